@@ -0,0 +1,121 @@
+"""
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+Generates darm_all.c and darm_all.h, the single translation unit version of
+libdarm, so that the compiler is able to inline across the decoders, e.g.,
+darm_disasm into darm_thumb2_disasm into the thumb2 sub-decoders.
+
+The vectorized kernels (kernels-*.c) are not part of it, as every one of
+them has to be compiled with its own instruction set flags.
+
+"""
+import glob
+import re
+import sys
+
+# the headers that make up the public interface, in this order
+public_headers = [
+    'darm.h', 'cfg.h', 'data.h', 'descent.h', 'fold.h', 'funcs.h',
+    'gadget.h', 'jumptable.h', 'ngram.h', 'search.h', 'stack.h', 'valid.h',
+]
+
+# the generated tables first, then the remaining sources
+generated_sources = ['darm-tbl.c', 'armv7-tbl.c', 'thumb-tbl.c',
+                     'thumb2-tbl.c']
+
+
+def license_block(lines):
+    """Length of the license comment at the start of a file, if any."""
+    if lines and lines[0].strip() == '/*' and 'Copyright' in lines[1]:
+        for idx, line in enumerate(lines):
+            if line.strip() == '*/':
+                return idx + 1
+    return 0
+
+
+def inline(fname, seen, out):
+    """Appends fname to out, inlining local headers the first time."""
+    lines = open(fname).read().split('\n')
+    if lines[-1] == '':
+        lines.pop()
+
+    out.append('// ---- %s ----' % fname)
+    for line in lines[license_block(lines):]:
+        m = re.match(r'#include "([^"]+)"', line)
+        if m:
+            if not m.group(1) in seen:
+                seen.add(m.group(1))
+                inline(m.group(1), seen, out)
+            continue
+
+        # defined once at the top of darm_all.c
+        if line.strip() == '#define _DEFAULT_SOURCE':
+            continue
+
+        out.append(line)
+
+
+def source_macros(fname):
+    """Macros that are defined by a source file."""
+    ret = []
+    for line in open(fname):
+        m = re.match(r'#\s*define\s+(\w+)', line)
+        if m and m.group(1) != '_DEFAULT_SOURCE' and \
+                not m.group(1) in ret:
+            ret.append(m.group(1))
+    return ret
+
+
+if __name__ == '__main__':
+    license = open('darmgen.py').read().split('"""')[1].strip()
+
+    seen = set()
+    header = ['/*', license, '*/', '', '#ifndef __DARM_ALL_H__',
+              '#define __DARM_ALL_H__', '']
+    for fname in public_headers:
+        if not fname in seen:
+            seen.add(fname)
+            inline(fname, seen, header)
+    header += ['', '#endif']
+
+    sources = generated_sources + sorted(
+        x for x in glob.glob('*.c')
+        if not x in generated_sources and not x.startswith('kernels-') and
+        x != 'darm_all.c')
+
+    source = ['/*', license, '*/', '', '#define _DEFAULT_SOURCE',
+              '#include "darm_all.h"', '']
+    for fname in sources:
+        inline(fname, seen, source)
+
+        # macros of one source file don't leak into the next one
+        source += ['#undef %s' % x for x in source_macros(fname)]
+        source.append('')
+
+    open('darm_all.h', 'w').write('\n'.join(header) + '\n')
+    open('darm_all.c', 'w').write('\n'.join(source) + '\n')
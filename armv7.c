@@ -33,6 +33,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "darm.h"
 #include "darm-internal.h"
 #include "armv7-tbl.h"
+#include "dispatch.h"
 
 #define BITMSK_12 ((1 << 12) - 1)
 #define BITMSK_16 ((1 << 16) - 1)
@@ -198,6 +199,68 @@ static int armv7_disas_uncond(darm_t *d, uint32_t w)
     return -1;
 }
 
+// B, BL, and SVC, of which the label has already been looked up
+static int armv7_disas_brnchsc(darm_t *d, uint32_t w)
+{
+    d->imm = w & BITMSK_24;
+    d->I = B_SET;
+
+    // if the instruction is B or BL, then we have to sign-extend it and
+    // multiply it with four
+    if(d->instr != I_SVC) {
+        // check if the highest bit of the imm24 is set, if so, we
+        // manually sign-extend the integer
+        if((d->imm >> 23) & 1) {
+            d->imm = (d->imm | 0xff000000) << 2;
+        }
+        else {
+            d->imm = d->imm << 2;
+        }
+    }
+    return 0;
+}
+
+// the STR, STRT, LDR, LDRT, STRB, STRBT, LDRB, LDRBT stack instructions
+static int armv7_disas_stack0(darm_t *d, uint32_t w)
+{
+    d->instr = type_stack0_instr_lookup[(w >> 20) & b11111];
+    d->instr_type = T_ARM_STACK0;
+
+    d->Rn = (w >> 16) & b1111;
+    d->Rt = (w >> 12) & b1111;
+
+    // extract some flags
+    d->P = (w >> 24) & 1;
+    d->U = (w >> 23) & 1;
+    d->W = (w >> 21) & 1;
+
+    // if the 25th bit is not set, then this instruction takes an
+    // immediate, otherwise, it takes a shifted register
+    if(((w >> 25) & 1) == 0) {
+        d->imm = w & BITMSK_12;
+        d->I = B_SET;
+    }
+    else {
+        d->shift_type = (w >> 5) & b11;
+        d->shift = (w >> 7) & b11111;
+        d->Rm = w & b1111;
+    }
+
+    // if Rn == SP and P = 1 and U = 0 and W = 1 and imm12 = 4 and
+    // this is a STR instruction, then this is a PUSH instruction
+    if(d->instr == I_STR && d->Rn == SP && d->P == 1 && d->U == 0 &&
+            d->W == 1 && d->imm == 4) {
+        d->instr = I_PUSH;
+    }
+    // if Rn == SP and P = 0 and U = 1 and W = 0 and imm12 = 4 and
+    // this is a LDR instruction, then this is a POP instruction
+    else if(d->instr == I_LDR && d->Rn == SP && d->P == 0 &&
+            d->U == 1 && d->W == 0 && d->imm == 4) {
+        d->instr = I_POP;
+    }
+    return 0;
+}
+
 static int armv7_disas_cond(darm_t *d, uint32_t w)
 {
     // we first handle some exceptions for MUL, STR, and LDR-like
@@ -333,42 +396,7 @@ static int armv7_disas_cond(darm_t *d, uint32_t w)
         // instruction, which is handled in the big switch-case statement
         const uint32_t media_mask = (1 << 25) | (1 << 4);
         if((w & media_mask) != media_mask) {
-            d->instr = type_stack0_instr_lookup[(w >> 20) & b11111];
-            d->instr_type = T_ARM_STACK0;
-
-            d->Rn = (w >> 16) & b1111;
-            d->Rt = (w >> 12) & b1111;
-
-            // extract some flags
-            d->P = (w >> 24) & 1;
-            d->U = (w >> 23) & 1;
-            d->W = (w >> 21) & 1;
-
-            // if the 25th bit is not set, then this instruction takes an
-            // immediate, otherwise, it takes a shifted register
-            if(((w >> 25) & 1) == 0) {
-                d->imm = w & BITMSK_12;
-                d->I = B_SET;
-            }
-            else {
-                d->shift_type = (w >> 5) & b11;
-                d->shift = (w >> 7) & b11111;
-                d->Rm = w & b1111;
-            }
-
-            // if Rn == SP and P = 1 and U = 0 and W = 1 and imm12 = 4 and
-            // this is a STR instruction, then this is a PUSH instruction
-            if(d->instr == I_STR && d->Rn == SP && d->P == 1 && d->U == 0 &&
-                    d->W == 1 && d->imm == 4) {
-                d->instr = I_PUSH;
-            }
-            // if Rn == SP and P = 0 and U = 1 and W = 0 and imm12 = 4 and
-            // this is a LDR instruction, then this is a POP instruction
-            else if(d->instr == I_LDR && d->Rn == SP && d->P == 0 &&
-                    d->U == 1 && d->W == 0 && d->imm == 4) {
-                d->instr = I_POP;
-            }
-            return 0;
+            return armv7_disas_stack0(d, w);
         }
     }
     // handle saturating addition and subtraction instructions, these
@@ -449,13 +477,37 @@ static int armv7_disas_cond(darm_t *d, uint32_t w)
         }
     }
 
-    // the instruction label
-    d->instr = armv7_instr_labels[(w >> 20) & 0xff];
-    d->instr_type = armv7_instr_types[(w >> 20) & 0xff];
+    // the instruction label and type
+    darm_lut_t entry = armv7_instr_lut[(w >> 20) & 0xff];
+    d->instr = darm_lut_instr(entry);
+    d->instr_type = darm_lut_type(entry);
 
     // do a lookup for the type of instruction
+#ifdef DARM_THREADED_DISPATCH
+    DISPATCH_TABLE(targets, ARRAYSIZE(darm_enctypes), arm_invld)
+        [T_ARM_ARITH_SHIFT] = &&arm_arith_shift,
+        [T_ARM_ARITH_IMM] = &&arm_arith_imm,
+        [T_ARM_BITS] = &&arm_bits,
+        [T_ARM_BRNCHSC] = &&arm_brnchsc,
+        [T_ARM_BRNCHMISC] = &&arm_brnchmisc,
+        [T_ARM_MOV_IMM] = &&arm_mov_imm,
+        [T_ARM_CMP_OP] = &&arm_cmp_op,
+        [T_ARM_CMP_IMM] = &&arm_cmp_imm,
+        [T_ARM_OPLESS] = &&arm_opless,
+        [T_ARM_DST_SRC] = &&arm_dst_src,
+        [T_ARM_LDSTREGS] = &&arm_ldstregs,
+        [T_ARM_BITREV] = &&arm_bitrev,
+        [T_ARM_MISC] = &&arm_misc,
+        [T_ARM_SM] = &&arm_sm,
+        [T_ARM_PAS] = &&arm_pas,
+        [T_ARM_MVCR] = &&arm_mvcr,
+        [T_ARM_UDF] = &&arm_udf,
+    DISPATCH_END()
+    DISPATCH(targets, d->instr_type);
+#endif
+
     switch ((uint32_t) d->instr_type) {
-    case T_ARM_ARITH_SHIFT:
+    case T_ARM_ARITH_SHIFT: DISPATCH_TARGET(arm_arith_shift)
         d->S = (w >> 20) & 1;
         d->Rd = (w >> 12) & b1111;
         d->Rn = (w >> 16) & b1111;
@@ -471,7 +523,7 @@ static int armv7_disas_cond(darm_t *d, uint32_t w)
         }
         return 0;
 
-    case T_ARM_ARITH_IMM:
+    case T_ARM_ARITH_IMM: DISPATCH_TARGET(arm_arith_imm)
         d->S = (w >> 20) & 1;
         d->Rd = (w >> 12) & b1111;
         d->Rn = (w >> 16) & b1111;
@@ -486,7 +538,7 @@ static int armv7_disas_cond(darm_t *d, uint32_t w)
         }
         return 0;
 
-    case T_ARM_BITS:
+    case T_ARM_BITS: DISPATCH_TARGET(arm_bits)
         d->instr = type_bits_instr_lookup[(w >> 21) & b11];
 
         d->instr_type = T_ARM_BITS;
@@ -510,25 +562,10 @@ static int armv7_disas_cond(darm_t *d, uint32_t w)
         }
         return 0;
 
-    case T_ARM_BRNCHSC:
-        d->imm = w & BITMSK_24;
-        d->I = B_SET;
-
-        // if the instruction is B or BL, then we have to sign-extend it and
-        // multiply it with four
-        if(d->instr != I_SVC) {
-            // check if the highest bit of the imm24 is set, if so, we
-            // manually sign-extend the integer
-            if((d->imm >> 23) & 1) {
-                d->imm = (d->imm | 0xff000000) << 2;
-            }
-            else {
-                d->imm = d->imm << 2;
-            }
-        }
-        return 0;
+    case T_ARM_BRNCHSC: DISPATCH_TARGET(arm_brnchsc)
+        return armv7_disas_brnchsc(d, w);
 
-    case T_ARM_BRNCHMISC:
+    case T_ARM_BRNCHMISC: DISPATCH_TARGET(arm_brnchmisc)
         // first get the real instruction label
         d->instr = type_brnchmisc_instr_lookup[(w >> 4) & b1111];
 
@@ -556,7 +593,7 @@ static int armv7_disas_cond(darm_t *d, uint32_t w)
         }
         break;
 
-    case T_ARM_MOV_IMM:
+    case T_ARM_MOV_IMM: DISPATCH_TARGET(arm_mov_imm)
         d->Rd = (w >> 12) & b1111;
         d->imm = w & BITMSK_12;
         d->I = B_SET;
@@ -575,7 +612,7 @@ static int armv7_disas_cond(darm_t *d, uint32_t w)
         }
         return 0;
 
-    case T_ARM_CMP_OP:
+    case T_ARM_CMP_OP: DISPATCH_TARGET(arm_cmp_op)
         d->Rn = (w >> 16) & b1111;
         d->Rm = w & b1111;
         d->shift_type = (w >> 5) & b11;
@@ -589,17 +626,17 @@ static int armv7_disas_cond(darm_t *d, uint32_t w)
         }
         return 0;
 
-    case T_ARM_CMP_IMM:
+    case T_ARM_CMP_IMM: DISPATCH_TARGET(arm_cmp_imm)
         d->Rn = (w >> 16) & b1111;
         d->imm = ARMExpandImm(w & BITMSK_12);
         d->I = B_SET;
         return 0;
 
-    case T_ARM_OPLESS:
+    case T_ARM_OPLESS: DISPATCH_TARGET(arm_opless)
         d->instr = type_opless_instr_lookup[w & b111];
         return d->instr == I_INVLD ? -1 : 0;
 
-    case T_ARM_DST_SRC:
+    case T_ARM_DST_SRC: DISPATCH_TARGET(arm_dst_src)
         d->instr = type_shift_instr_lookup[(w >> 4) & b1111];
         if(d->instr == I_INVLD) return -1;
 
@@ -630,7 +667,7 @@ static int armv7_disas_cond(darm_t *d, uint32_t w)
 
         return 0;
 
-    case T_ARM_LDSTREGS:
+    case T_ARM_LDSTREGS: DISPATCH_TARGET(arm_ldstregs)
         d->W = (w >> 21) & 1;
         d->Rn = (w >> 16) & b1111;
         d->reglist = w & BITMSK_16;
@@ -647,7 +684,7 @@ static int armv7_disas_cond(darm_t *d, uint32_t w)
         }
         return 0;
 
-    case T_ARM_BITREV:
+    case T_ARM_BITREV: DISPATCH_TARGET(arm_bitrev)
         d->Rd = (w >> 12) & b1111;
         d->Rm = w & b1111;
 
@@ -663,7 +700,7 @@ static int armv7_disas_cond(darm_t *d, uint32_t w)
         }
         return 0;
 
-    case T_ARM_MISC:
+    case T_ARM_MISC: DISPATCH_TARGET(arm_misc)
         switch ((uint32_t) d->instr) {
         case I_MVN:
             d->S = (w >> 20) & 1;
@@ -732,7 +769,7 @@ static int armv7_disas_cond(darm_t *d, uint32_t w)
             return 0;
         }
 
-    case T_ARM_SM:
+    case T_ARM_SM: DISPATCH_TARGET(arm_sm)
         switch ((uint32_t) d->instr) {
         case I_SMMUL:
             d->Rd = (w >> 16) & b1111;
@@ -807,7 +844,7 @@ static int armv7_disas_cond(darm_t *d, uint32_t w)
             break;
         }
 
-    case T_ARM_PAS:
+    case T_ARM_PAS: DISPATCH_TARGET(arm_pas)
         // we have a lookup table with size 64, for all parallel signed and
         // unsigned addition and subtraction instructions
         // the upper three bits are represented by bits 20..22, so we only
@@ -822,7 +859,7 @@ static int armv7_disas_cond(darm_t *d, uint32_t w)
         d->Rm = w & b1111;
         return 0;
 
-    case T_ARM_MVCR:
+    case T_ARM_MVCR: DISPATCH_TARGET(arm_mvcr)
         d->CRn = (w >> 16) & b1111;
         d->coproc = (w >> 8) & b1111;
         d->opc2 = (w >> 5) & b111;
@@ -839,14 +876,30 @@ static int armv7_disas_cond(darm_t *d, uint32_t w)
         }
         return 0;
 
-    case T_ARM_UDF:
+    case T_ARM_UDF: DISPATCH_TARGET(arm_udf)
         d->I = B_SET;
         d->imm = (w & b1111) | ((w >> 4) & (BITMSK_12 << 4));
         return 0;
     }
+    DISPATCH_TARGET(arm_invld)
     return -1;
 }
 
+static int armv7_disas_finish(darm_t *d, int ret)
+{
+    // return error
+    if(ret < 0) return ret;
+
+    // if the shift-type is set to S_LSL, but Rs is R_INVLD and shift is zero,
+    // then there's effectively no shift, so we set shift-type to S_INVLD
+    if(d->shift_type == S_LSL && d->Rs == R_INVLD && d->shift == 0) {
+        d->shift_type = S_INVLD;
+    }
+
+    darm_regs_update(d);
+    return 0;
+}
+
 int darm_armv7_disasm(darm_t *d, uint32_t w)
 {
     int ret;
@@ -862,16 +915,78 @@ int darm_armv7_disasm(darm_t *d, uint32_t w)
         ret = armv7_disas_cond(d, w);
     }
 
-    // return error
-    if(ret < 0) return ret;
+    return armv7_disas_finish(d, ret);
+}
 
-    // if the shift-type is set to S_LSL, but Rs is R_INVLD and shift is zero,
-    // then there's effectively no shift, so we set shift-type to S_INVLD
-    if(d->shift_type == S_LSL && d->Rs == R_INVLD && d->shift == 0) {
-        d->shift_type = S_INVLD;
-    }
+// amount of instructions that are classified and then disassembled at once
+#define BATCH_SIZE 256
 
-    return 0;
+uint32_t darm_armv7_disasm_batch(darm_t *d, const uint32_t *w,
+    uint32_t count)
+{
+    uint8_t cls[BATCH_SIZE]; uint16_t order[BATCH_SIZE];
+    uint32_t ok = 0;
+
+    for (uint32_t base = 0; base < count; base += BATCH_SIZE) {
+        uint32_t n = count - base < BATCH_SIZE ? count - base : BATCH_SIZE;
+        uint32_t offset[DC_COUNT + 1] = {0};
+
+        darm_armv7_classify(&w[base], n, cls);
+
+        // partition the instructions by class, i.e., a counting sort
+        for (uint32_t idx = 0; idx < n; idx++) {
+            offset[cls[idx] + 1]++;
+        }
+        for (uint32_t idx = 0; idx < DC_COUNT; idx++) {
+            offset[idx + 1] += offset[idx];
+        }
+        for (uint32_t idx = 0; idx < n; idx++) {
+            order[offset[cls[idx]]++] = idx;
+        }
+
+        // offset[c] now points to the end of class c
+        for (uint32_t c = 0, start = 0; c < DC_COUNT;
+                start = offset[c++]) {
+            for (uint32_t idx = start; idx < offset[c]; idx++) {
+                darm_t *cur = &d[base + order[idx]];
+                uint32_t insn = w[base + order[idx]];
+                int ret;
+
+                darm_init(cur);
+                cur->w = insn;
+                cur->cond = (insn >> 28) & b1111;
+
+                switch (c) {
+                case DC_UNCOND:
+                    ret = armv7_disas_uncond(cur, insn);
+                    break;
+
+                case DC_LDST:
+                    ret = armv7_disas_stack0(cur, insn);
+                    break;
+
+                case DC_BRANCH:
+                    cur->instr =
+                        darm_lut_instr(armv7_instr_lut[(insn >> 20) & 0xff]);
+                    cur->instr_type = T_ARM_BRNCHSC;
+                    ret = armv7_disas_brnchsc(cur, insn);
+                    break;
+
+                default:
+                    ret = armv7_disas_cond(cur, insn);
+                    break;
+                }
+
+                if(armv7_disas_finish(cur, ret) < 0) {
+                    darm_init(cur);
+                    cur->w = insn;
+                    continue;
+                }
+                ok++;
+            }
+        }
+    }
+    return ok;
 }
 
 const char *darm_mnemonic_name(darm_instr_t instr)
@@ -0,0 +1,90 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include "darm.h"
+#include "kernels.h"
+
+#define ODD_BITS 0xaaaaaaaaaaaaaaaaULL
+
+// computes the instruction starts of count halfwords, carry specifies
+// whether the first halfword is the second half of a 32-bit instruction;
+// returns the carry for the next halfword
+static uint64_t _thumb_bitmap(const uint8_t *buf, uint32_t count,
+    uint64_t *starts, uint64_t carry)
+{
+    uint64_t (*prefix)(const uint8_t *buf, uint32_t count) =
+        darm_kernels()->prefix;
+
+    for (uint32_t idx = 0; idx < count; idx += 64) {
+        uint32_t n = count - idx < 64 ? count - idx : 64;
+        uint64_t p = prefix(&buf[idx * 2], n);
+
+        // a halfword is the second half of a 32-bit instruction if the
+        // previous halfword is a prefix and starts an instruction itself,
+        // i.e., within each run of prefixes every other halfword starts an
+        // instruction, which is resolved by a carry propagating subtraction
+        // in the same way as odd-length runs of escape characters are
+        uint64_t first = p & ~carry;
+        uint64_t code = (((first << 1) | ODD_BITS) - first) ^ ODD_BITS;
+        uint64_t second = code ^ (p | carry);
+
+        starts[idx / 64] = ~second & (n == 64 ? ~0ULL : (1ULL << n) - 1);
+        carry = ((code & p) >> 63) & (n == 64);
+    }
+    return carry;
+}
+
+void darm_thumb_bitmap(const uint8_t *buf, uint32_t len, uint64_t *starts)
+{
+    _thumb_bitmap(buf, len / 2, starts, 0);
+}
+
+// amount of halfwords that are resolved at once
+#define CHUNK_SIZE 4096
+
+uint32_t darm_thumb_starts(const uint8_t *buf, uint32_t len,
+    uint32_t *starts)
+{
+    uint64_t bitmap[CHUNK_SIZE / 64], carry = 0;
+    uint32_t count = 0;
+
+    for (uint32_t off = 0; off < len / 2; off += CHUNK_SIZE) {
+        uint32_t n = len / 2 - off < CHUNK_SIZE ? len / 2 - off : CHUNK_SIZE;
+        carry = _thumb_bitmap(&buf[off * 2], n, bitmap, carry);
+
+        for (uint32_t idx = 0; idx < (n + 63) / 64; idx++) {
+            for (uint64_t bits = bitmap[idx]; bits != 0; bits &= bits - 1) {
+                starts[count++] = (off + idx * 64 + __builtin_ctzll(bits)) * 2;
+            }
+        }
+    }
+    return count;
+}
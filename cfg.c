@@ -0,0 +1,377 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "darm.h"
+#include "darm-internal.h"
+#include "cfg.h"
+#include "data.h"
+#include "jumptable.h"
+
+#define NO_TARGET 0xffffffff
+
+// control flow instruction, all offsets are in halfwords relative to the
+// start of the range
+typedef struct _cfg_branch_t {
+    uint32_t        next;
+    uint32_t        target;
+    uint8_t         flow;
+    uint8_t         cond;
+
+    // the cases of a resolved switch, case_count offsets starting at
+    // case_index in the list of cases
+    uint32_t        case_index;
+    uint32_t        case_count;
+} cfg_branch_t;
+
+darm_flow_t darm_flow(const darm_t *d)
+{
+    switch ((uint32_t) d->instr) {
+    case I_B: case I_CBZ: case I_CBNZ:
+        return F_JUMP;
+
+    case I_BL: case I_BLX:
+        return F_CALL;
+
+    case I_BX: case I_BXJ:
+        return F_INDIRECT;
+
+    case I_TBB: case I_TBH:
+        return F_TABLE;
+
+    case I_POP: case I_LDM: case I_LDMDA: case I_LDMDB: case I_LDMIB:
+        // loading the pc from the stack, i.e., a return
+        return (d->reglist >> PC) & 1 || d->Rt == PC ? F_INDIRECT : F_NONE;
+
+    case I_LDR:
+        return d->Rt == PC ? F_INDIRECT : F_NONE;
+
+    case I_CMP: case I_CMN: case I_TEQ: case I_TST:
+        // the thumb2 decoder sets Rd to PC for these, but they don't
+        // write to it
+        return F_NONE;
+
+    default:
+        // data-processing instructions writing to the pc, e.g.,
+        // MOV pc, lr or ADD pc, pc, r0
+        return d->Rd == PC ? F_INDIRECT : F_NONE;
+    }
+}
+
+int darm_flow_is_cond(const darm_t *d)
+{
+    return d->instr == I_CBZ || d->instr == I_CBNZ ||
+        (d->cond != C_AL && d->cond != C_UNCOND && d->cond != C_INVLD);
+}
+
+int32_t darm_cfg_block(const darm_cfg_t *cfg, uint32_t addr)
+{
+    uint32_t lo = 0, hi = cfg->block_count;
+
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if(cfg->block_addr[mid] < addr) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+
+    return lo < cfg->block_count && cfg->block_addr[lo] == addr ? (int32_t) lo : -1;
+}
+
+int darm_cfg_build(darm_cfg_t *cfg, const uint8_t *buf, uint32_t len,
+    uint32_t base, uint32_t start, uint32_t end)
+{
+    uint32_t thumb = start & 1, step = thumb ? 2 : 4;
+    start &= ~1;
+
+    memset(cfg, 0, sizeof(darm_cfg_t));
+
+    if(start < base || end < start || end - base > len) {
+        return -1;
+    }
+
+    const uint8_t *code = buf + (start - base);
+    uint32_t size = end - start, count = size / 2 + 1;
+
+    // one bit per halfword for the start of each instruction and for the
+    // start of each basic block
+    uint64_t *insns = calloc(BITMAP_WORDS(count), sizeof(uint64_t));
+    uint64_t *leaders = calloc(BITMAP_WORDS(count), sizeof(uint64_t));
+
+    uint32_t branch_count = 0, branch_alloc = 1024;
+    cfg_branch_t *branches = malloc(branch_alloc * sizeof(cfg_branch_t));
+
+    // the targets of resolved switches, in halfwords as well
+    uint32_t case_count = 0, case_alloc = 1024;
+    uint32_t *cases = malloc(case_alloc * sizeof(uint32_t));
+
+    // literal pools and jump tables referenced by the code
+    darm_data_t data;
+    int data_ret = darm_data_init(&data, start, size);
+
+    darm_jt_t jt;
+    darm_jt_init(&jt, buf, len, base);
+
+    if(insns == NULL || leaders == NULL || branches == NULL ||
+            cases == NULL || data_ret < 0) {
+        goto error;
+    }
+
+    BITMAP_SET(leaders, 0);
+
+    darm_t d; darm_it_t it; uint32_t off = 0;
+    darm_it_init(&it);
+
+    while (off + step <= size) {
+        // skip literal pools and jump tables, the next instruction after
+        // them starts a new basic block
+        if(darm_data_get(&data, start + off)) {
+            off += step;
+            if(!darm_data_get(&data, start + off)) {
+                BITMAP_SET(leaders, off / 2);
+            }
+            continue;
+        }
+
+        int ret = darm_disasm_buf(&d, code + off, size - off,
+            (start + off) | thumb);
+
+        // instructions inside an IT block are conditional
+        if(thumb != 0) {
+            darm_it_apply(&it, &d, ret);
+        }
+
+        BITMAP_SET(insns, off / 2);
+
+        uint32_t case_index = case_count, targets = 0;
+
+        if(ret != 0) {
+            darm_data_mark(&data, &d, (start + off) | thumb);
+
+            darm_jt_t saved = jt;
+            targets = darm_jt_step(&jt, &d, (start + off) | thumb,
+                cases + case_count, case_alloc - case_count);
+
+            // not enough room for all the cases, resolve the switch again
+            if(targets > case_alloc - case_count) {
+                while (targets > case_alloc - case_count) case_alloc *= 2;
+
+                uint32_t *ptr = realloc(cases, case_alloc * sizeof(uint32_t));
+                if(ptr == NULL) goto error;
+                cases = ptr;
+
+                jt = saved;
+                darm_jt_step(&jt, &d, (start + off) | thumb,
+                    cases + case_count, targets);
+            }
+
+            // the table holds addresses rather than instructions
+            if(targets != 0 && jt.table_size != 0) {
+                darm_data_set(&data, jt.table_addr, jt.table_size);
+            }
+        }
+
+        // keep the cases inside the range, as offsets
+        for (uint32_t idx = 0; idx < targets; idx++) {
+            uint32_t addr = cases[case_index + idx];
+            if((addr & 1) != thumb || (addr & ~1) < start ||
+                    (addr & ~1) >= end) {
+                continue;
+            }
+
+            cases[case_count] = ((addr & ~1) - start) / 2;
+            BITMAP_SET(leaders, cases[case_count]);
+            case_count++;
+        }
+
+        darm_flow_t flow = ret != 0 ? darm_flow(&d) : F_INDIRECT;
+        uint32_t next = off + (ret != 0 ? (uint32_t) ret * 2 : step);
+        uint32_t target = NO_TARGET, addr; int target_is_thumb;
+
+        if(ret != 0 && darm_branch_target(&d, (start + off) | thumb,
+                &addr, &target_is_thumb) == 0 &&
+                (uint32_t) target_is_thumb == thumb &&
+                addr >= start && addr < end) {
+            target = (addr - start) / 2;
+            BITMAP_SET(leaders, target);
+        }
+
+        off = next;
+
+        // calls don't end a basic block, and neither do regular instructions
+        if(flow == F_NONE || flow == F_CALL) continue;
+
+        if(branch_count == branch_alloc) {
+            cfg_branch_t *ptr = realloc(branches,
+                (branch_alloc *= 2) * sizeof(cfg_branch_t));
+            if(ptr == NULL) goto error;
+            branches = ptr;
+        }
+
+        // undecodable instructions end a basic block without any successors
+        branches[branch_count].next = next / 2;
+        branches[branch_count].target = target;
+        branches[branch_count].flow = flow;
+        branches[branch_count].cond = ret != 0 && darm_flow_is_cond(&d);
+        branches[branch_count].case_index = case_index;
+        branches[branch_count].case_count = case_count - case_index;
+        branch_count++;
+
+        BITMAP_SET(leaders, next / 2);
+    }
+
+    // only the start of an instruction can be the start of a basic block
+    for (uint32_t idx = 0; idx < BITMAP_WORDS(count); idx++) {
+        leaders[idx] &= insns[idx];
+        cfg->block_count += __builtin_popcountll(leaders[idx]);
+    }
+
+    cfg->block_addr = malloc(cfg->block_count * sizeof(uint32_t));
+    cfg->block_size = malloc(cfg->block_count * sizeof(uint32_t));
+    cfg->edge_index = malloc((cfg->block_count + 1) * sizeof(uint32_t));
+    cfg->edge_target = malloc((cfg->block_count * 2 + case_count) *
+        sizeof(uint32_t));
+    cfg->edge_type = malloc((cfg->block_count * 2 + case_count) *
+        sizeof(uint8_t));
+
+    if(cfg->block_addr == NULL || cfg->block_size == NULL ||
+            cfg->edge_index == NULL || cfg->edge_target == NULL ||
+            cfg->edge_type == NULL) {
+        goto error;
+    }
+
+    uint32_t block = 0;
+    for (uint32_t idx = 0; idx < BITMAP_WORDS(count); idx++) {
+        for (uint64_t bits = leaders[idx]; bits != 0; bits &= bits - 1) {
+            uint32_t hw = idx * 64 + __builtin_ctzll(bits);
+            cfg->block_addr[block++] = (start + hw * 2) | thumb;
+        }
+    }
+
+    // each basic block ends either right before the next one, right before
+    // data, or with the last instruction in the range
+    for (block = 0; block < cfg->block_count; block++) {
+        uint32_t addr = cfg->block_addr[block] & ~1;
+        uint32_t next = block + 1 < cfg->block_count ?
+            cfg->block_addr[block + 1] & ~1 : start + off;
+
+        uint32_t end = addr;
+        while (end < next && !darm_data_get(&data, end)) {
+            end += step;
+        }
+        cfg->block_size[block] = end - addr;
+    }
+
+    uint32_t branch = 0;
+    for (block = 0; block < cfg->block_count; block++) {
+        uint32_t next = ((cfg->block_addr[block] & ~1) - start +
+            cfg->block_size[block]) / 2;
+        int fallthrough = 1;
+
+        cfg->edge_index[block] = cfg->edge_count;
+
+        while (branch < branch_count && branches[branch].next < next) {
+            branch++;
+        }
+
+        // does this basic block end with a control flow instruction?
+        if(branch < branch_count && branches[branch].next == next) {
+            const cfg_branch_t *b = &branches[branch++];
+
+            if(b->target != NO_TARGET && BITMAP_GET(insns, b->target)) {
+                cfg->edge_target[cfg->edge_count] = darm_cfg_block(cfg,
+                    (start + b->target * 2) | thumb);
+                cfg->edge_type[cfg->edge_count++] = E_BRANCH;
+            }
+
+            // one edge per distinct case target
+            for (uint32_t idx = 0; idx < b->case_count; idx++) {
+                int32_t target = darm_cfg_block(cfg,
+                    (start + cases[b->case_index + idx] * 2) | thumb);
+                uint32_t edge = cfg->edge_index[block];
+
+                while (edge < cfg->edge_count &&
+                        (cfg->edge_target[edge] != (uint32_t) target ||
+                         cfg->edge_type[edge] != E_CASE)) {
+                    edge++;
+                }
+
+                if(target >= 0 && edge == cfg->edge_count) {
+                    cfg->edge_target[cfg->edge_count] = target;
+                    cfg->edge_type[cfg->edge_count++] = E_CASE;
+                }
+            }
+
+            fallthrough = b->cond;
+        }
+
+        // the next block only follows this one if there's no data, e.g., a
+        // literal pool, in between
+        if(fallthrough != 0 && block + 1 < cfg->block_count &&
+                cfg->block_addr[block + 1] ==
+                cfg->block_addr[block] + cfg->block_size[block]) {
+            cfg->edge_target[cfg->edge_count] = block + 1;
+            cfg->edge_type[cfg->edge_count++] = E_FALLTHROUGH;
+        }
+    }
+
+    cfg->edge_index[cfg->block_count] = cfg->edge_count;
+
+    free(insns);
+    free(leaders);
+    free(branches);
+    free(cases);
+    darm_data_free(&data);
+    return 0;
+
+error:
+    free(insns);
+    free(leaders);
+    free(branches);
+    free(cases);
+    darm_data_free(&data);
+    darm_cfg_free(cfg);
+    return -1;
+}
+
+void darm_cfg_free(darm_cfg_t *cfg)
+{
+    free(cfg->block_addr);
+    free(cfg->block_size);
+    free(cfg->edge_index);
+    free(cfg->edge_target);
+    free(cfg->edge_type);
+    memset(cfg, 0, sizeof(darm_cfg_t));
+}
@@ -0,0 +1,101 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef __CFG_H__
+#define __CFG_H__
+
+#include "darm.h"
+
+typedef enum _darm_flow_t {
+    // regular instruction, execution continues at the next instruction
+    F_NONE,
+
+    // branch with link, returns to the next instruction
+    F_CALL,
+
+    // direct branch, see darm_branch_target for its target
+    F_JUMP,
+
+    // branch to a computed address, e.g., BX LR, POP {pc}, or LDR pc, [..]
+    F_INDIRECT,
+
+    // table branch, i.e., TBB and TBH
+    F_TABLE,
+} darm_flow_t;
+
+typedef enum _darm_edge_t {
+    E_FALLTHROUGH, E_BRANCH,
+
+    // one of the cases of a switch, see darm_jt_step
+    E_CASE,
+} darm_edge_t;
+
+typedef struct _darm_cfg_t {
+    uint32_t        block_count;
+    uint32_t        edge_count;
+
+    // start address of each basic block, sorted, with the least significant
+    // bit set for Thumb, and the size of each block in bytes
+    uint32_t        *block_addr;
+    uint32_t        *block_size;
+
+    // the successors of block idx are stored in compressed sparse row form,
+    // i.e., edge_target[edge_index[idx]] up to edge_target[edge_index[idx+1]]
+    // are the indices of its successor blocks
+    uint32_t        *edge_index;
+    uint32_t        *edge_target;
+    uint8_t         *edge_type;
+} darm_cfg_t;
+
+// determine how an instruction affects the control flow
+darm_flow_t darm_flow(const darm_t *d);
+
+// whether the instruction might not be executed, i.e., a branch could be
+// taken or the next instruction will be executed
+int darm_flow_is_cond(const darm_t *d);
+
+//
+// Builds the control flow graph for the range start..end by linear sweep,
+// buf is the image mapped at address base and len is its size in bytes. As
+// usual, the least significant bit of start specifies whether the range is
+// Thumb code. Basic blocks are split at direct branch and call targets
+// inside the range, at the cases of resolved switches, and after each
+// branch, return, or table branch.
+//
+// Returns 0 on success, -1 on invalid ranges or allocation failures.
+//
+int darm_cfg_build(darm_cfg_t *cfg, const uint8_t *buf, uint32_t len,
+    uint32_t base, uint32_t start, uint32_t end);
+
+// index of the basic block starting at addr, or -1
+int32_t darm_cfg_block(const darm_cfg_t *cfg, uint32_t addr);
+
+void darm_cfg_free(darm_cfg_t *cfg);
+
+#endif
@@ -0,0 +1,811 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <stdio.h>
+#include <stdint.h>
+#include "darm-tbl.h"
+const char *darm_mnemonics[] = {
+    "INVLD", "ADC", "ADD", "ADDW", "ADR", "AND", "ASR", "B", "BFC", "BFI",
+    "BIC", "BKPT", "BL", "BLX", "BX", "BXJ", "CBNZ", "CBZ", "CDP", "CDP2",
+    "CHKA", "CLREX", "CLZ", "CMN", "CMP", "CPS", "CPY", "DBG", "DMB", "DSB",
+    "ENTERX", "EOR", "HB", "HBL", "HBLP", "HBP", "ISB", "IT", "LDC", "LDC2",
+    "LDM", "LDMDA", "LDMDB", "LDMIB", "LDR", "LDRB", "LDRBT", "LDRD", "LDREX",
+    "LDREXB", "LDREXD", "LDREXH", "LDRH", "LDRHT", "LDRSB", "LDRSBT", "LDRSH",
+    "LDRSHT", "LDRT", "LEAVEX", "LSL", "LSR", "MCR", "MCR2", "MCRR", "MCRR2",
+    "MLA", "MLS", "MOV", "MOVT", "MOVW", "MRC", "MRC2", "MRRC", "MRRC2",
+    "MRS", "MSR", "MUL", "MVN", "NEG", "NOP", "ORN", "ORR", "PKH", "PLD",
+    "PLDW", "PLI", "POP", "PUSH", "QADD", "QADD16", "QADD8", "QASX", "QDADD",
+    "QDSUB", "QSAX", "QSUB", "QSUB16", "QSUB8", "RBIT", "REV", "REV16",
+    "REVSH", "RFE", "ROR", "RRX", "RSB", "RSC", "SADD16", "SADD8", "SASX",
+    "SBC", "SBFX", "SDIV", "SEL", "SETEND", "SEV", "SHADD16", "SHADD8",
+    "SHASX", "SHSAX", "SHSUB16", "SHSUB8", "SMC", "SMLA", "SMLABB", "SMLABT",
+    "SMLAD", "SMLAL", "SMLALBB", "SMLALBT", "SMLALD", "SMLALTB", "SMLALTT",
+    "SMLATB", "SMLATT", "SMLAW", "SMLSD", "SMLSLD", "SMMLA", "SMMLS", "SMMUL",
+    "SMUAD", "SMUL", "SMULBB", "SMULBT", "SMULL", "SMULTB", "SMULTT", "SMULW",
+    "SMUSD", "SRS", "SSAT", "SSAT16", "SSAX", "SSUB16", "SSUB8", "STC",
+    "STC2", "STM", "STMDA", "STMDB", "STMIB", "STR", "STRB", "STRBT", "STRD",
+    "STREX", "STREXB", "STREXD", "STREXH", "STRH", "STRHT", "STRT", "SUB",
+    "SUBW", "SVC", "SWP", "SWPB", "SXTAB", "SXTAB16", "SXTAH", "SXTB",
+    "SXTB16", "SXTH", "TBB", "TBH", "TEQ", "TST", "UADD16", "UADD8", "UASX",
+    "UBFX", "UDF", "UDIV", "UHADD16", "UHADD8", "UHASX", "UHSAX", "UHSUB16",
+    "UHSUB8", "UMAAL", "UMLAL", "UMULL", "UQADD16", "UQADD8", "UQASX",
+    "UQSAX", "UQSUB16", "UQSUB8", "USAD8", "USADA8", "USAT", "USAT16", "USAX",
+    "USUB16", "USUB8", "UXTAB", "UXTAB16", "UXTAH", "UXTB", "UXTB16", "UXTH",
+    "VABA", "VABAL", "VABD", "VABDL", "VABS", "VACGE", "VACGT", "VACLE",
+    "VACLT", "VADD", "VADDHN", "VADDL", "VADDW", "VAND", "VBIC", "VBIF",
+    "VBIT", "VBSL", "VCEQ", "VCGE", "VCGT", "VCLE", "VCLS", "VCLT", "VCLZ",
+    "VCMP", "VCMPE", "VCNT", "VCVT", "VCVTB", "VCVTR", "VCVTT", "VDIV",
+    "VDUP", "VEOR", "VEXT", "VHADD", "VHSUB", "VLD1", "VLD2", "VLD3", "VLD4",
+    "VLDM", "VLDR", "VMAX", "VMIN", "VMLA", "VMLAL", "VMLS", "VMLSL", "VMOV",
+    "VMOVL", "VMOVN", "VMRS", "VMSR", "VMUL", "VMULL", "VMVN", "VNEG",
+    "VNMLA", "VNMLS", "VNMUL", "VORN", "VORR", "VPADAL", "VPADD", "VPADDL",
+    "VPMAX", "VPMIN", "VPOP", "VPUSH", "VQABS", "VQADD", "VQDMLAL", "VQDMLSL",
+    "VQDMULH", "VQDMULL", "VQMOVN", "VQMOVUN", "VQNEG", "VQRDMULH", "VQRSHL",
+    "VQRSHRN", "VQRSHRUN", "VQSHL", "VQSHLU", "VQSHRN", "VQSHRUN", "VQSUB",
+    "VRADDHN", "VRECPE", "VRECPS", "VREV16", "VREV32", "VREV64", "VRHADD",
+    "VRSHL", "VRSHR", "VRSHRN", "VRSQRTE", "VRSQRTS", "VRSRA", "VRSUBHN",
+    "VSHL", "VSHLL", "VSHR", "VSHRN", "VSLI", "VSQRT", "VSRA", "VSRI", "VST1",
+    "VST2", "VST3", "VST4", "VSTM", "VSTR", "VSUB", "VSUBHN", "VSUBL",
+    "VSUBW", "VSWP", "VTBL", "VTBX", "VTRN", "VTST", "VUZP", "VZIP", "WFE",
+    "WFI", "YIELD"
+};
+
+const char *darm_enctypes[] = {
+    "INVLD", "ARM_ADR", "ARM_UNCOND", "ARM_MUL", "ARM_STACK0", "ARM_STACK1",
+    "ARM_STACK2", "ARM_ARITH_SHIFT", "ARM_ARITH_IMM", "ARM_BITS",
+    "ARM_BRNCHSC", "ARM_BRNCHMISC", "ARM_MOV_IMM", "ARM_CMP_OP",
+    "ARM_CMP_IMM", "ARM_OPLESS", "ARM_DST_SRC", "ARM_LDSTREGS", "ARM_BITREV",
+    "ARM_MISC", "ARM_SM", "ARM_PAS", "ARM_SAT", "ARM_SYNC", "ARM_PUSR",
+    "ARM_MVCR", "ARM_UDF", "THUMB_ONLY_IMM8", "THUMB_COND_BRANCH",
+    "THUMB_UNCOND_BRANCH", "THUMB_SHIFT_IMM", "THUMB_STACK", "THUMB_LDR_PC",
+    "THUMB_GPI", "THUMB_BRANCH_REG", "THUMB_IT_HINTS", "THUMB_HAS_IMM8",
+    "THUMB_EXTEND", "THUMB_MOD_SP_IMM", "THUMB_3REG", "THUMB_2REG_IMM",
+    "THUMB_ADD_SP_IMM", "THUMB_MOV4", "THUMB_RW_MEMI", "THUMB_RW_MEMO",
+    "THUMB_RW_REG", "THUMB_REV", "THUMB_SETEND", "THUMB_PUSHPOP", "THUMB_CMP",
+    "THUMB_MOD_SP_REG", "THUMB_CBZ", "THUMB2_NO_REG", "THUMB2_RT_REG",
+    "THUMB2_RT_RT2_REG", "THUMB2_RM_REG", "THUMB2_RD_REG", "THUMB2_RD_RM_REG",
+    "THUMB2_RN_REG", "THUMB2_RN_RT_REG", "THUMB2_RN_RT_RT2_REG",
+    "THUMB2_RN_RM_REG", "THUMB2_RN_RM_RT_REG", "THUMB2_RN_RD_REG",
+    "THUMB2_RN_RD_RT_REG", "THUMB2_RN_RD_RT_RT2_REG", "THUMB2_RN_RD_RM_REG",
+    "THUMB2_RN_RD_RM_RA_REG", "THUMB2_NO_IMM", "THUMB2_IMM12", "THUMB2_IMM8",
+    "THUMB2_IMM2", "THUMB2_IMM2_IMM3", "THUMB2_IMM1_IMM3_IMM8",
+    "THUMB2_NO_FLAG", "THUMB2_ROTATE_FLAG", "THUMB2_U_FLAG",
+    "THUMB2_WUP_FLAG", "THUMB2_TYPE_FLAG", "THUMB2_REGLIST_FLAG",
+    "THUMB2_WP_REGLIST_FLAG", "THUMB2_S_FLAG", "THUMB2_S_TYPE_FLAG"
+};
+
+const char *darm_registers[] = {
+    "r0", "r1", "r2", "r3", "r4", "r5", "r6", "r7", "r8", "r9", "r10", "r11",
+    "r12", "SP", "LR", "PC"
+};
+
+const uint16_t darm_regrules[354] = {
+    [I_ADR] = RR_PC_REL,
+    [I_B] = RR_PC_WRITE | RR_PC_REL,
+    [I_BFC] = RR_RD_READ,
+    [I_BFI] = RR_RD_READ,
+    [I_BL] = RR_LR_WRITE | RR_PC_WRITE | RR_PC_REL,
+    [I_BLX] = RR_LR_WRITE | RR_PC_WRITE | RR_PC_REL,
+    [I_BX] = RR_PC_WRITE,
+    [I_BXJ] = RR_PC_WRITE,
+    [I_CBNZ] = RR_PC_WRITE | RR_PC_REL,
+    [I_CBZ] = RR_PC_WRITE | RR_PC_REL,
+    [I_CMN] = RR_RD_NONE,
+    [I_CMP] = RR_RD_NONE,
+    [I_LDC] = RR_WRITEBACK,
+    [I_LDC2] = RR_WRITEBACK,
+    [I_LDM] = RR_LIST_WRITE | RR_WRITEBACK,
+    [I_LDMDA] = RR_LIST_WRITE | RR_WRITEBACK,
+    [I_LDMDB] = RR_LIST_WRITE | RR_WRITEBACK,
+    [I_LDMIB] = RR_LIST_WRITE | RR_WRITEBACK,
+    [I_LDR] = RR_RT_WRITE | RR_WRITEBACK | RR_PC_REL,
+    [I_LDRB] = RR_RT_WRITE | RR_WRITEBACK | RR_PC_REL,
+    [I_LDRBT] = RR_RT_WRITE | RR_WRITEBACK,
+    [I_LDRD] = RR_RT_WRITE | RR_RT2_WRITE | RR_RT_PAIR | RR_WRITEBACK | RR_PC_REL,
+    [I_LDREX] = RR_RT_WRITE,
+    [I_LDREXB] = RR_RT_WRITE,
+    [I_LDREXD] = RR_RT_WRITE | RR_RT2_WRITE | RR_RT_PAIR,
+    [I_LDREXH] = RR_RT_WRITE,
+    [I_LDRH] = RR_RT_WRITE | RR_WRITEBACK | RR_PC_REL,
+    [I_LDRHT] = RR_RT_WRITE | RR_WRITEBACK,
+    [I_LDRSB] = RR_RT_WRITE | RR_WRITEBACK | RR_PC_REL,
+    [I_LDRSBT] = RR_RT_WRITE | RR_WRITEBACK,
+    [I_LDRSH] = RR_RT_WRITE | RR_WRITEBACK | RR_PC_REL,
+    [I_LDRSHT] = RR_RT_WRITE | RR_WRITEBACK,
+    [I_LDRT] = RR_RT_WRITE | RR_WRITEBACK,
+    [I_MOVT] = RR_RD_READ,
+    [I_MRC] = RR_RT_WRITE,
+    [I_MRC2] = RR_RT_WRITE,
+    [I_MRRC] = RR_RT_WRITE | RR_RT2_WRITE,
+    [I_MRRC2] = RR_RT_WRITE | RR_RT2_WRITE,
+    [I_PLD] = RR_PC_REL,
+    [I_PLDW] = RR_PC_REL,
+    [I_PLI] = RR_PC_REL,
+    [I_POP] = RR_RT_WRITE | RR_LIST_WRITE | RR_SP,
+    [I_PUSH] = RR_SP,
+    [I_SMLAL] = RR_HILO_READ,
+    [I_SMLALBB] = RR_HILO_READ,
+    [I_SMLALBT] = RR_HILO_READ,
+    [I_SMLALD] = RR_HILO_READ,
+    [I_SMLALTB] = RR_HILO_READ,
+    [I_SMLALTT] = RR_HILO_READ,
+    [I_SMLSLD] = RR_HILO_READ,
+    [I_STC] = RR_WRITEBACK,
+    [I_STC2] = RR_WRITEBACK,
+    [I_STM] = RR_WRITEBACK,
+    [I_STMDA] = RR_WRITEBACK,
+    [I_STMDB] = RR_WRITEBACK,
+    [I_STMIB] = RR_WRITEBACK,
+    [I_STR] = RR_WRITEBACK,
+    [I_STRB] = RR_WRITEBACK,
+    [I_STRBT] = RR_WRITEBACK,
+    [I_STRD] = RR_RT_PAIR | RR_WRITEBACK,
+    [I_STREXD] = RR_RT_PAIR,
+    [I_STRH] = RR_WRITEBACK,
+    [I_STRHT] = RR_WRITEBACK,
+    [I_STRT] = RR_WRITEBACK,
+    [I_SWP] = RR_RT_WRITE,
+    [I_SWPB] = RR_RT_WRITE,
+    [I_TBB] = RR_PC_WRITE,
+    [I_TBH] = RR_PC_WRITE,
+    [I_TEQ] = RR_RD_NONE,
+    [I_TST] = RR_RD_NONE,
+    [I_UMAAL] = RR_HILO_READ,
+    [I_UMLAL] = RR_HILO_READ,
+};
+
+const uint16_t darm_semrules[354] = {
+    [I_ADC] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_WRITES_V | SEM_READS_C,
+    [I_ADD] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_WRITES_V,
+    [I_ADDW] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_WRITES_V,
+    [I_AND] = SEM_WRITES_NZ | SEM_WRITES_C,
+    [I_ASR] = SEM_WRITES_NZ | SEM_WRITES_C,
+    [I_BIC] = SEM_WRITES_NZ | SEM_WRITES_C,
+    [I_CMN] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_WRITES_V | SEM_FLAGS_ALWAYS,
+    [I_CMP] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_WRITES_V | SEM_FLAGS_ALWAYS,
+    [I_EOR] = SEM_WRITES_NZ | SEM_WRITES_C,
+    [I_LDM] = SEM_LOAD | SEM_MULTI,
+    [I_LDMDA] = SEM_LOAD | SEM_MULTI,
+    [I_LDMDB] = SEM_LOAD | SEM_MULTI,
+    [I_LDMIB] = SEM_LOAD | SEM_MULTI,
+    [I_LDR] = SEM_LOAD,
+    [I_LDRB] = SEM_LOAD | SEM_BYTE,
+    [I_LDRBT] = SEM_LOAD | SEM_BYTE,
+    [I_LDRD] = SEM_LOAD | SEM_DUAL,
+    [I_LDREX] = SEM_LOAD | SEM_EXCLUSIVE,
+    [I_LDREXB] = SEM_LOAD | SEM_BYTE | SEM_EXCLUSIVE,
+    [I_LDREXD] = SEM_LOAD | SEM_DUAL | SEM_EXCLUSIVE,
+    [I_LDREXH] = SEM_LOAD | SEM_HALF | SEM_EXCLUSIVE,
+    [I_LDRH] = SEM_LOAD | SEM_HALF,
+    [I_LDRHT] = SEM_LOAD | SEM_HALF,
+    [I_LDRSB] = SEM_LOAD | SEM_BYTE | SEM_SIGNED,
+    [I_LDRSBT] = SEM_LOAD | SEM_BYTE | SEM_SIGNED,
+    [I_LDRSH] = SEM_LOAD | SEM_HALF | SEM_SIGNED,
+    [I_LDRSHT] = SEM_LOAD | SEM_HALF | SEM_SIGNED,
+    [I_LDRT] = SEM_LOAD,
+    [I_LSL] = SEM_WRITES_NZ | SEM_WRITES_C,
+    [I_LSR] = SEM_WRITES_NZ | SEM_WRITES_C,
+    [I_MLA] = SEM_WRITES_NZ,
+    [I_MOV] = SEM_WRITES_NZ | SEM_WRITES_C,
+    [I_MRS] = SEM_READS_NZCV,
+    [I_MSR] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_WRITES_V | SEM_FLAGS_ALWAYS,
+    [I_MUL] = SEM_WRITES_NZ,
+    [I_MVN] = SEM_WRITES_NZ | SEM_WRITES_C,
+    [I_ORN] = SEM_WRITES_NZ | SEM_WRITES_C,
+    [I_ORR] = SEM_WRITES_NZ | SEM_WRITES_C,
+    [I_POP] = SEM_LOAD | SEM_MULTI,
+    [I_PUSH] = SEM_STORE | SEM_MULTI,
+    [I_ROR] = SEM_WRITES_NZ | SEM_WRITES_C,
+    [I_RRX] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_READS_C,
+    [I_RSB] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_WRITES_V,
+    [I_RSC] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_WRITES_V | SEM_READS_C,
+    [I_SBC] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_WRITES_V | SEM_READS_C,
+    [I_SMLAL] = SEM_WRITES_NZ,
+    [I_SMULL] = SEM_WRITES_NZ,
+    [I_STM] = SEM_STORE | SEM_MULTI,
+    [I_STMDA] = SEM_STORE | SEM_MULTI,
+    [I_STMDB] = SEM_STORE | SEM_MULTI,
+    [I_STMIB] = SEM_STORE | SEM_MULTI,
+    [I_STR] = SEM_STORE,
+    [I_STRB] = SEM_STORE | SEM_BYTE,
+    [I_STRBT] = SEM_STORE | SEM_BYTE,
+    [I_STRD] = SEM_STORE | SEM_DUAL,
+    [I_STREX] = SEM_STORE | SEM_EXCLUSIVE,
+    [I_STREXB] = SEM_STORE | SEM_BYTE | SEM_EXCLUSIVE,
+    [I_STREXD] = SEM_STORE | SEM_DUAL | SEM_EXCLUSIVE,
+    [I_STREXH] = SEM_STORE | SEM_HALF | SEM_EXCLUSIVE,
+    [I_STRH] = SEM_STORE | SEM_HALF,
+    [I_STRHT] = SEM_STORE | SEM_HALF,
+    [I_STRT] = SEM_STORE,
+    [I_SUB] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_WRITES_V,
+    [I_SUBW] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_WRITES_V,
+    [I_SWP] = SEM_LOAD | SEM_STORE,
+    [I_SWPB] = SEM_LOAD | SEM_STORE | SEM_BYTE,
+    [I_TBB] = SEM_LOAD | SEM_BYTE,
+    [I_TBH] = SEM_LOAD | SEM_HALF,
+    [I_TEQ] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_FLAGS_ALWAYS,
+    [I_TST] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_FLAGS_ALWAYS,
+    [I_UMLAL] = SEM_WRITES_NZ,
+    [I_UMULL] = SEM_WRITES_NZ,
+};
+
+const darm_pattern_t darm_patterns[552] = {
+    {0x0fe00000, 0x02a00000, ISA_ARMV7, I_ADC},
+    {0x0fe00010, 0x00a00000, ISA_ARMV7, I_ADC},
+    {0x0fe00090, 0x00a00010, ISA_ARMV7, I_ADC},
+    {0x0fe00000, 0x02800000, ISA_ARMV7, I_ADD},
+    {0x0fe00010, 0x00800000, ISA_ARMV7, I_ADD},
+    {0x0fe00090, 0x00800010, ISA_ARMV7, I_ADD},
+    {0x0fff0000, 0x028f0000, ISA_ARMV7, I_ADR},
+    {0x0fff0000, 0x024f0000, ISA_ARMV7, I_ADR},
+    {0x0fe00000, 0x02000000, ISA_ARMV7, I_AND},
+    {0x0fe00010, 0x00000000, ISA_ARMV7, I_AND},
+    {0x0fe00090, 0x00000010, ISA_ARMV7, I_AND},
+    {0x0fef0070, 0x01a00040, ISA_ARMV7, I_ASR},
+    {0x0fef00f0, 0x01a00050, ISA_ARMV7, I_ASR},
+    {0x0f000000, 0x0a000000, ISA_ARMV7, I_B},
+    {0x0fe0007f, 0x07c0001f, ISA_ARMV7, I_BFC},
+    {0x0fe00070, 0x07c00010, ISA_ARMV7, I_BFI},
+    {0x0fe00000, 0x03c00000, ISA_ARMV7, I_BIC},
+    {0x0fe00010, 0x01c00000, ISA_ARMV7, I_BIC},
+    {0x0fe00090, 0x01c00010, ISA_ARMV7, I_BIC},
+    {0x0ff000f0, 0x01200070, ISA_ARMV7, I_BKPT},
+    {0x0f000000, 0x0b000000, ISA_ARMV7, I_BL},
+    {0xfe000000, 0xfa000000, ISA_ARMV7, I_BLX},
+    {0x0ffffff0, 0x012fff30, ISA_ARMV7, I_BLX},
+    {0x0ffffff0, 0x012fff10, ISA_ARMV7, I_BX},
+    {0x0ffffff0, 0x012fff20, ISA_ARMV7, I_BXJ},
+    {0x0f000010, 0x0e000000, ISA_ARMV7, I_CDP},
+    {0xff000010, 0xfe000000, ISA_ARMV7, I_CDP2},
+    {0xffffffff, 0xf57ff01f, ISA_ARMV7, I_CLREX},
+    {0x0fff0ff0, 0x016f0f10, ISA_ARMV7, I_CLZ},
+    {0x0ff0f000, 0x03700000, ISA_ARMV7, I_CMN},
+    {0x0ff0f010, 0x01700000, ISA_ARMV7, I_CMN},
+    {0x0ff0f090, 0x01700010, ISA_ARMV7, I_CMN},
+    {0x0ff0f000, 0x03500000, ISA_ARMV7, I_CMP},
+    {0x0ff0f010, 0x01500000, ISA_ARMV7, I_CMP},
+    {0x0ff0f090, 0x01500010, ISA_ARMV7, I_CMP},
+    {0x0ffffff0, 0x0320f0f0, ISA_ARMV7, I_DBG},
+    {0xfffffff0, 0xf57ff050, ISA_ARMV7, I_DMB},
+    {0xfffffff0, 0xf57ff040, ISA_ARMV7, I_DSB},
+    {0x0fe00000, 0x02200000, ISA_ARMV7, I_EOR},
+    {0x0fe00010, 0x00200000, ISA_ARMV7, I_EOR},
+    {0x0fe00090, 0x00200010, ISA_ARMV7, I_EOR},
+    {0xfffffff0, 0xf57ff060, ISA_ARMV7, I_ISB},
+    {0x0e100000, 0x0c100000, ISA_ARMV7, I_LDC},
+    {0xfe100000, 0xfc100000, ISA_ARMV7, I_LDC2},
+    {0x0fd00000, 0x08900000, ISA_ARMV7, I_LDM},
+    {0x0fd00000, 0x08100000, ISA_ARMV7, I_LDMDA},
+    {0x0fd00000, 0x09100000, ISA_ARMV7, I_LDMDB},
+    {0x0fd00000, 0x09900000, ISA_ARMV7, I_LDMIB},
+    {0x0e500000, 0x04100000, ISA_ARMV7, I_LDR},
+    {0x0e500010, 0x06100000, ISA_ARMV7, I_LDR},
+    {0x0e500000, 0x04500000, ISA_ARMV7, I_LDRB},
+    {0x0e500010, 0x06500000, ISA_ARMV7, I_LDRB},
+    {0x0f700000, 0x04700000, ISA_ARMV7, I_LDRBT},
+    {0x0f700010, 0x06700000, ISA_ARMV7, I_LDRBT},
+    {0x0e5000f0, 0x004000d0, ISA_ARMV7, I_LDRD},
+    {0x0e500ff0, 0x000000d0, ISA_ARMV7, I_LDRD},
+    {0x0ff00fff, 0x01900f9f, ISA_ARMV7, I_LDREX},
+    {0x0ff00fff, 0x01d00f9f, ISA_ARMV7, I_LDREXB},
+    {0x0ff00fff, 0x01b00f9f, ISA_ARMV7, I_LDREXD},
+    {0x0ff00fff, 0x01f00f9f, ISA_ARMV7, I_LDREXH},
+    {0x0e5000f0, 0x005000b0, ISA_ARMV7, I_LDRH},
+    {0x0e500ff0, 0x001000b0, ISA_ARMV7, I_LDRH},
+    {0x0f7000f0, 0x007000b0, ISA_ARMV7, I_LDRHT},
+    {0x0f700ff0, 0x003000b0, ISA_ARMV7, I_LDRHT},
+    {0x0e5000f0, 0x005000d0, ISA_ARMV7, I_LDRSB},
+    {0x0e500ff0, 0x001000d0, ISA_ARMV7, I_LDRSB},
+    {0x0f7000f0, 0x007000d0, ISA_ARMV7, I_LDRSBT},
+    {0x0f700ff0, 0x003000d0, ISA_ARMV7, I_LDRSBT},
+    {0x0e5000f0, 0x005000f0, ISA_ARMV7, I_LDRSH},
+    {0x0e500ff0, 0x001000f0, ISA_ARMV7, I_LDRSH},
+    {0x0f7000f0, 0x007000f0, ISA_ARMV7, I_LDRSHT},
+    {0x0f700ff0, 0x003000f0, ISA_ARMV7, I_LDRSHT},
+    {0x0f700000, 0x04300000, ISA_ARMV7, I_LDRT},
+    {0x0f700010, 0x06300000, ISA_ARMV7, I_LDRT},
+    {0x0fef0070, 0x01a00000, ISA_ARMV7, I_LSL},
+    {0x0fef00f0, 0x01a00010, ISA_ARMV7, I_LSL},
+    {0x0fef0070, 0x01a00020, ISA_ARMV7, I_LSR},
+    {0x0fef00f0, 0x01a00030, ISA_ARMV7, I_LSR},
+    {0x0f100010, 0x0e000010, ISA_ARMV7, I_MCR},
+    {0xff100010, 0xfe000010, ISA_ARMV7, I_MCR2},
+    {0x0ff00000, 0x0c400000, ISA_ARMV7, I_MCRR},
+    {0xfff00000, 0xfc400000, ISA_ARMV7, I_MCRR2},
+    {0x0fe000f0, 0x00200090, ISA_ARMV7, I_MLA},
+    {0x0ff000f0, 0x00600090, ISA_ARMV7, I_MLS},
+    {0x0fef0000, 0x03a00000, ISA_ARMV7, I_MOV},
+    {0x0ff00000, 0x03000000, ISA_ARMV7, I_MOVW},
+    {0x0fef0ff0, 0x01a00000, ISA_ARMV7, I_MOV},
+    {0x0ff00000, 0x03400000, ISA_ARMV7, I_MOVT},
+    {0x0f100010, 0x0e100010, ISA_ARMV7, I_MRC},
+    {0xff100010, 0xfe100010, ISA_ARMV7, I_MRC2},
+    {0x0ff00000, 0x0c500000, ISA_ARMV7, I_MRRC},
+    {0x0fff0fff, 0x010f0000, ISA_ARMV7, I_MRS},
+    {0xfff00000, 0xfc500000, ISA_ARMV7, I_MRRC2},
+    {0x0ff3f000, 0x0320f000, ISA_ARMV7, I_MSR},
+    {0x0ff3fff0, 0x0120f000, ISA_ARMV7, I_MSR},
+    {0x0fe0f0f0, 0x00000090, ISA_ARMV7, I_MUL},
+    {0x0fef0000, 0x03e00000, ISA_ARMV7, I_MVN},
+    {0x0fef0010, 0x01e00000, ISA_ARMV7, I_MVN},
+    {0x0fef0090, 0x01e00010, ISA_ARMV7, I_MVN},
+    {0x0fffffff, 0x0320f000, ISA_ARMV7, I_NOP},
+    {0x0fe00000, 0x03800000, ISA_ARMV7, I_ORR},
+    {0x0fe00010, 0x01800000, ISA_ARMV7, I_ORR},
+    {0x0fe00090, 0x01800010, ISA_ARMV7, I_ORR},
+    {0x0ff00030, 0x06800010, ISA_ARMV7, I_PKH},
+    {0xff30f000, 0xf510f000, ISA_ARMV7, I_PLD},
+    {0xff30f010, 0xf710f000, ISA_ARMV7, I_PLD},
+    {0xff70f000, 0xf450f000, ISA_ARMV7, I_PLI},
+    {0xff70f010, 0xf650f000, ISA_ARMV7, I_PLI},
+    {0x0fff0000, 0x08bd0000, ISA_ARMV7, I_POP},
+    {0x0fff0fff, 0x049d0004, ISA_ARMV7, I_POP},
+    {0x0fff0000, 0x092d0000, ISA_ARMV7, I_PUSH},
+    {0x0fff0fff, 0x052d0004, ISA_ARMV7, I_PUSH},
+    {0x0ff00ff0, 0x01000050, ISA_ARMV7, I_QADD},
+    {0x0ff00ff0, 0x06200f10, ISA_ARMV7, I_QADD16},
+    {0x0ff00ff0, 0x06200f90, ISA_ARMV7, I_QADD8},
+    {0x0ff00ff0, 0x06200f30, ISA_ARMV7, I_QASX},
+    {0x0ff00ff0, 0x01400050, ISA_ARMV7, I_QDADD},
+    {0x0ff00ff0, 0x01600050, ISA_ARMV7, I_QDSUB},
+    {0x0ff00ff0, 0x06200f50, ISA_ARMV7, I_QSAX},
+    {0x0ff00ff0, 0x01200050, ISA_ARMV7, I_QSUB},
+    {0x0ff00ff0, 0x06200f70, ISA_ARMV7, I_QSUB16},
+    {0x0ff00ff0, 0x06200ff0, ISA_ARMV7, I_QSUB8},
+    {0x0fff0ff0, 0x06ff0f30, ISA_ARMV7, I_RBIT},
+    {0x0fff0ff0, 0x06bf0f30, ISA_ARMV7, I_REV},
+    {0x0fff0ff0, 0x06bf0fb0, ISA_ARMV7, I_REV16},
+    {0x0fff0ff0, 0x06ff0fb0, ISA_ARMV7, I_REVSH},
+    {0x0fef0070, 0x01a00060, ISA_ARMV7, I_ROR},
+    {0x0fef00f0, 0x01a00070, ISA_ARMV7, I_ROR},
+    {0x0fef0ff0, 0x01a00060, ISA_ARMV7, I_RRX},
+    {0x0fe00000, 0x02600000, ISA_ARMV7, I_RSB},
+    {0x0fe00010, 0x00600000, ISA_ARMV7, I_RSB},
+    {0x0fe00090, 0x00600010, ISA_ARMV7, I_RSB},
+    {0x0fe00000, 0x02e00000, ISA_ARMV7, I_RSC},
+    {0x0fe00010, 0x00e00000, ISA_ARMV7, I_RSC},
+    {0x0fe00090, 0x00e00010, ISA_ARMV7, I_RSC},
+    {0x0ff00ff0, 0x06100f10, ISA_ARMV7, I_SADD16},
+    {0x0ff00ff0, 0x06100f90, ISA_ARMV7, I_SADD8},
+    {0x0ff00ff0, 0x06100f30, ISA_ARMV7, I_SASX},
+    {0x0fe00000, 0x02c00000, ISA_ARMV7, I_SBC},
+    {0x0fe00010, 0x00c00000, ISA_ARMV7, I_SBC},
+    {0x0fe00090, 0x00c00010, ISA_ARMV7, I_SBC},
+    {0x0fe00070, 0x07a00050, ISA_ARMV7, I_SBFX},
+    {0x0ff00ff0, 0x06800fb0, ISA_ARMV7, I_SEL},
+    {0xfffffdff, 0xf1010000, ISA_ARMV7, I_SETEND},
+    {0x0fffffff, 0x0320f004, ISA_ARMV7, I_SEV},
+    {0x0ff00ff0, 0x06300f10, ISA_ARMV7, I_SHADD16},
+    {0x0ff00ff0, 0x06300f90, ISA_ARMV7, I_SHADD8},
+    {0x0ff00ff0, 0x06300f30, ISA_ARMV7, I_SHASX},
+    {0x0ff00ff0, 0x06300f50, ISA_ARMV7, I_SHSAX},
+    {0x0ff00ff0, 0x06300f70, ISA_ARMV7, I_SHSUB16},
+    {0x0ff00ff0, 0x06300ff0, ISA_ARMV7, I_SHSUB8},
+    {0x0ff00090, 0x01000080, ISA_ARMV7, I_SMLA},
+    {0x0ff000d0, 0x07000010, ISA_ARMV7, I_SMLAD},
+    {0x0fe000f0, 0x00e00090, ISA_ARMV7, I_SMLAL},
+    {0x0ff00090, 0x01400080, ISA_ARMV7, I_SMLAL},
+    {0x0ff000d0, 0x07400010, ISA_ARMV7, I_SMLALD},
+    {0x0ff000b0, 0x01200080, ISA_ARMV7, I_SMLAW},
+    {0x0ff000d0, 0x07000050, ISA_ARMV7, I_SMLSD},
+    {0x0ff000d0, 0x07400050, ISA_ARMV7, I_SMLSLD},
+    {0x0ff000d0, 0x07500010, ISA_ARMV7, I_SMMLA},
+    {0x0ff000d0, 0x075000d0, ISA_ARMV7, I_SMMLS},
+    {0x0ff0f0d0, 0x0750f010, ISA_ARMV7, I_SMMUL},
+    {0x0ff0f0d0, 0x0700f010, ISA_ARMV7, I_SMUAD},
+    {0x0ff0f090, 0x01600080, ISA_ARMV7, I_SMUL},
+    {0x0fe000f0, 0x00c00090, ISA_ARMV7, I_SMULL},
+    {0x0ff0f0b0, 0x012000a0, ISA_ARMV7, I_SMULW},
+    {0x0ff0f0d0, 0x0700f050, ISA_ARMV7, I_SMUSD},
+    {0x0fe00030, 0x06a00010, ISA_ARMV7, I_SSAT},
+    {0x0ff00ff0, 0x06a00f30, ISA_ARMV7, I_SSAT16},
+    {0x0ff00ff0, 0x06100f50, ISA_ARMV7, I_SSAX},
+    {0x0ff00ff0, 0x06100f70, ISA_ARMV7, I_SSUB16},
+    {0x0ff00ff0, 0x06100ff0, ISA_ARMV7, I_SSUB8},
+    {0x0e100000, 0x0c000000, ISA_ARMV7, I_STC},
+    {0xfe100000, 0xfc000000, ISA_ARMV7, I_STC2},
+    {0x0fd00000, 0x08800000, ISA_ARMV7, I_STM},
+    {0x0fd00000, 0x08000000, ISA_ARMV7, I_STMDA},
+    {0x0fd00000, 0x09000000, ISA_ARMV7, I_STMDB},
+    {0x0fd00000, 0x09800000, ISA_ARMV7, I_STMIB},
+    {0x0e500000, 0x04000000, ISA_ARMV7, I_STR},
+    {0x0e500010, 0x06000000, ISA_ARMV7, I_STR},
+    {0x0e500000, 0x04400000, ISA_ARMV7, I_STRB},
+    {0x0e500010, 0x06400000, ISA_ARMV7, I_STRB},
+    {0x0f700000, 0x04600000, ISA_ARMV7, I_STRBT},
+    {0x0f700010, 0x06600000, ISA_ARMV7, I_STRBT},
+    {0x0e5000f0, 0x004000f0, ISA_ARMV7, I_STRD},
+    {0x0e500ff0, 0x000000f0, ISA_ARMV7, I_STRD},
+    {0x0ff00ff0, 0x01800f90, ISA_ARMV7, I_STREX},
+    {0x0ff00ff0, 0x01c00f90, ISA_ARMV7, I_STREXB},
+    {0x0ff00ff0, 0x01a00f90, ISA_ARMV7, I_STREXD},
+    {0x0ff00ff0, 0x01e00f90, ISA_ARMV7, I_STREXH},
+    {0x0e5000f0, 0x004000b0, ISA_ARMV7, I_STRH},
+    {0x0e500ff0, 0x000000b0, ISA_ARMV7, I_STRH},
+    {0x0f7000f0, 0x006000b0, ISA_ARMV7, I_STRHT},
+    {0x0f700ff0, 0x002000b0, ISA_ARMV7, I_STRHT},
+    {0x0f700000, 0x04200000, ISA_ARMV7, I_STRT},
+    {0x0f700010, 0x06200000, ISA_ARMV7, I_STRT},
+    {0x0fe00000, 0x02400000, ISA_ARMV7, I_SUB},
+    {0x0fe00010, 0x00400000, ISA_ARMV7, I_SUB},
+    {0x0fe00090, 0x00400010, ISA_ARMV7, I_SUB},
+    {0x0f000000, 0x0f000000, ISA_ARMV7, I_SVC},
+    {0x0ff00ff0, 0x01000090, ISA_ARMV7, I_SWP},
+    {0x0ff00ff0, 0x01400090, ISA_ARMV7, I_SWPB},
+    {0x0ff003f0, 0x06a00070, ISA_ARMV7, I_SXTAB},
+    {0x0ff003f0, 0x06800070, ISA_ARMV7, I_SXTAB16},
+    {0x0ff003f0, 0x06b00070, ISA_ARMV7, I_SXTAH},
+    {0x0fff03f0, 0x06af0070, ISA_ARMV7, I_SXTB},
+    {0x0fff03f0, 0x068f0070, ISA_ARMV7, I_SXTB16},
+    {0x0fff03f0, 0x06bf0070, ISA_ARMV7, I_SXTH},
+    {0x0ff0f000, 0x03300000, ISA_ARMV7, I_TEQ},
+    {0x0ff0f010, 0x01300000, ISA_ARMV7, I_TEQ},
+    {0x0ff0f090, 0x01300010, ISA_ARMV7, I_TEQ},
+    {0x0ff0f000, 0x03100000, ISA_ARMV7, I_TST},
+    {0x0ff0f010, 0x01100000, ISA_ARMV7, I_TST},
+    {0x0ff0f090, 0x01100010, ISA_ARMV7, I_TST},
+    {0x0ff00ff0, 0x06500f10, ISA_ARMV7, I_UADD16},
+    {0x0ff00ff0, 0x06500f90, ISA_ARMV7, I_UADD8},
+    {0x0ff00ff0, 0x06500f30, ISA_ARMV7, I_UASX},
+    {0x0fe00070, 0x07e00050, ISA_ARMV7, I_UBFX},
+    {0x0ff000f0, 0x07f000f0, ISA_ARMV7, I_UDF},
+    {0x0ff00ff0, 0x06700f10, ISA_ARMV7, I_UHADD16},
+    {0x0ff00ff0, 0x06700f90, ISA_ARMV7, I_UHADD8},
+    {0x0ff00ff0, 0x06700f30, ISA_ARMV7, I_UHASX},
+    {0x0ff00ff0, 0x06700f50, ISA_ARMV7, I_UHSAX},
+    {0x0ff00ff0, 0x06700f70, ISA_ARMV7, I_UHSUB16},
+    {0x0ff00ff0, 0x06700ff0, ISA_ARMV7, I_UHSUB8},
+    {0x0ff000f0, 0x00400090, ISA_ARMV7, I_UMAAL},
+    {0x0fe000f0, 0x00a00090, ISA_ARMV7, I_UMLAL},
+    {0x0fe000f0, 0x00800090, ISA_ARMV7, I_UMULL},
+    {0x0ff00ff0, 0x06600f10, ISA_ARMV7, I_UQADD16},
+    {0x0ff00ff0, 0x06600f90, ISA_ARMV7, I_UQADD8},
+    {0x0ff00ff0, 0x06600f30, ISA_ARMV7, I_UQASX},
+    {0x0ff00ff0, 0x06600f50, ISA_ARMV7, I_UQSAX},
+    {0x0ff00ff0, 0x06600f70, ISA_ARMV7, I_UQSUB16},
+    {0x0ff00ff0, 0x06600ff0, ISA_ARMV7, I_UQSUB8},
+    {0x0ff0f0f0, 0x0780f010, ISA_ARMV7, I_USAD8},
+    {0x0ff000f0, 0x07800010, ISA_ARMV7, I_USADA8},
+    {0x0fe00030, 0x06e00010, ISA_ARMV7, I_USAT},
+    {0x0ff00ff0, 0x06e00f30, ISA_ARMV7, I_USAT16},
+    {0x0ff00ff0, 0x06500f50, ISA_ARMV7, I_USAX},
+    {0x0ff00ff0, 0x06500f70, ISA_ARMV7, I_USUB16},
+    {0x0ff00ff0, 0x06500ff0, ISA_ARMV7, I_USUB8},
+    {0x0ff003f0, 0x06e00070, ISA_ARMV7, I_UXTAB},
+    {0x0ff003f0, 0x06c00070, ISA_ARMV7, I_UXTAB16},
+    {0x0ff003f0, 0x06f00070, ISA_ARMV7, I_UXTAH},
+    {0x0fff03f0, 0x06ef0070, ISA_ARMV7, I_UXTB},
+    {0x0fff03f0, 0x06cf0070, ISA_ARMV7, I_UXTB16},
+    {0x0fff03f0, 0x06ff0070, ISA_ARMV7, I_UXTH},
+    {0x0fffffff, 0x0320f002, ISA_ARMV7, I_WFE},
+    {0x0fffffff, 0x0320f003, ISA_ARMV7, I_WFI},
+    {0x0fffffff, 0x0320f001, ISA_ARMV7, I_YIELD},
+    {0x0fbf0fff, 0x010f0000, ISA_ARMV7, I_MRS},
+    {0x0ffffff0, 0x01600070, ISA_ARMV7, I_SMC},
+    {0xfbe08000, 0xf1400000, ISA_THUMB2, I_ADC},
+    {0xffc00000, 0x41400000, ISA_THUMB, I_ADC},
+    {0xffe08000, 0xeb400000, ISA_THUMB2, I_ADC},
+    {0xfe000000, 0x1c000000, ISA_THUMB, I_ADD},
+    {0xf8000000, 0x30000000, ISA_THUMB, I_ADD},
+    {0xfbe08000, 0xf1000000, ISA_THUMB2, I_ADD},
+    {0xfbf08000, 0xf2000000, ISA_THUMB2, I_ADDW},
+    {0xfe000000, 0x18000000, ISA_THUMB, I_ADD},
+    {0xffe08000, 0xeb000000, ISA_THUMB2, I_ADD},
+    {0xf8000000, 0xa8000000, ISA_THUMB, I_ADD},
+    {0xff800000, 0xb0000000, ISA_THUMB, I_ADD},
+    {0xfbef8000, 0xf10d0000, ISA_THUMB2, I_ADD},
+    {0xfbff8000, 0xf20d0000, ISA_THUMB2, I_ADDW},
+    {0xff870000, 0x44850000, ISA_THUMB, I_ADD},
+    {0xffef8000, 0xeb0d0000, ISA_THUMB2, I_ADD},
+    {0xf8000000, 0xa0000000, ISA_THUMB, I_ADR},
+    {0xfbff8000, 0xf2af0000, ISA_THUMB2, I_ADR},
+    {0xfbff8000, 0xf20f0000, ISA_THUMB2, I_ADR},
+    {0xfbe08000, 0xf0000000, ISA_THUMB2, I_AND},
+    {0xffc00000, 0x40000000, ISA_THUMB, I_AND},
+    {0xffe08000, 0xea000000, ISA_THUMB2, I_AND},
+    {0xf8000000, 0x10000000, ISA_THUMB, I_ASR},
+    {0xffef8030, 0xea4f0020, ISA_THUMB2, I_ASR},
+    {0xffc00000, 0x41000000, ISA_THUMB, I_ASR},
+    {0xffe0f0f0, 0xfa40f000, ISA_THUMB2, I_ASR},
+    {0xf0000000, 0xd0000000, ISA_THUMB, I_B},
+    {0xf8000000, 0xe0000000, ISA_THUMB, I_B},
+    {0xf800d000, 0xf0008000, ISA_THUMB2, I_B},
+    {0xf800d000, 0xf0009000, ISA_THUMB2, I_B},
+    {0xffff8020, 0xf36f0000, ISA_THUMB2, I_BFC},
+    {0xfff08020, 0xf3600000, ISA_THUMB2, I_BFI},
+    {0xfbe08000, 0xf0200000, ISA_THUMB2, I_BIC},
+    {0xffc00000, 0x43800000, ISA_THUMB, I_BIC},
+    {0xffe08000, 0xea200000, ISA_THUMB2, I_BIC},
+    {0xff000000, 0xbe000000, ISA_THUMB, I_BKPT},
+    {0xf800d000, 0xf000d000, ISA_THUMB2, I_BL},
+    {0xf800d000, 0xf000c000, ISA_THUMB2, I_BLX},
+    {0xff870000, 0x47800000, ISA_THUMB, I_BLX},
+    {0xff870000, 0x47000000, ISA_THUMB, I_BX},
+    {0xfff0ffff, 0xf3c08f00, ISA_THUMB2, I_BXJ},
+    {0xf5000000, 0xb1000000, ISA_THUMB, I_CBZ},
+    {0xffffffff, 0xf3bf8f2f, ISA_THUMB2, I_CLREX},
+    {0xfff0f0f0, 0xfab0f080, ISA_THUMB2, I_CLZ},
+    {0xfbf08f00, 0xf1100f00, ISA_THUMB2, I_CMN},
+    {0xffc00000, 0x42c00000, ISA_THUMB, I_CMN},
+    {0xfff08f00, 0xeb100f00, ISA_THUMB2, I_CMN},
+    {0xf8000000, 0x28000000, ISA_THUMB, I_CMP},
+    {0xfbf08f00, 0xf1b00f00, ISA_THUMB2, I_CMP},
+    {0xffc00000, 0x42800000, ISA_THUMB, I_CMP},
+    {0xff000000, 0x45000000, ISA_THUMB, I_CMP},
+    {0xfff08f00, 0xebb00f00, ISA_THUMB2, I_CMP},
+    {0xfffffff0, 0xf3af80f0, ISA_THUMB2, I_DBG},
+    {0xfffffff0, 0xf3bf8f50, ISA_THUMB2, I_DMB},
+    {0xfffffff0, 0xf3bf8f40, ISA_THUMB2, I_DSB},
+    {0xfbe08000, 0xf0800000, ISA_THUMB2, I_EOR},
+    {0xffc00000, 0x40400000, ISA_THUMB, I_EOR},
+    {0xffe08000, 0xea800000, ISA_THUMB2, I_EOR},
+    {0xfffffff0, 0xf3bf8f60, ISA_THUMB2, I_ISB},
+    {0xff000000, 0xbf000000, ISA_THUMB, I_IT},
+    {0xf8000000, 0xc8000000, ISA_THUMB, I_LDM},
+    {0xffd00000, 0xe8900000, ISA_THUMB2, I_LDM},
+    {0xffd00000, 0xe9100000, ISA_THUMB2, I_LDMDB},
+    {0xf8000000, 0x68000000, ISA_THUMB, I_LDR},
+    {0xf8000000, 0x98000000, ISA_THUMB, I_LDR},
+    {0xfff00000, 0xf8d00000, ISA_THUMB2, I_LDR},
+    {0xfff00800, 0xf8500800, ISA_THUMB2, I_LDR},
+    {0xf8000000, 0x48000000, ISA_THUMB, I_LDR},
+    {0xff7f0000, 0xf85f0000, ISA_THUMB2, I_LDR},
+    {0xfe000000, 0x58000000, ISA_THUMB, I_LDR},
+    {0xfff00fc0, 0xf8500000, ISA_THUMB2, I_LDR},
+    {0xf8000000, 0x78000000, ISA_THUMB, I_LDRB},
+    {0xfff00000, 0xf8900000, ISA_THUMB2, I_LDRB},
+    {0xfff00800, 0xf8100800, ISA_THUMB2, I_LDRB},
+    {0xff7f0000, 0xf81f0000, ISA_THUMB2, I_LDRB},
+    {0xfe000000, 0x5c000000, ISA_THUMB, I_LDRB},
+    {0xfff00fc0, 0xf8100000, ISA_THUMB2, I_LDRB},
+    {0xfff00f00, 0xf8100e00, ISA_THUMB2, I_LDRBT},
+    {0xfe500000, 0xe8500000, ISA_THUMB2, I_LDRD},
+    {0xfe5f0000, 0xe85f0000, ISA_THUMB2, I_LDRD},
+    {0xfff00f00, 0xe8500f00, ISA_THUMB2, I_LDREX},
+    {0xfff00fff, 0xe8d00f4f, ISA_THUMB2, I_LDREXB},
+    {0xfff000ff, 0xe8d0007f, ISA_THUMB2, I_LDREXD},
+    {0xfff00fff, 0xe8d00f5f, ISA_THUMB2, I_LDREXH},
+    {0xf8000000, 0x88000000, ISA_THUMB, I_LDRH},
+    {0xfff00000, 0xf8b00000, ISA_THUMB2, I_LDRH},
+    {0xfff00800, 0xf8300800, ISA_THUMB2, I_LDRH},
+    {0xff7f0000, 0xf83f0000, ISA_THUMB2, I_LDRH},
+    {0xfe000000, 0x5a000000, ISA_THUMB, I_LDRH},
+    {0xfff00fc0, 0xf8300000, ISA_THUMB2, I_LDRH},
+    {0xfff00f00, 0xf8300e00, ISA_THUMB2, I_LDRHT},
+    {0xfff00000, 0xf9900000, ISA_THUMB2, I_LDRSB},
+    {0xfff00800, 0xf9100800, ISA_THUMB2, I_LDRSB},
+    {0xff7f0000, 0xf91f0000, ISA_THUMB2, I_LDRSB},
+    {0xfe000000, 0x56000000, ISA_THUMB, I_LDRSB},
+    {0xfff00fc0, 0xf9100000, ISA_THUMB2, I_LDRSB},
+    {0xfff00f00, 0xf9100e00, ISA_THUMB2, I_LDRSBT},
+    {0xfff00000, 0xf9b00000, ISA_THUMB2, I_LDRSH},
+    {0xfff00800, 0xf9300800, ISA_THUMB2, I_LDRSH},
+    {0xff7f0000, 0xf93f0000, ISA_THUMB2, I_LDRSH},
+    {0xfe000000, 0x5e000000, ISA_THUMB, I_LDRSH},
+    {0xfff00fc0, 0xf9300000, ISA_THUMB2, I_LDRSH},
+    {0xfff00f00, 0xf9300e00, ISA_THUMB2, I_LDRSHT},
+    {0xfff00f00, 0xf8500e00, ISA_THUMB2, I_LDRT},
+    {0xf8000000, 0x00000000, ISA_THUMB, I_LSL},
+    {0xffef8030, 0xea4f0000, ISA_THUMB2, I_LSL},
+    {0xffc00000, 0x40800000, ISA_THUMB, I_LSL},
+    {0xffe0f0f0, 0xfa00f000, ISA_THUMB2, I_LSL},
+    {0xf8000000, 0x08000000, ISA_THUMB, I_LSR},
+    {0xffef8030, 0xea4f0010, ISA_THUMB2, I_LSR},
+    {0xffc00000, 0x40c00000, ISA_THUMB, I_LSR},
+    {0xffe0f0f0, 0xfa20f000, ISA_THUMB2, I_LSR},
+    {0xfff000f0, 0xfb000000, ISA_THUMB2, I_MLA},
+    {0xfff000f0, 0xfb000010, ISA_THUMB2, I_MLS},
+    {0xf8000000, 0x20000000, ISA_THUMB, I_MOV},
+    {0xfbef8000, 0xf04f0000, ISA_THUMB2, I_MOV},
+    {0xfbf08000, 0xf2400000, ISA_THUMB2, I_MOVW},
+    {0xff000000, 0x46000000, ISA_THUMB, I_MOV},
+    {0xffeff0f0, 0xea4f0000, ISA_THUMB2, I_MOV},
+    {0xfbf08000, 0xf2c00000, ISA_THUMB2, I_MOVT},
+    {0xfffff0ff, 0xf3ef8000, ISA_THUMB2, I_MRS},
+    {0xffc00000, 0x43400000, ISA_THUMB, I_MUL},
+    {0xfff0f0f0, 0xfb00f000, ISA_THUMB2, I_MUL},
+    {0xfbef8000, 0xf06f0000, ISA_THUMB2, I_MVN},
+    {0xffc00000, 0x43c00000, ISA_THUMB, I_MVN},
+    {0xffef8000, 0xea6f0000, ISA_THUMB2, I_MVN},
+    {0xffff0000, 0xbf000000, ISA_THUMB, I_NOP},
+    {0xffffffff, 0xf3af8000, ISA_THUMB2, I_NOP},
+    {0xfbe08000, 0xf0600000, ISA_THUMB2, I_ORN},
+    {0xffe08000, 0xea600000, ISA_THUMB2, I_ORN},
+    {0xfbe08000, 0xf0400000, ISA_THUMB2, I_ORR},
+    {0xffc00000, 0x43000000, ISA_THUMB, I_ORR},
+    {0xffe08000, 0xea400000, ISA_THUMB2, I_ORR},
+    {0xffd0f000, 0xf890f000, ISA_THUMB2, I_PLD},
+    {0xffd0ff00, 0xf810fc00, ISA_THUMB2, I_PLD},
+    {0xff7ff000, 0xf81ff000, ISA_THUMB2, I_PLD},
+    {0xffd0ffc0, 0xf810f000, ISA_THUMB2, I_PLD},
+    {0xfff0f000, 0xf990f000, ISA_THUMB2, I_PLI},
+    {0xfff0ff00, 0xf910fc00, ISA_THUMB2, I_PLI},
+    {0xff7ff000, 0xf91ff000, ISA_THUMB2, I_PLI},
+    {0xfff0ffc0, 0xf910f000, ISA_THUMB2, I_PLI},
+    {0xfe000000, 0xbc000000, ISA_THUMB, I_POP},
+    {0xffff0000, 0xe8bd0000, ISA_THUMB2, I_POP},
+    {0xffff0fff, 0xf85d0b04, ISA_THUMB2, I_POP},
+    {0xfe000000, 0xb4000000, ISA_THUMB, I_PUSH},
+    {0xffff0000, 0xe92d0000, ISA_THUMB2, I_PUSH},
+    {0xffff0fff, 0xf84d0d04, ISA_THUMB2, I_PUSH},
+    {0xfff0f0f0, 0xfa80f080, ISA_THUMB2, I_QADD},
+    {0xfff0f0f0, 0xfa90f010, ISA_THUMB2, I_QADD16},
+    {0xfff0f0f0, 0xfa80f010, ISA_THUMB2, I_QADD8},
+    {0xfff0f0f0, 0xfaa0f010, ISA_THUMB2, I_QASX},
+    {0xfff0f0f0, 0xfa80f090, ISA_THUMB2, I_QDADD},
+    {0xfff0f0f0, 0xfa80f0b0, ISA_THUMB2, I_QDSUB},
+    {0xfff0f0f0, 0xfae0f010, ISA_THUMB2, I_QSAX},
+    {0xfff0f0f0, 0xfa80f0a0, ISA_THUMB2, I_QSUB},
+    {0xfff0f0f0, 0xfad0f010, ISA_THUMB2, I_QSUB16},
+    {0xfff0f0f0, 0xfac0f010, ISA_THUMB2, I_QSUB8},
+    {0xfff0f0f0, 0xfa90f0a0, ISA_THUMB2, I_RBIT},
+    {0xffc00000, 0xba000000, ISA_THUMB, I_REV},
+    {0xfff0f0f0, 0xfa90f080, ISA_THUMB2, I_REV},
+    {0xffc00000, 0xba400000, ISA_THUMB, I_REV16},
+    {0xfff0f0f0, 0xfa90f090, ISA_THUMB2, I_REV16},
+    {0xffc00000, 0xbac00000, ISA_THUMB, I_REVSH},
+    {0xfff0f0f0, 0xfa90f0b0, ISA_THUMB2, I_REVSH},
+    {0xffef8030, 0xea4f0030, ISA_THUMB2, I_ROR},
+    {0xffc00000, 0x41c00000, ISA_THUMB, I_ROR},
+    {0xffe0f0f0, 0xfa60f000, ISA_THUMB2, I_ROR},
+    {0xffeff0f0, 0xea4f0030, ISA_THUMB2, I_RRX},
+    {0xffc00000, 0x42400000, ISA_THUMB, I_RSB},
+    {0xfbe08000, 0xf1c00000, ISA_THUMB2, I_RSB},
+    {0xffe08000, 0xebc00000, ISA_THUMB2, I_RSB},
+    {0xfff0f0f0, 0xfa90f000, ISA_THUMB2, I_SADD16},
+    {0xfff0f0f0, 0xfa80f000, ISA_THUMB2, I_SADD8},
+    {0xfff0f0f0, 0xfaa0f000, ISA_THUMB2, I_SASX},
+    {0xfbe08000, 0xf1600000, ISA_THUMB2, I_SBC},
+    {0xffc00000, 0x41800000, ISA_THUMB, I_SBC},
+    {0xffe08000, 0xeb600000, ISA_THUMB2, I_SBC},
+    {0xfff08020, 0xf3400000, ISA_THUMB2, I_SBFX},
+    {0xfff0f0f0, 0xfb90f0f0, ISA_THUMB2, I_SDIV},
+    {0xfff0f0f0, 0xfaa0f080, ISA_THUMB2, I_SEL},
+    {0xfff70000, 0xb6500000, ISA_THUMB, I_SETEND},
+    {0xffff0000, 0xbf400000, ISA_THUMB, I_SEV},
+    {0xffffffff, 0xf3af8004, ISA_THUMB2, I_SEV},
+    {0xfff0f0f0, 0xfa90f020, ISA_THUMB2, I_SHADD16},
+    {0xfff0f0f0, 0xfa80f020, ISA_THUMB2, I_SHADD8},
+    {0xfff0f0f0, 0xfaa0f020, ISA_THUMB2, I_SHASX},
+    {0xfff0f0f0, 0xfae0f020, ISA_THUMB2, I_SHSAX},
+    {0xfff0f0f0, 0xfad0f020, ISA_THUMB2, I_SHSUB16},
+    {0xfff0f0f0, 0xfac0f020, ISA_THUMB2, I_SHSUB8},
+    {0xfff000c0, 0xfb100000, ISA_THUMB2, I_SMLA},
+    {0xfff000e0, 0xfb200000, ISA_THUMB2, I_SMLAD},
+    {0xfff000f0, 0xfbc00000, ISA_THUMB2, I_SMLAL},
+    {0xfff000c0, 0xfbc00080, ISA_THUMB2, I_SMLAL},
+    {0xfff000e0, 0xfbc000c0, ISA_THUMB2, I_SMLALD},
+    {0xfff000e0, 0xfb300000, ISA_THUMB2, I_SMLAW},
+    {0xfff000e0, 0xfb400000, ISA_THUMB2, I_SMLSD},
+    {0xfff000e0, 0xfbd000c0, ISA_THUMB2, I_SMLSLD},
+    {0xfff000e0, 0xfb500000, ISA_THUMB2, I_SMMLA},
+    {0xfff000e0, 0xfb600000, ISA_THUMB2, I_SMMLS},
+    {0xfff0f0e0, 0xfb50f000, ISA_THUMB2, I_SMMUL},
+    {0xfff0f0e0, 0xfb20f000, ISA_THUMB2, I_SMUAD},
+    {0xfff0f0c0, 0xfb10f000, ISA_THUMB2, I_SMUL},
+    {0xfff000f0, 0xfb800000, ISA_THUMB2, I_SMULL},
+    {0xfff0f0e0, 0xfb30f000, ISA_THUMB2, I_SMULW},
+    {0xfff0f0e0, 0xfb40f000, ISA_THUMB2, I_SMUSD},
+    {0xfff0f0f0, 0xfae0f000, ISA_THUMB2, I_SSAX},
+    {0xfff0f0f0, 0xfad0f000, ISA_THUMB2, I_SSUB16},
+    {0xfff0f0f0, 0xfac0f000, ISA_THUMB2, I_SSUB8},
+    {0xf8000000, 0xc0000000, ISA_THUMB, I_STM},
+    {0xffd00000, 0xe8800000, ISA_THUMB2, I_STM},
+    {0xffd00000, 0xe9000000, ISA_THUMB2, I_STMDB},
+    {0xf8000000, 0x60000000, ISA_THUMB, I_STR},
+    {0xf8000000, 0x90000000, ISA_THUMB, I_STR},
+    {0xfff00000, 0xf8c00000, ISA_THUMB2, I_STR},
+    {0xfff00800, 0xf8400800, ISA_THUMB2, I_STR},
+    {0xfe000000, 0x50000000, ISA_THUMB, I_STR},
+    {0xfff00fc0, 0xf8400000, ISA_THUMB2, I_STR},
+    {0xf8000000, 0x70000000, ISA_THUMB, I_STRB},
+    {0xfff00000, 0xf8800000, ISA_THUMB2, I_STRB},
+    {0xfff00800, 0xf8000800, ISA_THUMB2, I_STRB},
+    {0xfe000000, 0x54000000, ISA_THUMB, I_STRB},
+    {0xfff00fc0, 0xf8000000, ISA_THUMB2, I_STRB},
+    {0xfff00f00, 0xf8000e00, ISA_THUMB2, I_STRBT},
+    {0xfe500000, 0xe8400000, ISA_THUMB2, I_STRD},
+    {0xfff00000, 0xe8400000, ISA_THUMB2, I_STREX},
+    {0xfff00ff0, 0xe8c00f40, ISA_THUMB2, I_STREXB},
+    {0xfff000f0, 0xe8c00070, ISA_THUMB2, I_STREXD},
+    {0xfff00ff0, 0xe8c00f50, ISA_THUMB2, I_STREXH},
+    {0xf8000000, 0x80000000, ISA_THUMB, I_STRH},
+    {0xfff00000, 0xf8a00000, ISA_THUMB2, I_STRH},
+    {0xfff00800, 0xf8200800, ISA_THUMB2, I_STRH},
+    {0xfe000000, 0x52000000, ISA_THUMB, I_STRH},
+    {0xfff00fc0, 0xf8200000, ISA_THUMB2, I_STRH},
+    {0xfff00f00, 0xf8200e00, ISA_THUMB2, I_STRHT},
+    {0xfff00f00, 0xf8400e00, ISA_THUMB2, I_STRT},
+    {0xfe000000, 0x1e000000, ISA_THUMB, I_SUB},
+    {0xf8000000, 0x38000000, ISA_THUMB, I_SUB},
+    {0xfbe08000, 0xf1a00000, ISA_THUMB2, I_SUB},
+    {0xfbf08000, 0xf2a00000, ISA_THUMB2, I_SUBW},
+    {0xfe000000, 0x1a000000, ISA_THUMB, I_SUB},
+    {0xffe08000, 0xeba00000, ISA_THUMB2, I_SUB},
+    {0xff800000, 0xb0800000, ISA_THUMB, I_SUB},
+    {0xfbef8000, 0xf1ad0000, ISA_THUMB2, I_SUB},
+    {0xfbff8000, 0xf2ad0000, ISA_THUMB2, I_SUBW},
+    {0xffef8000, 0xebad0000, ISA_THUMB2, I_SUB},
+    {0xff000000, 0xdf000000, ISA_THUMB, I_SVC},
+    {0xfff0f0c0, 0xfa40f080, ISA_THUMB2, I_SXTAB},
+    {0xfff0f0c0, 0xfa20f080, ISA_THUMB2, I_SXTAB16},
+    {0xfff0f0c0, 0xfa00f080, ISA_THUMB2, I_SXTAH},
+    {0xffc00000, 0xb2400000, ISA_THUMB, I_SXTB},
+    {0xfffff0c0, 0xfa4ff080, ISA_THUMB2, I_SXTB},
+    {0xfffff0c0, 0xfa2ff080, ISA_THUMB2, I_SXTB16},
+    {0xffc00000, 0xb2000000, ISA_THUMB, I_SXTH},
+    {0xfffff0c0, 0xfa0ff080, ISA_THUMB2, I_SXTH},
+    {0xfff0ffe0, 0xe8d0f000, ISA_THUMB2, I_TBB},
+    {0xfbf08f00, 0xf0900f00, ISA_THUMB2, I_TEQ},
+    {0xfff08f00, 0xea900f00, ISA_THUMB2, I_TEQ},
+    {0xfbf08f00, 0xf0100f00, ISA_THUMB2, I_TST},
+    {0xffc00000, 0x42000000, ISA_THUMB, I_TST},
+    {0xfff08f00, 0xea100f00, ISA_THUMB2, I_TST},
+    {0xfff0f0f0, 0xfa90f040, ISA_THUMB2, I_UADD16},
+    {0xfff0f0f0, 0xfa80f040, ISA_THUMB2, I_UADD8},
+    {0xfff0f0f0, 0xfaa0f040, ISA_THUMB2, I_UASX},
+    {0xfff08020, 0xf3c00000, ISA_THUMB2, I_UBFX},
+    {0xff000000, 0xde000000, ISA_THUMB, I_UDF},
+    {0xfff0f000, 0xf7f0a000, ISA_THUMB2, I_UDF},
+    {0xfff0f0f0, 0xfbb0f0f0, ISA_THUMB2, I_UDIV},
+    {0xfff0f0f0, 0xfa90f060, ISA_THUMB2, I_UHADD16},
+    {0xfff0f0f0, 0xfa80f060, ISA_THUMB2, I_UHADD8},
+    {0xfff0f0f0, 0xfaa0f060, ISA_THUMB2, I_UHASX},
+    {0xfff0f0f0, 0xfae0f060, ISA_THUMB2, I_UHSAX},
+    {0xfff0f0f0, 0xfad0f060, ISA_THUMB2, I_UHSUB16},
+    {0xfff0f0f0, 0xfac0f060, ISA_THUMB2, I_UHSUB8},
+    {0xfff000f0, 0xfbe00060, ISA_THUMB2, I_UMAAL},
+    {0xfff000f0, 0xfbe00000, ISA_THUMB2, I_UMLAL},
+    {0xfff000f0, 0xfba00000, ISA_THUMB2, I_UMULL},
+    {0xfff0f0f0, 0xfa90f050, ISA_THUMB2, I_UQADD16},
+    {0xfff0f0f0, 0xfa80f050, ISA_THUMB2, I_UQADD8},
+    {0xfff0f0f0, 0xfaa0f050, ISA_THUMB2, I_UQASX},
+    {0xfff0f0f0, 0xfae0f050, ISA_THUMB2, I_UQSAX},
+    {0xfff0f0f0, 0xfad0f050, ISA_THUMB2, I_UQSUB16},
+    {0xfff0f0f0, 0xfac0f050, ISA_THUMB2, I_UQSUB8},
+    {0xfff0f0f0, 0xfb70f000, ISA_THUMB2, I_USAD8},
+    {0xfff000f0, 0xfb700000, ISA_THUMB2, I_USADA8},
+    {0xfff0f0f0, 0xfae0f040, ISA_THUMB2, I_USAX},
+    {0xfff0f0f0, 0xfad0f040, ISA_THUMB2, I_USUB16},
+    {0xfff0f0f0, 0xfac0f040, ISA_THUMB2, I_USUB8},
+    {0xfff0f0c0, 0xfa50f080, ISA_THUMB2, I_UXTAB},
+    {0xfff0f0c0, 0xfa30f080, ISA_THUMB2, I_UXTAB16},
+    {0xfff0f0c0, 0xfa10f080, ISA_THUMB2, I_UXTAH},
+    {0xffc00000, 0xb2c00000, ISA_THUMB, I_UXTB},
+    {0xfffff0c0, 0xfa5ff080, ISA_THUMB2, I_UXTB},
+    {0xfffff0c0, 0xfa3ff080, ISA_THUMB2, I_UXTB16},
+    {0xffc00000, 0xb2800000, ISA_THUMB, I_UXTH},
+    {0xfffff0c0, 0xfa1ff080, ISA_THUMB2, I_UXTH},
+    {0xffff0000, 0xbf200000, ISA_THUMB, I_WFE},
+    {0xffffffff, 0xf3af8002, ISA_THUMB2, I_WFE},
+    {0xffff0000, 0xbf300000, ISA_THUMB, I_WFI},
+    {0xffffffff, 0xf3af8003, ISA_THUMB2, I_WFI},
+    {0xffff0000, 0xbf100000, ISA_THUMB, I_YIELD},
+    {0xffffffff, 0xf3af8001, ISA_THUMB2, I_YIELD},
+};
+
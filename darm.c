@@ -91,47 +91,279 @@ void darm_init(darm_t *d)
     d->firstcond = C_INVLD, d->mask = 0;
 }
 
+#define REGBIT(reg) ((reg) != R_INVLD ? 1 << (reg) : 0)
+
+// does this instruction write back to the base register Rn
+static int _writeback(const darm_t *d, uint32_t rules)
+{
+    // pre-indexed with write-back, or post-indexed addressing
+    if((rules & RR_WRITEBACK) && (d->W == B_SET || d->P == B_UNSET)) {
+        return 1;
+    }
+
+    // the 16-bit thumb LDM only writes back if Rn is not in the list, and
+    // STM always writes back
+    return d->instr_type == T_THUMB_RW_REG &&
+        (d->instr == I_STM || ((d->reglist >> d->Rn) & 1) == 0);
+}
+
+void darm_regs_update(darm_t *d)
+{
+    uint32_t rules = d->instr < I_INSTRCNT ? darm_regrules[d->instr] : 0;
+    uint32_t r = 0, w = 0;
+
+    // operands that are always read
+    r |= REGBIT(d->Rn) | REGBIT(d->Rm) | REGBIT(d->Ra) | REGBIT(d->Rs);
+
+    if(d->Rd != R_INVLD) {
+        if(rules & RR_RD_READ) r |= REGBIT(d->Rd);
+        if((rules & RR_RD_NONE) == 0) w |= REGBIT(d->Rd);
+    }
+
+    // the second register of a doubleword transfer might be implicit
+    darm_reg_t Rt2 = d->Rt2;
+    if(Rt2 == R_INVLD && d->Rt != R_INVLD && (rules & RR_RT_PAIR)) {
+        Rt2 = (darm_reg_t)((d->Rt + 1) & b1111);
+    }
+
+    if(rules & RR_RT_WRITE) w |= REGBIT(d->Rt); else r |= REGBIT(d->Rt);
+    if(rules & RR_RT2_WRITE) w |= REGBIT(Rt2); else r |= REGBIT(Rt2);
+
+    w |= REGBIT(d->RdHi) | REGBIT(d->RdLo);
+    if(rules & RR_HILO_READ) r |= REGBIT(d->RdHi) | REGBIT(d->RdLo);
+
+    if(rules & RR_LIST_WRITE) w |= d->reglist; else r |= d->reglist;
+
+    if(_writeback(d, rules) != 0) w |= REGBIT(d->Rn);
+
+    if(rules & RR_SP) r |= 1 << SP, w |= 1 << SP;
+    if(rules & RR_LR_WRITE) w |= 1 << LR;
+    if(rules & RR_PC_WRITE) w |= 1 << PC;
+
+    // direct branches and ARM's ADR are relative to the pc
+    if((rules & RR_PC_REL) && d->I == B_SET && d->Rn == R_INVLD) {
+        r |= 1 << PC;
+    }
+
+    d->regs_read = r;
+    d->regs_written = w;
+}
+
+// flags that are read by each condition code
+static const uint8_t g_cond_flags[16] = {
+    APSR_Z, APSR_Z, APSR_C, APSR_C, APSR_N, APSR_N, APSR_V, APSR_V,
+    APSR_C | APSR_Z, APSR_C | APSR_Z, APSR_N | APSR_V, APSR_N | APSR_V,
+    APSR_N | APSR_Z | APSR_V, APSR_N | APSR_Z | APSR_V, 0, 0,
+};
+
+uint32_t darm_flags_read(const darm_t *d)
+{
+    uint32_t sem = d->instr < I_INSTRCNT ? darm_semrules[d->instr] : 0;
+    uint32_t ret = d->cond != C_INVLD ? g_cond_flags[d->cond & b1111] : 0;
+
+    if(sem & SEM_READS_C) ret |= APSR_C;
+    if(sem & SEM_READS_NZCV) ret |= APSR_NZCV;
+    return ret;
+}
+
+uint32_t darm_flags_written(const darm_t *d)
+{
+    uint32_t sem = d->instr < I_INSTRCNT ? darm_semrules[d->instr] : 0;
+    int sets_flags = d->S == B_SET || (sem & SEM_FLAGS_ALWAYS) != 0;
+
+    // most 16-bit thumb data-processing instructions set the flags without
+    // having an S bit, unless they're inside an IT block (see darm_it_apply)
+    switch ((uint32_t) d->instr_type) {
+    case T_THUMB_SHIFT_IMM: case T_THUMB_GPI: case T_THUMB_HAS_IMM8:
+    case T_THUMB_3REG: case T_THUMB_2REG_IMM:
+        sets_flags |= d->S == B_INVLD;
+        break;
+    }
+
+    if(sets_flags == 0) return 0;
+
+    return (sem & SEM_WRITES_NZ ? APSR_N | APSR_Z : 0) |
+        (sem & SEM_WRITES_C ? APSR_C : 0) |
+        (sem & SEM_WRITES_V ? APSR_V : 0);
+}
+
+int darm_mem(const darm_t *d, darm_mem_t *mem)
+{
+    uint32_t sem = d->instr < I_INSTRCNT ? darm_semrules[d->instr] : 0;
+    uint32_t rules = d->instr < I_INSTRCNT ? darm_regrules[d->instr] : 0;
+
+    memset(mem, 0, sizeof(darm_mem_t));
+    if((sem & (SEM_LOAD | SEM_STORE)) == 0) return -1;
+
+    // literal loads don't always have Rn set, and neither do PUSH and POP
+    mem->base = d->Rn != R_INVLD ? d->Rn : rules & RR_SP ? SP : PC;
+
+    mem->offset_kind = M_NONE;
+    mem->index = R_INVLD;
+    mem->shift_type = S_INVLD;
+
+    if(d->I == B_SET) {
+        mem->offset_kind = M_IMM;
+        mem->offset = d->U == B_UNSET ? -(int32_t) d->imm : (int32_t) d->imm;
+    }
+    else if(d->Rm != R_INVLD) {
+        mem->offset_kind = M_REG;
+        mem->index = d->Rm;
+        mem->shift_type = d->shift_type;
+        mem->shift = d->shift;
+        mem->subtract = d->U == B_UNSET;
+    }
+
+    mem->size = sem & SEM_BYTE ? 1 : sem & SEM_HALF ? 2 : 4;
+    mem->count = 1;
+
+    if(sem & SEM_DUAL) {
+        mem->count = 2;
+    }
+    // the single register PUSH and POP have an empty register list
+    else if((sem & SEM_MULTI) && d->reglist != 0) {
+        mem->count = __builtin_popcount(d->reglist);
+    }
+
+    mem->load = (sem & SEM_LOAD) != 0;
+    mem->store = (sem & SEM_STORE) != 0;
+    mem->sign_extend = (sem & SEM_SIGNED) != 0;
+    mem->exclusive = (sem & SEM_EXCLUSIVE) != 0;
+    mem->writeback = (rules & RR_SP) != 0 || _writeback(d, rules) != 0;
+    mem->post_index = d->P == B_UNSET;
+    return 0;
+}
+
 int darm_disasm(darm_t *d, uint16_t w, uint16_t w2, uint32_t addr)
 {
-    // if the least significant bit is not set, then this is
-    // an ARMv7 instruction
-    if((addr & 1) == 0) {
+    return darm_disasm_inline(d, w, w2, addr);
+}
+
+int darm_disasm_buf(darm_t *d, const uint8_t *buf, uint32_t len,
+    uint32_t addr)
+{
+    if(len < 2) return 0;
+
+    // instructions are stored in little endian, as halfwords for Thumb and
+    // Thumb2, and as words for ARMv7
+    uint16_t w = buf[0] | (buf[1] << 8), w2 = 0;
+    if(len >= 4) {
+        w2 = buf[2] | (buf[3] << 8);
+    }
+
+    int ret = darm_disasm_inline(d, w, w2, addr);
+    return (uint32_t) ret * 2 > len ? 0 : ret;
+}
 
-        // disassemble and check for error return values
-        if(darm_armv7_disasm(d, (w2 << 16) | w) < 0) {
-            return 0;
+void darm_it_init(darm_it_t *it)
+{
+    it->state = 0;
+}
+
+void darm_it_apply(darm_it_t *it, darm_t *d, int ret)
+{
+    // outside of an IT block, only an IT instruction starts a new one
+    if((it->state & b1111) == 0) {
+        if(ret != 0 && d->instr == I_IT) {
+            it->state = (d->firstcond << 4) | d->mask;
         }
-        else {
-            return 2;
+        return;
+    }
+
+    if(ret != 0) {
+        d->cond = (darm_cond_t)(it->state >> 4);
+
+        // 16-bit instructions don't update the flags inside an IT block
+        if(d->S == B_INVLD) {
+            d->S = B_UNSET;
         }
     }
 
-    // magic table constructed based on section A6.1 of the ARM manual
-    static uint8_t is_thumb2[0x20] = {
-        [b11101] = 1,
-        [b11110] = 1,
-        [b11111] = 1,
-    };
+    // advance to the next instruction, the low bit of the condition is
+    // shifted in from the mask
+    if((it->state & b111) == 0) {
+        it->state = 0;
+    }
+    else {
+        it->state = (it->state & 0xe0) | ((it->state << 1) & b11111);
+    }
+}
 
-    // check whether this is a Thumb or Thumb2 instruction
-    if(is_thumb2[w >> 11] == 0) {
+int darm_disasm_it(darm_it_t *it, darm_t *d, uint16_t w, uint16_t w2,
+    uint32_t addr)
+{
+    int ret = darm_disasm(d, w, w2, addr);
+
+    // there are no IT blocks in ARMv7 mode
+    if((addr & 1) == 0) {
+        it->state = 0;
+        return ret;
+    }
+
+    darm_it_apply(it, d, ret);
+    return ret;
+}
 
-        // this is a Thumb instruction
-        if(darm_thumb_disasm(d, w) < 0) {
-            return 0;
+int darm_branch_target(const darm_t *d, uint32_t pc, uint32_t *target,
+    int *target_is_thumb)
+{
+    // just like darm_disasm, the least significant bit of the address
+    // specifies whether this is a Thumb or Thumb2 instruction
+    int thumb = pc & 1;
+    pc &= ~1;
+
+    switch ((uint32_t) d->instr) {
+    case I_B: case I_BL: case I_CBZ: case I_CBNZ:
+        // every decoder stores the offset already sign-extended and
+        // multiplied, so all that's left is the pipeline offset of the pc
+        if(d->I != B_SET) return -1;
+
+        *target = pc + (thumb ? 4 : 8) + d->imm;
+        if(target_is_thumb != NULL) {
+            *target_is_thumb = thumb;
+        }
+        return 0;
+
+    case I_BLX:
+        // the register form of BLX has no static target
+        if(d->H == B_INVLD) return -1;
+
+        // BLX always switches the instruction set, for Thumb2 the target
+        // is relative to Align(pc, 4), for ARMv7 the H bit has already
+        // been merged into the immediate
+        if(thumb != 0) {
+            *target = ((pc + 4) & ~3) + d->imm;
         }
         else {
-            return 1;
+            *target = pc + 8 + d->imm;
+        }
+        if(target_is_thumb != NULL) {
+            *target_is_thumb = !thumb;
         }
-    }
-
-    // this is a Thumb2 instruction
-    if(darm_thumb2_disasm(d, w, w2) < 0) {
         return 0;
+
+    default:
+        return -1;
     }
-    else {
-        return 2;
+}
+
+uint32_t darm_branch_targets(const darm_t *d, const uint32_t *pc,
+    uint32_t count, uint32_t *targets, int8_t *target_is_thumb)
+{
+    uint32_t ret = 0;
+
+    for (uint32_t idx = 0; idx < count; idx++) {
+        int thumb;
+        if(darm_branch_target(&d[idx], pc[idx], &targets[idx], &thumb) < 0) {
+            targets[idx] = 0;
+            target_is_thumb[idx] = -1;
+            continue;
+        }
+
+        target_is_thumb[idx] = thumb;
+        ret++;
     }
+    return ret;
 }
 
 int darm_str(const darm_t *d, darm_str_t *str)
@@ -166,10 +398,21 @@ int darm_str(const darm_t *d, darm_str_t *str)
     // format string - we handle these instructions in a hacky way for now..
     switch (d->instr) {
     case I_CPS:
-    case I_IT:
         // TODO
         return -1;
 
+    case I_IT:
+        // each of the following instructions is either a then or an else,
+        // depending on whether its mask bit equals the lowest bit of
+        // firstcond, the lowest set bit of the mask terminates the list
+        for (uint32_t bit = 3; (d->mask & ((1 << bit) - 1)) != 0; bit--) {
+            *mnemonic++ = ((d->mask >> bit) & 1) == (d->firstcond & 1) ?
+                'T' : 'E';
+        }
+        APPEND(args[arg], darm_condition_name(d->firstcond, 0));
+        arg++;
+        goto finalize;
+
     case I_CBZ:
     case I_CBNZ:
         APPEND(args[arg], darm_register_name(d->Rn));
@@ -83,6 +83,71 @@ typedef enum _darm_option_t {
     O_INVLD = -1,
 } darm_option_t;
 
+// coarse classes of ARMv7 instructions, based on the condition and bits
+// 27..25 (and bit 4 or bits 7 and 4) of the encoding
+typedef enum _darm_class_t {
+    DC_DATA,    // data-processing and miscellaneous instructions
+    DC_MUL,     // multiply and extra load/store instructions
+    DC_LDST,    // load/store word and unsigned byte
+    DC_MEDIA,   // media instructions
+    DC_BLOCK,   // load/store multiple
+    DC_BRANCH,  // branch and branch with link
+    DC_COPROC,  // coprocessor instructions and supervisor call
+    DC_UNCOND,  // unconditional instructions
+
+    DC_COUNT,
+} darm_class_t;
+
+// cpu features that are used by the vectorized kernels, as bitmask
+typedef enum _darm_cpu_t {
+    CPU_SSE42 = 1,
+    CPU_AVX2 = 2,
+    CPU_AVX512 = 4,
+} darm_cpu_t;
+
+// the condition flags, in the same order as they appear in the APSR
+typedef enum _darm_apsr_t {
+    APSR_V = 1, APSR_C = 2, APSR_Z = 4, APSR_N = 8,
+
+    APSR_NZCV = 15,
+} darm_apsr_t;
+
+typedef enum _darm_offset_t {
+    M_NONE, // no offset, e.g., LDM or LDREX
+    M_IMM,  // immediate offset
+    M_REG,  // (shifted) register offset
+} darm_offset_t;
+
+typedef struct _darm_mem_t {
+    // base register, this is PC for literal loads and SP for PUSH and POP
+    darm_reg_t      base;
+
+    // the kind of offset, for M_IMM the offset is a signed immediate,
+    // for M_REG the index register is shifted and then added to or
+    // subtracted from the base register
+    darm_offset_t   offset_kind;
+    int32_t         offset;
+    darm_reg_t      index;
+    darm_shift_type_t shift_type;
+    uint32_t        shift;
+    uint8_t         subtract;
+
+    // the size of each access in bytes, and the amount of accesses, e.g.,
+    // four bytes times two for LDRD
+    uint8_t         size;
+    uint8_t         count;
+
+    uint8_t         load;
+    uint8_t         store;
+    uint8_t         sign_extend;
+    uint8_t         exclusive;
+
+    // is the base register updated, and if so, is the access performed
+    // before the update (post-indexed addressing)
+    uint8_t         writeback;
+    uint8_t         post_index;
+} darm_mem_t;
+
 typedef struct _darm_t {
     // the original encoded instruction
     uint32_t        w;
@@ -190,8 +255,20 @@ typedef struct _darm_t {
     // condition and mask for the IT instruction
     darm_cond_t     firstcond;
     uint8_t         mask;
+
+    // bitmask of the registers that are read and written by this
+    // instruction, including implicit ones such as SP for PUSH and POP
+    uint16_t        regs_read;
+    uint16_t        regs_written;
 } darm_t;
 
+// IT block state for disassembling a stream of Thumb instructions
+typedef struct _darm_it_t {
+    // the ITSTATE, i.e., the condition of the next instruction in the upper
+    // four bits followed by the remaining mask, zero outside of an IT block
+    uint8_t         state;
+} darm_it_t;
+
 typedef struct _darm_str_t {
     // the full mnemonic, including extensions, flags, etc.
     char mnemonic[12];
@@ -211,9 +288,54 @@ typedef struct _darm_str_t {
 // call this function beforehand
 void darm_init(darm_t *d);
 
+// calculate the regs_read and regs_written masks from the operands, this
+// function is internally called by each of the disassemble routines
+void darm_regs_update(darm_t *d);
+
 // disassemble an armv7 instruction
 int darm_armv7_disasm(darm_t *d, uint32_t w);
 
+// classify count armv7 instructions, using the vectorized kernels that are
+// supported by the cpu, see darm_cpu_select
+void darm_armv7_classify(const uint32_t *w, uint32_t count, uint8_t *cls);
+
+// disassemble count armv7 instructions, grouped by their class; entries that
+// can't be disassembled have instr set to I_INVLD, returns the amount of
+// instructions that were disassembled successfully
+uint32_t darm_armv7_disasm_batch(darm_t *d, const uint32_t *w,
+    uint32_t count);
+
+// sets one bit per halfword of the Thumb code in buf for the start of each
+// instruction, assuming that the first halfword starts an instruction;
+// starts has to hold a bit for each of the len / 2 halfwords
+void darm_thumb_bitmap(const uint8_t *buf, uint32_t len, uint64_t *starts);
+
+// same as darm_thumb_bitmap, but writes the offset in bytes of each
+// instruction to starts (which has room for len / 2 entries), returns the
+// amount of instructions
+uint32_t darm_thumb_starts(const uint8_t *buf, uint32_t len,
+    uint32_t *starts);
+
+// the cpu features the vectorized kernels are able to use, darm_cpu_t
+uint32_t darm_cpu_features();
+
+//
+// Selects the kernels for the features, e.g., 0 for the portable scalar
+// kernels, limited to what the cpu supports. By default the best kernels
+// are selected on first use, which is thread-safe. Returns the features
+// the selected kernels use.
+//
+uint32_t darm_cpu_select(uint32_t features);
+
+// reverse the byte order of count words or halfwords, e.g., to disassemble
+// big-endian images; dst may be equal to src
+void darm_bswap32(uint32_t *dst, const uint32_t *src, uint32_t count);
+void darm_bswap16(uint16_t *dst, const uint16_t *src, uint32_t count);
+
+// gathers the bits of value that are selected by mask into the lower bits,
+// i.e., the pext instruction of BMI2 (which is used when compiled for it)
+uint32_t darm_pext(uint32_t value, uint32_t mask);
+
 // disassemble a thumb instruction
 int darm_thumb_disasm(darm_t *d, uint16_t w);
 
@@ -243,6 +365,81 @@ int darm_thumb2_disasm(darm_t *d, uint16_t w, uint16_t w2);
 //
 int darm_disasm(darm_t *d, uint16_t w, uint16_t w2, uint32_t addr);
 
+//
+// The length in 16 bit words of the instruction starting with w, i.e., the
+// value that darm_disasm returns on success, without disassembling it. Each
+// ARMv7 instruction (thumb is zero) has a length of two, as does each Thumb2
+// instruction, which is recognized by 0b11101, 0b11110, or 0b11111 in the
+// upper five bits of its first 16 bit word (section A6.1 of the manual).
+//
+static inline int darm_insn_length(uint16_t w, int thumb)
+{
+    return thumb == 0 || w >= 0xe800 ? 2 : 1;
+}
+
+// same as darm_disasm, but the mode and length dispatch is inlined into the
+// caller, so that it calls the decoder of the instruction set directly
+static inline int darm_disasm_inline(darm_t *d, uint16_t w, uint16_t w2,
+    uint32_t addr)
+{
+    if((addr & 1) == 0) {
+        return darm_armv7_disasm(d, ((uint32_t) w2 << 16) | w) < 0 ? 0 : 2;
+    }
+
+    if(darm_insn_length(w, 1) == 1) {
+        return darm_thumb_disasm(d, w) < 0 ? 0 : 1;
+    }
+
+    return darm_thumb2_disasm(d, w, w2) < 0 ? 0 : 2;
+}
+
+// reset the IT block state, e.g., at the start of a function
+void darm_it_init(darm_it_t *it);
+
+// applies the IT block state to the Thumb or Thumb2 instruction d, which
+// has just been disassembled with return value ret, i.e., an instruction
+// inside an IT block gets the condition of the block, and advances the
+// state to the next instruction
+void darm_it_apply(darm_it_t *it, darm_t *d, int ret);
+
+// same as darm_disasm, but keeps track of IT blocks in the given state
+int darm_disasm_it(darm_it_t *it, darm_t *d, uint16_t w, uint16_t w2,
+    uint32_t addr);
+
+// disassembles the instruction stored at buf, which is mapped at address
+// addr (again with the least significant bit set for Thumb), without reading
+// more than len bytes; return values are the same as for darm_disasm
+int darm_disasm_buf(darm_t *d, const uint8_t *buf, uint32_t len,
+    uint32_t addr);
+
+//
+// Calculates the absolute target of a direct branch (B, BL, BLX, CBZ and
+// CBNZ) which has been disassembled at address pc, taking care of the
+// different pc offsets for ARMv7 and Thumb/Thumb2. As with darm_disasm, the
+// least significant bit of pc has to be set for Thumb and Thumb2.
+//
+// Returns 0 on success, in which case target_is_thumb (if not NULL)
+// specifies whether the instruction set is Thumb at the target address,
+// e.g., after a BLX. Returns -1 for anything that's not a direct branch.
+//
+int darm_branch_target(const darm_t *d, uint32_t pc, uint32_t *target,
+    int *target_is_thumb);
+
+// batched version of darm_branch_target, d[idx] has been disassembled at
+// address pc[idx]; entries without static target get a target_is_thumb of
+// -1, returns the amount of direct branches
+uint32_t darm_branch_targets(const darm_t *d, const uint32_t *pc,
+    uint32_t count, uint32_t *targets, int8_t *target_is_thumb);
+
+// the condition flags that are read (e.g., due to a condition code) and
+// written by this instruction, as bitmask of darm_apsr_t
+uint32_t darm_flags_read(const darm_t *d);
+uint32_t darm_flags_written(const darm_t *d);
+
+// describes the memory access of this instruction, returns -1 if this
+// instruction doesn't access memory
+int darm_mem(const darm_t *d, darm_mem_t *mem);
+
 int darm_immshift_decode(const darm_t *d, const char **type,
     uint32_t *immediate);
 
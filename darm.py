@@ -183,6 +183,8 @@ class _Darm(Structure):
         ('D', c_int32),
         ('firstcond', c_int32),
         ('mask', c_uint8),
+        ('regs_read', c_uint16),
+        ('regs_written', c_uint16),
     ]
 
 
@@ -227,6 +229,8 @@ class Darm:
         self.lsb = d.lsb
         self.width = d.width
         self.reglist = RegisterList(d.reglist)
+        self.regs_read = RegisterList(d.regs_read)
+        self.regs_written = RegisterList(d.regs_written)
 
     def __repr__(self):
         g = lambda x: getattr(self, x)
@@ -0,0 +1,9211 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#define _DEFAULT_SOURCE
+#include "darm_all.h"
+
+// ---- darm-tbl.c ----
+#include <stdio.h>
+#include <stdint.h>
+const char *darm_mnemonics[] = {
+    "INVLD", "ADC", "ADD", "ADDW", "ADR", "AND", "ASR", "B", "BFC", "BFI",
+    "BIC", "BKPT", "BL", "BLX", "BX", "BXJ", "CBNZ", "CBZ", "CDP", "CDP2",
+    "CHKA", "CLREX", "CLZ", "CMN", "CMP", "CPS", "CPY", "DBG", "DMB", "DSB",
+    "ENTERX", "EOR", "HB", "HBL", "HBLP", "HBP", "ISB", "IT", "LDC", "LDC2",
+    "LDM", "LDMDA", "LDMDB", "LDMIB", "LDR", "LDRB", "LDRBT", "LDRD", "LDREX",
+    "LDREXB", "LDREXD", "LDREXH", "LDRH", "LDRHT", "LDRSB", "LDRSBT", "LDRSH",
+    "LDRSHT", "LDRT", "LEAVEX", "LSL", "LSR", "MCR", "MCR2", "MCRR", "MCRR2",
+    "MLA", "MLS", "MOV", "MOVT", "MOVW", "MRC", "MRC2", "MRRC", "MRRC2",
+    "MRS", "MSR", "MUL", "MVN", "NEG", "NOP", "ORN", "ORR", "PKH", "PLD",
+    "PLDW", "PLI", "POP", "PUSH", "QADD", "QADD16", "QADD8", "QASX", "QDADD",
+    "QDSUB", "QSAX", "QSUB", "QSUB16", "QSUB8", "RBIT", "REV", "REV16",
+    "REVSH", "RFE", "ROR", "RRX", "RSB", "RSC", "SADD16", "SADD8", "SASX",
+    "SBC", "SBFX", "SDIV", "SEL", "SETEND", "SEV", "SHADD16", "SHADD8",
+    "SHASX", "SHSAX", "SHSUB16", "SHSUB8", "SMC", "SMLA", "SMLABB", "SMLABT",
+    "SMLAD", "SMLAL", "SMLALBB", "SMLALBT", "SMLALD", "SMLALTB", "SMLALTT",
+    "SMLATB", "SMLATT", "SMLAW", "SMLSD", "SMLSLD", "SMMLA", "SMMLS", "SMMUL",
+    "SMUAD", "SMUL", "SMULBB", "SMULBT", "SMULL", "SMULTB", "SMULTT", "SMULW",
+    "SMUSD", "SRS", "SSAT", "SSAT16", "SSAX", "SSUB16", "SSUB8", "STC",
+    "STC2", "STM", "STMDA", "STMDB", "STMIB", "STR", "STRB", "STRBT", "STRD",
+    "STREX", "STREXB", "STREXD", "STREXH", "STRH", "STRHT", "STRT", "SUB",
+    "SUBW", "SVC", "SWP", "SWPB", "SXTAB", "SXTAB16", "SXTAH", "SXTB",
+    "SXTB16", "SXTH", "TBB", "TBH", "TEQ", "TST", "UADD16", "UADD8", "UASX",
+    "UBFX", "UDF", "UDIV", "UHADD16", "UHADD8", "UHASX", "UHSAX", "UHSUB16",
+    "UHSUB8", "UMAAL", "UMLAL", "UMULL", "UQADD16", "UQADD8", "UQASX",
+    "UQSAX", "UQSUB16", "UQSUB8", "USAD8", "USADA8", "USAT", "USAT16", "USAX",
+    "USUB16", "USUB8", "UXTAB", "UXTAB16", "UXTAH", "UXTB", "UXTB16", "UXTH",
+    "VABA", "VABAL", "VABD", "VABDL", "VABS", "VACGE", "VACGT", "VACLE",
+    "VACLT", "VADD", "VADDHN", "VADDL", "VADDW", "VAND", "VBIC", "VBIF",
+    "VBIT", "VBSL", "VCEQ", "VCGE", "VCGT", "VCLE", "VCLS", "VCLT", "VCLZ",
+    "VCMP", "VCMPE", "VCNT", "VCVT", "VCVTB", "VCVTR", "VCVTT", "VDIV",
+    "VDUP", "VEOR", "VEXT", "VHADD", "VHSUB", "VLD1", "VLD2", "VLD3", "VLD4",
+    "VLDM", "VLDR", "VMAX", "VMIN", "VMLA", "VMLAL", "VMLS", "VMLSL", "VMOV",
+    "VMOVL", "VMOVN", "VMRS", "VMSR", "VMUL", "VMULL", "VMVN", "VNEG",
+    "VNMLA", "VNMLS", "VNMUL", "VORN", "VORR", "VPADAL", "VPADD", "VPADDL",
+    "VPMAX", "VPMIN", "VPOP", "VPUSH", "VQABS", "VQADD", "VQDMLAL", "VQDMLSL",
+    "VQDMULH", "VQDMULL", "VQMOVN", "VQMOVUN", "VQNEG", "VQRDMULH", "VQRSHL",
+    "VQRSHRN", "VQRSHRUN", "VQSHL", "VQSHLU", "VQSHRN", "VQSHRUN", "VQSUB",
+    "VRADDHN", "VRECPE", "VRECPS", "VREV16", "VREV32", "VREV64", "VRHADD",
+    "VRSHL", "VRSHR", "VRSHRN", "VRSQRTE", "VRSQRTS", "VRSRA", "VRSUBHN",
+    "VSHL", "VSHLL", "VSHR", "VSHRN", "VSLI", "VSQRT", "VSRA", "VSRI", "VST1",
+    "VST2", "VST3", "VST4", "VSTM", "VSTR", "VSUB", "VSUBHN", "VSUBL",
+    "VSUBW", "VSWP", "VTBL", "VTBX", "VTRN", "VTST", "VUZP", "VZIP", "WFE",
+    "WFI", "YIELD"
+};
+
+const char *darm_enctypes[] = {
+    "INVLD", "ARM_ADR", "ARM_UNCOND", "ARM_MUL", "ARM_STACK0", "ARM_STACK1",
+    "ARM_STACK2", "ARM_ARITH_SHIFT", "ARM_ARITH_IMM", "ARM_BITS",
+    "ARM_BRNCHSC", "ARM_BRNCHMISC", "ARM_MOV_IMM", "ARM_CMP_OP",
+    "ARM_CMP_IMM", "ARM_OPLESS", "ARM_DST_SRC", "ARM_LDSTREGS", "ARM_BITREV",
+    "ARM_MISC", "ARM_SM", "ARM_PAS", "ARM_SAT", "ARM_SYNC", "ARM_PUSR",
+    "ARM_MVCR", "ARM_UDF", "THUMB_ONLY_IMM8", "THUMB_COND_BRANCH",
+    "THUMB_UNCOND_BRANCH", "THUMB_SHIFT_IMM", "THUMB_STACK", "THUMB_LDR_PC",
+    "THUMB_GPI", "THUMB_BRANCH_REG", "THUMB_IT_HINTS", "THUMB_HAS_IMM8",
+    "THUMB_EXTEND", "THUMB_MOD_SP_IMM", "THUMB_3REG", "THUMB_2REG_IMM",
+    "THUMB_ADD_SP_IMM", "THUMB_MOV4", "THUMB_RW_MEMI", "THUMB_RW_MEMO",
+    "THUMB_RW_REG", "THUMB_REV", "THUMB_SETEND", "THUMB_PUSHPOP", "THUMB_CMP",
+    "THUMB_MOD_SP_REG", "THUMB_CBZ", "THUMB2_NO_REG", "THUMB2_RT_REG",
+    "THUMB2_RT_RT2_REG", "THUMB2_RM_REG", "THUMB2_RD_REG", "THUMB2_RD_RM_REG",
+    "THUMB2_RN_REG", "THUMB2_RN_RT_REG", "THUMB2_RN_RT_RT2_REG",
+    "THUMB2_RN_RM_REG", "THUMB2_RN_RM_RT_REG", "THUMB2_RN_RD_REG",
+    "THUMB2_RN_RD_RT_REG", "THUMB2_RN_RD_RT_RT2_REG", "THUMB2_RN_RD_RM_REG",
+    "THUMB2_RN_RD_RM_RA_REG", "THUMB2_NO_IMM", "THUMB2_IMM12", "THUMB2_IMM8",
+    "THUMB2_IMM2", "THUMB2_IMM2_IMM3", "THUMB2_IMM1_IMM3_IMM8",
+    "THUMB2_NO_FLAG", "THUMB2_ROTATE_FLAG", "THUMB2_U_FLAG",
+    "THUMB2_WUP_FLAG", "THUMB2_TYPE_FLAG", "THUMB2_REGLIST_FLAG",
+    "THUMB2_WP_REGLIST_FLAG", "THUMB2_S_FLAG", "THUMB2_S_TYPE_FLAG"
+};
+
+const char *darm_registers[] = {
+    "r0", "r1", "r2", "r3", "r4", "r5", "r6", "r7", "r8", "r9", "r10", "r11",
+    "r12", "SP", "LR", "PC"
+};
+
+const uint16_t darm_regrules[354] = {
+    [I_ADR] = RR_PC_REL,
+    [I_B] = RR_PC_WRITE | RR_PC_REL,
+    [I_BFC] = RR_RD_READ,
+    [I_BFI] = RR_RD_READ,
+    [I_BL] = RR_LR_WRITE | RR_PC_WRITE | RR_PC_REL,
+    [I_BLX] = RR_LR_WRITE | RR_PC_WRITE | RR_PC_REL,
+    [I_BX] = RR_PC_WRITE,
+    [I_BXJ] = RR_PC_WRITE,
+    [I_CBNZ] = RR_PC_WRITE | RR_PC_REL,
+    [I_CBZ] = RR_PC_WRITE | RR_PC_REL,
+    [I_CMN] = RR_RD_NONE,
+    [I_CMP] = RR_RD_NONE,
+    [I_LDC] = RR_WRITEBACK,
+    [I_LDC2] = RR_WRITEBACK,
+    [I_LDM] = RR_LIST_WRITE | RR_WRITEBACK,
+    [I_LDMDA] = RR_LIST_WRITE | RR_WRITEBACK,
+    [I_LDMDB] = RR_LIST_WRITE | RR_WRITEBACK,
+    [I_LDMIB] = RR_LIST_WRITE | RR_WRITEBACK,
+    [I_LDR] = RR_RT_WRITE | RR_WRITEBACK | RR_PC_REL,
+    [I_LDRB] = RR_RT_WRITE | RR_WRITEBACK | RR_PC_REL,
+    [I_LDRBT] = RR_RT_WRITE | RR_WRITEBACK,
+    [I_LDRD] = RR_RT_WRITE | RR_RT2_WRITE | RR_RT_PAIR | RR_WRITEBACK | RR_PC_REL,
+    [I_LDREX] = RR_RT_WRITE,
+    [I_LDREXB] = RR_RT_WRITE,
+    [I_LDREXD] = RR_RT_WRITE | RR_RT2_WRITE | RR_RT_PAIR,
+    [I_LDREXH] = RR_RT_WRITE,
+    [I_LDRH] = RR_RT_WRITE | RR_WRITEBACK | RR_PC_REL,
+    [I_LDRHT] = RR_RT_WRITE | RR_WRITEBACK,
+    [I_LDRSB] = RR_RT_WRITE | RR_WRITEBACK | RR_PC_REL,
+    [I_LDRSBT] = RR_RT_WRITE | RR_WRITEBACK,
+    [I_LDRSH] = RR_RT_WRITE | RR_WRITEBACK | RR_PC_REL,
+    [I_LDRSHT] = RR_RT_WRITE | RR_WRITEBACK,
+    [I_LDRT] = RR_RT_WRITE | RR_WRITEBACK,
+    [I_MOVT] = RR_RD_READ,
+    [I_MRC] = RR_RT_WRITE,
+    [I_MRC2] = RR_RT_WRITE,
+    [I_MRRC] = RR_RT_WRITE | RR_RT2_WRITE,
+    [I_MRRC2] = RR_RT_WRITE | RR_RT2_WRITE,
+    [I_PLD] = RR_PC_REL,
+    [I_PLDW] = RR_PC_REL,
+    [I_PLI] = RR_PC_REL,
+    [I_POP] = RR_RT_WRITE | RR_LIST_WRITE | RR_SP,
+    [I_PUSH] = RR_SP,
+    [I_SMLAL] = RR_HILO_READ,
+    [I_SMLALBB] = RR_HILO_READ,
+    [I_SMLALBT] = RR_HILO_READ,
+    [I_SMLALD] = RR_HILO_READ,
+    [I_SMLALTB] = RR_HILO_READ,
+    [I_SMLALTT] = RR_HILO_READ,
+    [I_SMLSLD] = RR_HILO_READ,
+    [I_STC] = RR_WRITEBACK,
+    [I_STC2] = RR_WRITEBACK,
+    [I_STM] = RR_WRITEBACK,
+    [I_STMDA] = RR_WRITEBACK,
+    [I_STMDB] = RR_WRITEBACK,
+    [I_STMIB] = RR_WRITEBACK,
+    [I_STR] = RR_WRITEBACK,
+    [I_STRB] = RR_WRITEBACK,
+    [I_STRBT] = RR_WRITEBACK,
+    [I_STRD] = RR_RT_PAIR | RR_WRITEBACK,
+    [I_STREXD] = RR_RT_PAIR,
+    [I_STRH] = RR_WRITEBACK,
+    [I_STRHT] = RR_WRITEBACK,
+    [I_STRT] = RR_WRITEBACK,
+    [I_SWP] = RR_RT_WRITE,
+    [I_SWPB] = RR_RT_WRITE,
+    [I_TBB] = RR_PC_WRITE,
+    [I_TBH] = RR_PC_WRITE,
+    [I_TEQ] = RR_RD_NONE,
+    [I_TST] = RR_RD_NONE,
+    [I_UMAAL] = RR_HILO_READ,
+    [I_UMLAL] = RR_HILO_READ,
+};
+
+const uint16_t darm_semrules[354] = {
+    [I_ADC] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_WRITES_V | SEM_READS_C,
+    [I_ADD] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_WRITES_V,
+    [I_ADDW] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_WRITES_V,
+    [I_AND] = SEM_WRITES_NZ | SEM_WRITES_C,
+    [I_ASR] = SEM_WRITES_NZ | SEM_WRITES_C,
+    [I_BIC] = SEM_WRITES_NZ | SEM_WRITES_C,
+    [I_CMN] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_WRITES_V | SEM_FLAGS_ALWAYS,
+    [I_CMP] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_WRITES_V | SEM_FLAGS_ALWAYS,
+    [I_EOR] = SEM_WRITES_NZ | SEM_WRITES_C,
+    [I_LDM] = SEM_LOAD | SEM_MULTI,
+    [I_LDMDA] = SEM_LOAD | SEM_MULTI,
+    [I_LDMDB] = SEM_LOAD | SEM_MULTI,
+    [I_LDMIB] = SEM_LOAD | SEM_MULTI,
+    [I_LDR] = SEM_LOAD,
+    [I_LDRB] = SEM_LOAD | SEM_BYTE,
+    [I_LDRBT] = SEM_LOAD | SEM_BYTE,
+    [I_LDRD] = SEM_LOAD | SEM_DUAL,
+    [I_LDREX] = SEM_LOAD | SEM_EXCLUSIVE,
+    [I_LDREXB] = SEM_LOAD | SEM_BYTE | SEM_EXCLUSIVE,
+    [I_LDREXD] = SEM_LOAD | SEM_DUAL | SEM_EXCLUSIVE,
+    [I_LDREXH] = SEM_LOAD | SEM_HALF | SEM_EXCLUSIVE,
+    [I_LDRH] = SEM_LOAD | SEM_HALF,
+    [I_LDRHT] = SEM_LOAD | SEM_HALF,
+    [I_LDRSB] = SEM_LOAD | SEM_BYTE | SEM_SIGNED,
+    [I_LDRSBT] = SEM_LOAD | SEM_BYTE | SEM_SIGNED,
+    [I_LDRSH] = SEM_LOAD | SEM_HALF | SEM_SIGNED,
+    [I_LDRSHT] = SEM_LOAD | SEM_HALF | SEM_SIGNED,
+    [I_LDRT] = SEM_LOAD,
+    [I_LSL] = SEM_WRITES_NZ | SEM_WRITES_C,
+    [I_LSR] = SEM_WRITES_NZ | SEM_WRITES_C,
+    [I_MLA] = SEM_WRITES_NZ,
+    [I_MOV] = SEM_WRITES_NZ | SEM_WRITES_C,
+    [I_MRS] = SEM_READS_NZCV,
+    [I_MSR] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_WRITES_V | SEM_FLAGS_ALWAYS,
+    [I_MUL] = SEM_WRITES_NZ,
+    [I_MVN] = SEM_WRITES_NZ | SEM_WRITES_C,
+    [I_ORN] = SEM_WRITES_NZ | SEM_WRITES_C,
+    [I_ORR] = SEM_WRITES_NZ | SEM_WRITES_C,
+    [I_POP] = SEM_LOAD | SEM_MULTI,
+    [I_PUSH] = SEM_STORE | SEM_MULTI,
+    [I_ROR] = SEM_WRITES_NZ | SEM_WRITES_C,
+    [I_RRX] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_READS_C,
+    [I_RSB] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_WRITES_V,
+    [I_RSC] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_WRITES_V | SEM_READS_C,
+    [I_SBC] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_WRITES_V | SEM_READS_C,
+    [I_SMLAL] = SEM_WRITES_NZ,
+    [I_SMULL] = SEM_WRITES_NZ,
+    [I_STM] = SEM_STORE | SEM_MULTI,
+    [I_STMDA] = SEM_STORE | SEM_MULTI,
+    [I_STMDB] = SEM_STORE | SEM_MULTI,
+    [I_STMIB] = SEM_STORE | SEM_MULTI,
+    [I_STR] = SEM_STORE,
+    [I_STRB] = SEM_STORE | SEM_BYTE,
+    [I_STRBT] = SEM_STORE | SEM_BYTE,
+    [I_STRD] = SEM_STORE | SEM_DUAL,
+    [I_STREX] = SEM_STORE | SEM_EXCLUSIVE,
+    [I_STREXB] = SEM_STORE | SEM_BYTE | SEM_EXCLUSIVE,
+    [I_STREXD] = SEM_STORE | SEM_DUAL | SEM_EXCLUSIVE,
+    [I_STREXH] = SEM_STORE | SEM_HALF | SEM_EXCLUSIVE,
+    [I_STRH] = SEM_STORE | SEM_HALF,
+    [I_STRHT] = SEM_STORE | SEM_HALF,
+    [I_STRT] = SEM_STORE,
+    [I_SUB] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_WRITES_V,
+    [I_SUBW] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_WRITES_V,
+    [I_SWP] = SEM_LOAD | SEM_STORE,
+    [I_SWPB] = SEM_LOAD | SEM_STORE | SEM_BYTE,
+    [I_TBB] = SEM_LOAD | SEM_BYTE,
+    [I_TBH] = SEM_LOAD | SEM_HALF,
+    [I_TEQ] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_FLAGS_ALWAYS,
+    [I_TST] = SEM_WRITES_NZ | SEM_WRITES_C | SEM_FLAGS_ALWAYS,
+    [I_UMLAL] = SEM_WRITES_NZ,
+    [I_UMULL] = SEM_WRITES_NZ,
+};
+
+const darm_pattern_t darm_patterns[552] = {
+    {0x0fe00000, 0x02a00000, ISA_ARMV7, I_ADC},
+    {0x0fe00010, 0x00a00000, ISA_ARMV7, I_ADC},
+    {0x0fe00090, 0x00a00010, ISA_ARMV7, I_ADC},
+    {0x0fe00000, 0x02800000, ISA_ARMV7, I_ADD},
+    {0x0fe00010, 0x00800000, ISA_ARMV7, I_ADD},
+    {0x0fe00090, 0x00800010, ISA_ARMV7, I_ADD},
+    {0x0fff0000, 0x028f0000, ISA_ARMV7, I_ADR},
+    {0x0fff0000, 0x024f0000, ISA_ARMV7, I_ADR},
+    {0x0fe00000, 0x02000000, ISA_ARMV7, I_AND},
+    {0x0fe00010, 0x00000000, ISA_ARMV7, I_AND},
+    {0x0fe00090, 0x00000010, ISA_ARMV7, I_AND},
+    {0x0fef0070, 0x01a00040, ISA_ARMV7, I_ASR},
+    {0x0fef00f0, 0x01a00050, ISA_ARMV7, I_ASR},
+    {0x0f000000, 0x0a000000, ISA_ARMV7, I_B},
+    {0x0fe0007f, 0x07c0001f, ISA_ARMV7, I_BFC},
+    {0x0fe00070, 0x07c00010, ISA_ARMV7, I_BFI},
+    {0x0fe00000, 0x03c00000, ISA_ARMV7, I_BIC},
+    {0x0fe00010, 0x01c00000, ISA_ARMV7, I_BIC},
+    {0x0fe00090, 0x01c00010, ISA_ARMV7, I_BIC},
+    {0x0ff000f0, 0x01200070, ISA_ARMV7, I_BKPT},
+    {0x0f000000, 0x0b000000, ISA_ARMV7, I_BL},
+    {0xfe000000, 0xfa000000, ISA_ARMV7, I_BLX},
+    {0x0ffffff0, 0x012fff30, ISA_ARMV7, I_BLX},
+    {0x0ffffff0, 0x012fff10, ISA_ARMV7, I_BX},
+    {0x0ffffff0, 0x012fff20, ISA_ARMV7, I_BXJ},
+    {0x0f000010, 0x0e000000, ISA_ARMV7, I_CDP},
+    {0xff000010, 0xfe000000, ISA_ARMV7, I_CDP2},
+    {0xffffffff, 0xf57ff01f, ISA_ARMV7, I_CLREX},
+    {0x0fff0ff0, 0x016f0f10, ISA_ARMV7, I_CLZ},
+    {0x0ff0f000, 0x03700000, ISA_ARMV7, I_CMN},
+    {0x0ff0f010, 0x01700000, ISA_ARMV7, I_CMN},
+    {0x0ff0f090, 0x01700010, ISA_ARMV7, I_CMN},
+    {0x0ff0f000, 0x03500000, ISA_ARMV7, I_CMP},
+    {0x0ff0f010, 0x01500000, ISA_ARMV7, I_CMP},
+    {0x0ff0f090, 0x01500010, ISA_ARMV7, I_CMP},
+    {0x0ffffff0, 0x0320f0f0, ISA_ARMV7, I_DBG},
+    {0xfffffff0, 0xf57ff050, ISA_ARMV7, I_DMB},
+    {0xfffffff0, 0xf57ff040, ISA_ARMV7, I_DSB},
+    {0x0fe00000, 0x02200000, ISA_ARMV7, I_EOR},
+    {0x0fe00010, 0x00200000, ISA_ARMV7, I_EOR},
+    {0x0fe00090, 0x00200010, ISA_ARMV7, I_EOR},
+    {0xfffffff0, 0xf57ff060, ISA_ARMV7, I_ISB},
+    {0x0e100000, 0x0c100000, ISA_ARMV7, I_LDC},
+    {0xfe100000, 0xfc100000, ISA_ARMV7, I_LDC2},
+    {0x0fd00000, 0x08900000, ISA_ARMV7, I_LDM},
+    {0x0fd00000, 0x08100000, ISA_ARMV7, I_LDMDA},
+    {0x0fd00000, 0x09100000, ISA_ARMV7, I_LDMDB},
+    {0x0fd00000, 0x09900000, ISA_ARMV7, I_LDMIB},
+    {0x0e500000, 0x04100000, ISA_ARMV7, I_LDR},
+    {0x0e500010, 0x06100000, ISA_ARMV7, I_LDR},
+    {0x0e500000, 0x04500000, ISA_ARMV7, I_LDRB},
+    {0x0e500010, 0x06500000, ISA_ARMV7, I_LDRB},
+    {0x0f700000, 0x04700000, ISA_ARMV7, I_LDRBT},
+    {0x0f700010, 0x06700000, ISA_ARMV7, I_LDRBT},
+    {0x0e5000f0, 0x004000d0, ISA_ARMV7, I_LDRD},
+    {0x0e500ff0, 0x000000d0, ISA_ARMV7, I_LDRD},
+    {0x0ff00fff, 0x01900f9f, ISA_ARMV7, I_LDREX},
+    {0x0ff00fff, 0x01d00f9f, ISA_ARMV7, I_LDREXB},
+    {0x0ff00fff, 0x01b00f9f, ISA_ARMV7, I_LDREXD},
+    {0x0ff00fff, 0x01f00f9f, ISA_ARMV7, I_LDREXH},
+    {0x0e5000f0, 0x005000b0, ISA_ARMV7, I_LDRH},
+    {0x0e500ff0, 0x001000b0, ISA_ARMV7, I_LDRH},
+    {0x0f7000f0, 0x007000b0, ISA_ARMV7, I_LDRHT},
+    {0x0f700ff0, 0x003000b0, ISA_ARMV7, I_LDRHT},
+    {0x0e5000f0, 0x005000d0, ISA_ARMV7, I_LDRSB},
+    {0x0e500ff0, 0x001000d0, ISA_ARMV7, I_LDRSB},
+    {0x0f7000f0, 0x007000d0, ISA_ARMV7, I_LDRSBT},
+    {0x0f700ff0, 0x003000d0, ISA_ARMV7, I_LDRSBT},
+    {0x0e5000f0, 0x005000f0, ISA_ARMV7, I_LDRSH},
+    {0x0e500ff0, 0x001000f0, ISA_ARMV7, I_LDRSH},
+    {0x0f7000f0, 0x007000f0, ISA_ARMV7, I_LDRSHT},
+    {0x0f700ff0, 0x003000f0, ISA_ARMV7, I_LDRSHT},
+    {0x0f700000, 0x04300000, ISA_ARMV7, I_LDRT},
+    {0x0f700010, 0x06300000, ISA_ARMV7, I_LDRT},
+    {0x0fef0070, 0x01a00000, ISA_ARMV7, I_LSL},
+    {0x0fef00f0, 0x01a00010, ISA_ARMV7, I_LSL},
+    {0x0fef0070, 0x01a00020, ISA_ARMV7, I_LSR},
+    {0x0fef00f0, 0x01a00030, ISA_ARMV7, I_LSR},
+    {0x0f100010, 0x0e000010, ISA_ARMV7, I_MCR},
+    {0xff100010, 0xfe000010, ISA_ARMV7, I_MCR2},
+    {0x0ff00000, 0x0c400000, ISA_ARMV7, I_MCRR},
+    {0xfff00000, 0xfc400000, ISA_ARMV7, I_MCRR2},
+    {0x0fe000f0, 0x00200090, ISA_ARMV7, I_MLA},
+    {0x0ff000f0, 0x00600090, ISA_ARMV7, I_MLS},
+    {0x0fef0000, 0x03a00000, ISA_ARMV7, I_MOV},
+    {0x0ff00000, 0x03000000, ISA_ARMV7, I_MOVW},
+    {0x0fef0ff0, 0x01a00000, ISA_ARMV7, I_MOV},
+    {0x0ff00000, 0x03400000, ISA_ARMV7, I_MOVT},
+    {0x0f100010, 0x0e100010, ISA_ARMV7, I_MRC},
+    {0xff100010, 0xfe100010, ISA_ARMV7, I_MRC2},
+    {0x0ff00000, 0x0c500000, ISA_ARMV7, I_MRRC},
+    {0x0fff0fff, 0x010f0000, ISA_ARMV7, I_MRS},
+    {0xfff00000, 0xfc500000, ISA_ARMV7, I_MRRC2},
+    {0x0ff3f000, 0x0320f000, ISA_ARMV7, I_MSR},
+    {0x0ff3fff0, 0x0120f000, ISA_ARMV7, I_MSR},
+    {0x0fe0f0f0, 0x00000090, ISA_ARMV7, I_MUL},
+    {0x0fef0000, 0x03e00000, ISA_ARMV7, I_MVN},
+    {0x0fef0010, 0x01e00000, ISA_ARMV7, I_MVN},
+    {0x0fef0090, 0x01e00010, ISA_ARMV7, I_MVN},
+    {0x0fffffff, 0x0320f000, ISA_ARMV7, I_NOP},
+    {0x0fe00000, 0x03800000, ISA_ARMV7, I_ORR},
+    {0x0fe00010, 0x01800000, ISA_ARMV7, I_ORR},
+    {0x0fe00090, 0x01800010, ISA_ARMV7, I_ORR},
+    {0x0ff00030, 0x06800010, ISA_ARMV7, I_PKH},
+    {0xff30f000, 0xf510f000, ISA_ARMV7, I_PLD},
+    {0xff30f010, 0xf710f000, ISA_ARMV7, I_PLD},
+    {0xff70f000, 0xf450f000, ISA_ARMV7, I_PLI},
+    {0xff70f010, 0xf650f000, ISA_ARMV7, I_PLI},
+    {0x0fff0000, 0x08bd0000, ISA_ARMV7, I_POP},
+    {0x0fff0fff, 0x049d0004, ISA_ARMV7, I_POP},
+    {0x0fff0000, 0x092d0000, ISA_ARMV7, I_PUSH},
+    {0x0fff0fff, 0x052d0004, ISA_ARMV7, I_PUSH},
+    {0x0ff00ff0, 0x01000050, ISA_ARMV7, I_QADD},
+    {0x0ff00ff0, 0x06200f10, ISA_ARMV7, I_QADD16},
+    {0x0ff00ff0, 0x06200f90, ISA_ARMV7, I_QADD8},
+    {0x0ff00ff0, 0x06200f30, ISA_ARMV7, I_QASX},
+    {0x0ff00ff0, 0x01400050, ISA_ARMV7, I_QDADD},
+    {0x0ff00ff0, 0x01600050, ISA_ARMV7, I_QDSUB},
+    {0x0ff00ff0, 0x06200f50, ISA_ARMV7, I_QSAX},
+    {0x0ff00ff0, 0x01200050, ISA_ARMV7, I_QSUB},
+    {0x0ff00ff0, 0x06200f70, ISA_ARMV7, I_QSUB16},
+    {0x0ff00ff0, 0x06200ff0, ISA_ARMV7, I_QSUB8},
+    {0x0fff0ff0, 0x06ff0f30, ISA_ARMV7, I_RBIT},
+    {0x0fff0ff0, 0x06bf0f30, ISA_ARMV7, I_REV},
+    {0x0fff0ff0, 0x06bf0fb0, ISA_ARMV7, I_REV16},
+    {0x0fff0ff0, 0x06ff0fb0, ISA_ARMV7, I_REVSH},
+    {0x0fef0070, 0x01a00060, ISA_ARMV7, I_ROR},
+    {0x0fef00f0, 0x01a00070, ISA_ARMV7, I_ROR},
+    {0x0fef0ff0, 0x01a00060, ISA_ARMV7, I_RRX},
+    {0x0fe00000, 0x02600000, ISA_ARMV7, I_RSB},
+    {0x0fe00010, 0x00600000, ISA_ARMV7, I_RSB},
+    {0x0fe00090, 0x00600010, ISA_ARMV7, I_RSB},
+    {0x0fe00000, 0x02e00000, ISA_ARMV7, I_RSC},
+    {0x0fe00010, 0x00e00000, ISA_ARMV7, I_RSC},
+    {0x0fe00090, 0x00e00010, ISA_ARMV7, I_RSC},
+    {0x0ff00ff0, 0x06100f10, ISA_ARMV7, I_SADD16},
+    {0x0ff00ff0, 0x06100f90, ISA_ARMV7, I_SADD8},
+    {0x0ff00ff0, 0x06100f30, ISA_ARMV7, I_SASX},
+    {0x0fe00000, 0x02c00000, ISA_ARMV7, I_SBC},
+    {0x0fe00010, 0x00c00000, ISA_ARMV7, I_SBC},
+    {0x0fe00090, 0x00c00010, ISA_ARMV7, I_SBC},
+    {0x0fe00070, 0x07a00050, ISA_ARMV7, I_SBFX},
+    {0x0ff00ff0, 0x06800fb0, ISA_ARMV7, I_SEL},
+    {0xfffffdff, 0xf1010000, ISA_ARMV7, I_SETEND},
+    {0x0fffffff, 0x0320f004, ISA_ARMV7, I_SEV},
+    {0x0ff00ff0, 0x06300f10, ISA_ARMV7, I_SHADD16},
+    {0x0ff00ff0, 0x06300f90, ISA_ARMV7, I_SHADD8},
+    {0x0ff00ff0, 0x06300f30, ISA_ARMV7, I_SHASX},
+    {0x0ff00ff0, 0x06300f50, ISA_ARMV7, I_SHSAX},
+    {0x0ff00ff0, 0x06300f70, ISA_ARMV7, I_SHSUB16},
+    {0x0ff00ff0, 0x06300ff0, ISA_ARMV7, I_SHSUB8},
+    {0x0ff00090, 0x01000080, ISA_ARMV7, I_SMLA},
+    {0x0ff000d0, 0x07000010, ISA_ARMV7, I_SMLAD},
+    {0x0fe000f0, 0x00e00090, ISA_ARMV7, I_SMLAL},
+    {0x0ff00090, 0x01400080, ISA_ARMV7, I_SMLAL},
+    {0x0ff000d0, 0x07400010, ISA_ARMV7, I_SMLALD},
+    {0x0ff000b0, 0x01200080, ISA_ARMV7, I_SMLAW},
+    {0x0ff000d0, 0x07000050, ISA_ARMV7, I_SMLSD},
+    {0x0ff000d0, 0x07400050, ISA_ARMV7, I_SMLSLD},
+    {0x0ff000d0, 0x07500010, ISA_ARMV7, I_SMMLA},
+    {0x0ff000d0, 0x075000d0, ISA_ARMV7, I_SMMLS},
+    {0x0ff0f0d0, 0x0750f010, ISA_ARMV7, I_SMMUL},
+    {0x0ff0f0d0, 0x0700f010, ISA_ARMV7, I_SMUAD},
+    {0x0ff0f090, 0x01600080, ISA_ARMV7, I_SMUL},
+    {0x0fe000f0, 0x00c00090, ISA_ARMV7, I_SMULL},
+    {0x0ff0f0b0, 0x012000a0, ISA_ARMV7, I_SMULW},
+    {0x0ff0f0d0, 0x0700f050, ISA_ARMV7, I_SMUSD},
+    {0x0fe00030, 0x06a00010, ISA_ARMV7, I_SSAT},
+    {0x0ff00ff0, 0x06a00f30, ISA_ARMV7, I_SSAT16},
+    {0x0ff00ff0, 0x06100f50, ISA_ARMV7, I_SSAX},
+    {0x0ff00ff0, 0x06100f70, ISA_ARMV7, I_SSUB16},
+    {0x0ff00ff0, 0x06100ff0, ISA_ARMV7, I_SSUB8},
+    {0x0e100000, 0x0c000000, ISA_ARMV7, I_STC},
+    {0xfe100000, 0xfc000000, ISA_ARMV7, I_STC2},
+    {0x0fd00000, 0x08800000, ISA_ARMV7, I_STM},
+    {0x0fd00000, 0x08000000, ISA_ARMV7, I_STMDA},
+    {0x0fd00000, 0x09000000, ISA_ARMV7, I_STMDB},
+    {0x0fd00000, 0x09800000, ISA_ARMV7, I_STMIB},
+    {0x0e500000, 0x04000000, ISA_ARMV7, I_STR},
+    {0x0e500010, 0x06000000, ISA_ARMV7, I_STR},
+    {0x0e500000, 0x04400000, ISA_ARMV7, I_STRB},
+    {0x0e500010, 0x06400000, ISA_ARMV7, I_STRB},
+    {0x0f700000, 0x04600000, ISA_ARMV7, I_STRBT},
+    {0x0f700010, 0x06600000, ISA_ARMV7, I_STRBT},
+    {0x0e5000f0, 0x004000f0, ISA_ARMV7, I_STRD},
+    {0x0e500ff0, 0x000000f0, ISA_ARMV7, I_STRD},
+    {0x0ff00ff0, 0x01800f90, ISA_ARMV7, I_STREX},
+    {0x0ff00ff0, 0x01c00f90, ISA_ARMV7, I_STREXB},
+    {0x0ff00ff0, 0x01a00f90, ISA_ARMV7, I_STREXD},
+    {0x0ff00ff0, 0x01e00f90, ISA_ARMV7, I_STREXH},
+    {0x0e5000f0, 0x004000b0, ISA_ARMV7, I_STRH},
+    {0x0e500ff0, 0x000000b0, ISA_ARMV7, I_STRH},
+    {0x0f7000f0, 0x006000b0, ISA_ARMV7, I_STRHT},
+    {0x0f700ff0, 0x002000b0, ISA_ARMV7, I_STRHT},
+    {0x0f700000, 0x04200000, ISA_ARMV7, I_STRT},
+    {0x0f700010, 0x06200000, ISA_ARMV7, I_STRT},
+    {0x0fe00000, 0x02400000, ISA_ARMV7, I_SUB},
+    {0x0fe00010, 0x00400000, ISA_ARMV7, I_SUB},
+    {0x0fe00090, 0x00400010, ISA_ARMV7, I_SUB},
+    {0x0f000000, 0x0f000000, ISA_ARMV7, I_SVC},
+    {0x0ff00ff0, 0x01000090, ISA_ARMV7, I_SWP},
+    {0x0ff00ff0, 0x01400090, ISA_ARMV7, I_SWPB},
+    {0x0ff003f0, 0x06a00070, ISA_ARMV7, I_SXTAB},
+    {0x0ff003f0, 0x06800070, ISA_ARMV7, I_SXTAB16},
+    {0x0ff003f0, 0x06b00070, ISA_ARMV7, I_SXTAH},
+    {0x0fff03f0, 0x06af0070, ISA_ARMV7, I_SXTB},
+    {0x0fff03f0, 0x068f0070, ISA_ARMV7, I_SXTB16},
+    {0x0fff03f0, 0x06bf0070, ISA_ARMV7, I_SXTH},
+    {0x0ff0f000, 0x03300000, ISA_ARMV7, I_TEQ},
+    {0x0ff0f010, 0x01300000, ISA_ARMV7, I_TEQ},
+    {0x0ff0f090, 0x01300010, ISA_ARMV7, I_TEQ},
+    {0x0ff0f000, 0x03100000, ISA_ARMV7, I_TST},
+    {0x0ff0f010, 0x01100000, ISA_ARMV7, I_TST},
+    {0x0ff0f090, 0x01100010, ISA_ARMV7, I_TST},
+    {0x0ff00ff0, 0x06500f10, ISA_ARMV7, I_UADD16},
+    {0x0ff00ff0, 0x06500f90, ISA_ARMV7, I_UADD8},
+    {0x0ff00ff0, 0x06500f30, ISA_ARMV7, I_UASX},
+    {0x0fe00070, 0x07e00050, ISA_ARMV7, I_UBFX},
+    {0x0ff000f0, 0x07f000f0, ISA_ARMV7, I_UDF},
+    {0x0ff00ff0, 0x06700f10, ISA_ARMV7, I_UHADD16},
+    {0x0ff00ff0, 0x06700f90, ISA_ARMV7, I_UHADD8},
+    {0x0ff00ff0, 0x06700f30, ISA_ARMV7, I_UHASX},
+    {0x0ff00ff0, 0x06700f50, ISA_ARMV7, I_UHSAX},
+    {0x0ff00ff0, 0x06700f70, ISA_ARMV7, I_UHSUB16},
+    {0x0ff00ff0, 0x06700ff0, ISA_ARMV7, I_UHSUB8},
+    {0x0ff000f0, 0x00400090, ISA_ARMV7, I_UMAAL},
+    {0x0fe000f0, 0x00a00090, ISA_ARMV7, I_UMLAL},
+    {0x0fe000f0, 0x00800090, ISA_ARMV7, I_UMULL},
+    {0x0ff00ff0, 0x06600f10, ISA_ARMV7, I_UQADD16},
+    {0x0ff00ff0, 0x06600f90, ISA_ARMV7, I_UQADD8},
+    {0x0ff00ff0, 0x06600f30, ISA_ARMV7, I_UQASX},
+    {0x0ff00ff0, 0x06600f50, ISA_ARMV7, I_UQSAX},
+    {0x0ff00ff0, 0x06600f70, ISA_ARMV7, I_UQSUB16},
+    {0x0ff00ff0, 0x06600ff0, ISA_ARMV7, I_UQSUB8},
+    {0x0ff0f0f0, 0x0780f010, ISA_ARMV7, I_USAD8},
+    {0x0ff000f0, 0x07800010, ISA_ARMV7, I_USADA8},
+    {0x0fe00030, 0x06e00010, ISA_ARMV7, I_USAT},
+    {0x0ff00ff0, 0x06e00f30, ISA_ARMV7, I_USAT16},
+    {0x0ff00ff0, 0x06500f50, ISA_ARMV7, I_USAX},
+    {0x0ff00ff0, 0x06500f70, ISA_ARMV7, I_USUB16},
+    {0x0ff00ff0, 0x06500ff0, ISA_ARMV7, I_USUB8},
+    {0x0ff003f0, 0x06e00070, ISA_ARMV7, I_UXTAB},
+    {0x0ff003f0, 0x06c00070, ISA_ARMV7, I_UXTAB16},
+    {0x0ff003f0, 0x06f00070, ISA_ARMV7, I_UXTAH},
+    {0x0fff03f0, 0x06ef0070, ISA_ARMV7, I_UXTB},
+    {0x0fff03f0, 0x06cf0070, ISA_ARMV7, I_UXTB16},
+    {0x0fff03f0, 0x06ff0070, ISA_ARMV7, I_UXTH},
+    {0x0fffffff, 0x0320f002, ISA_ARMV7, I_WFE},
+    {0x0fffffff, 0x0320f003, ISA_ARMV7, I_WFI},
+    {0x0fffffff, 0x0320f001, ISA_ARMV7, I_YIELD},
+    {0x0fbf0fff, 0x010f0000, ISA_ARMV7, I_MRS},
+    {0x0ffffff0, 0x01600070, ISA_ARMV7, I_SMC},
+    {0xfbe08000, 0xf1400000, ISA_THUMB2, I_ADC},
+    {0xffc00000, 0x41400000, ISA_THUMB, I_ADC},
+    {0xffe08000, 0xeb400000, ISA_THUMB2, I_ADC},
+    {0xfe000000, 0x1c000000, ISA_THUMB, I_ADD},
+    {0xf8000000, 0x30000000, ISA_THUMB, I_ADD},
+    {0xfbe08000, 0xf1000000, ISA_THUMB2, I_ADD},
+    {0xfbf08000, 0xf2000000, ISA_THUMB2, I_ADDW},
+    {0xfe000000, 0x18000000, ISA_THUMB, I_ADD},
+    {0xffe08000, 0xeb000000, ISA_THUMB2, I_ADD},
+    {0xf8000000, 0xa8000000, ISA_THUMB, I_ADD},
+    {0xff800000, 0xb0000000, ISA_THUMB, I_ADD},
+    {0xfbef8000, 0xf10d0000, ISA_THUMB2, I_ADD},
+    {0xfbff8000, 0xf20d0000, ISA_THUMB2, I_ADDW},
+    {0xff870000, 0x44850000, ISA_THUMB, I_ADD},
+    {0xffef8000, 0xeb0d0000, ISA_THUMB2, I_ADD},
+    {0xf8000000, 0xa0000000, ISA_THUMB, I_ADR},
+    {0xfbff8000, 0xf2af0000, ISA_THUMB2, I_ADR},
+    {0xfbff8000, 0xf20f0000, ISA_THUMB2, I_ADR},
+    {0xfbe08000, 0xf0000000, ISA_THUMB2, I_AND},
+    {0xffc00000, 0x40000000, ISA_THUMB, I_AND},
+    {0xffe08000, 0xea000000, ISA_THUMB2, I_AND},
+    {0xf8000000, 0x10000000, ISA_THUMB, I_ASR},
+    {0xffef8030, 0xea4f0020, ISA_THUMB2, I_ASR},
+    {0xffc00000, 0x41000000, ISA_THUMB, I_ASR},
+    {0xffe0f0f0, 0xfa40f000, ISA_THUMB2, I_ASR},
+    {0xf0000000, 0xd0000000, ISA_THUMB, I_B},
+    {0xf8000000, 0xe0000000, ISA_THUMB, I_B},
+    {0xf800d000, 0xf0008000, ISA_THUMB2, I_B},
+    {0xf800d000, 0xf0009000, ISA_THUMB2, I_B},
+    {0xffff8020, 0xf36f0000, ISA_THUMB2, I_BFC},
+    {0xfff08020, 0xf3600000, ISA_THUMB2, I_BFI},
+    {0xfbe08000, 0xf0200000, ISA_THUMB2, I_BIC},
+    {0xffc00000, 0x43800000, ISA_THUMB, I_BIC},
+    {0xffe08000, 0xea200000, ISA_THUMB2, I_BIC},
+    {0xff000000, 0xbe000000, ISA_THUMB, I_BKPT},
+    {0xf800d000, 0xf000d000, ISA_THUMB2, I_BL},
+    {0xf800d000, 0xf000c000, ISA_THUMB2, I_BLX},
+    {0xff870000, 0x47800000, ISA_THUMB, I_BLX},
+    {0xff870000, 0x47000000, ISA_THUMB, I_BX},
+    {0xfff0ffff, 0xf3c08f00, ISA_THUMB2, I_BXJ},
+    {0xf5000000, 0xb1000000, ISA_THUMB, I_CBZ},
+    {0xffffffff, 0xf3bf8f2f, ISA_THUMB2, I_CLREX},
+    {0xfff0f0f0, 0xfab0f080, ISA_THUMB2, I_CLZ},
+    {0xfbf08f00, 0xf1100f00, ISA_THUMB2, I_CMN},
+    {0xffc00000, 0x42c00000, ISA_THUMB, I_CMN},
+    {0xfff08f00, 0xeb100f00, ISA_THUMB2, I_CMN},
+    {0xf8000000, 0x28000000, ISA_THUMB, I_CMP},
+    {0xfbf08f00, 0xf1b00f00, ISA_THUMB2, I_CMP},
+    {0xffc00000, 0x42800000, ISA_THUMB, I_CMP},
+    {0xff000000, 0x45000000, ISA_THUMB, I_CMP},
+    {0xfff08f00, 0xebb00f00, ISA_THUMB2, I_CMP},
+    {0xfffffff0, 0xf3af80f0, ISA_THUMB2, I_DBG},
+    {0xfffffff0, 0xf3bf8f50, ISA_THUMB2, I_DMB},
+    {0xfffffff0, 0xf3bf8f40, ISA_THUMB2, I_DSB},
+    {0xfbe08000, 0xf0800000, ISA_THUMB2, I_EOR},
+    {0xffc00000, 0x40400000, ISA_THUMB, I_EOR},
+    {0xffe08000, 0xea800000, ISA_THUMB2, I_EOR},
+    {0xfffffff0, 0xf3bf8f60, ISA_THUMB2, I_ISB},
+    {0xff000000, 0xbf000000, ISA_THUMB, I_IT},
+    {0xf8000000, 0xc8000000, ISA_THUMB, I_LDM},
+    {0xffd00000, 0xe8900000, ISA_THUMB2, I_LDM},
+    {0xffd00000, 0xe9100000, ISA_THUMB2, I_LDMDB},
+    {0xf8000000, 0x68000000, ISA_THUMB, I_LDR},
+    {0xf8000000, 0x98000000, ISA_THUMB, I_LDR},
+    {0xfff00000, 0xf8d00000, ISA_THUMB2, I_LDR},
+    {0xfff00800, 0xf8500800, ISA_THUMB2, I_LDR},
+    {0xf8000000, 0x48000000, ISA_THUMB, I_LDR},
+    {0xff7f0000, 0xf85f0000, ISA_THUMB2, I_LDR},
+    {0xfe000000, 0x58000000, ISA_THUMB, I_LDR},
+    {0xfff00fc0, 0xf8500000, ISA_THUMB2, I_LDR},
+    {0xf8000000, 0x78000000, ISA_THUMB, I_LDRB},
+    {0xfff00000, 0xf8900000, ISA_THUMB2, I_LDRB},
+    {0xfff00800, 0xf8100800, ISA_THUMB2, I_LDRB},
+    {0xff7f0000, 0xf81f0000, ISA_THUMB2, I_LDRB},
+    {0xfe000000, 0x5c000000, ISA_THUMB, I_LDRB},
+    {0xfff00fc0, 0xf8100000, ISA_THUMB2, I_LDRB},
+    {0xfff00f00, 0xf8100e00, ISA_THUMB2, I_LDRBT},
+    {0xfe500000, 0xe8500000, ISA_THUMB2, I_LDRD},
+    {0xfe5f0000, 0xe85f0000, ISA_THUMB2, I_LDRD},
+    {0xfff00f00, 0xe8500f00, ISA_THUMB2, I_LDREX},
+    {0xfff00fff, 0xe8d00f4f, ISA_THUMB2, I_LDREXB},
+    {0xfff000ff, 0xe8d0007f, ISA_THUMB2, I_LDREXD},
+    {0xfff00fff, 0xe8d00f5f, ISA_THUMB2, I_LDREXH},
+    {0xf8000000, 0x88000000, ISA_THUMB, I_LDRH},
+    {0xfff00000, 0xf8b00000, ISA_THUMB2, I_LDRH},
+    {0xfff00800, 0xf8300800, ISA_THUMB2, I_LDRH},
+    {0xff7f0000, 0xf83f0000, ISA_THUMB2, I_LDRH},
+    {0xfe000000, 0x5a000000, ISA_THUMB, I_LDRH},
+    {0xfff00fc0, 0xf8300000, ISA_THUMB2, I_LDRH},
+    {0xfff00f00, 0xf8300e00, ISA_THUMB2, I_LDRHT},
+    {0xfff00000, 0xf9900000, ISA_THUMB2, I_LDRSB},
+    {0xfff00800, 0xf9100800, ISA_THUMB2, I_LDRSB},
+    {0xff7f0000, 0xf91f0000, ISA_THUMB2, I_LDRSB},
+    {0xfe000000, 0x56000000, ISA_THUMB, I_LDRSB},
+    {0xfff00fc0, 0xf9100000, ISA_THUMB2, I_LDRSB},
+    {0xfff00f00, 0xf9100e00, ISA_THUMB2, I_LDRSBT},
+    {0xfff00000, 0xf9b00000, ISA_THUMB2, I_LDRSH},
+    {0xfff00800, 0xf9300800, ISA_THUMB2, I_LDRSH},
+    {0xff7f0000, 0xf93f0000, ISA_THUMB2, I_LDRSH},
+    {0xfe000000, 0x5e000000, ISA_THUMB, I_LDRSH},
+    {0xfff00fc0, 0xf9300000, ISA_THUMB2, I_LDRSH},
+    {0xfff00f00, 0xf9300e00, ISA_THUMB2, I_LDRSHT},
+    {0xfff00f00, 0xf8500e00, ISA_THUMB2, I_LDRT},
+    {0xf8000000, 0x00000000, ISA_THUMB, I_LSL},
+    {0xffef8030, 0xea4f0000, ISA_THUMB2, I_LSL},
+    {0xffc00000, 0x40800000, ISA_THUMB, I_LSL},
+    {0xffe0f0f0, 0xfa00f000, ISA_THUMB2, I_LSL},
+    {0xf8000000, 0x08000000, ISA_THUMB, I_LSR},
+    {0xffef8030, 0xea4f0010, ISA_THUMB2, I_LSR},
+    {0xffc00000, 0x40c00000, ISA_THUMB, I_LSR},
+    {0xffe0f0f0, 0xfa20f000, ISA_THUMB2, I_LSR},
+    {0xfff000f0, 0xfb000000, ISA_THUMB2, I_MLA},
+    {0xfff000f0, 0xfb000010, ISA_THUMB2, I_MLS},
+    {0xf8000000, 0x20000000, ISA_THUMB, I_MOV},
+    {0xfbef8000, 0xf04f0000, ISA_THUMB2, I_MOV},
+    {0xfbf08000, 0xf2400000, ISA_THUMB2, I_MOVW},
+    {0xff000000, 0x46000000, ISA_THUMB, I_MOV},
+    {0xffeff0f0, 0xea4f0000, ISA_THUMB2, I_MOV},
+    {0xfbf08000, 0xf2c00000, ISA_THUMB2, I_MOVT},
+    {0xfffff0ff, 0xf3ef8000, ISA_THUMB2, I_MRS},
+    {0xffc00000, 0x43400000, ISA_THUMB, I_MUL},
+    {0xfff0f0f0, 0xfb00f000, ISA_THUMB2, I_MUL},
+    {0xfbef8000, 0xf06f0000, ISA_THUMB2, I_MVN},
+    {0xffc00000, 0x43c00000, ISA_THUMB, I_MVN},
+    {0xffef8000, 0xea6f0000, ISA_THUMB2, I_MVN},
+    {0xffff0000, 0xbf000000, ISA_THUMB, I_NOP},
+    {0xffffffff, 0xf3af8000, ISA_THUMB2, I_NOP},
+    {0xfbe08000, 0xf0600000, ISA_THUMB2, I_ORN},
+    {0xffe08000, 0xea600000, ISA_THUMB2, I_ORN},
+    {0xfbe08000, 0xf0400000, ISA_THUMB2, I_ORR},
+    {0xffc00000, 0x43000000, ISA_THUMB, I_ORR},
+    {0xffe08000, 0xea400000, ISA_THUMB2, I_ORR},
+    {0xffd0f000, 0xf890f000, ISA_THUMB2, I_PLD},
+    {0xffd0ff00, 0xf810fc00, ISA_THUMB2, I_PLD},
+    {0xff7ff000, 0xf81ff000, ISA_THUMB2, I_PLD},
+    {0xffd0ffc0, 0xf810f000, ISA_THUMB2, I_PLD},
+    {0xfff0f000, 0xf990f000, ISA_THUMB2, I_PLI},
+    {0xfff0ff00, 0xf910fc00, ISA_THUMB2, I_PLI},
+    {0xff7ff000, 0xf91ff000, ISA_THUMB2, I_PLI},
+    {0xfff0ffc0, 0xf910f000, ISA_THUMB2, I_PLI},
+    {0xfe000000, 0xbc000000, ISA_THUMB, I_POP},
+    {0xffff0000, 0xe8bd0000, ISA_THUMB2, I_POP},
+    {0xffff0fff, 0xf85d0b04, ISA_THUMB2, I_POP},
+    {0xfe000000, 0xb4000000, ISA_THUMB, I_PUSH},
+    {0xffff0000, 0xe92d0000, ISA_THUMB2, I_PUSH},
+    {0xffff0fff, 0xf84d0d04, ISA_THUMB2, I_PUSH},
+    {0xfff0f0f0, 0xfa80f080, ISA_THUMB2, I_QADD},
+    {0xfff0f0f0, 0xfa90f010, ISA_THUMB2, I_QADD16},
+    {0xfff0f0f0, 0xfa80f010, ISA_THUMB2, I_QADD8},
+    {0xfff0f0f0, 0xfaa0f010, ISA_THUMB2, I_QASX},
+    {0xfff0f0f0, 0xfa80f090, ISA_THUMB2, I_QDADD},
+    {0xfff0f0f0, 0xfa80f0b0, ISA_THUMB2, I_QDSUB},
+    {0xfff0f0f0, 0xfae0f010, ISA_THUMB2, I_QSAX},
+    {0xfff0f0f0, 0xfa80f0a0, ISA_THUMB2, I_QSUB},
+    {0xfff0f0f0, 0xfad0f010, ISA_THUMB2, I_QSUB16},
+    {0xfff0f0f0, 0xfac0f010, ISA_THUMB2, I_QSUB8},
+    {0xfff0f0f0, 0xfa90f0a0, ISA_THUMB2, I_RBIT},
+    {0xffc00000, 0xba000000, ISA_THUMB, I_REV},
+    {0xfff0f0f0, 0xfa90f080, ISA_THUMB2, I_REV},
+    {0xffc00000, 0xba400000, ISA_THUMB, I_REV16},
+    {0xfff0f0f0, 0xfa90f090, ISA_THUMB2, I_REV16},
+    {0xffc00000, 0xbac00000, ISA_THUMB, I_REVSH},
+    {0xfff0f0f0, 0xfa90f0b0, ISA_THUMB2, I_REVSH},
+    {0xffef8030, 0xea4f0030, ISA_THUMB2, I_ROR},
+    {0xffc00000, 0x41c00000, ISA_THUMB, I_ROR},
+    {0xffe0f0f0, 0xfa60f000, ISA_THUMB2, I_ROR},
+    {0xffeff0f0, 0xea4f0030, ISA_THUMB2, I_RRX},
+    {0xffc00000, 0x42400000, ISA_THUMB, I_RSB},
+    {0xfbe08000, 0xf1c00000, ISA_THUMB2, I_RSB},
+    {0xffe08000, 0xebc00000, ISA_THUMB2, I_RSB},
+    {0xfff0f0f0, 0xfa90f000, ISA_THUMB2, I_SADD16},
+    {0xfff0f0f0, 0xfa80f000, ISA_THUMB2, I_SADD8},
+    {0xfff0f0f0, 0xfaa0f000, ISA_THUMB2, I_SASX},
+    {0xfbe08000, 0xf1600000, ISA_THUMB2, I_SBC},
+    {0xffc00000, 0x41800000, ISA_THUMB, I_SBC},
+    {0xffe08000, 0xeb600000, ISA_THUMB2, I_SBC},
+    {0xfff08020, 0xf3400000, ISA_THUMB2, I_SBFX},
+    {0xfff0f0f0, 0xfb90f0f0, ISA_THUMB2, I_SDIV},
+    {0xfff0f0f0, 0xfaa0f080, ISA_THUMB2, I_SEL},
+    {0xfff70000, 0xb6500000, ISA_THUMB, I_SETEND},
+    {0xffff0000, 0xbf400000, ISA_THUMB, I_SEV},
+    {0xffffffff, 0xf3af8004, ISA_THUMB2, I_SEV},
+    {0xfff0f0f0, 0xfa90f020, ISA_THUMB2, I_SHADD16},
+    {0xfff0f0f0, 0xfa80f020, ISA_THUMB2, I_SHADD8},
+    {0xfff0f0f0, 0xfaa0f020, ISA_THUMB2, I_SHASX},
+    {0xfff0f0f0, 0xfae0f020, ISA_THUMB2, I_SHSAX},
+    {0xfff0f0f0, 0xfad0f020, ISA_THUMB2, I_SHSUB16},
+    {0xfff0f0f0, 0xfac0f020, ISA_THUMB2, I_SHSUB8},
+    {0xfff000c0, 0xfb100000, ISA_THUMB2, I_SMLA},
+    {0xfff000e0, 0xfb200000, ISA_THUMB2, I_SMLAD},
+    {0xfff000f0, 0xfbc00000, ISA_THUMB2, I_SMLAL},
+    {0xfff000c0, 0xfbc00080, ISA_THUMB2, I_SMLAL},
+    {0xfff000e0, 0xfbc000c0, ISA_THUMB2, I_SMLALD},
+    {0xfff000e0, 0xfb300000, ISA_THUMB2, I_SMLAW},
+    {0xfff000e0, 0xfb400000, ISA_THUMB2, I_SMLSD},
+    {0xfff000e0, 0xfbd000c0, ISA_THUMB2, I_SMLSLD},
+    {0xfff000e0, 0xfb500000, ISA_THUMB2, I_SMMLA},
+    {0xfff000e0, 0xfb600000, ISA_THUMB2, I_SMMLS},
+    {0xfff0f0e0, 0xfb50f000, ISA_THUMB2, I_SMMUL},
+    {0xfff0f0e0, 0xfb20f000, ISA_THUMB2, I_SMUAD},
+    {0xfff0f0c0, 0xfb10f000, ISA_THUMB2, I_SMUL},
+    {0xfff000f0, 0xfb800000, ISA_THUMB2, I_SMULL},
+    {0xfff0f0e0, 0xfb30f000, ISA_THUMB2, I_SMULW},
+    {0xfff0f0e0, 0xfb40f000, ISA_THUMB2, I_SMUSD},
+    {0xfff0f0f0, 0xfae0f000, ISA_THUMB2, I_SSAX},
+    {0xfff0f0f0, 0xfad0f000, ISA_THUMB2, I_SSUB16},
+    {0xfff0f0f0, 0xfac0f000, ISA_THUMB2, I_SSUB8},
+    {0xf8000000, 0xc0000000, ISA_THUMB, I_STM},
+    {0xffd00000, 0xe8800000, ISA_THUMB2, I_STM},
+    {0xffd00000, 0xe9000000, ISA_THUMB2, I_STMDB},
+    {0xf8000000, 0x60000000, ISA_THUMB, I_STR},
+    {0xf8000000, 0x90000000, ISA_THUMB, I_STR},
+    {0xfff00000, 0xf8c00000, ISA_THUMB2, I_STR},
+    {0xfff00800, 0xf8400800, ISA_THUMB2, I_STR},
+    {0xfe000000, 0x50000000, ISA_THUMB, I_STR},
+    {0xfff00fc0, 0xf8400000, ISA_THUMB2, I_STR},
+    {0xf8000000, 0x70000000, ISA_THUMB, I_STRB},
+    {0xfff00000, 0xf8800000, ISA_THUMB2, I_STRB},
+    {0xfff00800, 0xf8000800, ISA_THUMB2, I_STRB},
+    {0xfe000000, 0x54000000, ISA_THUMB, I_STRB},
+    {0xfff00fc0, 0xf8000000, ISA_THUMB2, I_STRB},
+    {0xfff00f00, 0xf8000e00, ISA_THUMB2, I_STRBT},
+    {0xfe500000, 0xe8400000, ISA_THUMB2, I_STRD},
+    {0xfff00000, 0xe8400000, ISA_THUMB2, I_STREX},
+    {0xfff00ff0, 0xe8c00f40, ISA_THUMB2, I_STREXB},
+    {0xfff000f0, 0xe8c00070, ISA_THUMB2, I_STREXD},
+    {0xfff00ff0, 0xe8c00f50, ISA_THUMB2, I_STREXH},
+    {0xf8000000, 0x80000000, ISA_THUMB, I_STRH},
+    {0xfff00000, 0xf8a00000, ISA_THUMB2, I_STRH},
+    {0xfff00800, 0xf8200800, ISA_THUMB2, I_STRH},
+    {0xfe000000, 0x52000000, ISA_THUMB, I_STRH},
+    {0xfff00fc0, 0xf8200000, ISA_THUMB2, I_STRH},
+    {0xfff00f00, 0xf8200e00, ISA_THUMB2, I_STRHT},
+    {0xfff00f00, 0xf8400e00, ISA_THUMB2, I_STRT},
+    {0xfe000000, 0x1e000000, ISA_THUMB, I_SUB},
+    {0xf8000000, 0x38000000, ISA_THUMB, I_SUB},
+    {0xfbe08000, 0xf1a00000, ISA_THUMB2, I_SUB},
+    {0xfbf08000, 0xf2a00000, ISA_THUMB2, I_SUBW},
+    {0xfe000000, 0x1a000000, ISA_THUMB, I_SUB},
+    {0xffe08000, 0xeba00000, ISA_THUMB2, I_SUB},
+    {0xff800000, 0xb0800000, ISA_THUMB, I_SUB},
+    {0xfbef8000, 0xf1ad0000, ISA_THUMB2, I_SUB},
+    {0xfbff8000, 0xf2ad0000, ISA_THUMB2, I_SUBW},
+    {0xffef8000, 0xebad0000, ISA_THUMB2, I_SUB},
+    {0xff000000, 0xdf000000, ISA_THUMB, I_SVC},
+    {0xfff0f0c0, 0xfa40f080, ISA_THUMB2, I_SXTAB},
+    {0xfff0f0c0, 0xfa20f080, ISA_THUMB2, I_SXTAB16},
+    {0xfff0f0c0, 0xfa00f080, ISA_THUMB2, I_SXTAH},
+    {0xffc00000, 0xb2400000, ISA_THUMB, I_SXTB},
+    {0xfffff0c0, 0xfa4ff080, ISA_THUMB2, I_SXTB},
+    {0xfffff0c0, 0xfa2ff080, ISA_THUMB2, I_SXTB16},
+    {0xffc00000, 0xb2000000, ISA_THUMB, I_SXTH},
+    {0xfffff0c0, 0xfa0ff080, ISA_THUMB2, I_SXTH},
+    {0xfff0ffe0, 0xe8d0f000, ISA_THUMB2, I_TBB},
+    {0xfbf08f00, 0xf0900f00, ISA_THUMB2, I_TEQ},
+    {0xfff08f00, 0xea900f00, ISA_THUMB2, I_TEQ},
+    {0xfbf08f00, 0xf0100f00, ISA_THUMB2, I_TST},
+    {0xffc00000, 0x42000000, ISA_THUMB, I_TST},
+    {0xfff08f00, 0xea100f00, ISA_THUMB2, I_TST},
+    {0xfff0f0f0, 0xfa90f040, ISA_THUMB2, I_UADD16},
+    {0xfff0f0f0, 0xfa80f040, ISA_THUMB2, I_UADD8},
+    {0xfff0f0f0, 0xfaa0f040, ISA_THUMB2, I_UASX},
+    {0xfff08020, 0xf3c00000, ISA_THUMB2, I_UBFX},
+    {0xff000000, 0xde000000, ISA_THUMB, I_UDF},
+    {0xfff0f000, 0xf7f0a000, ISA_THUMB2, I_UDF},
+    {0xfff0f0f0, 0xfbb0f0f0, ISA_THUMB2, I_UDIV},
+    {0xfff0f0f0, 0xfa90f060, ISA_THUMB2, I_UHADD16},
+    {0xfff0f0f0, 0xfa80f060, ISA_THUMB2, I_UHADD8},
+    {0xfff0f0f0, 0xfaa0f060, ISA_THUMB2, I_UHASX},
+    {0xfff0f0f0, 0xfae0f060, ISA_THUMB2, I_UHSAX},
+    {0xfff0f0f0, 0xfad0f060, ISA_THUMB2, I_UHSUB16},
+    {0xfff0f0f0, 0xfac0f060, ISA_THUMB2, I_UHSUB8},
+    {0xfff000f0, 0xfbe00060, ISA_THUMB2, I_UMAAL},
+    {0xfff000f0, 0xfbe00000, ISA_THUMB2, I_UMLAL},
+    {0xfff000f0, 0xfba00000, ISA_THUMB2, I_UMULL},
+    {0xfff0f0f0, 0xfa90f050, ISA_THUMB2, I_UQADD16},
+    {0xfff0f0f0, 0xfa80f050, ISA_THUMB2, I_UQADD8},
+    {0xfff0f0f0, 0xfaa0f050, ISA_THUMB2, I_UQASX},
+    {0xfff0f0f0, 0xfae0f050, ISA_THUMB2, I_UQSAX},
+    {0xfff0f0f0, 0xfad0f050, ISA_THUMB2, I_UQSUB16},
+    {0xfff0f0f0, 0xfac0f050, ISA_THUMB2, I_UQSUB8},
+    {0xfff0f0f0, 0xfb70f000, ISA_THUMB2, I_USAD8},
+    {0xfff000f0, 0xfb700000, ISA_THUMB2, I_USADA8},
+    {0xfff0f0f0, 0xfae0f040, ISA_THUMB2, I_USAX},
+    {0xfff0f0f0, 0xfad0f040, ISA_THUMB2, I_USUB16},
+    {0xfff0f0f0, 0xfac0f040, ISA_THUMB2, I_USUB8},
+    {0xfff0f0c0, 0xfa50f080, ISA_THUMB2, I_UXTAB},
+    {0xfff0f0c0, 0xfa30f080, ISA_THUMB2, I_UXTAB16},
+    {0xfff0f0c0, 0xfa10f080, ISA_THUMB2, I_UXTAH},
+    {0xffc00000, 0xb2c00000, ISA_THUMB, I_UXTB},
+    {0xfffff0c0, 0xfa5ff080, ISA_THUMB2, I_UXTB},
+    {0xfffff0c0, 0xfa3ff080, ISA_THUMB2, I_UXTB16},
+    {0xffc00000, 0xb2800000, ISA_THUMB, I_UXTH},
+    {0xfffff0c0, 0xfa1ff080, ISA_THUMB2, I_UXTH},
+    {0xffff0000, 0xbf200000, ISA_THUMB, I_WFE},
+    {0xffffffff, 0xf3af8002, ISA_THUMB2, I_WFE},
+    {0xffff0000, 0xbf300000, ISA_THUMB, I_WFI},
+    {0xffffffff, 0xf3af8003, ISA_THUMB2, I_WFI},
+    {0xffff0000, 0xbf100000, ISA_THUMB, I_YIELD},
+    {0xffffffff, 0xf3af8001, ISA_THUMB2, I_YIELD},
+};
+
+
+// ---- armv7-tbl.c ----
+#include <stdio.h>
+#include <stdint.h>
+const darm_lut_t armv7_instr_lut[] = {
+    DARM_LUT(I_AND, T_ARM_ARITH_SHIFT), DARM_LUT(I_AND, T_ARM_ARITH_SHIFT),
+    DARM_LUT(I_EOR, T_ARM_ARITH_SHIFT), DARM_LUT(I_EOR, T_ARM_ARITH_SHIFT),
+    DARM_LUT(I_SUB, T_ARM_ARITH_SHIFT), DARM_LUT(I_SUB, T_ARM_ARITH_SHIFT),
+    DARM_LUT(I_RSB, T_ARM_ARITH_SHIFT), DARM_LUT(I_RSB, T_ARM_ARITH_SHIFT),
+    DARM_LUT(I_ADD, T_ARM_ARITH_SHIFT), DARM_LUT(I_ADD, T_ARM_ARITH_SHIFT),
+    DARM_LUT(I_ADC, T_ARM_ARITH_SHIFT), DARM_LUT(I_ADC, T_ARM_ARITH_SHIFT),
+    DARM_LUT(I_SBC, T_ARM_ARITH_SHIFT), DARM_LUT(I_SBC, T_ARM_ARITH_SHIFT),
+    DARM_LUT(I_RSC, T_ARM_ARITH_SHIFT), DARM_LUT(I_RSC, T_ARM_ARITH_SHIFT),
+    DARM_LUT(I_SMLA, T_ARM_SM), DARM_LUT(I_TST, T_ARM_CMP_OP),
+    DARM_LUT(I_SMULW, T_ARM_BRNCHMISC), DARM_LUT(I_TEQ, T_ARM_CMP_OP),
+    DARM_LUT(I_SMLAL, T_ARM_SM), DARM_LUT(I_CMP, T_ARM_CMP_OP),
+    DARM_LUT(I_SMC, T_ARM_MISC), DARM_LUT(I_CMN, T_ARM_CMP_OP),
+    DARM_LUT(I_ORR, T_ARM_ARITH_SHIFT), DARM_LUT(I_ORR, T_ARM_ARITH_SHIFT),
+    DARM_LUT(I_STREXD, T_ARM_DST_SRC), DARM_LUT(I_RRX, T_ARM_DST_SRC),
+    DARM_LUT(I_BIC, T_ARM_ARITH_SHIFT), DARM_LUT(I_BIC, T_ARM_ARITH_SHIFT),
+    DARM_LUT(I_MVN, T_ARM_MISC), DARM_LUT(I_MVN, T_ARM_MISC), DARM_LUT(I_AND,
+    T_ARM_ARITH_IMM), DARM_LUT(I_AND, T_ARM_ARITH_IMM), DARM_LUT(I_EOR,
+    T_ARM_ARITH_IMM), DARM_LUT(I_EOR, T_ARM_ARITH_IMM), DARM_LUT(I_SUB,
+    T_ARM_ARITH_IMM), DARM_LUT(I_SUB, T_ARM_ARITH_IMM), DARM_LUT(I_RSB,
+    T_ARM_ARITH_IMM), DARM_LUT(I_RSB, T_ARM_ARITH_IMM), DARM_LUT(I_ADD,
+    T_ARM_ARITH_IMM), DARM_LUT(I_ADD, T_ARM_ARITH_IMM), DARM_LUT(I_ADC,
+    T_ARM_ARITH_IMM), DARM_LUT(I_ADC, T_ARM_ARITH_IMM), DARM_LUT(I_SBC,
+    T_ARM_ARITH_IMM), DARM_LUT(I_SBC, T_ARM_ARITH_IMM), DARM_LUT(I_RSC,
+    T_ARM_ARITH_IMM), DARM_LUT(I_RSC, T_ARM_ARITH_IMM), DARM_LUT(I_MOVW,
+    T_ARM_MOV_IMM), DARM_LUT(I_TST, T_ARM_CMP_IMM), DARM_LUT(I_YIELD,
+    T_ARM_OPLESS), DARM_LUT(I_TEQ, T_ARM_CMP_IMM), DARM_LUT(I_MOVT,
+    T_ARM_MOV_IMM), DARM_LUT(I_CMP, T_ARM_CMP_IMM), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_CMN, T_ARM_CMP_IMM), DARM_LUT(I_ORR,
+    T_ARM_ARITH_IMM), DARM_LUT(I_ORR, T_ARM_ARITH_IMM), DARM_LUT(I_MOV,
+    T_ARM_MOV_IMM), DARM_LUT(I_MOV, T_ARM_MOV_IMM), DARM_LUT(I_BIC,
+    T_ARM_ARITH_IMM), DARM_LUT(I_BIC, T_ARM_ARITH_IMM), DARM_LUT(I_MVN,
+    T_ARM_MOV_IMM), DARM_LUT(I_MVN, T_ARM_MOV_IMM), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_SSUB8, T_ARM_PAS), DARM_LUT(I_QSUB8, T_ARM_PAS),
+    DARM_LUT(I_SHSUB8, T_ARM_PAS), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_USUB8, T_ARM_PAS), DARM_LUT(I_UQSUB8, T_ARM_PAS),
+    DARM_LUT(I_UHSUB8, T_ARM_PAS), DARM_LUT(I_SEL, T_ARM_MISC),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_REV16,
+    T_ARM_BITREV), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_REVSH, T_ARM_BITREV),
+    DARM_LUT(I_SMUSD, T_ARM_SM), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_SMLSLD, T_ARM_SM),
+    DARM_LUT(I_SMMUL, T_ARM_SM), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_SBFX, T_ARM_BITS), DARM_LUT(I_SBFX, T_ARM_BITS),
+    DARM_LUT(I_BFI, T_ARM_BITS), DARM_LUT(I_BFI, T_ARM_BITS), DARM_LUT(I_UBFX,
+    T_ARM_BITS), DARM_LUT(I_UDF, T_ARM_UDF), DARM_LUT(I_STMDA,
+    T_ARM_LDSTREGS), DARM_LUT(I_LDMDA, T_ARM_LDSTREGS), DARM_LUT(I_STMDA,
+    T_ARM_LDSTREGS), DARM_LUT(I_LDMDA, T_ARM_LDSTREGS), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_STM, T_ARM_LDSTREGS),
+    DARM_LUT(I_LDM, T_ARM_LDSTREGS), DARM_LUT(I_STM, T_ARM_LDSTREGS),
+    DARM_LUT(I_LDM, T_ARM_LDSTREGS), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_STMDB, T_ARM_LDSTREGS), DARM_LUT(I_LDMDB,
+    T_ARM_LDSTREGS), DARM_LUT(I_STMDB, T_ARM_LDSTREGS), DARM_LUT(I_LDMDB,
+    T_ARM_LDSTREGS), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_STMIB,
+    T_ARM_LDSTREGS), DARM_LUT(I_LDMIB, T_ARM_LDSTREGS), DARM_LUT(I_STMIB,
+    T_ARM_LDSTREGS), DARM_LUT(I_LDMIB, T_ARM_LDSTREGS), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_B, T_ARM_BRNCHSC), DARM_LUT(I_B,
+    T_ARM_BRNCHSC), DARM_LUT(I_B, T_ARM_BRNCHSC), DARM_LUT(I_B,
+    T_ARM_BRNCHSC), DARM_LUT(I_B, T_ARM_BRNCHSC), DARM_LUT(I_B,
+    T_ARM_BRNCHSC), DARM_LUT(I_B, T_ARM_BRNCHSC), DARM_LUT(I_B,
+    T_ARM_BRNCHSC), DARM_LUT(I_B, T_ARM_BRNCHSC), DARM_LUT(I_B,
+    T_ARM_BRNCHSC), DARM_LUT(I_B, T_ARM_BRNCHSC), DARM_LUT(I_B,
+    T_ARM_BRNCHSC), DARM_LUT(I_B, T_ARM_BRNCHSC), DARM_LUT(I_B,
+    T_ARM_BRNCHSC), DARM_LUT(I_B, T_ARM_BRNCHSC), DARM_LUT(I_B,
+    T_ARM_BRNCHSC), DARM_LUT(I_BL, T_ARM_BRNCHSC), DARM_LUT(I_BL,
+    T_ARM_BRNCHSC), DARM_LUT(I_BL, T_ARM_BRNCHSC), DARM_LUT(I_BL,
+    T_ARM_BRNCHSC), DARM_LUT(I_BL, T_ARM_BRNCHSC), DARM_LUT(I_BL,
+    T_ARM_BRNCHSC), DARM_LUT(I_BL, T_ARM_BRNCHSC), DARM_LUT(I_BL,
+    T_ARM_BRNCHSC), DARM_LUT(I_BL, T_ARM_BRNCHSC), DARM_LUT(I_BL,
+    T_ARM_BRNCHSC), DARM_LUT(I_BL, T_ARM_BRNCHSC), DARM_LUT(I_BL,
+    T_ARM_BRNCHSC), DARM_LUT(I_BL, T_ARM_BRNCHSC), DARM_LUT(I_BL,
+    T_ARM_BRNCHSC), DARM_LUT(I_BL, T_ARM_BRNCHSC), DARM_LUT(I_BL,
+    T_ARM_BRNCHSC), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_MCR, T_ARM_MVCR), DARM_LUT(I_MRC, T_ARM_MVCR), DARM_LUT(I_MCR,
+    T_ARM_MVCR), DARM_LUT(I_MRC, T_ARM_MVCR), DARM_LUT(I_MCR, T_ARM_MVCR),
+    DARM_LUT(I_MRC, T_ARM_MVCR), DARM_LUT(I_MCR, T_ARM_MVCR), DARM_LUT(I_MRC,
+    T_ARM_MVCR), DARM_LUT(I_MCR, T_ARM_MVCR), DARM_LUT(I_MRC, T_ARM_MVCR),
+    DARM_LUT(I_MCR, T_ARM_MVCR), DARM_LUT(I_MRC, T_ARM_MVCR), DARM_LUT(I_MCR,
+    T_ARM_MVCR), DARM_LUT(I_MRC, T_ARM_MVCR), DARM_LUT(I_MCR, T_ARM_MVCR),
+    DARM_LUT(I_MRC, T_ARM_MVCR), DARM_LUT(I_SVC, T_ARM_BRNCHSC),
+    DARM_LUT(I_SVC, T_ARM_BRNCHSC), DARM_LUT(I_SVC, T_ARM_BRNCHSC),
+    DARM_LUT(I_SVC, T_ARM_BRNCHSC), DARM_LUT(I_SVC, T_ARM_BRNCHSC),
+    DARM_LUT(I_SVC, T_ARM_BRNCHSC), DARM_LUT(I_SVC, T_ARM_BRNCHSC),
+    DARM_LUT(I_SVC, T_ARM_BRNCHSC), DARM_LUT(I_SVC, T_ARM_BRNCHSC),
+    DARM_LUT(I_SVC, T_ARM_BRNCHSC), DARM_LUT(I_SVC, T_ARM_BRNCHSC),
+    DARM_LUT(I_SVC, T_ARM_BRNCHSC), DARM_LUT(I_SVC, T_ARM_BRNCHSC),
+    DARM_LUT(I_SVC, T_ARM_BRNCHSC), DARM_LUT(I_SVC, T_ARM_BRNCHSC),
+    DARM_LUT(I_SVC, T_ARM_BRNCHSC)
+};
+
+const uint16_t type_shift_instr_lookup[] = {
+    I_LSL, I_LSL, I_LSR, I_LSR, I_ASR, I_ASR, I_ROR, I_ROR, I_LSL, I_INVLD,
+    I_LSR, I_INVLD, I_ASR, I_INVLD, I_ROR, I_INVLD
+};
+
+const uint16_t type_brnchmisc_instr_lookup[] = {
+    I_MSR, I_BX, I_BXJ, I_BLX, I_INVLD, I_QSUB, I_INVLD, I_BKPT, I_SMLAW,
+    I_INVLD, I_SMULW, I_INVLD, I_SMLAW, I_INVLD, I_SMULW, I_INVLD
+};
+
+const uint16_t type_opless_instr_lookup[] = {
+    I_NOP, I_YIELD, I_WFE, I_WFI, I_SEV, I_INVLD, I_INVLD, I_INVLD
+};
+
+const uint16_t type_uncond2_instr_lookup[] = {
+    I_INVLD, I_CLREX, I_INVLD, I_INVLD, I_DSB, I_DMB, I_ISB, I_INVLD
+};
+
+const uint16_t type_mul_instr_lookup[] = {
+    I_MUL, I_MLA, I_UMAAL, I_MLS, I_UMULL, I_UMLAL, I_SMULL, I_SMLAL
+};
+
+const uint16_t type_stack0_instr_lookup[] = {
+    I_STR, I_LDR, I_STRT, I_LDRT, I_STRB, I_LDRB, I_STRBT, I_LDRBT, I_STR,
+    I_LDR, I_STRT, I_LDRT, I_STRB, I_LDRB, I_STRBT, I_LDRBT, I_STR, I_LDR,
+    I_STR, I_LDR, I_STRB, I_LDRB, I_STRB, I_LDRB, I_STR, I_LDR, I_STR, I_LDR,
+    I_STRB, I_LDRB, I_STRB, I_LDRB
+};
+
+const uint16_t type_stack1_instr_lookup[] = {
+    I_INVLD, I_INVLD, I_STRHT, I_LDRHT, I_INVLD, I_LDRSBT, I_INVLD, I_LDRSHT
+};
+
+const uint16_t type_stack2_instr_lookup[] = {
+    I_INVLD, I_INVLD, I_STRH, I_LDRH, I_LDRD, I_LDRSB, I_STRD, I_LDRSH
+};
+
+const uint16_t type_bits_instr_lookup[] = {
+    I_INVLD, I_SBFX, I_BFI, I_UBFX
+};
+
+const uint16_t type_pas_instr_lookup[] = {
+    I_INVLD, I_INVLD, I_INVLD, I_INVLD, I_INVLD, I_INVLD, I_INVLD, I_INVLD,
+    I_SADD16, I_SASX, I_SSAX, I_SSUB16, I_SADD8, I_INVLD, I_INVLD, I_SSUB8,
+    I_QADD16, I_QASX, I_QSAX, I_QSUB16, I_QADD8, I_INVLD, I_INVLD, I_QSUB8,
+    I_SHADD16, I_SHASX, I_SHSAX, I_SHSUB16, I_SHADD8, I_INVLD, I_INVLD,
+    I_SHSUB8, I_INVLD, I_INVLD, I_INVLD, I_INVLD, I_INVLD, I_INVLD, I_INVLD,
+    I_INVLD, I_UADD16, I_UASX, I_USAX, I_USUB16, I_UADD8, I_INVLD, I_INVLD,
+    I_USUB8, I_UQADD16, I_UQASX, I_UQSAX, I_UQSUB16, I_UQADD8, I_INVLD,
+    I_INVLD, I_UQSUB8, I_UHADD16, I_UHASX, I_UHSAX, I_UHSUB16, I_UHADD8,
+    I_INVLD, I_INVLD, I_UHSUB8
+};
+
+const uint16_t type_sat_instr_lookup[] = {
+    I_QADD, I_QSUB, I_QDADD, I_QDSUB
+};
+
+const uint16_t type_sync_instr_lookup[] = {
+    I_SWP, I_INVLD, I_INVLD, I_INVLD, I_SWPB, I_INVLD, I_INVLD, I_INVLD,
+    I_STREX, I_LDREX, I_STREXD, I_LDREXD, I_STREXB, I_LDREXB, I_STREXH,
+    I_LDREXH
+};
+
+const uint16_t type_pusr_instr_lookup[] = {
+    I_SXTAB16, I_SXTB16, I_INVLD, I_INVLD, I_SXTAB, I_SXTB, I_SXTAH, I_SXTH,
+    I_UXTAB16, I_UXTB16, I_INVLD, I_INVLD, I_UXTAB, I_UXTB, I_UXTAH, I_UXTH
+};
+
+const char *armv7_format_strings[479][3] = {
+    [I_ADC] = {"scdni", "scdnmS"},
+    [I_ADD] = {"scdni", "scdnmS"},
+    [I_ADR] = {"cdb"},
+    [I_AND] = {"scdni", "scdnmS"},
+    [I_ASR] = {"scdnm", "scdmS"},
+    [I_BFC] = {"cdLw"},
+    [I_BFI] = {"cdnLw"},
+    [I_BIC] = {"scdni", "scdnmS"},
+    [I_BKPT] = {"i"},
+    [I_BLX] = {"b", "cm"},
+    [I_BL] = {"cb"},
+    [I_BXJ] = {"cm"},
+    [I_BX] = {"cm"},
+    [I_B] = {"cb"},
+    [I_CDP2] = {"cCpINJ<opc2>"},
+    [I_CDP] = {"cCpINJ<opc2>"},
+    [I_CLREX] = {""},
+    [I_CLZ] = {"cdm"},
+    [I_CMN] = {"cni", "cnmS"},
+    [I_CMP] = {"cni", "cnmS"},
+    [I_DBG] = {"co"},
+    [I_DMB] = {"o"},
+    [I_DSB] = {"o"},
+    [I_EOR] = {"scdni", "scdnmS"},
+    [I_ISB] = {"o"},
+    [I_LDC2] = {"{L}cCIB#+/-<imm>"},
+    [I_LDC] = {"{L}cCIB#+/-<imm>"},
+    [I_LDMDA] = {"cn!r"},
+    [I_LDMDB] = {"cn!r"},
+    [I_LDMIB] = {"cn!r"},
+    [I_LDM] = {"cn!r"},
+    [I_LDRBT] = {"ctBOS"},
+    [I_LDRB] = {"ctBOS"},
+    [I_LDRD] = {"ct2BO"},
+    [I_LDREXB] = {"ctB"},
+    [I_LDREXD] = {"ct2B"},
+    [I_LDREXH] = {"ctB"},
+    [I_LDREX] = {"ctB"},
+    [I_LDRHT] = {"ctBO"},
+    [I_LDRH] = {"ctBO"},
+    [I_LDRSBT] = {"ctBO"},
+    [I_LDRSB] = {"ctBO"},
+    [I_LDRSHT] = {"ctBO"},
+    [I_LDRSH] = {"ctBO"},
+    [I_LDRT] = {"ctBOS"},
+    [I_LDR] = {"ctBOS"},
+    [I_LSL] = {"scdnm", "scdmS"},
+    [I_LSR] = {"scdnm", "scdmS"},
+    [I_MCR2] = {"cCptNJP"},
+    [I_MCRR2] = {"cCpt2J"},
+    [I_MCRR] = {"cCpt2J"},
+    [I_MCR] = {"cCptNJP"},
+    [I_MLA] = {"scdnma"},
+    [I_MLS] = {"cdnma"},
+    [I_MOVT] = {"cdi"},
+    [I_MOVW] = {"cdi"},
+    [I_MOV] = {"scdi", "scdm"},
+    [I_MRC2] = {"cCptNJP"},
+    [I_MRC] = {"cCptNJP"},
+    [I_MRRC2] = {"cC<opc>t2J"},
+    [I_MRRC] = {"cC<opc>t2J"},
+    [I_MRS] = {"cd<spec_reg>"},
+    [I_MSR] = {"c<spec_reg>i", "c<spec_reg>n"},
+    [I_MUL] = {"scdnm"},
+    [I_MVN] = {"scdi", "scdmS"},
+    [I_NOP] = {"c"},
+    [I_ORR] = {"scdni", "scdnmS"},
+    [I_PKH] = {"TcdnmS"},
+    [I_PLD] = {"cM"},
+    [I_PLI] = {"M"},
+    [I_POP] = {"cr"},
+    [I_PUSH] = {"cr"},
+    [I_QADD16] = {"cdnm"},
+    [I_QADD8] = {"cdnm"},
+    [I_QADD] = {"cdmn"},
+    [I_QASX] = {"cdnm"},
+    [I_QDADD] = {"cdmn"},
+    [I_QDSUB] = {"cdmn"},
+    [I_QSAX] = {"cdnm"},
+    [I_QSUB16] = {"cdnm"},
+    [I_QSUB8] = {"cdnm"},
+    [I_QSUB] = {"cdmn"},
+    [I_RBIT] = {"cdm"},
+    [I_REV16] = {"cdm"},
+    [I_REVSH] = {"cdm"},
+    [I_REV] = {"cdm"},
+    [I_ROR] = {"scdnm", "scdmS"},
+    [I_RRX] = {"scdm"},
+    [I_RSB] = {"scdni", "scdnmS"},
+    [I_RSC] = {"scdni", "scdnmS"},
+    [I_SADD16] = {"cdnm"},
+    [I_SADD8] = {"cdnm"},
+    [I_SASX] = {"cdnm"},
+    [I_SBC] = {"scdni", "scdnmS"},
+    [I_SBFX] = {"cdnLw"},
+    [I_SEL] = {"cdnm"},
+    [I_SETEND] = {"e"},
+    [I_SEV] = {"c"},
+    [I_SHADD16] = {"cdnm"},
+    [I_SHADD8] = {"cdnm"},
+    [I_SHASX] = {"cdnm"},
+    [I_SHSAX] = {"cdnm"},
+    [I_SHSUB16] = {"cdnm"},
+    [I_SHSUB8] = {"cdnm"},
+    [I_SMC] = {"ci"},
+    [I_SMLAD] = {"xcdnma"},
+    [I_SMLALD] = {"xclhnm"},
+    [I_SMLAL] = {"Xclhnm", "sclhnm"},
+    [I_SMLAW] = {"<y>cdnma"},
+    [I_SMLA] = {"Xcdnma"},
+    [I_SMLSD] = {"xcdnma"},
+    [I_SMLSLD] = {"xclhnm"},
+    [I_SMMLA] = {"Rcdnma"},
+    [I_SMMLS] = {"Rcdnma"},
+    [I_SMMUL] = {"Rcdnm"},
+    [I_SMUAD] = {"xcdnm"},
+    [I_SMULL] = {"sclhnm"},
+    [I_SMULW] = {"<y>cdnm"},
+    [I_SMUL] = {"Xcdnm"},
+    [I_SMUSD] = {"xcdnm"},
+    [I_SSAT16] = {"cd#<imm>n"},
+    [I_SSAT] = {"cd#<imm>nS"},
+    [I_SSAX] = {"cdnm"},
+    [I_SSUB16] = {"cdnm"},
+    [I_SSUB8] = {"cdnm"},
+    [I_STC2] = {"{L}cCIB#+/-<imm>"},
+    [I_STC] = {"{L}cCIB#+/-<imm>"},
+    [I_STMDA] = {"cn!r"},
+    [I_STMDB] = {"cn!r"},
+    [I_STMIB] = {"cn!r"},
+    [I_STM] = {"cn!r"},
+    [I_STRBT] = {"ctBOS"},
+    [I_STRB] = {"ctBOS"},
+    [I_STRD] = {"ct2BO"},
+    [I_STREXB] = {"cdtB"},
+    [I_STREXD] = {"cdt2B"},
+    [I_STREXH] = {"cdtB"},
+    [I_STREX] = {"cdtB"},
+    [I_STRHT] = {"ctBO"},
+    [I_STRH] = {"ctBO"},
+    [I_STRT] = {"ctBOS"},
+    [I_STR] = {"ctBOS"},
+    [I_SUB] = {"scdni", "scdnmS"},
+    [I_SVC] = {"ci"},
+    [I_SWPB] = {"ct2B"},
+    [I_SWP] = {"ct2B"},
+    [I_SXTAB16] = {"cdnmA"},
+    [I_SXTAB] = {"cdnmA"},
+    [I_SXTAH] = {"cdnmA"},
+    [I_SXTB16] = {"cdmA"},
+    [I_SXTB] = {"cdmA"},
+    [I_SXTH] = {"cdmA"},
+    [I_TEQ] = {"cni", "cnmS"},
+    [I_TST] = {"cni", "cnmS"},
+    [I_UADD16] = {"cdnm"},
+    [I_UADD8] = {"cdnm"},
+    [I_UASX] = {"cdnm"},
+    [I_UBFX] = {"cdnLw"},
+    [I_UDF] = {"ci"},
+    [I_UHADD16] = {"cdnm"},
+    [I_UHADD8] = {"cdnm"},
+    [I_UHASX] = {"cdnm"},
+    [I_UHSAX] = {"cdnm"},
+    [I_UHSUB16] = {"cdnm"},
+    [I_UHSUB8] = {"cdnm"},
+    [I_UMAAL] = {"clhnm"},
+    [I_UMLAL] = {"sclhnm"},
+    [I_UMULL] = {"sclhnm"},
+    [I_UQADD16] = {"cdnm"},
+    [I_UQADD8] = {"cdnm"},
+    [I_UQASX] = {"cdnm"},
+    [I_UQSAX] = {"cdnm"},
+    [I_UQSUB16] = {"cdnm"},
+    [I_UQSUB8] = {"cdnm"},
+    [I_USAD8] = {"cdnm"},
+    [I_USADA8] = {"cdnma"},
+    [I_USAT16] = {"cdin"},
+    [I_USAT] = {"cdinS"},
+    [I_USAX] = {"cdnm"},
+    [I_USUB16] = {"cdnm"},
+    [I_USUB8] = {"cdnm"},
+    [I_UXTAB16] = {"cdnmA"},
+    [I_UXTAB] = {"cdnmA"},
+    [I_UXTAH] = {"cdnmA"},
+    [I_UXTB16] = {"cdmA"},
+    [I_UXTB] = {"cdmA"},
+    [I_UXTH] = {"cdmA"},
+    [I_WFE] = {"c"},
+    [I_WFI] = {"c"},
+    [I_YIELD] = {"c"},
+};
+
+// ---- thumb-tbl.c ----
+#include <stdio.h>
+#include <stdint.h>
+// ---- thumb-tbl.h ----
+#ifndef __THUMB_TBL__
+#define __THUMB_TBL__
+#include <stdint.h>
+extern const darm_lut_t thumb_instr_lut[256];
+extern const uint16_t type_gpi_instr_lookup[16];
+extern const uint16_t type_hints_instr_lookup[8];
+extern const uint16_t type_extend_instr_lookup[4];
+extern const uint16_t type_rev_instr_lookup[4];
+#endif
+const darm_lut_t thumb_instr_lut[] = {
+    DARM_LUT(I_LSL, T_THUMB_SHIFT_IMM), DARM_LUT(I_LSL, T_THUMB_SHIFT_IMM),
+    DARM_LUT(I_LSL, T_THUMB_SHIFT_IMM), DARM_LUT(I_LSL, T_THUMB_SHIFT_IMM),
+    DARM_LUT(I_LSL, T_THUMB_SHIFT_IMM), DARM_LUT(I_LSL, T_THUMB_SHIFT_IMM),
+    DARM_LUT(I_LSL, T_THUMB_SHIFT_IMM), DARM_LUT(I_LSL, T_THUMB_SHIFT_IMM),
+    DARM_LUT(I_LSR, T_THUMB_SHIFT_IMM), DARM_LUT(I_LSR, T_THUMB_SHIFT_IMM),
+    DARM_LUT(I_LSR, T_THUMB_SHIFT_IMM), DARM_LUT(I_LSR, T_THUMB_SHIFT_IMM),
+    DARM_LUT(I_LSR, T_THUMB_SHIFT_IMM), DARM_LUT(I_LSR, T_THUMB_SHIFT_IMM),
+    DARM_LUT(I_LSR, T_THUMB_SHIFT_IMM), DARM_LUT(I_LSR, T_THUMB_SHIFT_IMM),
+    DARM_LUT(I_ASR, T_THUMB_SHIFT_IMM), DARM_LUT(I_ASR, T_THUMB_SHIFT_IMM),
+    DARM_LUT(I_ASR, T_THUMB_SHIFT_IMM), DARM_LUT(I_ASR, T_THUMB_SHIFT_IMM),
+    DARM_LUT(I_ASR, T_THUMB_SHIFT_IMM), DARM_LUT(I_ASR, T_THUMB_SHIFT_IMM),
+    DARM_LUT(I_ASR, T_THUMB_SHIFT_IMM), DARM_LUT(I_ASR, T_THUMB_SHIFT_IMM),
+    DARM_LUT(I_ADD, T_THUMB_3REG), DARM_LUT(I_ADD, T_THUMB_3REG),
+    DARM_LUT(I_SUB, T_THUMB_3REG), DARM_LUT(I_SUB, T_THUMB_3REG),
+    DARM_LUT(I_ADD, T_THUMB_2REG_IMM), DARM_LUT(I_ADD, T_THUMB_2REG_IMM),
+    DARM_LUT(I_SUB, T_THUMB_2REG_IMM), DARM_LUT(I_SUB, T_THUMB_2REG_IMM),
+    DARM_LUT(I_MOV, T_THUMB_HAS_IMM8), DARM_LUT(I_MOV, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_MOV, T_THUMB_HAS_IMM8), DARM_LUT(I_MOV, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_MOV, T_THUMB_HAS_IMM8), DARM_LUT(I_MOV, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_MOV, T_THUMB_HAS_IMM8), DARM_LUT(I_MOV, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_CMP, T_THUMB_HAS_IMM8), DARM_LUT(I_CMP, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_CMP, T_THUMB_HAS_IMM8), DARM_LUT(I_CMP, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_CMP, T_THUMB_HAS_IMM8), DARM_LUT(I_CMP, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_CMP, T_THUMB_HAS_IMM8), DARM_LUT(I_CMP, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_ADD, T_THUMB_HAS_IMM8), DARM_LUT(I_ADD, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_ADD, T_THUMB_HAS_IMM8), DARM_LUT(I_ADD, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_ADD, T_THUMB_HAS_IMM8), DARM_LUT(I_ADD, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_ADD, T_THUMB_HAS_IMM8), DARM_LUT(I_ADD, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_SUB, T_THUMB_HAS_IMM8), DARM_LUT(I_SUB, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_SUB, T_THUMB_HAS_IMM8), DARM_LUT(I_SUB, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_SUB, T_THUMB_HAS_IMM8), DARM_LUT(I_SUB, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_SUB, T_THUMB_HAS_IMM8), DARM_LUT(I_SUB, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_LSR, T_THUMB_GPI), DARM_LUT(I_SBC, T_THUMB_GPI),
+    DARM_LUT(I_TST, T_THUMB_GPI), DARM_LUT(I_ORR, T_THUMB_GPI),
+    DARM_LUT(I_ADD, T_THUMB_MOD_SP_REG), DARM_LUT(I_CMP, T_THUMB_CMP),
+    DARM_LUT(I_MOV, T_THUMB_MOV4), DARM_LUT(I_BX, T_THUMB_BRANCH_REG),
+    DARM_LUT(I_LDR, T_THUMB_LDR_PC), DARM_LUT(I_LDR, T_THUMB_LDR_PC),
+    DARM_LUT(I_LDR, T_THUMB_LDR_PC), DARM_LUT(I_LDR, T_THUMB_LDR_PC),
+    DARM_LUT(I_LDR, T_THUMB_LDR_PC), DARM_LUT(I_LDR, T_THUMB_LDR_PC),
+    DARM_LUT(I_LDR, T_THUMB_LDR_PC), DARM_LUT(I_LDR, T_THUMB_LDR_PC),
+    DARM_LUT(I_STR, T_THUMB_RW_MEMO), DARM_LUT(I_STR, T_THUMB_RW_MEMO),
+    DARM_LUT(I_STRH, T_THUMB_RW_MEMO), DARM_LUT(I_STRH, T_THUMB_RW_MEMO),
+    DARM_LUT(I_STRB, T_THUMB_RW_MEMO), DARM_LUT(I_STRB, T_THUMB_RW_MEMO),
+    DARM_LUT(I_LDRSB, T_THUMB_RW_MEMO), DARM_LUT(I_LDRSB, T_THUMB_RW_MEMO),
+    DARM_LUT(I_LDR, T_THUMB_RW_MEMO), DARM_LUT(I_LDR, T_THUMB_RW_MEMO),
+    DARM_LUT(I_LDRH, T_THUMB_RW_MEMO), DARM_LUT(I_LDRH, T_THUMB_RW_MEMO),
+    DARM_LUT(I_LDRB, T_THUMB_RW_MEMO), DARM_LUT(I_LDRB, T_THUMB_RW_MEMO),
+    DARM_LUT(I_LDRSH, T_THUMB_RW_MEMO), DARM_LUT(I_LDRSH, T_THUMB_RW_MEMO),
+    DARM_LUT(I_STR, T_THUMB_RW_MEMI), DARM_LUT(I_STR, T_THUMB_RW_MEMI),
+    DARM_LUT(I_STR, T_THUMB_RW_MEMI), DARM_LUT(I_STR, T_THUMB_RW_MEMI),
+    DARM_LUT(I_STR, T_THUMB_RW_MEMI), DARM_LUT(I_STR, T_THUMB_RW_MEMI),
+    DARM_LUT(I_STR, T_THUMB_RW_MEMI), DARM_LUT(I_STR, T_THUMB_RW_MEMI),
+    DARM_LUT(I_LDR, T_THUMB_RW_MEMI), DARM_LUT(I_LDR, T_THUMB_RW_MEMI),
+    DARM_LUT(I_LDR, T_THUMB_RW_MEMI), DARM_LUT(I_LDR, T_THUMB_RW_MEMI),
+    DARM_LUT(I_LDR, T_THUMB_RW_MEMI), DARM_LUT(I_LDR, T_THUMB_RW_MEMI),
+    DARM_LUT(I_LDR, T_THUMB_RW_MEMI), DARM_LUT(I_LDR, T_THUMB_RW_MEMI),
+    DARM_LUT(I_STRB, T_THUMB_RW_MEMI), DARM_LUT(I_STRB, T_THUMB_RW_MEMI),
+    DARM_LUT(I_STRB, T_THUMB_RW_MEMI), DARM_LUT(I_STRB, T_THUMB_RW_MEMI),
+    DARM_LUT(I_STRB, T_THUMB_RW_MEMI), DARM_LUT(I_STRB, T_THUMB_RW_MEMI),
+    DARM_LUT(I_STRB, T_THUMB_RW_MEMI), DARM_LUT(I_STRB, T_THUMB_RW_MEMI),
+    DARM_LUT(I_LDRB, T_THUMB_RW_MEMI), DARM_LUT(I_LDRB, T_THUMB_RW_MEMI),
+    DARM_LUT(I_LDRB, T_THUMB_RW_MEMI), DARM_LUT(I_LDRB, T_THUMB_RW_MEMI),
+    DARM_LUT(I_LDRB, T_THUMB_RW_MEMI), DARM_LUT(I_LDRB, T_THUMB_RW_MEMI),
+    DARM_LUT(I_LDRB, T_THUMB_RW_MEMI), DARM_LUT(I_LDRB, T_THUMB_RW_MEMI),
+    DARM_LUT(I_STRH, T_THUMB_RW_MEMI), DARM_LUT(I_STRH, T_THUMB_RW_MEMI),
+    DARM_LUT(I_STRH, T_THUMB_RW_MEMI), DARM_LUT(I_STRH, T_THUMB_RW_MEMI),
+    DARM_LUT(I_STRH, T_THUMB_RW_MEMI), DARM_LUT(I_STRH, T_THUMB_RW_MEMI),
+    DARM_LUT(I_STRH, T_THUMB_RW_MEMI), DARM_LUT(I_STRH, T_THUMB_RW_MEMI),
+    DARM_LUT(I_LDRH, T_THUMB_RW_MEMI), DARM_LUT(I_LDRH, T_THUMB_RW_MEMI),
+    DARM_LUT(I_LDRH, T_THUMB_RW_MEMI), DARM_LUT(I_LDRH, T_THUMB_RW_MEMI),
+    DARM_LUT(I_LDRH, T_THUMB_RW_MEMI), DARM_LUT(I_LDRH, T_THUMB_RW_MEMI),
+    DARM_LUT(I_LDRH, T_THUMB_RW_MEMI), DARM_LUT(I_LDRH, T_THUMB_RW_MEMI),
+    DARM_LUT(I_STR, T_THUMB_STACK), DARM_LUT(I_STR, T_THUMB_STACK),
+    DARM_LUT(I_STR, T_THUMB_STACK), DARM_LUT(I_STR, T_THUMB_STACK),
+    DARM_LUT(I_STR, T_THUMB_STACK), DARM_LUT(I_STR, T_THUMB_STACK),
+    DARM_LUT(I_STR, T_THUMB_STACK), DARM_LUT(I_STR, T_THUMB_STACK),
+    DARM_LUT(I_LDR, T_THUMB_STACK), DARM_LUT(I_LDR, T_THUMB_STACK),
+    DARM_LUT(I_LDR, T_THUMB_STACK), DARM_LUT(I_LDR, T_THUMB_STACK),
+    DARM_LUT(I_LDR, T_THUMB_STACK), DARM_LUT(I_LDR, T_THUMB_STACK),
+    DARM_LUT(I_LDR, T_THUMB_STACK), DARM_LUT(I_LDR, T_THUMB_STACK),
+    DARM_LUT(I_ADR, T_THUMB_HAS_IMM8), DARM_LUT(I_ADR, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_ADR, T_THUMB_HAS_IMM8), DARM_LUT(I_ADR, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_ADR, T_THUMB_HAS_IMM8), DARM_LUT(I_ADR, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_ADR, T_THUMB_HAS_IMM8), DARM_LUT(I_ADR, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_ADD, T_THUMB_ADD_SP_IMM), DARM_LUT(I_ADD, T_THUMB_ADD_SP_IMM),
+    DARM_LUT(I_ADD, T_THUMB_ADD_SP_IMM), DARM_LUT(I_ADD, T_THUMB_ADD_SP_IMM),
+    DARM_LUT(I_ADD, T_THUMB_ADD_SP_IMM), DARM_LUT(I_ADD, T_THUMB_ADD_SP_IMM),
+    DARM_LUT(I_ADD, T_THUMB_ADD_SP_IMM), DARM_LUT(I_ADD, T_THUMB_ADD_SP_IMM),
+    DARM_LUT(I_SUB, T_THUMB_MOD_SP_IMM), DARM_LUT(I_CBZ, T_THUMB_CBZ),
+    DARM_LUT(I_UXTH, T_THUMB_EXTEND), DARM_LUT(I_CBZ, T_THUMB_CBZ),
+    DARM_LUT(I_PUSH, T_THUMB_PUSHPOP), DARM_LUT(I_PUSH, T_THUMB_PUSHPOP),
+    DARM_LUT(I_SETEND, T_THUMB_SETEND), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_CBZ, T_THUMB_CBZ),
+    DARM_LUT(I_REVSH, T_THUMB_REV), DARM_LUT(I_CBZ, T_THUMB_CBZ),
+    DARM_LUT(I_POP, T_THUMB_PUSHPOP), DARM_LUT(I_POP, T_THUMB_PUSHPOP),
+    DARM_LUT(I_BKPT, T_THUMB_ONLY_IMM8), DARM_LUT(I_YIELD, T_THUMB_IT_HINTS),
+    DARM_LUT(I_STM, T_THUMB_RW_REG), DARM_LUT(I_STM, T_THUMB_RW_REG),
+    DARM_LUT(I_STM, T_THUMB_RW_REG), DARM_LUT(I_STM, T_THUMB_RW_REG),
+    DARM_LUT(I_STM, T_THUMB_RW_REG), DARM_LUT(I_STM, T_THUMB_RW_REG),
+    DARM_LUT(I_STM, T_THUMB_RW_REG), DARM_LUT(I_STM, T_THUMB_RW_REG),
+    DARM_LUT(I_LDM, T_THUMB_RW_REG), DARM_LUT(I_LDM, T_THUMB_RW_REG),
+    DARM_LUT(I_LDM, T_THUMB_RW_REG), DARM_LUT(I_LDM, T_THUMB_RW_REG),
+    DARM_LUT(I_LDM, T_THUMB_RW_REG), DARM_LUT(I_LDM, T_THUMB_RW_REG),
+    DARM_LUT(I_LDM, T_THUMB_RW_REG), DARM_LUT(I_LDM, T_THUMB_RW_REG),
+    DARM_LUT(I_B, T_THUMB_COND_BRANCH), DARM_LUT(I_B, T_THUMB_COND_BRANCH),
+    DARM_LUT(I_B, T_THUMB_COND_BRANCH), DARM_LUT(I_B, T_THUMB_COND_BRANCH),
+    DARM_LUT(I_B, T_THUMB_COND_BRANCH), DARM_LUT(I_B, T_THUMB_COND_BRANCH),
+    DARM_LUT(I_B, T_THUMB_COND_BRANCH), DARM_LUT(I_B, T_THUMB_COND_BRANCH),
+    DARM_LUT(I_B, T_THUMB_COND_BRANCH), DARM_LUT(I_B, T_THUMB_COND_BRANCH),
+    DARM_LUT(I_B, T_THUMB_COND_BRANCH), DARM_LUT(I_B, T_THUMB_COND_BRANCH),
+    DARM_LUT(I_B, T_THUMB_COND_BRANCH), DARM_LUT(I_B, T_THUMB_COND_BRANCH),
+    DARM_LUT(I_UDF, T_THUMB_ONLY_IMM8), DARM_LUT(I_SVC, T_THUMB_ONLY_IMM8),
+    DARM_LUT(I_B, T_THUMB_UNCOND_BRANCH), DARM_LUT(I_B,
+    T_THUMB_UNCOND_BRANCH), DARM_LUT(I_B, T_THUMB_UNCOND_BRANCH),
+    DARM_LUT(I_B, T_THUMB_UNCOND_BRANCH), DARM_LUT(I_B,
+    T_THUMB_UNCOND_BRANCH), DARM_LUT(I_B, T_THUMB_UNCOND_BRANCH),
+    DARM_LUT(I_B, T_THUMB_UNCOND_BRANCH), DARM_LUT(I_B,
+    T_THUMB_UNCOND_BRANCH), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD)
+};
+
+const uint16_t type_gpi_instr_lookup[] = {
+    I_AND, I_EOR, I_LSL, I_LSR, I_ASR, I_ADC, I_SBC, I_ROR, I_TST, I_RSB,
+    I_CMP, I_CMN, I_ORR, I_MUL, I_BIC, I_MVN
+};
+
+const uint16_t type_hints_instr_lookup[] = {
+    I_NOP, I_YIELD, I_WFE, I_WFI, I_SEV
+};
+
+const uint16_t type_extend_instr_lookup[] = {
+    I_SXTH, I_SXTB, I_UXTH, I_UXTB
+};
+
+const uint16_t type_rev_instr_lookup[] = {
+    I_REV, I_REV16, I_INVLD, I_REVSH
+};
+
+
+// ---- thumb2-tbl.c ----
+#include <stdio.h>
+#include <stdint.h>
+// ---- thumb2-tbl.h ----
+#ifndef __THUMB2_TBL__
+#define __THUMB2_TBL__
+#include <stdint.h>
+#define THUMB2_INSTRUCTION_COUNT 220
+extern const uint16_t thumb2_instr_labels[220];
+extern const char * thumb2_instruction_strings[256];
+extern const uint16_t type_immediate_instr_lookup[16];
+extern const uint16_t type_flags_instr_lookup[8];
+#define THUMB2_PEXT_IMM2_IMM3 0x000070c0
+#define THUMB2_PEXT_IMM1_IMM3_IMM8 0x040070ff
+#define THUMB2_PEXT_IMM6_IMM11 0x003f07ff
+#define THUMB2_PEXT_IMM10_IMM11 0x03ff07ff
+#define THUMB2_PEXT_IMM10H_IMM10L 0x03ff07fe
+#define THUMB2_REG_TYPES 16
+#define THUMB2_IMM_TYPES 6
+#define THUMB2_FLAG_TYPES 9
+#define THUMB2_EXTRACTORS(X) \
+    X(RN_RD_REG, IMM1_IMM3_IMM8, S_FLAG) \
+    X(RN_RD_RM_REG, IMM2_IMM3, S_TYPE_FLAG) \
+    X(RN_RD_REG, IMM1_IMM3_IMM8, NO_FLAG) \
+    X(RD_REG, IMM1_IMM3_IMM8, S_FLAG) \
+    X(RD_REG, IMM1_IMM3_IMM8, NO_FLAG) \
+    X(RD_RM_REG, IMM2_IMM3, S_TYPE_FLAG) \
+    X(RD_RM_REG, IMM2_IMM3, S_FLAG) \
+    X(RN_RD_RM_REG, NO_IMM, S_FLAG) \
+    X(RD_REG, IMM2_IMM3, NO_FLAG) \
+    X(RN_RD_REG, IMM2_IMM3, NO_FLAG) \
+    X(RM_REG, NO_IMM, NO_FLAG) \
+    X(NO_REG, NO_IMM, NO_FLAG) \
+    X(RD_RM_REG, NO_IMM, NO_FLAG) \
+    X(RN_REG, IMM1_IMM3_IMM8, NO_FLAG) \
+    X(RN_RM_REG, IMM2_IMM3, TYPE_FLAG) \
+    X(RN_REG, NO_IMM, WP_REGLIST_FLAG) \
+    X(RN_RT_REG, IMM12, NO_FLAG) \
+    X(RN_RT_REG, IMM8, WUP_FLAG) \
+    X(RT_REG, IMM12, U_FLAG) \
+    X(RN_RM_RT_REG, IMM2, NO_FLAG) \
+    X(RN_RT_REG, IMM8, NO_FLAG) \
+    X(RN_RT_RT2_REG, IMM8, WUP_FLAG) \
+    X(RT_RT2_REG, IMM8, WUP_FLAG) \
+    X(RN_RT_REG, NO_IMM, NO_FLAG) \
+    X(RN_RT_RT2_REG, NO_IMM, NO_FLAG) \
+    X(RN_RD_RM_RA_REG, NO_IMM, NO_FLAG) \
+    X(RD_RM_REG, NO_IMM, S_FLAG) \
+    X(RD_REG, NO_IMM, NO_FLAG) \
+    X(RN_RD_RM_REG, NO_IMM, NO_FLAG) \
+    X(NO_REG, IMM12, U_FLAG) \
+    X(RN_REG, IMM12, NO_FLAG) \
+    X(RN_REG, IMM8, NO_FLAG) \
+    X(RN_RM_REG, IMM2, NO_FLAG) \
+    X(NO_REG, NO_IMM, REGLIST_FLAG) \
+    X(RT_REG, NO_IMM, NO_FLAG) \
+    X(RN_RM_REG, NO_IMM, NO_FLAG) \
+    X(RN_RD_RT_REG, IMM8, NO_FLAG) \
+    X(RN_RD_RT_REG, NO_IMM, NO_FLAG) \
+    X(RN_RD_RT_RT2_REG, NO_IMM, NO_FLAG)
+extern const uint8_t thumb2_extractor_index[864];
+#endif
+const uint16_t thumb2_instr_labels[] = {
+    I_ADC, I_ADC, I_ADD, I_ADDW, I_ADD, I_ADD, I_ADDW, I_ADD, I_ADR, I_ADR,
+    I_AND, I_AND, I_ASR, I_ASR, I_B, I_B, I_BFC, I_BFI, I_BIC, I_BIC, I_BL,
+    I_BLX, I_BXJ, I_CLREX, I_CLZ, I_CMN, I_CMN, I_CMP, I_CMP, I_DBG, I_DMB,
+    I_DSB, I_EOR, I_EOR, I_ISB, I_LDM, I_LDMDB, I_LDR, I_LDR, I_LDR, I_LDR,
+    I_LDRB, I_LDRB, I_LDRB, I_LDRB, I_LDRBT, I_LDRD, I_LDRD, I_LDREX,
+    I_LDREXB, I_LDREXD, I_LDREXH, I_LDRH, I_LDRH, I_LDRH, I_LDRH, I_LDRHT,
+    I_LDRSB, I_LDRSB, I_LDRSB, I_LDRSB, I_LDRSBT, I_LDRSH, I_LDRSH, I_LDRSH,
+    I_LDRSH, I_LDRSHT, I_LDRT, I_MOV, I_LSL, I_LSR, I_LSR, I_MLA, I_MLS,
+    I_MOV, I_MOVW, I_MOVT, I_MRS, I_MUL, I_MVN, I_MVN, I_NOP, I_ORN, I_ORN,
+    I_ORR, I_ORR, I_PLD, I_PLD, I_PLD, I_PLD, I_PLI, I_PLI, I_PLI, I_PLI,
+    I_POP, I_POP, I_PUSH, I_PUSH, I_QADD, I_QADD16, I_QADD8, I_QASX, I_QDADD,
+    I_QDSUB, I_QSAX, I_QSUB, I_QSUB16, I_QSUB8, I_RBIT, I_REV, I_REV16,
+    I_REVSH, I_RRX, I_ROR, I_RSB, I_RSB, I_SADD16, I_SADD8, I_SASX, I_SBC,
+    I_SBC, I_SBFX, I_SDIV, I_SEL, I_SEV, I_SHADD16, I_SHADD8, I_SHASX,
+    I_SHSAX, I_SHSUB16, I_SHSUB8, I_SMLA, I_SMLAD, I_SMLAL, I_SMLAL, I_SMLALD,
+    I_SMLAW, I_SMLSD, I_SMLSLD, I_SMMLA, I_SMMLS, I_SMMUL, I_SMUAD, I_SMUL,
+    I_SMULL, I_SMULW, I_SMUSD, I_SSAX, I_SSUB16, I_SSUB8, I_STM, I_STMDB,
+    I_STR, I_STR, I_STR, I_STRB, I_STRB, I_STRB, I_STRBT, I_STREX, I_STREXB,
+    I_STREXD, I_STREXH, I_STRH, I_STRH, I_STRH, I_STRHT, I_STRT, I_SUB,
+    I_SUBW, I_SUB, I_SUB, I_SUBW, I_SUB, I_SXTAB, I_SXTAB16, I_SXTAH, I_SXTB,
+    I_SXTB16, I_SXTH, I_TBB, I_TEQ, I_TEQ, I_TST, I_TST, I_UADD16, I_UADD8,
+    I_UASX, I_UBFX, I_UDF, I_UDIV, I_UHADD16, I_UHADD8, I_UHASX, I_UHSAX,
+    I_UHSUB16, I_UHSUB8, I_UMAAL, I_UMLAL, I_UMULL, I_UQADD16, I_UQADD8,
+    I_UQASX, I_UQSAX, I_UQSUB16, I_UQSUB8, I_USAD8, I_USADA8, I_USAX,
+    I_USUB16, I_USUB8, I_UXTAB, I_UXTAB16, I_UXTAH, I_UXTB, I_UXTB16, I_UXTH,
+    I_WFE, I_WFI, I_YIELD
+};
+
+const char *thumb2_instruction_strings[] = {
+    "ADC", "ADC", "ADD", "ADDW", "ADD", "ADD", "ADDW", "ADD", "ADR", "ADR",
+    "AND", "AND", "ASR", "ASR", "B", "B", "BFC", "BFI", "BIC", "BIC", "BL",
+    "BLX", "BXJ", "CLREX", "CLZ", "CMN", "CMN", "CMP", "CMP", "DBG", "DMB",
+    "DSB", "EOR", "EOR", "ISB", "LDM", "LDMDB", "LDR", "LDR", "LDR", "LDR",
+    "LDRB", "LDRB", "LDRB", "LDRB", "LDRBT", "LDRD", "LDRD", "LDREX",
+    "LDREXB", "LDREXD", "LDREXH", "LDRH", "LDRH", "LDRH", "LDRH", "LDRHT",
+    "LDRSB", "LDRSB", "LDRSB", "LDRSB", "LDRSBT", "LDRSH", "LDRSH", "LDRSH",
+    "LDRSH", "LDRSHT", "LDRT", "MOV", "LSL", "LSR", "LSR", "MLA", "MLS",
+    "MOV", "MOVW", "MOVT", "MRS", "MUL", "MVN", "MVN", "NOP", "ORN", "ORN",
+    "ORR", "ORR", "PLD", "PLD", "PLD", "PLD", "PLI", "PLI", "PLI", "PLI",
+    "POP", "POP", "PUSH", "PUSH", "QADD", "QADD16", "QADD8", "QASX", "QDADD",
+    "QDSUB", "QSAX", "QSUB", "QSUB16", "QSUB8", "RBIT", "REV", "REV16",
+    "REVSH", "RRX", "ROR", "RSB", "RSB", "SADD16", "SADD8", "SASX", "SBC",
+    "SBC", "SBFX", "SDIV", "SEL", "SEV", "SHADD16", "SHADD8", "SHASX",
+    "SHSAX", "SHSUB16", "SHSUB8", "SMLA", "SMLAD", "SMLAL", "SMLAL", "SMLALD",
+    "SMLAW", "SMLSD", "SMLSLD", "SMMLA", "SMMLS", "SMMUL", "SMUAD", "SMUL",
+    "SMULL", "SMULW", "SMUSD", "SSAX", "SSUB16", "SSUB8", "STM", "STMDB",
+    "STR", "STR", "STR", "STRB", "STRB", "STRB", "STRBT", "STREX", "STREXB",
+    "STREXD", "STREXH", "STRH", "STRH", "STRH", "STRHT", "STRT", "SUB",
+    "SUBW", "SUB", "SUB", "SUBW", "SUB", "SXTAB", "SXTAB16", "SXTAH", "SXTB",
+    "SXTB16", "SXTH", "TBB", "TEQ", "TEQ", "TST", "TST", "UADD16", "UADD8",
+    "UASX", "UBFX", "UDF", "UDIV", "UHADD16", "UHADD8", "UHASX", "UHSAX",
+    "UHSUB16", "UHSUB8", "UMAAL", "UMLAL", "UMULL", "UQADD16", "UQADD8",
+    "UQASX", "UQSAX", "UQSUB16", "UQSUB8", "USAD8", "USADA8", "USAX",
+    "USUB16", "USUB8", "UXTAB", "UXTAB16", "UXTAH", "UXTB", "UXTB16", "UXTH",
+    "WFE", "WFI", "YIELD"
+};
+
+const uint8_t thumb2_extractor_index[] = {
+    12, 0, 0, 0, 0, 34, 0, 0, 0, 0, 0, 30, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 35, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 19, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 23, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 11, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 28, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 9, 0, 0, 0, 0, 0, 0, 0, 0, 5, 0, 0, 0, 0, 0, 0, 4, 0,
+    13, 0, 0, 0, 0, 0, 0, 27, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, 6, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16, 0, 0, 31, 0, 0, 0, 0, 0, 0, 0, 0, 32,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 14, 0, 0, 0, 0, 0, 0, 0, 0, 24, 0, 0, 0, 0, 0, 0, 0, 0, 17, 0, 0, 0, 0,
+    0, 0, 0, 0, 21, 0, 0, 18, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 25, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 22, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 36, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    33, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 15, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 20, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 10, 0, 0, 0, 0,
+    0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 1, 0, 38, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 37, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 39, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    29, 0, 0, 0, 0, 0, 0, 8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 26, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+
+// ---- armv7.c ----
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+// ---- darm-internal.h ----
+#define b0 0
+#define b1 1
+#define b10 2
+#define b11 3
+#define b100 4
+#define b101 5
+#define b110 6
+#define b111 7
+#define b1000 8
+#define b1001 9
+#define b1010 10
+#define b1011 11
+#define b1100 12
+#define b1101 13
+#define b1110 14
+#define b1111 15
+#define b10000 16
+#define b10001 17
+#define b10010 18
+#define b10011 19
+#define b10100 20
+#define b10101 21
+#define b10110 22
+#define b10111 23
+#define b11000 24
+#define b11001 25
+#define b11010 26
+#define b11011 27
+#define b11100 28
+#define b11101 29
+#define b11110 30
+#define b11111 31
+#define b100000 32
+#define b100001 33
+#define b100010 34
+#define b100011 35
+#define b100100 36
+#define b100101 37
+#define b100110 38
+#define b100111 39
+#define b101000 40
+#define b101001 41
+#define b101010 42
+#define b101011 43
+#define b101100 44
+#define b101101 45
+#define b101110 46
+#define b101111 47
+#define b110000 48
+#define b110001 49
+#define b110010 50
+#define b110011 51
+#define b110100 52
+#define b110101 53
+#define b110110 54
+#define b110111 55
+#define b111000 56
+#define b111001 57
+#define b111010 58
+#define b111011 59
+#define b111100 60
+#define b111101 61
+#define b111110 62
+#define b111111 63
+#define b1000000 64
+#define b1000001 65
+#define b1000010 66
+#define b1000011 67
+#define b1000100 68
+#define b1000101 69
+#define b1000110 70
+#define b1000111 71
+#define b1001000 72
+#define b1001001 73
+#define b1001010 74
+#define b1001011 75
+#define b1001100 76
+#define b1001101 77
+#define b1001110 78
+#define b1001111 79
+#define b1010000 80
+#define b1010001 81
+#define b1010010 82
+#define b1010011 83
+#define b1010100 84
+#define b1010101 85
+#define b1010110 86
+#define b1010111 87
+#define b1011000 88
+#define b1011001 89
+#define b1011010 90
+#define b1011011 91
+#define b1011100 92
+#define b1011101 93
+#define b1011110 94
+#define b1011111 95
+#define b1100000 96
+#define b1100001 97
+#define b1100010 98
+#define b1100011 99
+#define b1100100 100
+#define b1100101 101
+#define b1100110 102
+#define b1100111 103
+#define b1101000 104
+#define b1101001 105
+#define b1101010 106
+#define b1101011 107
+#define b1101100 108
+#define b1101101 109
+#define b1101110 110
+#define b1101111 111
+#define b1110000 112
+#define b1110001 113
+#define b1110010 114
+#define b1110011 115
+#define b1110100 116
+#define b1110101 117
+#define b1110110 118
+#define b1110111 119
+#define b1111000 120
+#define b1111001 121
+#define b1111010 122
+#define b1111011 123
+#define b1111100 124
+#define b1111101 125
+#define b1111110 126
+#define b1111111 127
+#define b10000000 128
+#define b10000001 129
+#define b10000010 130
+#define b10000011 131
+#define b10000100 132
+#define b10000101 133
+#define b10000110 134
+#define b10000111 135
+#define b10001000 136
+#define b10001001 137
+#define b10001010 138
+#define b10001011 139
+#define b10001100 140
+#define b10001101 141
+#define b10001110 142
+#define b10001111 143
+#define b10010000 144
+#define b10010001 145
+#define b10010010 146
+#define b10010011 147
+#define b10010100 148
+#define b10010101 149
+#define b10010110 150
+#define b10010111 151
+#define b10011000 152
+#define b10011001 153
+#define b10011010 154
+#define b10011011 155
+#define b10011100 156
+#define b10011101 157
+#define b10011110 158
+#define b10011111 159
+#define b10100000 160
+#define b10100001 161
+#define b10100010 162
+#define b10100011 163
+#define b10100100 164
+#define b10100101 165
+#define b10100110 166
+#define b10100111 167
+#define b10101000 168
+#define b10101001 169
+#define b10101010 170
+#define b10101011 171
+#define b10101100 172
+#define b10101101 173
+#define b10101110 174
+#define b10101111 175
+#define b10110000 176
+#define b10110001 177
+#define b10110010 178
+#define b10110011 179
+#define b10110100 180
+#define b10110101 181
+#define b10110110 182
+#define b10110111 183
+#define b10111000 184
+#define b10111001 185
+#define b10111010 186
+#define b10111011 187
+#define b10111100 188
+#define b10111101 189
+#define b10111110 190
+#define b10111111 191
+#define b11000000 192
+#define b11000001 193
+#define b11000010 194
+#define b11000011 195
+#define b11000100 196
+#define b11000101 197
+#define b11000110 198
+#define b11000111 199
+#define b11001000 200
+#define b11001001 201
+#define b11001010 202
+#define b11001011 203
+#define b11001100 204
+#define b11001101 205
+#define b11001110 206
+#define b11001111 207
+#define b11010000 208
+#define b11010001 209
+#define b11010010 210
+#define b11010011 211
+#define b11010100 212
+#define b11010101 213
+#define b11010110 214
+#define b11010111 215
+#define b11011000 216
+#define b11011001 217
+#define b11011010 218
+#define b11011011 219
+#define b11011100 220
+#define b11011101 221
+#define b11011110 222
+#define b11011111 223
+#define b11100000 224
+#define b11100001 225
+#define b11100010 226
+#define b11100011 227
+#define b11100100 228
+#define b11100101 229
+#define b11100110 230
+#define b11100111 231
+#define b11101000 232
+#define b11101001 233
+#define b11101010 234
+#define b11101011 235
+#define b11101100 236
+#define b11101101 237
+#define b11101110 238
+#define b11101111 239
+#define b11110000 240
+#define b11110001 241
+#define b11110010 242
+#define b11110011 243
+#define b11110100 244
+#define b11110101 245
+#define b11110110 246
+#define b11110111 247
+#define b11111000 248
+#define b11111001 249
+#define b11111010 250
+#define b11111011 251
+#define b11111100 252
+#define b11111101 253
+#define b11111110 254
+#define b11111111 255
+#define b00 0
+#define b01 1
+#define b10 2
+#define b11 3
+#define b000 0
+#define b001 1
+#define b010 2
+#define b011 3
+#define b100 4
+#define b101 5
+#define b110 6
+#define b111 7
+#define b0000 0
+#define b0001 1
+#define b0010 2
+#define b0011 3
+#define b0100 4
+#define b0101 5
+#define b0110 6
+#define b0111 7
+#define b1000 8
+#define b1001 9
+#define b1010 10
+#define b1011 11
+#define b1100 12
+#define b1101 13
+#define b1110 14
+#define b1111 15
+#define b00000 0
+#define b00001 1
+#define b00010 2
+#define b00011 3
+#define b00100 4
+#define b00101 5
+#define b00110 6
+#define b00111 7
+#define b01000 8
+#define b01001 9
+#define b01010 10
+#define b01011 11
+#define b01100 12
+#define b01101 13
+#define b01110 14
+#define b01111 15
+#define b10000 16
+#define b10001 17
+#define b10010 18
+#define b10011 19
+#define b10100 20
+#define b10101 21
+#define b10110 22
+#define b10111 23
+#define b11000 24
+#define b11001 25
+#define b11010 26
+#define b11011 27
+#define b11100 28
+#define b11101 29
+#define b11110 30
+#define b11111 31
+#define b000000 0
+#define b000001 1
+#define b000010 2
+#define b000011 3
+#define b000100 4
+#define b000101 5
+#define b000110 6
+#define b000111 7
+#define b001000 8
+#define b001001 9
+#define b001010 10
+#define b001011 11
+#define b001100 12
+#define b001101 13
+#define b001110 14
+#define b001111 15
+#define b010000 16
+#define b010001 17
+#define b010010 18
+#define b010011 19
+#define b010100 20
+#define b010101 21
+#define b010110 22
+#define b010111 23
+#define b011000 24
+#define b011001 25
+#define b011010 26
+#define b011011 27
+#define b011100 28
+#define b011101 29
+#define b011110 30
+#define b011111 31
+#define b100000 32
+#define b100001 33
+#define b100010 34
+#define b100011 35
+#define b100100 36
+#define b100101 37
+#define b100110 38
+#define b100111 39
+#define b101000 40
+#define b101001 41
+#define b101010 42
+#define b101011 43
+#define b101100 44
+#define b101101 45
+#define b101110 46
+#define b101111 47
+#define b110000 48
+#define b110001 49
+#define b110010 50
+#define b110011 51
+#define b110100 52
+#define b110101 53
+#define b110110 54
+#define b110111 55
+#define b111000 56
+#define b111001 57
+#define b111010 58
+#define b111011 59
+#define b111100 60
+#define b111101 61
+#define b111110 62
+#define b111111 63
+#define BITMAP_WORDS(count) (((count) + 63) / 64)
+#define BITMAP_GET(bm, idx) (((bm)[(idx) / 64] >> ((idx) % 64)) & 1)
+#define BITMAP_SET(bm, idx) ((bm)[(idx) / 64] |= 1ULL << ((idx) % 64))
+// ---- dispatch.h ----
+
+#ifndef __DISPATCH_H__
+#define __DISPATCH_H__
+
+//
+// Optional computed-goto dispatch for the switch statements of the decoders.
+// When built with -DDARM_THREADED_DISPATCH (which requires the labels-as-
+// values extension of GCC and clang) each decoder jumps through its own
+// table of label addresses, covering every value of the enumeration, rather
+// than through the range check and jump table of the switch statement. The
+// switch statement remains in place, so that both builds share one body:
+//
+//     #ifdef DARM_THREADED_DISPATCH
+//     DISPATCH_TABLE(targets, I_INSTRCNT, other)
+//         [I_B] = &&b,
+//     DISPATCH_END()
+//     DISPATCH(targets, d->instr);
+//     #endif
+//
+//     switch (d->instr) {
+//     case I_B: DISPATCH_TARGET(b)
+//         ...
+//     default: DISPATCH_TARGET(other)
+//         ...
+//     }
+//
+
+#ifdef DARM_THREADED_DISPATCH
+
+#ifdef __clang__
+#define DISPATCH_IGNORE_OVERRIDE \
+    _Pragma("clang diagnostic ignored \"-Winitializer-overrides\"")
+#else
+#define DISPATCH_IGNORE_OVERRIDE \
+    _Pragma("GCC diagnostic ignored \"-Woverride-init\"")
+#endif
+
+// every entry defaults to the fallback label, the explicit entries override
+// it, which is intended
+#define DISPATCH_TABLE(name, count, fallback) \
+    _Pragma("GCC diagnostic push") \
+    DISPATCH_IGNORE_OVERRIDE \
+    static const void *const name[count] = { \
+        [0 ... (count) - 1] = &&fallback,
+
+#define DISPATCH_END() \
+    }; \
+    _Pragma("GCC diagnostic pop")
+
+#define DISPATCH(name, value) goto *name[(uint32_t)(value)]
+#define DISPATCH_TARGET(label) label:
+
+#else
+
+#define DISPATCH_TARGET(label)
+
+#endif
+
+#endif
+
+#define BITMSK_12 ((1 << 12) - 1)
+#define BITMSK_16 ((1 << 16) - 1)
+#define BITMSK_24 ((1 << 24) - 1)
+
+#define ROR(val, rotate) (((val) >> (rotate)) | ((val) << (32 - (rotate))))
+
+// the upper four bits define the rotation value, but we have to multiply the
+// rotation value by two, so instead of right shifting by eight, we do a
+// right shift of seven, effectively avoiding the left shift of one
+#define ARMExpandImm(imm12) ROR((imm12) & 0xff, ((imm12) >> 7) & b11110)
+
+static struct {
+    const char *mnemonic_extension;
+    const char *meaning_integer;
+    const char *meaning_fp;
+} g_condition_codes[] = {
+    {"EQ", "Equal", "Equal"},
+    {"NE", "Not equal", "Not equal, or unordered"},
+    {"CS", "Carry Set", "Greater than, equal, or unordered"},
+    {"CC", "Carry Clear", "Less than"},
+    {"MI", "Minus, negative", "Less than"},
+    {"PL", "Plus, positive or zero", "Greater than, equal, or unordered"},
+    {"VS", "Overflow", "Unordered"},
+    {"VC", "No overflow", "Not unordered"},
+    {"HI", "Unsigned higher", "Greater than, unordered"},
+    {"LS", "Unsigned lower or same", "Greater than, or unordered"},
+    {"GE", "Signed greater than or equal", "Greater than, or unordered"},
+    {"LT", "Signed less than", "Less than, or unordered"},
+    {"GT", "Signed greater than", "Greater than"},
+    {"LE", "Signed less than or equal", "Less than, equal, or unordered"},
+    {"AL", "Always (unconditional)", "Always (unconditional)"},
+    {"",   "Unconditional", "Unconditional Instruction"},
+
+    // alias for CS
+    {"HS", "Carry Set", "Greater than, equal, or unordered"},
+    // alias for CC
+    {"LO", "Carry Clear", "Less than"},
+};
+
+static const char *shift_types[] = {
+    "LSL", "LSR", "ASR", "ROR",
+};
+
+int darm_immshift_decode(const darm_t *d, const char **type,
+    uint32_t *immediate)
+{
+    if(d->shift_type == S_INVLD) {
+        *type = NULL, *immediate = 0;
+        return -1;
+    }
+    else if(d->shift_type == S_ROR && d->Rs == R_INVLD && d->shift == 0) {
+        *type = "RRX", *immediate = 0;
+    }
+    else {
+        *type = darm_shift_type_name(d->shift_type);
+        *immediate = d->shift;
+
+        // 32 is encoded as 0 for immediate shifts
+        if((d->shift_type == S_LSR || d->shift_type == S_ASR) &&
+                d->Rs == R_INVLD && d->shift == 0) {
+            *immediate = 32;
+        }
+    }
+    return 0;
+}
+
+static int armv7_disas_uncond(darm_t *d, uint32_t w)
+{
+    d->instr_type = T_ARM_UNCOND;
+
+    // there are not a lot of unconditional instructions, so the following
+    // values are a bit hardcoded
+    switch ((w >> 25) & b111) {
+    case b000:
+        d->instr = I_SETEND;
+        d->E = (w >> 9) & 1;
+        return 0;
+
+    case b010:
+        // if the 21th bit is set, then it's one of the CLREX, DMB, DSB or ISB
+        // instructions
+        if((w >> 21) & 1) {
+            d->instr = type_uncond2_instr_lookup[(w >> 4) & b111];
+            if(d->instr != I_INVLD) {
+                // if the instruction is either DMB, DSB or ISB, then the last
+                // four bits represent an "option"
+                if(d->instr != I_CLREX) {
+                    d->option = w & b1111;
+                }
+                return 0;
+            }
+        }
+        // otherwise, if the 21th bit is not set, it's either the PLD or the
+        // PLI instruction
+        // we fall-through here, as 0b011 also handles the PLD and PLI
+        // instructions
+
+    case b011:
+        // if the 24th bit is set, then this is a PLD instruction, otherwise
+        // it's a PLI instruction
+        d->instr = (w >> 24) & 1 ? I_PLD : I_PLI;
+
+        d->Rn = (w >> 16) & b1111;
+        d->U = (w >> 23) & 1;
+
+        // if the 25th bit is set, then this instruction takes a shifted
+        // register as offset, otherwise, it takes an immediate as offset
+        if((w >> 25) & 1) {
+            d->Rm = w & b1111;
+            d->shift_type = (w >> 5) & b11;
+            d->shift = (w >> 7) & b11111;
+        }
+        else {
+            d->I = B_SET;
+            d->imm = w & BITMSK_12;
+        }
+
+        // if this instruction is PLD and the 22th bit is not set, then this
+        // is in fact PLDW
+        if(d->instr == I_PLD && ((w >> 22) & 1) == 0) {
+            d->instr = I_PLDW;
+        }
+        return 0;
+
+    case b101:
+        d->instr = I_BLX;
+        d->H = (w >> 24) & 1;
+        d->imm = w & BITMSK_24;
+        d->I = B_SET;
+
+        // check if the highest bit of the imm24 is set, if so, we
+        // manually sign-extend the integer
+        if((d->imm >> 23) & 1) {
+            d->imm = (d->imm | 0xff000000) << 2;
+        }
+        else {
+            d->imm = d->imm << 2;
+        }
+
+        // add the H bit
+        d->imm |= d->H << 1;
+        return 0;
+
+    case b111:
+        d->CRn = (w >> 16) & b1111;
+        d->coproc = (w >> 8) & b1111;
+        d->opc2 = (w >> 5) & b111;
+        d->CRm = w & b1111;
+
+        if(((w >> 4) & 1) == 0) {
+            d->instr = I_CDP2;
+            d->CRd = (w >> 12) & b1111;
+            d->opc1 = (w >> 20) & b1111;
+        }
+        else {
+            d->instr = (w >> 20) & 1 ? I_MRC2 : I_MCR2;
+            d->opc1 = (w >> 21) & b111;
+            d->Rt = (w >> 12) & b1111;
+        }
+        return 0;
+    }
+    return -1;
+}
+
+// B, BL, and SVC, of which the label has already been looked up
+static int armv7_disas_brnchsc(darm_t *d, uint32_t w)
+{
+    d->imm = w & BITMSK_24;
+    d->I = B_SET;
+
+    // if the instruction is B or BL, then we have to sign-extend it and
+    // multiply it with four
+    if(d->instr != I_SVC) {
+        // check if the highest bit of the imm24 is set, if so, we
+        // manually sign-extend the integer
+        if((d->imm >> 23) & 1) {
+            d->imm = (d->imm | 0xff000000) << 2;
+        }
+        else {
+            d->imm = d->imm << 2;
+        }
+    }
+    return 0;
+}
+
+// the STR, STRT, LDR, LDRT, STRB, STRBT, LDRB, LDRBT stack instructions
+static int armv7_disas_stack0(darm_t *d, uint32_t w)
+{
+    d->instr = type_stack0_instr_lookup[(w >> 20) & b11111];
+    d->instr_type = T_ARM_STACK0;
+
+    d->Rn = (w >> 16) & b1111;
+    d->Rt = (w >> 12) & b1111;
+
+    // extract some flags
+    d->P = (w >> 24) & 1;
+    d->U = (w >> 23) & 1;
+    d->W = (w >> 21) & 1;
+
+    // if the 25th bit is not set, then this instruction takes an
+    // immediate, otherwise, it takes a shifted register
+    if(((w >> 25) & 1) == 0) {
+        d->imm = w & BITMSK_12;
+        d->I = B_SET;
+    }
+    else {
+        d->shift_type = (w >> 5) & b11;
+        d->shift = (w >> 7) & b11111;
+        d->Rm = w & b1111;
+    }
+
+    // if Rn == SP and P = 1 and U = 0 and W = 1 and imm12 = 4 and
+    // this is a STR instruction, then this is a PUSH instruction
+    if(d->instr == I_STR && d->Rn == SP && d->P == 1 && d->U == 0 &&
+            d->W == 1 && d->imm == 4) {
+        d->instr = I_PUSH;
+    }
+    // if Rn == SP and P = 0 and U = 1 and W = 0 and imm12 = 4 and
+    // this is a LDR instruction, then this is a POP instruction
+    else if(d->instr == I_LDR && d->Rn == SP && d->P == 0 &&
+            d->U == 1 && d->W == 0 && d->imm == 4) {
+        d->instr = I_POP;
+    }
+    return 0;
+}
+
+static int armv7_disas_cond(darm_t *d, uint32_t w)
+{
+    // we first handle some exceptions for MUL, STR, and LDR-like
+    // instructions, which don't fit in the regular table (as they interfere
+    // with the other instructions)
+
+    // we have to check two parts of the encoded instruction, namely bits
+    // 25..27 which should be zero, and bits 4..7, of which bit 4 and bit 7
+    // should be one
+    const uint32_t mask = (b111 << 25) | (b1001 << 4);
+    if((w & mask) == (b1001 << 4)) {
+
+        // all variants of the MUL instruction
+        if(((w >> 24) & 1) == 0 && ((w >> 4) & b1111) == b1001) {
+
+            d->instr = type_mul_instr_lookup[(w >> 21) & b111];
+            d->instr_type = T_ARM_MUL;
+
+            // except for UMAAL and MLS, every variant takes the S bit
+            d->S = (w >> 20) & 1;
+
+            // each variant takes Rm and Rn
+            d->Rm = (w >> 8) & b1111;
+            d->Rn = w & b1111;
+
+            // if this is the UMAAL or MLS instruction *and* the S bit is set,
+            // then this is an invalid instruction
+            if((d->instr == I_UMAAL || d->instr == I_MLS) && d->S != 0) {
+                return -1;
+            }
+
+            switch ((uint32_t) d->instr) {
+            case I_MLA: case I_MLS:
+                d->Ra = (w >> 12) & b1111;
+                // fall-through
+
+            case I_MUL:
+                d->Rd = (w >> 16) & b1111;
+                break;
+
+            case I_UMAAL: case I_UMULL: case I_UMLAL: case I_SMULL:
+            case I_SMLAL:
+                d->RdHi = (w >> 16) & b1111;
+                d->RdLo = (w >> 12) & b1111;
+                break;
+            }
+            return 0;
+        }
+        else if(((w >> 24) & 1) == 0 && ((w >> 5) & b11) != 0 &&
+                (w >> 21) & 1) {
+
+            // the high 2 bits are represented by the 5th and 6th bit, the
+            // lower bit is represented by the 20th bit
+            uint32_t index = ((w >> 4) & b110) | ((w >> 20) & 1);
+            d->instr = type_stack1_instr_lookup[index];
+            if(d->instr == I_INVLD) return -1;
+
+            d->instr_type = T_ARM_STACK1;
+            d->Rn = (w >> 16) & b1111;
+            d->Rt = (w >> 12) & b1111;
+            d->P = (w >> 24) & 1;
+            d->U = (w >> 23) & 1;
+
+            // depending on the register form we either have to extract a
+            // register or an immediate
+            if(((w >> 22) & 1) == 0) {
+                d->Rm = w & b1111;
+            }
+            else {
+                // the four high bits start at bit 8, so we shift them right
+                // to their destination
+                d->imm = ((w >> 4) & b11110000) | (w & b1111);
+                d->I = B_SET;
+            }
+            return 0;
+        }
+        else if(((w >> 5) & b11) != 0 && ((w >> 20) & b10010) != b00010) {
+
+            // the high 2 bits are represented by the 5th and 6th bit, the
+            // lower bit is represented by the 20th bit
+            uint32_t index = ((w >> 4) & b110) | ((w >> 20) & 1);
+            d->instr = type_stack2_instr_lookup[index];
+            if(d->instr == I_INVLD) return -1;
+
+            d->instr_type = T_ARM_STACK2;
+            d->Rn = (w >> 16) & b1111;
+            d->Rt = (w >> 12) & b1111;
+            d->P = (w >> 24) & 1;
+            d->U = (w >> 23) & 1;
+            d->W = (w >> 21) & 1;
+
+            // depending on the register form we either have to extract a
+            // register or an immediate
+            if(((w >> 22) & 1) == 0) {
+                d->Rm = w & b1111;
+            }
+            else {
+                // the four high bits start at bit 8, so we shift them right
+                // to their destination
+                d->imm = ((w >> 4) & b11110000) | (w & b1111);
+                d->I = B_SET;
+            }
+            return 0;
+        }
+        // synchronization primitive instructions
+        else if(((w >> 24) & 1) == 1 && ((w >> 4) & b1111) == b1001) {
+            d->instr = type_sync_instr_lookup[(w >> 20) & b1111];
+            d->instr_type = T_ARM_SYNC;
+            d->Rn = (w >> 16) & b1111;
+            switch ((uint32_t) d->instr) {
+            case I_SWP: case I_SWPB:
+                d->B = (w >> 22) & 1;
+                d->Rt = (w >> 12) & b1111;
+                d->Rt2 = w & b1111;
+                return 0;
+
+            case I_LDREX: case I_LDREXD: case I_LDREXB: case I_LDREXH:
+                d->Rt = (w >> 12) & b1111;
+                return 0;
+
+            case I_STREX: case I_STREXD: case I_STREXB: case I_STREXH:
+                d->Rd = (w >> 12) & b1111;
+                d->Rt = w & b1111;
+                return 0;
+            }
+        }
+    }
+    // handles the STR, STRT, LDR, LDRT, STRB, STRBT, LDRB, LDRBT stack
+    // instructions, and the media instructions
+    else if(((w >> 26) & b11) == b01) {
+
+        // if both the 25th and the 4th bit are set, then this is a media
+        // instruction, which is handled in the big switch-case statement
+        const uint32_t media_mask = (1 << 25) | (1 << 4);
+        if((w & media_mask) != media_mask) {
+            return armv7_disas_stack0(d, w);
+        }
+    }
+    // handle saturating addition and subtraction instructions, these
+    // instructions have various masks; of bits 20..27 bit 24 is set and bits
+    // 21..22 specify which instruction this is, furthermore, bits 4..7
+    // represent the value 0b0101
+    const uint32_t mask2 = (b11111001 << 20) | (b1111 << 4);
+    if((w & mask2) == ((1 << 24) | (b0101 << 4))) {
+        d->instr = type_sat_instr_lookup[(w >> 21) & b11];
+        d->instr_type = T_ARM_SAT;
+        d->Rn = (w >> 16) & b1111;
+        d->Rd = (w >> 12) & b1111;
+        d->Rm = w & b1111;
+        return 0;
+    }
+    // handle packing, unpacking, saturation, and reversal instructions, these
+    // instructions have the 4th bit set and bits 23..27 represent 0b01101
+    const uint32_t mask3 = (b11111 << 23) | (1 << 4);
+    if((w & mask3) == ((b01101 << 23) | (1 << 4))) {
+        // some instructions are already handled elsewhere (namely, PKH, SEL,
+        // REV, REV16, RBIT, and REVSH)
+        uint32_t op1 = (w >> 20) & b111;
+        uint32_t A = (w >> 16) & b1111;
+        uint32_t op2 = (w >> 5) & b111;
+
+        d->instr_type = T_ARM_PUSR;
+
+        // the (SX|UX)T(A)(B|H)(16) instructions
+        // op1 represents the upper three bits, and A = 0b1111 represents
+        if(op2 == b011) {
+            // the lower bit
+            d->instr = type_pusr_instr_lookup[(op1 << 1) | (A == b1111)];
+            if(d->instr != I_INVLD) {
+                d->Rd = (w >> 12) & b1111;
+                d->Rm = w & b1111;
+
+                // rotation is shifted to the left by three, so we do this
+                // directly in our shift as well
+                d->rotate = (w >> 7) & b11000;
+
+                // if A is not 0b1111, then A represents the Rn operand
+                if(A != b1111) {
+                    d->Rn = A;
+                }
+                return 0;
+            }
+        }
+
+        // SSAT
+        if((op1 & b010) == b010 && (op2 & 1) == 0) {
+            // if the upper bit is set, then it's USAT, otherwise SSAT
+            d->instr = (op1 >> 2) ? I_USAT : I_SSAT;
+            d->imm = (w >> 16) & b11111;
+            d->I = B_SET;
+            // signed saturate adds one to the immediate
+            if(d->instr == I_SSAT) {
+                d->imm++;
+            }
+            d->Rd = (w >> 12) & b1111;
+            d->shift = (w >> 7) & b11111;
+            d->shift_type = (w >> 5) & b11;
+            d->Rn = w & b1111;
+            return 0;
+        }
+
+        // SSAT16 and USAT16
+        if((op1 == b010 || op1 == b110) && op2 == b001) {
+            d->instr = op1 == b010 ? I_SSAT16 : I_USAT16;
+            d->imm = (w >> 16) & b1111;
+            d->I = B_SET;
+            // signed saturate 16 adds one to the immediate
+            if(d->instr == I_SSAT16) {
+                d->imm++;
+            }
+            d->Rd = (w >> 12) & b1111;
+            d->Rn = w & b1111;
+            return 0;
+        }
+    }
+
+    // the instruction label and type
+    darm_lut_t entry = armv7_instr_lut[(w >> 20) & 0xff];
+    d->instr = darm_lut_instr(entry);
+    d->instr_type = darm_lut_type(entry);
+
+    // do a lookup for the type of instruction
+#ifdef DARM_THREADED_DISPATCH
+    DISPATCH_TABLE(targets, ARRAYSIZE(darm_enctypes), arm_invld)
+        [T_ARM_ARITH_SHIFT] = &&arm_arith_shift,
+        [T_ARM_ARITH_IMM] = &&arm_arith_imm,
+        [T_ARM_BITS] = &&arm_bits,
+        [T_ARM_BRNCHSC] = &&arm_brnchsc,
+        [T_ARM_BRNCHMISC] = &&arm_brnchmisc,
+        [T_ARM_MOV_IMM] = &&arm_mov_imm,
+        [T_ARM_CMP_OP] = &&arm_cmp_op,
+        [T_ARM_CMP_IMM] = &&arm_cmp_imm,
+        [T_ARM_OPLESS] = &&arm_opless,
+        [T_ARM_DST_SRC] = &&arm_dst_src,
+        [T_ARM_LDSTREGS] = &&arm_ldstregs,
+        [T_ARM_BITREV] = &&arm_bitrev,
+        [T_ARM_MISC] = &&arm_misc,
+        [T_ARM_SM] = &&arm_sm,
+        [T_ARM_PAS] = &&arm_pas,
+        [T_ARM_MVCR] = &&arm_mvcr,
+        [T_ARM_UDF] = &&arm_udf,
+    DISPATCH_END()
+    DISPATCH(targets, d->instr_type);
+#endif
+
+    switch ((uint32_t) d->instr_type) {
+    case T_ARM_ARITH_SHIFT: DISPATCH_TARGET(arm_arith_shift)
+        d->S = (w >> 20) & 1;
+        d->Rd = (w >> 12) & b1111;
+        d->Rn = (w >> 16) & b1111;
+        d->Rm = w & b1111;
+        d->shift_type = (w >> 5) & b11;
+
+        // type == 1, shift with the value of the lower bits of Rs
+        if(((w >> 4) & 1) == B_SET) {
+            d->Rs = (w >> 8) & b1111;
+        }
+        else {
+            d->shift = (w >> 7) & b11111;
+        }
+        return 0;
+
+    case T_ARM_ARITH_IMM: DISPATCH_TARGET(arm_arith_imm)
+        d->S = (w >> 20) & 1;
+        d->Rd = (w >> 12) & b1111;
+        d->Rn = (w >> 16) & b1111;
+        d->imm = ARMExpandImm(w & BITMSK_12);
+        d->I = B_SET;
+
+        // check whether this instruction is in fact an ADR instruction
+        if((d->instr == I_ADD || d->instr == I_SUB) &&
+                d->S == 0 && d->Rn == PC) {
+            d->instr = I_ADR, d->Rn = R_INVLD;
+            d->U = (w >> 23) & 1;
+        }
+        return 0;
+
+    case T_ARM_BITS: DISPATCH_TARGET(arm_bits)
+        d->instr = type_bits_instr_lookup[(w >> 21) & b11];
+
+        d->instr_type = T_ARM_BITS;
+        d->Rd = (w >> 12) & b1111;
+        d->Rn = w & b1111;
+        d->lsb = (w >> 7) & b11111;
+
+        // the bfi and bfc instructions specify the MSB, whereas the SBFX and
+        // UBFX instructions specify the width minus one
+        if(d->instr == I_BFI) {
+            d->width = ((w >> 16) & b11111) - d->lsb + 1;
+
+            // if Rn is 0b1111, then this is in fact the BFC instruction
+            if(d->Rn == b1111) {
+                d->Rn = R_INVLD;
+                d->instr = I_BFC;
+            }
+        }
+        else {
+            d->width = ((w >> 16) & b11111) + 1;
+        }
+        return 0;
+
+    case T_ARM_BRNCHSC: DISPATCH_TARGET(arm_brnchsc)
+        return armv7_disas_brnchsc(d, w);
+
+    case T_ARM_BRNCHMISC: DISPATCH_TARGET(arm_brnchmisc)
+        // first get the real instruction label
+        d->instr = type_brnchmisc_instr_lookup[(w >> 4) & b1111];
+
+        // now we do a switch statement based on the instruction label,
+        // rather than some magic values
+        switch ((uint32_t) d->instr) {
+        case I_BKPT:
+            d->imm = (((w >> 8) & BITMSK_12) << 4) + (w & b1111);
+            d->I = B_SET;
+            return 0;
+
+        case I_BX: case I_BXJ: case I_BLX:
+            d->Rm = w & b1111;
+            return 0;
+
+        case I_MSR:
+            d->Rn = w & b1111;
+            d->imm = (w >> 18) & b11;
+            d->I = B_SET;
+            return 0;
+
+        case I_QSUB: case I_SMLAW: case I_SMULW: default:
+            // returns -1
+            break;
+        }
+        break;
+
+    case T_ARM_MOV_IMM: DISPATCH_TARGET(arm_mov_imm)
+        d->Rd = (w >> 12) & b1111;
+        d->imm = w & BITMSK_12;
+        d->I = B_SET;
+
+        // the MOV and MVN instructions have an S bit
+        if(d->instr == I_MOV || d->instr == I_MVN) {
+            d->S = (w >> 20) & 1;
+
+            // the immediate values of the MOV and MVN instructions have to
+            // be decoded
+            d->imm = ARMExpandImm(d->imm);
+        }
+        // the MOVW and the MOVT instructions take another 4 bits of immediate
+        else {
+            d->imm |= ((w >> 16) & b1111) << 12;
+        }
+        return 0;
+
+    case T_ARM_CMP_OP: DISPATCH_TARGET(arm_cmp_op)
+        d->Rn = (w >> 16) & b1111;
+        d->Rm = w & b1111;
+        d->shift_type = (w >> 5) & b11;
+
+        // type == 1, shift with the value of the lower bits of Rs
+        if(((w >> 4) & 1) == B_SET) {
+            d->Rs = (w >> 8) & b1111;
+        }
+        else {
+            d->shift = (w >> 7) & b11111;
+        }
+        return 0;
+
+    case T_ARM_CMP_IMM: DISPATCH_TARGET(arm_cmp_imm)
+        d->Rn = (w >> 16) & b1111;
+        d->imm = ARMExpandImm(w & BITMSK_12);
+        d->I = B_SET;
+        return 0;
+
+    case T_ARM_OPLESS: DISPATCH_TARGET(arm_opless)
+        d->instr = type_opless_instr_lookup[w & b111];
+        return d->instr == I_INVLD ? -1 : 0;
+
+    case T_ARM_DST_SRC: DISPATCH_TARGET(arm_dst_src)
+        d->instr = type_shift_instr_lookup[(w >> 4) & b1111];
+        if(d->instr == I_INVLD) return -1;
+
+        d->S = (w >> 20) & 1;
+        d->Rd = (w >> 12) & b1111;
+        d->shift_type = (w >> 5) & b11;
+        if((w >> 4) & 1) {
+            d->Rm = (w >> 8) & b1111;
+            d->Rn = w & b1111;
+        }
+        else {
+            d->Rm = w & b1111;
+            d->shift = (w >> 7) & b11111;
+
+            // if this is a LSL instruction with a zero shift, then it's
+            // actually a MOV instruction (there's no register-shifted LSL)
+            if(d->instr == I_LSL && d->shift_type == S_LSL && d->shift == 0) {
+                d->instr = I_MOV;
+            }
+
+            // if this is a ROR instruction with a zero shift, then it's
+            // actually a RRX instruction (there's no register-shifted ROR)
+            else if(d->instr == I_ROR && d->shift_type == S_ROR &&
+                    d->shift == 0) {
+                d->instr = I_RRX;
+            }
+        }
+
+        return 0;
+
+    case T_ARM_LDSTREGS: DISPATCH_TARGET(arm_ldstregs)
+        d->W = (w >> 21) & 1;
+        d->Rn = (w >> 16) & b1111;
+        d->reglist = w & BITMSK_16;
+
+        // if this is the LDM instruction and W = 1 and Rn = SP then this is
+        // a POP instruction
+        if(d->instr == I_LDM && d->W == 1 && d->Rn == SP) {
+            d->instr = I_POP;
+        }
+        // if this is the STMDB instruction and W = 1 and Rn = SP then this is
+        // the PUSH instruction
+        else if(d->instr == I_STMDB && d->W == 1 && d->Rn == SP) {
+            d->instr = I_PUSH;
+        }
+        return 0;
+
+    case T_ARM_BITREV: DISPATCH_TARGET(arm_bitrev)
+        d->Rd = (w >> 12) & b1111;
+        d->Rm = w & b1111;
+
+        // if this is the REV16 instruction and bits 4..7 are 0b0011, then
+        // this is in fact the REV instruction
+        if(d->instr == I_REV16 && ((w >> 4) & b1111) == b0011) {
+            d->instr = I_REV;
+        }
+        // if this is the REVSH instruction and bits 4..7 are 0b0011, then
+        // this is in fact the RBIT instruction
+        else if(d->instr == I_REVSH && ((w >> 4) & b1111) == b0011) {
+            d->instr = I_RBIT;
+        }
+        return 0;
+
+    case T_ARM_MISC: DISPATCH_TARGET(arm_misc)
+        switch ((uint32_t) d->instr) {
+        case I_MVN:
+            d->S = (w >> 20) & 1;
+            d->Rd = (w >> 12) & b1111;
+            d->shift_type = (w >> 5) & b11;
+            d->Rm = w & b1111;
+            if(((w >> 4) & 1) == B_UNSET) {
+                d->shift = (w >> 7) & b11111;
+            }
+            else {
+                d->Rs = (w >> 8) & b1111;
+            }
+            return 0;
+
+        case I_DBG:
+            d->option = w & b1111;
+            return 0;
+
+        case I_SMC:
+            switch ((w >> 4) & b1111) {
+            // if the 7th bit is 1 and the 4th bit 0, then this is
+            // the SMUL instruction
+            case b1000: case b1010: case b1100: case b1110:
+                d->instr = I_SMUL;
+                d->instr_type = T_ARM_SM;
+                d->Rd = (w >> 16) & b1111;
+                d->Rm = (w >> 8) & b1111;
+                d->M  = (w >> 6) & 1;
+                d->N  = (w >> 5) & 1;
+                d->Rn = w & b1111;
+                break;
+
+            // smc
+            case b0111:
+                d->instr = I_SMC;
+                d->imm = w & b1111;
+                d->I = B_SET;
+                break;
+
+            // clz
+            case b0001:
+                d->instr = I_CLZ;
+                d->Rm = w & b1111;
+                d->Rd = (w >> 12) & b1111;
+                break;
+
+            default:
+                return -1;
+            }
+            return 0;
+
+        case I_SEL:
+            d->Rd = (w >> 12) & b1111;
+            d->Rn = (w >> 16) & b1111;
+            d->Rm = w & b1111;
+
+            // the SEL and PKH instructions share the same 8-bit identifier,
+            // if the 5th bit is set, then this is the SEL instruction,
+            // otherwise it's the PKH instruction
+            if(((w >> 5) & 1) == 0) {
+                d->instr = I_PKH;
+                d->shift_type = (w >> 5) & b10;
+                d->shift = (w >> 7) & b11111;
+                d->T = (w >> 6) & 1;
+            }
+            return 0;
+        }
+
+    case T_ARM_SM: DISPATCH_TARGET(arm_sm)
+        switch ((uint32_t) d->instr) {
+        case I_SMMUL:
+            d->Rd = (w >> 16) & b1111;
+            d->Ra = (w >> 12) & b1111;
+            d->Rm = (w >> 8) & b1111;
+            d->R  = (w >> 5) & 1;
+            d->Rn = w & b1111;
+
+            // this can be either the SMMUL, the SMMLA, or the SMMLS
+            // instruction, depending on the 6th bit and Ra
+            if((w >> 6) & 1) {
+                d->instr = I_SMMLS;
+            }
+            // if it's SMMUL instruction, but Ra is not 0b1111, then this is
+            // the SMMLA instruction
+            else if(d->Ra != b1111) {
+                d->instr = I_SMMLA;
+            }
+            return 0;
+
+        case I_SMUSD:
+            d->Rd = (w >> 16) & b1111;
+            d->Ra = (w >> 12) & b1111;
+            d->Rm = (w >> 8) & b1111;
+            d->M  = (w >> 5) & 1;
+            d->Rn = w & b1111;
+
+            // this can be either the SMLAD, the SMLSD, the SMUAD, or the
+            // SMUSD instruction, depending on the 6th bit and Ra
+            if((w >> 6) & 1 && d->Rn != b1111) {
+                d->instr = I_SMLSD;
+            }
+            else if(((w >> 6) & 1) == 0) {
+                d->instr = d->Ra == b1111 ? I_SMUAD : I_SMLAD;
+            }
+            return 0;
+
+        case I_SMLSLD:
+            d->RdHi = (w >> 16) & b1111;
+            d->RdLo = (w >> 12) & b1111;
+            d->Rm = (w >> 8) & b1111;
+            d->M = (w >> 5) & 1;
+            d->Rn = w & b1111;
+
+            // if the 6th bit is zero, then this is in fact the SMLALD
+            // instruction
+            if(((w >> 6) & 1) == 0) {
+                d->instr = I_SMLALD;
+            }
+            return 0;
+
+        case I_SMLA:
+            d->Rd = (w >> 16) & b1111;
+            d->Ra = (w >> 12) & b1111;
+            d->Rm = (w >> 8) & b1111;
+            d->M  = (w >> 6) & 1;
+            d->N  = (w >> 5) & 1;
+            d->Rn = w & b1111;
+            return 0;
+
+        case I_SMLAL:
+            d->RdHi = (w >> 16) & b1111;
+            d->RdLo = (w >> 12) & b1111;
+            d->Rm = (w >> 8) & b1111;
+            d->M  = (w >> 6) & 1;
+            d->N  = (w >> 5) & 1;
+            d->Rn = w & b1111;
+            return 0;
+
+        case I_SMUL:
+            // SMUL overlaps with SMC, so we define SMUL in SMC..
+            break;
+        }
+
+    case T_ARM_PAS: DISPATCH_TARGET(arm_pas)
+        // we have a lookup table with size 64, for all parallel signed and
+        // unsigned addition and subtraction instructions
+        // the upper three bits are represented by bits 20..22, so we only
+        // right-shift those 17 bytes, the lower three bits are represented
+        // by bits 5..7
+        d->instr = type_pas_instr_lookup[((w >> 17) & b111000) |
+                                         ((w >> 5) & b111)];
+        if(d->instr == I_INVLD) return -1;
+
+        d->Rn = (w >> 16) & b1111;
+        d->Rd = (w >> 12) & b1111;
+        d->Rm = w & b1111;
+        return 0;
+
+    case T_ARM_MVCR: DISPATCH_TARGET(arm_mvcr)
+        d->CRn = (w >> 16) & b1111;
+        d->coproc = (w >> 8) & b1111;
+        d->opc2 = (w >> 5) & b111;
+        d->CRm = w & b1111;
+
+        if(((w >> 4) & 1) == 0) {
+            d->instr = I_CDP;
+            d->opc1 = (w >> 20) & b1111;
+            d->CRd = (w >> 12) & b1111;
+        }
+        else {
+            d->opc1 = (w >> 21) & b111;
+            d->Rt = (w >> 12) & b1111;
+        }
+        return 0;
+
+    case T_ARM_UDF: DISPATCH_TARGET(arm_udf)
+        d->I = B_SET;
+        d->imm = (w & b1111) | ((w >> 4) & (BITMSK_12 << 4));
+        return 0;
+    }
+    DISPATCH_TARGET(arm_invld)
+    return -1;
+}
+
+static int armv7_disas_finish(darm_t *d, int ret)
+{
+    // return error
+    if(ret < 0) return ret;
+
+    // if the shift-type is set to S_LSL, but Rs is R_INVLD and shift is zero,
+    // then there's effectively no shift, so we set shift-type to S_INVLD
+    if(d->shift_type == S_LSL && d->Rs == R_INVLD && d->shift == 0) {
+        d->shift_type = S_INVLD;
+    }
+
+    darm_regs_update(d);
+    return 0;
+}
+
+int darm_armv7_disasm(darm_t *d, uint32_t w)
+{
+    int ret;
+
+    darm_init(d);
+    d->w = w;
+    d->cond = (w >> 28) & b1111;
+
+    if(d->cond == C_UNCOND) {
+        ret = armv7_disas_uncond(d, w);
+    }
+    else {
+        ret = armv7_disas_cond(d, w);
+    }
+
+    return armv7_disas_finish(d, ret);
+}
+
+// amount of instructions that are classified and then disassembled at once
+#define BATCH_SIZE 256
+
+uint32_t darm_armv7_disasm_batch(darm_t *d, const uint32_t *w,
+    uint32_t count)
+{
+    uint8_t cls[BATCH_SIZE]; uint16_t order[BATCH_SIZE];
+    uint32_t ok = 0;
+
+    for (uint32_t base = 0; base < count; base += BATCH_SIZE) {
+        uint32_t n = count - base < BATCH_SIZE ? count - base : BATCH_SIZE;
+        uint32_t offset[DC_COUNT + 1] = {0};
+
+        darm_armv7_classify(&w[base], n, cls);
+
+        // partition the instructions by class, i.e., a counting sort
+        for (uint32_t idx = 0; idx < n; idx++) {
+            offset[cls[idx] + 1]++;
+        }
+        for (uint32_t idx = 0; idx < DC_COUNT; idx++) {
+            offset[idx + 1] += offset[idx];
+        }
+        for (uint32_t idx = 0; idx < n; idx++) {
+            order[offset[cls[idx]]++] = idx;
+        }
+
+        // offset[c] now points to the end of class c
+        for (uint32_t c = 0, start = 0; c < DC_COUNT;
+                start = offset[c++]) {
+            for (uint32_t idx = start; idx < offset[c]; idx++) {
+                darm_t *cur = &d[base + order[idx]];
+                uint32_t insn = w[base + order[idx]];
+                int ret;
+
+                darm_init(cur);
+                cur->w = insn;
+                cur->cond = (insn >> 28) & b1111;
+
+                switch (c) {
+                case DC_UNCOND:
+                    ret = armv7_disas_uncond(cur, insn);
+                    break;
+
+                case DC_LDST:
+                    ret = armv7_disas_stack0(cur, insn);
+                    break;
+
+                case DC_BRANCH:
+                    cur->instr =
+                        darm_lut_instr(armv7_instr_lut[(insn >> 20) & 0xff]);
+                    cur->instr_type = T_ARM_BRNCHSC;
+                    ret = armv7_disas_brnchsc(cur, insn);
+                    break;
+
+                default:
+                    ret = armv7_disas_cond(cur, insn);
+                    break;
+                }
+
+                if(armv7_disas_finish(cur, ret) < 0) {
+                    darm_init(cur);
+                    cur->w = insn;
+                    continue;
+                }
+                ok++;
+            }
+        }
+    }
+    return ok;
+}
+
+const char *darm_mnemonic_name(darm_instr_t instr)
+{
+    return instr < ARRAYSIZE(darm_mnemonics) ?
+        darm_mnemonics[instr] : NULL;
+}
+
+const char *darm_enctype_name(darm_enctype_t enctype)
+{
+    return enctype < ARRAYSIZE(darm_enctypes) ?
+        darm_enctypes[enctype] : NULL;
+}
+
+const char *darm_register_name(darm_reg_t reg)
+{
+    return reg != R_INVLD && reg < (int32_t) ARRAYSIZE(darm_registers) ?
+        darm_registers[reg] : NULL;
+}
+
+const char *darm_shift_type_name(darm_shift_type_t shifttype)
+{
+    return
+        shifttype != S_INVLD && shifttype < (int32_t) ARRAYSIZE(shift_types) ?
+        shift_types[shifttype] : NULL;
+}
+
+const char *darm_condition_name(darm_cond_t cond, int omit_always_execute)
+{
+    // we don't give the AL postfix, as almost every instruction would need
+    // one then
+    if(omit_always_execute != 0 && cond == C_AL) return "";
+
+    return cond != C_INVLD && cond < (int32_t) ARRAYSIZE(g_condition_codes) ?
+        g_condition_codes[cond].mnemonic_extension : NULL;
+}
+
+const char *darm_condition_meaning_int(darm_cond_t cond)
+{
+    return cond != C_INVLD && cond < (int32_t) ARRAYSIZE(g_condition_codes) ?
+        g_condition_codes[cond].meaning_integer : NULL;
+}
+
+const char *darm_condition_meaning_fp(darm_cond_t cond)
+{
+    return cond != C_INVLD && cond < (int32_t) ARRAYSIZE(g_condition_codes) ?
+        g_condition_codes[cond].meaning_fp : NULL;
+}
+
+darm_cond_t darm_condition_index(const char *condition_code)
+{
+    if(condition_code == NULL) return -1;
+
+    // the "AL" condition flag
+    if(condition_code[0] == 0) return C_AL;
+
+    for (uint32_t i = 0; i < ARRAYSIZE(g_condition_codes); i++) {
+        if(!strcmp(condition_code, g_condition_codes[i].mnemonic_extension)) {
+            return i;
+        }
+    }
+
+    return C_INVLD;
+}
+#undef BITMSK_12
+#undef BITMSK_16
+#undef BITMSK_24
+#undef ROR
+#undef ARMExpandImm
+#undef BATCH_SIZE
+
+// ---- boundary.c ----
+
+#include <stdio.h>
+#include <stdint.h>
+// ---- kernels.h ----
+
+#ifndef __KERNELS_H__
+#define __KERNELS_H__
+
+#include <stdint.h>
+
+// the vectorized kernels are only available for x86 and x86-64, each ISA
+// has its own object, see the Makefile
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DARM_X86 1
+#endif
+
+// the class of each key, i.e., bits 27..25 of the instruction followed by
+// bit 4 (or bits 7 and 4 for data-processing), as one nibble per key; keys
+// 0..7 are stored in CLASSES_LO and keys 8..15 in CLASSES_HI
+#define CLASSES_LO 0x32220010
+#define CLASSES_HI 0x66665544
+
+// a halfword starts a 32-bit instruction if bits 15..11 are 0b11101,
+// 0b11110, or 0b11111, see darm_disasm
+#define IS_PREFIX(hw) ((hw) >= 0xe800)
+
+typedef struct _darm_kernels_t {
+    // the cpu features the kernels require
+    uint32_t        features;
+
+    // classifies count armv7 instructions, see darm_armv7_classify
+    void (*classify)(const uint32_t *w, uint32_t count, uint8_t *cls);
+
+    // one bit per halfword for the count (at most 64) halfwords in buf, set
+    // if it would start a 32-bit Thumb instruction
+    uint64_t (*prefix)(const uint8_t *buf, uint32_t count);
+
+    // one bit per word for the count (at most 64) words, set if the word
+    // matches the pattern, see darm_match_block
+    uint64_t (*match)(const uint32_t *words, uint32_t count, uint32_t mask,
+        uint32_t value);
+
+    // reverses the byte order of count words or halfwords
+    void (*bswap32)(uint32_t *dst, const uint32_t *src, uint32_t count);
+    void (*bswap16)(uint16_t *dst, const uint16_t *src, uint32_t count);
+} darm_kernels_t;
+
+// the kernels for the features of this cpu, selected on first use, see
+// darm_cpu_select
+const darm_kernels_t *darm_kernels();
+
+// the portable kernels, which are also used by the vectorized kernels for
+// the remaining elements
+void darm_classify_scalar(const uint32_t *w, uint32_t count, uint8_t *cls);
+uint64_t darm_prefix_scalar(const uint8_t *buf, uint32_t count);
+uint64_t darm_match_scalar(const uint32_t *words, uint32_t count,
+    uint32_t mask, uint32_t value);
+void darm_bswap32_scalar(uint32_t *dst, const uint32_t *src, uint32_t count);
+void darm_bswap16_scalar(uint16_t *dst, const uint16_t *src, uint32_t count);
+
+#ifdef DARM_X86
+
+extern const darm_kernels_t darm_kernels_sse42;
+extern const darm_kernels_t darm_kernels_avx2;
+extern const darm_kernels_t darm_kernels_avx512;
+
+// shared with the AVX-512 kernels
+void darm_classify_avx2(const uint32_t *w, uint32_t count, uint8_t *cls);
+
+#endif
+
+#endif
+
+#define ODD_BITS 0xaaaaaaaaaaaaaaaaULL
+
+// computes the instruction starts of count halfwords, carry specifies
+// whether the first halfword is the second half of a 32-bit instruction;
+// returns the carry for the next halfword
+static uint64_t _thumb_bitmap(const uint8_t *buf, uint32_t count,
+    uint64_t *starts, uint64_t carry)
+{
+    uint64_t (*prefix)(const uint8_t *buf, uint32_t count) =
+        darm_kernels()->prefix;
+
+    for (uint32_t idx = 0; idx < count; idx += 64) {
+        uint32_t n = count - idx < 64 ? count - idx : 64;
+        uint64_t p = prefix(&buf[idx * 2], n);
+
+        // a halfword is the second half of a 32-bit instruction if the
+        // previous halfword is a prefix and starts an instruction itself,
+        // i.e., within each run of prefixes every other halfword starts an
+        // instruction, which is resolved by a carry propagating subtraction
+        // in the same way as odd-length runs of escape characters are
+        uint64_t first = p & ~carry;
+        uint64_t code = (((first << 1) | ODD_BITS) - first) ^ ODD_BITS;
+        uint64_t second = code ^ (p | carry);
+
+        starts[idx / 64] = ~second & (n == 64 ? ~0ULL : (1ULL << n) - 1);
+        carry = ((code & p) >> 63) & (n == 64);
+    }
+    return carry;
+}
+
+void darm_thumb_bitmap(const uint8_t *buf, uint32_t len, uint64_t *starts)
+{
+    _thumb_bitmap(buf, len / 2, starts, 0);
+}
+
+// amount of halfwords that are resolved at once
+#define CHUNK_SIZE 4096
+
+uint32_t darm_thumb_starts(const uint8_t *buf, uint32_t len,
+    uint32_t *starts)
+{
+    uint64_t bitmap[CHUNK_SIZE / 64], carry = 0;
+    uint32_t count = 0;
+
+    for (uint32_t off = 0; off < len / 2; off += CHUNK_SIZE) {
+        uint32_t n = len / 2 - off < CHUNK_SIZE ? len / 2 - off : CHUNK_SIZE;
+        carry = _thumb_bitmap(&buf[off * 2], n, bitmap, carry);
+
+        for (uint32_t idx = 0; idx < (n + 63) / 64; idx++) {
+            for (uint64_t bits = bitmap[idx]; bits != 0; bits &= bits - 1) {
+                starts[count++] = (off + idx * 64 + __builtin_ctzll(bits)) * 2;
+            }
+        }
+    }
+    return count;
+}
+#undef ODD_BITS
+#undef CHUNK_SIZE
+
+// ---- cfg.c ----
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NO_TARGET 0xffffffff
+
+// control flow instruction, all offsets are in halfwords relative to the
+// start of the range
+typedef struct _cfg_branch_t {
+    uint32_t        next;
+    uint32_t        target;
+    uint8_t         flow;
+    uint8_t         cond;
+
+    // the cases of a resolved switch, case_count offsets starting at
+    // case_index in the list of cases
+    uint32_t        case_index;
+    uint32_t        case_count;
+} cfg_branch_t;
+
+darm_flow_t darm_flow(const darm_t *d)
+{
+    switch ((uint32_t) d->instr) {
+    case I_B: case I_CBZ: case I_CBNZ:
+        return F_JUMP;
+
+    case I_BL: case I_BLX:
+        return F_CALL;
+
+    case I_BX: case I_BXJ:
+        return F_INDIRECT;
+
+    case I_TBB: case I_TBH:
+        return F_TABLE;
+
+    case I_POP: case I_LDM: case I_LDMDA: case I_LDMDB: case I_LDMIB:
+        // loading the pc from the stack, i.e., a return
+        return (d->reglist >> PC) & 1 || d->Rt == PC ? F_INDIRECT : F_NONE;
+
+    case I_LDR:
+        return d->Rt == PC ? F_INDIRECT : F_NONE;
+
+    case I_CMP: case I_CMN: case I_TEQ: case I_TST:
+        // the thumb2 decoder sets Rd to PC for these, but they don't
+        // write to it
+        return F_NONE;
+
+    default:
+        // data-processing instructions writing to the pc, e.g.,
+        // MOV pc, lr or ADD pc, pc, r0
+        return d->Rd == PC ? F_INDIRECT : F_NONE;
+    }
+}
+
+int darm_flow_is_cond(const darm_t *d)
+{
+    return d->instr == I_CBZ || d->instr == I_CBNZ ||
+        (d->cond != C_AL && d->cond != C_UNCOND && d->cond != C_INVLD);
+}
+
+int32_t darm_cfg_block(const darm_cfg_t *cfg, uint32_t addr)
+{
+    uint32_t lo = 0, hi = cfg->block_count;
+
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if(cfg->block_addr[mid] < addr) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+
+    return lo < cfg->block_count && cfg->block_addr[lo] == addr ? (int32_t) lo : -1;
+}
+
+int darm_cfg_build(darm_cfg_t *cfg, const uint8_t *buf, uint32_t len,
+    uint32_t base, uint32_t start, uint32_t end)
+{
+    uint32_t thumb = start & 1, step = thumb ? 2 : 4;
+    start &= ~1;
+
+    memset(cfg, 0, sizeof(darm_cfg_t));
+
+    if(start < base || end < start || end - base > len) {
+        return -1;
+    }
+
+    const uint8_t *code = buf + (start - base);
+    uint32_t size = end - start, count = size / 2 + 1;
+
+    // one bit per halfword for the start of each instruction and for the
+    // start of each basic block
+    uint64_t *insns = calloc(BITMAP_WORDS(count), sizeof(uint64_t));
+    uint64_t *leaders = calloc(BITMAP_WORDS(count), sizeof(uint64_t));
+
+    uint32_t branch_count = 0, branch_alloc = 1024;
+    cfg_branch_t *branches = malloc(branch_alloc * sizeof(cfg_branch_t));
+
+    // the targets of resolved switches, in halfwords as well
+    uint32_t case_count = 0, case_alloc = 1024;
+    uint32_t *cases = malloc(case_alloc * sizeof(uint32_t));
+
+    // literal pools and jump tables referenced by the code
+    darm_data_t data;
+    int data_ret = darm_data_init(&data, start, size);
+
+    darm_jt_t jt;
+    darm_jt_init(&jt, buf, len, base);
+
+    if(insns == NULL || leaders == NULL || branches == NULL ||
+            cases == NULL || data_ret < 0) {
+        goto error;
+    }
+
+    BITMAP_SET(leaders, 0);
+
+    darm_t d; darm_it_t it; uint32_t off = 0;
+    darm_it_init(&it);
+
+    while (off + step <= size) {
+        // skip literal pools and jump tables, the next instruction after
+        // them starts a new basic block
+        if(darm_data_get(&data, start + off)) {
+            off += step;
+            if(!darm_data_get(&data, start + off)) {
+                BITMAP_SET(leaders, off / 2);
+            }
+            continue;
+        }
+
+        int ret = darm_disasm_buf(&d, code + off, size - off,
+            (start + off) | thumb);
+
+        // instructions inside an IT block are conditional
+        if(thumb != 0) {
+            darm_it_apply(&it, &d, ret);
+        }
+
+        BITMAP_SET(insns, off / 2);
+
+        uint32_t case_index = case_count, targets = 0;
+
+        if(ret != 0) {
+            darm_data_mark(&data, &d, (start + off) | thumb);
+
+            darm_jt_t saved = jt;
+            targets = darm_jt_step(&jt, &d, (start + off) | thumb,
+                cases + case_count, case_alloc - case_count);
+
+            // not enough room for all the cases, resolve the switch again
+            if(targets > case_alloc - case_count) {
+                while (targets > case_alloc - case_count) case_alloc *= 2;
+
+                uint32_t *ptr = realloc(cases, case_alloc * sizeof(uint32_t));
+                if(ptr == NULL) goto error;
+                cases = ptr;
+
+                jt = saved;
+                darm_jt_step(&jt, &d, (start + off) | thumb,
+                    cases + case_count, targets);
+            }
+
+            // the table holds addresses rather than instructions
+            if(targets != 0 && jt.table_size != 0) {
+                darm_data_set(&data, jt.table_addr, jt.table_size);
+            }
+        }
+
+        // keep the cases inside the range, as offsets
+        for (uint32_t idx = 0; idx < targets; idx++) {
+            uint32_t addr = cases[case_index + idx];
+            if((addr & 1) != thumb || (addr & ~1) < start ||
+                    (addr & ~1) >= end) {
+                continue;
+            }
+
+            cases[case_count] = ((addr & ~1) - start) / 2;
+            BITMAP_SET(leaders, cases[case_count]);
+            case_count++;
+        }
+
+        darm_flow_t flow = ret != 0 ? darm_flow(&d) : F_INDIRECT;
+        uint32_t next = off + (ret != 0 ? (uint32_t) ret * 2 : step);
+        uint32_t target = NO_TARGET, addr; int target_is_thumb;
+
+        if(ret != 0 && darm_branch_target(&d, (start + off) | thumb,
+                &addr, &target_is_thumb) == 0 &&
+                (uint32_t) target_is_thumb == thumb &&
+                addr >= start && addr < end) {
+            target = (addr - start) / 2;
+            BITMAP_SET(leaders, target);
+        }
+
+        off = next;
+
+        // calls don't end a basic block, and neither do regular instructions
+        if(flow == F_NONE || flow == F_CALL) continue;
+
+        if(branch_count == branch_alloc) {
+            cfg_branch_t *ptr = realloc(branches,
+                (branch_alloc *= 2) * sizeof(cfg_branch_t));
+            if(ptr == NULL) goto error;
+            branches = ptr;
+        }
+
+        // undecodable instructions end a basic block without any successors
+        branches[branch_count].next = next / 2;
+        branches[branch_count].target = target;
+        branches[branch_count].flow = flow;
+        branches[branch_count].cond = ret != 0 && darm_flow_is_cond(&d);
+        branches[branch_count].case_index = case_index;
+        branches[branch_count].case_count = case_count - case_index;
+        branch_count++;
+
+        BITMAP_SET(leaders, next / 2);
+    }
+
+    // only the start of an instruction can be the start of a basic block
+    for (uint32_t idx = 0; idx < BITMAP_WORDS(count); idx++) {
+        leaders[idx] &= insns[idx];
+        cfg->block_count += __builtin_popcountll(leaders[idx]);
+    }
+
+    cfg->block_addr = malloc(cfg->block_count * sizeof(uint32_t));
+    cfg->block_size = malloc(cfg->block_count * sizeof(uint32_t));
+    cfg->edge_index = malloc((cfg->block_count + 1) * sizeof(uint32_t));
+    cfg->edge_target = malloc((cfg->block_count * 2 + case_count) *
+        sizeof(uint32_t));
+    cfg->edge_type = malloc((cfg->block_count * 2 + case_count) *
+        sizeof(uint8_t));
+
+    if(cfg->block_addr == NULL || cfg->block_size == NULL ||
+            cfg->edge_index == NULL || cfg->edge_target == NULL ||
+            cfg->edge_type == NULL) {
+        goto error;
+    }
+
+    uint32_t block = 0;
+    for (uint32_t idx = 0; idx < BITMAP_WORDS(count); idx++) {
+        for (uint64_t bits = leaders[idx]; bits != 0; bits &= bits - 1) {
+            uint32_t hw = idx * 64 + __builtin_ctzll(bits);
+            cfg->block_addr[block++] = (start + hw * 2) | thumb;
+        }
+    }
+
+    // each basic block ends either right before the next one, right before
+    // data, or with the last instruction in the range
+    for (block = 0; block < cfg->block_count; block++) {
+        uint32_t addr = cfg->block_addr[block] & ~1;
+        uint32_t next = block + 1 < cfg->block_count ?
+            cfg->block_addr[block + 1] & ~1 : start + off;
+
+        uint32_t end = addr;
+        while (end < next && !darm_data_get(&data, end)) {
+            end += step;
+        }
+        cfg->block_size[block] = end - addr;
+    }
+
+    uint32_t branch = 0;
+    for (block = 0; block < cfg->block_count; block++) {
+        uint32_t next = ((cfg->block_addr[block] & ~1) - start +
+            cfg->block_size[block]) / 2;
+        int fallthrough = 1;
+
+        cfg->edge_index[block] = cfg->edge_count;
+
+        while (branch < branch_count && branches[branch].next < next) {
+            branch++;
+        }
+
+        // does this basic block end with a control flow instruction?
+        if(branch < branch_count && branches[branch].next == next) {
+            const cfg_branch_t *b = &branches[branch++];
+
+            if(b->target != NO_TARGET && BITMAP_GET(insns, b->target)) {
+                cfg->edge_target[cfg->edge_count] = darm_cfg_block(cfg,
+                    (start + b->target * 2) | thumb);
+                cfg->edge_type[cfg->edge_count++] = E_BRANCH;
+            }
+
+            // one edge per distinct case target
+            for (uint32_t idx = 0; idx < b->case_count; idx++) {
+                int32_t target = darm_cfg_block(cfg,
+                    (start + cases[b->case_index + idx] * 2) | thumb);
+                uint32_t edge = cfg->edge_index[block];
+
+                while (edge < cfg->edge_count &&
+                        (cfg->edge_target[edge] != (uint32_t) target ||
+                         cfg->edge_type[edge] != E_CASE)) {
+                    edge++;
+                }
+
+                if(target >= 0 && edge == cfg->edge_count) {
+                    cfg->edge_target[cfg->edge_count] = target;
+                    cfg->edge_type[cfg->edge_count++] = E_CASE;
+                }
+            }
+
+            fallthrough = b->cond;
+        }
+
+        // the next block only follows this one if there's no data, e.g., a
+        // literal pool, in between
+        if(fallthrough != 0 && block + 1 < cfg->block_count &&
+                cfg->block_addr[block + 1] ==
+                cfg->block_addr[block] + cfg->block_size[block]) {
+            cfg->edge_target[cfg->edge_count] = block + 1;
+            cfg->edge_type[cfg->edge_count++] = E_FALLTHROUGH;
+        }
+    }
+
+    cfg->edge_index[cfg->block_count] = cfg->edge_count;
+
+    free(insns);
+    free(leaders);
+    free(branches);
+    free(cases);
+    darm_data_free(&data);
+    return 0;
+
+error:
+    free(insns);
+    free(leaders);
+    free(branches);
+    free(cases);
+    darm_data_free(&data);
+    darm_cfg_free(cfg);
+    return -1;
+}
+
+void darm_cfg_free(darm_cfg_t *cfg)
+{
+    free(cfg->block_addr);
+    free(cfg->block_size);
+    free(cfg->edge_index);
+    free(cfg->edge_target);
+    free(cfg->edge_type);
+    memset(cfg, 0, sizeof(darm_cfg_t));
+}
+#undef NO_TARGET
+
+// ---- darm.c ----
+
+#include <stdio.h>
+#include <ctype.h>
+#include <stdint.h>
+#include <string.h>
+
+#define APPEND(out, ptr) \
+    do { \
+        const char *p = ptr; \
+        if(p != NULL) while (*p != 0) *out++ = *p++; \
+    } while (0);
+
+static int _utoa(unsigned int value, char *out, int base)
+{
+    char buf[30]; unsigned int i, counter = 0;
+
+    if(value == 0) {
+        buf[counter++] = '0';
+    }
+
+    for (; value != 0; value /= base) {
+        buf[counter++] = "0123456789abcdef"[value % base];
+    }
+
+    for (i = 0; i < counter; i++) {
+        out[i] = buf[counter - i - 1];
+    }
+
+    return counter;
+}
+
+static int _append_imm(char *arg, uint32_t imm)
+{
+    const char *start = arg;
+    if(imm > 0x1000) {
+        *arg++ = '0';
+        *arg++ = 'x';
+        arg += _utoa(imm, arg, 16);
+    }
+    else {
+        arg += _utoa(imm, arg, 10);
+    }
+    return arg - start;
+}
+
+void darm_init(darm_t *d)
+{
+    // initialize the entire darm state in order to make sure that no members
+    // contain undefined data
+    memset(d, 0, sizeof(darm_t));
+    d->instr = I_INVLD;
+    d->instr_type = T_INVLD;
+    d->shift_type = S_INVLD;
+    d->S = d->E = d->U = d->H = d->P = d->I = B_INVLD;
+    d->R = d->T = d->W = d->M = d->N = d->B = B_INVLD;
+    d->Rd = d->Rn = d->Rm = d->Ra = d->Rt = R_INVLD;
+    d->Rt2 = d->RdHi = d->RdLo = d->Rs = R_INVLD;
+    d->option = O_INVLD;
+    // TODO set opc and coproc? to what value?
+    d->CRn = d->CRm = d->CRd = R_INVLD;
+    d->firstcond = C_INVLD, d->mask = 0;
+}
+
+#define REGBIT(reg) ((reg) != R_INVLD ? 1 << (reg) : 0)
+
+// does this instruction write back to the base register Rn
+static int _writeback(const darm_t *d, uint32_t rules)
+{
+    // pre-indexed with write-back, or post-indexed addressing
+    if((rules & RR_WRITEBACK) && (d->W == B_SET || d->P == B_UNSET)) {
+        return 1;
+    }
+
+    // the 16-bit thumb LDM only writes back if Rn is not in the list, and
+    // STM always writes back
+    return d->instr_type == T_THUMB_RW_REG &&
+        (d->instr == I_STM || ((d->reglist >> d->Rn) & 1) == 0);
+}
+
+void darm_regs_update(darm_t *d)
+{
+    uint32_t rules = d->instr < I_INSTRCNT ? darm_regrules[d->instr] : 0;
+    uint32_t r = 0, w = 0;
+
+    // operands that are always read
+    r |= REGBIT(d->Rn) | REGBIT(d->Rm) | REGBIT(d->Ra) | REGBIT(d->Rs);
+
+    if(d->Rd != R_INVLD) {
+        if(rules & RR_RD_READ) r |= REGBIT(d->Rd);
+        if((rules & RR_RD_NONE) == 0) w |= REGBIT(d->Rd);
+    }
+
+    // the second register of a doubleword transfer might be implicit
+    darm_reg_t Rt2 = d->Rt2;
+    if(Rt2 == R_INVLD && d->Rt != R_INVLD && (rules & RR_RT_PAIR)) {
+        Rt2 = (darm_reg_t)((d->Rt + 1) & b1111);
+    }
+
+    if(rules & RR_RT_WRITE) w |= REGBIT(d->Rt); else r |= REGBIT(d->Rt);
+    if(rules & RR_RT2_WRITE) w |= REGBIT(Rt2); else r |= REGBIT(Rt2);
+
+    w |= REGBIT(d->RdHi) | REGBIT(d->RdLo);
+    if(rules & RR_HILO_READ) r |= REGBIT(d->RdHi) | REGBIT(d->RdLo);
+
+    if(rules & RR_LIST_WRITE) w |= d->reglist; else r |= d->reglist;
+
+    if(_writeback(d, rules) != 0) w |= REGBIT(d->Rn);
+
+    if(rules & RR_SP) r |= 1 << SP, w |= 1 << SP;
+    if(rules & RR_LR_WRITE) w |= 1 << LR;
+    if(rules & RR_PC_WRITE) w |= 1 << PC;
+
+    // direct branches and ARM's ADR are relative to the pc
+    if((rules & RR_PC_REL) && d->I == B_SET && d->Rn == R_INVLD) {
+        r |= 1 << PC;
+    }
+
+    d->regs_read = r;
+    d->regs_written = w;
+}
+
+// flags that are read by each condition code
+static const uint8_t g_cond_flags[16] = {
+    APSR_Z, APSR_Z, APSR_C, APSR_C, APSR_N, APSR_N, APSR_V, APSR_V,
+    APSR_C | APSR_Z, APSR_C | APSR_Z, APSR_N | APSR_V, APSR_N | APSR_V,
+    APSR_N | APSR_Z | APSR_V, APSR_N | APSR_Z | APSR_V, 0, 0,
+};
+
+uint32_t darm_flags_read(const darm_t *d)
+{
+    uint32_t sem = d->instr < I_INSTRCNT ? darm_semrules[d->instr] : 0;
+    uint32_t ret = d->cond != C_INVLD ? g_cond_flags[d->cond & b1111] : 0;
+
+    if(sem & SEM_READS_C) ret |= APSR_C;
+    if(sem & SEM_READS_NZCV) ret |= APSR_NZCV;
+    return ret;
+}
+
+uint32_t darm_flags_written(const darm_t *d)
+{
+    uint32_t sem = d->instr < I_INSTRCNT ? darm_semrules[d->instr] : 0;
+    int sets_flags = d->S == B_SET || (sem & SEM_FLAGS_ALWAYS) != 0;
+
+    // most 16-bit thumb data-processing instructions set the flags without
+    // having an S bit, unless they're inside an IT block (see darm_it_apply)
+    switch ((uint32_t) d->instr_type) {
+    case T_THUMB_SHIFT_IMM: case T_THUMB_GPI: case T_THUMB_HAS_IMM8:
+    case T_THUMB_3REG: case T_THUMB_2REG_IMM:
+        sets_flags |= d->S == B_INVLD;
+        break;
+    }
+
+    if(sets_flags == 0) return 0;
+
+    return (sem & SEM_WRITES_NZ ? APSR_N | APSR_Z : 0) |
+        (sem & SEM_WRITES_C ? APSR_C : 0) |
+        (sem & SEM_WRITES_V ? APSR_V : 0);
+}
+
+int darm_mem(const darm_t *d, darm_mem_t *mem)
+{
+    uint32_t sem = d->instr < I_INSTRCNT ? darm_semrules[d->instr] : 0;
+    uint32_t rules = d->instr < I_INSTRCNT ? darm_regrules[d->instr] : 0;
+
+    memset(mem, 0, sizeof(darm_mem_t));
+    if((sem & (SEM_LOAD | SEM_STORE)) == 0) return -1;
+
+    // literal loads don't always have Rn set, and neither do PUSH and POP
+    mem->base = d->Rn != R_INVLD ? d->Rn : rules & RR_SP ? SP : PC;
+
+    mem->offset_kind = M_NONE;
+    mem->index = R_INVLD;
+    mem->shift_type = S_INVLD;
+
+    if(d->I == B_SET) {
+        mem->offset_kind = M_IMM;
+        mem->offset = d->U == B_UNSET ? -(int32_t) d->imm : (int32_t) d->imm;
+    }
+    else if(d->Rm != R_INVLD) {
+        mem->offset_kind = M_REG;
+        mem->index = d->Rm;
+        mem->shift_type = d->shift_type;
+        mem->shift = d->shift;
+        mem->subtract = d->U == B_UNSET;
+    }
+
+    mem->size = sem & SEM_BYTE ? 1 : sem & SEM_HALF ? 2 : 4;
+    mem->count = 1;
+
+    if(sem & SEM_DUAL) {
+        mem->count = 2;
+    }
+    // the single register PUSH and POP have an empty register list
+    else if((sem & SEM_MULTI) && d->reglist != 0) {
+        mem->count = __builtin_popcount(d->reglist);
+    }
+
+    mem->load = (sem & SEM_LOAD) != 0;
+    mem->store = (sem & SEM_STORE) != 0;
+    mem->sign_extend = (sem & SEM_SIGNED) != 0;
+    mem->exclusive = (sem & SEM_EXCLUSIVE) != 0;
+    mem->writeback = (rules & RR_SP) != 0 || _writeback(d, rules) != 0;
+    mem->post_index = d->P == B_UNSET;
+    return 0;
+}
+
+int darm_disasm(darm_t *d, uint16_t w, uint16_t w2, uint32_t addr)
+{
+    return darm_disasm_inline(d, w, w2, addr);
+}
+
+int darm_disasm_buf(darm_t *d, const uint8_t *buf, uint32_t len,
+    uint32_t addr)
+{
+    if(len < 2) return 0;
+
+    // instructions are stored in little endian, as halfwords for Thumb and
+    // Thumb2, and as words for ARMv7
+    uint16_t w = buf[0] | (buf[1] << 8), w2 = 0;
+    if(len >= 4) {
+        w2 = buf[2] | (buf[3] << 8);
+    }
+
+    int ret = darm_disasm_inline(d, w, w2, addr);
+    return (uint32_t) ret * 2 > len ? 0 : ret;
+}
+
+void darm_it_init(darm_it_t *it)
+{
+    it->state = 0;
+}
+
+void darm_it_apply(darm_it_t *it, darm_t *d, int ret)
+{
+    // outside of an IT block, only an IT instruction starts a new one
+    if((it->state & b1111) == 0) {
+        if(ret != 0 && d->instr == I_IT) {
+            it->state = (d->firstcond << 4) | d->mask;
+        }
+        return;
+    }
+
+    if(ret != 0) {
+        d->cond = (darm_cond_t)(it->state >> 4);
+
+        // 16-bit instructions don't update the flags inside an IT block
+        if(d->S == B_INVLD) {
+            d->S = B_UNSET;
+        }
+    }
+
+    // advance to the next instruction, the low bit of the condition is
+    // shifted in from the mask
+    if((it->state & b111) == 0) {
+        it->state = 0;
+    }
+    else {
+        it->state = (it->state & 0xe0) | ((it->state << 1) & b11111);
+    }
+}
+
+int darm_disasm_it(darm_it_t *it, darm_t *d, uint16_t w, uint16_t w2,
+    uint32_t addr)
+{
+    int ret = darm_disasm(d, w, w2, addr);
+
+    // there are no IT blocks in ARMv7 mode
+    if((addr & 1) == 0) {
+        it->state = 0;
+        return ret;
+    }
+
+    darm_it_apply(it, d, ret);
+    return ret;
+}
+
+int darm_branch_target(const darm_t *d, uint32_t pc, uint32_t *target,
+    int *target_is_thumb)
+{
+    // just like darm_disasm, the least significant bit of the address
+    // specifies whether this is a Thumb or Thumb2 instruction
+    int thumb = pc & 1;
+    pc &= ~1;
+
+    switch ((uint32_t) d->instr) {
+    case I_B: case I_BL: case I_CBZ: case I_CBNZ:
+        // every decoder stores the offset already sign-extended and
+        // multiplied, so all that's left is the pipeline offset of the pc
+        if(d->I != B_SET) return -1;
+
+        *target = pc + (thumb ? 4 : 8) + d->imm;
+        if(target_is_thumb != NULL) {
+            *target_is_thumb = thumb;
+        }
+        return 0;
+
+    case I_BLX:
+        // the register form of BLX has no static target
+        if(d->H == B_INVLD) return -1;
+
+        // BLX always switches the instruction set, for Thumb2 the target
+        // is relative to Align(pc, 4), for ARMv7 the H bit has already
+        // been merged into the immediate
+        if(thumb != 0) {
+            *target = ((pc + 4) & ~3) + d->imm;
+        }
+        else {
+            *target = pc + 8 + d->imm;
+        }
+        if(target_is_thumb != NULL) {
+            *target_is_thumb = !thumb;
+        }
+        return 0;
+
+    default:
+        return -1;
+    }
+}
+
+uint32_t darm_branch_targets(const darm_t *d, const uint32_t *pc,
+    uint32_t count, uint32_t *targets, int8_t *target_is_thumb)
+{
+    uint32_t ret = 0;
+
+    for (uint32_t idx = 0; idx < count; idx++) {
+        int thumb;
+        if(darm_branch_target(&d[idx], pc[idx], &targets[idx], &thumb) < 0) {
+            targets[idx] = 0;
+            target_is_thumb[idx] = -1;
+            continue;
+        }
+
+        target_is_thumb[idx] = thumb;
+        ret++;
+    }
+    return ret;
+}
+
+int darm_str(const darm_t *d, darm_str_t *str)
+{
+    if(d->instr == I_INVLD || d->instr >= ARRAYSIZE(darm_mnemonics)) {
+        return -1;
+    }
+
+    // the format string index
+    uint32_t idx = 0;
+
+    // the offset in the format string
+    uint32_t off = 0;
+
+    // argument index
+    uint32_t arg = 0;
+
+    // pointers to the arguments
+    char *args[] = {
+        str->arg[0], str->arg[1], str->arg[2],
+        str->arg[3], str->arg[4], str->arg[5],
+    };
+
+    // ptr to the output mnemonic
+    char *mnemonic = str->mnemonic;
+    APPEND(mnemonic, darm_mnemonic_name(d->instr));
+
+    char *shift = str->shift;
+
+    // there are a couple of instructions in the Thumb instruction set which
+    // do not have an equivalent in ARMv7, hence they'll not have an ARMv7
+    // format string - we handle these instructions in a hacky way for now..
+    switch (d->instr) {
+    case I_CPS:
+        // TODO
+        return -1;
+
+    case I_IT:
+        // each of the following instructions is either a then or an else,
+        // depending on whether its mask bit equals the lowest bit of
+        // firstcond, the lowest set bit of the mask terminates the list
+        for (uint32_t bit = 3; (d->mask & ((1 << bit) - 1)) != 0; bit--) {
+            *mnemonic++ = ((d->mask >> bit) & 1) == (d->firstcond & 1) ?
+                'T' : 'E';
+        }
+        APPEND(args[arg], darm_condition_name(d->firstcond, 0));
+        arg++;
+        goto finalize;
+
+    case I_CBZ:
+    case I_CBNZ:
+        APPEND(args[arg], darm_register_name(d->Rn));
+        arg++;
+        APPEND(args[arg], "#+");
+        args[arg] += _append_imm(args[arg], d->imm);
+        goto finalize;
+
+    default:
+        break;
+    }
+
+    const char **ptrs = armv7_format_strings[d->instr];
+    if(ptrs[0] == NULL) return -1;
+
+    for (char ch; (ch = ptrs[idx][off]) != 0; off++) {
+        switch (ch) {
+        case 's':
+            if(d->S == B_SET) {
+                *mnemonic++ = 'S';
+            }
+            continue;
+
+        case 'c':
+            APPEND(mnemonic, darm_condition_name(d->cond, 1));
+            continue;
+
+        case 'd':
+            if(d->Rd == R_INVLD) break;
+            APPEND(args[arg], darm_register_name(d->Rd));
+            arg++;
+            continue;
+
+        case 'n':
+            if(d->Rn == R_INVLD) break;
+            APPEND(args[arg], darm_register_name(d->Rn));
+            arg++;
+            continue;
+
+        case 'm':
+            if(d->Rm == R_INVLD) break;
+            APPEND(args[arg], darm_register_name(d->Rm));
+            arg++;
+            continue;
+
+        case 'a':
+            if(d->Ra == R_INVLD) break;
+            APPEND(args[arg], darm_register_name(d->Ra));
+            arg++;
+            continue;
+
+        case 't':
+            if(d->Rt == R_INVLD) break;
+            APPEND(args[arg], darm_register_name(d->Rt));
+            arg++;
+            continue;
+
+        case '2':
+            // first check if Rt2 is actually set
+            if(d->Rt2 != R_INVLD) {
+                APPEND(args[arg], darm_register_name(d->Rt2));
+                arg++;
+                continue;
+            }
+            // for some instructions, Rt2 = Rt + 1
+            else if(d->Rt != R_INVLD) {
+                APPEND(args[arg], darm_register_name(d->Rt + 1));
+                arg++;
+                continue;
+            }
+            break;
+
+        case 'h':
+            if(d->RdHi == R_INVLD) break;
+            APPEND(args[arg], darm_register_name(d->RdHi));
+            arg++;
+            continue;
+
+        case 'l':
+            if(d->RdLo == R_INVLD) break;
+            APPEND(args[arg], darm_register_name(d->RdLo));
+            arg++;
+            continue;
+
+        case 'i':
+            // check if an immediate has been set
+            if(d->I != B_SET) break;
+
+            *args[arg]++ = '#';
+            args[arg] += _append_imm(args[arg], d->imm);
+            arg++;
+            continue;
+
+        case 'S':
+            // is there even a shift?
+            if(d->shift_type == S_INVLD) continue;
+
+            if(d->P == B_SET) {
+                // we're still inside the memory address
+                shift = args[arg] - 1;
+                *shift++ = ',';
+                *shift++ = ' ';
+            }
+
+            if(d->Rs == R_INVLD) {
+                const char *type; uint32_t imm;
+                if(darm_immshift_decode(d, &type, &imm) == 0) {
+                    switch (d->instr) {
+                    case I_LSL: case I_LSR: case I_ASR:
+                    case I_ROR: case I_RRX:
+                        break;
+
+                    default:
+                        APPEND(shift, type);
+                        *shift++ = ' ';
+                    }
+                    *shift++ = '#';
+                    shift += _utoa(imm, shift, 10);
+                }
+                else if(d->P == B_SET) {
+                    // we're still in the memory address, but there was
+                    // no shift, so we have to revert the shift pointer so
+                    // it will write a closing bracket again
+                    shift -= 2;
+                }
+            }
+            else {
+                APPEND(shift, darm_shift_type_name(d->shift_type));
+                *shift++ = ' ';
+                APPEND(shift, darm_register_name(d->Rs));
+            }
+
+            if(d->P == B_SET) {
+                // close the memory address
+                *shift++ = ']';
+
+                // reset shift
+                args[arg] = shift;
+                shift = str->shift;
+            }
+            continue;
+
+        case '!':
+            if(d->W == B_SET) {
+                *args[arg-1]++ = '!';
+            }
+            continue;
+
+        case 'e':
+            args[arg] += _utoa(d->E, args[arg], 10);
+            continue;
+
+        case 'x':
+            if(d->M == B_SET) {
+                *mnemonic++ = 'x';
+            }
+            continue;
+
+        case 'X':
+            // if the flags are not set, then this instruction doesn't take
+            // the (B|T)(B|T) postfix
+            if(d->N == B_INVLD || d->M == B_INVLD) break;
+
+            *mnemonic++ = d->N == B_SET ? 'T' : 'B';
+            *mnemonic++ = d->M == B_SET ? 'T' : 'B';
+            continue;
+
+        case 'R':
+            if(d->R == B_SET) {
+                *mnemonic++ = 'R';
+            }
+            continue;
+
+        case 'T':
+            APPEND(mnemonic, d->T == B_SET ? "TB" : "BT");
+            continue;
+
+        case 'r':
+            if(d->reglist != 0) {
+                args[arg] += darm_reglist(d->reglist, args[arg]);
+            }
+            else {
+                *args[arg]++ = '{';
+                APPEND(args[arg], darm_register_name(d->Rt));
+                *args[arg]++ = '}';
+            }
+            continue;
+
+        case 'L':
+            *args[arg]++ = '#';
+            args[arg] += _utoa(d->lsb, args[arg], 10);
+            arg++;
+            continue;
+
+        case 'w':
+            *args[arg]++ = '#';
+            args[arg] += _utoa(d->width, args[arg], 10);
+            arg++;
+            continue;
+
+        case 'o':
+            *args[arg]++ = '#';
+            args[arg] += _utoa(d->option, args[arg], 10);
+            arg++;
+            continue;
+
+        case 'B':
+            *args[arg]++ = '[';
+            APPEND(args[arg], darm_register_name(d->Rn));
+
+            // if post-indexed or the index is not even set, then we close
+            // the memory address
+            if(d->P != B_SET) {
+                *args[arg++]++ = ']';
+            }
+            else {
+                *args[arg]++ = ',';
+                *args[arg]++ = ' ';
+            }
+            continue;
+
+        case 'O':
+            // if the Rm operand is set, then this is about the Rm operand,
+            // otherwise it's about the immediate
+            if(d->Rm != R_INVLD) {
+
+                // negative offset
+                if(d->U == B_UNSET) {
+                    *args[arg]++ = '-';
+                }
+
+                APPEND(args[arg], darm_register_name(d->Rm));
+
+                // if post-indexed this was a stand-alone operator one
+                if(d->P == B_UNSET) {
+                    arg++;
+                }
+            }
+            // if there's an immediate, append it
+            else if(d->imm != 0) {
+                // negative offset?
+                APPEND(args[arg], d->U == B_UNSET ? "#-" : "#");
+                args[arg] += _append_imm(args[arg], d->imm);
+            }
+            else {
+                // there's no immediate, so we have to remove the ", " which
+                // was introduced by the base register of the memory address
+                args[arg] -= 2;
+            }
+
+            // if pre-indexed, close the memory address, but don't increase
+            // arg so we can alter it in the shift handler
+            if(d->P == B_SET) {
+                *args[arg]++ = ']';
+
+                // if pre-indexed and write-back, then add an exclamation mark
+                if(d->W == B_SET) {
+                    *args[arg]++ = '!';
+                }
+            }
+            continue;
+
+        case 'b':
+            // BLX first checks for branch and only then for the conditional
+            // version which takes the Rm as operand, so let's see if the
+            // branch stuff has been initialized yet
+            if(d->instr == I_BLX && d->H == B_INVLD) break;
+
+            // check whether the immediate is negative
+            int32_t imm = d->imm;
+            if(imm < 0 && imm >= -0x1000) {
+                APPEND(args[arg], "#+-");
+                imm = -imm;
+            }
+            else if(d->U == B_UNSET) {
+                APPEND(args[arg], "#+-");
+            }
+            else {
+                APPEND(args[arg], "#+");
+            }
+            args[arg] += _append_imm(args[arg], imm);
+            continue;
+
+        case 'M':
+            *args[arg]++ = '[';
+            APPEND(args[arg], darm_register_name(d->Rn));
+
+            // if the Rm operand is defined, then we use that optionally with
+            // a shift, otherwise there might be an immediate value as offset
+            if(d->Rm != R_INVLD) {
+                APPEND(args[arg], ", ");
+                APPEND(args[arg], darm_register_name(d->Rm));
+
+                const char *type; uint32_t imm;
+                if(darm_immshift_decode(d, &type, &imm) == 0) {
+                    APPEND(args[arg], ", ");
+                    APPEND(args[arg], type);
+                    APPEND(args[arg], " #");
+                    args[arg] += _utoa(imm, args[arg], 10);
+                }
+            }
+            else if(d->imm != 0) {
+                APPEND(args[arg], ", ");
+
+                // negative offset?
+                APPEND(args[arg], d->U == B_UNSET ? "#-" : "#");
+                args[arg] += _append_imm(args[arg], d->imm);
+            }
+
+            *args[arg]++ = ']';
+
+            // if index is true and write-back is true, then we add an
+            // exclamation mark
+            if(d->P == B_SET && d->W == B_SET) {
+                *args[arg]++ = '!';
+            }
+            continue;
+
+        case 'A':
+            if(d->rotate != 0) {
+                APPEND(args[arg], "ROR #");
+                args[arg] += _utoa(d->rotate, args[arg], 10);
+            }
+            continue;
+
+        case 'C':
+            args[arg] += _utoa(d->coproc, args[arg], 10);
+            arg++;
+            continue;
+
+        case 'p':
+            args[arg] += _utoa(d->opc1, args[arg], 10);
+            arg++;
+            continue;
+
+        case 'P':
+            args[arg] += _utoa(d->opc2, args[arg], 10);
+            arg++;
+            continue;
+
+        case 'N':
+            APPEND(args[arg], "cr");
+            args[arg] += _utoa(d->CRn, args[arg], 10);
+            arg++;
+            continue;
+
+        case 'J':
+            APPEND(args[arg], "cr");
+            args[arg] += _utoa(d->CRm, args[arg], 10);
+            arg++;
+            continue;
+
+        case 'I':
+            APPEND(args[arg], "cr");
+            args[arg] += _utoa(d->CRd, args[arg], 10);
+            arg++;
+            continue;
+
+        default:
+            return -1;
+        }
+
+        if(ptrs[++idx] == NULL || idx == 3) return -1;
+        off--;
+    }
+
+finalize:
+
+    *mnemonic = *shift = 0;
+    *args[0] = *args[1] = *args[2] = *args[3] = *args[4] = *args[5] = 0;
+
+    char *instr = str->total;
+    APPEND(instr, str->mnemonic);
+
+    for (int i = 0; i < 6 && args[i] != str->arg[i]; i++) {
+        if(i != 0) *instr++ = ',';
+        *instr++ = ' ';
+        APPEND(instr, str->arg[i]);
+    }
+
+    if(shift != str->shift) {
+        *instr++ = ',';
+        *instr++ = ' ';
+        APPEND(instr, str->shift);
+    }
+
+    *instr = 0;
+    return 0;
+}
+
+int darm_str2(const darm_t *d, darm_str_t *str, int lowercase)
+{
+    if(darm_str(d, str) < 0) {
+        return -1;
+    }
+
+    if(lowercase != 0) {
+        // just lowercase the entire object, including null-bytes
+        char *buf = (char *) str;
+        for (uint32_t i = 0; i < sizeof(darm_str_t); i++) {
+            buf[i] = tolower(buf[i]);
+        }
+    }
+    return 0;
+}
+
+int darm_reglist(uint16_t reglist, char *out)
+{
+    char *base = out;
+
+    if(reglist == 0) return -1;
+
+    *out++ = '{';
+
+    while (reglist != 0) {
+        // count trailing zero's
+        int32_t reg, start = __builtin_ctz(reglist);
+
+        // most registers have length two
+        *(uint16_t *) out = *(uint16_t *) darm_registers[start];
+        out[2] = darm_registers[start][2];
+        out += 2 + (out[2] != 0);
+
+        for (reg = start; reg == __builtin_ctz(reglist); reg++) {
+            // unset this bit
+            reglist &= ~(1 << reg);
+        }
+
+        // if reg is not start + 1, then this means that a series of
+        // consecutive registers have been identified
+        if(reg != start + 1) {
+            // if reg is start + 2, then this means that two consecutive
+            // registers have been found, but we prefer the notation
+            // {r0,r1} over {r0-r1} in that case
+            *out++ = reg == start + 2 ? ',' : '-';
+            *(uint16_t *) out = *(uint16_t *) darm_registers[reg-1];
+            out[2] = darm_registers[reg-1][2];
+            out += 2 + (out[2] != 0);
+        }
+        *out++ = ',';
+    }
+
+    out[-1] = '}';
+    *out = 0;
+    return out - base;
+}
+
+void darm_dump(const darm_t *d)
+{
+    printf(
+        "encoded:       0x%08x\n"
+        "instr:         I_%s\n"
+        "instr-type:    T_%s\n",
+        d->w, darm_mnemonic_name(d->instr),
+        darm_enctype_name(d->instr_type));
+
+    if(d->cond == C_UNCOND) {
+        printf("cond:          unconditional\n");
+    }
+    else if(d->cond != C_INVLD) {
+        printf("cond:          C_%s\n", darm_condition_name(d->cond, 0));
+    }
+
+#define PRINT_REG(reg) if(d->reg != R_INVLD) \
+    printf("%-5s          %s\n", #reg ":", darm_register_name(d->reg))
+
+    PRINT_REG(Rd);
+    PRINT_REG(Rn);
+    PRINT_REG(Rm);
+    PRINT_REG(Ra);
+    PRINT_REG(Rt);
+    PRINT_REG(Rt2);
+    PRINT_REG(RdHi);
+    PRINT_REG(RdLo);
+
+    if(d->I == B_SET) {
+        printf("imm:           0x%08x  %d\n", d->imm, d->imm);
+    }
+
+#define PRINT_FLAG(flag, comment, comment2) if(d->flag != B_INVLD) \
+    printf("%s:             %d   (%s)\n", #flag, d->flag, \
+        d->flag == B_SET ? comment : comment2)
+
+    PRINT_FLAG(B, "swap one byte", "swap four bytes");
+    PRINT_FLAG(S, "updates conditional flag",
+        "does NOT update conditional flags");
+    PRINT_FLAG(E, "change to big endian", "change to little endian");
+    PRINT_FLAG(U, "add offset to address", "subtract offset from address");
+    PRINT_FLAG(H, "Thumb2 instruction is two-byte aligned",
+        "Thumb2 instruction is four-byte aligned");
+    PRINT_FLAG(P, "pre-indexed addressing", "post-indexed addressing");
+    PRINT_FLAG(M, "take the top halfword as source",
+        "take the bottom halfword as source");
+    PRINT_FLAG(N, "take the top halfword as source",
+        "take the bottom halfword as source");
+    PRINT_FLAG(T, "PKHTB form", "PKHBT form");
+    PRINT_FLAG(R, "round the result", "do NOT round the result");
+    PRINT_FLAG(W, "write-back", "do NOT write-back");
+    PRINT_FLAG(I, "immediate present", "no immediate present");
+
+    if(d->option != O_INVLD) {
+        printf("option:        %d\n", d->option);
+    }
+
+    if(d->rotate != 0) {
+        printf("rotate:        %d\n", d->rotate);
+    }
+
+    if(d->shift_type != S_INVLD) {
+        if(d->Rs == R_INVLD) {
+            printf(
+                "type:          %s (shift type)\n"
+                "shift:         %-2d  (shift constant)\n",
+                darm_shift_type_name(d->shift_type), d->shift);
+        }
+        else {
+            printf(
+                "type:          %s (shift type)\n"
+                "Rs:            %s  (register-shift)\n",
+                darm_shift_type_name(d->shift_type),
+                darm_register_name(d->Rs));
+        }
+    }
+
+    if(d->lsb != 0 || d->width != 0) {
+        printf(
+            "lsb:           %d\n"
+            "width:         %d\n",
+            d->lsb, d->width);
+    }
+
+    if(d->reglist != 0) {
+        char reglist[64];
+        darm_reglist(d->reglist, reglist);
+        printf("reglist:       %s\n", reglist);
+    }
+    if (d->sat_imm != 0) {
+        printf("sat_imm:           0x%08x  %d\n", d->sat_imm, d->sat_imm);
+    }
+
+    if(d->opc1 != 0 || d->opc2 != 0 || d->coproc != 0) {
+        printf("opc1:          %d\n", d->opc1);
+        printf("opc2:          %d\n", d->opc2);
+        printf("coproc:        %d\n", d->coproc);
+    }
+    PRINT_REG(CRn);
+    PRINT_REG(CRm);
+    PRINT_REG(CRd);
+
+    printf("\n");
+}
+#undef APPEND
+#undef REGBIT
+#undef PRINT_REG
+#undef PRINT_FLAG
+
+// ---- data.c ----
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+int darm_data_init(darm_data_t *dd, uint32_t base, uint32_t len)
+{
+    memset(dd, 0, sizeof(darm_data_t));
+    dd->base = base, dd->len = len;
+    dd->cmp_reg = R_INVLD;
+
+    dd->bitmap = calloc(BITMAP_WORDS(len / 2 + 1), sizeof(uint64_t));
+    return dd->bitmap != NULL ? 0 : -1;
+}
+
+int darm_data_set(darm_data_t *dd, uint32_t addr, uint32_t size)
+{
+    // only mark the halfwords that lie within the range, in 64-bit so that
+    // ranges near the end of the address space don't wrap around
+    uint64_t start = addr & ~1, end = ((uint64_t) addr + size + 1) & ~1;
+    uint64_t lo = dd->base, hi = (uint64_t) dd->base + dd->len;
+    int ret = 0;
+
+    if(start < lo) start = lo;
+    if(end > hi) end = hi;
+
+    for (; start < end; start += 2) {
+        BITMAP_SET(dd->bitmap, (start - lo) / 2);
+        ret = 1;
+    }
+    return ret;
+}
+
+int darm_data_mark(darm_data_t *dd, const darm_t *d, uint32_t addr)
+{
+    uint32_t thumb = addr & 1, pc = (addr & ~1) + (thumb ? 4 : 8);
+    darm_mem_t mem;
+
+    // keep track of bounds checks, e.g., cmp r0, #7
+    if(d->instr == I_CMP && d->I == B_SET) {
+        dd->cmp_reg = d->Rn, dd->cmp_imm = d->imm;
+        return 0;
+    }
+
+    // the bound no longer holds once the register is overwritten, this
+    // includes pc-relative loads such as ldr r0, [pc, #4]
+    if(dd->cmp_reg != R_INVLD && (d->regs_written >> dd->cmp_reg) & 1) {
+        dd->cmp_reg = R_INVLD;
+    }
+
+    if(darm_mem(d, &mem) < 0 || mem.base != PC) {
+        return 0;
+    }
+
+    // a table of byte or halfword offsets follows the TBB or TBH
+    if(d->instr == I_TBB || d->instr == I_TBH) {
+        if(mem.index != dd->cmp_reg || dd->cmp_imm >= DARM_JT_MAXCASES) {
+            return 0;
+        }
+
+        return darm_data_set(dd, pc, (dd->cmp_imm + 1) * mem.size);
+    }
+
+    // the literal of a pc-relative load, the pc is word-aligned for Thumb
+    if(mem.load != 0 && mem.offset_kind == M_IMM) {
+        return darm_data_set(dd, (pc & ~3) + mem.offset,
+            mem.size * mem.count);
+    }
+    return 0;
+}
+
+int darm_data_get(const darm_data_t *dd, uint32_t addr)
+{
+    uint32_t off = (addr & ~1) - dd->base;
+    if((addr & ~1) < dd->base || off >= dd->len) return 0;
+
+    return BITMAP_GET(dd->bitmap, off / 2);
+}
+
+void darm_data_free(darm_data_t *dd)
+{
+    free(dd->bitmap);
+    memset(dd, 0, sizeof(darm_data_t));
+}
+
+// ---- descent.c ----
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+int darm_rd_init(darm_rd_t *rd, const uint8_t *buf, uint32_t len,
+    uint32_t base)
+{
+    memset(rd, 0, sizeof(darm_rd_t));
+    rd->buf = buf, rd->len = len, rd->base = base;
+
+    rd->visited = calloc(BITMAP_WORDS(len / 2 + 1), sizeof(uint64_t));
+    rd->thumb = calloc(BITMAP_WORDS(len / 2 + 1), sizeof(uint64_t));
+    rd->work = malloc((rd->work_alloc = 256) * sizeof(uint32_t));
+
+    if(rd->visited == NULL || rd->thumb == NULL || rd->work == NULL ||
+            darm_data_init(&rd->data, base, len) < 0) {
+        darm_rd_free(rd);
+        return -1;
+    }
+    return 0;
+}
+
+int darm_rd_seed(darm_rd_t *rd, uint32_t addr)
+{
+    uint32_t off = (addr & ~1) - rd->base;
+
+    // ignore anything outside of the image, or addresses that have already
+    // been disassembled
+    if((addr & ~1) < rd->base || off >= rd->len ||
+            BITMAP_GET(rd->visited, off / 2)) {
+        return 0;
+    }
+
+    if(rd->work_count == rd->work_alloc) {
+        uint32_t *ptr = realloc(rd->work,
+            rd->work_alloc * 2 * sizeof(uint32_t));
+        if(ptr == NULL) return -1;
+
+        rd->work = ptr, rd->work_alloc *= 2;
+    }
+
+    rd->work[rd->work_count++] = addr;
+    return 0;
+}
+
+// follows the cases if d dispatches a switch
+static int _rd_switch(darm_rd_t *rd, const darm_t *d, uint32_t addr)
+{
+    uint32_t cases[256], *targets = cases;
+    darm_jt_t saved = rd->jt;
+
+    uint32_t count = darm_jt_step(&rd->jt, d, addr, cases, 256);
+    if(count > 256) {
+        targets = malloc(count * sizeof(uint32_t));
+        if(targets == NULL) return -1;
+
+        rd->jt = saved;
+        darm_jt_step(&rd->jt, d, addr, targets, count);
+    }
+
+    // the table holds addresses rather than instructions
+    if(count != 0 && rd->jt.table_size != 0) {
+        darm_data_set(&rd->data, rd->jt.table_addr, rd->jt.table_size);
+    }
+
+    int ret = 0;
+    for (uint32_t idx = 0; idx < count && ret == 0; idx++) {
+        ret = darm_rd_seed(rd, targets[idx]);
+    }
+
+    if(targets != cases) free(targets);
+    return ret;
+}
+
+int darm_rd_run(darm_rd_t *rd)
+{
+    darm_t d; darm_it_t it;
+
+    while (rd->work_count != 0) {
+        uint32_t addr = rd->work[--rd->work_count];
+        uint32_t thumb = addr & 1;
+
+        // branch targets are assumed to be outside of IT blocks
+        darm_it_init(&it);
+        darm_jt_init(&rd->jt, rd->buf, rd->len, rd->base);
+
+        // ARMv7 instructions have to be four-byte aligned
+        if(thumb == 0 && (addr & 3) != 0) continue;
+
+        for (addr &= ~1; addr - rd->base < rd->len; ) {
+            uint32_t off = addr - rd->base;
+            if(BITMAP_GET(rd->visited, off / 2) ||
+                    darm_data_get(&rd->data, addr)) {
+                break;
+            }
+
+            int ret = darm_disasm_buf(&d, rd->buf + off, rd->len - off,
+                addr | thumb);
+            if(ret == 0) break;
+
+            if(thumb != 0) {
+                darm_it_apply(&it, &d, ret);
+            }
+
+            darm_data_mark(&rd->data, &d, addr | thumb);
+
+            BITMAP_SET(rd->visited, off / 2);
+            if(thumb != 0) {
+                BITMAP_SET(rd->thumb, off / 2);
+            }
+            rd->insn_count++;
+
+            uint32_t target; int target_is_thumb;
+            if(darm_branch_target(&d, addr | thumb, &target,
+                    &target_is_thumb) == 0 &&
+                    darm_rd_seed(rd, target | target_is_thumb) < 0) {
+                return -1;
+            }
+
+            if(_rd_switch(rd, &d, addr | thumb) < 0) {
+                return -1;
+            }
+
+            // the path ends with any unconditional change of control flow
+            // other than a call
+            darm_flow_t flow = darm_flow(&d);
+            if(flow != F_NONE && flow != F_CALL && !darm_flow_is_cond(&d)) {
+                break;
+            }
+
+            addr += ret * 2;
+        }
+    }
+
+    return rd->insn_count;
+}
+
+int darm_rd_visited(const darm_rd_t *rd, uint32_t addr)
+{
+    uint32_t off = (addr & ~1) - rd->base;
+    if((addr & ~1) < rd->base || off >= rd->len) return 0;
+
+    // instructions might have been visited before a later load marked
+    // them as literal
+    if(BITMAP_GET(rd->visited, off / 2) == 0 ||
+            BITMAP_GET(rd->data.bitmap, off / 2) != 0) {
+        return 0;
+    }
+    return BITMAP_GET(rd->thumb, off / 2) ? 2 : 1;
+}
+
+void darm_rd_free(darm_rd_t *rd)
+{
+    free(rd->visited);
+    free(rd->thumb);
+    free(rd->work);
+    darm_data_free(&rd->data);
+    memset(rd, 0, sizeof(darm_rd_t));
+}
+
+// ---- fold.c ----
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+void darm_fold_init(darm_fold_t *f, uint32_t window)
+{
+    memset(f, 0, sizeof(darm_fold_t));
+    f->window = window != 0 ? window : 16;
+}
+
+void darm_fold_reset(darm_fold_t *f)
+{
+    f->pending = 0;
+}
+
+int darm_fold_step(darm_fold_t *f, const darm_t *d, uint32_t addr,
+    darm_const_t *out)
+{
+    uint32_t index = f->index++; int ret = 0;
+
+    // pending values which have been around for too long
+    for (uint32_t bits = f->pending; bits != 0; bits &= bits - 1) {
+        uint32_t reg = __builtin_ctz(bits);
+        if(index - f->movw_index[reg] > f->window) {
+            f->pending &= ~(1 << reg);
+        }
+    }
+
+    if(d->instr == I_MOVW) {
+        f->pending |= 1 << d->Rd;
+        f->low[d->Rd] = d->imm;
+        f->movw_addr[d->Rd] = addr;
+        f->cond[d->Rd] = d->cond;
+        f->movw_index[d->Rd] = index;
+        return 0;
+    }
+
+    // the MOVT has to execute under the same condition as the MOVW
+    if(d->instr == I_MOVT && ((f->pending >> d->Rd) & 1) != 0 &&
+            f->cond[d->Rd] == d->cond) {
+        out->movw_addr = f->movw_addr[d->Rd];
+        out->addr = addr;
+        out->reg = d->Rd;
+        out->value = (d->imm << 16) | f->low[d->Rd];
+        ret = 1;
+    }
+
+    // any other write to the register invalidates its pending value, and
+    // so does the end of the basic block
+    f->pending &= ~d->regs_written;
+
+    // calls only clobber the caller-saved registers
+    darm_flow_t flow = darm_flow(d);
+    if(flow == F_CALL) {
+        f->pending &= ~((1 << r0) | (1 << r1) | (1 << r2) | (1 << r3) |
+            (1 << r12));
+    }
+    else if(flow != F_NONE) {
+        darm_fold_reset(f);
+    }
+    return ret;
+}
+
+// ---- funcs.c ----
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct _prologue_t {
+    uint32_t        mask;
+    uint32_t        value;
+
+    // whether this pattern allocates stack space, which is only the start
+    // of a function if it doesn't follow another prologue
+    int             alloc;
+} prologue_t;
+
+// amount of instructions after a save in which a sub sp is part of the same
+// prologue, e.g., push {r4-r7, lr}; add r7, sp, #12; sub sp, sp, #8
+#define SAVE_WINDOW 3
+
+static const prologue_t g_arm_prologues[] = {
+    {0xffffe000, 0xe92d4000, 0},    // push {.., lr}
+    {0xffffffff, 0xe52de004, 0},    // str lr, [sp, #-4]!
+    {0xfffff000, 0xe24dd000, 1},    // sub sp, sp, #imm
+};
+
+// the first halfword of Thumb instructions is stored in the upper half
+static const prologue_t g_thumb_prologues[] = {
+    {0xff000000, 0xb5000000, 0},    // push {.., lr}
+    {0xffffe000, 0xe92d4000, 0},    // push.w {.., lr}
+    {0xff800000, 0xb0800000, 1},    // sub sp, #imm
+    {0xfbef8f00, 0xf1ad0d00, 1},    // sub.w sp, sp, #imm
+};
+
+void darm_funcs_init(darm_funcs_t *f)
+{
+    memset(f, 0, sizeof(darm_funcs_t));
+}
+
+int darm_funcs_add(darm_funcs_t *f, uint32_t addr)
+{
+    if(f->count == f->alloc) {
+        uint32_t alloc = f->alloc != 0 ? f->alloc * 2 : 256;
+        uint32_t *ptr = realloc(f->start, alloc * sizeof(uint32_t));
+        if(ptr == NULL) return -1;
+
+        f->start = ptr, f->alloc = alloc;
+    }
+
+    f->start[f->count++] = addr;
+    return 0;
+}
+
+static uint32_t _read32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t) p[3] << 24);
+}
+
+int darm_funcs_exidx(darm_funcs_t *f, const uint8_t *buf, uint32_t len,
+    uint32_t addr)
+{
+    if(len % 8 != 0) return -1;
+
+    for (uint32_t off = 0; off < len; off += 8) {
+        uint32_t prel31 = _read32(buf + off);
+
+        // the upper bit is reserved
+        if((prel31 >> 31) != 0) return -1;
+
+        // sign-extend the 31-bit offset
+        uint32_t start = addr + off + (prel31 | ((prel31 & (1 << 30)) << 1));
+
+        if(darm_funcs_add(f, start) < 0) return -1;
+    }
+    return 0;
+}
+
+// returns the offset up to which the prologue that starts with the save at
+// offset off continues, i.e., the SAVE_WINDOW instructions after it unless
+// the straight-line run ends earlier
+static uint32_t _save_window(const uint8_t *buf, uint32_t len,
+    uint32_t base, uint32_t thumb, uint32_t off)
+{
+    darm_t d;
+
+    for (uint32_t idx = 0; idx <= SAVE_WINDOW && off < len; idx++) {
+        int ret = darm_disasm_buf(&d, buf + off, len - off,
+            (base + off) | thumb);
+        if(ret == 0) break;
+
+        off += thumb ? ret * 2 : 4;
+        if(darm_flow(&d) != F_NONE) break;
+    }
+    return off;
+}
+
+int darm_funcs_scan(darm_funcs_t *f, const uint8_t *buf, uint32_t len,
+    uint32_t base)
+{
+    uint32_t thumb = base & 1, step = thumb ? 2 : 4;
+    base &= ~1;
+
+    const prologue_t *prologues = thumb ? g_thumb_prologues : g_arm_prologues;
+    uint32_t prologue_count = thumb ? ARRAYSIZE(g_thumb_prologues) :
+        ARRAYSIZE(g_arm_prologues);
+
+    if(len < step) return 0;
+
+    // every instruction as a 32-bit word, for Thumb this is the halfword at
+    // each offset followed by the next one
+    uint32_t count = (len - step) / step + 1;
+    uint32_t *words = malloc(count * sizeof(uint32_t));
+    if(words == NULL) return -1;
+
+    for (uint32_t idx = 0; idx < count; idx++) {
+        const uint8_t *p = buf + idx * step;
+        if(thumb == 0) {
+            words[idx] = _read32(p);
+        }
+        else {
+            uint32_t next = idx * 2 + 4 <= len ? p[2] | (p[3] << 8) : 0;
+            words[idx] = ((p[0] | (p[1] << 8)) << 16) | next;
+        }
+    }
+
+    // a sub sp before this offset belongs to the prologue of a preceding
+    // save, rather than being the start of a function
+    uint32_t window = 0;
+
+    for (uint32_t idx = 0; idx < count; idx += 64) {
+        uint64_t saves = 0, allocs = 0;
+
+        for (uint32_t pat = 0; pat < prologue_count; pat++) {
+            uint64_t bits = darm_match_block(&words[idx], count - idx,
+                prologues[pat].mask, prologues[pat].value);
+            if(prologues[pat].alloc != 0) {
+                allocs |= bits;
+            }
+            else {
+                saves |= bits;
+            }
+        }
+
+        for (uint64_t bits = saves | allocs; bits != 0; bits &= bits - 1) {
+            uint32_t bit = __builtin_ctzll(bits), off = (idx + bit) * step;
+            darm_t d;
+
+            if(((allocs >> bit) & 1) != 0 && off < window) {
+                continue;
+            }
+
+            // make sure the candidate is a valid instruction that actually
+            // writes to the stack pointer
+            if(darm_disasm_buf(&d, buf + off, len - off,
+                    (base + off) | thumb) == 0 ||
+                    ((d.regs_written >> SP) & 1) == 0) {
+                continue;
+            }
+
+            if(((saves >> bit) & 1) != 0) {
+                window = _save_window(buf, len, base, thumb, off);
+            }
+
+            if(darm_funcs_add(f, (base + off) | thumb) < 0) {
+                free(words);
+                return -1;
+            }
+        }
+    }
+
+    free(words);
+    return 0;
+}
+
+static int _funcs_cmp(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *) a, y = *(const uint32_t *) b;
+    return x < y ? -1 : x > y;
+}
+
+void darm_funcs_sort(darm_funcs_t *f)
+{
+    uint32_t count = 0;
+
+    qsort(f->start, f->count, sizeof(uint32_t), &_funcs_cmp);
+
+    // the Thumb start at the same address comes right after the ARMv7 one
+    for (uint32_t idx = 0; idx < f->count; idx++) {
+        if(count != 0 && (f->start[count-1] & ~1) == (f->start[idx] & ~1)) {
+            f->start[count-1] = f->start[idx];
+            continue;
+        }
+        f->start[count++] = f->start[idx];
+    }
+    f->count = count;
+}
+
+void darm_funcs_free(darm_funcs_t *f)
+{
+    free(f->start);
+    memset(f, 0, sizeof(darm_funcs_t));
+}
+#undef SAVE_WINDOW
+
+// ---- gadget.c ----
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// amount of bytes of which the terminators are searched at once
+#define CHUNK_SIZE 4096
+
+#define FNV_OFFSET 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+
+static const darm_pattern_t g_terminators[] = {
+    {0x0fffffff, 0x012fff1e, ISA_ARMV7, I_BX},      // bx lr
+    {0x0ffffff0, 0x012fff30, ISA_ARMV7, I_BLX},     // blx Rm
+    {0x0e508000, 0x08108000, ISA_ARMV7, I_LDM},     // ldm Rn, {.., pc}
+    {0x0fffffff, 0x049df004, ISA_ARMV7, I_POP},     // pop {pc}
+    {0xffff0000, 0x47700000, ISA_THUMB, I_BX},      // bx lr
+    {0xff870000, 0x47800000, ISA_THUMB, I_BLX},     // blx Rm
+    {0xff000000, 0xbd000000, ISA_THUMB, I_POP},     // pop {.., pc}
+    {0xffd08000, 0xe8908000, ISA_THUMB2, I_LDM},    // ldm.w Rn, {.., pc}
+    {0xffd08000, 0xe9108000, ISA_THUMB2, I_LDMDB},  // ldmdb Rn, {.., pc}
+    {0xffffffff, 0xf85dfb04, ISA_THUMB2, I_POP},    // pop.w {pc}
+};
+
+void darm_gadgets_init(darm_gadgets_t *g)
+{
+    memset(g, 0, sizeof(darm_gadgets_t));
+}
+
+static int _gadgets_grow(darm_gadgets_t *g)
+{
+    uint32_t size = g->table_size != 0 ? g->table_size * 2 : 1024;
+    uint64_t *table = calloc(size, sizeof(uint64_t));
+    if(table == NULL) return -1;
+
+    for (uint32_t idx = 0; idx < g->table_size; idx++) {
+        if(g->table[idx] == 0) continue;
+
+        uint32_t slot = g->table[idx] & (size - 1);
+        while (table[slot] != 0) {
+            slot = (slot + 1) & (size - 1);
+        }
+        table[slot] = g->table[idx];
+    }
+
+    free(g->table);
+    g->table = table, g->table_size = size;
+    return 0;
+}
+
+// adds a gadget unless there's already one with the same hash
+static int _gadgets_add(darm_gadgets_t *g, const darm_gadget_t *gadget)
+{
+    // keep the hash set at most half full
+    if(g->count * 2 >= g->table_size && _gadgets_grow(g) < 0) {
+        return -1;
+    }
+
+    uint32_t slot = gadget->hash & (g->table_size - 1);
+    while (g->table[slot] != 0) {
+        if(g->table[slot] == gadget->hash) return 0;
+        slot = (slot + 1) & (g->table_size - 1);
+    }
+
+    if(g->count == g->alloc) {
+        uint32_t alloc = g->alloc != 0 ? g->alloc * 2 : 256;
+        darm_gadget_t *p = realloc(g->gadget, alloc * sizeof(darm_gadget_t));
+        if(p == NULL) return -1;
+
+        g->gadget = p, g->alloc = alloc;
+    }
+
+    g->table[slot] = gadget->hash;
+    g->gadget[g->count++] = *gadget;
+    return 0;
+}
+
+static uint64_t _hash(uint64_t hash, const darm_t *d)
+{
+    darm_str_t str;
+
+    // instructions that can't be formatted, e.g., addw, are hashed by their
+    // encoding, otherwise the gadget would equal the one without them
+    if(darm_str2(d, &str, 1) < 0) {
+        sprintf(str.total, "(%08x)", d->w);
+    }
+
+    for (const char *p = str.total; *p != 0; p++) {
+        hash = (hash ^ (uint8_t) *p) * FNV_PRIME;
+    }
+    return (hash ^ ';') * FNV_PRIME;
+}
+
+// disassembles the instructions from offset off up to the terminator at
+// offset term, returns the amount of instructions or zero if this isn't a
+// gadget
+static uint32_t _gadget_walk(const uint8_t *buf, uint32_t len,
+    uint32_t base, uint32_t thumb, uint32_t off, uint32_t term,
+    uint32_t depth, uint64_t *hash)
+{
+    uint32_t count = 0;
+    darm_t d;
+
+    *hash = FNV_OFFSET;
+
+    // for Thumb the instruction lengths alone tell whether the walk lands on
+    // the terminator within depth instructions, so most of the candidate
+    // offsets are rejected without disassembling anything
+    if(thumb != 0) {
+        uint32_t pos = off, n = 0;
+        while (pos < term && ++n < depth) {
+            pos += darm_insn_length(buf[pos] | (buf[pos + 1] << 8), 1) * 2;
+        }
+        if(pos != term) return 0;
+    }
+
+    while (off < term) {
+        int ret = darm_disasm_buf(&d, buf + off, len - off,
+            (base + off) | thumb);
+        if(ret == 0 || darm_flow(&d) != F_NONE || ++count == depth) {
+            return 0;
+        }
+
+        *hash = _hash(*hash, &d);
+        off += thumb != 0 ? ret * 2 : 4;
+    }
+
+    if(off != term) return 0;
+
+    darm_disasm_buf(&d, buf + term, len - term, (base + term) | thumb);
+    *hash = _hash(*hash, &d);
+
+    // zero marks empty slots in the hash set
+    if(*hash == 0) *hash = 1;
+    return count + 1;
+}
+
+static int _gadgets_term(darm_gadgets_t *g, const uint8_t *buf,
+    uint32_t len, uint32_t base, uint32_t addr, uint32_t depth)
+{
+    uint32_t thumb = addr & 1, term = (addr & ~1) - base;
+    uint32_t step = thumb != 0 ? 2 : 4;
+    darm_t d;
+
+    int ret = darm_disasm_buf(&d, buf + term, len - term, addr);
+    if(ret == 0) return 0;
+
+    // make sure the terminator really is an indirect branch, e.g., with
+    // condition 0b1111 the ARMv7 patterns match other instructions
+    if(darm_flow(&d) != F_INDIRECT &&
+            (d.instr != I_BLX || d.Rm == R_INVLD)) {
+        return 0;
+    }
+
+    uint32_t size = thumb != 0 ? ret * 2 : 4;
+
+    // every preceding instruction takes at most four bytes
+    for (uint32_t back = 0; back <= (depth - 1) * 4 && back <= term;
+            back += step) {
+        darm_gadget_t gadget; uint64_t hash;
+
+        gadget.count = _gadget_walk(buf, len, base, thumb, term - back,
+            term, depth, &hash);
+        if(gadget.count == 0) {
+            // for ARMv7 every longer gadget contains this one
+            if(thumb == 0) break;
+            continue;
+        }
+
+        gadget.addr = (base + term - back) | thumb;
+        gadget.size = back + size;
+        gadget.hash = hash;
+        if(_gadgets_add(g, &gadget) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int darm_gadgets_find(darm_gadgets_t *g, const uint8_t *buf, uint32_t len,
+    uint32_t base, uint32_t start, uint32_t end, uint32_t depth)
+{
+    darm_hit_t hits[CHUNK_SIZE / 2 + CHUNK_SIZE / 4 + 1];
+
+    if(end > len) end = len;
+
+    for (uint32_t off = start; off < end; off += CHUNK_SIZE) {
+        uint32_t size = end - off < CHUNK_SIZE ? end - off : CHUNK_SIZE;
+
+        // the second halfword of a Thumb2 terminator may follow the chunk
+        uint32_t avail = len - off < size + 2 ? len - off : size + 2;
+
+        uint32_t count = darm_search(g_terminators,
+            ARRAYSIZE(g_terminators), buf + off, avail, base + off, hits,
+            ARRAYSIZE(hits));
+        if(count > ARRAYSIZE(hits)) count = ARRAYSIZE(hits);
+
+        for (uint32_t idx = 0; idx < count; idx++) {
+            if((hits[idx].addr & ~1) - base - off >= size) continue;
+
+            if(_gadgets_term(g, buf, len, base, hits[idx].addr,
+                    depth) < 0) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+int darm_gadgets_merge(darm_gadgets_t *g, const darm_gadgets_t *other)
+{
+    for (uint32_t idx = 0; idx < other->count; idx++) {
+        if(_gadgets_add(g, &other->gadget[idx]) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+void darm_gadgets_free(darm_gadgets_t *g)
+{
+    free(g->gadget);
+    free(g->table);
+    darm_gadgets_init(g);
+}
+#undef CHUNK_SIZE
+#undef FNV_OFFSET
+#undef FNV_PRIME
+
+// ---- jumptable.c ----
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+void darm_jt_init(darm_jt_t *jt, const uint8_t *buf, uint32_t len,
+    uint32_t base)
+{
+    memset(jt, 0, sizeof(darm_jt_t));
+    jt->buf = buf, jt->len = len, jt->base = base;
+    jt->reg = R_INVLD;
+}
+
+// reads an entry of size bytes from the table at addr
+static int _jt_read(const darm_jt_t *jt, uint32_t addr, uint32_t size,
+    uint32_t *value)
+{
+    uint32_t off = addr - jt->base;
+    if(addr < jt->base || off >= jt->len || jt->len - off < size) {
+        return -1;
+    }
+
+    const uint8_t *p = jt->buf + off;
+    switch (size) {
+    case 1: *value = p[0]; break;
+    case 2: *value = p[0] | (p[1] << 8); break;
+    default: *value = p[0] | (p[1] << 8) | (p[2] << 16) |
+        ((uint32_t) p[3] << 24); break;
+    }
+    return 0;
+}
+
+uint32_t darm_jt_step(darm_jt_t *jt, const darm_t *d, uint32_t addr,
+    uint32_t *targets, uint32_t max)
+{
+    uint32_t thumb = addr & 1, pc = (addr & ~1) + (thumb ? 4 : 8);
+    uint32_t table, size, count = jt->count;
+
+    if(d->instr == I_CMP && d->I == B_SET) {
+        jt->reg = d->Rn, jt->imm = d->imm, jt->count = 0;
+        return 0;
+    }
+
+    if(jt->reg == R_INVLD) return 0;
+
+    // the bounds check, bhi skips the switch for index > imm, and bhs for
+    // index >= imm
+    if(d->instr == I_B && (d->cond == C_HI || d->cond == C_CS)) {
+        if(jt->imm >= DARM_JT_MAXCASES) {
+            jt->reg = R_INVLD;
+            return 0;
+        }
+        jt->count = d->cond == C_HI ? jt->imm + 1 : jt->imm;
+        return 0;
+    }
+
+    // in ARMv7 the bounds check is usually the condition of the dispatch
+    if(count == 0 && d->cond == C_LS && jt->imm < DARM_JT_MAXCASES) {
+        count = jt->imm + 1;
+    }
+
+    int dispatch = count != 0 && d->Rm == jt->reg &&
+        (d->Rn == PC || d->instr == I_ADD);
+
+    switch (dispatch ? (uint32_t) d->instr : I_INVLD) {
+    case I_TBB: case I_TBH:
+        table = pc, size = d->instr == I_TBB ? 1 : 2;
+        break;
+
+    case I_ADD:
+        // each case is a branch instruction, starting at the pc
+        if(thumb != 0 || d->Rd != PC || d->Rn != PC ||
+                d->shift_type != S_LSL || d->shift != 2) {
+            dispatch = 0;
+            break;
+        }
+        table = 0, size = 0;
+        break;
+
+    case I_LDR:
+        if(d->Rt != PC || d->shift_type != S_LSL || d->shift != 2) {
+            dispatch = 0;
+            break;
+        }
+        table = pc & ~3, size = 4;
+        break;
+
+    default:
+        dispatch = 0;
+        break;
+    }
+
+    if(dispatch == 0) {
+        // the index register has been overwritten, or the basic block ended
+        // without a switch
+        if(((d->regs_written >> jt->reg) & 1) != 0 ||
+                (darm_flow(d) != F_NONE && !darm_flow_is_cond(d))) {
+            jt->reg = R_INVLD;
+        }
+        return 0;
+    }
+
+    // make sure the entire table is inside the image
+    if(size != 0 && (table < jt->base ||
+            (uint64_t) table - jt->base + count * size > jt->len)) {
+        jt->reg = R_INVLD;
+        return 0;
+    }
+
+    for (uint32_t idx = 0; idx < count && idx < max; idx++) {
+        if(size == 0) {
+            targets[idx] = pc + idx * 4;
+            continue;
+        }
+
+        uint32_t value = 0;
+        _jt_read(jt, table + idx * size, size, &value);
+
+        // tbb and tbh hold halfword offsets from the pc, ldr loads the
+        // address itself, including the thumb bit
+        targets[idx] = size != 4 ? (pc + value * 2) | 1 : value;
+    }
+
+    jt->table_addr = table, jt->table_size = count * size;
+    jt->reg = R_INVLD;
+    return count;
+}
+
+// ---- kernels.c ----
+
+#include <stdio.h>
+#include <stdint.h>
+
+#ifdef DARM_X86
+#include <cpuid.h>
+#endif
+
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
+static inline uint32_t _classify(uint32_t w)
+{
+    uint32_t op = (w >> 25) & 7, b4 = (w >> 4) & 1, b7 = (w >> 7) & 1;
+    uint32_t key = (op << 1) | (b4 & (b7 | (op != 0)));
+
+    if((w >> 28) == C_UNCOND) return DC_UNCOND;
+
+    return ((key & 8 ? CLASSES_HI : CLASSES_LO) >> ((key & 7) * 4)) & 15;
+}
+
+void darm_classify_scalar(const uint32_t *w, uint32_t count, uint8_t *cls)
+{
+    for (uint32_t idx = 0; idx < count; idx++) {
+        cls[idx] = _classify(w[idx]);
+    }
+}
+
+uint64_t darm_prefix_scalar(const uint8_t *buf, uint32_t count)
+{
+    uint64_t bits = 0;
+    for (uint32_t idx = 0; idx < count; idx++) {
+        uint32_t hw = buf[idx * 2] | (buf[idx * 2 + 1] << 8);
+        bits |= (uint64_t) IS_PREFIX(hw) << idx;
+    }
+    return bits;
+}
+
+uint64_t darm_match_scalar(const uint32_t *words, uint32_t count,
+    uint32_t mask, uint32_t value)
+{
+    uint64_t bits = 0;
+    for (uint32_t idx = 0; idx < count; idx++) {
+        bits |= (uint64_t)((words[idx] & mask) == value) << idx;
+    }
+    return bits;
+}
+
+void darm_bswap32_scalar(uint32_t *dst, const uint32_t *src, uint32_t count)
+{
+    for (uint32_t idx = 0; idx < count; idx++) {
+        dst[idx] = __builtin_bswap32(src[idx]);
+    }
+}
+
+void darm_bswap16_scalar(uint16_t *dst, const uint16_t *src, uint32_t count)
+{
+    for (uint32_t idx = 0; idx < count; idx++) {
+        dst[idx] = (uint16_t)((src[idx] >> 8) | (src[idx] << 8));
+    }
+}
+
+uint32_t darm_pext(uint32_t value, uint32_t mask)
+{
+#ifdef __BMI2__
+    return _pext_u32(value, mask);
+#else
+    uint32_t ret = 0;
+    for (uint32_t bit = 1; mask != 0; mask &= mask - 1, bit <<= 1) {
+        if(value & mask & -mask) {
+            ret |= bit;
+        }
+    }
+    return ret;
+#endif
+}
+
+static const darm_kernels_t g_kernels_scalar = {
+    0, &darm_classify_scalar, &darm_prefix_scalar, &darm_match_scalar,
+    &darm_bswap32_scalar, &darm_bswap16_scalar,
+};
+
+// only accessed atomically, as the first use may happen from several
+// threads at once, e.g., the gadget search of bindarm
+static const darm_kernels_t *g_kernels;
+
+uint32_t darm_cpu_features()
+{
+    uint32_t features = 0;
+
+#ifdef DARM_X86
+    uint32_t eax, ebx, ecx, edx, xcr0 = 0;
+
+    if(__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0) {
+        return 0;
+    }
+
+    // pshufb is SSSE3, which every cpu with SSE4.2 supports as well
+    if((ecx >> 20) & 1) {
+        features |= CPU_SSE42;
+    }
+
+    // the operating system has to save the ymm and zmm registers, which is
+    // checked through xgetbv, only available with osxsave
+    if((ecx >> 27) & 1) {
+        __asm__ __volatile__("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+        xcr0 = eax;
+    }
+
+    uint32_t avx = (ecx >> 28) & 1;
+
+    if(__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) == 0) {
+        return features;
+    }
+
+    if(avx != 0 && (xcr0 & 0x06) == 0x06 && (ebx >> 5) & 1) {
+        features |= CPU_AVX2;
+    }
+
+    // avx512f, avx512bw, and avx512vl, plus the opmask and zmm state
+    if((features & CPU_AVX2) != 0 && (xcr0 & 0xe0) == 0xe0 &&
+            (ebx >> 16) & 1 && (ebx >> 30) & 1 && (ebx >> 31) & 1) {
+        features |= CPU_AVX512;
+    }
+#endif
+
+    return features;
+}
+
+uint32_t darm_cpu_select(uint32_t features)
+{
+    const darm_kernels_t *kernels = &g_kernels_scalar;
+
+    features &= darm_cpu_features();
+
+#ifdef DARM_X86
+    if(features & CPU_AVX512) {
+        kernels = &darm_kernels_avx512;
+    }
+    else if(features & CPU_AVX2) {
+        kernels = &darm_kernels_avx2;
+    }
+    else if(features & CPU_SSE42) {
+        kernels = &darm_kernels_sse42;
+    }
+#endif
+
+    __atomic_store_n(&g_kernels, kernels, __ATOMIC_RELEASE);
+    return kernels->features;
+}
+
+const darm_kernels_t *darm_kernels()
+{
+    const darm_kernels_t *kernels =
+        __atomic_load_n(&g_kernels, __ATOMIC_ACQUIRE);
+
+    // concurrent first uses all select the same kernels
+    if(kernels == NULL) {
+        darm_cpu_select(~0);
+        kernels = __atomic_load_n(&g_kernels, __ATOMIC_ACQUIRE);
+    }
+    return kernels;
+}
+
+void darm_armv7_classify(const uint32_t *w, uint32_t count, uint8_t *cls)
+{
+    darm_kernels()->classify(w, count, cls);
+}
+
+void darm_bswap32(uint32_t *dst, const uint32_t *src, uint32_t count)
+{
+    darm_kernels()->bswap32(dst, src, count);
+}
+
+void darm_bswap16(uint16_t *dst, const uint16_t *src, uint32_t count)
+{
+    darm_kernels()->bswap16(dst, src, count);
+}
+
+// ---- ngram.c ----
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#define NGRAM_MAGIC "DARMNGR1"
+
+#define FNV_OFFSET 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+
+typedef struct _ngram_header_t {
+    char            magic[8];
+    uint32_t        n;
+    uint32_t        key_count;
+    uint32_t        block_count;
+    uint32_t        doc_count;
+    uint32_t        file_count;
+    uint32_t        reserved;
+    uint64_t        strings_size;
+    uint64_t        postings_size;
+} ngram_header_t;
+
+uint32_t darm_ngram_token(const darm_t *d)
+{
+    const darm_reg_t regs[] = {
+        d->Rd, d->Rn, d->Rm, d->Ra, d->Rt, d->Rt2, d->RdHi, d->RdLo, d->Rs,
+    };
+
+    // the instruction in the lower 16 bits, one bit per operand kind in
+    // the upper bits
+    uint32_t token = d->instr, bit = 16;
+    for (uint32_t idx = 0; idx < ARRAYSIZE(regs); idx++, bit++) {
+        token |= (uint32_t)(regs[idx] != R_INVLD) << bit;
+    }
+
+    token |= (uint32_t)(d->I == B_SET) << bit++;
+    token |= (uint32_t)(d->shift_type != S_INVLD) << bit++;
+    token |= (uint32_t)(d->reglist != 0) << bit++;
+    token |= (uint32_t)(d->cond != C_AL && d->cond != C_UNCOND &&
+        d->cond != C_INVLD) << bit++;
+    return token;
+}
+
+uint32_t darm_ngram_tokens(const uint8_t *buf, uint32_t len, uint32_t addr,
+    uint32_t *tokens, uint32_t max)
+{
+    uint32_t thumb = addr & 1, off = 0, count = 0;
+    darm_it_t it; darm_t d;
+
+    darm_it_init(&it);
+
+    while (count < max && off + (thumb ? 2 : 4) <= len) {
+        uint16_t w = buf[off] | (buf[off + 1] << 8), w2 = 0;
+        if(off + 4 <= len) {
+            w2 = buf[off + 2] | (buf[off + 3] << 8);
+        }
+
+        int ret = darm_disasm_it(&it, &d, w, w2, ((addr & ~1) + off) | thumb);
+        tokens[count++] = ret != 0 ? darm_ngram_token(&d) : DARM_TOKEN_INVLD;
+        off += thumb != 0 && ret != 2 ? 2 : 4;
+    }
+    return count;
+}
+
+uint32_t darm_ngram_keys(const uint32_t *tokens, uint32_t count, uint32_t n,
+    uint64_t *keys)
+{
+    if(n == 0 || count < n) return 0;
+
+    for (uint32_t idx = 0; idx + n <= count; idx++) {
+        uint64_t hash = FNV_OFFSET;
+        for (uint32_t tok = 0; tok < n; tok++) {
+            for (uint32_t byte = 0; byte < 32; byte += 8) {
+                hash = (hash ^ ((tokens[idx + tok] >> byte) & 0xff)) *
+                    FNV_PRIME;
+            }
+        }
+        keys[idx] = hash;
+    }
+    return count - n + 1;
+}
+
+void darm_ngram_builder_init(darm_ngram_builder_t *b, uint32_t n)
+{
+    memset(b, 0, sizeof(darm_ngram_builder_t));
+    b->n = n;
+}
+
+// makes room for count more elements of size bytes in the array
+static int _grow(void **ptr, uint32_t *alloc, uint32_t used, uint32_t count,
+    uint32_t size)
+{
+    if(used + count <= *alloc) return 0;
+
+    uint32_t n = *alloc != 0 ? *alloc : 64;
+    while (n < used + count) {
+        n *= 2;
+    }
+
+    void *p = realloc(*ptr, (size_t) n * size);
+    if(p == NULL) return -1;
+
+    *ptr = p, *alloc = n;
+    return 0;
+}
+
+int32_t darm_ngram_add_file(darm_ngram_builder_t *b, const char *name)
+{
+    if(_grow((void **) &b->file, &b->file_alloc, b->file_count, 1,
+            sizeof(char *)) < 0) {
+        return -1;
+    }
+
+    char *p = malloc(strlen(name) + 1);
+    if(p == NULL) return -1;
+
+    strcpy(p, name);
+    b->file[b->file_count] = p;
+    return b->file_count++;
+}
+
+int32_t darm_ngram_add_doc(darm_ngram_builder_t *b, uint32_t file,
+    uint32_t addr, const uint64_t *keys, uint32_t count)
+{
+    if(_grow((void **) &b->doc, &b->doc_alloc, b->doc_count, 1,
+            sizeof(darm_ngram_doc_t)) < 0 ||
+            _grow((void **) &b->pair, &b->pair_alloc, b->pair_count, count,
+            sizeof(darm_ngram_pair_t)) < 0) {
+        return -1;
+    }
+
+    for (uint32_t idx = 0; idx < count; idx++) {
+        b->pair[b->pair_count].key = keys[idx];
+        b->pair[b->pair_count++].doc = b->doc_count;
+    }
+
+    b->doc[b->doc_count].file = file;
+    b->doc[b->doc_count].addr = addr;
+    return b->doc_count++;
+}
+
+int darm_ngram_builder_merge(darm_ngram_builder_t *b,
+    darm_ngram_builder_t *other)
+{
+    if(_grow((void **) &b->file, &b->file_alloc, b->file_count,
+            other->file_count, sizeof(char *)) < 0 ||
+            _grow((void **) &b->doc, &b->doc_alloc, b->doc_count,
+            other->doc_count, sizeof(darm_ngram_doc_t)) < 0 ||
+            _grow((void **) &b->pair, &b->pair_alloc, b->pair_count,
+            other->pair_count, sizeof(darm_ngram_pair_t)) < 0) {
+        return -1;
+    }
+
+    for (uint32_t idx = 0; idx < other->pair_count; idx++) {
+        b->pair[b->pair_count].key = other->pair[idx].key;
+        b->pair[b->pair_count++].doc = other->pair[idx].doc + b->doc_count;
+    }
+
+    for (uint32_t idx = 0; idx < other->doc_count; idx++) {
+        b->doc[b->doc_count].file = other->doc[idx].file + b->file_count;
+        b->doc[b->doc_count++].addr = other->doc[idx].addr;
+    }
+
+    // the file names are now owned by b
+    memcpy(&b->file[b->file_count], other->file,
+        other->file_count * sizeof(char *));
+    b->file_count += other->file_count;
+    other->file_count = 0;
+
+    darm_ngram_builder_free(other);
+    return 0;
+}
+
+static int _pair_compare(const void *a, const void *b)
+{
+    const darm_ngram_pair_t *x = (const darm_ngram_pair_t *) a;
+    const darm_ngram_pair_t *y = (const darm_ngram_pair_t *) b;
+
+    if(x->key != y->key) return x->key < y->key ? -1 : 1;
+    if(x->doc != y->doc) return x->doc < y->doc ? -1 : 1;
+    return 0;
+}
+
+static uint32_t _leb128(uint8_t *out, uint32_t value)
+{
+    uint32_t len = 0;
+    do {
+        out[len++] = (value & 0x7f) | (value > 0x7f ? 0x80 : 0);
+        value >>= 7;
+    } while (value != 0);
+    return len;
+}
+
+static int _pad8(FILE *fp, uint64_t size)
+{
+    static const uint8_t zero[8];
+    return fwrite(zero, 1, -size & 7, fp) == (-size & 7) ? 0 : -1;
+}
+
+int darm_ngram_write(darm_ngram_builder_t *b, const char *fname)
+{
+    qsort(b->pair, b->pair_count, sizeof(darm_ngram_pair_t), &_pair_compare);
+
+    // unique keys, and the postings encoded in place of the pairs, as
+    // they never take more space than the pairs they're encoded from
+    uint64_t *keys = malloc((b->pair_count + 1) * sizeof(uint64_t));
+    uint64_t *offsets = malloc((b->pair_count + 1) * sizeof(uint64_t));
+    uint64_t *blocks = malloc((b->pair_count / DARM_NGRAM_BLOCK + 1) *
+        sizeof(uint64_t));
+    uint8_t *postings = (uint8_t *) b->pair;
+    uint32_t key_count = 0; uint64_t size = 0;
+
+    if(keys == NULL || offsets == NULL || blocks == NULL) {
+        free(keys), free(offsets), free(blocks);
+        return -1;
+    }
+
+    for (uint32_t idx = 0, prev = 0; idx < b->pair_count; idx++) {
+        darm_ngram_pair_t pair = b->pair[idx];
+
+        if(key_count == 0 || keys[key_count - 1] != pair.key) {
+            keys[key_count] = pair.key;
+            offsets[key_count++] = size;
+            size += _leb128(&postings[size], pair.doc);
+        }
+        else if(pair.doc != prev) {
+            size += _leb128(&postings[size], pair.doc - prev);
+        }
+        prev = pair.doc;
+    }
+    offsets[key_count] = size;
+
+    uint32_t block_count = (key_count + DARM_NGRAM_BLOCK - 1) /
+        DARM_NGRAM_BLOCK;
+    for (uint32_t idx = 0; idx < block_count; idx++) {
+        blocks[idx] = keys[idx * DARM_NGRAM_BLOCK];
+    }
+
+    ngram_header_t hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, NGRAM_MAGIC, sizeof(hdr.magic));
+    hdr.n = b->n;
+    hdr.key_count = key_count;
+    hdr.block_count = block_count;
+    hdr.doc_count = b->doc_count;
+    hdr.file_count = b->file_count;
+    hdr.postings_size = size;
+
+    uint32_t *names = malloc((b->file_count + 1) * sizeof(uint32_t));
+    for (uint32_t idx = 0; names != NULL && idx < b->file_count; idx++) {
+        names[idx] = hdr.strings_size;
+        hdr.strings_size += strlen(b->file[idx]) + 1;
+    }
+
+    FILE *fp = names != NULL ? fopen(fname, "wb") : NULL;
+    int ret = fp != NULL &&
+        fwrite(&hdr, sizeof(hdr), 1, fp) == 1 &&
+        fwrite(blocks, sizeof(uint64_t), block_count, fp) == block_count &&
+        fwrite(keys, sizeof(uint64_t), key_count, fp) == key_count &&
+        fwrite(offsets, sizeof(uint64_t), key_count + 1,
+            fp) == key_count + 1 &&
+        fwrite(b->doc, sizeof(darm_ngram_doc_t), b->doc_count,
+            fp) == b->doc_count &&
+        fwrite(names, sizeof(uint32_t), b->file_count,
+            fp) == b->file_count &&
+        _pad8(fp, b->file_count * sizeof(uint32_t)) == 0 ? 0 : -1;
+
+    for (uint32_t idx = 0; ret == 0 && idx < b->file_count; idx++) {
+        if(fwrite(b->file[idx], strlen(b->file[idx]) + 1, 1, fp) != 1) {
+            ret = -1;
+        }
+    }
+
+    if(ret == 0 && (_pad8(fp, hdr.strings_size) < 0 ||
+            fwrite(postings, 1, size, fp) != size)) {
+        ret = -1;
+    }
+
+    if(fp != NULL && fclose(fp) != 0) {
+        ret = -1;
+    }
+
+    // the pairs have been overwritten by the postings
+    b->pair_count = 0;
+
+    free(names), free(keys), free(offsets), free(blocks);
+    return ret;
+}
+
+void darm_ngram_builder_free(darm_ngram_builder_t *b)
+{
+    for (uint32_t idx = 0; idx < b->file_count; idx++) {
+        free(b->file[idx]);
+    }
+    free(b->file), free(b->doc), free(b->pair);
+    darm_ngram_builder_init(b, b->n);
+}
+
+int darm_ngram_open(darm_ngram_index_t *ix, const char *fname)
+{
+    memset(ix, 0, sizeof(darm_ngram_index_t));
+
+#ifndef _WIN32
+    int fd = open(fname, O_RDONLY);
+    if(fd < 0) return -1;
+
+    struct stat st;
+    if(fstat(fd, &st) < 0 || (uint64_t) st.st_size < sizeof(ngram_header_t)) {
+        close(fd);
+        return -1;
+    }
+
+    void *ptr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(ptr == MAP_FAILED) return -1;
+
+    // lookups jump all over the place
+    madvise(ptr, st.st_size, MADV_RANDOM);
+
+    ix->map = ptr, ix->size = st.st_size;
+#else
+    FILE *fp = fopen(fname, "rb");
+    if(fp == NULL) return -1;
+
+    fseek(fp, 0, SEEK_END);
+    long len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    uint8_t *buf = len >= (long) sizeof(ngram_header_t) ? malloc(len) : NULL;
+    if(buf != NULL && fread(buf, 1, len, fp) != (size_t) len) {
+        free(buf), buf = NULL;
+    }
+    fclose(fp);
+    if(buf == NULL) return -1;
+
+    ix->map = buf, ix->size = len;
+#endif
+
+    const ngram_header_t *hdr = (const ngram_header_t *) ix->map;
+    ix->n = hdr->n;
+    ix->key_count = hdr->key_count;
+    ix->block_count = hdr->block_count;
+    ix->doc_count = hdr->doc_count;
+    ix->file_count = hdr->file_count;
+    ix->strings_size = hdr->strings_size;
+    ix->postings_size = hdr->postings_size;
+
+    // the size of each section, rounded up to eight bytes
+    uint64_t sizes[] = {
+        sizeof(ngram_header_t),
+        (uint64_t) hdr->block_count * sizeof(uint64_t),
+        (uint64_t) hdr->key_count * sizeof(uint64_t),
+        ((uint64_t) hdr->key_count + 1) * sizeof(uint64_t),
+        (uint64_t) hdr->doc_count * sizeof(darm_ngram_doc_t),
+        ((uint64_t) hdr->file_count * sizeof(uint32_t) + 7) & ~7ULL,
+        (hdr->strings_size + 7) & ~7ULL,
+        hdr->postings_size,
+    };
+
+    uint64_t off[ARRAYSIZE(sizes) + 1] = {0};
+    for (uint32_t idx = 0; idx < ARRAYSIZE(sizes); idx++) {
+        off[idx + 1] = off[idx] + sizes[idx];
+    }
+
+    if(memcmp(hdr->magic, NGRAM_MAGIC, sizeof(hdr->magic)) != 0 ||
+            hdr->strings_size > ix->size || hdr->postings_size > ix->size ||
+            off[ARRAYSIZE(sizes)] != ix->size || hdr->block_count !=
+            (hdr->key_count + DARM_NGRAM_BLOCK - 1) / DARM_NGRAM_BLOCK) {
+        darm_ngram_close(ix);
+        return -1;
+    }
+
+    ix->block = (const uint64_t *) &ix->map[off[1]];
+    ix->keys = (const uint64_t *) &ix->map[off[2]];
+    ix->offsets = (const uint64_t *) &ix->map[off[3]];
+    ix->doc = (const darm_ngram_doc_t *) &ix->map[off[4]];
+    ix->names = (const uint32_t *) &ix->map[off[5]];
+    ix->strings = (const char *) &ix->map[off[6]];
+    ix->postings = &ix->map[off[7]];
+
+    if(ix->key_count != 0 &&
+            ix->offsets[ix->key_count] != ix->postings_size) {
+        darm_ngram_close(ix);
+        return -1;
+    }
+    return 0;
+}
+
+uint32_t darm_ngram_lookup(const darm_ngram_index_t *ix, uint64_t key,
+    uint32_t *docs, uint32_t max)
+{
+    // the last block of which the first key is at most key
+    uint32_t lo = 0, hi = ix->block_count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if(ix->block[mid] <= key) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    if(lo == 0) return 0;
+
+    uint32_t idx = (lo - 1) * DARM_NGRAM_BLOCK;
+    uint32_t end = idx + DARM_NGRAM_BLOCK < ix->key_count ?
+        idx + DARM_NGRAM_BLOCK : ix->key_count;
+
+    while (idx < end && ix->keys[idx] < key) {
+        idx++;
+    }
+    if(idx == end || ix->keys[idx] != key) return 0;
+
+    uint64_t off = ix->offsets[idx], stop = ix->offsets[idx + 1];
+    uint32_t count = 0, doc = 0;
+
+    while (off < stop) {
+        uint32_t value = 0, shift = 0;
+        while (off < stop && shift < 32) {
+            uint8_t byte = ix->postings[off++];
+            value |= (uint32_t)(byte & 0x7f) << shift;
+            shift += 7;
+            if((byte & 0x80) == 0) break;
+        }
+
+        doc = count == 0 ? value : doc + value;
+        if(count < max) {
+            docs[count] = doc;
+        }
+        count++;
+    }
+    return count;
+}
+
+const char *darm_ngram_doc(const darm_ngram_index_t *ix, uint32_t doc,
+    uint32_t *addr)
+{
+    if(doc >= ix->doc_count || ix->doc[doc].file >= ix->file_count ||
+            ix->names[ix->doc[doc].file] >= ix->strings_size) {
+        return NULL;
+    }
+
+    if(addr != NULL) {
+        *addr = ix->doc[doc].addr;
+    }
+    return &ix->strings[ix->names[ix->doc[doc].file]];
+}
+
+void darm_ngram_close(darm_ngram_index_t *ix)
+{
+    if(ix->map != NULL) {
+#ifndef _WIN32
+        munmap((void *) ix->map, ix->size);
+#else
+        free((void *) ix->map);
+#endif
+    }
+    memset(ix, 0, sizeof(darm_ngram_index_t));
+}
+#undef NGRAM_MAGIC
+#undef FNV_OFFSET
+#undef FNV_PRIME
+
+// ---- search.c ----
+
+#include <stdio.h>
+#include <stdint.h>
+
+// amount of words that are matched at once
+#define CHUNK_SIZE 4096
+
+uint64_t darm_match_block(const uint32_t *words, uint32_t count,
+    uint32_t mask, uint32_t value)
+{
+    return darm_kernels()->match(words, count < 64 ? count : 64, mask, value);
+}
+
+static inline uint32_t _read16(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+// searches either the ARMv7 or the Thumb instructions of the image
+static uint32_t _search(const darm_pattern_t *patterns, uint32_t count,
+    const uint8_t *buf, uint32_t len, uint32_t base, uint32_t thumb,
+    darm_hit_t *hits, uint32_t max, uint32_t found)
+{
+    uint32_t words[CHUNK_SIZE], step = thumb ? 2 : 4;
+    int any = 0;
+
+    for (uint32_t pat = 0; pat < count; pat++) {
+        any |= (patterns[pat].isa != ISA_ARMV7) == thumb;
+    }
+
+    if(any == 0 || len < step) return found;
+
+    uint32_t total = (len - step) / step + 1;
+
+    for (uint32_t start = 0; start < total; start += CHUNK_SIZE) {
+        uint32_t n = total - start < CHUNK_SIZE ? total - start : CHUNK_SIZE;
+
+        // every instruction as a 32-bit word, for Thumb this is the
+        // halfword at each offset followed by the next one
+        for (uint32_t idx = 0; idx < n; idx++) {
+            const uint8_t *p = buf + (start + idx) * step;
+            if(thumb == 0) {
+                words[idx] = _read16(p) | (_read16(p + 2) << 16);
+            }
+            else {
+                uint32_t next = (start + idx) * 2 + 4 <= len ?
+                    _read16(p + 2) : 0;
+                words[idx] = (_read16(p) << 16) | next;
+            }
+        }
+
+        for (uint32_t idx = 0; idx < n; idx += 64) {
+            uint32_t block = n - idx < 64 ? n - idx : 64;
+            uint64_t bits = 0;
+
+            for (uint32_t pat = 0; pat < count; pat++) {
+                if((patterns[pat].isa != ISA_ARMV7) == thumb) {
+                    bits |= darm_match_block(&words[idx], block,
+                        patterns[pat].mask, patterns[pat].value);
+                }
+            }
+
+            for (; bits != 0; bits &= bits - 1) {
+                uint32_t off = idx + __builtin_ctzll(bits), w = words[off];
+                uint32_t addr = base + (start + off) * step, pat;
+
+                darm_t d; int ret;
+                if(thumb == 0) {
+                    ret = darm_disasm_inline(&d, w & 0xffff, w >> 16, addr);
+                }
+                else {
+                    // a thumb2 candidate in the last halfword runs past the
+                    // end of the buffer
+                    if((start + off) * 2 + darm_insn_length(w >> 16, 1) * 2 >
+                            len) {
+                        continue;
+                    }
+                    ret = darm_disasm_inline(&d, w >> 16, w & 0xffff,
+                        addr | 1);
+                }
+
+                if(ret == 0) continue;
+
+                // the pattern that matched with the size of the disassembled
+                // instruction, 16-bit Thumb instructions have a size of one,
+                // everything else a size of two; a pattern of the same
+                // instruction is preferred
+                uint32_t first = count;
+                for (pat = 0; pat < count; pat++) {
+                    const darm_pattern_t *p = &patterns[pat];
+                    if((p->isa != ISA_ARMV7) != thumb ||
+                            (w & p->mask) != p->value ||
+                            ret != (p->isa == ISA_THUMB ? 1 : 2)) {
+                        continue;
+                    }
+                    if(first == count) {
+                        first = pat;
+                    }
+                    if(p->instr == d.instr) break;
+                }
+
+                if(first == count) continue;
+                if(pat == count) pat = first;
+
+                if(found < max) {
+                    hits[found].addr = addr | thumb;
+                    hits[found].pattern = pat;
+                    hits[found].instr = d.instr;
+                }
+                found++;
+            }
+        }
+    }
+    return found;
+}
+
+uint32_t darm_search(const darm_pattern_t *patterns, uint32_t count,
+    const uint8_t *buf, uint32_t len, uint32_t base, darm_hit_t *hits,
+    uint32_t max)
+{
+    uint32_t found = _search(patterns, count, buf, len, base, 0,
+        hits, max, 0);
+    return _search(patterns, count, buf, len, base, 1, hits, max, found);
+}
+#undef CHUNK_SIZE
+
+// ---- stack.c ----
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+int darm_sp_delta(const darm_t *d, int32_t *delta)
+{
+    darm_mem_t mem;
+
+    *delta = 0;
+
+    // a conditional change is only applied on one of the paths, unless it's
+    // a conditional return, e.g., popne {r4, pc}, which leaves the function
+    if(d->cond != C_AL && d->cond != C_UNCOND && (d->regs_written >> SP) & 1) {
+        return (d->regs_written >> PC) & 1 ? 0 : -1;
+    }
+
+    switch ((uint32_t) d->instr) {
+    case I_PUSH: case I_POP:
+        darm_mem(d, &mem);
+        *delta = (d->instr == I_PUSH ? -4 : 4) * mem.count;
+        return 0;
+
+    case I_ADD: case I_SUB: case I_ADDW: case I_SUBW:
+        if(d->Rd != SP) break;
+
+        // add sp, sp, #imm and sub sp, sp, #imm, and the thumb2 addw and
+        // subw for large frames
+        if(d->Rn == SP && d->I == B_SET) {
+            *delta = d->instr == I_ADD || d->instr == I_ADDW ?
+                (int32_t) d->imm : -(int32_t) d->imm;
+            return 0;
+        }
+        return -1;
+    }
+
+    if(darm_mem(d, &mem) == 0 && mem.base == SP && mem.writeback != 0) {
+        switch ((uint32_t) d->instr) {
+        case I_STMDB: case I_STMDA: case I_LDMDB: case I_LDMDA:
+            *delta = -4 * mem.count;
+            return 0;
+
+        case I_STM: case I_STMIB: case I_LDM: case I_LDMIB:
+            *delta = 4 * mem.count;
+            return 0;
+        }
+
+        // pre- and post-indexed, e.g., str lr, [sp, #-4]!
+        if(mem.offset_kind == M_IMM) {
+            *delta = mem.offset;
+            return 0;
+        }
+        return -1;
+    }
+
+    return (d->regs_written >> SP) & 1 ? -1 : 0;
+}
+
+int darm_stack_init(darm_stack_t *s, const uint8_t *buf, uint32_t len,
+    uint32_t base)
+{
+    memset(s, 0, sizeof(darm_stack_t));
+    s->buf = buf, s->len = len, s->base = base;
+
+    s->depth = malloc((len / 2 + 1) * sizeof(int32_t));
+    s->insns = malloc((s->insn_alloc = 256) * sizeof(uint32_t));
+    s->work = malloc((s->work_alloc = 256) * sizeof(uint32_t));
+
+    if(s->depth == NULL || s->insns == NULL || s->work == NULL) {
+        darm_stack_free(s);
+        return -1;
+    }
+
+    for (uint32_t idx = 0; idx < len / 2 + 1; idx++) {
+        s->depth[idx] = DARM_STACK_NONE;
+    }
+    return 0;
+}
+
+// records the depth before the instruction at halfword off, returns 1 if it
+// has not been reached before, 0 if it has, and -1 on allocation failures
+static int _stack_visit(darm_stack_t *s, uint32_t off, int32_t depth)
+{
+    // this path joins one that has been followed already
+    if(s->depth[off] != DARM_STACK_NONE) {
+        s->mismatch += s->depth[off] != depth;
+        return 0;
+    }
+
+    if(s->insn_count == s->insn_alloc) {
+        uint32_t *ptr = realloc(s->insns,
+            s->insn_alloc * 2 * sizeof(uint32_t));
+        if(ptr == NULL) return -1;
+
+        s->insns = ptr, s->insn_alloc *= 2;
+    }
+
+    s->depth[off] = depth;
+    s->insns[s->insn_count++] = off;
+    return 1;
+}
+
+// continues at addr with the given depth, returns -1 on allocation failures
+static int _stack_push(darm_stack_t *s, uint32_t addr, int32_t depth)
+{
+    uint32_t off = (addr & ~1) - s->base;
+
+    if((addr & ~1) < s->base || off >= s->len) return 0;
+
+    int ret = _stack_visit(s, off / 2, depth);
+    if(ret <= 0) return ret;
+
+    if(s->work_count == s->work_alloc) {
+        uint32_t *ptr = realloc(s->work,
+            s->work_alloc * 2 * sizeof(uint32_t));
+        if(ptr == NULL) return -1;
+
+        s->work = ptr, s->work_alloc *= 2;
+    }
+
+    s->work[s->work_count++] = addr;
+    return 0;
+}
+
+int32_t darm_stack_analyze(darm_stack_t *s, uint32_t func)
+{
+    darm_t d; darm_it_t it;
+
+    // forget about the previous function
+    for (uint32_t idx = 0; idx < s->insn_count; idx++) {
+        s->depth[s->insns[idx]] = DARM_STACK_NONE;
+    }
+
+    s->insn_count = s->work_count = 0;
+    s->max_depth = s->unknown = s->mismatch = 0;
+
+    if(_stack_push(s, func, 0) < 0) return -1;
+
+    while (s->work_count != 0) {
+        uint32_t addr = s->work[--s->work_count];
+        uint32_t thumb = addr & 1;
+
+        // branch targets are assumed to be outside of IT blocks
+        darm_it_init(&it);
+
+        // ARMv7 instructions have to be four-byte aligned
+        if(thumb == 0 && (addr & 3) != 0) continue;
+
+        for (addr &= ~1; addr - s->base < s->len; ) {
+            uint32_t off = addr - s->base;
+            int32_t depth = s->depth[off / 2], delta;
+
+            int ret = darm_disasm_buf(&d, s->buf + off, s->len - off,
+                addr | thumb);
+            if(ret == 0) break;
+
+            if(thumb != 0) {
+                darm_it_apply(&it, &d, ret);
+            }
+
+            if(darm_sp_delta(&d, &delta) < 0) {
+                s->unknown++;
+                break;
+            }
+
+            int32_t after = depth - delta;
+            if(after > (int32_t) s->max_depth) {
+                s->max_depth = after;
+            }
+
+            // follow branches, but not calls, within this function
+            uint32_t target; int target_is_thumb;
+            darm_flow_t flow = darm_flow(&d);
+
+            if(flow != F_CALL && darm_branch_target(&d, addr | thumb,
+                    &target, &target_is_thumb) == 0 &&
+                    _stack_push(s, target | target_is_thumb, after) < 0) {
+                return -1;
+            }
+
+            if(flow != F_NONE && flow != F_CALL && !darm_flow_is_cond(&d)) {
+                break;
+            }
+
+            // a conditional return, e.g., popne {r4, pc}, doesn't change
+            // the stack pointer when it falls through
+            if(flow == F_NONE || flow == F_CALL) {
+                depth = after;
+            }
+
+            addr += ret * 2;
+            if(addr - s->base >= s->len) break;
+
+            // continue the linear run, unless another path got here first
+            ret = _stack_visit(s, (addr - s->base) / 2, depth);
+            if(ret < 0) return -1;
+            if(ret == 0) break;
+        }
+    }
+
+    return s->max_depth;
+}
+
+int32_t darm_stack_depth(const darm_stack_t *s, uint32_t addr)
+{
+    uint32_t off = (addr & ~1) - s->base;
+    if((addr & ~1) < s->base || off >= s->len) return DARM_STACK_NONE;
+
+    return s->depth[off / 2];
+}
+
+void darm_stack_free(darm_stack_t *s)
+{
+    free(s->depth);
+    free(s->insns);
+    free(s->work);
+    memset(s, 0, sizeof(darm_stack_t));
+}
+
+// ---- thumb.c ----
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#define BITMSK_8 ((1 << 8) - 1)
+
+static int thumb_disasm(darm_t *d, uint16_t w)
+{
+    darm_lut_t entry = thumb_instr_lut[w >> 8];
+    d->instr = darm_lut_instr(entry);
+    d->instr_type = darm_lut_type(entry);
+
+    switch ((uint32_t) d->instr_type) {
+    case T_THUMB_ONLY_IMM8:
+        d->I = B_SET;
+        d->imm = w & BITMSK_8;
+        return 0;
+
+    case T_THUMB_COND_BRANCH:
+        d->cond = (w >> 8) & b1111;
+        d->I = B_SET;
+        d->imm = (uint32_t)(int8_t)(w & BITMSK_8) << 1;
+        return 0;
+
+    case T_THUMB_UNCOND_BRANCH:
+        d->I = B_SET;
+        d->imm = w & ((1 << 11) - 1);
+
+        // manually sign-extend it
+        if(((d->imm >> 10) & 1) != 0) {
+            d->imm |= ~((1 << 11) - 1);
+        }
+
+        // finally, shift it one byte to the left
+        d->imm <<= 1;
+        return 0;
+
+    case T_THUMB_SHIFT_IMM:
+        d->Rd = (w >> 0) & b111;
+        d->Rm = (w >> 3) & b111;
+        d->shift = (w >> 6) & b11111;
+
+        // if the shift is zero and this is the lsl instruction, then this is
+        // actually a mov instruction
+        if(d->shift == 0 && d->instr == I_LSL) {
+            d->instr = I_MOV;
+        }
+        else {
+            // set the correct shift-type
+            switch ((uint32_t) d->instr) {
+            case I_ASR:
+                d->shift_type = S_ASR;
+                break;
+
+            case I_LSL:
+                d->shift_type = S_LSL;
+                break;
+
+            case I_LSR:
+                d->shift_type = S_LSR;
+                break;
+            }
+        }
+        return 0;
+
+    case T_THUMB_STACK:
+        d->I = B_SET;
+        d->imm = (w & BITMSK_8) << 2;
+        d->Rn = SP;
+        d->Rt = (w >> 8) & b111;
+        d->U = B_SET;
+        d->W = B_UNSET;
+        d->P = B_SET;
+        return 0;
+
+    case T_THUMB_LDR_PC:
+        d->I = B_SET;
+        d->imm = (w & BITMSK_8) << 2;
+        d->Rn = PC;
+        d->Rt = (w >> 8) & b111;
+        d->U = B_SET;
+        d->W = B_UNSET;
+        d->P = B_SET;
+        return 0;
+
+    case T_THUMB_GPI:
+        d->instr = type_gpi_instr_lookup[(w >> 6) & b1111];
+        switch ((uint32_t) d->instr) {
+        case I_AND: case I_EOR: case I_LSL: case I_LSR:
+        case I_ASR: case I_ADC: case I_SBC: case I_ROR:
+            d->Rd = d->Rn = w & b111;
+            d->Rm = (w >> 3) & b111;
+            return 0;
+
+        case I_TST: case I_CMP: case I_CMN:
+            d->Rn = w & b111;
+            d->Rm = (w >> 3) & b111;
+            return 0;
+
+        case I_RSB:
+            d->I = B_SET;
+            d->imm = 0;
+            d->Rd = w & b111;
+            d->Rn = (w >> 3) & b111;
+            return 0;
+
+        case I_ORR: case I_BIC:
+            d->Rn = w & b111;
+            // fall-through as the mvn handler is almost the same, except
+            // for parsing Rn
+
+        case I_MVN:
+            d->Rd = w & b111;
+            d->Rm = (w >> 3) & b111;
+            return 0;
+
+        case I_MUL:
+            d->Rd = d->Rm = w & b111;
+            d->Rn = (w >> 3) & b111;
+            return 0;
+        }
+
+    case T_THUMB_BRANCH_REG:
+        d->instr = (w >> 7) & 1 ? I_BLX : I_BX;
+        d->Rm = (w >> 3) & b1111;
+        return 0;
+
+    case T_THUMB_IT_HINTS:
+        // one of the hints instructions (instructions that hint the cpu and
+        // don't take any operands)
+        if((w & b1111) == 0) {
+            d->instr = type_hints_instr_lookup[(w >> 4) & b111];
+            return d->instr == I_INVLD ? -1 : 0;
+        }
+
+        // if-then instruction
+        d->instr = I_IT;
+        d->mask = w & b1111;
+        d->firstcond = (w >> 4) & b1111;
+        return 0;
+
+    case T_THUMB_HAS_IMM8:
+        d->I = B_SET;
+        d->imm = w & BITMSK_8;
+
+        switch ((uint32_t) d->instr) {
+        case I_ADD: case I_SUB:
+            d->Rd = d->Rn = (w >> 8) & b111;
+            return 0;
+
+        case I_ADR:
+            d->Rn = PC;
+            d->U = B_SET;
+            d->imm <<= 2;
+            // fall-through as adr also has to set Rd
+
+        case I_MOV:
+            d->Rd = (w >> 8) & b111;
+            return 0;
+
+        case I_CMP:
+            d->Rn = (w >> 8) & b111;
+            return 0;
+        }
+
+    case T_THUMB_EXTEND:
+        d->instr = type_extend_instr_lookup[(w >> 6) & b11];
+        d->Rd = w & b111;
+        d->Rm = (w >> 3) & b111;
+        return 0;
+
+    case T_THUMB_MOD_SP_IMM:
+        d->instr = (w >> 7) & 1 ? I_SUB : I_ADD;
+        d->Rd = d->Rn = SP;
+        d->I = B_SET;
+        d->imm = (w & 0x7f) << 2;
+        return 0;
+
+    case T_THUMB_3REG:
+        d->Rd = (w >> 0) & b111;
+        d->Rn = (w >> 3) & b111;
+        d->Rm = (w >> 6) & b111;
+        return 0;
+
+    case T_THUMB_2REG_IMM:
+        d->Rd = w & b111;
+        d->Rn = (w >> 3) & b111;
+        d->I = B_SET;
+        d->imm = (w >> 6) & b111;
+        return 0;
+
+    case T_THUMB_ADD_SP_IMM:
+        d->I = B_SET;
+        d->imm = (w & BITMSK_8) << 2;
+        d->Rn = SP;
+        d->Rd = (w >> 8) & b111;
+        return 0;
+
+    case T_THUMB_MOV4:
+        // D is the 8th bit and has to become the 3th bit, to function as
+        // highest bit for Rd
+        d->Rd = ((w >> 4) & 8) | (w & b111);
+        d->Rm = (w >> 3) & b1111;
+        return 0;
+
+    case T_THUMB_RW_MEMI:
+        d->Rt = w & b111;
+        d->Rn = (w >> 3) & b111;
+        d->I = B_SET;
+        d->imm = (w >> 6) & b11111;
+
+        // some instructions require some shifting for the immediate
+        switch ((uint32_t) d->instr) {
+        case I_LDR: case I_STR:
+            d->imm <<= 2;
+            break;
+
+        case I_LDRH: case I_STRH:
+            d->imm <<= 1;
+            break;
+        }
+
+        d->P = B_SET;
+        d->U = B_SET;
+        d->W = B_UNSET;
+        return 0;
+
+    case T_THUMB_RW_MEMO:
+        d->Rt = (w >> 0) & b111;
+        d->Rn = (w >> 3) & b111;
+        d->Rm = (w >> 6) & b111;
+        d->P = B_SET;
+        d->U = B_SET;
+        d->W = B_UNSET;
+        return 0;
+
+    case T_THUMB_RW_REG:
+        // TODO write-back support for LDM
+        d->reglist = w & BITMSK_8;
+        d->Rn = (w >> 8) & b111;
+        return 0;
+
+    case T_THUMB_REV:
+        d->instr = type_rev_instr_lookup[(w >> 6) & b11];
+        if(d->instr == I_INVLD) return -1;
+
+        d->Rd = (w >> 0) & b111;
+        d->Rm = (w >> 3) & b111;
+        return 0;
+
+    case T_THUMB_SETEND:
+        d->E = (w >> 4) & b1;
+        return 0;
+
+    case T_THUMB_PUSHPOP:
+        d->reglist = w & BITMSK_8;
+
+        // for push we have to set LR
+        if(d->instr == I_PUSH) {
+            d->reglist |= ((w >> 8) & 1) << LR;
+        }
+        // for pop we have to set PC
+        else {
+            d->reglist |= ((w >> 8) & 1) << PC;
+        }
+        return 0;
+
+    case T_THUMB_CMP:
+        // the 4th bit for Rn is stored as the 7th bit
+        d->Rn = (w & b111) | ((w >> 4) & b1000);
+        d->Rm = (w >> 3) & b1111;
+        return 0;
+
+    case T_THUMB_MOD_SP_REG:
+        // a8.8.6 t2 (also implies a8.8.10 t2)
+        d->Rd = d->Rn = ((w >> 4) & b1000) | (w & b0111);
+        d->Rm = (w >> 3) & b1111;
+
+        // a8.8.10 t1
+        if(d->Rm == SP) {
+            d->Rd = d->Rm = d->Rn;
+            d->Rn = SP;
+        }
+        return 0;
+
+    case T_THUMB_CBZ:
+        d->instr = (w >> 11) & 1 ? I_CBNZ : I_CBZ;
+        d->Rn = w & b111;
+        d->Rm = PC;
+        d->U = B_SET;
+        d->I = B_SET;
+        d->imm = ((w >> 2) & (b11111 << 1)) | ((w >> 3) & (1 << 6));
+        return 0;
+    }
+    return -1;
+}
+
+int darm_thumb_disasm(darm_t *d, uint16_t w)
+{
+    darm_init(d);
+    d->w = w;
+
+    // we set all conditional flags to "execute always" by default, as most
+    // thumb instructions don't feature a conditional flag
+    d->cond = C_AL;
+
+    switch (w >> 11) {
+    case b11101: case b11110: case b11111:
+        return -1;
+
+    default:
+        if(thumb_disasm(d, w) < 0) return -1;
+
+        darm_regs_update(d);
+        return 0;
+    }
+}
+#undef BITMSK_8
+
+// ---- thumb2-decoder.c ----
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+// ---- thumb2.h ----
+
+#ifndef __THUMB2_H__
+#define __THUMB2_H__
+
+uint32_t thumb_expand_imm(uint16_t imm12_r);
+void thumb2_decode_immshift(darm_t *d, uint8_t type, uint8_t imm5);
+darm_instr_t thumb2_decode_instruction(darm_t *d, uint16_t w, uint16_t w2);
+
+#endif
+
+darm_instr_t thumb2_load_store_multiple(darm_t *d, uint16_t w, uint16_t w2);
+darm_instr_t thumb2_load_store_dual(darm_t *d, uint16_t w, uint16_t w2);
+darm_instr_t thumb2_data_shifted_reg(darm_t *d, uint16_t w, uint16_t w2);
+darm_instr_t thumb2_coproc_simd(darm_t *d, uint16_t w, uint16_t w2);
+darm_instr_t thumb2_modified_immediate(darm_t *d, uint16_t w, uint16_t w2);
+darm_instr_t thumb2_plain_immediate(darm_t *d, uint16_t w, uint16_t w2);
+darm_instr_t thumb2_branch_misc_ctrl(darm_t *d, uint16_t w, uint16_t w2);
+darm_instr_t thumb2_store_single_item(darm_t *d, uint16_t w, uint16_t w2);
+darm_instr_t thumb2_data_reg(darm_t *d, uint16_t w, uint16_t w2);
+darm_instr_t thumb2_mult_acc_diff(darm_t *d, uint16_t w, uint16_t w2);
+darm_instr_t thumb2_long_mult_acc(darm_t *d, uint16_t w, uint16_t w2);
+darm_instr_t thumb2_load_byte_hints(darm_t *d, uint16_t w, uint16_t w2);
+darm_instr_t thumb2_load_word(darm_t *d, uint16_t w, uint16_t w2);
+darm_instr_t thumb2_load_halfword_hints(darm_t *d, uint16_t w, uint16_t w2);
+
+darm_instr_t thumb2_decode_instruction(darm_t *d, uint16_t w, uint16_t w2)
+{
+    uint32_t op2 = (w >> 4) & 0x7f;
+
+    switch ((w >> 11) & b11) {
+    case 1:
+        op2 &= 0x64;
+        if(op2 == 0) {
+            // load, store multiple
+            return thumb2_load_store_multiple(d, w, w2);
+        }
+        else if(op2 == b100) {
+            // load/store dual, load/store exclusive, table branch
+            return thumb2_load_store_dual(d, w, w2);
+        }
+        else if(((op2 >> 5) & b11) == b1) {
+            // dataprocessing (shifted register)
+            return thumb2_data_shifted_reg(d, w, w2);
+        }
+        else if(((op2 >> 6) & b1) == b1) {
+            // coproc, simd, fpu
+            return thumb2_coproc_simd(d, w, w2);
+        }
+        break;
+
+    case 2:
+        op2 = (op2 & 0x20) >> 5;
+        if(op2 == 0 && (w2 & 0x8000) == 0) {
+            // dataprocessing (modified immediate)
+            return thumb2_modified_immediate(d, w, w2);
+        }
+        else if(op2 == 1 && (w2 & 0x8000) == 0) {
+            // dataprocessing (plain binary immediate)
+            return thumb2_plain_immediate(d, w, w2);
+        }
+        else if((w2 & 0x8000) == 0x8000) {
+            // branches and miscellaneous control
+            return thumb2_branch_misc_ctrl(d, w, w2);
+        }
+        break;
+
+    case 3:
+        if((op2 & 0x71) == 0) {
+            // store single data item
+            return thumb2_store_single_item(d, w, w2);
+        }
+        else if((op2 & 0x71) == 0x10) {
+            // Advanced SIMD element or structure load/store instructions
+            // TODO: implement
+            return I_INVLD;
+        }
+        else if((op2 & 0x70) == 0x20) {
+            // data-processing (register)
+            return thumb2_data_reg(d, w, w2);
+        }
+        else if((op2 & 0x78) == 0x30) {
+            // multiply, multiply accumulate, and absolute difference
+            return thumb2_mult_acc_diff(d, w, w2);
+        }
+        else if((op2 & 0x78) == 0x38) {
+            // long multiply, long multiply accumulate, and divide
+            return thumb2_long_mult_acc(d, w, w2);
+        }
+        else {
+            switch (op2 & 0x67) {
+            case 1:
+                // load byte, memory hints
+                return thumb2_load_byte_hints(d, w, w2);
+
+            case 3:
+                // load halfword, memory hints
+                return thumb2_load_halfword_hints(d, w, w2);
+
+            case 5:
+                // load word
+                return thumb2_load_word(d, w, w2);
+            }
+            break;
+        }
+    }
+
+    // TODO handle other co-proc case
+    return I_INVLD;
+}
+
+darm_instr_t thumb2_load_store_multiple(darm_t *d, uint16_t w, uint16_t w2)
+{
+    (void) w2;
+
+    uint32_t op = (w >> 7) & b11;
+    uint32_t L = (w >> 4) & b1;
+    uint32_t W_Rn = ((w >> 1) & 0x10) | (w & b1111);
+
+    d->instr_type = T_THUMB2_RN_REG;
+    d->instr_imm_type = T_THUMB2_NO_IMM;
+    d->instr_flag_type = T_THUMB2_REGLIST_FLAG;
+
+    switch (op) {
+    case 0:
+    case 3:
+        d->instr_type = T_THUMB2_NO_REG;
+        d->instr_flag_type = T_THUMB2_NO_FLAG;
+        if(L == 0) {
+            return I_SRS;
+        }
+        else if(L == 1) {
+            return I_RFE;
+        }
+        break;
+
+    case 1:
+        if(L == 0) {
+            return I_STM;
+        }
+
+        if(W_Rn == 0x1d) {
+            d->instr_type = T_THUMB2_NO_REG;
+            return I_POP;
+        }
+
+        d->instr_flag_type = T_THUMB2_WP_REGLIST_FLAG;
+        return I_LDM;
+
+    case 2:
+        if(L == 0) {
+            if(W_Rn == 0x1d) {
+                d->instr_type = T_THUMB2_NO_REG;
+                return I_PUSH;
+            }
+
+            return I_STMDB;
+        }
+
+        d->instr_flag_type = T_THUMB2_WP_REGLIST_FLAG;
+        return I_LDMDB;
+    }
+
+    return I_INVLD;
+}
+
+darm_instr_t thumb2_load_store_dual(darm_t *d, uint16_t w, uint16_t w2)
+{
+    uint32_t op1 = (w >> 7) & b11;
+    uint32_t op2 = (w >> 4) & b11;
+    uint32_t op3 = (w2 >> 4) & b1111;
+    uint32_t Rn = w & b1111;
+
+    d->instr_type = T_THUMB2_RN_RT_REG;
+    d->instr_imm_type = T_THUMB2_IMM8;;
+    d->instr_flag_type = T_THUMB2_NO_FLAG;
+
+    if(op1 == 0 && op2 == 0) {
+        d->instr_type = T_THUMB2_RN_RD_RT_REG;
+        return I_STREX;
+    }
+    else if(op1 == 0 && op2 == 1) {
+        return I_LDREX;
+    }
+    else if((op1 & 2) == 0 && op2 == 2) {
+        d->instr_type = T_THUMB2_RN_RT_RT2_REG;
+        d->instr_flag_type = T_THUMB2_WUP_FLAG;
+        return I_STRD; // immediate
+    }
+    else if(((op1 & 2) == 0 && op2 == 3) ||
+            ((op1 & 2) == 2 && (op2 & 1) == 1)) {
+        d->instr_flag_type = T_THUMB2_WUP_FLAG;
+        if(Rn == b1111) {
+            d->instr_type = T_THUMB2_RT_RT2_REG;
+        }
+        else {
+            d->instr_type = T_THUMB2_RN_RT_RT2_REG;
+        }
+        return I_LDRD; // literal and immediate
+    }
+    else if((op1 & 2) == 2 && (op2 & 1) == 0) {
+        d->instr_type = T_THUMB2_RN_RT_RT2_REG;
+        d->instr_flag_type = T_THUMB2_WUP_FLAG;
+        return I_STRD; // immediate
+    }
+    else if(op1 == 1 && op2 == 0) {
+        d->instr_imm_type = T_THUMB2_NO_IMM;
+        d->instr_type = T_THUMB2_RN_RD_RT_REG;
+
+        switch (op3) {
+        case 4:
+            return I_STREXB;
+
+        case 5:
+            return I_STREXH;
+
+        case 7:
+            d->instr_type = T_THUMB2_RN_RD_RT_RT2_REG;
+            return I_STREXD;
+        }
+    }
+    else if(op1 == 1 && op2 == 1) {
+        d->instr_imm_type = T_THUMB2_NO_IMM;
+
+        switch (op3) {
+        case 0:
+            d->instr_type = T_THUMB2_RN_RM_REG;
+            d->instr_imm_type = T_THUMB2_NO_IMM;
+            return I_TBB;
+
+        case 1:
+            d->instr_type = T_THUMB2_RN_RM_REG;
+            d->instr_imm_type = T_THUMB2_NO_IMM;
+            return I_TBH;
+
+        case 4:
+            return I_LDREXB;
+
+        case 5:
+            return I_LDREXH;
+
+        case 7:
+            d->instr_type = T_THUMB2_RN_RT_RT2_REG;
+            return I_LDREXD;
+        }
+    }
+
+    return I_INVLD;
+}
+
+darm_instr_t thumb2_move_shift(darm_t *d, uint16_t w, uint16_t w2)
+{
+    (void) w;
+
+    uint32_t type = (w2>>4) & b11;
+    uint32_t imm3_imm2 = ((w2>>10) & 0x1C) | ((w2>>6) & b11);
+
+    d->instr_type = T_THUMB2_RD_RM_REG;
+    d->instr_imm_type = T_THUMB2_IMM2_IMM3;
+    d->instr_flag_type = T_THUMB2_S_FLAG;
+
+    switch (type) {
+    case 0:
+        if(imm3_imm2 == 0) {
+            d->instr_imm_type = T_THUMB2_NO_IMM;
+            return I_MOV;
+        }
+
+        return I_LSL;
+
+    case 1:
+        return I_LSR;
+
+    case 2:
+        return I_ASR;
+
+    case 3:
+        if(imm3_imm2 == 0) {
+            d->instr_imm_type = T_THUMB2_NO_IMM;
+            return I_RRX;
+        }
+
+        return I_ROR;
+    }
+
+    return I_INVLD;
+}
+
+darm_instr_t thumb2_data_shifted_reg(darm_t *d, uint16_t w, uint16_t w2)
+{
+    uint32_t op = (w >> 5) & b1111;
+    uint32_t Rn = w & b1111;
+    uint32_t Rd_S = ((w2 >> 7) & 0x1e) | ((w >> 4) & 1);
+
+    d->instr_type = T_THUMB2_RN_RD_RM_REG;
+    d->instr_imm_type = T_THUMB2_IMM2_IMM3;
+    d->instr_flag_type = T_THUMB2_S_TYPE_FLAG;
+
+    switch (op) {
+    case 0:
+        if(Rd_S == 0x1f) {
+            d->instr_type = T_THUMB2_RN_RM_REG;
+            d->instr_flag_type = T_THUMB2_TYPE_FLAG;
+            return I_TST;
+        }
+
+        return I_AND;
+
+    case 1:
+        return I_BIC;
+
+    case 2:
+        if(Rn == b1111) {
+            return thumb2_move_shift(d, w, w2);
+        }
+
+        return I_ORR;
+
+    case 3:
+        if(Rn == b1111) {
+            d->instr_type = T_THUMB2_RD_RM_REG;
+            return I_MVN;
+        }
+
+        return I_ORN;
+
+    case 4:
+        if(Rd_S == 0x1f) {
+            d->instr_type = T_THUMB2_RN_RM_REG;
+            d->instr_flag_type = T_THUMB2_TYPE_FLAG;
+            return I_TEQ;
+        }
+
+        return I_EOR;
+
+    case 6:
+        d->instr_flag_type = T_THUMB2_S_FLAG;
+        return I_PKH;
+
+    case 8:
+        if(Rd_S == 0x1f) {
+            d->instr_type = T_THUMB2_RN_RM_REG;
+            d->instr_flag_type = T_THUMB2_TYPE_FLAG;
+            return I_CMN;
+        }
+
+        return I_ADD;
+
+    case 10:
+        return I_ADC;
+
+    case 11:
+        return I_SBC;
+
+    case 13:
+        if(Rd_S == 0x1f) {
+            d->instr_type = T_THUMB2_RN_RM_REG;
+            d->instr_flag_type = T_THUMB2_TYPE_FLAG;
+            return I_CMP;
+        }
+
+        return I_SUB;
+
+    case 14:
+        return I_RSB;
+    }
+
+    return I_INVLD;
+}
+
+darm_instr_t thumb2_modified_immediate(darm_t *d, uint16_t w, uint16_t w2)
+{
+    uint32_t op = (w >> 5) & b1111;
+    uint32_t Rn = w & b1111;
+    uint32_t Rd_S = ((w2 >> 7) & 0x1e) | ((w >> 4) & 1);
+
+    d->instr_type = T_THUMB2_RN_RD_REG;
+    d->instr_imm_type = T_THUMB2_IMM1_IMM3_IMM8;
+    d->instr_flag_type = T_THUMB2_S_FLAG;
+
+    switch (op) {
+    case 0:
+        if(Rd_S == 0x1f) {
+            d->instr_type = T_THUMB2_RN_REG;
+            d->instr_flag_type = T_THUMB2_NO_FLAG;
+            return I_TST;
+        }
+
+        return I_AND;
+
+    case 1:
+        return I_BIC;
+
+    case 2:
+        if(Rn == b1111) {
+            d->instr_type = T_THUMB2_RD_REG;
+            return I_MOV;
+        }
+
+        return I_ORR;
+
+    case 3:
+        if(Rn == b1111) {
+            d->instr_type = T_THUMB2_RD_REG;
+            return I_MVN;
+        }
+
+        return I_ORN;
+
+    case 4:
+        if(Rd_S == 0x1f) {
+            d->instr_type = T_THUMB2_RN_REG;
+            d->instr_flag_type = T_THUMB2_NO_FLAG;
+            return I_TEQ;
+        }
+
+        return I_EOR;
+
+    case 8:
+        if(Rd_S == 0x1f) {
+            d->instr_type = T_THUMB2_RN_REG;
+            d->instr_flag_type = T_THUMB2_NO_FLAG;
+            return I_CMN;
+        }
+
+        return I_ADD;
+
+    case 10:
+        return I_ADC;
+
+    case 11:
+        return I_SBC;
+
+    case 13:
+        if(Rd_S == 0x1f) {
+            d->instr_type = T_THUMB2_RN_REG;
+            d->instr_flag_type = T_THUMB2_NO_FLAG;
+            return I_CMP;
+        }
+
+        return I_SUB;
+
+    case 14:
+        return I_RSB;
+    }
+
+    return I_INVLD;
+}
+
+darm_instr_t thumb2_plain_immediate(darm_t *d, uint16_t w, uint16_t w2)
+{
+    uint32_t op = (w >> 4) & 0x1f;
+    uint32_t Rn = w & b1111;
+
+    d->instr_type = T_THUMB2_RN_RD_REG;
+    d->instr_imm_type = T_THUMB2_IMM1_IMM3_IMM8;
+    d->instr_flag_type = T_THUMB2_NO_FLAG;
+
+    switch (op) {
+    case 0:
+        return Rn == b1111 ? I_ADR : I_ADDW;
+
+    case 4:
+        d->instr_type = T_THUMB2_RD_REG;
+        return I_MOVW;
+
+    case 10:
+        return Rn == b1111 ? I_ADR : I_SUBW;
+
+    case 12:
+        d->instr_type = T_THUMB2_RD_REG;
+        return I_MOVT;
+
+    case 16:
+        d->instr_imm_type = T_THUMB2_IMM2_IMM3;
+        return I_SSAT;
+
+    case 18:
+        if((w2 & 0x70c0) == 0) {
+            d->instr_imm_type = T_THUMB2_NO_IMM;
+            return I_SSAT16;
+        }
+
+        d->instr_imm_type = T_THUMB2_IMM2_IMM3;
+        return I_SSAT;
+
+    case 20:
+        d->instr_imm_type = T_THUMB2_IMM2_IMM3;
+        return I_SBFX;
+
+    case 22:
+        d->instr_imm_type = T_THUMB2_IMM2_IMM3;
+        if(Rn == b1111) {
+            d->instr_type = T_THUMB2_RD_REG;
+            return I_BFC;
+        }
+
+        return I_BFI;
+
+    case 24:
+        d->instr_imm_type = T_THUMB2_IMM2_IMM3;
+        return I_USAT;
+
+    case 26:
+        if((w2 & 0x70c0) == 0) {
+            d->instr_imm_type = T_THUMB2_NO_IMM;
+            return I_USAT16;
+        }
+
+        d->instr_imm_type = T_THUMB2_IMM2_IMM3;
+        return I_USAT;
+
+    case 28:
+        d->instr_imm_type = T_THUMB2_IMM2_IMM3;
+        return I_UBFX;
+    }
+
+    return I_INVLD;
+}
+
+darm_instr_t thumb2_proc_state(darm_t *d, uint16_t w, uint16_t w2)
+{
+    (void) d; (void) w;
+
+    uint32_t op1 = (w2 >> 8) & b111;
+    uint32_t op2 = w2 & 0xff;
+
+    if(op1 == 0) {
+        switch (op2) {
+        case 0:
+            return I_NOP;
+
+        case 1:
+            return I_YIELD;
+
+        case 2:
+            return I_WFE;
+
+        case 3:
+            return I_WFI;
+
+        case 4:
+            return I_SEV;
+
+        default:
+            if(((op2 >> 4) & b1111) == b1111) {
+                return I_DBG;
+            }
+        }
+    }
+    else {
+        return I_CPS;
+    }
+
+    return I_INVLD;
+}
+
+darm_instr_t thumb2_misc_ctrl(darm_t *d, uint16_t w, uint16_t w2)
+{
+    (void) d; (void) w;
+    uint32_t op = (w2 >> 4) & b111;
+
+    switch (op) {
+    case 0: case 1:
+        // TODO: ENTERX, LEAVEX
+        return I_NOP;
+
+    case 2:
+        return I_CLREX;
+
+    case 4:
+        return I_DSB;
+
+    case 5:
+        return I_DMB;
+
+    case 6:
+        return I_ISB;
+    }
+
+    return I_INVLD;
+}
+
+darm_instr_t thumb2_branch_misc_ctrl(darm_t *d, uint16_t w, uint16_t w2)
+{
+    uint32_t op = (w >> 4) & 0x7f;
+    uint32_t op1 = (w2 >> 12) & b111;
+    uint32_t imm8 = w2 & 0xff;
+
+    d->instr_type = T_THUMB2_NO_REG;
+    d->instr_imm_type = T_THUMB2_NO_IMM;
+    d->instr_flag_type = T_THUMB2_NO_FLAG;
+
+    if(op1 == 0 && op == 0xfe) {
+        // TODO return I_HVC
+        return I_NOP;
+    }
+    else if(op1 == 0 && op == 0xff) {
+        return I_SMC;
+    }
+    else if((op1 & b101) == 1) {
+        d->instr_flag_type = T_THUMB2_S_FLAG;
+        return I_B;
+    }
+    else if(op1 == 2 && op == 0xff) {
+        return I_UDF;
+    }
+    else if((op1 & b101) == 0) {
+        if((op & 0x38) != 0x38) {
+            d->instr_flag_type = T_THUMB2_S_FLAG;
+            return I_B;
+        }
+        else if((op & 0x7e) == 0x38 && (imm8 & 0x10) == 0x10) {
+            return I_MSR; // banked register
+        }
+        else if(op == 0x38 && (imm8 & 0x10) == 0) {
+            d->instr_type = T_THUMB2_RN_REG;
+            return I_MSR; // register
+        }
+        else if(op == 0x3a) {
+            return thumb2_proc_state(d, w, w2);
+        }
+        else if(op == 0x3b) {
+            return thumb2_misc_ctrl(d, w, w2);
+        }
+        else if(op == 0x3c) {
+            d->instr_type = T_THUMB2_RM_REG;
+            return I_BXJ;
+        }
+        else if(op == 0x3e && (imm8 & 0x10) == 0) {
+            d->instr_type = T_THUMB2_RD_REG;
+            return I_MRS;
+        }
+    }
+    else if((op1 & b101) == b100) {
+        d->instr_flag_type = T_THUMB2_S_FLAG;
+        return I_BLX;
+    }
+    else if((op1 & b101) == b101) {
+        d->instr_flag_type = T_THUMB2_S_FLAG;
+        return I_BL;
+    }
+
+    return I_INVLD;
+}
+
+darm_instr_t thumb2_store_single_item(darm_t *d, uint16_t w, uint16_t w2)
+{
+    uint32_t op1 = (w >> 5) & b111;
+    uint32_t op2 = (w2 >> 6) & 0x3f;
+
+    d->instr_type = T_THUMB2_RN_RT_REG;
+    d->instr_imm_type = T_THUMB2_IMM8;
+    d->instr_flag_type = T_THUMB2_NO_FLAG;
+
+    switch (op1) {
+    case 0:
+        if(op2 == 0) {
+            d->instr_type = T_THUMB2_RN_RM_RT_REG;
+            d->instr_imm_type = T_THUMB2_IMM2;
+            return I_STRB; // register
+        }
+        else if((op2 & 0x3c) == 0x38) {
+            return I_STRBT;
+        }
+        else if((op2 & 0x3c) == 0x30 || (op2 & 0x24) == 0x24) {
+            d->instr_flag_type = T_THUMB2_WUP_FLAG;
+            return I_STRB; // immediate 8 bit
+        }
+        break;
+
+    case 1:
+        if(op2 == 0) {
+            d->instr_type = T_THUMB2_RN_RM_RT_REG;
+            d->instr_imm_type = T_THUMB2_IMM2;
+            return I_STRH; // register
+        }
+        else if((op2 & 0x3c) == 0x38) {
+            return I_STRHT;
+        }
+        else if((op2 & 0x3c) == 0x30 || (op2 & 0x24) == 0x24) {
+            d->instr_flag_type = T_THUMB2_WUP_FLAG;
+            return I_STRH;  // immediate 8 bit
+        }
+        break;
+
+    case 2:
+        if(op2 == 0) {
+            d->instr_type = T_THUMB2_RN_RM_RT_REG;
+            d->instr_imm_type = T_THUMB2_IMM2;
+            return I_STR; // register
+        }
+        else if((op2 & 0x3c) == 0x38) {
+            return I_STRT;
+        }
+        else if((op2 & 0x3c) == 0x30 || (op2 & 0x24) == 0x24) {
+
+            // PUSH pseudo single register if Rn == SP,
+            // P and W are set, and imm == 4
+            if((w & 0xf) == b1101 && (w2 & 0xfff) == 0xd04) {
+                d->instr_type = T_THUMB2_RT_REG;
+                d->instr_imm_type = T_THUMB2_NO_IMM;
+                d->instr_flag_type = T_THUMB2_NO_FLAG;
+                return I_PUSH;
+            }
+
+            d->instr_flag_type = T_THUMB2_WUP_FLAG;
+            return I_STR; // immediate 8 bit
+        }
+        break;
+
+    case 4:
+        d->instr_imm_type = T_THUMB2_IMM12;
+        return I_STRB; // immediate 12 bit
+
+    case 5:
+        d->instr_imm_type = T_THUMB2_IMM12;
+        return I_STRH; // immediate 12 bit
+
+    case 6:
+        d->instr_imm_type = T_THUMB2_IMM12;
+        return I_STR; // immediate 12 bit
+    }
+
+    return I_INVLD;
+}
+
+darm_instr_t thumb2_load_byte_hints(darm_t *d, uint16_t w, uint16_t w2)
+{
+    uint32_t op1 = (w >> 7) & b11;
+    uint32_t op2 = (w2 >> 6) & 0x3f;
+    uint32_t Rn = w & b1111;
+    uint32_t Rt = (w2 >> 12) & b1111;
+
+    d->instr_type = T_THUMB2_RN_RT_REG;
+    d->instr_imm_type = T_THUMB2_IMM12;
+    d->instr_flag_type = T_THUMB2_NO_FLAG;
+
+    if((op1 & 2) == 0 && Rn == b1111) {
+        d->instr_flag_type = T_THUMB2_U_FLAG;
+        if(Rt == b1111) {
+            d->instr_imm_type = T_THUMB2_NO_REG;
+            return I_PLD; // literal
+        }
+
+        d->instr_type = T_THUMB2_RT_REG;
+        return I_LDRB; // literal
+    }
+    else if((op1 & 2) == 2 && Rn == b1111) {
+        d->instr_flag_type = T_THUMB2_U_FLAG;
+        if(Rt == b1111) {
+            d->instr_imm_type = T_THUMB2_NO_REG;
+            return I_PLI; // immediate, literal
+        }
+
+        d->instr_type = T_THUMB2_RT_REG;
+        return I_LDRSB; // literal
+    }
+    else if(op1 == 0) {
+        if(op2 == 0) {
+            d->instr_imm_type = T_THUMB2_IMM2;
+            if(Rt == b1111) {
+                d->instr_type = T_THUMB2_RN_RM_REG;
+                return I_PLD; // PLD/PLDW register
+            }
+
+            d->instr_type = T_THUMB2_RN_RM_RT_REG;
+            return I_LDRB; // register
+        }
+        else if((op2 & 0x24) == 0x24) {
+            d->instr_imm_type = T_THUMB2_IMM8;
+            d->instr_flag_type = T_THUMB2_WUP_FLAG;
+            return I_LDRB; // immediate
+        }
+        else if((op2 & 0x3c) == 0x30) {
+            d->instr_imm_type = T_THUMB2_IMM8;
+            if(Rt == b1111) {
+                d->instr_type = T_THUMB2_RN_REG;
+                return I_PLD; // PLD/PLDW immediate
+            }
+
+            d->instr_flag_type = T_THUMB2_WUP_FLAG;
+            return I_LDRB; // immediate
+        }
+        else if((op2 & 0x3c) == 0x38) {
+            d->instr_imm_type = T_THUMB2_IMM8;
+            return I_LDRBT;
+        }
+    }
+    else if(op1 == 1) {
+        if(Rt == b1111) {
+            d->instr_type = T_THUMB2_RN_REG;
+            return I_PLD; // PLD/PLDW immediate 12
+        }
+
+        return I_LDRB; // immediate 12
+    }
+    else if(op1 == 2) {
+        if(op2 == 0) {
+            d->instr_imm_type = T_THUMB2_IMM2;
+            if(Rt == b1111) {
+                d->instr_type = T_THUMB2_RN_RM_REG;
+                return I_PLI; // PLI register
+            }
+
+            d->instr_type = T_THUMB2_RN_RM_RT_REG;
+            return I_LDRSB; // register
+        }
+        else if((op2 & 0x24) == 0x24) {
+            d->instr_imm_type = T_THUMB2_IMM8;
+            d->instr_flag_type = T_THUMB2_WUP_FLAG;
+            return I_LDRSB; // immediate 8
+        }
+        else if((op2 & 0x3C) == 0x30) {
+            d->instr_imm_type = T_THUMB2_IMM8;
+            if(Rt == b1111) {
+                d->instr_type = T_THUMB2_RN_REG;
+                return I_PLI; // PLI immediate/literal
+            }
+
+            d->instr_flag_type = T_THUMB2_WUP_FLAG;
+            return I_LDRSB; // immediate 8
+        }
+        else if((op2 & 0x3C) == 0x38) {
+            d->instr_imm_type = T_THUMB2_IMM8;
+            return I_LDRSBT;
+        }
+    }
+    else if(op1 == 3) {
+        if(Rt == b1111) {
+            d->instr_type = T_THUMB2_RN_REG;
+            return I_PLI; // PLI literal/immediate
+        }
+
+        return I_LDRSB; // immediate 12
+    }
+
+    return I_INVLD;
+}
+
+darm_instr_t thumb2_load_halfword_hints(darm_t *d, uint16_t w, uint16_t w2)
+{
+    uint32_t op1 = (w >> 7) & b11;
+    uint32_t op2 = (w2 >> 6) & 0x3f;
+    uint32_t Rn = w & b1111;
+    uint32_t Rt = (w2 >> 12) & b1111;
+
+    d->instr_type = T_THUMB2_RN_RT_REG;
+    d->instr_imm_type = T_THUMB2_IMM12;
+    d->instr_flag_type = T_THUMB2_NO_FLAG;
+
+    if((op1 & 2) == 0 && Rn == b1111) {
+        d->instr_flag_type = T_THUMB2_U_FLAG;
+        if(Rt == b1111) {
+            return I_PLD; // literal
+        }
+
+        d->instr_type = T_THUMB2_RT_REG;
+        return I_LDRH; // literal
+    }
+    else if((op1 & 2) == 2 && Rn == b1111) {
+        if(Rt == b1111) {
+            return I_NOP; // mem hint
+        }
+
+        d->instr_flag_type = T_THUMB2_U_FLAG;
+        d->instr_type = T_THUMB2_RT_REG;
+        return I_LDRSH; // literal
+    }
+    else if(op1 == 0) {
+        if(op2 == 0) {
+            d->instr_imm_type = T_THUMB2_IMM2;
+            if(Rt == b1111) {
+                d->instr_type = T_THUMB2_RN_RM_REG;
+                return I_PLD; // PLD/PLDW register
+            }
+
+            d->instr_type = T_THUMB2_RN_RM_RT_REG;
+            return I_LDRH; // register
+        }
+        else if((op2 & 0x24) == 0x24) {
+            d->instr_imm_type = T_THUMB2_IMM8;
+            d->instr_flag_type = T_THUMB2_WUP_FLAG;
+            return I_LDRH; // immediate 8 bit
+        }
+        else if((op2 & 0x3c) == 0x30) {
+            if(Rt == b1111) {
+                d->instr_type = T_THUMB2_RN_REG;
+                d->instr_imm_type = T_THUMB2_IMM8;
+                return I_PLD; // PLD/PLDW immediate 8 bit
+            }
+
+            d->instr_imm_type = T_THUMB2_IMM8;
+            d->instr_flag_type = T_THUMB2_WUP_FLAG;
+            return I_LDRH; // immediate 8 bit
+        }
+        else if((op2 & 0x3c) == 0x38) {
+            d->instr_imm_type = T_THUMB2_IMM8;
+            return I_LDRHT;
+        }
+    }
+    else if(op1 == 1) {
+        if(Rt == b1111) {
+            d->instr_type = T_THUMB2_RN_REG;
+            return I_PLD; // PLD/PLDW immediate 12 bit
+        }
+
+        return I_LDRH; // immediate 12 bit
+    }
+    else if(op1 == 2) {
+        if(op2 == 0) {
+            if(Rt == b1111) {
+                return I_NOP;
+            }
+
+            d->instr_imm_type = T_THUMB2_IMM2;
+            d->instr_type = T_THUMB2_RN_RM_RT_REG;
+            return I_LDRSH; // register
+        }
+        else if((op2 & 0x24) == 0x24) {
+            d->instr_imm_type = T_THUMB2_IMM8;
+            d->instr_flag_type = T_THUMB2_WUP_FLAG;
+            return I_LDRSH; // immediate 8 bit
+        }
+        else if((op2 & 0x3c) == 0x30) {
+            if(Rt == b1111) {
+                return I_NOP;
+            }
+
+            d->instr_imm_type = T_THUMB2_IMM8;
+            d->instr_flag_type = T_THUMB2_WUP_FLAG;
+            return I_LDRSH; // immediate 8 bit
+        }
+        else if ((op2 & 0x3c) == 0x38) {
+            d->instr_imm_type = T_THUMB2_IMM8;
+            return I_LDRSHT;
+        }
+    }
+    else if(op1 == 3) {
+        if(Rt == b1111) {
+            return I_NOP;
+        }
+
+        return I_LDRSH; // immediate 12 bit
+    }
+
+    return I_INVLD;
+}
+
+darm_instr_t thumb2_load_word(darm_t *d, uint16_t w, uint16_t w2)
+{
+    uint32_t op1 = (w >> 7) & b11;
+    uint32_t op2 = (w2 >> 6) & 0x3f;
+    uint32_t Rn = w & b1111;
+
+    d->instr_type = T_THUMB2_RN_RT_REG;
+    d->instr_imm_type = T_THUMB2_IMM8;
+    d->instr_flag_type = T_THUMB2_NO_FLAG;
+    d->Rn = Rn;
+
+    if((op1 & 2) == 0 && Rn == b1111) {
+        d->instr_type = T_THUMB2_RT_REG;
+        d->instr_imm_type = T_THUMB2_IMM12;
+        d->instr_flag_type = T_THUMB2_U_FLAG;
+        return I_LDR; // literal
+    }
+    else if(op1 == 1 && Rn != b1111) {
+        d->instr_imm_type = T_THUMB2_IMM12;
+        return I_LDR; // immediate
+    }
+    else if(op1 == 0 && Rn != b1111) {
+        if(op2 == 0) { d->instr_type = T_THUMB2_RN_RM_RT_REG;
+            d->instr_imm_type = T_THUMB2_IMM2;
+            return I_LDR; // register
+        }
+        else if((op2 & 0x3c) == 0x30 || (op2 & 0x24) == 0x24) {
+            d->instr_flag_type = T_THUMB2_WUP_FLAG;
+
+            // POP pseudo single register if Rn == SP,
+            // U and W are set, and imm == 4
+            if((w & 0xf) == b1101 && (w2 & 0xfff) == 0xb04) {
+                d->instr_type = T_THUMB2_RT_REG;
+                d->instr_imm_type = T_THUMB2_NO_IMM;
+                d->instr_flag_type = T_THUMB2_NO_FLAG;
+                return I_POP;
+            }
+
+            return I_LDR; // immediate
+        }
+        else if((op2 & 0x3c) == 0x38) {
+            return I_LDRT;
+        }
+    }
+
+    return I_INVLD;
+}
+
+darm_instr_t thumb2_parallel_signed(darm_t *d, uint16_t w, uint16_t w2)
+{
+    uint32_t op1 = (w >> 4) & b111;
+    uint32_t op2 = (w2 >> 4) & b11;
+
+    d->instr_type = T_THUMB2_RN_RD_RM_REG;
+    d->instr_imm_type = T_THUMB2_NO_IMM;
+    d->instr_flag_type = T_THUMB2_NO_FLAG;
+
+    if(op2 == 0) {
+        switch (op1) {
+        case 0:
+            return I_SADD8;
+
+        case 1:
+            return I_SADD16;
+
+        case 2:
+            return I_SASX;
+
+        case 4:
+            return I_SSUB8;
+
+        case 5:
+            return I_SSUB16;
+
+        case 6:
+            return I_SSAX;
+        }
+    }
+    else if(op2 == 1) {
+        switch (op1) {
+        case 0:
+            return I_QADD8;
+
+        case 1:
+            return I_QADD16;
+
+        case 2:
+            return I_QASX;
+
+        case 4:
+            return I_QSUB8;
+
+        case 5:
+            return I_QSUB16;
+
+        case 6:
+            return I_QSAX;
+        }
+    }
+    else if(op2 == 2) {
+        switch (op1) {
+        case 0:
+            return I_SHADD8;
+
+        case 1:
+            return I_SHADD16;
+
+        case 2:
+            return I_SHASX;
+
+        case 4:
+            return I_SHSUB8;
+
+        case 5:
+            return I_SHSUB16;
+
+        case 6:
+            return I_SHSAX;
+        }
+    }
+
+    return I_INVLD;
+}
+
+darm_instr_t thumb2_parallel_unsigned(darm_t *d, uint16_t w, uint16_t w2)
+{
+    uint32_t op1 = (w >> 4) & b111;
+    uint32_t op2 = (w2 >> 4) & b11;
+
+    d->instr_type = T_THUMB2_RN_RD_RM_REG;
+    d->instr_imm_type = T_THUMB2_NO_IMM;
+    d->instr_flag_type = T_THUMB2_NO_FLAG;
+
+    if(op2 == 0) {
+        switch (op1) {
+        case 0:
+            return I_UADD8;
+
+        case 1:
+            return I_UADD16;
+
+        case 2:
+            return I_UASX;
+
+        case 4:
+            return I_USUB8;
+
+        case 5:
+            return I_USUB16;
+
+        case 6:
+            return I_USAX;
+        }
+    }
+    else if(op2 == 1) {
+        switch (op1) {
+        case 0:
+            return I_UQADD8;
+
+        case 1:
+            return I_UQADD16;
+
+        case 2:
+            return I_UQASX;
+
+        case 4:
+            return I_UQSUB8;
+
+        case 5:
+            return I_UQSUB16;
+
+        case 6:
+            return I_UQSAX;
+        }
+    }
+    else if(op2 == 2) {
+        switch (op1) {
+        case 0:
+            return I_UHADD8;
+
+        case 1:
+            return I_UHADD16;
+
+        case 2:
+            return I_UHASX;
+
+        case 4:
+            return I_UHSUB8;
+
+        case 5:
+            return I_UHSUB16;
+
+        case 6:
+            return I_UHSAX;
+        }
+    }
+
+    return I_INVLD;
+}
+
+darm_instr_t thumb2_misc_op(darm_t *d, uint16_t w, uint16_t w2)
+{
+    uint32_t op1 = (w >> 4) & b11;
+    uint32_t op2 = (w2 >> 4) & b11;
+
+    if(((w2 >> 12) & b1111) != b1111) {
+        return I_INVLD;
+    }
+
+    d->instr_type = T_THUMB2_RN_RD_RM_REG;
+    d->instr_imm_type = T_THUMB2_NO_IMM;
+    d->instr_flag_type = T_THUMB2_NO_FLAG;
+
+    switch (op1) {
+    case 0:
+        switch (op2) {
+        case 0:
+            return I_QADD;
+
+        case 1:
+            return I_QDADD;
+
+        case 2:
+            return I_QSUB;
+
+        case 3:
+            return I_QDSUB;
+        }
+
+    case 1:
+        d->instr_type = T_THUMB2_RD_RM_REG;
+        switch (op2) {
+        case 0:
+            return I_REV;
+
+
+        case 1:
+            return I_REV16;
+
+
+        case 2:
+            return I_RBIT;
+
+
+        case 3:
+            return I_REVSH;
+        }
+
+    case 2:
+        if(op2 == 0) {
+            return I_SEL;
+        }
+        break;
+
+    case 3:
+        if(op2 == 0) {
+            d->instr_type = T_THUMB2_RD_RM_REG;
+            return I_CLZ;
+        }
+        break;
+    }
+
+    return I_INVLD;
+}
+
+darm_instr_t thumb2_data_reg(darm_t *d, uint16_t w, uint16_t w2)
+{
+    uint32_t op1 = (w >> 4) & b1111;
+    uint32_t op2 = (w2 >> 4) & b1111;
+    uint32_t Rn = w & b1111;
+
+    d->instr_type = T_THUMB2_RN_RD_RM_REG;
+    d->instr_imm_type = T_THUMB2_NO_IMM;
+    d->instr_flag_type = T_THUMB2_ROTATE_FLAG;
+
+    if(op2 == 0 && (op1 & b1000) == 0) {
+        d->instr_flag_type = T_THUMB2_S_FLAG;
+        switch (op1 & b1110) {
+        case 0:
+            return I_LSL; // register
+
+        case 2:
+            return I_LSR; // register
+
+        case 4:
+            return I_ASR; // register
+
+        case 6:
+            return I_ROR; // register
+        }
+    }
+    else if(op1 < 8 && (op2 & b1000) == 8) {
+        d->instr_flag_type = T_THUMB2_ROTATE_FLAG;
+        switch(op1) {
+        case 0:
+            if(Rn == b1111) {
+                d->instr_type = T_THUMB2_RD_RM_REG;
+                return I_SXTH;
+            }
+
+            return I_SXTAH;
+
+        case 1:
+            if(Rn == b1111) {
+                d->instr_type = T_THUMB2_RD_RM_REG;
+                return I_UXTH;
+            }
+
+            return I_UXTAH;
+
+        case 2:
+            if(Rn == b1111) {
+                d->instr_type = T_THUMB2_RD_RM_REG;
+                return I_SXTB16;
+            }
+
+            return I_SXTAB16;
+
+        case 3:
+            if(Rn == b1111) {
+                d->instr_type = T_THUMB2_RD_RM_REG;
+                return I_UXTB16;
+            }
+
+            return I_UXTAB16;
+
+        case 4:
+            if(Rn == b1111) {
+                d->instr_type = T_THUMB2_RD_RM_REG;
+                return I_SXTB;
+            }
+
+            return I_SXTAB;
+
+        case 5:
+            if(Rn == b1111) {
+                d->instr_type = T_THUMB2_RD_RM_REG;
+                return I_UXTB;
+            }
+
+            return I_UXTAB;
+        }
+    }
+    else if((op1 & b1000) == 8 && (op2 & b1100) == 0) {
+        return thumb2_parallel_signed(d, w, w2);
+    }
+    else if((op1 & b1000) == 8 && (op2 & b1100) == 4) {
+        return thumb2_parallel_unsigned(d, w, w2);
+    }
+    else if((op1 & b1100) == 8 && (op2 & b1100) == 8) {
+        return thumb2_misc_op(d, w, w2);
+    }
+
+    return I_INVLD;
+}
+
+darm_instr_t thumb2_nm_decoder(darm_t *d, uint16_t w, uint16_t w2,
+    darm_instr_t i1, darm_instr_t i2, darm_instr_t i3, darm_instr_t i4)
+{
+    (void) d; (void) w;
+
+    uint32_t n = (w2 >> 5) & 1;
+    uint32_t m = (w2 >> 4) & 1;
+
+    if(n == 1) {
+        if(m == 1) {
+            return i4;
+        }
+
+        return i3;
+    }
+    else {
+        if(m == 1) {
+            return i2;
+        }
+
+        return i1;
+    }
+
+    return I_INVLD;
+}
+
+darm_instr_t thumb2_mult_acc_diff(darm_t *d, uint16_t w, uint16_t w2)
+{
+    uint32_t op1 = (w >> 4) & b111;
+    uint32_t op2 = (w2 >> 4) & b11;
+    uint32_t Ra = (w2 >> 12) & b1111;
+
+    if(((w2 >> 6) & b11) != 0) {
+        return I_INVLD;
+    }
+
+    d->instr_type = T_THUMB2_RN_RD_RM_RA_REG;
+    d->instr_imm_type = T_THUMB2_NO_IMM;
+    d->instr_flag_type = T_THUMB2_NO_FLAG;
+
+    if(op1 == 1) {
+        if(Ra == b1111) {
+            return thumb2_nm_decoder(d, w, w2,
+                I_SMULBB, I_SMULBT, I_SMULTB, I_SMULTT);
+        }
+
+        return thumb2_nm_decoder(d, w, w2,
+            I_SMLABB, I_SMLABT, I_SMLATB, I_SMLATT);
+    }
+
+    if((op2 & 2) != 0) {
+        return I_INVLD;
+    }
+
+    switch (op1) {
+    case 0:
+        if(op2 == 0 && Ra == b1111) {
+            d->instr_type = T_THUMB2_RN_RD_RM_REG;
+            return I_MUL;
+        }
+        else if(op2 == 0 && Ra != b1111) {
+            return I_MLA;
+        }
+        else if(op2 == 1) {
+            return I_MLS;
+        }
+
+        break;
+
+    case 2:
+        if(Ra == b1111) {
+            d->instr_type = T_THUMB2_RN_RD_RM_REG;
+            return I_SMUAD;
+        }
+
+        return I_SMLAD;
+
+    case 3:
+        // B or T variant indicated by M bit but not encoded
+        // in the instruction name
+        if(Ra == b1111) {
+            d->instr_type = T_THUMB2_RN_RD_RM_REG;
+            return I_SMULW;
+        }
+
+        return I_SMLAW;
+
+    case 4:
+        if(Ra == b1111) {
+            d->instr_type = T_THUMB2_RN_RD_RM_REG;
+            return I_SMUSD;
+        }
+
+        return I_SMLSD;
+
+    case 5:
+        if(Ra == b1111) {
+            d->instr_type = T_THUMB2_RN_RD_RM_REG;
+            return I_SMMUL;
+        }
+
+        return I_SMMLA;
+
+    case 6:
+        return I_SMMLS;
+
+    case 7:
+        if(op2 == 0 && Ra == b1111) {
+            d->instr_type = T_THUMB2_RN_RD_RM_REG;
+            return I_USAD8;
+        }
+        else if(op2 == 0) {
+            return I_USADA8;
+        }
+
+        break;
+    }
+
+    return I_INVLD;
+}
+
+darm_instr_t thumb2_long_mult_acc(darm_t *d, uint16_t w, uint16_t w2)
+{
+    uint32_t op1 = (w >> 4) & b111;
+    uint32_t op2 = (w2 >> 4) & b1111;
+
+    d->instr_type = T_THUMB2_RN_RM_REG;
+    d->instr_imm_type = T_THUMB2_NO_IMM;
+    d->instr_flag_type = T_THUMB2_NO_FLAG;
+
+    switch (op1) {
+    case 0:
+        if(op2 == 0) {
+            return I_SMULL;
+        }
+
+        break;
+
+    case 1:
+        if(op2 == b1111) {
+            d->instr_type = T_THUMB2_RN_RD_RM_REG;
+            return I_SDIV;
+        }
+
+        break;
+
+    case 2:
+        if(op2 == 0) {
+            return I_UMULL;
+        }
+
+        break;
+
+    case 3:
+        if(op2 == b1111) {
+            d->instr_type = T_THUMB2_RN_RD_RM_REG;
+            return I_UDIV;
+        }
+
+        break;
+
+    case 4:
+        if(op2 == 0) {
+            return I_SMLAL;
+        }
+        else if((op2 & b1100) == b1000) {
+            return thumb2_nm_decoder(d, w, w2,
+                I_SMLALBB, I_SMLALBT, I_SMLALTB, I_SMLALTT);
+        }
+        else if((op2 & b1110) == b1100) {
+            return I_SMLALD;
+        }
+
+        break;
+
+    case 5:
+        if((op2 & b1110) == b1100) {
+            return I_SMLSLD;
+        }
+
+        break;
+
+    case 6:
+        if(op2 == 0) {
+            return I_UMLAL;
+        }
+        else if(op2 == b110) {
+            return I_UMAAL;
+        }
+
+        break;
+    }
+
+    return I_INVLD;
+}
+
+darm_instr_t thumb2_coproc_simd(darm_t *d, uint16_t w, uint16_t w2)
+{
+    (void) d; (void) w; (void) w2;
+
+    // TODO implement
+    return I_INVLD;
+}
+
+// ---- thumb2.c ----
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#define BITMSK_8 ((1 << 8) - 1)
+#define ROR(val, rotate) (((val) >> (rotate)) | ((val) << (32 - (rotate))))
+#define SIGN_EXTEND32(v, len) (((int32_t)(v) << (32 - len)) >> (32 - len))
+
+// concatenates the immediate fields selected by one of the THUMB2_PEXT_*
+// masks (generated by darmgen.py) of (w << 16) | w2 using a single pext
+// when compiled for BMI2, e.g., with -mbmi2, otherwise the equivalent
+// shifts are used
+#ifdef __BMI2__
+#include <immintrin.h>
+#define THUMB2_FIELDS(w, w2, mask, shifts) \
+    _pext_u32(((uint32_t)(w) << 16) | (w2), (mask))
+#else
+#define THUMB2_FIELDS(w, w2, mask, shifts) (shifts)
+#endif
+
+void thumb2_parse_reg(darm_t *d, uint16_t w, uint16_t w2);
+void thumb2_parse_imm(darm_t *d, uint16_t w, uint16_t w2);
+void thumb2_parse_flag(darm_t *d, uint16_t w, uint16_t w2);
+void thumb2_parse_misc(darm_t *d, uint16_t w, uint16_t w2);
+
+// 12 -> 32 bit expansion function
+// See manual for this
+// We don't care about the carry for the moment (should we?)
+uint32_t thumb_expand_imm(uint16_t imm12)
+{
+    uint32_t value;
+
+    imm12 &= 0xfff;
+
+    if((imm12 & 0xc00) == 0) {
+        switch ((imm12 & 0x300) >> 8) {
+        case 0:
+            value = imm12 & 0xff;
+            break;
+
+        case 1:
+            value = ((imm12 & 0xff) << 16) | (imm12 & 0xff);
+            break;
+
+        case 2:
+            value = ((imm12 & 0xff) << 24) | ((imm12 & 0xff) << 8);
+            break;
+
+        case 3:
+            imm12 &= 0xff;
+            value = imm12 | (imm12 << 8) | (imm12 << 16) | (imm12 << 24);
+            break;
+        }
+    }
+    else {
+        uint32_t unrotated = 0x80 | (imm12 & 0x7F);
+        value = ROR(unrotated, (imm12 & 0xF80) >> 7);
+    }
+
+    return value;
+}
+
+void thumb2_decode_immshift(darm_t *d, uint8_t type, uint8_t imm5)
+{
+    switch (type) {
+    case 0:
+        d->shift_type = S_LSL;
+        d->shift = imm5;
+        break;
+
+    case 1:
+        d->shift_type = S_LSR;
+        d->shift = imm5 == 0 ? 32 : imm5;
+        break;
+
+    case 2:
+        d->shift_type = S_ASR;
+        d->shift = imm5 == 0 ? 32 : imm5;
+        break;
+
+    case 3:
+        d->shift_type = S_ROR;
+        d->shift = imm5 == 0 ? 1 : imm5; // RRX! :)
+        break;
+
+    default:
+        d->shift_type = S_INVLD;
+        break;
+    }
+}
+
+// Parse the register instruction type, the type is passed along so that it's
+// folded into straight-line code by the extractors in thumb2_disasm
+static inline void _thumb2_reg(darm_t *d, uint16_t w, uint16_t w2,
+    darm_enctype_t type)
+{
+    switch (type) {
+    case T_THUMB2_NO_REG:
+        break;
+
+    case T_THUMB2_RT_REG:
+        d->Rt = (w2 >> 12) & b1111;
+        break;
+
+    case T_THUMB2_RT_RT2_REG:
+        d->Rt = (w2 >> 12) & b1111;
+        d->Rt2 = (w2 >> 8) & b1111;
+        break;
+
+    case T_THUMB2_RM_REG:
+        d->Rm = (w & b1111);
+        break;
+
+    case T_THUMB2_RD_REG:
+        d->Rd = (w2 >> 8) & b1111;
+        break;
+
+    case T_THUMB2_RD_RM_REG:
+        d->Rd = (w2 >> 8) & b1111;
+        d->Rm = w2 & b1111;
+        break;
+
+    case T_THUMB2_RN_REG:
+        d->Rn = w & b1111;
+        break;
+
+    case T_THUMB2_RN_RT_REG:
+        d->Rn = w & b1111;
+        d->Rt = (w2 >> 12) & b1111;
+        break;
+
+    case T_THUMB2_RN_RT_RT2_REG:
+        d->Rn = w & b1111;
+        d->Rt = (w2 >> 12) & b1111;
+        d->Rt2 = (w2 >> 8) & b1111;
+        break;
+
+    case T_THUMB2_RN_RM_REG:
+        d->Rn = w & b1111;
+        d->Rm = w2 & b1111;
+        break;
+
+    case T_THUMB2_RN_RM_RT_REG:
+        d->Rn = w & b1111;
+        d->Rm = w2 & b1111;
+        d->Rt = (w2 >> 12) & b1111;
+        break;
+
+    case T_THUMB2_RN_RD_REG:
+        d->Rn = w & b1111;
+        d->Rd = (w2 >> 8) & b1111;
+        break;
+
+    case T_THUMB2_RN_RD_RT_REG:
+        d->Rn = (w & b1111);
+        d->Rd = (w2 & b1111);
+        d->Rt = (w2 >> 12) & b1111;
+        break;
+
+    case T_THUMB2_RN_RD_RT_RT2_REG:
+        d->Rn = (w & b1111);
+        d->Rd = (w2 & b1111);
+        d->Rt = (w2 >> 12) & b1111;
+        d->Rt2 = (w2 >> 8) & b1111;
+        break;
+
+    case T_THUMB2_RN_RD_RM_REG:
+        d->Rn = w & b1111;
+        d->Rm = w2 & b1111;
+        d->Rd = (w2 >> 8) & b1111;
+        break;
+
+    case T_THUMB2_RN_RD_RM_RA_REG:
+        d->Rn = w & b1111;
+        d->Rm = w2 & b1111;
+        d->Rd = (w2 >> 8) & b1111;
+        d->Ra = (w2 >> 12) & b1111;
+        break;
+
+    default:
+        break;
+    }
+}
+
+// Parse the immediate instruction type, the type is passed along so that it's
+// folded into straight-line code by the extractors in thumb2_disasm
+static inline void _thumb2_imm(darm_t *d, uint16_t w, uint16_t w2,
+    darm_enctype_t type)
+{
+    d->I = B_SET;
+
+    switch (type) {
+    case T_THUMB2_NO_IMM:
+        d->I = B_UNSET;
+        break;
+
+    case T_THUMB2_IMM12:
+        d->imm = w2 & 0xfff;
+        break;
+
+    case T_THUMB2_IMM8:
+        d->imm = w2 & 0xff;
+        break;
+
+    case T_THUMB2_IMM2:
+        // 2 bit immediate
+        d->imm = (w2 >> 4) & b11;
+        d->shift = d->imm;
+        d->shift_type = S_LSL;
+        break;
+
+    case T_THUMB2_IMM2_IMM3:
+        // 2 and 3 bit immediates
+        // (imm3:imm2)
+        d->imm = THUMB2_FIELDS(w, w2, THUMB2_PEXT_IMM2_IMM3,
+            ((w2 >> 10) & b11100) | ((w2 >> 6) & b11));
+        break;
+
+    case T_THUMB2_IMM1_IMM3_IMM8:
+        // 1, 3 and 8 bit immediates
+        // i:imm3:imm8 -> imm12 -> imm32
+
+        d->imm = THUMB2_FIELDS(w, w2, THUMB2_PEXT_IMM1_IMM3_IMM8,
+            ((w & 0x400) << 1) | ((w2 & 0x7000) >> 4) | (w2 & 0xff));
+
+        // if bits 9:8 == '10' then zero extend, otherwise thumb expand
+        if((w & 0x300) != 0x200) {
+            d->imm = thumb_expand_imm(d->imm);
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+// Parse the flag instruction type, the type is passed along so that it's
+// folded into straight-line code by the extractors in thumb2_disasm
+static inline void _thumb2_flag(darm_t *d, uint16_t w, uint16_t w2,
+    darm_enctype_t type)
+{
+    switch (type) {
+    case T_THUMB2_NO_FLAG:
+        break;
+
+    case T_THUMB2_ROTATE_FLAG:
+        // Rotate field
+        d->rotate = (w2 >> 1) & b11000;
+        break;
+
+    case T_THUMB2_U_FLAG:
+        // U flag
+        d->U = (w >> 7) & 1 ? B_SET : B_UNSET;
+        break;
+
+    case T_THUMB2_WUP_FLAG:
+        // W, U and P flags
+        d->W = (w2 >> 8) & 1 ? B_SET : B_UNSET;
+        d->U = (w2 >> 9) & 1 ? B_SET : B_UNSET;
+        d->P = (w2 >> 10) & 1 ? B_SET : B_UNSET;
+        break;
+
+    case T_THUMB2_TYPE_FLAG:
+        // Type field
+        // This is always a T_THUMB2_IMM2_IMM3 type
+        thumb2_decode_immshift(d, (w2 >> 4) & 3, d->imm);
+        break;
+
+    case T_THUMB2_REGLIST_FLAG:
+        // Reglist field
+        d->reglist = w2 & 0xffff;
+        break;
+
+    case T_THUMB2_WP_REGLIST_FLAG:
+        // Reglist field and W, P flags
+        d->reglist = w2 & 0xffff;
+        d->W = (w >> 5) & 1 ? B_SET : B_UNSET;
+        //d->P = (w >> 15) & 1 ? B_SET : B_UNSET;
+        break;
+
+    case T_THUMB2_S_FLAG:
+        // S flag
+        d->S = (w >> 4) & 1 ? B_SET : B_UNSET;
+        break;
+
+    case T_THUMB2_S_TYPE_FLAG:
+        // S flag and type field
+        d->S = (w >> 4) & 1 ? B_SET : B_UNSET;
+        thumb2_decode_immshift(d, (w2 >> 4) & 3, d->imm);
+        break;
+
+    default:
+        break;
+    }
+}
+
+void thumb2_parse_reg(darm_t *d, uint16_t w, uint16_t w2)
+{
+    _thumb2_reg(d, w, w2, d->instr_type);
+}
+
+void thumb2_parse_imm(darm_t *d, uint16_t w, uint16_t w2)
+{
+    _thumb2_imm(d, w, w2, d->instr_imm_type);
+}
+
+void thumb2_parse_flag(darm_t *d, uint16_t w, uint16_t w2)
+{
+    _thumb2_flag(d, w, w2, d->instr_flag_type);
+}
+
+// Parse misc instruction cases
+void thumb2_parse_misc(darm_t *d, uint16_t w, uint16_t w2)
+{
+#ifdef DARM_THREADED_DISPATCH
+    DISPATCH_TABLE(targets, I_INSTRCNT, misc_other)
+        [I_B] = &&misc_b,
+        [I_BL] = &&misc_bl,
+        [I_BLX] = &&misc_bl,
+        [I_BFC] = &&misc_bfc,
+        [I_BFI] = &&misc_bfc,
+        [I_LSL] = &&misc_lsl,
+        [I_LSR] = &&misc_lsl,
+        [I_ASR] = &&misc_lsl,
+        [I_ROR] = &&misc_lsl,
+        [I_MOVW] = &&misc_movw,
+        [I_MOVT] = &&misc_movw,
+        [I_CMP] = &&misc_cmp,
+        [I_CMN] = &&misc_cmp,
+        [I_TEQ] = &&misc_cmp,
+        [I_TST] = &&misc_cmp,
+        [I_DBG] = &&misc_dbg,
+        [I_DMB] = &&misc_dbg,
+        [I_DSB] = &&misc_dbg,
+        [I_ISB] = &&misc_dbg,
+        [I_LDC] = &&misc_ldc,
+        [I_LDC2] = &&misc_ldc,
+        [I_STC] = &&misc_ldc,
+        [I_STC2] = &&misc_ldc,
+        [I_STREX] = &&misc_strex,
+        [I_LDRD] = &&misc_ldrd,
+        [I_LDREX] = &&misc_ldrd,
+        [I_STRD] = &&misc_ldrd,
+        [I_POP] = &&misc_pop,
+        [I_PUSH] = &&misc_pop,
+        [I_MCR] = &&misc_mcr,
+        [I_MCR2] = &&misc_mcr,
+        [I_MRC] = &&misc_mcr,
+        [I_MRC2] = &&misc_mcr,
+        [I_MCRR] = &&misc_mcrr,
+        [I_MCRR2] = &&misc_mcrr,
+        [I_MRRC] = &&misc_mcrr,
+        [I_MRRC2] = &&misc_mcrr,
+        [I_MSR] = &&misc_msr,
+        [I_PKH] = &&misc_pkh,
+        [I_PLI] = &&misc_pli,
+        [I_PLD] = &&misc_pld,
+        [I_SBFX] = &&misc_sbfx,
+        [I_UBFX] = &&misc_sbfx,
+        [I_SMLABB] = &&misc_smlabb,
+        [I_SMLABT] = &&misc_smlabb,
+        [I_SMLATB] = &&misc_smlabb,
+        [I_SMLATT] = &&misc_smlabb,
+        [I_SMULBB] = &&misc_smlabb,
+        [I_SMULBT] = &&misc_smlabb,
+        [I_SMULTB] = &&misc_smlabb,
+        [I_SMULTT] = &&misc_smlabb,
+        [I_SMLAD] = &&misc_smlad,
+        [I_SMLAW] = &&misc_smlad,
+        [I_SMLSD] = &&misc_smlad,
+        [I_SMUAD] = &&misc_smlad,
+        [I_SMULW] = &&misc_smlad,
+        [I_SMUSD] = &&misc_smlad,
+        [I_SMLALBB] = &&misc_smlalbb,
+        [I_SMLALBT] = &&misc_smlalbb,
+        [I_SMLALTB] = &&misc_smlalbb,
+        [I_SMLALTT] = &&misc_smlalbb,
+        [I_SMLSLD] = &&misc_smlsld,
+        [I_SMLALD] = &&misc_smlsld,
+        [I_SMLAL] = &&misc_smlal,
+        [I_SMULL] = &&misc_smlal,
+        [I_UMAAL] = &&misc_smlal,
+        [I_UMLAL] = &&misc_smlal,
+        [I_UMULL] = &&misc_smlal,
+        [I_SMMLA] = &&misc_smmla,
+        [I_SMMLS] = &&misc_smmla,
+        [I_SMMUL] = &&misc_smmla,
+        [I_SSAT] = &&misc_ssat,
+        [I_USAT] = &&misc_ssat,
+        [I_SSAT16] = &&misc_ssat16,
+        [I_USAT16] = &&misc_ssat16,
+        [I_STM] = &&misc_stm,
+        [I_STMDB] = &&misc_stm,
+        [I_TBB] = &&misc_tbb,
+        [I_TBH] = &&misc_tbb,
+    DISPATCH_END()
+    DISPATCH(targets, d->instr);
+#endif
+
+    switch (d->instr) {
+    case I_B: DISPATCH_TARGET(misc_b)
+        d->I = B_SET;
+        d->S = (w >> 10) & 1 ? B_SET : B_UNSET;
+        if ((w2 & 0x1000) == 0) {
+            // T3
+            // sign_extend(S:J2:J1:imm6:imm11:0, 32)
+            d->imm =
+                ((w & 0x400) << 10) |
+                ((w2 & 0x800) << 8) |
+                ((w2 & 0x2000) << 5) |
+                (THUMB2_FIELDS(w, w2, THUMB2_PEXT_IMM6_IMM11,
+                    ((w & 0x3F) << 11) | (w2 & 0x7ff)) << 1);
+            d->imm = SIGN_EXTEND32(d->imm, 21);
+            d->cond = (w >> 6) & b1111;
+        }
+        else {
+            // T4
+            // I1 = not(J1 xor S);
+            // I2 = not(J2 xor S);
+            // imm32 = sign_extend(S:I1:I2:imm10:imm11:0, 32)
+            d->imm =
+                ((w & 0x400) << 14) |
+                (((~(w2 >> 13) ^ (w >> 10)) & 1) << 23) |
+                ((~((w2 >> 11) ^ (w >> 10)) & 1) << 22) |
+                (THUMB2_FIELDS(w, w2, THUMB2_PEXT_IMM10_IMM11,
+                    ((w & 0x3FF) << 11) | (w2 & 0x7FF)) << 1);
+            d->imm = SIGN_EXTEND32(d->imm, 25);
+        }
+        break;
+
+    case I_BL: case I_BLX: DISPATCH_TARGET(misc_bl)
+        d->I = B_SET;
+        d->S = (w >> 10) & 1 ? B_SET : B_UNSET;
+        if ((w2 & 0x1000) == 0) {
+            // BLX
+            // I1 = not(J1 xor S); I2 = not(J2 xor S); imm32 = sign_extend(S:I1:I2:imm10H:imm10L:00, 32)
+            d->imm =
+                ((w & 0x400) << 14) |
+                ((~((w2 >> 13) ^ (w >> 10)) & 1) << 23) |
+                ((~((w2 >> 11) ^ (w >> 10)) & 1) << 22) |
+                (THUMB2_FIELDS(w, w2, THUMB2_PEXT_IMM10H_IMM10L,
+                    ((w & 0x3FF) << 10) | ((w2 & 0x7FE) >> 1)) << 2);
+            d->imm = SIGN_EXTEND32(d->imm, 25);
+            d->H = (w & 1) ? B_SET : B_UNSET;
+        }
+        else {
+            // BL
+            // I1 = not(J1 xor S); I2 = not(J2 xor S); imm32 = sign_extend(S:I1:I2:imm10:imm11:0, 32)
+            d->imm =
+                ((w & 0x400) << 14) |
+                (((~((w2 >> 13) ^ (w >> 10))) & 1) << 23) |
+                ((~((w2 >> 11) ^ (w >> 10)) & 1) << 22) |
+                (THUMB2_FIELDS(w, w2, THUMB2_PEXT_IMM10_IMM11,
+                    ((w & 0x3FF) << 11) | (w2 & 0x7FF)) << 1);
+            d->imm = SIGN_EXTEND32(d->imm, 25);
+        }
+        break;
+
+    case I_BFC: case I_BFI: DISPATCH_TARGET(misc_bfc)
+        d->lsb = d->imm & 0x1f;
+        d->msb = w2 & 0x1f;
+        d->width = d->msb + 1 - d->lsb;
+        break;
+
+    case I_LSL: case I_LSR: case I_ASR: case I_ROR: DISPATCH_TARGET(misc_lsl)
+        if(d->I == B_SET) {
+            d->shift = d->imm;
+            d->shift_type = ((w2 >> 4) & b11);
+        }
+        break;
+
+    case I_MOVW: case I_MOVT: DISPATCH_TARGET(misc_movw)
+        d->imm =
+            ((w & b1111) << 12) |
+            THUMB2_FIELDS(w, w2, THUMB2_PEXT_IMM1_IMM3_IMM8,
+                ((w & 0x400) << 1) | ((w2 & 0x7000) >> 4) | (w2 & 0xff));
+        break;
+
+    // preserve PC in Rd for further use (?)
+    case I_CMP: case I_CMN: case I_TEQ: case I_TST: DISPATCH_TARGET(misc_cmp)
+        d->Rd = PC;
+        break;
+
+    // option field
+    case I_DBG: case I_DMB: case I_DSB: case I_ISB: DISPATCH_TARGET(misc_dbg)
+        d->option = w2 & b1111;
+        break;
+
+    // co-proc data processing
+    // TODO: not implemented
+    //case I_CPD: case I_CPD2:
+    //break;
+
+    // co-proc load/store memory
+    case I_LDC: case I_LDC2:
+    case I_STC: case I_STC2: DISPATCH_TARGET(misc_ldc)
+        d->P = (w >> 8) & 1 ? B_SET : B_UNSET;
+        d->U = (w >> 7) & 1 ? B_SET : B_UNSET;
+        d->D = (w >> 6) & 1 ? B_SET : B_UNSET;
+        d->W = (w >> 5) & 1 ? B_SET : B_UNSET;
+
+        // literal or immediate
+        d->Rn = (w & b1111) == b1111 ? R_INVLD : (w & b1111);
+
+        d->I = B_SET;
+        d->imm = (w2 & 0xff) << 2;
+        d->coproc = (w2 >> 8) & b1111;
+        d->CRd = (w2 >> 12) & b1111;
+        break;
+
+    // Weird Rd offset
+    case I_STREX: DISPATCH_TARGET(misc_strex)
+        d->Rd = (w2 >> 8) & b1111;
+        d->imm = (w2 & 0xff) << 2;
+        break;
+
+    // zero-extend corner case with '00' appended
+    case I_LDRD: case I_LDREX: case I_STRD: DISPATCH_TARGET(misc_ldrd)
+        d->imm = (w2 & 0xff) << 2;
+        d->W = (w >> 5) & 1 ? B_SET : B_UNSET;
+        d->U = (w >> 7) & 1 ? B_SET : B_UNSET;
+        d->P = (w >> 8) & 1 ? B_SET : B_UNSET;
+        break;
+
+    // Catch some pop/push inconsistencies
+    case I_POP: case I_PUSH: DISPATCH_TARGET(misc_pop)
+        // no flags, TODO fixup
+        if(w == 0xf85d || w == 0xf84d) {
+            break;
+        }
+
+        // P flag
+        if(w == 0xe8bd) {
+            d->P = (w2 >> 15) & 1 ? B_SET : B_UNSET;
+        }
+
+        d->M = (w2 >> 14) & 1 ? B_SET : B_UNSET;
+        break;
+
+    // co-processor move
+    case I_MCR: case I_MCR2:
+    case I_MRC: case I_MRC2: DISPATCH_TARGET(misc_mcr)
+        d->CRm = w2 & b1111;
+        d->CRn = w & b1111;
+        d->coproc = (w2 >> 8) & b1111;
+        d->Rt = (w2 >> 12) & b1111;
+        d->opc1 = (w >> 5) & b111;
+        d->opc2 = (w2 >> 5) & b111;
+        break;
+
+    // co-proc move 2 reg
+    case I_MCRR: case I_MCRR2:
+    case I_MRRC: case I_MRRC2: DISPATCH_TARGET(misc_mcrr)
+        d->coproc = (w2 >> 8) & b1111;
+        d->Rt = (w2 >> 12) & b1111;
+        d->opc1 = (w2 >> 4) & b1111;
+        d->CRm = (w2 & b1111);
+        d->Rt2 = w & b1111;
+        break;
+
+    case I_MSR: DISPATCH_TARGET(misc_msr)
+        d->I = B_SET;
+        d->Rn = w & b1111;
+        d->mask = d->imm = (w2 >> 10) & b11;
+        break;
+
+    case I_PKH: DISPATCH_TARGET(misc_pkh)
+        // S flag and immediate already set
+        d->T = (w2 >> 4) & 1;
+        thumb2_decode_immshift(d, (w2 >> 4) & 2, d->imm);
+        break;
+
+    case I_PLI: DISPATCH_TARGET(misc_pli)
+        d->Rt = R_INVLD;
+        d->P = B_INVLD;
+        d->W = B_INVLD;
+        if(d->Rn == b1111) {
+            d->Rn = R_INVLD;
+            d->imm = w2 & 0xfff;
+            d->U = ((w >> 7) & 1) ? B_SET : B_UNSET;
+        }
+        break;
+
+    case I_PLD: DISPATCH_TARGET(misc_pld)
+        d->Rt = R_INVLD;
+        d->P = B_INVLD;
+        if(d->Rn == b1111) {
+            d->Rn = d->Rm = R_INVLD;
+            d->imm = w2 & 0xfff;
+            d->shift_type = S_INVLD;
+            d->shift = 0;
+            d->U = (w >> 7) & 1 ? B_SET : B_UNSET;
+        }
+        d->W = (w & b1111) != b1111 ? ((w >> 5) & 1) : B_INVLD;
+        break;
+
+    case I_SBFX: case I_UBFX: DISPATCH_TARGET(misc_sbfx)
+        d->lsb = d->imm;
+        d->width = (w2 & 0x1f) + 1;
+        break;
+
+    // N, M flags
+    case I_SMLABB: case I_SMLABT: case I_SMLATB: case I_SMLATT:
+    case I_SMULBB: case I_SMULBT: case I_SMULTB: case I_SMULTT: DISPATCH_TARGET(misc_smlabb)
+        d->N = (w2 >> 5) & 1 ? B_SET : B_UNSET;
+        // fall-through
+
+    case I_SMLAD: case I_SMLAW:
+    case I_SMLSD: case I_SMUAD:
+    case I_SMULW: case I_SMUSD: DISPATCH_TARGET(misc_smlad)
+        d->M = (w2 >> 4) & 1 ? B_SET : B_UNSET;
+        if(d->Ra == b1111) {
+            d->Ra = R_INVLD;
+        }
+        break;
+
+    // N, M, Rdhi, Rdlo flags
+    case I_SMLALBB: case I_SMLALBT: case I_SMLALTB: case I_SMLALTT: DISPATCH_TARGET(misc_smlalbb)
+        d->N = (w2 >> 5) & 1 ? B_SET : B_UNSET;
+        // fall-through
+
+    case I_SMLSLD: case I_SMLALD: DISPATCH_TARGET(misc_smlsld)
+        d->M = (w2 >> 4) & 1 ? B_SET : B_UNSET;
+        // fall-through
+
+    case I_SMLAL: case I_SMULL:
+    case I_UMAAL: case I_UMLAL: case I_UMULL: DISPATCH_TARGET(misc_smlal)
+        d->RdHi = (w2 >> 8) & b1111;
+        d->RdLo = (w2 >> 12) & b1111;
+        break;
+
+    case I_SMMLA: case I_SMMLS: case I_SMMUL: DISPATCH_TARGET(misc_smmla)
+        d->R = (w2 >> 4) & 1 ? B_SET : B_UNSET;
+        break;
+
+    case I_SSAT: case I_USAT: DISPATCH_TARGET(misc_ssat)
+        thumb2_decode_immshift(d, (w >> 4) & 2, d->imm);
+        d->sat_imm = w2 & 0x1f;
+        break;
+
+    case I_SSAT16: case I_USAT16: DISPATCH_TARGET(misc_ssat16)
+        d->sat_imm = w2 & 0xf;
+        break;
+
+    case I_STM: case I_STMDB: DISPATCH_TARGET(misc_stm)
+        d->W = (w >> 5) & 1 ? B_SET : B_UNSET;
+        d->M = (w2 >> 14) & 1 ? B_SET : B_UNSET;
+        break;
+
+    case I_TBB: case I_TBH: DISPATCH_TARGET(misc_tbb)
+        d->H = (w2 >> 4) & 1 ? B_SET : B_UNSET;
+        break;
+
+    default: DISPATCH_TARGET(misc_other)
+        break;
+    }
+}
+
+typedef void (*thumb2_extractor_t)(darm_t *d, uint16_t w, uint16_t w2);
+
+// one fused operand extractor for each combination of register, immediate
+// and flag type that is used by the thumb2 encodings (see darmgen.py)
+#define THUMB2_EXTRACTOR(reg, imm, flag) \
+    static void thumb2_extract_##reg##_##imm##_##flag(darm_t *d, \
+        uint16_t w, uint16_t w2) \
+    { \
+        _thumb2_reg(d, w, w2, T_THUMB2_##reg); \
+        _thumb2_imm(d, w, w2, T_THUMB2_##imm); \
+        _thumb2_flag(d, w, w2, T_THUMB2_##flag); \
+    }
+
+THUMB2_EXTRACTORS(THUMB2_EXTRACTOR)
+
+#define THUMB2_EXTRACTOR_ENTRY(reg, imm, flag) \
+    &thumb2_extract_##reg##_##imm##_##flag,
+
+// indexed by thumb2_extractor_index, the first entry is the fallback
+static const thumb2_extractor_t g_thumb2_extractors[] = {
+    NULL, THUMB2_EXTRACTORS(THUMB2_EXTRACTOR_ENTRY)
+};
+
+static int thumb2_disasm(darm_t *d, uint16_t w, uint16_t w2)
+{
+    d->instr = thumb2_decode_instruction(d, w, w2);
+    if(d->instr == I_INVLD) {
+        return -1;
+    }
+
+    uint32_t reg = d->instr_type - T_THUMB2_NO_REG;
+    uint32_t imm = d->instr_imm_type - T_THUMB2_NO_IMM;
+    uint32_t flag = d->instr_flag_type - T_THUMB2_NO_FLAG;
+
+    // a single table lookup selects the extractor which parses all operand
+    // types at once, other combinations go through the generic functions
+    uint32_t index = 0;
+    if(reg < THUMB2_REG_TYPES && imm < THUMB2_IMM_TYPES &&
+            flag < THUMB2_FLAG_TYPES) {
+        index = thumb2_extractor_index[
+            (reg * THUMB2_IMM_TYPES + imm) * THUMB2_FLAG_TYPES + flag];
+    }
+
+    if(index != 0) {
+        g_thumb2_extractors[index](d, w, w2);
+    }
+    else {
+        thumb2_parse_reg(d, w, w2);
+        thumb2_parse_imm(d, w, w2);
+        thumb2_parse_flag(d, w, w2);
+    }
+    thumb2_parse_misc(d, w, w2);
+    d->instr_type = T_INVLD;
+    darm_regs_update(d);
+    return 0;
+}
+
+// placeholder function for printing out thumb2 instructions
+// This is here until the format string problem is resolved
+// TODO: This lacks a lot of functionality, for debug only, replace with better function
+char *darm_thumb2_str(darm_t *d)
+{
+    int index=0, offset=0;
+    static char stringbuf[512];
+
+    for (int i = 0; i < THUMB2_INSTRUCTION_COUNT; i++) {
+        if(d->instr == thumb2_instr_labels[i]) {
+            index = i;
+            break;
+        }
+    }
+
+    offset += sprintf(stringbuf + offset, "%s",
+        thumb2_instruction_strings[index]);
+
+    if(d->Rd != R_INVLD) {
+        offset += sprintf(stringbuf+offset, "rd%i,", d->Rd);
+    }
+
+    if(d->Rt != R_INVLD) {
+        offset += sprintf(stringbuf+offset, "rt%i,", d->Rt2);
+    }
+
+    if(d->Rt2 != R_INVLD) {
+        offset += sprintf(stringbuf+offset, "rt2%i,", d->Rt);
+    }
+
+    if(d->Rn != R_INVLD) {
+        offset += sprintf(stringbuf+offset, "rn%i,", d->Rn);
+    }
+
+    if(d->Rm != R_INVLD) {
+        offset += sprintf(stringbuf+offset, "rm%i ", d->Rm);
+    }
+
+    if(d->I == B_SET) {
+        offset += sprintf(stringbuf+offset, "#0x%x", d->imm);
+    }
+
+    return stringbuf;
+}
+
+int darm_thumb2_disasm(darm_t *d, uint16_t w, uint16_t w2)
+{
+    darm_init(d);
+    d->w = (w << 16) | w2;
+
+    // we set all conditional flags to "execute always" by default, as most
+    // thumb instructions don't feature a conditional flag
+    d->cond = C_AL;
+
+    switch (w >> 11) {
+    case b11101: case b11110: case b11111:
+        return thumb2_disasm(d, w, w2);
+
+    default:
+        return -1;
+    }
+}
+#undef BITMSK_8
+#undef ROR
+#undef SIGN_EXTEND32
+#undef THUMB2_FIELDS
+#undef THUMB2_EXTRACTOR
+#undef THUMB2_EXTRACTOR_ENTRY
+
+// ---- valid.c ----
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#define VALID_MAGIC "DARMVLD1"
+
+// containers with more entries than this are stored as bitmap instead
+#define ARRAY_MAX 4096
+
+#define BITMAP_SIZE (DARM_VALID_BLOCK / 8)
+
+typedef struct _valid_header_t {
+    char            magic[8];
+    uint32_t        instr_count;
+    uint32_t        reserved;
+    uint64_t        data_size;
+} valid_header_t;
+
+// the containers are stored in little endian
+static inline uint16_t _read_le16(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+static inline void _write16(uint8_t *p, uint16_t value)
+{
+    p[0] = value & 0xff, p[1] = value >> 8;
+}
+
+static uint32_t _container_size(const darm_valid_entry_t *entry)
+{
+    switch ((darm_valid_type_t) entry->type) {
+    case V_ARRAY: case V_INVERTED:
+        return entry->count * sizeof(uint16_t);
+
+    case V_RUNS:
+        return entry->count * 2 * sizeof(uint16_t);
+
+    case V_BITMAP:
+        return BITMAP_SIZE;
+
+    default:
+        return 0;
+    }
+}
+
+uint32_t darm_valid_pack(const uint64_t *bits, uint8_t *out,
+    darm_valid_entry_t *entry)
+{
+    uint32_t valid = 0, runs = 0;
+
+    for (uint32_t idx = 0; idx < DARM_VALID_BLOCK / 64; idx++) {
+        uint64_t prev = idx != 0 ? bits[idx - 1] >> 63 : 0;
+
+        // a run starts at every valid word of which the previous word
+        // isn't valid
+        valid += __builtin_popcountll(bits[idx]);
+        runs += __builtin_popcountll(bits[idx] & ~((bits[idx] << 1) | prev));
+    }
+
+    uint32_t count = 0;
+
+    entry->offset = 0;
+
+    if(valid == 0 || valid == DARM_VALID_BLOCK) {
+        entry->type = valid == 0 ? V_EMPTY : V_FULL;
+        entry->count = 0;
+        return 0;
+    }
+
+    // the smallest of the sorted arrays and the runs, if any of them is
+    // smaller than the bitmap
+    uint32_t invalid = DARM_VALID_BLOCK - valid;
+    uint32_t array = valid < invalid ? valid : invalid;
+
+    if(runs * 2 <= array && runs * 4 < BITMAP_SIZE) {
+        for (uint32_t idx = 0; idx < DARM_VALID_BLOCK; idx++) {
+            if(BITMAP_GET(bits, idx) == 0) continue;
+
+            // the run continues while the next word is valid
+            _write16(&out[count * 4], idx);
+            while (idx + 1 < DARM_VALID_BLOCK && BITMAP_GET(bits, idx + 1)) {
+                idx++;
+            }
+            _write16(&out[count++ * 4 + 2], idx);
+        }
+
+        entry->type = V_RUNS, entry->count = count;
+    }
+    else if(array <= ARRAY_MAX) {
+        uint32_t want = valid == array;
+        for (uint32_t idx = 0; idx < DARM_VALID_BLOCK; idx++) {
+            if(BITMAP_GET(bits, idx) == want) {
+                _write16(&out[count++ * 2], idx);
+            }
+        }
+
+        entry->type = want ? V_ARRAY : V_INVERTED, entry->count = count;
+    }
+    else {
+        for (uint32_t idx = 0; idx < BITMAP_SIZE; idx++) {
+            out[idx] = bits[idx / 8] >> (idx % 8 * 8);
+        }
+
+        entry->type = V_BITMAP, entry->count = 0;
+    }
+    return _container_size(entry);
+}
+
+// index of the last halfword in the sorted array that is at most value,
+// or -1 if there's none
+static int32_t _lower_bound(const uint8_t *data, uint32_t count,
+    uint32_t stride, uint16_t value)
+{
+    uint32_t lo = 0, hi = count;
+
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2, off = mid * stride * 2;
+        uint16_t x = _read_le16(&data[off]);
+
+        if(x <= value) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return (int32_t) lo - 1;
+}
+
+int darm_valid_unpack(const darm_valid_entry_t *entry, const uint8_t *data,
+    uint16_t low)
+{
+    int32_t idx;
+
+    switch ((darm_valid_type_t) entry->type) {
+    case V_EMPTY:
+        return 0;
+
+    case V_FULL:
+        return 1;
+
+    case V_ARRAY: case V_INVERTED:
+        idx = _lower_bound(data, entry->count, 1, low);
+        return (idx >= 0 && _read_le16(&data[idx * 2]) == low) ==
+            (entry->type == V_ARRAY);
+
+    case V_RUNS:
+        idx = _lower_bound(data, entry->count, 2, low);
+        return idx >= 0 && low <= _read_le16(&data[idx * 4 + 2]);
+
+    case V_BITMAP:
+        return (data[low / 8] >> (low % 8)) & 1;
+
+    default:
+        return -1;
+    }
+}
+
+int darm_valid_write(const char *fname, const uint64_t *counts,
+    darm_valid_entry_t *entry, const uint8_t *const *container)
+{
+    valid_header_t hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, VALID_MAGIC, sizeof(hdr.magic));
+    hdr.instr_count = I_INSTRCNT;
+
+    for (uint32_t idx = 0; idx < DARM_VALID_BLOCK; idx++) {
+        entry[idx].offset = hdr.data_size;
+        hdr.data_size += _container_size(&entry[idx]);
+    }
+
+    FILE *fp = fopen(fname, "wb");
+    if(fp == NULL) return -1;
+
+    int ret = fwrite(&hdr, sizeof(hdr), 1, fp) == 1 &&
+        fwrite(counts, sizeof(uint64_t), I_INSTRCNT, fp) == I_INSTRCNT &&
+        fwrite(entry, sizeof(darm_valid_entry_t), DARM_VALID_BLOCK,
+            fp) == DARM_VALID_BLOCK ? 0 : -1;
+
+    for (uint32_t idx = 0; ret == 0 && idx < DARM_VALID_BLOCK; idx++) {
+        uint32_t size = _container_size(&entry[idx]);
+        if(size != 0 && fwrite(container[idx], 1, size, fp) != size) {
+            ret = -1;
+        }
+    }
+
+    if(fclose(fp) != 0) {
+        ret = -1;
+    }
+    return ret;
+}
+
+int darm_valid_open(darm_valid_t *v, const char *fname)
+{
+    memset(v, 0, sizeof(darm_valid_t));
+
+#ifndef _WIN32
+    int fd = open(fname, O_RDONLY);
+    if(fd < 0) return -1;
+
+    struct stat st;
+    if(fstat(fd, &st) < 0 || (uint64_t) st.st_size < sizeof(valid_header_t)) {
+        close(fd);
+        return -1;
+    }
+
+    void *ptr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(ptr == MAP_FAILED) return -1;
+
+    v->map = ptr, v->size = st.st_size;
+#else
+    FILE *fp = fopen(fname, "rb");
+    if(fp == NULL) return -1;
+
+    fseek(fp, 0, SEEK_END);
+    long len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    uint8_t *buf = len >= (long) sizeof(valid_header_t) ? malloc(len) : NULL;
+    if(buf != NULL && fread(buf, 1, len, fp) != (size_t) len) {
+        free(buf), buf = NULL;
+    }
+    fclose(fp);
+    if(buf == NULL) return -1;
+
+    v->map = buf, v->size = len;
+#endif
+
+    const valid_header_t *hdr = (const valid_header_t *) v->map;
+    uint64_t off = sizeof(valid_header_t) +
+        (uint64_t) hdr->instr_count * sizeof(uint64_t) +
+        DARM_VALID_BLOCK * sizeof(darm_valid_entry_t);
+
+    if(memcmp(hdr->magic, VALID_MAGIC, sizeof(hdr->magic)) != 0 ||
+            off > v->size || hdr->data_size != v->size - off) {
+        darm_valid_close(v);
+        return -1;
+    }
+
+    v->instr_count = hdr->instr_count;
+    v->counts = (const uint64_t *) &v->map[sizeof(valid_header_t)];
+    v->entry = (const darm_valid_entry_t *) &v->counts[v->instr_count];
+    v->data = &v->map[off];
+    v->data_size = hdr->data_size;
+
+    // make sure every container lies within the data
+    for (uint32_t idx = 0; idx < DARM_VALID_BLOCK; idx++) {
+        if((uint64_t) v->entry[idx].offset +
+                _container_size(&v->entry[idx]) > v->data_size) {
+            darm_valid_close(v);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int darm_valid_get(const darm_valid_t *v, uint32_t w)
+{
+    const darm_valid_entry_t *entry = &v->entry[w >> 16];
+    return darm_valid_unpack(entry, &v->data[entry->offset], w & 0xffff);
+}
+
+uint64_t darm_valid_count(const darm_valid_t *v, darm_instr_t instr)
+{
+    return (uint32_t) instr < v->instr_count ? v->counts[instr] : 0;
+}
+
+void darm_valid_close(darm_valid_t *v)
+{
+    if(v->map != NULL) {
+#ifndef _WIN32
+        munmap((void *) v->map, v->size);
+#else
+        free((void *) v->map);
+#endif
+    }
+    memset(v, 0, sizeof(darm_valid_t));
+}
+#undef VALID_MAGIC
+#undef ARRAY_MAX
+#undef BITMAP_SIZE
+
@@ -0,0 +1,2246 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef __DARM_ALL_H__
+#define __DARM_ALL_H__
+
+// ---- darm.h ----
+
+#ifndef __DARM__
+#define __DARM__
+
+// ---- armv7-tbl.h ----
+#ifndef __ARMV7_TBL__
+#define __ARMV7_TBL__
+#include <stdint.h>
+// ---- darm-tbl.h ----
+#ifndef __DARM_TBL__
+#define __DARM_TBL__
+#include <stdint.h>
+typedef enum _darm_enctype_t {
+    // info:
+    // Invalid or non-existent type
+    //
+    // encodings:
+    // I_INVLD
+    //
+    // affects:
+    // 
+    T_INVLD,
+
+    // info:
+    // ADR Instruction, which is an optimization of ADD
+    //
+    // encodings:
+    // ADR<c> <Rd>,<label>
+    //
+    // affects:
+    // ADR
+    T_ARM_ADR,
+
+    // info:
+    // All unconditional instructions
+    //
+    // encodings:
+    // ins <endian_specifier>
+    // ins [<Rn>,#+/-<imm12>]
+    // ins [<Rn>,#<imm12>]
+    // ins
+    // ins #<option>
+    // ins <label>
+    //
+    // affects:
+    // BLX, CLREX, DMB, DSB, ISB, PLD, PLI, SETEND
+    T_ARM_UNCOND,
+
+    // info:
+    // All multiplication instructions
+    //
+    // encodings:
+    // ins{S}<c> <Rd>,<Rn>,<Rm>
+    // ins{S}<c> <Rd>,<Rn>,<Rm>,<Ra>
+    // ins{S}<c> <RdLo>,<RdHi>,<Rn>,<Rm>
+    //
+    // affects:
+    // MLA, MLS, MUL, SMLAL, SMULL, UMAAL, UMLAL, UMULL
+    T_ARM_MUL,
+
+    // info:
+    // Various STR and LDR instructions
+    //
+    // encodings:
+    // ins<c> <Rt>,[<Rn>,#+/-<imm12>]
+    // ins<c> <Rt>,[<Rn>],#+/-<imm12>
+    // ins<c> <Rt>,[<Rn>],+/-<Rm>{,<shift>}
+    //
+    // affects:
+    // LDR, LDRB, LDRBT, LDRT, POP, PUSH, STR, STRB, STRBT, STRT
+    T_ARM_STACK0,
+
+    // info:
+    // Various unprivileged STR and LDR instructions
+    //
+    // encodings:
+    // ins<c> <Rt>,[<Rn>],+/-<Rm>
+    // ins<c> <Rt>,[<Rn>]{,#+/-<imm8>}
+    //
+    // affects:
+    // LDRHT, LDRSBT, LDRSHT, STRHT
+    T_ARM_STACK1,
+
+    // info:
+    // Various other STR and LDR instructions
+    //
+    // encodings:
+    // ins<c> <Rt>,<Rt2>,[<Rn>],+/-<Rm>
+    // ins<c> <Rt>,[<Rn>],+/-<Rm>
+    // ins<c> <Rt>,<Rt2>,[<Rn>],#+/-<imm8>
+    // ins<c> <Rt>,<Rt2>,[<Rn>,#+/-<imm8>]
+    // ins<c> <Rt>,[<Rn>,#+/-<imm8>]
+    //
+    // affects:
+    // LDRD, LDRH, LDRSB, LDRSH, STRD, STRH
+    T_ARM_STACK2,
+
+    // info:
+    // Arithmetic instructions which take a shift for the second source
+    //
+    // encodings:
+    // ins{S}<c> <Rd>,<Rn>,<Rm>{,<shift>}
+    // ins{S}<c> <Rd>,<Rn>,<Rm>,<type> <Rs>
+    //
+    // affects:
+    // ADC, ADD, AND, BIC, EOR, ORR, RSB, RSC, SBC, SUB
+    T_ARM_ARITH_SHIFT,
+
+    // info:
+    // Arithmetic instructions which take an immediate as second source
+    //
+    // encodings:
+    // ins{S}<c> <Rd>,<Rn>,#<const>
+    //
+    // affects:
+    // ADC, ADD, AND, BIC, EOR, ORR, RSB, RSC, SBC, SUB
+    T_ARM_ARITH_IMM,
+
+    // info:
+    // Bit field magic
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // BFC, BFI, SBFX, UBFX
+    T_ARM_BITS,
+
+    // info:
+    // Branch and System Call instructions
+    //
+    // encodings:
+    // B(L)<c> <label>
+    // SVC<c> #<imm24>
+    //
+    // affects:
+    // B, BL, SVC
+    T_ARM_BRNCHSC,
+
+    // info:
+    // Branch and Misc instructions
+    //
+    // encodings:
+    // B(L)X(J)<c> <Rm>
+    // BKPT #<imm16>
+    // MSR<c> <spec_reg>,<Rn>
+    //
+    // affects:
+    // BKPT, BLX, BX, BXJ, MSR, SMLAW, SMULW
+    T_ARM_BRNCHMISC,
+
+    // info:
+    // Move immediate to a register (possibly negating it)
+    //
+    // encodings:
+    // ins{S}<c> <Rd>,#<const>
+    //
+    // affects:
+    // MOV, MOVT, MOVW, MVN
+    T_ARM_MOV_IMM,
+
+    // info:
+    // Comparison instructions which take two operands
+    //
+    // encodings:
+    // ins<c> <Rn>,<Rm>{,<shift>}
+    // ins<c> <Rn>,<Rm>,<type> <Rs>
+    //
+    // affects:
+    // CMN, CMP, TEQ, TST
+    T_ARM_CMP_OP,
+
+    // info:
+    // Comparison instructions which take an immediate
+    //
+    // encodings:
+    // ins<c> <Rn>,#<const>
+    //
+    // affects:
+    // CMN, CMP, TEQ, TST
+    T_ARM_CMP_IMM,
+
+    // info:
+    // Instructions which don't take any operands
+    //
+    // encodings:
+    // ins<c>
+    //
+    // affects:
+    // NOP, SEV, WFE, WFI, YIELD
+    T_ARM_OPLESS,
+
+    // info:
+    // Manipulate and move a register to another register
+    //
+    // encodings:
+    // ins{S}<c> <Rd>,<Rm>
+    // ins{S}<c> <Rd>,<Rm>,#<imm>
+    // ins{S}<c> <Rd>,<Rn>,<Rm>
+    //
+    // affects:
+    // ASR, LDREXD, LSL, LSR, MOV, ROR, RRX, STREXD
+    T_ARM_DST_SRC,
+
+    // info:
+    // Load or store multiple registers at once
+    //
+    // encodings:
+    // ins<c> <Rn>{!},<registers>
+    //
+    // affects:
+    // LDM, LDMDA, LDMDB, LDMIB, PUSH, STM, STMDA, STMDB, STMIB
+    T_ARM_LDSTREGS,
+
+    // info:
+    // Bit reverse instructions
+    //
+    // encodings:
+    // ins<c> <Rd>,<Rm>
+    //
+    // affects:
+    // CLZ, RBIT, REV, REV16, REVSH
+    T_ARM_BITREV,
+
+    // info:
+    // Various miscellaneous instructions
+    //
+    // encodings:
+    // ins{S}<c> <Rd>,<Rm>,<type> <Rs>
+    // ins{S}<c> <Rd>,<Rm>{,<shift>}
+    // ins<c> #<imm4>
+    // ins<c> #<option>
+    // ins<c> <Rd>,<Rn>,<Rm>{,<type> #<imm>}
+    // ins<c> <Rd>,<Rn>,<Rm>
+    //
+    // affects:
+    // DBG, MVN, PKH, SEL, SMC
+    T_ARM_MISC,
+
+    // info:
+    // Various signed multiply instructions
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // SMLA, SMLAD, SMLAL, SMLALD, SMLSD, SMLSLD, SMMLA, SMMLS, SMMUL, SMUAD,
+    // SMUL, SMUSD
+    T_ARM_SM,
+
+    // info:
+    // Parallel signed and unsigned addition and subtraction
+    //
+    // encodings:
+    // ins<c> <Rd>,<Rn>,<Rm>
+    //
+    // affects:
+    // QADD16, QADD8, QASX, QSAX, QSUB16, QSUB8, SADD16, SADD8, SASX, SHADD16,
+    // SHADD8, SHASX, SHSAX, SHSUB16, SHSUB8, SSAX, SSUB16, SSUB8, UADD16, UADD8,
+    // UASX, UHADD16, UHADD8, UHASX, UHSAX, UHSUB16, UHSUB8, UQADD16, UQADD8,
+    // UQASX, UQSAX, UQSUB16, UQSUB8, USAX, USUB16, USUB8
+    T_ARM_PAS,
+
+    // info:
+    // Saturating addition and subtraction instructions
+    //
+    // encodings:
+    // ins<c> <Rd>,<Rn>,<Rm>
+    //
+    // affects:
+    // QADD, QDADD, QDSUB, QSUB
+    T_ARM_SAT,
+
+    // info:
+    // Synchronization primitives
+    //
+    // encodings:
+    // ins{B}<c> <Rt>,<Rt2>,[<Rn>]
+    // ins<c> <Rd>,<Rt>,[<Rn>]
+    // ins<c> <Rt>,<Rt2>,[<Rn>]
+    // ins<c> <Rt>,[<Rn>]
+    //
+    // affects:
+    // LDREX, LDREXB, LDREXH, STREX, STREXB, STREXH, SWP, SWPB
+    T_ARM_SYNC,
+
+    // info:
+    // Packing, unpacking, saturation, and reversal instructions
+    //
+    // encodings:
+    // ins<c> <Rd>,#<imm>,<Rn>
+    // ins<c> <Rd>,#<imm>,<Rn>{,<shift>}
+    // ins<c> <Rd>,<Rn>,<Rm>{,<rotation>}
+    // ins<c> <Rd>,<Rm>{,<rotation>}
+    //
+    // affects:
+    // SSAT, SSAT16, SXTAB, SXTAB16, SXTAH, SXTB, SXTB16, SXTH, USAT, USAT16,
+    // UXTAB, UXTAB16, UXTAH, UXTB, UXTB16, UXTH
+    T_ARM_PUSR,
+
+    // info:
+    // Move to/from Coprocessor to/from ARM core register
+    //
+    // encodings:
+    // ins<c> <coproc>,<opc1>,<Rt>,<CRn>,<CRm>,{,<opc2>}
+    //
+    // affects:
+    // CDP, MCR, MRC
+    T_ARM_MVCR,
+
+    // info:
+    // Permanently Undefined Instruction
+    //
+    // encodings:
+    // ins<c> #<imm>
+    //
+    // affects:
+    // UDF
+    T_ARM_UDF,
+
+    // info:
+    // Instructions which only take an 8-byte immediate
+    //
+    // encodings:
+    // ins<c> #<imm8>
+    //
+    // affects:
+    // BKPT, SVC, UDF
+    T_THUMB_ONLY_IMM8,
+
+    // info:
+    // Conditional branch
+    //
+    // encodings:
+    // ins<c> <label>
+    //
+    // affects:
+    // B
+    T_THUMB_COND_BRANCH,
+
+    // info:
+    // Unconditional branch
+    //
+    // encodings:
+    // ins<c> <label>
+    //
+    // affects:
+    // B
+    T_THUMB_UNCOND_BRANCH,
+
+    // info:
+    // Shifting instructions which take an immediate
+    //
+    // encodings:
+    // ins<c> <Rd>, <Rm>, #<imm>
+    //
+    // affects:
+    // ASR, LSL, LSR
+    T_THUMB_SHIFT_IMM,
+
+    // info:
+    // Load from and Store to the stack
+    //
+    // encodings:
+    // ins<c> <Rt>, [SP, #<imm>]
+    //
+    // affects:
+    // LDR, STR
+    T_THUMB_STACK,
+
+    // info:
+    // Load a value relative to PC
+    //
+    // encodings:
+    // ins<c> <Rt>, <label>
+    //
+    // affects:
+    // LDR
+    T_THUMB_LDR_PC,
+
+    // info:
+    // Various General Purpose Instructions
+    //
+    // encodings:
+    // ins<c> <Rdn>, <Rm>
+    // ins<c> <Rn>, <Rm>
+    // ins<c> <Rdm>, <Rn>, <Rdm>
+    // ins<c> <Rd>, <Rm>
+    //
+    // affects:
+    // ADC, AND, ASR, BIC, CMN, CMP, EOR, LSL, LSR, MUL, MVN, ORR, ROR, RSB, SBC,
+    // TST
+    T_THUMB_GPI,
+
+    // info:
+    // Branch (and optionally link) to a Register
+    //
+    // encodings:
+    // ins<c> <Rm>
+    //
+    // affects:
+    // BLX, BX
+    T_THUMB_BRANCH_REG,
+
+    // info:
+    // If-Then and Hints
+    //
+    // encodings:
+    // ins<c>
+    //
+    // affects:
+    // IT, NOP, SEV, WFE, WFI, YIELD
+    T_THUMB_IT_HINTS,
+
+    // info:
+    // Instructions with an 8bit immediate
+    //
+    // encodings:
+    // ins<c> <Rdn>, #<imm>
+    // ins<c> <Rd>, SP, #<imm>
+    // ins<c> <Rd>, <label>
+    // ins<c> <Rn>, #<imm>
+    // ins<c> <Rd>, #<imm>
+    //
+    // affects:
+    // ADD, ADR, CMP, MOV, SUB
+    T_THUMB_HAS_IMM8,
+
+    // info:
+    // Bit Extension instructions
+    //
+    // encodings:
+    // ins<c> <Rd>, <Rm>
+    //
+    // affects:
+    // SXTB, SXTH, UXTB, UXTH
+    T_THUMB_EXTEND,
+
+    // info:
+    // Modifies the Stack Pointer by an Immediate
+    //
+    // encodings:
+    // ins<c> SP, SP, #<imm>
+    //
+    // affects:
+    // ADD, SUB
+    T_THUMB_MOD_SP_IMM,
+
+    // info:
+    // Instructions with 3 registers as operands
+    //
+    // encodings:
+    // ins<c> <Rd>, <Rn>, <Rm>
+    //
+    // affects:
+    // ADD, SUB
+    T_THUMB_3REG,
+
+    // info:
+    // Instructions with two registers and an immediate
+    //
+    // encodings:
+    // ins<c> <Rd>, <Rn>, #<imm>
+    //
+    // affects:
+    // ADD, SUB
+    T_THUMB_2REG_IMM,
+
+    // info:
+    // Add SP with an Immediate to a register
+    //
+    // encodings:
+    // ins<c> <Rd>, SP, #<imm>
+    //
+    // affects:
+    // ADD
+    T_THUMB_ADD_SP_IMM,
+
+    // info:
+    // Move operation with 4bit registers
+    //
+    // encodings:
+    // ins<c> <Rd>, <Rn>
+    //
+    // affects:
+    // MOV
+    T_THUMB_MOV4,
+
+    // info:
+    // Instructions to manipulate memory
+    //
+    // encodings:
+    // ins<c> <Rt>, [<Rn>, #<imm>]
+    //
+    // affects:
+    // LDR, LDRB, LDRH, STR, STRB, STRH
+    T_THUMB_RW_MEMI,
+
+    // info:
+    // Instructions to manipulate memory
+    //
+    // encodings:
+    // ins<c> <Rt>, [<Rn>, <Rm>]
+    //
+    // affects:
+    // LDR, LDRB, LDRH, LDRSB, LDRSH, STR, STRB, STRH
+    T_THUMB_RW_MEMO,
+
+    // info:
+    // Load and Store register lists
+    //
+    // encodings:
+    // ins<c> <Rn>{!}, <registers>
+    //
+    // affects:
+    // LDM, STM
+    T_THUMB_RW_REG,
+
+    // info:
+    // Various Reverse instructions
+    //
+    // encodings:
+    // ins<c> <Rd>, <Rm>
+    //
+    // affects:
+    // REV, REV16, REVSH
+    T_THUMB_REV,
+
+    // info:
+    // Set Endian instruction
+    //
+    // encodings:
+    // ins <endian_specifier>
+    //
+    // affects:
+    // SETEND
+    T_THUMB_SETEND,
+
+    // info:
+    // Push and Pop registers
+    //
+    // encodings:
+    // ins<c> <registers>
+    //
+    // affects:
+    // POP, PUSH
+    T_THUMB_PUSHPOP,
+
+    // info:
+    // Comparison instruction
+    //
+    // encodings:
+    // ins<c> <Rn>, <Rm>
+    //
+    // affects:
+    // CMP
+    T_THUMB_CMP,
+
+    // info:
+    // Add a Register to the Stack Pointer
+    //
+    // encodings:
+    // ins<c> SP, <Rm>
+    //
+    // affects:
+    // ADD
+    T_THUMB_MOD_SP_REG,
+
+    // info:
+    // Compare and Branch on (Non)Zero
+    //
+    // encodings:
+    // ins<c> <Rn>, <label>
+    //
+    // affects:
+    // CBZ
+    T_THUMB_CBZ,
+
+    // info:
+    // Instructions that do not operate on a register
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_NO_REG,
+
+    // info:
+    // Instructions that operate on Rt register
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_RT_REG,
+
+    // info:
+    // Instructions that operate on Rt and Rt2 register
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_RT_RT2_REG,
+
+    // info:
+    // Instructions that operate on the Rm register
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_RM_REG,
+
+    // info:
+    // Instructions that operate on the Rd register
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_RD_REG,
+
+    // info:
+    // Instructions that operate on the Rd and Rm register
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_RD_RM_REG,
+
+    // info:
+    // Instructions that operate on the Rn register
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_RN_REG,
+
+    // info:
+    // Instructions that operate on the Rn and Rt register
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_RN_RT_REG,
+
+    // info:
+    // Instructions that operate on the Rn, Rt and Rt2 register
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_RN_RT_RT2_REG,
+
+    // info:
+    // Instructions that operate on the Rn and Rm register
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_RN_RM_REG,
+
+    // info:
+    // Instructions that operate on the Rn, Rm and Rt register
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_RN_RM_RT_REG,
+
+    // info:
+    // Instructions that operate on the Rn and Rd register
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_RN_RD_REG,
+
+    // info:
+    // Instructions that operate on the Rn, Rd and Rt register
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_RN_RD_RT_REG,
+
+    // info:
+    // Instructions that operate on the Rn, Rd, Rt and Rt2 register
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_RN_RD_RT_RT2_REG,
+
+    // info:
+    // Instructions that operate on the Rn, Rd and Rm register
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_RN_RD_RM_REG,
+
+    // info:
+    // Instructions that operate on the Rn, Rd, Rm and Ra register
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_RN_RD_RM_RA_REG,
+
+    // info:
+    // Instructions that do not operate on an immediate
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_NO_IMM,
+
+    // info:
+    // Instructions that use a 12 bit immediate
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_IMM12,
+
+    // info:
+    // Instructions that use an 8 bit immediate
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_IMM8,
+
+    // info:
+    // Instructions that use a 2 bit immediate
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_IMM2,
+
+    // info:
+    // Instructions that use a 2 and 3 bit immediate
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_IMM2_IMM3,
+
+    // info:
+    // Instructions that use a 1, 3 and 8 bit immediate
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_IMM1_IMM3_IMM8,
+
+    // info:
+    // Instructions that have no flags
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_NO_FLAG,
+
+    // info:
+    // Instructions that use the rotate flag
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_ROTATE_FLAG,
+
+    // info:
+    // Instructions that use the U flag
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_U_FLAG,
+
+    // info:
+    // Instructions that use the WUP flags
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_WUP_FLAG,
+
+    // info:
+    // Instructions that use the shift type flag
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_TYPE_FLAG,
+
+    // info:
+    // Instructions that use the register list
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_REGLIST_FLAG,
+
+    // info:
+    // Instructions that use the WP flags and register list
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_WP_REGLIST_FLAG,
+
+    // info:
+    // Instructions that use the S flag
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_S_FLAG,
+
+    // info:
+    // Instructions that use the S flag and shift type flag
+    //
+    // encodings:
+    // 
+    //
+    // affects:
+    // 
+    T_THUMB2_S_TYPE_FLAG,
+} darm_enctype_t;
+
+typedef enum _darm_instr_t {
+    I_INVLD, I_ADC, I_ADD, I_ADDW, I_ADR, I_AND, I_ASR, I_B, I_BFC, I_BFI,
+    I_BIC, I_BKPT, I_BL, I_BLX, I_BX, I_BXJ, I_CBNZ, I_CBZ, I_CDP, I_CDP2,
+    I_CHKA, I_CLREX, I_CLZ, I_CMN, I_CMP, I_CPS, I_CPY, I_DBG, I_DMB, I_DSB,
+    I_ENTERX, I_EOR, I_HB, I_HBL, I_HBLP, I_HBP, I_ISB, I_IT, I_LDC, I_LDC2,
+    I_LDM, I_LDMDA, I_LDMDB, I_LDMIB, I_LDR, I_LDRB, I_LDRBT, I_LDRD, I_LDREX,
+    I_LDREXB, I_LDREXD, I_LDREXH, I_LDRH, I_LDRHT, I_LDRSB, I_LDRSBT, I_LDRSH,
+    I_LDRSHT, I_LDRT, I_LEAVEX, I_LSL, I_LSR, I_MCR, I_MCR2, I_MCRR, I_MCRR2,
+    I_MLA, I_MLS, I_MOV, I_MOVT, I_MOVW, I_MRC, I_MRC2, I_MRRC, I_MRRC2,
+    I_MRS, I_MSR, I_MUL, I_MVN, I_NEG, I_NOP, I_ORN, I_ORR, I_PKH, I_PLD,
+    I_PLDW, I_PLI, I_POP, I_PUSH, I_QADD, I_QADD16, I_QADD8, I_QASX, I_QDADD,
+    I_QDSUB, I_QSAX, I_QSUB, I_QSUB16, I_QSUB8, I_RBIT, I_REV, I_REV16,
+    I_REVSH, I_RFE, I_ROR, I_RRX, I_RSB, I_RSC, I_SADD16, I_SADD8, I_SASX,
+    I_SBC, I_SBFX, I_SDIV, I_SEL, I_SETEND, I_SEV, I_SHADD16, I_SHADD8,
+    I_SHASX, I_SHSAX, I_SHSUB16, I_SHSUB8, I_SMC, I_SMLA, I_SMLABB, I_SMLABT,
+    I_SMLAD, I_SMLAL, I_SMLALBB, I_SMLALBT, I_SMLALD, I_SMLALTB, I_SMLALTT,
+    I_SMLATB, I_SMLATT, I_SMLAW, I_SMLSD, I_SMLSLD, I_SMMLA, I_SMMLS, I_SMMUL,
+    I_SMUAD, I_SMUL, I_SMULBB, I_SMULBT, I_SMULL, I_SMULTB, I_SMULTT, I_SMULW,
+    I_SMUSD, I_SRS, I_SSAT, I_SSAT16, I_SSAX, I_SSUB16, I_SSUB8, I_STC,
+    I_STC2, I_STM, I_STMDA, I_STMDB, I_STMIB, I_STR, I_STRB, I_STRBT, I_STRD,
+    I_STREX, I_STREXB, I_STREXD, I_STREXH, I_STRH, I_STRHT, I_STRT, I_SUB,
+    I_SUBW, I_SVC, I_SWP, I_SWPB, I_SXTAB, I_SXTAB16, I_SXTAH, I_SXTB,
+    I_SXTB16, I_SXTH, I_TBB, I_TBH, I_TEQ, I_TST, I_UADD16, I_UADD8, I_UASX,
+    I_UBFX, I_UDF, I_UDIV, I_UHADD16, I_UHADD8, I_UHASX, I_UHSAX, I_UHSUB16,
+    I_UHSUB8, I_UMAAL, I_UMLAL, I_UMULL, I_UQADD16, I_UQADD8, I_UQASX,
+    I_UQSAX, I_UQSUB16, I_UQSUB8, I_USAD8, I_USADA8, I_USAT, I_USAT16, I_USAX,
+    I_USUB16, I_USUB8, I_UXTAB, I_UXTAB16, I_UXTAH, I_UXTB, I_UXTB16, I_UXTH,
+    I_VABA, I_VABAL, I_VABD, I_VABDL, I_VABS, I_VACGE, I_VACGT, I_VACLE,
+    I_VACLT, I_VADD, I_VADDHN, I_VADDL, I_VADDW, I_VAND, I_VBIC, I_VBIF,
+    I_VBIT, I_VBSL, I_VCEQ, I_VCGE, I_VCGT, I_VCLE, I_VCLS, I_VCLT, I_VCLZ,
+    I_VCMP, I_VCMPE, I_VCNT, I_VCVT, I_VCVTB, I_VCVTR, I_VCVTT, I_VDIV,
+    I_VDUP, I_VEOR, I_VEXT, I_VHADD, I_VHSUB, I_VLD1, I_VLD2, I_VLD3, I_VLD4,
+    I_VLDM, I_VLDR, I_VMAX, I_VMIN, I_VMLA, I_VMLAL, I_VMLS, I_VMLSL, I_VMOV,
+    I_VMOVL, I_VMOVN, I_VMRS, I_VMSR, I_VMUL, I_VMULL, I_VMVN, I_VNEG,
+    I_VNMLA, I_VNMLS, I_VNMUL, I_VORN, I_VORR, I_VPADAL, I_VPADD, I_VPADDL,
+    I_VPMAX, I_VPMIN, I_VPOP, I_VPUSH, I_VQABS, I_VQADD, I_VQDMLAL, I_VQDMLSL,
+    I_VQDMULH, I_VQDMULL, I_VQMOVN, I_VQMOVUN, I_VQNEG, I_VQRDMULH, I_VQRSHL,
+    I_VQRSHRN, I_VQRSHRUN, I_VQSHL, I_VQSHLU, I_VQSHRN, I_VQSHRUN, I_VQSUB,
+    I_VRADDHN, I_VRECPE, I_VRECPS, I_VREV16, I_VREV32, I_VREV64, I_VRHADD,
+    I_VRSHL, I_VRSHR, I_VRSHRN, I_VRSQRTE, I_VRSQRTS, I_VRSRA, I_VRSUBHN,
+    I_VSHL, I_VSHLL, I_VSHR, I_VSHRN, I_VSLI, I_VSQRT, I_VSRA, I_VSRI, I_VST1,
+    I_VST2, I_VST3, I_VST4, I_VSTM, I_VSTR, I_VSUB, I_VSUBHN, I_VSUBL,
+    I_VSUBW, I_VSWP, I_VTBL, I_VTBX, I_VTRN, I_VTST, I_VUZP, I_VZIP, I_WFE,
+    I_WFI, I_YIELD, I_INSTRCNT
+} darm_instr_t;
+
+extern const char *darm_mnemonics[354];
+extern const char *darm_enctypes[83];
+extern const char *darm_registers[16];
+typedef enum _darm_regrule_t {
+    // Rd is read as well, e.g., MOVT, BFI
+    RR_RD_READ = 1 << 0,
+    // Rd is not written, e.g., CMP on Thumb2
+    RR_RD_NONE = 1 << 1,
+    // Rt is written, e.g., loads
+    RR_RT_WRITE = 1 << 2,
+    // Rt2 is written, e.g., LDRD
+    RR_RT2_WRITE = 1 << 3,
+    // Rt2 is Rt+1 if the encoding does not specify it
+    RR_RT_PAIR = 1 << 4,
+    // RdHi and RdLo are accumulated
+    RR_HILO_READ = 1 << 5,
+    // the register list is written rather than read
+    RR_LIST_WRITE = 1 << 6,
+    // Rn is written if W is set or P is unset
+    RR_WRITEBACK = 1 << 7,
+    // SP is implicitly read and written
+    RR_SP = 1 << 8,
+    // LR is implicitly written
+    RR_LR_WRITE = 1 << 9,
+    // PC is implicitly written
+    RR_PC_WRITE = 1 << 10,
+    // PC is implicitly read if there is an immediate and no Rn
+    RR_PC_REL = 1 << 11,
+} darm_regrule_t;
+
+typedef enum _darm_semrule_t {
+    // N and Z are written if S is set
+    SEM_WRITES_NZ = 1 << 0,
+    // C is written if S is set
+    SEM_WRITES_C = 1 << 1,
+    // V is written if S is set
+    SEM_WRITES_V = 1 << 2,
+    // the flags are written regardless of S
+    SEM_FLAGS_ALWAYS = 1 << 3,
+    // C is read, e.g., ADC
+    SEM_READS_C = 1 << 4,
+    // all flags are read, i.e., MRS
+    SEM_READS_NZCV = 1 << 5,
+    // memory is read
+    SEM_LOAD = 1 << 6,
+    // memory is written
+    SEM_STORE = 1 << 7,
+    // the memory access is a byte
+    SEM_BYTE = 1 << 8,
+    // the memory access is a halfword
+    SEM_HALF = 1 << 9,
+    // the memory access is two words
+    SEM_DUAL = 1 << 10,
+    // the memory access is a word for each register in the list
+    SEM_MULTI = 1 << 11,
+    // the loaded value is sign-extended
+    SEM_SIGNED = 1 << 12,
+    // the memory access is exclusive
+    SEM_EXCLUSIVE = 1 << 13,
+} darm_semrule_t;
+
+extern const uint16_t darm_regrules[354];
+extern const uint16_t darm_semrules[354];
+typedef enum _darm_isa_t {
+    ISA_ARMV7, ISA_THUMB, ISA_THUMB2,
+} darm_isa_t;
+typedef struct _darm_pattern_t {
+    uint32_t mask;
+    uint32_t value;
+    darm_isa_t isa;
+    darm_instr_t instr;
+} darm_pattern_t;
+extern const darm_pattern_t darm_patterns[552];
+typedef uint16_t darm_lut_t;
+#define DARM_LUT_INSTR_BITS 9
+#define DARM_LUT(instr, type) \
+    ((instr) | ((type) << DARM_LUT_INSTR_BITS))
+static inline darm_instr_t darm_lut_instr(darm_lut_t entry)
+{
+    return (darm_instr_t)(entry & ((1 << DARM_LUT_INSTR_BITS) - 1));
+}
+static inline darm_enctype_t darm_lut_type(darm_lut_t entry)
+{
+    return (darm_enctype_t)(entry >> DARM_LUT_INSTR_BITS);
+}
+#endif
+extern const darm_lut_t armv7_instr_lut[256];
+extern const uint16_t type_shift_instr_lookup[16];
+extern const uint16_t type_brnchmisc_instr_lookup[16];
+extern const uint16_t type_opless_instr_lookup[8];
+extern const uint16_t type_uncond2_instr_lookup[8];
+extern const uint16_t type_mul_instr_lookup[8];
+extern const uint16_t type_stack0_instr_lookup[32];
+extern const uint16_t type_stack1_instr_lookup[8];
+extern const uint16_t type_stack2_instr_lookup[8];
+extern const uint16_t type_bits_instr_lookup[4];
+extern const uint16_t type_pas_instr_lookup[64];
+extern const uint16_t type_sat_instr_lookup[4];
+extern const uint16_t type_sync_instr_lookup[16];
+extern const uint16_t type_pusr_instr_lookup[16];
+extern const char *armv7_format_strings[479][3];
+#endif
+
+#ifndef ARRAYSIZE
+#define ARRAYSIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
+#endif
+
+#define B_UNSET 0
+#define B_SET   1
+#define B_INVLD 2
+
+typedef enum _darm_reg_t {
+    r0 = 0, r1 = 1, r2 = 2, r3 = 3, r4 = 4, r5 = 5, r6 = 6, r7 = 7, r8 = 8,
+    r9 = 9, r10 = 10, r11 = 11, r12 = 12, r13 = 13, r14 = 14, r15 = 15,
+
+    FP = 11, IP = 12, SP = 13, LR = 14, PC = 15,
+
+    cr0 = 0, cr1 = 1, cr2 = 2, cr3 = 3, cr4 = 4, cr5 = 5, cr6 = 6, cr7 = 7,
+    cr8 = 8, cr9 = 9, cr10 = 10, cr11 = 11, cr12 = 12, cr13 = 13, cr14 = 14,
+    cr15 = 15,
+
+    R_INVLD = -1
+} darm_reg_t;
+
+typedef enum _darm_cond_t {
+    C_EQ = 0, C_NE = 1, C_CS = 2, C_CC = 3, C_MI = 4,
+    C_PL = 5, C_VS = 6, C_VC = 7, C_HI = 8, C_LS = 9,
+    C_GE = 10, C_LT = 11, C_GT = 12, C_LE = 13, C_AL = 14,
+
+    C_HS = C_CS, C_LO = C_CC,
+    C_UNCOND = 15,
+
+    C_INVLD = -1
+} darm_cond_t;
+
+typedef enum _darm_shift_type_t {
+    S_LSL = 0, S_LSR = 1, S_ASR = 2, S_ROR = 3,
+
+    S_INVLD = -1,
+} darm_shift_type_t;
+
+typedef enum _darm_option_t {
+    O_SY    = 15, // b1111
+    O_ST    = 14, // b1110
+    O_ISH   = 11, // b1011
+    O_ISHST = 10, // b1010
+    O_NSH   = 7,  // b0111
+    O_NSHST = 6,  // b0110
+    O_OSH   = 3,  // b0011
+    O_OSHST = 2,  // b0010
+
+    O_INVLD = -1,
+} darm_option_t;
+
+// coarse classes of ARMv7 instructions, based on the condition and bits
+// 27..25 (and bit 4 or bits 7 and 4) of the encoding
+typedef enum _darm_class_t {
+    DC_DATA,    // data-processing and miscellaneous instructions
+    DC_MUL,     // multiply and extra load/store instructions
+    DC_LDST,    // load/store word and unsigned byte
+    DC_MEDIA,   // media instructions
+    DC_BLOCK,   // load/store multiple
+    DC_BRANCH,  // branch and branch with link
+    DC_COPROC,  // coprocessor instructions and supervisor call
+    DC_UNCOND,  // unconditional instructions
+
+    DC_COUNT,
+} darm_class_t;
+
+// cpu features that are used by the vectorized kernels, as bitmask
+typedef enum _darm_cpu_t {
+    CPU_SSE42 = 1,
+    CPU_AVX2 = 2,
+    CPU_AVX512 = 4,
+} darm_cpu_t;
+
+// the condition flags, in the same order as they appear in the APSR
+typedef enum _darm_apsr_t {
+    APSR_V = 1, APSR_C = 2, APSR_Z = 4, APSR_N = 8,
+
+    APSR_NZCV = 15,
+} darm_apsr_t;
+
+typedef enum _darm_offset_t {
+    M_NONE, // no offset, e.g., LDM or LDREX
+    M_IMM,  // immediate offset
+    M_REG,  // (shifted) register offset
+} darm_offset_t;
+
+typedef struct _darm_mem_t {
+    // base register, this is PC for literal loads and SP for PUSH and POP
+    darm_reg_t      base;
+
+    // the kind of offset, for M_IMM the offset is a signed immediate,
+    // for M_REG the index register is shifted and then added to or
+    // subtracted from the base register
+    darm_offset_t   offset_kind;
+    int32_t         offset;
+    darm_reg_t      index;
+    darm_shift_type_t shift_type;
+    uint32_t        shift;
+    uint8_t         subtract;
+
+    // the size of each access in bytes, and the amount of accesses, e.g.,
+    // four bytes times two for LDRD
+    uint8_t         size;
+    uint8_t         count;
+
+    uint8_t         load;
+    uint8_t         store;
+    uint8_t         sign_extend;
+    uint8_t         exclusive;
+
+    // is the base register updated, and if so, is the access performed
+    // before the update (post-indexed addressing)
+    uint8_t         writeback;
+    uint8_t         post_index;
+} darm_mem_t;
+
+typedef struct _darm_t {
+    // the original encoded instruction
+    uint32_t        w;
+
+    // the instruction label
+    darm_instr_t    instr;
+    darm_enctype_t  instr_type;
+    darm_enctype_t  instr_imm_type;  // thumb2 immediate type
+    darm_enctype_t  instr_flag_type; // thumb2 flag type
+
+    // conditional flags, if any
+    darm_cond_t     cond;
+
+    // if set, swap only one byte, otherwise swap four bytes
+    uint32_t        B;
+
+    // does this instruction update the conditional flags?
+    uint32_t        S;
+
+    // endian specifier for the SETEND instruction
+    uint32_t        E;
+
+    // whether halfwords should be swapped before various signed
+    // multiplication operations
+    uint32_t        M;
+
+    // specifies, together with the M flag, which half of the source
+    // operand is used to multiply
+    uint32_t        N;
+
+    // option operand for the DMB, DSB and ISB instructions
+    darm_option_t   option;
+
+    // to add or to subtract the immediate, this is used for instructions
+    // which take a relative offset to a pointer or to the program counter
+    uint32_t        U;
+
+    // the bit for the unconditional BLX instruction which allows one to
+    // branch with link to a 2-byte aligned thumb2 instruction
+    uint32_t        H;
+
+    // specifies whether this instruction uses pre-indexed addressing or
+    // post-indexed addressing
+    uint32_t        P;
+
+    // specifies whether signed multiplication results should be rounded
+    // or not
+    uint32_t        R;
+
+    // the PKH instruction has two variants, namely, PKHBT and PKHTB, the
+    // tbform is represented by T, i.e., if T = 1 then the instruction is
+    // PKHTB, otherwise it's PKHBT
+    uint32_t        T;
+
+    // write-back bit
+    uint32_t        W;
+
+    // flag which specifies whether an immediate has been set
+    uint32_t        I;
+
+    // rotation value
+    uint32_t        rotate;
+
+    // register operands
+    darm_reg_t      Rd; // destination
+    darm_reg_t      Rn; // first operand
+    darm_reg_t      Rm; // second operand
+    darm_reg_t      Ra; // accumulate operand
+    darm_reg_t      Rt; // transferred operand
+    darm_reg_t      Rt2; // second transferred operand
+
+    // for instructions which produce a 64bit output we have to specify a
+    // high and a low 32bits destination register
+    darm_reg_t      RdHi; // high 32bits destination
+    darm_reg_t      RdLo; // low 32bits destination
+
+    // immediate operand
+    uint32_t        imm;
+    uint32_t        sat_imm;
+
+    // register shift info
+    darm_shift_type_t shift_type;
+    darm_reg_t      Rs;
+    uint32_t        shift;
+
+    // certain instructions operate on bits, they specify the lowest or highest
+    // significant bit to be used, as well as the width, the amount of bits
+    // that are affected
+    uint32_t        lsb;
+    uint32_t        msb;
+    uint32_t        width;
+
+    // bitmask of registers affected by the STM/LDM/PUSH/POP instruction
+    uint16_t        reglist;
+
+    // special registers and values for the MRC/MCR/etc instructions
+    uint8_t         coproc;
+    uint8_t         opc1;
+    uint8_t         opc2;
+    darm_reg_t      CRd;
+    darm_reg_t      CRn;
+    darm_reg_t      CRm;
+    uint32_t        D;
+
+    // condition and mask for the IT instruction
+    darm_cond_t     firstcond;
+    uint8_t         mask;
+
+    // bitmask of the registers that are read and written by this
+    // instruction, including implicit ones such as SP for PUSH and POP
+    uint16_t        regs_read;
+    uint16_t        regs_written;
+} darm_t;
+
+// IT block state for disassembling a stream of Thumb instructions
+typedef struct _darm_it_t {
+    // the ITSTATE, i.e., the condition of the next instruction in the upper
+    // four bits followed by the remaining mask, zero outside of an IT block
+    uint8_t         state;
+} darm_it_t;
+
+typedef struct _darm_str_t {
+    // the full mnemonic, including extensions, flags, etc.
+    char mnemonic[12];
+
+    // a representation of each argument in a separate string
+    char arg[6][32];
+
+    // representation of shifting, if present
+    char shift[12];
+
+    // the entire instruction
+    char total[64];
+} darm_str_t;
+
+// reset a darm object, this function is internally called right before using
+// any of the disassemble routines, hence a user is normally not required to
+// call this function beforehand
+void darm_init(darm_t *d);
+
+// calculate the regs_read and regs_written masks from the operands, this
+// function is internally called by each of the disassemble routines
+void darm_regs_update(darm_t *d);
+
+// disassemble an armv7 instruction
+int darm_armv7_disasm(darm_t *d, uint32_t w);
+
+// classify count armv7 instructions, using the vectorized kernels that are
+// supported by the cpu, see darm_cpu_select
+void darm_armv7_classify(const uint32_t *w, uint32_t count, uint8_t *cls);
+
+// disassemble count armv7 instructions, grouped by their class; entries that
+// can't be disassembled have instr set to I_INVLD, returns the amount of
+// instructions that were disassembled successfully
+uint32_t darm_armv7_disasm_batch(darm_t *d, const uint32_t *w,
+    uint32_t count);
+
+// sets one bit per halfword of the Thumb code in buf for the start of each
+// instruction, assuming that the first halfword starts an instruction;
+// starts has to hold a bit for each of the len / 2 halfwords
+void darm_thumb_bitmap(const uint8_t *buf, uint32_t len, uint64_t *starts);
+
+// same as darm_thumb_bitmap, but writes the offset in bytes of each
+// instruction to starts (which has room for len / 2 entries), returns the
+// amount of instructions
+uint32_t darm_thumb_starts(const uint8_t *buf, uint32_t len,
+    uint32_t *starts);
+
+// the cpu features the vectorized kernels are able to use, darm_cpu_t
+uint32_t darm_cpu_features();
+
+//
+// Selects the kernels for the features, e.g., 0 for the portable scalar
+// kernels, limited to what the cpu supports. By default the best kernels
+// are selected on first use, which is thread-safe. Returns the features
+// the selected kernels use.
+//
+uint32_t darm_cpu_select(uint32_t features);
+
+// reverse the byte order of count words or halfwords, e.g., to disassemble
+// big-endian images; dst may be equal to src
+void darm_bswap32(uint32_t *dst, const uint32_t *src, uint32_t count);
+void darm_bswap16(uint16_t *dst, const uint16_t *src, uint32_t count);
+
+// gathers the bits of value that are selected by mask into the lower bits,
+// i.e., the pext instruction of BMI2 (which is used when compiled for it)
+uint32_t darm_pext(uint32_t value, uint32_t mask);
+
+// disassemble a thumb instruction
+int darm_thumb_disasm(darm_t *d, uint16_t w);
+
+// disassemble a thumb2 instruction
+int darm_thumb2_disasm(darm_t *d, uint16_t w, uint16_t w2);
+
+//
+// Disassembles an instruction - determines instruction set
+// (ARMv7 or Thumb/Thumb2) based on the address and determines Thumb or
+// Thumb2 mode based on the instruction itself.
+//
+// Takes two 16 bit words as input, the first representing the lower 16 bits
+// and the second 16 bit word representing the upper 16 bits of the possibly
+// full 32 bits.
+//
+// Returns 0 on failure, 1 for Thumb, 2 for Thumb2, and 2 for ARMv7. In other
+// words, the function returns the amount of 16 bit words that were used to
+// disassemble this instruction.
+//
+// Note that, in order to instruct the disassembler to disassemble a Thumb or
+// Thumb2 instruction, the address has to have the least significant bit set.
+// That is, given a 4-byte aligned addr, addr is disassembled as 32bit ARMv7
+// instruction, addr+1 is disassembled as Thumb or Thumb2 instruction, and
+// addr+3 is also disassembled as Thumb/Thumb2. Furthermore, addr+2 is
+// disassembled as ARMv7, but do not rely on this being defined behavior in
+// the ARM CPU.
+//
+int darm_disasm(darm_t *d, uint16_t w, uint16_t w2, uint32_t addr);
+
+//
+// The length in 16 bit words of the instruction starting with w, i.e., the
+// value that darm_disasm returns on success, without disassembling it. Each
+// ARMv7 instruction (thumb is zero) has a length of two, as does each Thumb2
+// instruction, which is recognized by 0b11101, 0b11110, or 0b11111 in the
+// upper five bits of its first 16 bit word (section A6.1 of the manual).
+//
+static inline int darm_insn_length(uint16_t w, int thumb)
+{
+    return thumb == 0 || w >= 0xe800 ? 2 : 1;
+}
+
+// same as darm_disasm, but the mode and length dispatch is inlined into the
+// caller, so that it calls the decoder of the instruction set directly
+static inline int darm_disasm_inline(darm_t *d, uint16_t w, uint16_t w2,
+    uint32_t addr)
+{
+    if((addr & 1) == 0) {
+        return darm_armv7_disasm(d, ((uint32_t) w2 << 16) | w) < 0 ? 0 : 2;
+    }
+
+    if(darm_insn_length(w, 1) == 1) {
+        return darm_thumb_disasm(d, w) < 0 ? 0 : 1;
+    }
+
+    return darm_thumb2_disasm(d, w, w2) < 0 ? 0 : 2;
+}
+
+// reset the IT block state, e.g., at the start of a function
+void darm_it_init(darm_it_t *it);
+
+// applies the IT block state to the Thumb or Thumb2 instruction d, which
+// has just been disassembled with return value ret, i.e., an instruction
+// inside an IT block gets the condition of the block, and advances the
+// state to the next instruction
+void darm_it_apply(darm_it_t *it, darm_t *d, int ret);
+
+// same as darm_disasm, but keeps track of IT blocks in the given state
+int darm_disasm_it(darm_it_t *it, darm_t *d, uint16_t w, uint16_t w2,
+    uint32_t addr);
+
+// disassembles the instruction stored at buf, which is mapped at address
+// addr (again with the least significant bit set for Thumb), without reading
+// more than len bytes; return values are the same as for darm_disasm
+int darm_disasm_buf(darm_t *d, const uint8_t *buf, uint32_t len,
+    uint32_t addr);
+
+//
+// Calculates the absolute target of a direct branch (B, BL, BLX, CBZ and
+// CBNZ) which has been disassembled at address pc, taking care of the
+// different pc offsets for ARMv7 and Thumb/Thumb2. As with darm_disasm, the
+// least significant bit of pc has to be set for Thumb and Thumb2.
+//
+// Returns 0 on success, in which case target_is_thumb (if not NULL)
+// specifies whether the instruction set is Thumb at the target address,
+// e.g., after a BLX. Returns -1 for anything that's not a direct branch.
+//
+int darm_branch_target(const darm_t *d, uint32_t pc, uint32_t *target,
+    int *target_is_thumb);
+
+// batched version of darm_branch_target, d[idx] has been disassembled at
+// address pc[idx]; entries without static target get a target_is_thumb of
+// -1, returns the amount of direct branches
+uint32_t darm_branch_targets(const darm_t *d, const uint32_t *pc,
+    uint32_t count, uint32_t *targets, int8_t *target_is_thumb);
+
+// the condition flags that are read (e.g., due to a condition code) and
+// written by this instruction, as bitmask of darm_apsr_t
+uint32_t darm_flags_read(const darm_t *d);
+uint32_t darm_flags_written(const darm_t *d);
+
+// describes the memory access of this instruction, returns -1 if this
+// instruction doesn't access memory
+int darm_mem(const darm_t *d, darm_mem_t *mem);
+
+int darm_immshift_decode(const darm_t *d, const char **type,
+    uint32_t *immediate);
+
+const char *darm_mnemonic_name(darm_instr_t instr);
+const char *darm_enctype_name(darm_enctype_t enctype);
+const char *darm_register_name(darm_reg_t reg);
+const char *darm_shift_type_name(darm_shift_type_t shifttype);
+
+// postfix for each condition, e.g., EQ, NE
+const char *darm_condition_name(darm_cond_t cond, int omit_always_execute);
+
+// meaning if this condition is used for regular instructions
+const char *darm_condition_meaning_int(darm_cond_t cond);
+
+// meaning if this condition is used for floating point instructions
+const char *darm_condition_meaning_fp(darm_cond_t cond);
+
+// look up a condition code, e.g., "EQ" => C_EQ
+darm_cond_t darm_condition_index(const char *condition_code);
+
+int darm_reglist(uint16_t reglist, char *out);
+void darm_dump(const darm_t *d);
+
+int darm_str(const darm_t *d, darm_str_t *str);
+int darm_str2(const darm_t *d, darm_str_t *str, int lowercase);
+
+#endif
+// ---- cfg.h ----
+
+#ifndef __CFG_H__
+#define __CFG_H__
+
+
+typedef enum _darm_flow_t {
+    // regular instruction, execution continues at the next instruction
+    F_NONE,
+
+    // branch with link, returns to the next instruction
+    F_CALL,
+
+    // direct branch, see darm_branch_target for its target
+    F_JUMP,
+
+    // branch to a computed address, e.g., BX LR, POP {pc}, or LDR pc, [..]
+    F_INDIRECT,
+
+    // table branch, i.e., TBB and TBH
+    F_TABLE,
+} darm_flow_t;
+
+typedef enum _darm_edge_t {
+    E_FALLTHROUGH, E_BRANCH,
+
+    // one of the cases of a switch, see darm_jt_step
+    E_CASE,
+} darm_edge_t;
+
+typedef struct _darm_cfg_t {
+    uint32_t        block_count;
+    uint32_t        edge_count;
+
+    // start address of each basic block, sorted, with the least significant
+    // bit set for Thumb, and the size of each block in bytes
+    uint32_t        *block_addr;
+    uint32_t        *block_size;
+
+    // the successors of block idx are stored in compressed sparse row form,
+    // i.e., edge_target[edge_index[idx]] up to edge_target[edge_index[idx+1]]
+    // are the indices of its successor blocks
+    uint32_t        *edge_index;
+    uint32_t        *edge_target;
+    uint8_t         *edge_type;
+} darm_cfg_t;
+
+// determine how an instruction affects the control flow
+darm_flow_t darm_flow(const darm_t *d);
+
+// whether the instruction might not be executed, i.e., a branch could be
+// taken or the next instruction will be executed
+int darm_flow_is_cond(const darm_t *d);
+
+//
+// Builds the control flow graph for the range start..end by linear sweep,
+// buf is the image mapped at address base and len is its size in bytes. As
+// usual, the least significant bit of start specifies whether the range is
+// Thumb code. Basic blocks are split at direct branch and call targets
+// inside the range, at the cases of resolved switches, and after each
+// branch, return, or table branch.
+//
+// Returns 0 on success, -1 on invalid ranges or allocation failures.
+//
+int darm_cfg_build(darm_cfg_t *cfg, const uint8_t *buf, uint32_t len,
+    uint32_t base, uint32_t start, uint32_t end);
+
+// index of the basic block starting at addr, or -1
+int32_t darm_cfg_block(const darm_cfg_t *cfg, uint32_t addr);
+
+void darm_cfg_free(darm_cfg_t *cfg);
+
+#endif
+// ---- data.h ----
+
+#ifndef __DATA_H__
+#define __DATA_H__
+
+
+typedef struct _darm_data_t {
+    // the address range covered by the bitmap
+    uint32_t        base;
+    uint32_t        len;
+
+    // one bit per halfword, set for literal pools and jump tables
+    uint64_t        *bitmap;
+
+    // the last register that has been compared against an immediate, which
+    // gives the amount of entries of a following TBB or TBH table
+    darm_reg_t      cmp_reg;
+    uint32_t        cmp_imm;
+} darm_data_t;
+
+int darm_data_init(darm_data_t *dd, uint32_t base, uint32_t len);
+
+//
+// Marks the data that is referenced by instruction d, which has been
+// disassembled at address addr (with the least significant bit set for
+// Thumb), i.e., the literal of a PC-relative load, or the table following
+// a TBB or TBH instruction. Instructions have to be passed in program
+// order, as the size of a table is taken from the preceding CMP.
+//
+// Returns 1 if any data was marked, 0 otherwise.
+//
+int darm_data_mark(darm_data_t *dd, const darm_t *d, uint32_t addr);
+
+// marks size bytes at addr as data, returns 1 if any of them are in range
+int darm_data_set(darm_data_t *dd, uint32_t addr, uint32_t size);
+
+// whether the halfword at addr has been marked as data
+int darm_data_get(const darm_data_t *dd, uint32_t addr);
+
+void darm_data_free(darm_data_t *dd);
+
+#endif
+// ---- descent.h ----
+
+#ifndef __DESCENT_H__
+#define __DESCENT_H__
+
+// ---- jumptable.h ----
+
+#ifndef __JUMPTABLE_H__
+#define __JUMPTABLE_H__
+
+
+// switches with more cases than this are assumed to be a bogus bounds check,
+// e.g., a compare against a large immediate in data that has been decoded
+#define DARM_JT_MAXCASES 4096
+
+typedef struct _darm_jt_t {
+    // the image, mapped at address base, from which the tables are read
+    const uint8_t   *buf;
+    uint32_t        len;
+    uint32_t        base;
+
+    // the last register that has been compared against an immediate, and
+    // the amount of cases once the bounds check has been seen, i.e., a
+    // conditional branch on the result of the compare
+    darm_reg_t      reg;
+    uint32_t        imm;
+    uint32_t        count;
+
+    // the table of the last resolved switch if it contains data, e.g., the
+    // offsets for TBB, and zero if the table consists of instructions
+    uint32_t        table_addr;
+    uint32_t        table_size;
+} darm_jt_t;
+
+void darm_jt_init(darm_jt_t *jt, const uint8_t *buf, uint32_t len,
+    uint32_t base);
+
+//
+// Feeds the next instruction d, disassembled at address addr (with the
+// least significant bit set for Thumb), into the jump table resolver. The
+// instructions have to be given in program order, as the amount of cases
+// is taken from a preceding bounds check, e.g., cmp r0, #7 and bhi.
+//
+// The following switch idioms are recognized.
+// - tbb [pc, Rm] and tbh [pc, Rm, lsl #1]
+// - addls pc, pc, Rm, lsl #2 followed by a branch for each case
+// - ldrls pc, [pc, Rm, lsl #2] followed by a table of addresses
+//
+// Returns the amount of cases if d dispatches a switch, of which at most
+// max targets are written to targets (with the least significant bit set
+// for Thumb), and 0 otherwise.
+//
+uint32_t darm_jt_step(darm_jt_t *jt, const darm_t *d, uint32_t addr,
+    uint32_t *targets, uint32_t max);
+
+#endif
+
+typedef struct _darm_rd_t {
+    // the image, mapped at address base
+    const uint8_t   *buf;
+    uint32_t        len;
+    uint32_t        base;
+
+    // one bit per halfword of the image, visited is set for the start of
+    // each reachable instruction, and thumb specifies its instruction set
+    uint64_t        *visited;
+    uint64_t        *thumb;
+
+    // literal pools and jump tables referenced by the reachable code, these
+    // are never disassembled
+    darm_data_t     data;
+
+    // resolves the switches along the current path
+    darm_jt_t       jt;
+
+    // amount of reachable instructions found so far
+    uint32_t        insn_count;
+
+    // worklist of addresses which still have to be followed, with the
+    // least significant bit set for Thumb
+    uint32_t        *work;
+    uint32_t        work_count;
+    uint32_t        work_alloc;
+} darm_rd_t;
+
+int darm_rd_init(darm_rd_t *rd, const uint8_t *buf, uint32_t len,
+    uint32_t base);
+
+// adds a starting point, e.g., the entry point or a function symbol, the
+// least significant bit of addr is set for Thumb code
+int darm_rd_seed(darm_rd_t *rd, uint32_t addr);
+
+//
+// Follows the control flow from all seeds until the worklist is empty,
+// i.e., disassembles only the code which is reachable through direct
+// branches and calls (switching between ARMv7 and Thumb on BLX) and falls
+// through conditional branches and calls, and into the cases of switches
+// which can be resolved. Paths end at unconditional branches, returns,
+// table branches, undecodable instructions, and data.
+//
+// Returns the amount of reachable instructions, or -1 on allocation
+// failures.
+//
+int darm_rd_run(darm_rd_t *rd);
+
+// whether the instruction at addr is reachable, returns 1 for ARMv7,
+// 2 for Thumb, and 0 if it has not been visited or if it is data
+int darm_rd_visited(const darm_rd_t *rd, uint32_t addr);
+
+void darm_rd_free(darm_rd_t *rd);
+
+#endif
+// ---- fold.h ----
+
+#ifndef __FOLD_H__
+#define __FOLD_H__
+
+
+// a 32-bit constant that has been built by a MOVW/MOVT pair
+typedef struct _darm_const_t {
+    // address of the MOVW and of the MOVT, i.e., the value is available in
+    // reg right after the instruction at addr
+    uint32_t        movw_addr;
+    uint32_t        addr;
+
+    darm_reg_t      reg;
+    uint32_t        value;
+} darm_const_t;
+
+typedef struct _darm_fold_t {
+    // amount of instructions that a MOVW stays pending
+    uint32_t        window;
+
+    // instruction counter, incremented for each darm_fold_step call
+    uint32_t        index;
+
+    // bitmask of registers with a pending MOVW, and for each of those the
+    // lower halfword, the address, the condition, and the instruction index
+    uint16_t        pending;
+    uint16_t        low[16];
+    uint32_t        movw_addr[16];
+    darm_cond_t     cond[16];
+    uint32_t        movw_index[16];
+} darm_fold_t;
+
+// a window of zero is replaced by a default of 16 instructions
+void darm_fold_init(darm_fold_t *f, uint32_t window);
+
+//
+// Feeds the next instruction d, which has been disassembled at address
+// addr, into the folding pass; instructions have to be given in program
+// order. Pending MOVW values are dropped at the end of each basic block,
+// when the register is overwritten, or after window instructions.
+//
+// Returns 1 and fills in out if this instruction is the MOVT that
+// completes a pair, returns 0 otherwise.
+//
+int darm_fold_step(darm_fold_t *f, const darm_t *d, uint32_t addr,
+    darm_const_t *out);
+
+// drops all pending values, e.g., when the next instruction is a branch
+// target
+void darm_fold_reset(darm_fold_t *f);
+
+#endif
+// ---- funcs.h ----
+
+#ifndef __FUNCS_H__
+#define __FUNCS_H__
+
+
+typedef struct _darm_funcs_t {
+    // start address of each function, with the least significant bit set
+    // for Thumb, sorted once darm_funcs_sort has been called
+    uint32_t        *start;
+    uint32_t        count;
+    uint32_t        alloc;
+} darm_funcs_t;
+
+void darm_funcs_init(darm_funcs_t *f);
+
+// adds a function start, e.g., the entry point or a symbol
+int darm_funcs_add(darm_funcs_t *f, uint32_t addr);
+
+//
+// Adds the function starts from the .ARM.exidx section, which is mapped at
+// address addr and has a size of len bytes. Each entry consists of two
+// words, the first of which is a 31-bit offset relative to the entry to the
+// start of the function. The least significant bit is kept as encoded.
+//
+// Returns 0 on success, -1 on a malformed section or allocation failures.
+//
+int darm_funcs_exidx(darm_funcs_t *f, const uint8_t *buf, uint32_t len,
+    uint32_t addr);
+
+//
+// Scans the image buf, mapped at address base, for function prologues,
+// i.e., push {.., lr}, stmdb sp!, {.., lr}, str lr, [sp, #-4]!, and
+// sub sp, sp, #imm unless it's within three instructions after one of the
+// others without a branch in between. All instructions
+// are first matched against mask/value patterns, only candidates are fully
+// disassembled. The least significant bit of base specifies whether the
+// image is scanned for Thumb or ARMv7 prologues.
+//
+// Returns 0 on success, -1 on allocation failures.
+//
+int darm_funcs_scan(darm_funcs_t *f, const uint8_t *buf, uint32_t len,
+    uint32_t base);
+
+// sorts the function starts and removes duplicates, a Thumb start is kept
+// over an ARMv7 start at the same address
+void darm_funcs_sort(darm_funcs_t *f);
+
+void darm_funcs_free(darm_funcs_t *f);
+
+#endif
+// ---- gadget.h ----
+
+#ifndef __GADGET_H__
+#define __GADGET_H__
+
+
+typedef struct _darm_gadget_t {
+    // address of the first instruction, with the least significant bit set
+    // for Thumb gadgets
+    uint32_t        addr;
+
+    // size in bytes and amount of instructions, including the terminator
+    uint32_t        size;
+    uint32_t        count;
+
+    // hash of the disassembled instructions
+    uint64_t        hash;
+} darm_gadget_t;
+
+typedef struct _darm_gadgets_t {
+    darm_gadget_t   *gadget;
+    uint32_t        count;
+    uint32_t        alloc;
+
+    // open addressing hash set of the gadget hashes, zero marks an empty
+    // slot, table_size is a power of two
+    uint64_t        *table;
+    uint32_t        table_size;
+} darm_gadgets_t;
+
+void darm_gadgets_init(darm_gadgets_t *g);
+
+//
+// Finds the gadgets of at most depth instructions in the image buf, which
+// is mapped at address base, that end with a terminator at an offset in the
+// range [start, end), start being a multiple of four. Terminators are
+// BX LR, POP {.., pc}, LDM {.., pc}, LDR pc, [sp], #4, and BLX Rm, both in
+// ARMv7 and Thumb mode. They are located using darm_search, after which the
+// instructions before them are disassembled from every word (ARMv7) or
+// halfword (Thumb) offset. A gadget may start before start, but only
+// contains instructions that don't change the flow of execution.
+//
+// Gadgets are deduplicated by the hash of their disassembled instructions,
+// only the first occurrence is kept. Searching disjoint ranges into
+// separate darm_gadgets_t objects, e.g., from multiple threads, and merging
+// them afterwards gives the same unique gadgets as a single search.
+//
+// Returns 0 on success, -1 on allocation failures.
+//
+int darm_gadgets_find(darm_gadgets_t *g, const uint8_t *buf, uint32_t len,
+    uint32_t base, uint32_t start, uint32_t end, uint32_t depth);
+
+// adds the gadgets of other which aren't in g yet
+int darm_gadgets_merge(darm_gadgets_t *g, const darm_gadgets_t *other);
+
+void darm_gadgets_free(darm_gadgets_t *g);
+
+#endif
+// ---- ngram.h ----
+
+#ifndef __NGRAM_H__
+#define __NGRAM_H__
+
+
+// normalized instruction of an undecodable word or halfword
+#define DARM_TOKEN_INVLD 0
+
+//
+// Normalizes an instruction into a 32-bit token, consisting of the
+// instruction and the kinds of its operands, i.e., which register operands
+// are present, whether there's an immediate, a shift, a register list, and
+// a condition. The actual registers and immediates are abstracted away, so
+// the same code compiled with a different register allocation or with
+// different constants has the same tokens.
+//
+uint32_t darm_ngram_token(const darm_t *d);
+
+//
+// Normalizes the instructions of a function that starts at address addr
+// (with the least significant bit set for Thumb) of which the code is
+// located in buf, i.e., buf[0] is at address addr. IT blocks are taken into
+// account, undecodable words (ARMv7) or halfwords (Thumb) are represented
+// by DARM_TOKEN_INVLD. Returns the amount of tokens, at most max.
+//
+uint32_t darm_ngram_tokens(const uint8_t *buf, uint32_t len, uint32_t addr,
+    uint32_t *tokens, uint32_t max);
+
+//
+// Hashes each sequence of n consecutive tokens into a 64-bit key, i.e.,
+// count - n + 1 keys are written to keys (none if count < n). Returns the
+// amount of keys.
+//
+uint32_t darm_ngram_keys(const uint32_t *tokens, uint32_t count, uint32_t n,
+    uint64_t *keys);
+
+typedef struct _darm_ngram_pair_t {
+    uint64_t        key;
+    uint32_t        doc;
+} darm_ngram_pair_t;
+
+typedef struct _darm_ngram_doc_t {
+    // index of the file and the address of the function
+    uint32_t        file;
+    uint32_t        addr;
+} darm_ngram_doc_t;
+
+// in-memory index that is being built
+typedef struct _darm_ngram_builder_t {
+    uint32_t        n;
+
+    darm_ngram_pair_t *pair;
+    uint32_t        pair_count;
+    uint32_t        pair_alloc;
+
+    darm_ngram_doc_t *doc;
+    uint32_t        doc_count;
+    uint32_t        doc_alloc;
+
+    char            **file;
+    uint32_t        file_count;
+    uint32_t        file_alloc;
+} darm_ngram_builder_t;
+
+void darm_ngram_builder_init(darm_ngram_builder_t *b, uint32_t n);
+
+// adds a file, returns its index or -1 on allocation failures
+int32_t darm_ngram_add_file(darm_ngram_builder_t *b, const char *name);
+
+// adds a function of a file and its keys, returns the index of the
+// function (the document) or -1 on allocation failures
+int32_t darm_ngram_add_doc(darm_ngram_builder_t *b, uint32_t file,
+    uint32_t addr, const uint64_t *keys, uint32_t count);
+
+// moves the files, functions, and keys of other into b, e.g., after
+// building parts of the index in separate threads; other is freed
+int darm_ngram_builder_merge(darm_ngram_builder_t *b,
+    darm_ngram_builder_t *other);
+
+//
+// Writes the index to fname. The file consists of a header, the first key
+// of each block of DARM_NGRAM_BLOCK keys, the sorted keys, the offsets of
+// their postings, the documents, the file names, and the postings, i.e.,
+// the ascending document indices of each key, delta-coded as LEB128.
+// Everything is in host byte order. The keys of b are consumed, its files
+// and functions are kept. Returns 0 on success, -1 on failure.
+//
+int darm_ngram_write(darm_ngram_builder_t *b, const char *fname);
+
+void darm_ngram_builder_free(darm_ngram_builder_t *b);
+
+#define DARM_NGRAM_BLOCK 64
+
+// memory-mapped index
+typedef struct _darm_ngram_index_t {
+    const uint8_t   *map;
+    uint64_t        size;
+
+    uint32_t        n;
+    uint32_t        key_count;
+    uint32_t        block_count;
+    uint32_t        doc_count;
+    uint32_t        file_count;
+
+    const uint64_t  *block;
+    const uint64_t  *keys;
+    const uint64_t  *offsets;
+    const uint8_t   *postings;
+    uint64_t        postings_size;
+    const darm_ngram_doc_t *doc;
+    const uint32_t  *names;
+    const char      *strings;
+    uint64_t        strings_size;
+} darm_ngram_index_t;
+
+// maps an index written by darm_ngram_write, returns 0 on success, -1 if
+// the file can't be mapped or isn't a valid index
+int darm_ngram_open(darm_ngram_index_t *ix, const char *fname);
+
+//
+// Looks up the documents that contain key, writes at most max document
+// indices in ascending order to docs. Returns the total amount of
+// documents, which may exceed max.
+//
+uint32_t darm_ngram_lookup(const darm_ngram_index_t *ix, uint64_t key,
+    uint32_t *docs, uint32_t max);
+
+// the file name and function address of a document, or NULL
+const char *darm_ngram_doc(const darm_ngram_index_t *ix, uint32_t doc,
+    uint32_t *addr);
+
+void darm_ngram_close(darm_ngram_index_t *ix);
+
+#endif
+// ---- search.h ----
+
+#ifndef __SEARCH_H__
+#define __SEARCH_H__
+
+
+typedef struct _darm_hit_t {
+    // address of the instruction, with the least significant bit set for
+    // Thumb and Thumb2 instructions
+    uint32_t        addr;
+
+    // index of the first pattern that matched
+    uint32_t        pattern;
+
+    // the instruction as disassembled, which is not necessarily the
+    // instruction of the pattern, e.g., for aliases such as push and stmdb
+    darm_instr_t    instr;
+} darm_hit_t;
+
+//
+// One bit for each of the count (at most 64) words, set if the word matches
+// the pattern, i.e., if (words[idx] & mask) == value. Thumb instructions are
+// represented as a 32-bit word with the first halfword in the upper half.
+//
+uint64_t darm_match_block(const uint32_t *words, uint32_t count,
+    uint32_t mask, uint32_t value);
+
+//
+// Searches the image buf, mapped at address base, for instructions that
+// match any of the patterns, e.g., darm_patterns which contains one pattern
+// for each encoding, or patterns given by hand. ARMv7 patterns are matched
+// at every word, Thumb and Thumb2 patterns at every halfword. Every word is
+// matched against the patterns before anything is disassembled, candidates
+// are only reported if they disassemble to an instruction of the size of
+// the pattern. The disassembled instruction may differ from the instruction
+// of the pattern, e.g., for aliases or for ARMv7 encodings with condition
+// 0b1111, so callers that care should check the instr of the hit.
+//
+// At most max hits are written to hits, ARMv7 hits first and Thumb hits
+// after that, both ordered by address. Returns the total amount of hits,
+// which may exceed max.
+//
+uint32_t darm_search(const darm_pattern_t *patterns, uint32_t count,
+    const uint8_t *buf, uint32_t len, uint32_t base, darm_hit_t *hits,
+    uint32_t max);
+
+#endif
+// ---- stack.h ----
+
+#ifndef __STACK_H__
+#define __STACK_H__
+
+
+// depth of instructions that have not been reached
+#define DARM_STACK_NONE INT32_MIN
+
+typedef struct _darm_stack_t {
+    // the image, mapped at address base
+    const uint8_t   *buf;
+    uint32_t        len;
+    uint32_t        base;
+
+    // one entry per halfword of the image, the amount of bytes that has been
+    // pushed onto the stack since the start of the function, right before
+    // the instruction at this address is executed
+    int32_t         *depth;
+
+    // halfword offsets of the instructions which have been reached in the
+    // last analyzed function
+    uint32_t        *insns;
+    uint32_t        insn_count;
+    uint32_t        insn_alloc;
+
+    // worklist of addresses which still have to be followed, with the
+    // least significant bit set for Thumb
+    uint32_t        *work;
+    uint32_t        work_count;
+    uint32_t        work_alloc;
+
+    // the maximum depth of the last analyzed function, the amount of
+    // instructions that modify the stack pointer by an unknown amount (e.g.,
+    // mov sp, r7), and the amount of paths that join with different depths
+    uint32_t        max_depth;
+    uint32_t        unknown;
+    uint32_t        mismatch;
+} darm_stack_t;
+
+//
+// Calculates the change of the stack pointer by instruction d in bytes, a
+// negative delta for PUSH and the like. Instructions that don't touch the
+// stack pointer have a delta of zero.
+//
+// Returns 0 on success, -1 if the stack pointer is modified by an unknown
+// amount, e.g., mov sp, r7 or add sp, sp, r0, or only conditionally, e.g.,
+// addne sp, sp, #8. A conditional return such as popne {r4, pc} has a
+// delta of zero, as it only changes the stack pointer when leaving.
+//
+int darm_sp_delta(const darm_t *d, int32_t *delta);
+
+int darm_stack_init(darm_stack_t *s, const uint8_t *buf, uint32_t len,
+    uint32_t base);
+
+//
+// Propagates the stack depth through the function starting at func (with
+// the least significant bit set for Thumb) along its fallthroughs and
+// direct branches, calls are assumed to leave the stack pointer as is.
+// Paths end at unconditional indirect branches, undecodable instructions,
+// and instructions that modify the stack pointer by an unknown amount.
+//
+// Afterwards the depth of each reached instruction is found in s->depth
+// and the maximum in s->max_depth; the results of the previous function
+// are discarded.
+//
+// Returns the maximum depth, or -1 on allocation failures.
+//
+int32_t darm_stack_analyze(darm_stack_t *s, uint32_t func);
+
+// the depth right before the instruction at addr in the last analyzed
+// function, or DARM_STACK_NONE if it has not been reached
+int32_t darm_stack_depth(const darm_stack_t *s, uint32_t addr);
+
+void darm_stack_free(darm_stack_t *s);
+
+#endif
+// ---- valid.h ----
+
+#ifndef __VALID_H__
+#define __VALID_H__
+
+
+// amount of words in each block of the encoding space, i.e., the upper
+// halfword of a word selects the block and the lower halfword the word
+// within that block
+#define DARM_VALID_BLOCK 65536
+
+typedef enum _darm_valid_type_t {
+    // the block hasn't been swept
+    V_UNKNOWN,
+
+    // none or all of the words are valid
+    V_EMPTY,
+    V_FULL,
+
+    // sorted lower halfwords of the valid or invalid words, count entries
+    V_ARRAY,
+    V_INVERTED,
+
+    // count runs of valid words, each as the lower halfwords of the first
+    // and the last word of the run
+    V_RUNS,
+
+    // one bit per word
+    V_BITMAP,
+} darm_valid_type_t;
+
+typedef struct _darm_valid_entry_t {
+    // offset of the container relative to the start of the data
+    uint32_t        offset;
+    uint16_t        type;
+    uint16_t        count;
+} darm_valid_entry_t;
+
+//
+// Packs the validity bitmap of a block (one bit per word, DARM_VALID_BLOCK
+// bits) into the smallest container, at most DARM_VALID_BLOCK / 8 bytes
+// are written to out. Sets the type and count of the entry, but not its
+// offset. Returns the size of the container in bytes.
+//
+uint32_t darm_valid_pack(const uint64_t *bits, uint8_t *out,
+    darm_valid_entry_t *entry);
+
+// whether the word with lower halfword low is valid according to the
+// container, returns -1 for blocks that haven't been swept
+int darm_valid_unpack(const darm_valid_entry_t *entry, const uint8_t *data,
+    uint16_t low);
+
+//
+// Writes a validity bitmap to fname, given the per-instruction counts
+// (I_INSTRCNT entries) and the entry and packed container of each of the
+// DARM_VALID_BLOCK blocks, setting the offsets of the entries. The file
+// consists of a header, the counts, the entries, and the containers; the
+// containers are stored in little endian, everything else in host byte
+// order. Returns 0 on success, -1 on failure.
+//
+int darm_valid_write(const char *fname, const uint64_t *counts,
+    darm_valid_entry_t *entry, const uint8_t *const *container);
+
+typedef struct _darm_valid_t {
+    const uint8_t   *map;
+    uint64_t        size;
+
+    // the amount of words that disassemble to each instruction, the
+    // invalid words are counted as I_INVLD
+    const uint64_t  *counts;
+    uint32_t        instr_count;
+
+    const darm_valid_entry_t *entry;
+    const uint8_t   *data;
+    uint64_t        data_size;
+} darm_valid_t;
+
+// maps a validity bitmap as written by darm_valid_write, e.g., by the
+// utils/sweepdarm tool, returns 0 on success, -1 on failure
+int darm_valid_open(darm_valid_t *v, const char *fname);
+
+// whether the ARMv7 word w is a valid instruction, -1 if unknown
+int darm_valid_get(const darm_valid_t *v, uint32_t w);
+
+// the amount of words that disassemble to instr
+uint64_t darm_valid_count(const darm_valid_t *v, darm_instr_t instr);
+
+void darm_valid_close(darm_valid_t *v);
+
+#endif
+
+#endif
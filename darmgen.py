@@ -76,30 +76,23 @@ def instruction_names_table(arr):
     return string_table('darm_mnemonics', instruction_names(arr))
 
 
-def instruction_types_table(arr, kind):
-    """Lookup table for the types of instructions."""
-    arr = ['T_%s' % arr[x][1][1] if x in arr else 'T_INVLD'
-           for x in range(256)]
-    return typed_table('darm_enctype_t', '%s_instr_types' % kind, arr)
-
-
-def instruction_names_index_table(arr, kind):
-    """Lookup table for instruction label for each instruction index."""
-    arr = ['I_%s' % arr[x][0] if x in arr else 'I_INVLD'
-           for x in range(256)]
-    return typed_table('darm_instr_t', '%s_instr_labels' % kind, arr)
+def instruction_lut_table(arr, kind):
+    """Lookup table of the instruction label and type for each index."""
+    arr = ['DARM_LUT(I_%s, T_%s)' % (arr[x][0], arr[x][1][1])
+           if x in arr else 'DARM_LUT(I_INVLD, T_INVLD)' for x in range(256)]
+    return typed_table('const darm_lut_t', '%s_instr_lut' % kind, arr)
 
 
 def instruction_names_index_table_thumb2(arr, kind):
     """Lookup table for instruction label for each Thumb2 instruction index."""
     barr = map(lambda x: 'I_%s' % str(x[0]), arr.values())
-    return typed_table('darm_instr_t', '%s_instr_labels' % kind, barr)
+    return typed_table('const uint16_t', '%s_instr_labels' % kind, barr)
 
 
 def type_lookup_table(name, *args):
     """Create a lookup table for a certain instruction type."""
     arr = ('I_%s' % x.upper() if x else 'I_INVLD' for x in args)
-    return typed_table('darm_instr_t', '%s_instr_lookup' % name, arr)
+    return typed_table('const uint16_t', '%s_instr_lookup' % name, arr)
 
 
 def type_encoding_enum(enumname, arr):
@@ -248,6 +241,277 @@ def generate_format_strings(arr):
     return ret
 
 
+# register rules, these describe how the register operands of an instruction
+# are used, in addition to the defaults (Rd, RdHi and RdLo are written, all
+# other register operands are read)
+register_rules = [
+    ('RR_RD_READ', 'Rd is read as well, e.g., MOVT, BFI'),
+    ('RR_RD_NONE', 'Rd is not written, e.g., CMP on Thumb2'),
+    ('RR_RT_WRITE', 'Rt is written, e.g., loads'),
+    ('RR_RT2_WRITE', 'Rt2 is written, e.g., LDRD'),
+    ('RR_RT_PAIR', 'Rt2 is Rt+1 if the encoding does not specify it'),
+    ('RR_HILO_READ', 'RdHi and RdLo are accumulated'),
+    ('RR_LIST_WRITE', 'the register list is written rather than read'),
+    ('RR_WRITEBACK', 'Rn is written if W is set or P is unset'),
+    ('RR_SP', 'SP is implicitly read and written'),
+    ('RR_LR_WRITE', 'LR is implicitly written'),
+    ('RR_PC_WRITE', 'PC is implicitly written'),
+    ('RR_PC_REL', 'PC is implicitly read if there is an immediate and no Rn'),
+]
+
+
+# instructions that have no encoding of their own in darmtbl, mapped to the
+# instruction whose encoding they are decoded from
+derived_instructions = {
+    'TBH': 'TBB', 'CBNZ': 'CBZ', 'PLDW': 'PLD',
+    'SMLABB': 'SMLA', 'SMLABT': 'SMLA', 'SMLATB': 'SMLA', 'SMLATT': 'SMLA',
+    'SMLALBB': 'SMLAL', 'SMLALBT': 'SMLAL', 'SMLALTB': 'SMLAL',
+    'SMLALTT': 'SMLAL',
+    'SMULBB': 'SMUL', 'SMULBT': 'SMUL', 'SMULTB': 'SMUL', 'SMULTT': 'SMUL',
+}
+
+
+def generate_register_rules(arr):
+    """Determine the register rules for each instruction, based on its name
+    and the syntax and bits of each of its encodings."""
+    ret = {}
+    for description in arr:
+        instr, bits = instruction_name(description[0]), description[1:]
+        syntax = description[0]
+        names = [getattr(x, 'name', None) for x in bits]
+
+        rules = ret.setdefault(instr, set())
+
+        if instr in ('MOVT', 'BFI', 'BFC'):
+            rules.add('RR_RD_READ')
+
+        if instr in ('CMP', 'CMN', 'TST', 'TEQ'):
+            rules.add('RR_RD_NONE')
+
+        if instr.startswith('LDR') or instr in ('POP', 'SWP', 'SWPB') or \
+                instr.startswith('MRC') or instr.startswith('MRRC'):
+            rules.add('RR_RT_WRITE')
+
+        if instr in ('LDRD', 'LDREXD') or instr.startswith('MRRC'):
+            rules.add('RR_RT2_WRITE')
+
+        if instr in ('LDRD', 'LDREXD', 'STRD', 'STREXD'):
+            rules.add('RR_RT_PAIR')
+
+        if 'MLAL' in instr or 'MLSL' in instr or instr == 'UMAAL':
+            rules.add('RR_HILO_READ')
+
+        if instr.startswith('LDM') or instr == 'POP':
+            rules.add('RR_LIST_WRITE')
+
+        # preload instructions use the W bit to indicate write intent
+        if ('!' in syntax or '],' in syntax or 'W' in names) and \
+                not instr.startswith('PL'):
+            rules.add('RR_WRITEBACK')
+
+        if instr in ('PUSH', 'POP'):
+            rules.add('RR_SP')
+
+        if instr in ('BL', 'BLX'):
+            rules.add('RR_LR_WRITE')
+
+        if instr in ('B', 'BL', 'BLX', 'BX', 'BXJ', 'CBZ', 'CBNZ',
+                     'TBB', 'TBH', 'RFE', 'ERET'):
+            rules.add('RR_PC_WRITE')
+
+        if '<label>' in syntax:
+            rules.add('RR_PC_REL')
+
+    # instructions which the decoders derive from another encoding, e.g.,
+    # TBH is the TBB encoding with the H bit set
+    for instr, base in derived_instructions.items():
+        ret.setdefault(instr, set()).update(ret.get(base, ()))
+    return ret
+
+
+# semantic rules, which flags are read and written, and how an instruction
+# accesses memory
+semantic_rules = [
+    ('SEM_WRITES_NZ', 'N and Z are written if S is set'),
+    ('SEM_WRITES_C', 'C is written if S is set'),
+    ('SEM_WRITES_V', 'V is written if S is set'),
+    ('SEM_FLAGS_ALWAYS', 'the flags are written regardless of S'),
+    ('SEM_READS_C', 'C is read, e.g., ADC'),
+    ('SEM_READS_NZCV', 'all flags are read, i.e., MRS'),
+    ('SEM_LOAD', 'memory is read'),
+    ('SEM_STORE', 'memory is written'),
+    ('SEM_BYTE', 'the memory access is a byte'),
+    ('SEM_HALF', 'the memory access is a halfword'),
+    ('SEM_DUAL', 'the memory access is two words'),
+    ('SEM_MULTI', 'the memory access is a word for each register in the list'),
+    ('SEM_SIGNED', 'the loaded value is sign-extended'),
+    ('SEM_EXCLUSIVE', 'the memory access is exclusive'),
+]
+
+
+def generate_semantic_rules(names):
+    """Determine the semantic rules for each instruction, based on its
+    name."""
+    arith = 'ADC', 'ADD', 'ADDW', 'CMN', 'CMP', 'RSB', 'RSC', 'SBC', 'SUB', \
+        'SUBW'
+    logic = 'AND', 'ASR', 'BIC', 'EOR', 'LSL', 'LSR', 'MOV', 'MVN', 'ORN', \
+        'ORR', 'ROR', 'RRX', 'TEQ', 'TST'
+    mul = 'MLA', 'MUL', 'SMLAL', 'SMULL', 'UMLAL', 'UMULL'
+
+    ret = {}
+    for instr in names:
+        rules = ret.setdefault(instr, set())
+
+        if instr in arith + logic + mul:
+            rules.add('SEM_WRITES_NZ')
+
+        if instr in arith + logic:
+            rules.add('SEM_WRITES_C')
+
+        if instr in arith:
+            rules.add('SEM_WRITES_V')
+
+        if instr in ('CMN', 'CMP', 'TEQ', 'TST', 'MSR'):
+            rules.add('SEM_FLAGS_ALWAYS')
+
+        if instr == 'MSR':
+            rules.update(('SEM_WRITES_NZ', 'SEM_WRITES_C', 'SEM_WRITES_V'))
+
+        if instr in ('ADC', 'SBC', 'RSC', 'RRX'):
+            rules.add('SEM_READS_C')
+
+        if instr == 'MRS':
+            rules.add('SEM_READS_NZCV')
+
+        # single and dual loads and stores, e.g., LDRSBT and STREXD
+        if instr[:3] in ('LDR', 'STR'):
+            rules.add('SEM_LOAD' if instr[0] == 'L' else 'SEM_STORE')
+
+            suffix = instr[3:].replace('EX', '')
+            if suffix.startswith('S'):
+                rules.add('SEM_SIGNED')
+                suffix = suffix[1:]
+
+            sizes = {'B': 'SEM_BYTE', 'H': 'SEM_HALF', 'D': 'SEM_DUAL'}
+            if suffix[:1] in sizes:
+                rules.add(sizes[suffix[0]])
+
+            if 'EX' in instr:
+                rules.add('SEM_EXCLUSIVE')
+
+        if instr[:3] in ('LDM', 'POP'):
+            rules.update(('SEM_LOAD', 'SEM_MULTI'))
+
+        if instr[:3] in ('STM', 'PUS'):
+            rules.update(('SEM_STORE', 'SEM_MULTI'))
+
+        if instr in ('SWP', 'SWPB'):
+            rules.update(('SEM_LOAD', 'SEM_STORE'))
+
+        if instr in ('SWPB', 'TBB'):
+            rules.add('SEM_BYTE')
+
+        if instr in ('TBB', 'TBH'):
+            rules.add('SEM_LOAD')
+
+        if instr == 'TBH':
+            rules.add('SEM_HALF')
+    return ret
+
+
+def rules_enum(enumname, arr):
+    """Enumeration of rules, each rule being a single bit."""
+    text = []
+    for idx, (name, info) in enumerate(arr):
+        text.append('    // %s\n    %s = 1 << %d,' % (info, name, idx))
+    return 'typedef enum _%s_t {\n%s\n} %s_t;\n' % (enumname,
+                                                    '\n'.join(text),
+                                                    enumname)
+
+
+def rules_table(name, arr, rules, count):
+    """Table with the rules that apply to each instruction."""
+    order = [x[0] for x in arr]
+    lines = []
+    for instr, rule in sorted(rules.items()):
+        if rule:
+            rule = sorted(rule, key=order.index)
+            lines.append('    [I_%s] = %s,' % (instr, ' | '.join(rule)))
+    return 'const uint16_t %s[%d] = {\n%s\n};\n' % (name, count,
+                                                   '\n'.join(lines))
+
+
+def generate_patterns(arr, names):
+    """Mask and value of each encoding, based on its fixed bits."""
+    ret = []
+    for description in arr:
+        instr, bits = description[0], description[1:]
+        mask = value = bitcount = 0
+        for x in bits:
+            size = 1 if isinstance(x, int) else x.bitsize
+            mask, value, bitcount = mask << size, value << size, \
+                bitcount + size
+            if isinstance(x, int):
+                mask, value = mask | 1, value | x
+
+        # thumb instructions are stored in the upper halfword, just like the
+        # first halfword of thumb2 instructions
+        isa = 'ISA_ARMV7' if arr is darmtbl.ARMv7 else 'ISA_THUMB2'
+        if bitcount == 16:
+            isa, mask, value = 'ISA_THUMB', mask << 16, value << 16
+
+        entry = mask, value, isa, instruction_name(instr)
+        if entry[3] in names and not entry in ret:
+            ret.append(entry)
+    return ret
+
+
+def patterns_table(name, arr):
+    """Table of mask/value patterns."""
+    lines = ['    {0x%08x, 0x%08x, %s, I_%s},' % x for x in arr]
+    return 'const darm_pattern_t %s[%d] = {\n%s\n};\n' % (name, len(arr),
+                                                         '\n'.join(lines))
+
+
+def field_masks(bits):
+    """Mask of each field of a 32-bit encoding, bit 31 being the first."""
+    ret, offset = {}, 32
+    for x in bits:
+        size = 1 if isinstance(x, int) else x.bitsize
+        offset -= size
+        if not isinstance(x, int):
+            ret[x] = ((1 << size) - 1) << offset
+    return ret
+
+
+def pext_mask(arr, fields, check=None):
+    """PEXT mask which concatenates the given fields in a single step.
+
+    Only 32-bit encodings which contain the fields (and which pass the
+    optional check) are taken into account. If the fields are not laid out
+    in the order of the concatenation, or if their location differs between
+    encodings, then there's no single mask and zero is returned.
+
+    """
+    ret = set()
+    for description in arr:
+        bits = description[1:]
+        if sum(1 if isinstance(x, int) else x.bitsize for x in bits) != 32:
+            continue
+
+        masks = field_masks(bits)
+        if not all(x in masks for x in fields) or \
+                check is not None and not check(bits):
+            continue
+
+        masks = [masks[x] for x in fields]
+        if masks != sorted(masks, reverse=True):
+            return 0
+
+        ret.add(sum(masks))
+    return ret.pop() if len(ret) == 1 else 0
+
+
 def magic_open(fname):
     # python magic!
     sys.stdout = open(fname, 'w')
@@ -571,6 +835,7 @@ instr_types = [
 
 if __name__ == '__main__':
     armv7_table, thumb_table, thumb2_table = {}, {}, {}
+    thumb2_extractors = []
 
     # the last item (a list) will contain the instructions affected by this
     # encoding type
@@ -675,6 +940,17 @@ if __name__ == '__main__':
             idx = sum(int(idx_bin[y])*2**(31-y) for y in range(32))
 
             thumb2_table[idx] = instruction_name(instr), idx
+
+            # the register, immediate and flag type of this encoding, each
+            # combination gets its own fused operand extractor
+            types = []
+            for kind in (3, 31, 32):
+                for y in (_ for _ in instr_types if _[0] == kind):
+                    if y[4](bits, instr, idx):
+                        types.append(y[1][len('THUMB2_'):])
+                        break
+            if len(types) == 3 and not tuple(types) in thumb2_extractors:
+                thumb2_extractors.append(tuple(types))
         else:
             raise
 
@@ -707,6 +983,45 @@ if __name__ == '__main__':
     print('extern const char *darm_enctypes[%d];' % len(instr_types))
     print('extern const char *darm_registers[16];')
 
+    # print the register and semantic rules
+    print(rules_enum('darm_regrule', register_rules))
+    print(rules_enum('darm_semrule', semantic_rules))
+    print('extern const uint16_t darm_regrules[%d];' % count)
+    print('extern const uint16_t darm_semrules[%d];' % count)
+
+    # the mask/value patterns of each encoding
+    names = instruction_names(open('instructions.txt'))
+    patterns = generate_patterns(darmtbl.ARMv7, names) + \
+        generate_patterns(darmtbl2.thumbs, names)
+    print('typedef enum _darm_isa_t {')
+    print('    ISA_ARMV7, ISA_THUMB, ISA_THUMB2,')
+    print('} darm_isa_t;')
+    print('typedef struct _darm_pattern_t {')
+    print('    uint32_t mask;')
+    print('    uint32_t value;')
+    print('    darm_isa_t isa;')
+    print('    darm_instr_t instr;')
+    print('} darm_pattern_t;')
+    print('extern const darm_pattern_t darm_patterns[%d];' % len(patterns))
+
+    # the label and encoding type of the armv7 and thumb lookup tables are
+    # packed into one entry, so that one load (and cache line) serves both
+    instr_bits = (count - 1).bit_length()
+    if instr_bits + (len(instr_types) - 1).bit_length() > 16:
+        raise Exception('Instruction label and type exceed 16 bits')
+    print('typedef uint16_t darm_lut_t;')
+    print('#define DARM_LUT_INSTR_BITS %d' % instr_bits)
+    print('#define DARM_LUT(instr, type) \\')
+    print('    ((instr) | ((type) << DARM_LUT_INSTR_BITS))')
+    print('static inline darm_instr_t darm_lut_instr(darm_lut_t entry)')
+    print('{')
+    print('    return (darm_instr_t)(entry & ((1 << DARM_LUT_INSTR_BITS) - 1));')
+    print('}')
+    print('static inline darm_enctype_t darm_lut_type(darm_lut_t entry)')
+    print('{')
+    print('    return (darm_enctype_t)(entry >> DARM_LUT_INSTR_BITS);')
+    print('}')
+
     print('#endif')
 
     #
@@ -725,8 +1040,16 @@ if __name__ == '__main__':
             num = ''.join(y)
             print('#define b%s %d' % (num, int(num, 2)))
 
+    # bitmaps of uint64_t words, e.g., one bit for each halfword of an image
+    print('#define BITMAP_WORDS(count) (((count) + 63) / 64)')
+    print('#define BITMAP_GET(bm, idx) '
+          '(((bm)[(idx) / 64] >> ((idx) % 64)) & 1)')
+    print('#define BITMAP_SET(bm, idx) '
+          '((bm)[(idx) / 64] |= 1ULL << ((idx) % 64))')
+
     def type_lut(name, bits):
-        print('extern darm_instr_t type_%s_instr_lookup[%d];' % (name, 2**bits))
+        print('extern const uint16_t type_%s_instr_lookup[%d];' %
+              (name, 2**bits))
 
     #
     # thumb-tbl.h
@@ -741,8 +1064,7 @@ if __name__ == '__main__':
     print('#include "darm-tbl.h"')
 
     # print some required definitions
-    print('extern darm_enctype_t thumb_instr_types[256];')
-    print('extern darm_instr_t thumb_instr_labels[256];')
+    print('extern const darm_lut_t thumb_instr_lut[256];')
 
     type_lut('gpi', 4)
     type_lut('hints', 3)
@@ -766,12 +1088,46 @@ if __name__ == '__main__':
     print('#define THUMB2_INSTRUCTION_COUNT %d' % len(thumb2_table))
 
     # print some required definitions
-    print('extern darm_instr_t thumb2_instr_labels[256];')
+    print('extern const uint16_t thumb2_instr_labels[%d];' %
+          len(thumb2_table))
     print('extern const char * thumb2_instruction_strings[256];')
 
     type_lut('immediate', 4)
     type_lut('flags', 3)
 
+    # PEXT masks over (w << 16) | w2 which concatenate multi-field
+    # immediates in one step, see THUMB2_FIELDS in thumb2.c
+    pext_fields = [
+        ('IMM2_IMM3', [d2.imm3, d2.imm2], [d2.imm2, d2.imm3]),
+        ('IMM1_IMM3_IMM8', [d2.i, d2.imm3, d2.imm8],
+         [d2.i, d2.imm3, d2.imm8]),
+        ('IMM6_IMM11', [d2.imm6, d2.imm11], [d2.imm6, d2.imm11]),
+        ('IMM10_IMM11', [d2.imm10, d2.imm11], [d2.imm10, d2.imm11]),
+        ('IMM10H_IMM10L', [d2.imm10H, d2.imm10L], [d2.imm10H, d2.imm10L]),
+    ]
+    for name, fields, imm in pext_fields:
+        mask = pext_mask(darmtbl2.thumbs, fields,
+                         lambda bits: thumb2_immChk(bits, imm))
+        if not mask:
+            raise Exception('No single PEXT mask for %s' % name)
+        print('#define THUMB2_PEXT_%s 0x%08x' % (name, mask))
+
+    # the number of register, immediate and flag types, which together
+    # index thumb2_extractor_index
+    thumb2_kinds = [[x[1][len('THUMB2_'):] for x in instr_types
+                     if x[0] == kind] for kind in (3, 31, 32)]
+    print('#define THUMB2_REG_TYPES %d' % len(thumb2_kinds[0]))
+    print('#define THUMB2_IMM_TYPES %d' % len(thumb2_kinds[1]))
+    print('#define THUMB2_FLAG_TYPES %d' % len(thumb2_kinds[2]))
+
+    # X(reg, imm, flag) for each combination of operand types that is used
+    # by the thumb2 encodings, see thumb2_disasm
+    print('#define THUMB2_EXTRACTORS(X) \\')
+    print(' \\\n'.join('    X(%s, %s, %s)' % x for x in thumb2_extractors))
+    print('extern const uint8_t thumb2_extractor_index[%d];' %
+          (len(thumb2_kinds[0]) * len(thumb2_kinds[1]) *
+           len(thumb2_kinds[2])))
+
     print('#endif')
 
     #
@@ -787,10 +1143,7 @@ if __name__ == '__main__':
     print('#include "darm-tbl.h"')
 
     # print some required definitions
-    print('extern darm_enctype_t armv7_instr_types[256];')
-    print('extern darm_enctype_t thumb2_instr_types[256];')
-
-    print('extern darm_instr_t armv7_instr_labels[256];')
+    print('extern const darm_lut_t armv7_instr_lut[256];')
     type_lut('shift', 4)
     type_lut('brnchmisc', 4)
     type_lut('opless', 3)
@@ -822,6 +1175,20 @@ if __name__ == '__main__':
     reg = 'r0 r1 r2 r3 r4 r5 r6 r7 r8 r9 r10 r11 r12 SP LR PC'
     print(string_table('darm_registers', reg.split()))
 
+    # only instructions that are known to the darm_instr_t enumeration
+    names = instruction_names(open('instructions.txt'))
+    regrules = generate_register_rules(list(darmtbl.ARMv7) +
+                                       list(darmtbl2.thumbs))
+    regrules = dict((k, v) for k, v in regrules.items() if k in names)
+    print(rules_table('darm_regrules', register_rules, regrules,
+                      len(names)))
+
+    semrules = generate_semantic_rules(names[1:])
+    print(rules_table('darm_semrules', semantic_rules, semrules,
+                      len(names)))
+
+    print(patterns_table('darm_patterns', patterns))
+
     #
     # thumb-tbl.c
     #
@@ -832,10 +1199,8 @@ if __name__ == '__main__':
     print('#include "thumb-tbl.h"')
 
     # print a table containing all the types of instructions
-    print(instruction_types_table(thumb_table, 'thumb'))
-
-    # print a table containing the instruction label for each entry
-    print(instruction_names_index_table(thumb_table, 'thumb'))
+    # print a table containing the label and type of each entry
+    print(instruction_lut_table(thumb_table, 'thumb'))
 
     t_gpi = {
         0b0000: 'and',
@@ -881,6 +1246,17 @@ if __name__ == '__main__':
     print(typed_table('const char *', 'thumb2_instruction_strings',
                       ['"%s"' % s[0] for s in thumb2_table.values()]))
 
+    # for each combination of operand types the extractor from the
+    # THUMB2_EXTRACTORS list plus one, zero for the generic parse functions
+    index = []
+    for reg in thumb2_kinds[0]:
+        for imm in thumb2_kinds[1]:
+            for flag in thumb2_kinds[2]:
+                index.append(thumb2_extractors.index((reg, imm, flag)) + 1
+                             if (reg, imm, flag) in thumb2_extractors else 0)
+    print(typed_table('const uint8_t', 'thumb2_extractor_index',
+                      map(str, index)))
+
     #
     # armv7-tbl.c
     #
@@ -891,10 +1267,8 @@ if __name__ == '__main__':
     print('#include "armv7-tbl.h"')
 
     # print a table containing all the types of instructions
-    print(instruction_types_table(armv7_table, 'armv7'))
-
-    # print a table containing the instruction label for each entry
-    print(instruction_names_index_table(armv7_table, 'armv7'))
+    # print a table containing the label and type of each entry
+    print(instruction_lut_table(armv7_table, 'armv7'))
 
     # print a lookup table for the shift type (which is a sub-type of
     # the dst-src type), the None types represent instructions of the
@@ -1009,9 +1383,18 @@ if __name__ == '__main__':
         'uxtab', 'uxtb', 'uxtah', 'uxth'
     print(type_lookup_table('type_pusr', *t_pusr))
 
+    # darm_str skips to the next format string when one of these operands
+    # is missing, so the variant with the most of them is tried first, e.g.,
+    # asr r2, r8, r4 before asr r2, r4, #32
+    required = 'dnmathliXb'
+
     lines = []
     for instr, fmtstr in fmtstrs.items():
-        fmtstr = ', '.join('"%s"' % x for x in set(fmtstr))
+        # remove duplicates, ties keep their order, so that the output
+        # doesn't depend on the hash seed of the python interpreter
+        fmtstr = ', '.join('"%s"' % x for x in sorted(
+            set(fmtstr), key=lambda x: (-sum(x.count(ch) for ch in required),
+                                        fmtstr.index(x))))
         lines.append('    [I_%s] = {%s},' % (instr, fmtstr))
     print('const char *armv7_format_strings[%d][3] = {' % instrcnt)
     print('\n'.join(sorted(lines)))
@@ -0,0 +1,117 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "darm.h"
+#include "darm-internal.h"
+#include "data.h"
+#include "jumptable.h"
+
+int darm_data_init(darm_data_t *dd, uint32_t base, uint32_t len)
+{
+    memset(dd, 0, sizeof(darm_data_t));
+    dd->base = base, dd->len = len;
+    dd->cmp_reg = R_INVLD;
+
+    dd->bitmap = calloc(BITMAP_WORDS(len / 2 + 1), sizeof(uint64_t));
+    return dd->bitmap != NULL ? 0 : -1;
+}
+
+int darm_data_set(darm_data_t *dd, uint32_t addr, uint32_t size)
+{
+    // only mark the halfwords that lie within the range, in 64-bit so that
+    // ranges near the end of the address space don't wrap around
+    uint64_t start = addr & ~1, end = ((uint64_t) addr + size + 1) & ~1;
+    uint64_t lo = dd->base, hi = (uint64_t) dd->base + dd->len;
+    int ret = 0;
+
+    if(start < lo) start = lo;
+    if(end > hi) end = hi;
+
+    for (; start < end; start += 2) {
+        BITMAP_SET(dd->bitmap, (start - lo) / 2);
+        ret = 1;
+    }
+    return ret;
+}
+
+int darm_data_mark(darm_data_t *dd, const darm_t *d, uint32_t addr)
+{
+    uint32_t thumb = addr & 1, pc = (addr & ~1) + (thumb ? 4 : 8);
+    darm_mem_t mem;
+
+    // keep track of bounds checks, e.g., cmp r0, #7
+    if(d->instr == I_CMP && d->I == B_SET) {
+        dd->cmp_reg = d->Rn, dd->cmp_imm = d->imm;
+        return 0;
+    }
+
+    // the bound no longer holds once the register is overwritten, this
+    // includes pc-relative loads such as ldr r0, [pc, #4]
+    if(dd->cmp_reg != R_INVLD && (d->regs_written >> dd->cmp_reg) & 1) {
+        dd->cmp_reg = R_INVLD;
+    }
+
+    if(darm_mem(d, &mem) < 0 || mem.base != PC) {
+        return 0;
+    }
+
+    // a table of byte or halfword offsets follows the TBB or TBH
+    if(d->instr == I_TBB || d->instr == I_TBH) {
+        if(mem.index != dd->cmp_reg || dd->cmp_imm >= DARM_JT_MAXCASES) {
+            return 0;
+        }
+
+        return darm_data_set(dd, pc, (dd->cmp_imm + 1) * mem.size);
+    }
+
+    // the literal of a pc-relative load, the pc is word-aligned for Thumb
+    if(mem.load != 0 && mem.offset_kind == M_IMM) {
+        return darm_data_set(dd, (pc & ~3) + mem.offset,
+            mem.size * mem.count);
+    }
+    return 0;
+}
+
+int darm_data_get(const darm_data_t *dd, uint32_t addr)
+{
+    uint32_t off = (addr & ~1) - dd->base;
+    if((addr & ~1) < dd->base || off >= dd->len) return 0;
+
+    return BITMAP_GET(dd->bitmap, off / 2);
+}
+
+void darm_data_free(darm_data_t *dd)
+{
+    free(dd->bitmap);
+    memset(dd, 0, sizeof(darm_data_t));
+}
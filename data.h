@@ -0,0 +1,70 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef __DATA_H__
+#define __DATA_H__
+
+#include "darm.h"
+
+typedef struct _darm_data_t {
+    // the address range covered by the bitmap
+    uint32_t        base;
+    uint32_t        len;
+
+    // one bit per halfword, set for literal pools and jump tables
+    uint64_t        *bitmap;
+
+    // the last register that has been compared against an immediate, which
+    // gives the amount of entries of a following TBB or TBH table
+    darm_reg_t      cmp_reg;
+    uint32_t        cmp_imm;
+} darm_data_t;
+
+int darm_data_init(darm_data_t *dd, uint32_t base, uint32_t len);
+
+//
+// Marks the data that is referenced by instruction d, which has been
+// disassembled at address addr (with the least significant bit set for
+// Thumb), i.e., the literal of a PC-relative load, or the table following
+// a TBB or TBH instruction. Instructions have to be passed in program
+// order, as the size of a table is taken from the preceding CMP.
+//
+// Returns 1 if any data was marked, 0 otherwise.
+//
+int darm_data_mark(darm_data_t *dd, const darm_t *d, uint32_t addr);
+
+// marks size bytes at addr as data, returns 1 if any of them are in range
+int darm_data_set(darm_data_t *dd, uint32_t addr, uint32_t size);
+
+// whether the halfword at addr has been marked as data
+int darm_data_get(const darm_data_t *dd, uint32_t addr);
+
+void darm_data_free(darm_data_t *dd);
+
+#endif
@@ -0,0 +1,193 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "darm.h"
+#include "darm-internal.h"
+#include "cfg.h"
+#include "descent.h"
+
+int darm_rd_init(darm_rd_t *rd, const uint8_t *buf, uint32_t len,
+    uint32_t base)
+{
+    memset(rd, 0, sizeof(darm_rd_t));
+    rd->buf = buf, rd->len = len, rd->base = base;
+
+    rd->visited = calloc(BITMAP_WORDS(len / 2 + 1), sizeof(uint64_t));
+    rd->thumb = calloc(BITMAP_WORDS(len / 2 + 1), sizeof(uint64_t));
+    rd->work = malloc((rd->work_alloc = 256) * sizeof(uint32_t));
+
+    if(rd->visited == NULL || rd->thumb == NULL || rd->work == NULL ||
+            darm_data_init(&rd->data, base, len) < 0) {
+        darm_rd_free(rd);
+        return -1;
+    }
+    return 0;
+}
+
+int darm_rd_seed(darm_rd_t *rd, uint32_t addr)
+{
+    uint32_t off = (addr & ~1) - rd->base;
+
+    // ignore anything outside of the image, or addresses that have already
+    // been disassembled
+    if((addr & ~1) < rd->base || off >= rd->len ||
+            BITMAP_GET(rd->visited, off / 2)) {
+        return 0;
+    }
+
+    if(rd->work_count == rd->work_alloc) {
+        uint32_t *ptr = realloc(rd->work,
+            rd->work_alloc * 2 * sizeof(uint32_t));
+        if(ptr == NULL) return -1;
+
+        rd->work = ptr, rd->work_alloc *= 2;
+    }
+
+    rd->work[rd->work_count++] = addr;
+    return 0;
+}
+
+// follows the cases if d dispatches a switch
+static int _rd_switch(darm_rd_t *rd, const darm_t *d, uint32_t addr)
+{
+    uint32_t cases[256], *targets = cases;
+    darm_jt_t saved = rd->jt;
+
+    uint32_t count = darm_jt_step(&rd->jt, d, addr, cases, 256);
+    if(count > 256) {
+        targets = malloc(count * sizeof(uint32_t));
+        if(targets == NULL) return -1;
+
+        rd->jt = saved;
+        darm_jt_step(&rd->jt, d, addr, targets, count);
+    }
+
+    // the table holds addresses rather than instructions
+    if(count != 0 && rd->jt.table_size != 0) {
+        darm_data_set(&rd->data, rd->jt.table_addr, rd->jt.table_size);
+    }
+
+    int ret = 0;
+    for (uint32_t idx = 0; idx < count && ret == 0; idx++) {
+        ret = darm_rd_seed(rd, targets[idx]);
+    }
+
+    if(targets != cases) free(targets);
+    return ret;
+}
+
+int darm_rd_run(darm_rd_t *rd)
+{
+    darm_t d; darm_it_t it;
+
+    while (rd->work_count != 0) {
+        uint32_t addr = rd->work[--rd->work_count];
+        uint32_t thumb = addr & 1;
+
+        // branch targets are assumed to be outside of IT blocks
+        darm_it_init(&it);
+        darm_jt_init(&rd->jt, rd->buf, rd->len, rd->base);
+
+        // ARMv7 instructions have to be four-byte aligned
+        if(thumb == 0 && (addr & 3) != 0) continue;
+
+        for (addr &= ~1; addr - rd->base < rd->len; ) {
+            uint32_t off = addr - rd->base;
+            if(BITMAP_GET(rd->visited, off / 2) ||
+                    darm_data_get(&rd->data, addr)) {
+                break;
+            }
+
+            int ret = darm_disasm_buf(&d, rd->buf + off, rd->len - off,
+                addr | thumb);
+            if(ret == 0) break;
+
+            if(thumb != 0) {
+                darm_it_apply(&it, &d, ret);
+            }
+
+            darm_data_mark(&rd->data, &d, addr | thumb);
+
+            BITMAP_SET(rd->visited, off / 2);
+            if(thumb != 0) {
+                BITMAP_SET(rd->thumb, off / 2);
+            }
+            rd->insn_count++;
+
+            uint32_t target; int target_is_thumb;
+            if(darm_branch_target(&d, addr | thumb, &target,
+                    &target_is_thumb) == 0 &&
+                    darm_rd_seed(rd, target | target_is_thumb) < 0) {
+                return -1;
+            }
+
+            if(_rd_switch(rd, &d, addr | thumb) < 0) {
+                return -1;
+            }
+
+            // the path ends with any unconditional change of control flow
+            // other than a call
+            darm_flow_t flow = darm_flow(&d);
+            if(flow != F_NONE && flow != F_CALL && !darm_flow_is_cond(&d)) {
+                break;
+            }
+
+            addr += ret * 2;
+        }
+    }
+
+    return rd->insn_count;
+}
+
+int darm_rd_visited(const darm_rd_t *rd, uint32_t addr)
+{
+    uint32_t off = (addr & ~1) - rd->base;
+    if((addr & ~1) < rd->base || off >= rd->len) return 0;
+
+    // instructions might have been visited before a later load marked
+    // them as literal
+    if(BITMAP_GET(rd->visited, off / 2) == 0 ||
+            BITMAP_GET(rd->data.bitmap, off / 2) != 0) {
+        return 0;
+    }
+    return BITMAP_GET(rd->thumb, off / 2) ? 2 : 1;
+}
+
+void darm_rd_free(darm_rd_t *rd)
+{
+    free(rd->visited);
+    free(rd->thumb);
+    free(rd->work);
+    darm_data_free(&rd->data);
+    memset(rd, 0, sizeof(darm_rd_t));
+}
@@ -0,0 +1,91 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef __DESCENT_H__
+#define __DESCENT_H__
+
+#include "darm.h"
+#include "data.h"
+#include "jumptable.h"
+
+typedef struct _darm_rd_t {
+    // the image, mapped at address base
+    const uint8_t   *buf;
+    uint32_t        len;
+    uint32_t        base;
+
+    // one bit per halfword of the image, visited is set for the start of
+    // each reachable instruction, and thumb specifies its instruction set
+    uint64_t        *visited;
+    uint64_t        *thumb;
+
+    // literal pools and jump tables referenced by the reachable code, these
+    // are never disassembled
+    darm_data_t     data;
+
+    // resolves the switches along the current path
+    darm_jt_t       jt;
+
+    // amount of reachable instructions found so far
+    uint32_t        insn_count;
+
+    // worklist of addresses which still have to be followed, with the
+    // least significant bit set for Thumb
+    uint32_t        *work;
+    uint32_t        work_count;
+    uint32_t        work_alloc;
+} darm_rd_t;
+
+int darm_rd_init(darm_rd_t *rd, const uint8_t *buf, uint32_t len,
+    uint32_t base);
+
+// adds a starting point, e.g., the entry point or a function symbol, the
+// least significant bit of addr is set for Thumb code
+int darm_rd_seed(darm_rd_t *rd, uint32_t addr);
+
+//
+// Follows the control flow from all seeds until the worklist is empty,
+// i.e., disassembles only the code which is reachable through direct
+// branches and calls (switching between ARMv7 and Thumb on BLX) and falls
+// through conditional branches and calls, and into the cases of switches
+// which can be resolved. Paths end at unconditional branches, returns,
+// table branches, undecodable instructions, and data.
+//
+// Returns the amount of reachable instructions, or -1 on allocation
+// failures.
+//
+int darm_rd_run(darm_rd_t *rd);
+
+// whether the instruction at addr is reachable, returns 1 for ARMv7,
+// 2 for Thumb, and 0 if it has not been visited or if it is data
+int darm_rd_visited(const darm_rd_t *rd, uint32_t addr);
+
+void darm_rd_free(darm_rd_t *rd);
+
+#endif
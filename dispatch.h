@@ -0,0 +1,87 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef __DISPATCH_H__
+#define __DISPATCH_H__
+
+//
+// Optional computed-goto dispatch for the switch statements of the decoders.
+// When built with -DDARM_THREADED_DISPATCH (which requires the labels-as-
+// values extension of GCC and clang) each decoder jumps through its own
+// table of label addresses, covering every value of the enumeration, rather
+// than through the range check and jump table of the switch statement. The
+// switch statement remains in place, so that both builds share one body:
+//
+//     #ifdef DARM_THREADED_DISPATCH
+//     DISPATCH_TABLE(targets, I_INSTRCNT, other)
+//         [I_B] = &&b,
+//     DISPATCH_END()
+//     DISPATCH(targets, d->instr);
+//     #endif
+//
+//     switch (d->instr) {
+//     case I_B: DISPATCH_TARGET(b)
+//         ...
+//     default: DISPATCH_TARGET(other)
+//         ...
+//     }
+//
+
+#ifdef DARM_THREADED_DISPATCH
+
+#ifdef __clang__
+#define DISPATCH_IGNORE_OVERRIDE \
+    _Pragma("clang diagnostic ignored \"-Winitializer-overrides\"")
+#else
+#define DISPATCH_IGNORE_OVERRIDE \
+    _Pragma("GCC diagnostic ignored \"-Woverride-init\"")
+#endif
+
+// every entry defaults to the fallback label, the explicit entries override
+// it, which is intended
+#define DISPATCH_TABLE(name, count, fallback) \
+    _Pragma("GCC diagnostic push") \
+    DISPATCH_IGNORE_OVERRIDE \
+    static const void *const name[count] = { \
+        [0 ... (count) - 1] = &&fallback,
+
+#define DISPATCH_END() \
+    }; \
+    _Pragma("GCC diagnostic pop")
+
+#define DISPATCH(name, value) goto *name[(uint32_t)(value)]
+#define DISPATCH_TARGET(label) label:
+
+#else
+
+#define DISPATCH_TARGET(label)
+
+#endif
+
+#endif
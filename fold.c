@@ -0,0 +1,94 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "darm.h"
+#include "cfg.h"
+#include "fold.h"
+
+void darm_fold_init(darm_fold_t *f, uint32_t window)
+{
+    memset(f, 0, sizeof(darm_fold_t));
+    f->window = window != 0 ? window : 16;
+}
+
+void darm_fold_reset(darm_fold_t *f)
+{
+    f->pending = 0;
+}
+
+int darm_fold_step(darm_fold_t *f, const darm_t *d, uint32_t addr,
+    darm_const_t *out)
+{
+    uint32_t index = f->index++; int ret = 0;
+
+    // pending values which have been around for too long
+    for (uint32_t bits = f->pending; bits != 0; bits &= bits - 1) {
+        uint32_t reg = __builtin_ctz(bits);
+        if(index - f->movw_index[reg] > f->window) {
+            f->pending &= ~(1 << reg);
+        }
+    }
+
+    if(d->instr == I_MOVW) {
+        f->pending |= 1 << d->Rd;
+        f->low[d->Rd] = d->imm;
+        f->movw_addr[d->Rd] = addr;
+        f->cond[d->Rd] = d->cond;
+        f->movw_index[d->Rd] = index;
+        return 0;
+    }
+
+    // the MOVT has to execute under the same condition as the MOVW
+    if(d->instr == I_MOVT && ((f->pending >> d->Rd) & 1) != 0 &&
+            f->cond[d->Rd] == d->cond) {
+        out->movw_addr = f->movw_addr[d->Rd];
+        out->addr = addr;
+        out->reg = d->Rd;
+        out->value = (d->imm << 16) | f->low[d->Rd];
+        ret = 1;
+    }
+
+    // any other write to the register invalidates its pending value, and
+    // so does the end of the basic block
+    f->pending &= ~d->regs_written;
+
+    // calls only clobber the caller-saved registers
+    darm_flow_t flow = darm_flow(d);
+    if(flow == F_CALL) {
+        f->pending &= ~((1 << r0) | (1 << r1) | (1 << r2) | (1 << r3) |
+            (1 << r12));
+    }
+    else if(flow != F_NONE) {
+        darm_fold_reset(f);
+    }
+    return ret;
+}
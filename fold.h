@@ -0,0 +1,81 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef __FOLD_H__
+#define __FOLD_H__
+
+#include "darm.h"
+
+// a 32-bit constant that has been built by a MOVW/MOVT pair
+typedef struct _darm_const_t {
+    // address of the MOVW and of the MOVT, i.e., the value is available in
+    // reg right after the instruction at addr
+    uint32_t        movw_addr;
+    uint32_t        addr;
+
+    darm_reg_t      reg;
+    uint32_t        value;
+} darm_const_t;
+
+typedef struct _darm_fold_t {
+    // amount of instructions that a MOVW stays pending
+    uint32_t        window;
+
+    // instruction counter, incremented for each darm_fold_step call
+    uint32_t        index;
+
+    // bitmask of registers with a pending MOVW, and for each of those the
+    // lower halfword, the address, the condition, and the instruction index
+    uint16_t        pending;
+    uint16_t        low[16];
+    uint32_t        movw_addr[16];
+    darm_cond_t     cond[16];
+    uint32_t        movw_index[16];
+} darm_fold_t;
+
+// a window of zero is replaced by a default of 16 instructions
+void darm_fold_init(darm_fold_t *f, uint32_t window);
+
+//
+// Feeds the next instruction d, which has been disassembled at address
+// addr, into the folding pass; instructions have to be given in program
+// order. Pending MOVW values are dropped at the end of each basic block,
+// when the register is overwritten, or after window instructions.
+//
+// Returns 1 and fills in out if this instruction is the MOVT that
+// completes a pair, returns 0 otherwise.
+//
+int darm_fold_step(darm_fold_t *f, const darm_t *d, uint32_t addr,
+    darm_const_t *out);
+
+// drops all pending values, e.g., when the next instruction is a branch
+// target
+void darm_fold_reset(darm_fold_t *f);
+
+#endif
@@ -0,0 +1,233 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "darm.h"
+#include "cfg.h"
+#include "funcs.h"
+#include "search.h"
+
+typedef struct _prologue_t {
+    uint32_t        mask;
+    uint32_t        value;
+
+    // whether this pattern allocates stack space, which is only the start
+    // of a function if it doesn't follow another prologue
+    int             alloc;
+} prologue_t;
+
+// amount of instructions after a save in which a sub sp is part of the same
+// prologue, e.g., push {r4-r7, lr}; add r7, sp, #12; sub sp, sp, #8
+#define SAVE_WINDOW 3
+
+static const prologue_t g_arm_prologues[] = {
+    {0xffffe000, 0xe92d4000, 0},    // push {.., lr}
+    {0xffffffff, 0xe52de004, 0},    // str lr, [sp, #-4]!
+    {0xfffff000, 0xe24dd000, 1},    // sub sp, sp, #imm
+};
+
+// the first halfword of Thumb instructions is stored in the upper half
+static const prologue_t g_thumb_prologues[] = {
+    {0xff000000, 0xb5000000, 0},    // push {.., lr}
+    {0xffffe000, 0xe92d4000, 0},    // push.w {.., lr}
+    {0xff800000, 0xb0800000, 1},    // sub sp, #imm
+    {0xfbef8f00, 0xf1ad0d00, 1},    // sub.w sp, sp, #imm
+};
+
+void darm_funcs_init(darm_funcs_t *f)
+{
+    memset(f, 0, sizeof(darm_funcs_t));
+}
+
+int darm_funcs_add(darm_funcs_t *f, uint32_t addr)
+{
+    if(f->count == f->alloc) {
+        uint32_t alloc = f->alloc != 0 ? f->alloc * 2 : 256;
+        uint32_t *ptr = realloc(f->start, alloc * sizeof(uint32_t));
+        if(ptr == NULL) return -1;
+
+        f->start = ptr, f->alloc = alloc;
+    }
+
+    f->start[f->count++] = addr;
+    return 0;
+}
+
+static uint32_t _read32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t) p[3] << 24);
+}
+
+int darm_funcs_exidx(darm_funcs_t *f, const uint8_t *buf, uint32_t len,
+    uint32_t addr)
+{
+    if(len % 8 != 0) return -1;
+
+    for (uint32_t off = 0; off < len; off += 8) {
+        uint32_t prel31 = _read32(buf + off);
+
+        // the upper bit is reserved
+        if((prel31 >> 31) != 0) return -1;
+
+        // sign-extend the 31-bit offset
+        uint32_t start = addr + off + (prel31 | ((prel31 & (1 << 30)) << 1));
+
+        if(darm_funcs_add(f, start) < 0) return -1;
+    }
+    return 0;
+}
+
+// returns the offset up to which the prologue that starts with the save at
+// offset off continues, i.e., the SAVE_WINDOW instructions after it unless
+// the straight-line run ends earlier
+static uint32_t _save_window(const uint8_t *buf, uint32_t len,
+    uint32_t base, uint32_t thumb, uint32_t off)
+{
+    darm_t d;
+
+    for (uint32_t idx = 0; idx <= SAVE_WINDOW && off < len; idx++) {
+        int ret = darm_disasm_buf(&d, buf + off, len - off,
+            (base + off) | thumb);
+        if(ret == 0) break;
+
+        off += thumb ? ret * 2 : 4;
+        if(darm_flow(&d) != F_NONE) break;
+    }
+    return off;
+}
+
+int darm_funcs_scan(darm_funcs_t *f, const uint8_t *buf, uint32_t len,
+    uint32_t base)
+{
+    uint32_t thumb = base & 1, step = thumb ? 2 : 4;
+    base &= ~1;
+
+    const prologue_t *prologues = thumb ? g_thumb_prologues : g_arm_prologues;
+    uint32_t prologue_count = thumb ? ARRAYSIZE(g_thumb_prologues) :
+        ARRAYSIZE(g_arm_prologues);
+
+    if(len < step) return 0;
+
+    // every instruction as a 32-bit word, for Thumb this is the halfword at
+    // each offset followed by the next one
+    uint32_t count = (len - step) / step + 1;
+    uint32_t *words = malloc(count * sizeof(uint32_t));
+    if(words == NULL) return -1;
+
+    for (uint32_t idx = 0; idx < count; idx++) {
+        const uint8_t *p = buf + idx * step;
+        if(thumb == 0) {
+            words[idx] = _read32(p);
+        }
+        else {
+            uint32_t next = idx * 2 + 4 <= len ? p[2] | (p[3] << 8) : 0;
+            words[idx] = ((p[0] | (p[1] << 8)) << 16) | next;
+        }
+    }
+
+    // a sub sp before this offset belongs to the prologue of a preceding
+    // save, rather than being the start of a function
+    uint32_t window = 0;
+
+    for (uint32_t idx = 0; idx < count; idx += 64) {
+        uint64_t saves = 0, allocs = 0;
+
+        for (uint32_t pat = 0; pat < prologue_count; pat++) {
+            uint64_t bits = darm_match_block(&words[idx], count - idx,
+                prologues[pat].mask, prologues[pat].value);
+            if(prologues[pat].alloc != 0) {
+                allocs |= bits;
+            }
+            else {
+                saves |= bits;
+            }
+        }
+
+        for (uint64_t bits = saves | allocs; bits != 0; bits &= bits - 1) {
+            uint32_t bit = __builtin_ctzll(bits), off = (idx + bit) * step;
+            darm_t d;
+
+            if(((allocs >> bit) & 1) != 0 && off < window) {
+                continue;
+            }
+
+            // make sure the candidate is a valid instruction that actually
+            // writes to the stack pointer
+            if(darm_disasm_buf(&d, buf + off, len - off,
+                    (base + off) | thumb) == 0 ||
+                    ((d.regs_written >> SP) & 1) == 0) {
+                continue;
+            }
+
+            if(((saves >> bit) & 1) != 0) {
+                window = _save_window(buf, len, base, thumb, off);
+            }
+
+            if(darm_funcs_add(f, (base + off) | thumb) < 0) {
+                free(words);
+                return -1;
+            }
+        }
+    }
+
+    free(words);
+    return 0;
+}
+
+static int _funcs_cmp(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *) a, y = *(const uint32_t *) b;
+    return x < y ? -1 : x > y;
+}
+
+void darm_funcs_sort(darm_funcs_t *f)
+{
+    uint32_t count = 0;
+
+    qsort(f->start, f->count, sizeof(uint32_t), &_funcs_cmp);
+
+    // the Thumb start at the same address comes right after the ARMv7 one
+    for (uint32_t idx = 0; idx < f->count; idx++) {
+        if(count != 0 && (f->start[count-1] & ~1) == (f->start[idx] & ~1)) {
+            f->start[count-1] = f->start[idx];
+            continue;
+        }
+        f->start[count++] = f->start[idx];
+    }
+    f->count = count;
+}
+
+void darm_funcs_free(darm_funcs_t *f)
+{
+    free(f->start);
+    memset(f, 0, sizeof(darm_funcs_t));
+}
@@ -0,0 +1,79 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef __FUNCS_H__
+#define __FUNCS_H__
+
+#include "darm.h"
+
+typedef struct _darm_funcs_t {
+    // start address of each function, with the least significant bit set
+    // for Thumb, sorted once darm_funcs_sort has been called
+    uint32_t        *start;
+    uint32_t        count;
+    uint32_t        alloc;
+} darm_funcs_t;
+
+void darm_funcs_init(darm_funcs_t *f);
+
+// adds a function start, e.g., the entry point or a symbol
+int darm_funcs_add(darm_funcs_t *f, uint32_t addr);
+
+//
+// Adds the function starts from the .ARM.exidx section, which is mapped at
+// address addr and has a size of len bytes. Each entry consists of two
+// words, the first of which is a 31-bit offset relative to the entry to the
+// start of the function. The least significant bit is kept as encoded.
+//
+// Returns 0 on success, -1 on a malformed section or allocation failures.
+//
+int darm_funcs_exidx(darm_funcs_t *f, const uint8_t *buf, uint32_t len,
+    uint32_t addr);
+
+//
+// Scans the image buf, mapped at address base, for function prologues,
+// i.e., push {.., lr}, stmdb sp!, {.., lr}, str lr, [sp, #-4]!, and
+// sub sp, sp, #imm unless it's within three instructions after one of the
+// others without a branch in between. All instructions
+// are first matched against mask/value patterns, only candidates are fully
+// disassembled. The least significant bit of base specifies whether the
+// image is scanned for Thumb or ARMv7 prologues.
+//
+// Returns 0 on success, -1 on allocation failures.
+//
+int darm_funcs_scan(darm_funcs_t *f, const uint8_t *buf, uint32_t len,
+    uint32_t base);
+
+// sorts the function starts and removes duplicates, a Thumb start is kept
+// over an ARMv7 start at the same address
+void darm_funcs_sort(darm_funcs_t *f);
+
+void darm_funcs_free(darm_funcs_t *f);
+
+#endif
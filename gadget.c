@@ -0,0 +1,258 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "darm.h"
+#include "cfg.h"
+#include "search.h"
+#include "gadget.h"
+
+// amount of bytes of which the terminators are searched at once
+#define CHUNK_SIZE 4096
+
+#define FNV_OFFSET 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+
+static const darm_pattern_t g_terminators[] = {
+    {0x0fffffff, 0x012fff1e, ISA_ARMV7, I_BX},      // bx lr
+    {0x0ffffff0, 0x012fff30, ISA_ARMV7, I_BLX},     // blx Rm
+    {0x0e508000, 0x08108000, ISA_ARMV7, I_LDM},     // ldm Rn, {.., pc}
+    {0x0fffffff, 0x049df004, ISA_ARMV7, I_POP},     // pop {pc}
+    {0xffff0000, 0x47700000, ISA_THUMB, I_BX},      // bx lr
+    {0xff870000, 0x47800000, ISA_THUMB, I_BLX},     // blx Rm
+    {0xff000000, 0xbd000000, ISA_THUMB, I_POP},     // pop {.., pc}
+    {0xffd08000, 0xe8908000, ISA_THUMB2, I_LDM},    // ldm.w Rn, {.., pc}
+    {0xffd08000, 0xe9108000, ISA_THUMB2, I_LDMDB},  // ldmdb Rn, {.., pc}
+    {0xffffffff, 0xf85dfb04, ISA_THUMB2, I_POP},    // pop.w {pc}
+};
+
+void darm_gadgets_init(darm_gadgets_t *g)
+{
+    memset(g, 0, sizeof(darm_gadgets_t));
+}
+
+static int _gadgets_grow(darm_gadgets_t *g)
+{
+    uint32_t size = g->table_size != 0 ? g->table_size * 2 : 1024;
+    uint64_t *table = calloc(size, sizeof(uint64_t));
+    if(table == NULL) return -1;
+
+    for (uint32_t idx = 0; idx < g->table_size; idx++) {
+        if(g->table[idx] == 0) continue;
+
+        uint32_t slot = g->table[idx] & (size - 1);
+        while (table[slot] != 0) {
+            slot = (slot + 1) & (size - 1);
+        }
+        table[slot] = g->table[idx];
+    }
+
+    free(g->table);
+    g->table = table, g->table_size = size;
+    return 0;
+}
+
+// adds a gadget unless there's already one with the same hash
+static int _gadgets_add(darm_gadgets_t *g, const darm_gadget_t *gadget)
+{
+    // keep the hash set at most half full
+    if(g->count * 2 >= g->table_size && _gadgets_grow(g) < 0) {
+        return -1;
+    }
+
+    uint32_t slot = gadget->hash & (g->table_size - 1);
+    while (g->table[slot] != 0) {
+        if(g->table[slot] == gadget->hash) return 0;
+        slot = (slot + 1) & (g->table_size - 1);
+    }
+
+    if(g->count == g->alloc) {
+        uint32_t alloc = g->alloc != 0 ? g->alloc * 2 : 256;
+        darm_gadget_t *p = realloc(g->gadget, alloc * sizeof(darm_gadget_t));
+        if(p == NULL) return -1;
+
+        g->gadget = p, g->alloc = alloc;
+    }
+
+    g->table[slot] = gadget->hash;
+    g->gadget[g->count++] = *gadget;
+    return 0;
+}
+
+static uint64_t _hash(uint64_t hash, const darm_t *d)
+{
+    darm_str_t str;
+
+    // instructions that can't be formatted, e.g., addw, are hashed by their
+    // encoding, otherwise the gadget would equal the one without them
+    if(darm_str2(d, &str, 1) < 0) {
+        sprintf(str.total, "(%08x)", d->w);
+    }
+
+    for (const char *p = str.total; *p != 0; p++) {
+        hash = (hash ^ (uint8_t) *p) * FNV_PRIME;
+    }
+    return (hash ^ ';') * FNV_PRIME;
+}
+
+// disassembles the instructions from offset off up to the terminator at
+// offset term, returns the amount of instructions or zero if this isn't a
+// gadget
+static uint32_t _gadget_walk(const uint8_t *buf, uint32_t len,
+    uint32_t base, uint32_t thumb, uint32_t off, uint32_t term,
+    uint32_t depth, uint64_t *hash)
+{
+    uint32_t count = 0;
+    darm_t d;
+
+    *hash = FNV_OFFSET;
+
+    // for Thumb the instruction lengths alone tell whether the walk lands on
+    // the terminator within depth instructions, so most of the candidate
+    // offsets are rejected without disassembling anything
+    if(thumb != 0) {
+        uint32_t pos = off, n = 0;
+        while (pos < term && ++n < depth) {
+            pos += darm_insn_length(buf[pos] | (buf[pos + 1] << 8), 1) * 2;
+        }
+        if(pos != term) return 0;
+    }
+
+    while (off < term) {
+        int ret = darm_disasm_buf(&d, buf + off, len - off,
+            (base + off) | thumb);
+        if(ret == 0 || darm_flow(&d) != F_NONE || ++count == depth) {
+            return 0;
+        }
+
+        *hash = _hash(*hash, &d);
+        off += thumb != 0 ? ret * 2 : 4;
+    }
+
+    if(off != term) return 0;
+
+    darm_disasm_buf(&d, buf + term, len - term, (base + term) | thumb);
+    *hash = _hash(*hash, &d);
+
+    // zero marks empty slots in the hash set
+    if(*hash == 0) *hash = 1;
+    return count + 1;
+}
+
+static int _gadgets_term(darm_gadgets_t *g, const uint8_t *buf,
+    uint32_t len, uint32_t base, uint32_t addr, uint32_t depth)
+{
+    uint32_t thumb = addr & 1, term = (addr & ~1) - base;
+    uint32_t step = thumb != 0 ? 2 : 4;
+    darm_t d;
+
+    int ret = darm_disasm_buf(&d, buf + term, len - term, addr);
+    if(ret == 0) return 0;
+
+    // make sure the terminator really is an indirect branch, e.g., with
+    // condition 0b1111 the ARMv7 patterns match other instructions
+    if(darm_flow(&d) != F_INDIRECT &&
+            (d.instr != I_BLX || d.Rm == R_INVLD)) {
+        return 0;
+    }
+
+    uint32_t size = thumb != 0 ? ret * 2 : 4;
+
+    // every preceding instruction takes at most four bytes
+    for (uint32_t back = 0; back <= (depth - 1) * 4 && back <= term;
+            back += step) {
+        darm_gadget_t gadget; uint64_t hash;
+
+        gadget.count = _gadget_walk(buf, len, base, thumb, term - back,
+            term, depth, &hash);
+        if(gadget.count == 0) {
+            // for ARMv7 every longer gadget contains this one
+            if(thumb == 0) break;
+            continue;
+        }
+
+        gadget.addr = (base + term - back) | thumb;
+        gadget.size = back + size;
+        gadget.hash = hash;
+        if(_gadgets_add(g, &gadget) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int darm_gadgets_find(darm_gadgets_t *g, const uint8_t *buf, uint32_t len,
+    uint32_t base, uint32_t start, uint32_t end, uint32_t depth)
+{
+    darm_hit_t hits[CHUNK_SIZE / 2 + CHUNK_SIZE / 4 + 1];
+
+    if(end > len) end = len;
+
+    for (uint32_t off = start; off < end; off += CHUNK_SIZE) {
+        uint32_t size = end - off < CHUNK_SIZE ? end - off : CHUNK_SIZE;
+
+        // the second halfword of a Thumb2 terminator may follow the chunk
+        uint32_t avail = len - off < size + 2 ? len - off : size + 2;
+
+        uint32_t count = darm_search(g_terminators,
+            ARRAYSIZE(g_terminators), buf + off, avail, base + off, hits,
+            ARRAYSIZE(hits));
+        if(count > ARRAYSIZE(hits)) count = ARRAYSIZE(hits);
+
+        for (uint32_t idx = 0; idx < count; idx++) {
+            if((hits[idx].addr & ~1) - base - off >= size) continue;
+
+            if(_gadgets_term(g, buf, len, base, hits[idx].addr,
+                    depth) < 0) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+int darm_gadgets_merge(darm_gadgets_t *g, const darm_gadgets_t *other)
+{
+    for (uint32_t idx = 0; idx < other->count; idx++) {
+        if(_gadgets_add(g, &other->gadget[idx]) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+void darm_gadgets_free(darm_gadgets_t *g)
+{
+    free(g->gadget);
+    free(g->table);
+    darm_gadgets_init(g);
+}
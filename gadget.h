@@ -0,0 +1,86 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef __GADGET_H__
+#define __GADGET_H__
+
+#include "darm.h"
+
+typedef struct _darm_gadget_t {
+    // address of the first instruction, with the least significant bit set
+    // for Thumb gadgets
+    uint32_t        addr;
+
+    // size in bytes and amount of instructions, including the terminator
+    uint32_t        size;
+    uint32_t        count;
+
+    // hash of the disassembled instructions
+    uint64_t        hash;
+} darm_gadget_t;
+
+typedef struct _darm_gadgets_t {
+    darm_gadget_t   *gadget;
+    uint32_t        count;
+    uint32_t        alloc;
+
+    // open addressing hash set of the gadget hashes, zero marks an empty
+    // slot, table_size is a power of two
+    uint64_t        *table;
+    uint32_t        table_size;
+} darm_gadgets_t;
+
+void darm_gadgets_init(darm_gadgets_t *g);
+
+//
+// Finds the gadgets of at most depth instructions in the image buf, which
+// is mapped at address base, that end with a terminator at an offset in the
+// range [start, end), start being a multiple of four. Terminators are
+// BX LR, POP {.., pc}, LDM {.., pc}, LDR pc, [sp], #4, and BLX Rm, both in
+// ARMv7 and Thumb mode. They are located using darm_search, after which the
+// instructions before them are disassembled from every word (ARMv7) or
+// halfword (Thumb) offset. A gadget may start before start, but only
+// contains instructions that don't change the flow of execution.
+//
+// Gadgets are deduplicated by the hash of their disassembled instructions,
+// only the first occurrence is kept. Searching disjoint ranges into
+// separate darm_gadgets_t objects, e.g., from multiple threads, and merging
+// them afterwards gives the same unique gadgets as a single search.
+//
+// Returns 0 on success, -1 on allocation failures.
+//
+int darm_gadgets_find(darm_gadgets_t *g, const uint8_t *buf, uint32_t len,
+    uint32_t base, uint32_t start, uint32_t end, uint32_t depth);
+
+// adds the gadgets of other which aren't in g yet
+int darm_gadgets_merge(darm_gadgets_t *g, const darm_gadgets_t *other);
+
+void darm_gadgets_free(darm_gadgets_t *g);
+
+#endif
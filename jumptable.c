@@ -0,0 +1,158 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "darm.h"
+#include "cfg.h"
+#include "jumptable.h"
+
+void darm_jt_init(darm_jt_t *jt, const uint8_t *buf, uint32_t len,
+    uint32_t base)
+{
+    memset(jt, 0, sizeof(darm_jt_t));
+    jt->buf = buf, jt->len = len, jt->base = base;
+    jt->reg = R_INVLD;
+}
+
+// reads an entry of size bytes from the table at addr
+static int _jt_read(const darm_jt_t *jt, uint32_t addr, uint32_t size,
+    uint32_t *value)
+{
+    uint32_t off = addr - jt->base;
+    if(addr < jt->base || off >= jt->len || jt->len - off < size) {
+        return -1;
+    }
+
+    const uint8_t *p = jt->buf + off;
+    switch (size) {
+    case 1: *value = p[0]; break;
+    case 2: *value = p[0] | (p[1] << 8); break;
+    default: *value = p[0] | (p[1] << 8) | (p[2] << 16) |
+        ((uint32_t) p[3] << 24); break;
+    }
+    return 0;
+}
+
+uint32_t darm_jt_step(darm_jt_t *jt, const darm_t *d, uint32_t addr,
+    uint32_t *targets, uint32_t max)
+{
+    uint32_t thumb = addr & 1, pc = (addr & ~1) + (thumb ? 4 : 8);
+    uint32_t table, size, count = jt->count;
+
+    if(d->instr == I_CMP && d->I == B_SET) {
+        jt->reg = d->Rn, jt->imm = d->imm, jt->count = 0;
+        return 0;
+    }
+
+    if(jt->reg == R_INVLD) return 0;
+
+    // the bounds check, bhi skips the switch for index > imm, and bhs for
+    // index >= imm
+    if(d->instr == I_B && (d->cond == C_HI || d->cond == C_CS)) {
+        if(jt->imm >= DARM_JT_MAXCASES) {
+            jt->reg = R_INVLD;
+            return 0;
+        }
+        jt->count = d->cond == C_HI ? jt->imm + 1 : jt->imm;
+        return 0;
+    }
+
+    // in ARMv7 the bounds check is usually the condition of the dispatch
+    if(count == 0 && d->cond == C_LS && jt->imm < DARM_JT_MAXCASES) {
+        count = jt->imm + 1;
+    }
+
+    int dispatch = count != 0 && d->Rm == jt->reg &&
+        (d->Rn == PC || d->instr == I_ADD);
+
+    switch (dispatch ? (uint32_t) d->instr : I_INVLD) {
+    case I_TBB: case I_TBH:
+        table = pc, size = d->instr == I_TBB ? 1 : 2;
+        break;
+
+    case I_ADD:
+        // each case is a branch instruction, starting at the pc
+        if(thumb != 0 || d->Rd != PC || d->Rn != PC ||
+                d->shift_type != S_LSL || d->shift != 2) {
+            dispatch = 0;
+            break;
+        }
+        table = 0, size = 0;
+        break;
+
+    case I_LDR:
+        if(d->Rt != PC || d->shift_type != S_LSL || d->shift != 2) {
+            dispatch = 0;
+            break;
+        }
+        table = pc & ~3, size = 4;
+        break;
+
+    default:
+        dispatch = 0;
+        break;
+    }
+
+    if(dispatch == 0) {
+        // the index register has been overwritten, or the basic block ended
+        // without a switch
+        if(((d->regs_written >> jt->reg) & 1) != 0 ||
+                (darm_flow(d) != F_NONE && !darm_flow_is_cond(d))) {
+            jt->reg = R_INVLD;
+        }
+        return 0;
+    }
+
+    // make sure the entire table is inside the image
+    if(size != 0 && (table < jt->base ||
+            (uint64_t) table - jt->base + count * size > jt->len)) {
+        jt->reg = R_INVLD;
+        return 0;
+    }
+
+    for (uint32_t idx = 0; idx < count && idx < max; idx++) {
+        if(size == 0) {
+            targets[idx] = pc + idx * 4;
+            continue;
+        }
+
+        uint32_t value = 0;
+        _jt_read(jt, table + idx * size, size, &value);
+
+        // tbb and tbh hold halfword offsets from the pc, ldr loads the
+        // address itself, including the thumb bit
+        targets[idx] = size != 4 ? (pc + value * 2) | 1 : value;
+    }
+
+    jt->table_addr = table, jt->table_size = count * size;
+    jt->reg = R_INVLD;
+    return count;
+}
@@ -0,0 +1,79 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef __JUMPTABLE_H__
+#define __JUMPTABLE_H__
+
+#include "darm.h"
+
+// switches with more cases than this are assumed to be a bogus bounds check,
+// e.g., a compare against a large immediate in data that has been decoded
+#define DARM_JT_MAXCASES 4096
+
+typedef struct _darm_jt_t {
+    // the image, mapped at address base, from which the tables are read
+    const uint8_t   *buf;
+    uint32_t        len;
+    uint32_t        base;
+
+    // the last register that has been compared against an immediate, and
+    // the amount of cases once the bounds check has been seen, i.e., a
+    // conditional branch on the result of the compare
+    darm_reg_t      reg;
+    uint32_t        imm;
+    uint32_t        count;
+
+    // the table of the last resolved switch if it contains data, e.g., the
+    // offsets for TBB, and zero if the table consists of instructions
+    uint32_t        table_addr;
+    uint32_t        table_size;
+} darm_jt_t;
+
+void darm_jt_init(darm_jt_t *jt, const uint8_t *buf, uint32_t len,
+    uint32_t base);
+
+//
+// Feeds the next instruction d, disassembled at address addr (with the
+// least significant bit set for Thumb), into the jump table resolver. The
+// instructions have to be given in program order, as the amount of cases
+// is taken from a preceding bounds check, e.g., cmp r0, #7 and bhi.
+//
+// The following switch idioms are recognized.
+// - tbb [pc, Rm] and tbh [pc, Rm, lsl #1]
+// - addls pc, pc, Rm, lsl #2 followed by a branch for each case
+// - ldrls pc, [pc, Rm, lsl #2] followed by a table of addresses
+//
+// Returns the amount of cases if d dispatches a switch, of which at most
+// max targets are written to targets (with the least significant bit set
+// for Thumb), and 0 otherwise.
+//
+uint32_t darm_jt_step(darm_jt_t *jt, const darm_t *d, uint32_t addr,
+    uint32_t *targets, uint32_t max);
+
+#endif
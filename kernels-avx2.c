@@ -0,0 +1,185 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include "darm.h"
+#include "kernels.h"
+
+#ifdef DARM_X86
+
+#ifndef __AVX2__
+#error "kernels-avx2.c has to be compiled with -mavx2"
+#endif
+
+#include <immintrin.h>
+
+// computes the classes of eight instructions at once, the class lookup is
+// a variable shift of the nibble tables
+void darm_classify_avx2(const uint32_t *w, uint32_t count, uint8_t *cls)
+{
+    const __m256i one = _mm256_set1_epi32(1), seven = _mm256_set1_epi32(7);
+    const __m256i lo = _mm256_set1_epi32(CLASSES_LO);
+    const __m256i hi = _mm256_set1_epi32(CLASSES_HI);
+
+    // gathers the lowest byte of each dword into the lower four bytes of
+    // each 128-bit lane
+    const __m256i gather = _mm256_setr_epi8(
+        0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+
+    uint32_t idx = 0;
+
+    for (; idx + 8 <= count; idx += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i *) &w[idx]);
+
+        __m256i op = _mm256_and_si256(_mm256_srli_epi32(v, 25), seven);
+        __m256i b4 = _mm256_and_si256(_mm256_srli_epi32(v, 4), one);
+        __m256i b7 = _mm256_and_si256(_mm256_srli_epi32(v, 7), one);
+
+        __m256i nz = _mm256_andnot_si256(
+            _mm256_cmpeq_epi32(op, _mm256_setzero_si256()), one);
+        __m256i flag = _mm256_and_si256(b4, _mm256_or_si256(b7, nz));
+
+        // op >= 4 selects the upper table, and the lower two bits of op
+        // together with the flag select the nibble
+        __m256i table = _mm256_blendv_epi8(lo, hi,
+            _mm256_cmpgt_epi32(op, _mm256_set1_epi32(3)));
+        __m256i shift = _mm256_slli_epi32(_mm256_or_si256(
+            _mm256_slli_epi32(_mm256_and_si256(op, _mm256_set1_epi32(3)),
+                1), flag), 2);
+
+        __m256i c = _mm256_and_si256(_mm256_srlv_epi32(table, shift),
+            _mm256_set1_epi32(15));
+
+        // unconditional instructions override the class
+        c = _mm256_blendv_epi8(c, _mm256_set1_epi32(DC_UNCOND),
+            _mm256_cmpeq_epi32(_mm256_srli_epi32(v, 28),
+                _mm256_set1_epi32(C_UNCOND)));
+
+        c = _mm256_shuffle_epi8(c, gather);
+        _mm_storel_epi64((__m128i *) &cls[idx], _mm_unpacklo_epi32(
+            _mm256_castsi256_si128(c), _mm256_extracti128_si256(c, 1)));
+    }
+
+    darm_classify_scalar(&w[idx], count - idx, &cls[idx]);
+}
+
+static uint64_t _prefix_avx2(const uint8_t *buf, uint32_t count)
+{
+    const __m256i limit = _mm256_set1_epi16((short) 0xe800);
+    uint64_t bits = 0; uint32_t idx = 0;
+
+    for (; idx + 32 <= count; idx += 32) {
+        __m256i a = _mm256_loadu_si256((const __m256i *) &buf[idx * 2]);
+        __m256i b = _mm256_loadu_si256((const __m256i *) &buf[idx * 2 + 32]);
+
+        a = _mm256_cmpeq_epi16(_mm256_max_epu16(a, limit), a);
+        b = _mm256_cmpeq_epi16(_mm256_max_epu16(b, limit), b);
+
+        // packing works per 128-bit lane, so the quadwords have to be put
+        // back in order afterwards
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi16(a, b),
+            _MM_SHUFFLE(3, 1, 2, 0));
+
+        uint64_t mask = (uint32_t) _mm256_movemask_epi8(packed);
+        bits |= mask << idx;
+    }
+
+    if(idx < count) {
+        bits |= darm_kernels_sse42.prefix(&buf[idx * 2], count - idx) << idx;
+    }
+    return bits;
+}
+
+static uint64_t _match_avx2(const uint32_t *words, uint32_t count,
+    uint32_t mask, uint32_t value)
+{
+    const __m256i m = _mm256_set1_epi32(mask), v = _mm256_set1_epi32(value);
+    uint64_t bits = 0; uint32_t idx = 0;
+
+    for (; idx + 16 <= count; idx += 16) {
+        __m256i a = _mm256_loadu_si256((const __m256i *) &words[idx]);
+        __m256i b = _mm256_loadu_si256((const __m256i *) &words[idx + 8]);
+
+        a = _mm256_cmpeq_epi32(_mm256_and_si256(a, m), v);
+        b = _mm256_cmpeq_epi32(_mm256_and_si256(b, m), v);
+
+        uint64_t lo = _mm256_movemask_ps(_mm256_castsi256_ps(a));
+        uint64_t hi = _mm256_movemask_ps(_mm256_castsi256_ps(b));
+        bits |= (lo | (hi << 8)) << idx;
+    }
+
+    if(idx < count) {
+        bits |= darm_kernels_sse42.match(&words[idx], count - idx, mask,
+            value) << idx;
+    }
+    return bits;
+}
+
+static void _bswap32_avx2(uint32_t *dst, const uint32_t *src,
+    uint32_t count)
+{
+    const __m256i shuf = _mm256_setr_epi8(
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    uint32_t idx = 0;
+
+    for (; idx + 8 <= count; idx += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i *) &src[idx]);
+        _mm256_storeu_si256((__m256i *) &dst[idx],
+            _mm256_shuffle_epi8(v, shuf));
+    }
+
+    darm_kernels_sse42.bswap32(&dst[idx], &src[idx], count - idx);
+}
+
+static void _bswap16_avx2(uint16_t *dst, const uint16_t *src,
+    uint32_t count)
+{
+    const __m256i shuf = _mm256_setr_epi8(
+        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    uint32_t idx = 0;
+
+    for (; idx + 16 <= count; idx += 16) {
+        __m256i v = _mm256_loadu_si256((const __m256i *) &src[idx]);
+        _mm256_storeu_si256((__m256i *) &dst[idx],
+            _mm256_shuffle_epi8(v, shuf));
+    }
+
+    darm_kernels_sse42.bswap16(&dst[idx], &src[idx], count - idx);
+}
+
+const darm_kernels_t darm_kernels_avx2 = {
+    CPU_SSE42 | CPU_AVX2, &darm_classify_avx2, &_prefix_avx2,
+    &_match_avx2, &_bswap32_avx2, &_bswap16_avx2,
+};
+
+#endif
@@ -0,0 +1,118 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include "darm.h"
+#include "kernels.h"
+
+#ifdef DARM_X86
+
+#if !defined(__AVX512F__) || !defined(__AVX512BW__) || !defined(__AVX512VL__)
+#error "kernels-avx512.c has to be compiled with -mavx512f -mavx512bw -mavx512vl"
+#endif
+
+#include <immintrin.h>
+
+// the comparisons directly produce a bitmask, so there's no packing
+static uint64_t _prefix_avx512(const uint8_t *buf, uint32_t count)
+{
+    const __m512i limit = _mm512_set1_epi16((short) 0xe800);
+    uint64_t bits = 0; uint32_t idx = 0;
+
+    for (; idx + 32 <= count; idx += 32) {
+        __m512i v = _mm512_loadu_si512((const void *) &buf[idx * 2]);
+        bits |= (uint64_t) _mm512_cmpge_epu16_mask(v, limit) << idx;
+    }
+
+    // the remaining halfwords are loaded with a mask, which doesn't touch
+    // the memory beyond the buffer
+    if(idx < count) {
+        __mmask32 valid = (__mmask32)((1ULL << (count - idx)) - 1);
+        __m512i v = _mm512_maskz_loadu_epi16(valid, &buf[idx * 2]);
+        bits |= (uint64_t) _mm512_mask_cmpge_epu16_mask(valid, v,
+            limit) << idx;
+    }
+    return bits;
+}
+
+static uint64_t _match_avx512(const uint32_t *words, uint32_t count,
+    uint32_t mask, uint32_t value)
+{
+    const __m512i m = _mm512_set1_epi32(mask), v = _mm512_set1_epi32(value);
+    uint64_t bits = 0;
+
+    for (uint32_t idx = 0; idx < count; idx += 16) {
+        __mmask16 valid = count - idx >= 16 ? 0xffff :
+            (__mmask16)((1 << (count - idx)) - 1);
+        __m512i w = _mm512_maskz_loadu_epi32(valid, &words[idx]);
+
+        bits |= (uint64_t) _mm512_mask_cmpeq_epi32_mask(valid,
+            _mm512_and_si512(w, m), v) << idx;
+    }
+    return bits;
+}
+
+static void _bswap32_avx512(uint32_t *dst, const uint32_t *src,
+    uint32_t count)
+{
+    const __m512i shuf = _mm512_broadcast_i32x4(_mm_setr_epi8(
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12));
+
+    for (uint32_t idx = 0; idx < count; idx += 16) {
+        __mmask16 valid = count - idx >= 16 ? 0xffff :
+            (__mmask16)((1 << (count - idx)) - 1);
+        __m512i v = _mm512_maskz_loadu_epi32(valid, &src[idx]);
+        _mm512_mask_storeu_epi32(&dst[idx], valid,
+            _mm512_shuffle_epi8(v, shuf));
+    }
+}
+
+static void _bswap16_avx512(uint16_t *dst, const uint16_t *src,
+    uint32_t count)
+{
+    const __m512i shuf = _mm512_broadcast_i32x4(_mm_setr_epi8(
+        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14));
+
+    for (uint32_t idx = 0; idx < count; idx += 32) {
+        __mmask32 valid = count - idx >= 32 ? 0xffffffff :
+            (__mmask32)((1U << (count - idx)) - 1);
+        __m512i v = _mm512_maskz_loadu_epi16(valid, &src[idx]);
+        _mm512_mask_storeu_epi16(&dst[idx], valid,
+            _mm512_shuffle_epi8(v, shuf));
+    }
+}
+
+// the classification doesn't gain anything over AVX2
+const darm_kernels_t darm_kernels_avx512 = {
+    CPU_SSE42 | CPU_AVX2 | CPU_AVX512, &darm_classify_avx2, &_prefix_avx512,
+    &_match_avx512, &_bswap32_avx512, &_bswap16_avx512,
+};
+
+#endif
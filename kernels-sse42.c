@@ -0,0 +1,172 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include "darm.h"
+#include "kernels.h"
+
+#ifdef DARM_X86
+
+#ifndef __SSE4_2__
+#error "kernels-sse42.c has to be compiled with -msse4.2"
+#endif
+
+#include <immintrin.h>
+
+// computes the keys of eight instructions, the class of each key is then
+// looked up one by one
+static void _classify_sse42(const uint32_t *w, uint32_t count, uint8_t *cls)
+{
+    const __m128i one = _mm_set1_epi32(1), seven = _mm_set1_epi32(7);
+    const __m128i uncond = _mm_set1_epi32(C_UNCOND);
+    uint32_t idx = 0;
+
+    for (; idx + 8 <= count; idx += 8) {
+        __m128i key[2]; uint8_t keys[16];
+
+        for (uint32_t half = 0; half < 2; half++) {
+            __m128i v = _mm_loadu_si128((const __m128i *) &w[idx + half*4]);
+
+            __m128i op = _mm_and_si128(_mm_srli_epi32(v, 25), seven);
+            __m128i b4 = _mm_and_si128(_mm_srli_epi32(v, 4), one);
+            __m128i b7 = _mm_and_si128(_mm_srli_epi32(v, 7), one);
+
+            // bit 7 only matters for data-processing instructions
+            __m128i nz = _mm_andnot_si128(
+                _mm_cmpeq_epi32(op, _mm_setzero_si128()), one);
+            __m128i flag = _mm_and_si128(b4, _mm_or_si128(b7, nz));
+
+            // unconditional instructions get key 16 and up
+            __m128i unc = _mm_and_si128(
+                _mm_cmpeq_epi32(_mm_srli_epi32(v, 28), uncond),
+                _mm_set1_epi32(16));
+
+            key[half] = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(op, 1),
+                flag), unc);
+        }
+
+        __m128i packed = _mm_packs_epi32(key[0], key[1]);
+        _mm_storeu_si128((__m128i *) keys, _mm_packus_epi16(packed, packed));
+
+        for (uint32_t k = 0; k < 8; k++) {
+            cls[idx + k] = keys[k] >= 16 ? DC_UNCOND :
+                ((keys[k] & 8 ? CLASSES_HI : CLASSES_LO) >>
+                    ((keys[k] & 7) * 4)) & 15;
+        }
+    }
+
+    darm_classify_scalar(&w[idx], count - idx, &cls[idx]);
+}
+
+// a halfword is at least 0xe800 if the unsigned maximum of the two is the
+// halfword itself
+static uint64_t _prefix_sse42(const uint8_t *buf, uint32_t count)
+{
+    const __m128i limit = _mm_set1_epi16((short) 0xe800);
+    uint64_t bits = 0; uint32_t idx = 0;
+
+    for (; idx + 16 <= count; idx += 16) {
+        __m128i a = _mm_loadu_si128((const __m128i *) &buf[idx * 2]);
+        __m128i b = _mm_loadu_si128((const __m128i *) &buf[idx * 2 + 16]);
+
+        a = _mm_cmpeq_epi16(_mm_max_epu16(a, limit), a);
+        b = _mm_cmpeq_epi16(_mm_max_epu16(b, limit), b);
+
+        uint64_t mask = (uint16_t) _mm_movemask_epi8(_mm_packs_epi16(a, b));
+        bits |= mask << idx;
+    }
+
+    if(idx < count) {
+        bits |= darm_prefix_scalar(&buf[idx * 2], count - idx) << idx;
+    }
+    return bits;
+}
+
+static uint64_t _match_sse42(const uint32_t *words, uint32_t count,
+    uint32_t mask, uint32_t value)
+{
+    const __m128i m = _mm_set1_epi32(mask), v = _mm_set1_epi32(value);
+    uint64_t bits = 0; uint32_t idx = 0;
+
+    for (; idx + 8 <= count; idx += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i *) &words[idx]);
+        __m128i b = _mm_loadu_si128((const __m128i *) &words[idx + 4]);
+
+        a = _mm_cmpeq_epi32(_mm_and_si128(a, m), v);
+        b = _mm_cmpeq_epi32(_mm_and_si128(b, m), v);
+
+        uint64_t lo = _mm_movemask_ps(_mm_castsi128_ps(a));
+        uint64_t hi = _mm_movemask_ps(_mm_castsi128_ps(b));
+        bits |= (lo | (hi << 4)) << idx;
+    }
+
+    if(idx < count) {
+        bits |= darm_match_scalar(&words[idx], count - idx, mask,
+            value) << idx;
+    }
+    return bits;
+}
+
+static void _bswap32_sse42(uint32_t *dst, const uint32_t *src,
+    uint32_t count)
+{
+    const __m128i shuf = _mm_setr_epi8(
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    uint32_t idx = 0;
+
+    for (; idx + 4 <= count; idx += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *) &src[idx]);
+        _mm_storeu_si128((__m128i *) &dst[idx], _mm_shuffle_epi8(v, shuf));
+    }
+
+    darm_bswap32_scalar(&dst[idx], &src[idx], count - idx);
+}
+
+static void _bswap16_sse42(uint16_t *dst, const uint16_t *src,
+    uint32_t count)
+{
+    const __m128i shuf = _mm_setr_epi8(
+        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    uint32_t idx = 0;
+
+    for (; idx + 8 <= count; idx += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *) &src[idx]);
+        _mm_storeu_si128((__m128i *) &dst[idx], _mm_shuffle_epi8(v, shuf));
+    }
+
+    darm_bswap16_scalar(&dst[idx], &src[idx], count - idx);
+}
+
+const darm_kernels_t darm_kernels_sse42 = {
+    CPU_SSE42, &_classify_sse42, &_prefix_sse42, &_match_sse42,
+    &_bswap32_sse42, &_bswap16_sse42,
+};
+
+#endif
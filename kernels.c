@@ -0,0 +1,209 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include "darm.h"
+#include "kernels.h"
+
+#ifdef DARM_X86
+#include <cpuid.h>
+#endif
+
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
+static inline uint32_t _classify(uint32_t w)
+{
+    uint32_t op = (w >> 25) & 7, b4 = (w >> 4) & 1, b7 = (w >> 7) & 1;
+    uint32_t key = (op << 1) | (b4 & (b7 | (op != 0)));
+
+    if((w >> 28) == C_UNCOND) return DC_UNCOND;
+
+    return ((key & 8 ? CLASSES_HI : CLASSES_LO) >> ((key & 7) * 4)) & 15;
+}
+
+void darm_classify_scalar(const uint32_t *w, uint32_t count, uint8_t *cls)
+{
+    for (uint32_t idx = 0; idx < count; idx++) {
+        cls[idx] = _classify(w[idx]);
+    }
+}
+
+uint64_t darm_prefix_scalar(const uint8_t *buf, uint32_t count)
+{
+    uint64_t bits = 0;
+    for (uint32_t idx = 0; idx < count; idx++) {
+        uint32_t hw = buf[idx * 2] | (buf[idx * 2 + 1] << 8);
+        bits |= (uint64_t) IS_PREFIX(hw) << idx;
+    }
+    return bits;
+}
+
+uint64_t darm_match_scalar(const uint32_t *words, uint32_t count,
+    uint32_t mask, uint32_t value)
+{
+    uint64_t bits = 0;
+    for (uint32_t idx = 0; idx < count; idx++) {
+        bits |= (uint64_t)((words[idx] & mask) == value) << idx;
+    }
+    return bits;
+}
+
+void darm_bswap32_scalar(uint32_t *dst, const uint32_t *src, uint32_t count)
+{
+    for (uint32_t idx = 0; idx < count; idx++) {
+        dst[idx] = __builtin_bswap32(src[idx]);
+    }
+}
+
+void darm_bswap16_scalar(uint16_t *dst, const uint16_t *src, uint32_t count)
+{
+    for (uint32_t idx = 0; idx < count; idx++) {
+        dst[idx] = (uint16_t)((src[idx] >> 8) | (src[idx] << 8));
+    }
+}
+
+uint32_t darm_pext(uint32_t value, uint32_t mask)
+{
+#ifdef __BMI2__
+    return _pext_u32(value, mask);
+#else
+    uint32_t ret = 0;
+    for (uint32_t bit = 1; mask != 0; mask &= mask - 1, bit <<= 1) {
+        if(value & mask & -mask) {
+            ret |= bit;
+        }
+    }
+    return ret;
+#endif
+}
+
+static const darm_kernels_t g_kernels_scalar = {
+    0, &darm_classify_scalar, &darm_prefix_scalar, &darm_match_scalar,
+    &darm_bswap32_scalar, &darm_bswap16_scalar,
+};
+
+// only accessed atomically, as the first use may happen from several
+// threads at once, e.g., the gadget search of bindarm
+static const darm_kernels_t *g_kernels;
+
+uint32_t darm_cpu_features()
+{
+    uint32_t features = 0;
+
+#ifdef DARM_X86
+    uint32_t eax, ebx, ecx, edx, xcr0 = 0;
+
+    if(__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0) {
+        return 0;
+    }
+
+    // pshufb is SSSE3, which every cpu with SSE4.2 supports as well
+    if((ecx >> 20) & 1) {
+        features |= CPU_SSE42;
+    }
+
+    // the operating system has to save the ymm and zmm registers, which is
+    // checked through xgetbv, only available with osxsave
+    if((ecx >> 27) & 1) {
+        __asm__ __volatile__("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+        xcr0 = eax;
+    }
+
+    uint32_t avx = (ecx >> 28) & 1;
+
+    if(__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) == 0) {
+        return features;
+    }
+
+    if(avx != 0 && (xcr0 & 0x06) == 0x06 && (ebx >> 5) & 1) {
+        features |= CPU_AVX2;
+    }
+
+    // avx512f, avx512bw, and avx512vl, plus the opmask and zmm state
+    if((features & CPU_AVX2) != 0 && (xcr0 & 0xe0) == 0xe0 &&
+            (ebx >> 16) & 1 && (ebx >> 30) & 1 && (ebx >> 31) & 1) {
+        features |= CPU_AVX512;
+    }
+#endif
+
+    return features;
+}
+
+uint32_t darm_cpu_select(uint32_t features)
+{
+    const darm_kernels_t *kernels = &g_kernels_scalar;
+
+    features &= darm_cpu_features();
+
+#ifdef DARM_X86
+    if(features & CPU_AVX512) {
+        kernels = &darm_kernels_avx512;
+    }
+    else if(features & CPU_AVX2) {
+        kernels = &darm_kernels_avx2;
+    }
+    else if(features & CPU_SSE42) {
+        kernels = &darm_kernels_sse42;
+    }
+#endif
+
+    __atomic_store_n(&g_kernels, kernels, __ATOMIC_RELEASE);
+    return kernels->features;
+}
+
+const darm_kernels_t *darm_kernels()
+{
+    const darm_kernels_t *kernels =
+        __atomic_load_n(&g_kernels, __ATOMIC_ACQUIRE);
+
+    // concurrent first uses all select the same kernels
+    if(kernels == NULL) {
+        darm_cpu_select(~0);
+        kernels = __atomic_load_n(&g_kernels, __ATOMIC_ACQUIRE);
+    }
+    return kernels;
+}
+
+void darm_armv7_classify(const uint32_t *w, uint32_t count, uint8_t *cls)
+{
+    darm_kernels()->classify(w, count, cls);
+}
+
+void darm_bswap32(uint32_t *dst, const uint32_t *src, uint32_t count)
+{
+    darm_kernels()->bswap32(dst, src, count);
+}
+
+void darm_bswap16(uint16_t *dst, const uint16_t *src, uint32_t count)
+{
+    darm_kernels()->bswap16(dst, src, count);
+}
@@ -0,0 +1,97 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef __KERNELS_H__
+#define __KERNELS_H__
+
+#include <stdint.h>
+#include "darm.h"
+
+// the vectorized kernels are only available for x86 and x86-64, each ISA
+// has its own object, see the Makefile
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DARM_X86 1
+#endif
+
+// the class of each key, i.e., bits 27..25 of the instruction followed by
+// bit 4 (or bits 7 and 4 for data-processing), as one nibble per key; keys
+// 0..7 are stored in CLASSES_LO and keys 8..15 in CLASSES_HI
+#define CLASSES_LO 0x32220010
+#define CLASSES_HI 0x66665544
+
+// a halfword starts a 32-bit instruction if bits 15..11 are 0b11101,
+// 0b11110, or 0b11111, see darm_disasm
+#define IS_PREFIX(hw) ((hw) >= 0xe800)
+
+typedef struct _darm_kernels_t {
+    // the cpu features the kernels require
+    uint32_t        features;
+
+    // classifies count armv7 instructions, see darm_armv7_classify
+    void (*classify)(const uint32_t *w, uint32_t count, uint8_t *cls);
+
+    // one bit per halfword for the count (at most 64) halfwords in buf, set
+    // if it would start a 32-bit Thumb instruction
+    uint64_t (*prefix)(const uint8_t *buf, uint32_t count);
+
+    // one bit per word for the count (at most 64) words, set if the word
+    // matches the pattern, see darm_match_block
+    uint64_t (*match)(const uint32_t *words, uint32_t count, uint32_t mask,
+        uint32_t value);
+
+    // reverses the byte order of count words or halfwords
+    void (*bswap32)(uint32_t *dst, const uint32_t *src, uint32_t count);
+    void (*bswap16)(uint16_t *dst, const uint16_t *src, uint32_t count);
+} darm_kernels_t;
+
+// the kernels for the features of this cpu, selected on first use, see
+// darm_cpu_select
+const darm_kernels_t *darm_kernels();
+
+// the portable kernels, which are also used by the vectorized kernels for
+// the remaining elements
+void darm_classify_scalar(const uint32_t *w, uint32_t count, uint8_t *cls);
+uint64_t darm_prefix_scalar(const uint8_t *buf, uint32_t count);
+uint64_t darm_match_scalar(const uint32_t *words, uint32_t count,
+    uint32_t mask, uint32_t value);
+void darm_bswap32_scalar(uint32_t *dst, const uint32_t *src, uint32_t count);
+void darm_bswap16_scalar(uint16_t *dst, const uint16_t *src, uint32_t count);
+
+#ifdef DARM_X86
+
+extern const darm_kernels_t darm_kernels_sse42;
+extern const darm_kernels_t darm_kernels_avx2;
+extern const darm_kernels_t darm_kernels_avx512;
+
+// shared with the AVX-512 kernels
+void darm_classify_avx2(const uint32_t *w, uint32_t count, uint8_t *cls);
+
+#endif
+
+#endif
@@ -0,0 +1,498 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "darm.h"
+#include "ngram.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#define NGRAM_MAGIC "DARMNGR1"
+
+#define FNV_OFFSET 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+
+typedef struct _ngram_header_t {
+    char            magic[8];
+    uint32_t        n;
+    uint32_t        key_count;
+    uint32_t        block_count;
+    uint32_t        doc_count;
+    uint32_t        file_count;
+    uint32_t        reserved;
+    uint64_t        strings_size;
+    uint64_t        postings_size;
+} ngram_header_t;
+
+uint32_t darm_ngram_token(const darm_t *d)
+{
+    const darm_reg_t regs[] = {
+        d->Rd, d->Rn, d->Rm, d->Ra, d->Rt, d->Rt2, d->RdHi, d->RdLo, d->Rs,
+    };
+
+    // the instruction in the lower 16 bits, one bit per operand kind in
+    // the upper bits
+    uint32_t token = d->instr, bit = 16;
+    for (uint32_t idx = 0; idx < ARRAYSIZE(regs); idx++, bit++) {
+        token |= (uint32_t)(regs[idx] != R_INVLD) << bit;
+    }
+
+    token |= (uint32_t)(d->I == B_SET) << bit++;
+    token |= (uint32_t)(d->shift_type != S_INVLD) << bit++;
+    token |= (uint32_t)(d->reglist != 0) << bit++;
+    token |= (uint32_t)(d->cond != C_AL && d->cond != C_UNCOND &&
+        d->cond != C_INVLD) << bit++;
+    return token;
+}
+
+uint32_t darm_ngram_tokens(const uint8_t *buf, uint32_t len, uint32_t addr,
+    uint32_t *tokens, uint32_t max)
+{
+    uint32_t thumb = addr & 1, off = 0, count = 0;
+    darm_it_t it; darm_t d;
+
+    darm_it_init(&it);
+
+    while (count < max && off + (thumb ? 2 : 4) <= len) {
+        uint16_t w = buf[off] | (buf[off + 1] << 8), w2 = 0;
+        if(off + 4 <= len) {
+            w2 = buf[off + 2] | (buf[off + 3] << 8);
+        }
+
+        int ret = darm_disasm_it(&it, &d, w, w2, ((addr & ~1) + off) | thumb);
+        tokens[count++] = ret != 0 ? darm_ngram_token(&d) : DARM_TOKEN_INVLD;
+        off += thumb != 0 && ret != 2 ? 2 : 4;
+    }
+    return count;
+}
+
+uint32_t darm_ngram_keys(const uint32_t *tokens, uint32_t count, uint32_t n,
+    uint64_t *keys)
+{
+    if(n == 0 || count < n) return 0;
+
+    for (uint32_t idx = 0; idx + n <= count; idx++) {
+        uint64_t hash = FNV_OFFSET;
+        for (uint32_t tok = 0; tok < n; tok++) {
+            for (uint32_t byte = 0; byte < 32; byte += 8) {
+                hash = (hash ^ ((tokens[idx + tok] >> byte) & 0xff)) *
+                    FNV_PRIME;
+            }
+        }
+        keys[idx] = hash;
+    }
+    return count - n + 1;
+}
+
+void darm_ngram_builder_init(darm_ngram_builder_t *b, uint32_t n)
+{
+    memset(b, 0, sizeof(darm_ngram_builder_t));
+    b->n = n;
+}
+
+// makes room for count more elements of size bytes in the array
+static int _grow(void **ptr, uint32_t *alloc, uint32_t used, uint32_t count,
+    uint32_t size)
+{
+    if(used + count <= *alloc) return 0;
+
+    uint32_t n = *alloc != 0 ? *alloc : 64;
+    while (n < used + count) {
+        n *= 2;
+    }
+
+    void *p = realloc(*ptr, (size_t) n * size);
+    if(p == NULL) return -1;
+
+    *ptr = p, *alloc = n;
+    return 0;
+}
+
+int32_t darm_ngram_add_file(darm_ngram_builder_t *b, const char *name)
+{
+    if(_grow((void **) &b->file, &b->file_alloc, b->file_count, 1,
+            sizeof(char *)) < 0) {
+        return -1;
+    }
+
+    char *p = malloc(strlen(name) + 1);
+    if(p == NULL) return -1;
+
+    strcpy(p, name);
+    b->file[b->file_count] = p;
+    return b->file_count++;
+}
+
+int32_t darm_ngram_add_doc(darm_ngram_builder_t *b, uint32_t file,
+    uint32_t addr, const uint64_t *keys, uint32_t count)
+{
+    if(_grow((void **) &b->doc, &b->doc_alloc, b->doc_count, 1,
+            sizeof(darm_ngram_doc_t)) < 0 ||
+            _grow((void **) &b->pair, &b->pair_alloc, b->pair_count, count,
+            sizeof(darm_ngram_pair_t)) < 0) {
+        return -1;
+    }
+
+    for (uint32_t idx = 0; idx < count; idx++) {
+        b->pair[b->pair_count].key = keys[idx];
+        b->pair[b->pair_count++].doc = b->doc_count;
+    }
+
+    b->doc[b->doc_count].file = file;
+    b->doc[b->doc_count].addr = addr;
+    return b->doc_count++;
+}
+
+int darm_ngram_builder_merge(darm_ngram_builder_t *b,
+    darm_ngram_builder_t *other)
+{
+    if(_grow((void **) &b->file, &b->file_alloc, b->file_count,
+            other->file_count, sizeof(char *)) < 0 ||
+            _grow((void **) &b->doc, &b->doc_alloc, b->doc_count,
+            other->doc_count, sizeof(darm_ngram_doc_t)) < 0 ||
+            _grow((void **) &b->pair, &b->pair_alloc, b->pair_count,
+            other->pair_count, sizeof(darm_ngram_pair_t)) < 0) {
+        return -1;
+    }
+
+    for (uint32_t idx = 0; idx < other->pair_count; idx++) {
+        b->pair[b->pair_count].key = other->pair[idx].key;
+        b->pair[b->pair_count++].doc = other->pair[idx].doc + b->doc_count;
+    }
+
+    for (uint32_t idx = 0; idx < other->doc_count; idx++) {
+        b->doc[b->doc_count].file = other->doc[idx].file + b->file_count;
+        b->doc[b->doc_count++].addr = other->doc[idx].addr;
+    }
+
+    // the file names are now owned by b
+    memcpy(&b->file[b->file_count], other->file,
+        other->file_count * sizeof(char *));
+    b->file_count += other->file_count;
+    other->file_count = 0;
+
+    darm_ngram_builder_free(other);
+    return 0;
+}
+
+static int _pair_compare(const void *a, const void *b)
+{
+    const darm_ngram_pair_t *x = (const darm_ngram_pair_t *) a;
+    const darm_ngram_pair_t *y = (const darm_ngram_pair_t *) b;
+
+    if(x->key != y->key) return x->key < y->key ? -1 : 1;
+    if(x->doc != y->doc) return x->doc < y->doc ? -1 : 1;
+    return 0;
+}
+
+static uint32_t _leb128(uint8_t *out, uint32_t value)
+{
+    uint32_t len = 0;
+    do {
+        out[len++] = (value & 0x7f) | (value > 0x7f ? 0x80 : 0);
+        value >>= 7;
+    } while (value != 0);
+    return len;
+}
+
+static int _pad8(FILE *fp, uint64_t size)
+{
+    static const uint8_t zero[8];
+    return fwrite(zero, 1, -size & 7, fp) == (-size & 7) ? 0 : -1;
+}
+
+int darm_ngram_write(darm_ngram_builder_t *b, const char *fname)
+{
+    qsort(b->pair, b->pair_count, sizeof(darm_ngram_pair_t), &_pair_compare);
+
+    // unique keys, and the postings encoded in place of the pairs, as
+    // they never take more space than the pairs they're encoded from
+    uint64_t *keys = malloc((b->pair_count + 1) * sizeof(uint64_t));
+    uint64_t *offsets = malloc((b->pair_count + 1) * sizeof(uint64_t));
+    uint64_t *blocks = malloc((b->pair_count / DARM_NGRAM_BLOCK + 1) *
+        sizeof(uint64_t));
+    uint8_t *postings = (uint8_t *) b->pair;
+    uint32_t key_count = 0; uint64_t size = 0;
+
+    if(keys == NULL || offsets == NULL || blocks == NULL) {
+        free(keys), free(offsets), free(blocks);
+        return -1;
+    }
+
+    for (uint32_t idx = 0, prev = 0; idx < b->pair_count; idx++) {
+        darm_ngram_pair_t pair = b->pair[idx];
+
+        if(key_count == 0 || keys[key_count - 1] != pair.key) {
+            keys[key_count] = pair.key;
+            offsets[key_count++] = size;
+            size += _leb128(&postings[size], pair.doc);
+        }
+        else if(pair.doc != prev) {
+            size += _leb128(&postings[size], pair.doc - prev);
+        }
+        prev = pair.doc;
+    }
+    offsets[key_count] = size;
+
+    uint32_t block_count = (key_count + DARM_NGRAM_BLOCK - 1) /
+        DARM_NGRAM_BLOCK;
+    for (uint32_t idx = 0; idx < block_count; idx++) {
+        blocks[idx] = keys[idx * DARM_NGRAM_BLOCK];
+    }
+
+    ngram_header_t hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, NGRAM_MAGIC, sizeof(hdr.magic));
+    hdr.n = b->n;
+    hdr.key_count = key_count;
+    hdr.block_count = block_count;
+    hdr.doc_count = b->doc_count;
+    hdr.file_count = b->file_count;
+    hdr.postings_size = size;
+
+    uint32_t *names = malloc((b->file_count + 1) * sizeof(uint32_t));
+    for (uint32_t idx = 0; names != NULL && idx < b->file_count; idx++) {
+        names[idx] = hdr.strings_size;
+        hdr.strings_size += strlen(b->file[idx]) + 1;
+    }
+
+    FILE *fp = names != NULL ? fopen(fname, "wb") : NULL;
+    int ret = fp != NULL &&
+        fwrite(&hdr, sizeof(hdr), 1, fp) == 1 &&
+        fwrite(blocks, sizeof(uint64_t), block_count, fp) == block_count &&
+        fwrite(keys, sizeof(uint64_t), key_count, fp) == key_count &&
+        fwrite(offsets, sizeof(uint64_t), key_count + 1,
+            fp) == key_count + 1 &&
+        fwrite(b->doc, sizeof(darm_ngram_doc_t), b->doc_count,
+            fp) == b->doc_count &&
+        fwrite(names, sizeof(uint32_t), b->file_count,
+            fp) == b->file_count &&
+        _pad8(fp, b->file_count * sizeof(uint32_t)) == 0 ? 0 : -1;
+
+    for (uint32_t idx = 0; ret == 0 && idx < b->file_count; idx++) {
+        if(fwrite(b->file[idx], strlen(b->file[idx]) + 1, 1, fp) != 1) {
+            ret = -1;
+        }
+    }
+
+    if(ret == 0 && (_pad8(fp, hdr.strings_size) < 0 ||
+            fwrite(postings, 1, size, fp) != size)) {
+        ret = -1;
+    }
+
+    if(fp != NULL && fclose(fp) != 0) {
+        ret = -1;
+    }
+
+    // the pairs have been overwritten by the postings
+    b->pair_count = 0;
+
+    free(names), free(keys), free(offsets), free(blocks);
+    return ret;
+}
+
+void darm_ngram_builder_free(darm_ngram_builder_t *b)
+{
+    for (uint32_t idx = 0; idx < b->file_count; idx++) {
+        free(b->file[idx]);
+    }
+    free(b->file), free(b->doc), free(b->pair);
+    darm_ngram_builder_init(b, b->n);
+}
+
+int darm_ngram_open(darm_ngram_index_t *ix, const char *fname)
+{
+    memset(ix, 0, sizeof(darm_ngram_index_t));
+
+#ifndef _WIN32
+    int fd = open(fname, O_RDONLY);
+    if(fd < 0) return -1;
+
+    struct stat st;
+    if(fstat(fd, &st) < 0 || (uint64_t) st.st_size < sizeof(ngram_header_t)) {
+        close(fd);
+        return -1;
+    }
+
+    void *ptr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(ptr == MAP_FAILED) return -1;
+
+    // lookups jump all over the place
+    madvise(ptr, st.st_size, MADV_RANDOM);
+
+    ix->map = ptr, ix->size = st.st_size;
+#else
+    FILE *fp = fopen(fname, "rb");
+    if(fp == NULL) return -1;
+
+    fseek(fp, 0, SEEK_END);
+    long len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    uint8_t *buf = len >= (long) sizeof(ngram_header_t) ? malloc(len) : NULL;
+    if(buf != NULL && fread(buf, 1, len, fp) != (size_t) len) {
+        free(buf), buf = NULL;
+    }
+    fclose(fp);
+    if(buf == NULL) return -1;
+
+    ix->map = buf, ix->size = len;
+#endif
+
+    const ngram_header_t *hdr = (const ngram_header_t *) ix->map;
+    ix->n = hdr->n;
+    ix->key_count = hdr->key_count;
+    ix->block_count = hdr->block_count;
+    ix->doc_count = hdr->doc_count;
+    ix->file_count = hdr->file_count;
+    ix->strings_size = hdr->strings_size;
+    ix->postings_size = hdr->postings_size;
+
+    // the size of each section, rounded up to eight bytes
+    uint64_t sizes[] = {
+        sizeof(ngram_header_t),
+        (uint64_t) hdr->block_count * sizeof(uint64_t),
+        (uint64_t) hdr->key_count * sizeof(uint64_t),
+        ((uint64_t) hdr->key_count + 1) * sizeof(uint64_t),
+        (uint64_t) hdr->doc_count * sizeof(darm_ngram_doc_t),
+        ((uint64_t) hdr->file_count * sizeof(uint32_t) + 7) & ~7ULL,
+        (hdr->strings_size + 7) & ~7ULL,
+        hdr->postings_size,
+    };
+
+    uint64_t off[ARRAYSIZE(sizes) + 1] = {0};
+    for (uint32_t idx = 0; idx < ARRAYSIZE(sizes); idx++) {
+        off[idx + 1] = off[idx] + sizes[idx];
+    }
+
+    if(memcmp(hdr->magic, NGRAM_MAGIC, sizeof(hdr->magic)) != 0 ||
+            hdr->strings_size > ix->size || hdr->postings_size > ix->size ||
+            off[ARRAYSIZE(sizes)] != ix->size || hdr->block_count !=
+            (hdr->key_count + DARM_NGRAM_BLOCK - 1) / DARM_NGRAM_BLOCK) {
+        darm_ngram_close(ix);
+        return -1;
+    }
+
+    ix->block = (const uint64_t *) &ix->map[off[1]];
+    ix->keys = (const uint64_t *) &ix->map[off[2]];
+    ix->offsets = (const uint64_t *) &ix->map[off[3]];
+    ix->doc = (const darm_ngram_doc_t *) &ix->map[off[4]];
+    ix->names = (const uint32_t *) &ix->map[off[5]];
+    ix->strings = (const char *) &ix->map[off[6]];
+    ix->postings = &ix->map[off[7]];
+
+    if(ix->key_count != 0 &&
+            ix->offsets[ix->key_count] != ix->postings_size) {
+        darm_ngram_close(ix);
+        return -1;
+    }
+    return 0;
+}
+
+uint32_t darm_ngram_lookup(const darm_ngram_index_t *ix, uint64_t key,
+    uint32_t *docs, uint32_t max)
+{
+    // the last block of which the first key is at most key
+    uint32_t lo = 0, hi = ix->block_count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if(ix->block[mid] <= key) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    if(lo == 0) return 0;
+
+    uint32_t idx = (lo - 1) * DARM_NGRAM_BLOCK;
+    uint32_t end = idx + DARM_NGRAM_BLOCK < ix->key_count ?
+        idx + DARM_NGRAM_BLOCK : ix->key_count;
+
+    while (idx < end && ix->keys[idx] < key) {
+        idx++;
+    }
+    if(idx == end || ix->keys[idx] != key) return 0;
+
+    uint64_t off = ix->offsets[idx], stop = ix->offsets[idx + 1];
+    uint32_t count = 0, doc = 0;
+
+    while (off < stop) {
+        uint32_t value = 0, shift = 0;
+        while (off < stop && shift < 32) {
+            uint8_t byte = ix->postings[off++];
+            value |= (uint32_t)(byte & 0x7f) << shift;
+            shift += 7;
+            if((byte & 0x80) == 0) break;
+        }
+
+        doc = count == 0 ? value : doc + value;
+        if(count < max) {
+            docs[count] = doc;
+        }
+        count++;
+    }
+    return count;
+}
+
+const char *darm_ngram_doc(const darm_ngram_index_t *ix, uint32_t doc,
+    uint32_t *addr)
+{
+    if(doc >= ix->doc_count || ix->doc[doc].file >= ix->file_count ||
+            ix->names[ix->doc[doc].file] >= ix->strings_size) {
+        return NULL;
+    }
+
+    if(addr != NULL) {
+        *addr = ix->doc[doc].addr;
+    }
+    return &ix->strings[ix->names[ix->doc[doc].file]];
+}
+
+void darm_ngram_close(darm_ngram_index_t *ix)
+{
+    if(ix->map != NULL) {
+#ifndef _WIN32
+        munmap((void *) ix->map, ix->size);
+#else
+        free((void *) ix->map);
+#endif
+    }
+    memset(ix, 0, sizeof(darm_ngram_index_t));
+}
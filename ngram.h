@@ -0,0 +1,163 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef __NGRAM_H__
+#define __NGRAM_H__
+
+#include "darm.h"
+
+// normalized instruction of an undecodable word or halfword
+#define DARM_TOKEN_INVLD 0
+
+//
+// Normalizes an instruction into a 32-bit token, consisting of the
+// instruction and the kinds of its operands, i.e., which register operands
+// are present, whether there's an immediate, a shift, a register list, and
+// a condition. The actual registers and immediates are abstracted away, so
+// the same code compiled with a different register allocation or with
+// different constants has the same tokens.
+//
+uint32_t darm_ngram_token(const darm_t *d);
+
+//
+// Normalizes the instructions of a function that starts at address addr
+// (with the least significant bit set for Thumb) of which the code is
+// located in buf, i.e., buf[0] is at address addr. IT blocks are taken into
+// account, undecodable words (ARMv7) or halfwords (Thumb) are represented
+// by DARM_TOKEN_INVLD. Returns the amount of tokens, at most max.
+//
+uint32_t darm_ngram_tokens(const uint8_t *buf, uint32_t len, uint32_t addr,
+    uint32_t *tokens, uint32_t max);
+
+//
+// Hashes each sequence of n consecutive tokens into a 64-bit key, i.e.,
+// count - n + 1 keys are written to keys (none if count < n). Returns the
+// amount of keys.
+//
+uint32_t darm_ngram_keys(const uint32_t *tokens, uint32_t count, uint32_t n,
+    uint64_t *keys);
+
+typedef struct _darm_ngram_pair_t {
+    uint64_t        key;
+    uint32_t        doc;
+} darm_ngram_pair_t;
+
+typedef struct _darm_ngram_doc_t {
+    // index of the file and the address of the function
+    uint32_t        file;
+    uint32_t        addr;
+} darm_ngram_doc_t;
+
+// in-memory index that is being built
+typedef struct _darm_ngram_builder_t {
+    uint32_t        n;
+
+    darm_ngram_pair_t *pair;
+    uint32_t        pair_count;
+    uint32_t        pair_alloc;
+
+    darm_ngram_doc_t *doc;
+    uint32_t        doc_count;
+    uint32_t        doc_alloc;
+
+    char            **file;
+    uint32_t        file_count;
+    uint32_t        file_alloc;
+} darm_ngram_builder_t;
+
+void darm_ngram_builder_init(darm_ngram_builder_t *b, uint32_t n);
+
+// adds a file, returns its index or -1 on allocation failures
+int32_t darm_ngram_add_file(darm_ngram_builder_t *b, const char *name);
+
+// adds a function of a file and its keys, returns the index of the
+// function (the document) or -1 on allocation failures
+int32_t darm_ngram_add_doc(darm_ngram_builder_t *b, uint32_t file,
+    uint32_t addr, const uint64_t *keys, uint32_t count);
+
+// moves the files, functions, and keys of other into b, e.g., after
+// building parts of the index in separate threads; other is freed
+int darm_ngram_builder_merge(darm_ngram_builder_t *b,
+    darm_ngram_builder_t *other);
+
+//
+// Writes the index to fname. The file consists of a header, the first key
+// of each block of DARM_NGRAM_BLOCK keys, the sorted keys, the offsets of
+// their postings, the documents, the file names, and the postings, i.e.,
+// the ascending document indices of each key, delta-coded as LEB128.
+// Everything is in host byte order. The keys of b are consumed, its files
+// and functions are kept. Returns 0 on success, -1 on failure.
+//
+int darm_ngram_write(darm_ngram_builder_t *b, const char *fname);
+
+void darm_ngram_builder_free(darm_ngram_builder_t *b);
+
+#define DARM_NGRAM_BLOCK 64
+
+// memory-mapped index
+typedef struct _darm_ngram_index_t {
+    const uint8_t   *map;
+    uint64_t        size;
+
+    uint32_t        n;
+    uint32_t        key_count;
+    uint32_t        block_count;
+    uint32_t        doc_count;
+    uint32_t        file_count;
+
+    const uint64_t  *block;
+    const uint64_t  *keys;
+    const uint64_t  *offsets;
+    const uint8_t   *postings;
+    uint64_t        postings_size;
+    const darm_ngram_doc_t *doc;
+    const uint32_t  *names;
+    const char      *strings;
+    uint64_t        strings_size;
+} darm_ngram_index_t;
+
+// maps an index written by darm_ngram_write, returns 0 on success, -1 if
+// the file can't be mapped or isn't a valid index
+int darm_ngram_open(darm_ngram_index_t *ix, const char *fname);
+
+//
+// Looks up the documents that contain key, writes at most max document
+// indices in ascending order to docs. Returns the total amount of
+// documents, which may exceed max.
+//
+uint32_t darm_ngram_lookup(const darm_ngram_index_t *ix, uint64_t key,
+    uint32_t *docs, uint32_t max);
+
+// the file name and function address of a document, or NULL
+const char *darm_ngram_doc(const darm_ngram_index_t *ix, uint32_t doc,
+    uint32_t *addr);
+
+void darm_ngram_close(darm_ngram_index_t *ix);
+
+#endif
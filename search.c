@@ -0,0 +1,155 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include "darm.h"
+#include "search.h"
+#include "kernels.h"
+
+// amount of words that are matched at once
+#define CHUNK_SIZE 4096
+
+uint64_t darm_match_block(const uint32_t *words, uint32_t count,
+    uint32_t mask, uint32_t value)
+{
+    return darm_kernels()->match(words, count < 64 ? count : 64, mask, value);
+}
+
+static inline uint32_t _read16(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+// searches either the ARMv7 or the Thumb instructions of the image
+static uint32_t _search(const darm_pattern_t *patterns, uint32_t count,
+    const uint8_t *buf, uint32_t len, uint32_t base, uint32_t thumb,
+    darm_hit_t *hits, uint32_t max, uint32_t found)
+{
+    uint32_t words[CHUNK_SIZE], step = thumb ? 2 : 4;
+    int any = 0;
+
+    for (uint32_t pat = 0; pat < count; pat++) {
+        any |= (patterns[pat].isa != ISA_ARMV7) == thumb;
+    }
+
+    if(any == 0 || len < step) return found;
+
+    uint32_t total = (len - step) / step + 1;
+
+    for (uint32_t start = 0; start < total; start += CHUNK_SIZE) {
+        uint32_t n = total - start < CHUNK_SIZE ? total - start : CHUNK_SIZE;
+
+        // every instruction as a 32-bit word, for Thumb this is the
+        // halfword at each offset followed by the next one
+        for (uint32_t idx = 0; idx < n; idx++) {
+            const uint8_t *p = buf + (start + idx) * step;
+            if(thumb == 0) {
+                words[idx] = _read16(p) | (_read16(p + 2) << 16);
+            }
+            else {
+                uint32_t next = (start + idx) * 2 + 4 <= len ?
+                    _read16(p + 2) : 0;
+                words[idx] = (_read16(p) << 16) | next;
+            }
+        }
+
+        for (uint32_t idx = 0; idx < n; idx += 64) {
+            uint32_t block = n - idx < 64 ? n - idx : 64;
+            uint64_t bits = 0;
+
+            for (uint32_t pat = 0; pat < count; pat++) {
+                if((patterns[pat].isa != ISA_ARMV7) == thumb) {
+                    bits |= darm_match_block(&words[idx], block,
+                        patterns[pat].mask, patterns[pat].value);
+                }
+            }
+
+            for (; bits != 0; bits &= bits - 1) {
+                uint32_t off = idx + __builtin_ctzll(bits), w = words[off];
+                uint32_t addr = base + (start + off) * step, pat;
+
+                darm_t d; int ret;
+                if(thumb == 0) {
+                    ret = darm_disasm_inline(&d, w & 0xffff, w >> 16, addr);
+                }
+                else {
+                    // a thumb2 candidate in the last halfword runs past the
+                    // end of the buffer
+                    if((start + off) * 2 + darm_insn_length(w >> 16, 1) * 2 >
+                            len) {
+                        continue;
+                    }
+                    ret = darm_disasm_inline(&d, w >> 16, w & 0xffff,
+                        addr | 1);
+                }
+
+                if(ret == 0) continue;
+
+                // the pattern that matched with the size of the disassembled
+                // instruction, 16-bit Thumb instructions have a size of one,
+                // everything else a size of two; a pattern of the same
+                // instruction is preferred
+                uint32_t first = count;
+                for (pat = 0; pat < count; pat++) {
+                    const darm_pattern_t *p = &patterns[pat];
+                    if((p->isa != ISA_ARMV7) != thumb ||
+                            (w & p->mask) != p->value ||
+                            ret != (p->isa == ISA_THUMB ? 1 : 2)) {
+                        continue;
+                    }
+                    if(first == count) {
+                        first = pat;
+                    }
+                    if(p->instr == d.instr) break;
+                }
+
+                if(first == count) continue;
+                if(pat == count) pat = first;
+
+                if(found < max) {
+                    hits[found].addr = addr | thumb;
+                    hits[found].pattern = pat;
+                    hits[found].instr = d.instr;
+                }
+                found++;
+            }
+        }
+    }
+    return found;
+}
+
+uint32_t darm_search(const darm_pattern_t *patterns, uint32_t count,
+    const uint8_t *buf, uint32_t len, uint32_t base, darm_hit_t *hits,
+    uint32_t max)
+{
+    uint32_t found = _search(patterns, count, buf, len, base, 0,
+        hits, max, 0);
+    return _search(patterns, count, buf, len, base, 1, hits, max, found);
+}
@@ -0,0 +1,75 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef __SEARCH_H__
+#define __SEARCH_H__
+
+#include "darm.h"
+
+typedef struct _darm_hit_t {
+    // address of the instruction, with the least significant bit set for
+    // Thumb and Thumb2 instructions
+    uint32_t        addr;
+
+    // index of the first pattern that matched
+    uint32_t        pattern;
+
+    // the instruction as disassembled, which is not necessarily the
+    // instruction of the pattern, e.g., for aliases such as push and stmdb
+    darm_instr_t    instr;
+} darm_hit_t;
+
+//
+// One bit for each of the count (at most 64) words, set if the word matches
+// the pattern, i.e., if (words[idx] & mask) == value. Thumb instructions are
+// represented as a 32-bit word with the first halfword in the upper half.
+//
+uint64_t darm_match_block(const uint32_t *words, uint32_t count,
+    uint32_t mask, uint32_t value);
+
+//
+// Searches the image buf, mapped at address base, for instructions that
+// match any of the patterns, e.g., darm_patterns which contains one pattern
+// for each encoding, or patterns given by hand. ARMv7 patterns are matched
+// at every word, Thumb and Thumb2 patterns at every halfword. Every word is
+// matched against the patterns before anything is disassembled, candidates
+// are only reported if they disassemble to an instruction of the size of
+// the pattern. The disassembled instruction may differ from the instruction
+// of the pattern, e.g., for aliases or for ARMv7 encodings with condition
+// 0b1111, so callers that care should check the instr of the hit.
+//
+// At most max hits are written to hits, ARMv7 hits first and Thumb hits
+// after that, both ordered by address. Returns the total amount of hits,
+// which may exceed max.
+//
+uint32_t darm_search(const darm_pattern_t *patterns, uint32_t count,
+    const uint8_t *buf, uint32_t len, uint32_t base, darm_hit_t *hits,
+    uint32_t max);
+
+#endif
@@ -0,0 +1,250 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "darm.h"
+#include "cfg.h"
+#include "stack.h"
+
+int darm_sp_delta(const darm_t *d, int32_t *delta)
+{
+    darm_mem_t mem;
+
+    *delta = 0;
+
+    // a conditional change is only applied on one of the paths, unless it's
+    // a conditional return, e.g., popne {r4, pc}, which leaves the function
+    if(d->cond != C_AL && d->cond != C_UNCOND && (d->regs_written >> SP) & 1) {
+        return (d->regs_written >> PC) & 1 ? 0 : -1;
+    }
+
+    switch ((uint32_t) d->instr) {
+    case I_PUSH: case I_POP:
+        darm_mem(d, &mem);
+        *delta = (d->instr == I_PUSH ? -4 : 4) * mem.count;
+        return 0;
+
+    case I_ADD: case I_SUB: case I_ADDW: case I_SUBW:
+        if(d->Rd != SP) break;
+
+        // add sp, sp, #imm and sub sp, sp, #imm, and the thumb2 addw and
+        // subw for large frames
+        if(d->Rn == SP && d->I == B_SET) {
+            *delta = d->instr == I_ADD || d->instr == I_ADDW ?
+                (int32_t) d->imm : -(int32_t) d->imm;
+            return 0;
+        }
+        return -1;
+    }
+
+    if(darm_mem(d, &mem) == 0 && mem.base == SP && mem.writeback != 0) {
+        switch ((uint32_t) d->instr) {
+        case I_STMDB: case I_STMDA: case I_LDMDB: case I_LDMDA:
+            *delta = -4 * mem.count;
+            return 0;
+
+        case I_STM: case I_STMIB: case I_LDM: case I_LDMIB:
+            *delta = 4 * mem.count;
+            return 0;
+        }
+
+        // pre- and post-indexed, e.g., str lr, [sp, #-4]!
+        if(mem.offset_kind == M_IMM) {
+            *delta = mem.offset;
+            return 0;
+        }
+        return -1;
+    }
+
+    return (d->regs_written >> SP) & 1 ? -1 : 0;
+}
+
+int darm_stack_init(darm_stack_t *s, const uint8_t *buf, uint32_t len,
+    uint32_t base)
+{
+    memset(s, 0, sizeof(darm_stack_t));
+    s->buf = buf, s->len = len, s->base = base;
+
+    s->depth = malloc((len / 2 + 1) * sizeof(int32_t));
+    s->insns = malloc((s->insn_alloc = 256) * sizeof(uint32_t));
+    s->work = malloc((s->work_alloc = 256) * sizeof(uint32_t));
+
+    if(s->depth == NULL || s->insns == NULL || s->work == NULL) {
+        darm_stack_free(s);
+        return -1;
+    }
+
+    for (uint32_t idx = 0; idx < len / 2 + 1; idx++) {
+        s->depth[idx] = DARM_STACK_NONE;
+    }
+    return 0;
+}
+
+// records the depth before the instruction at halfword off, returns 1 if it
+// has not been reached before, 0 if it has, and -1 on allocation failures
+static int _stack_visit(darm_stack_t *s, uint32_t off, int32_t depth)
+{
+    // this path joins one that has been followed already
+    if(s->depth[off] != DARM_STACK_NONE) {
+        s->mismatch += s->depth[off] != depth;
+        return 0;
+    }
+
+    if(s->insn_count == s->insn_alloc) {
+        uint32_t *ptr = realloc(s->insns,
+            s->insn_alloc * 2 * sizeof(uint32_t));
+        if(ptr == NULL) return -1;
+
+        s->insns = ptr, s->insn_alloc *= 2;
+    }
+
+    s->depth[off] = depth;
+    s->insns[s->insn_count++] = off;
+    return 1;
+}
+
+// continues at addr with the given depth, returns -1 on allocation failures
+static int _stack_push(darm_stack_t *s, uint32_t addr, int32_t depth)
+{
+    uint32_t off = (addr & ~1) - s->base;
+
+    if((addr & ~1) < s->base || off >= s->len) return 0;
+
+    int ret = _stack_visit(s, off / 2, depth);
+    if(ret <= 0) return ret;
+
+    if(s->work_count == s->work_alloc) {
+        uint32_t *ptr = realloc(s->work,
+            s->work_alloc * 2 * sizeof(uint32_t));
+        if(ptr == NULL) return -1;
+
+        s->work = ptr, s->work_alloc *= 2;
+    }
+
+    s->work[s->work_count++] = addr;
+    return 0;
+}
+
+int32_t darm_stack_analyze(darm_stack_t *s, uint32_t func)
+{
+    darm_t d; darm_it_t it;
+
+    // forget about the previous function
+    for (uint32_t idx = 0; idx < s->insn_count; idx++) {
+        s->depth[s->insns[idx]] = DARM_STACK_NONE;
+    }
+
+    s->insn_count = s->work_count = 0;
+    s->max_depth = s->unknown = s->mismatch = 0;
+
+    if(_stack_push(s, func, 0) < 0) return -1;
+
+    while (s->work_count != 0) {
+        uint32_t addr = s->work[--s->work_count];
+        uint32_t thumb = addr & 1;
+
+        // branch targets are assumed to be outside of IT blocks
+        darm_it_init(&it);
+
+        // ARMv7 instructions have to be four-byte aligned
+        if(thumb == 0 && (addr & 3) != 0) continue;
+
+        for (addr &= ~1; addr - s->base < s->len; ) {
+            uint32_t off = addr - s->base;
+            int32_t depth = s->depth[off / 2], delta;
+
+            int ret = darm_disasm_buf(&d, s->buf + off, s->len - off,
+                addr | thumb);
+            if(ret == 0) break;
+
+            if(thumb != 0) {
+                darm_it_apply(&it, &d, ret);
+            }
+
+            if(darm_sp_delta(&d, &delta) < 0) {
+                s->unknown++;
+                break;
+            }
+
+            int32_t after = depth - delta;
+            if(after > (int32_t) s->max_depth) {
+                s->max_depth = after;
+            }
+
+            // follow branches, but not calls, within this function
+            uint32_t target; int target_is_thumb;
+            darm_flow_t flow = darm_flow(&d);
+
+            if(flow != F_CALL && darm_branch_target(&d, addr | thumb,
+                    &target, &target_is_thumb) == 0 &&
+                    _stack_push(s, target | target_is_thumb, after) < 0) {
+                return -1;
+            }
+
+            if(flow != F_NONE && flow != F_CALL && !darm_flow_is_cond(&d)) {
+                break;
+            }
+
+            // a conditional return, e.g., popne {r4, pc}, doesn't change
+            // the stack pointer when it falls through
+            if(flow == F_NONE || flow == F_CALL) {
+                depth = after;
+            }
+
+            addr += ret * 2;
+            if(addr - s->base >= s->len) break;
+
+            // continue the linear run, unless another path got here first
+            ret = _stack_visit(s, (addr - s->base) / 2, depth);
+            if(ret < 0) return -1;
+            if(ret == 0) break;
+        }
+    }
+
+    return s->max_depth;
+}
+
+int32_t darm_stack_depth(const darm_stack_t *s, uint32_t addr)
+{
+    uint32_t off = (addr & ~1) - s->base;
+    if((addr & ~1) < s->base || off >= s->len) return DARM_STACK_NONE;
+
+    return s->depth[off / 2];
+}
+
+void darm_stack_free(darm_stack_t *s)
+{
+    free(s->depth);
+    free(s->insns);
+    free(s->work);
+    memset(s, 0, sizeof(darm_stack_t));
+}
@@ -0,0 +1,105 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef __STACK_H__
+#define __STACK_H__
+
+#include "darm.h"
+
+// depth of instructions that have not been reached
+#define DARM_STACK_NONE INT32_MIN
+
+typedef struct _darm_stack_t {
+    // the image, mapped at address base
+    const uint8_t   *buf;
+    uint32_t        len;
+    uint32_t        base;
+
+    // one entry per halfword of the image, the amount of bytes that has been
+    // pushed onto the stack since the start of the function, right before
+    // the instruction at this address is executed
+    int32_t         *depth;
+
+    // halfword offsets of the instructions which have been reached in the
+    // last analyzed function
+    uint32_t        *insns;
+    uint32_t        insn_count;
+    uint32_t        insn_alloc;
+
+    // worklist of addresses which still have to be followed, with the
+    // least significant bit set for Thumb
+    uint32_t        *work;
+    uint32_t        work_count;
+    uint32_t        work_alloc;
+
+    // the maximum depth of the last analyzed function, the amount of
+    // instructions that modify the stack pointer by an unknown amount (e.g.,
+    // mov sp, r7), and the amount of paths that join with different depths
+    uint32_t        max_depth;
+    uint32_t        unknown;
+    uint32_t        mismatch;
+} darm_stack_t;
+
+//
+// Calculates the change of the stack pointer by instruction d in bytes, a
+// negative delta for PUSH and the like. Instructions that don't touch the
+// stack pointer have a delta of zero.
+//
+// Returns 0 on success, -1 if the stack pointer is modified by an unknown
+// amount, e.g., mov sp, r7 or add sp, sp, r0, or only conditionally, e.g.,
+// addne sp, sp, #8. A conditional return such as popne {r4, pc} has a
+// delta of zero, as it only changes the stack pointer when leaving.
+//
+int darm_sp_delta(const darm_t *d, int32_t *delta);
+
+int darm_stack_init(darm_stack_t *s, const uint8_t *buf, uint32_t len,
+    uint32_t base);
+
+//
+// Propagates the stack depth through the function starting at func (with
+// the least significant bit set for Thumb) along its fallthroughs and
+// direct branches, calls are assumed to leave the stack pointer as is.
+// Paths end at unconditional indirect branches, undecodable instructions,
+// and instructions that modify the stack pointer by an unknown amount.
+//
+// Afterwards the depth of each reached instruction is found in s->depth
+// and the maximum in s->max_depth; the results of the previous function
+// are discarded.
+//
+// Returns the maximum depth, or -1 on allocation failures.
+//
+int32_t darm_stack_analyze(darm_stack_t *s, uint32_t func);
+
+// the depth right before the instruction at addr in the last analyzed
+// function, or DARM_STACK_NONE if it has not been reached
+int32_t darm_stack_depth(const darm_stack_t *s, uint32_t addr);
+
+void darm_stack_free(darm_stack_t *s);
+
+#endif
@@ -0,0 +1,100 @@
+"""
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+Generates tests/corpus-arm.bin and tests/corpus-thumb.bin, a reproducible
+corpus of ARMv7 and Thumb/Thumb2 code for the profile-guided build (make pgo)
+and for utils/benchdarm. Every encoding of darmtbl.py and darmtbl2.py is
+instantiated with random operands, the instructions that dominate compiled
+code are weighted more heavily. Has to be run from the top directory.
+
+"""
+import random
+import struct
+import sys
+
+sys.path.insert(0, '.')
+import darmtbl
+import darmtbl2
+
+# amount of instructions per corpus
+COUNT = 0x10000
+
+# instructions which are, roughly, most common in compiled code
+common = {
+    'LDR': 8, 'STR': 6, 'MOV': 6, 'ADD': 5, 'SUB': 4, 'CMP': 4, 'B': 5,
+    'BL': 4, 'BX': 2, 'PUSH': 2, 'POP': 2, 'LDM': 1, 'STM': 1, 'AND': 1,
+    'ORR': 1, 'LSL': 1, 'LDRB': 2, 'STRB': 2,
+}
+
+
+def mnemonic(x):
+    return x.split('{')[0].split('<')[0].split()[0].split('.')[0]
+
+
+def instantiate(bits, rnd):
+    """Random instance of an encoding, most conditional ones execute AL."""
+    value = 0
+    for x in bits:
+        if isinstance(x, int):
+            value = (value << 1) | x
+        elif x is darmtbl.cond and rnd.random() < 0.9:
+            value = (value << 4) | 0b1110
+        else:
+            value = (value << x.bitsize) | rnd.getrandbits(x.bitsize)
+    return value
+
+
+def corpus(arr, rnd):
+    """Weighted random instructions of arr, with their bitsize."""
+    table = []
+    for description in arr:
+        bits = description[1:]
+        size = sum(1 if isinstance(x, int) else x.bitsize for x in bits)
+        weight = common.get(mnemonic(description[0]), 0) * 8 or 1
+        table += [(bits, size)] * weight
+
+    for _ in range(COUNT):
+        bits, size = rnd.choice(table)
+        yield instantiate(bits, rnd), size
+
+
+if __name__ == '__main__':
+    rnd = random.Random(0x4441524d)
+
+    with open('tests/corpus-arm.bin', 'wb') as f:
+        for value, _ in corpus(darmtbl.ARMv7, rnd):
+            f.write(struct.pack('<I', value))
+
+    # thumb2 instructions are stored as two halfwords, the first one being
+    # the upper half of the encoding
+    with open('tests/corpus-thumb.bin', 'wb') as f:
+        for value, size in corpus(darmtbl2.thumbs, rnd):
+            if size == 32:
+                f.write(struct.pack('<HH', value >> 16, value & 0xffff))
+            else:
+                f.write(struct.pack('<H', value))
@@ -3,6 +3,18 @@
 #include "../darm.h"
 #include "../darm-internal.h"
 #include "../thumb2.h"
+#include "../thumb2-tbl.h"
+#include "../cfg.h"
+#include "../descent.h"
+#include "../data.h"
+#include "../fold.h"
+#include "../jumptable.h"
+#include "../funcs.h"
+#include "../stack.h"
+#include "../search.h"
+#include "../gadget.h"
+#include "../ngram.h"
+#include "../valid.h"
 
 struct {
     uint32_t w;
@@ -336,7 +348,7 @@ struct {
     {0xbbbb, 0, "cbnz r3, #+110", {
         .instr = I_CBNZ, .instr_type = T_THUMB_CBZ, .cond = C_AL,
         .Rn = r3, .I = B_SET, .U = B_SET, .Rm = PC, .imm = 110}},
-    {0xbf34, 0, "", {
+    {0xbf34, 0, "ite cc", {
         .instr = I_IT, .instr_type = T_THUMB_IT_HINTS, .cond = C_AL,
         .firstcond = C_CC, .mask = 4}},
 
@@ -1509,6 +1521,1202 @@ static int test_thumb2_functions()
     return 0;
 }
 
+static int test_branch_targets()
+{
+    struct {
+        uint32_t w;
+        uint32_t pc;
+        int ret;
+        uint32_t target;
+        int target_is_thumb;
+    } branches[] = {
+        {0xeb00014e, 0x1000, 0, 0x1540, 0},   // bl #+1336
+        {0xeaffff00, 0x1000, 0, 0x0c08, 0},   // b #+-1024
+        {0xfb000000, 0x1000, 0, 0x100a, 1},   // blx #+2
+        {0xe12fff14, 0x1000, -1, 0, 0},       // bx r4
+        {0xdd02, 0x2001, 0, 0x2008, 1},       // ble #+4
+        {0xe7ff, 0x2001, 0, 0x2002, 1},       // b #+-2
+        {0xb132, 0x2001, 0, 0x2010, 1},       // cbz r2, #+12
+        {0x47b8, 0x2001, -1, 0, 0},           // blx r7
+        {0xf00fc78e, 0x3002 | 1, 0, 0xc0ff1c + 0x3004, 0},
+        {0xf1ead6df, 0x3001, 0, 0xdeadbe + 0x3004, 1},
+    };
+
+    darm_t d[ARRAYSIZE(branches)];
+    uint32_t pc[ARRAYSIZE(branches)], targets[ARRAYSIZE(branches)];
+    int8_t target_is_thumb[ARRAYSIZE(branches)];
+
+    for (uint32_t i = 0; i < ARRAYSIZE(branches); i++) {
+        uint32_t w = branches[i].w, target; int thumb;
+        uint16_t lo = w & 0xffff, hi = w >> 16;
+
+        // thumb2 instructions are given as first halfword : second halfword
+        pc[i] = branches[i].pc;
+        if((pc[i] & 1) != 0 && hi != 0) {
+            lo = w >> 16, hi = w & 0xffff;
+        }
+
+        if(darm_disasm(&d[i], lo, hi, pc[i]) == 0) {
+            printf("Disassembling branch 0x%08x failed\n", w);
+            return -1;
+        }
+
+        int ret = darm_branch_target(&d[i], pc[i], &target, &thumb);
+        if(ret != branches[i].ret || (ret == 0 &&
+                (target != branches[i].target ||
+                 thumb != branches[i].target_is_thumb))) {
+            printf("Branch target for 0x%08x failed: 0x%08x\n", w, target);
+            return -1;
+        }
+    }
+
+    if(darm_branch_targets(d, pc, ARRAYSIZE(branches), targets,
+            target_is_thumb) != 8 || target_is_thumb[3] != -1 ||
+            targets[8] != 0xc0ff1c + 0x3004) {
+        printf("Batched branch targets failed\n");
+        return -1;
+    }
+
+    printf("[x] passed branch target tests\n");
+    return 0;
+}
+
+static int test_regs()
+{
+    struct {
+        uint32_t w;
+        uint32_t addr;
+        uint16_t regs_read;
+        uint16_t regs_written;
+    } insns[] = {
+        {0xe4921004, 0, 0x0004, 0x0006},    // ldr r1, [r2], #4
+        {0xe0a10392, 0, 0x000f, 0x0003},    // umlal r0, r1, r2, r3
+        {0xeb00014e, 0, 0x8000, 0xc000},    // bl #+1336
+        {0xe12fff14, 0, 0x0010, 0x8000},    // bx r4
+        {0xe92d4010, 0, 0x6010, 0x2000},    // push {r4, lr}
+        {0xe1c020d0, 0, 0x0001, 0x000c},    // ldrd r2, r3, [r0]
+        {0xe3400000, 0, 0x0001, 0x0001},    // movt r0, #0
+        {0xb510, 1, 0x6010, 0x2000},        // push {r4, lr}
+        {0xbd10, 1, 0x2000, 0xa010},        // pop {r4, pc}
+        {0x4281, 1, 0x0003, 0x0000},        // cmp r1, r0
+        {0xc803, 1, 0x0001, 0x0003},        // ldm r0, {r0, r1}
+        {0xc10c, 1, 0x000e, 0x0002},        // stm r1!, {r2, r3}
+        {0xebb10f02, 1, 0x0006, 0x0000},    // cmp.w r1, r2
+        {0xe8dff000, 1, 0x8001, 0x8000},    // tbb [pc, r0]
+        {0xe8dff010, 1, 0x8001, 0x8000},    // tbh [pc, r0, lsl #1]
+        {0xb910, 1, 0x8001, 0x8000},        // cbnz r0, #+4
+    };
+
+    for (uint32_t i = 0; i < ARRAYSIZE(insns); i++) {
+        uint32_t w = insns[i].w; darm_t d;
+        uint16_t lo = w & 0xffff, hi = w >> 16;
+
+        // thumb2 instructions are given as first halfword : second halfword
+        if(insns[i].addr != 0 && hi != 0) {
+            lo = w >> 16, hi = w & 0xffff;
+        }
+
+        if(darm_disasm(&d, lo, hi, insns[i].addr) == 0 ||
+                d.regs_read != insns[i].regs_read ||
+                d.regs_written != insns[i].regs_written) {
+            printf("Register masks for 0x%08x failed: 0x%04x 0x%04x\n",
+                w, d.regs_read, d.regs_written);
+            return -1;
+        }
+    }
+
+    printf("[x] passed register mask tests\n");
+    return 0;
+}
+
+static int test_semantics()
+{
+    struct {
+        uint32_t w;
+        uint32_t addr;
+        uint32_t flags_read;
+        uint32_t flags_written;
+    } flags[] = {
+        {0xe0910002, 0, 0, APSR_NZCV},          // adds r0, r1, r2
+        {0x00a10002, 0, APSR_Z | APSR_C, 0},    // adceq r0, r1, r2
+        {0xe1510002, 0, 0, APSR_NZCV},          // cmp r1, r2
+        {0xe0100291, 0, 0, APSR_N | APSR_Z},    // muls r0, r1, r2
+        {0x2001, 1, 0, APSR_N | APSR_Z | APSR_C},   // movs r0, #1
+        {0xd002, 1, APSR_Z, 0},                 // beq #+4
+    };
+
+    for (uint32_t i = 0; i < ARRAYSIZE(flags); i++) {
+        darm_t d; uint32_t w = flags[i].w;
+        if(darm_disasm(&d, w & 0xffff, w >> 16, flags[i].addr) == 0 ||
+                darm_flags_read(&d) != flags[i].flags_read ||
+                darm_flags_written(&d) != flags[i].flags_written) {
+            printf("Flags for 0x%08x failed: %d %d\n", w,
+                darm_flags_read(&d), darm_flags_written(&d));
+            return -1;
+        }
+    }
+
+    // static, so the padding is zeroed for the memcmp
+    static const struct {
+        uint32_t w;
+        uint32_t addr;
+        int ret;
+        darm_mem_t mem;
+    } mems[] = {
+        // ldr r1, [r2], #4
+        {0xe4921004, 0, 0, {.base = r2, .offset_kind = M_IMM, .offset = 4,
+            .index = R_INVLD, .shift_type = S_INVLD, .size = 4, .count = 1,
+            .load = 1, .writeback = 1, .post_index = 1}},
+        // ldrh r1, [r0, #-2]
+        {0xe15010b2, 0, 0, {.base = r0, .offset_kind = M_IMM, .offset = -2,
+            .index = R_INVLD, .shift_type = S_INVLD, .size = 2, .count = 1,
+            .load = 1}},
+        // strd r2, r3, [r0, r1]
+        {0xe18020f1, 0, 0, {.base = r0, .offset_kind = M_REG, .index = r1,
+            .shift_type = S_INVLD, .size = 4, .count = 2, .store = 1}},
+        // push {r4, lr}
+        {0xb510, 1, 0, {.base = SP, .offset_kind = M_NONE, .index = R_INVLD,
+            .shift_type = S_INVLD, .size = 4, .count = 2, .store = 1,
+            .writeback = 1}},
+        // ldr r0, [pc, #8]
+        {0x4802, 1, 0, {.base = PC, .offset_kind = M_IMM, .offset = 8,
+            .index = R_INVLD, .shift_type = S_INVLD, .size = 4, .count = 1,
+            .load = 1}},
+        // add r0, r1, r2
+        {0xe0810002, 0, -1, {0}},
+    };
+
+    for (uint32_t i = 0; i < ARRAYSIZE(mems); i++) {
+        darm_t d; darm_mem_t mem; uint32_t w = mems[i].w;
+        if(darm_disasm(&d, w & 0xffff, w >> 16, mems[i].addr) == 0 ||
+                darm_mem(&d, &mem) != mems[i].ret || (mems[i].ret == 0 &&
+                memcmp(&mem, &mems[i].mem, sizeof(darm_mem_t)) != 0)) {
+            printf("Memory access for 0x%08x failed\n", w);
+            return -1;
+        }
+    }
+
+    printf("[x] passed instruction semantics tests\n");
+    return 0;
+}
+
+static int test_it()
+{
+    struct {
+        uint16_t w;
+        darm_cond_t cond;
+        const char *s;
+    } insns[] = {
+        {0xbf1a, C_AL, "itte ne"},
+        {0x2001, C_NE, "movne r0, #1"},
+        {0x2002, C_NE, "movne r0, #2"},
+        {0x2003, C_EQ, "moveq r0, #3"},
+        {0x2004, C_AL, "mov r0, #4"},
+        {0xbf08, C_AL, "it eq"},
+        {0x4770, C_EQ, "bxeq lr"},
+        {0x4770, C_AL, "bx lr"},
+    };
+
+    darm_it_t it; darm_t d; darm_str_t str;
+    darm_it_init(&it);
+
+    for (uint32_t i = 0; i < ARRAYSIZE(insns); i++) {
+        if(darm_disasm_it(&it, &d, insns[i].w, 0, 1) != 1 ||
+                d.cond != insns[i].cond || darm_str2(&d, &str, 1) < 0 ||
+                strcmp(str.total, insns[i].s) != 0) {
+            printf("IT block test %d failed: %s\n", i, str.total);
+            return -1;
+        }
+    }
+
+    // 16-bit instructions inside an IT block don't update the flags
+    darm_disasm_it(&it, &d, 0xbf08, 0, 1);
+    darm_disasm_it(&it, &d, 0x2001, 0, 1);
+    if(darm_flags_written(&d) != 0 || darm_flags_read(&d) != APSR_Z) {
+        printf("IT block flags test failed\n");
+        return -1;
+    }
+
+    printf("[x] passed IT block tests\n");
+    return 0;
+}
+
+static int test_cfg()
+{
+    // push {lr}; cmp r0, #0; beq 0x100a; movs r0, #1; b 0x100c;
+    // movs r0, #2; pop {pc}
+    static const uint8_t code[] = {
+        0x00, 0xb5, 0x00, 0x28, 0x01, 0xd0, 0x01, 0x20,
+        0x00, 0xe0, 0x02, 0x20, 0x00, 0xbd,
+    };
+
+    static const uint32_t blocks[] = {0x1001, 0x1007, 0x100b, 0x100d};
+    static const uint32_t edges[] = {0, 2, 3, 4, 4};
+    static const uint32_t targets[] = {2, 1, 3, 3};
+
+    darm_cfg_t cfg;
+    if(darm_cfg_build(&cfg, code, sizeof(code), 0x1000, 0x1001,
+            0x1000 + sizeof(code)) < 0) {
+        printf("Building the control flow graph failed\n");
+        return -1;
+    }
+
+    int ret = cfg.block_count != ARRAYSIZE(blocks) ||
+        cfg.edge_count != ARRAYSIZE(targets);
+
+    for (uint32_t i = 0; ret == 0 && i < ARRAYSIZE(blocks); i++) {
+        ret = cfg.block_addr[i] != blocks[i] || cfg.edge_index[i] != edges[i];
+    }
+
+    for (uint32_t i = 0; ret == 0 && i < ARRAYSIZE(targets); i++) {
+        ret = cfg.edge_target[i] != targets[i];
+    }
+
+    darm_cfg_free(&cfg);
+
+    if(ret != 0) {
+        printf("Control flow graph mismatch\n");
+        return -1;
+    }
+
+    // ldr r1, [pc, #0]; bne 0x1008; .word 0x12345678; movs r0, #1; bx lr,
+    // the bne doesn't fall through into the literal pool
+    static const uint8_t pool[] = {
+        0x00, 0x49, 0x01, 0xd1, 0x78, 0x56, 0x34, 0x12,
+        0x01, 0x20, 0x70, 0x47,
+    };
+
+    if(darm_cfg_build(&cfg, pool, sizeof(pool), 0x1000, 0x1001,
+            0x1000 + sizeof(pool)) < 0) {
+        printf("Building the control flow graph failed\n");
+        return -1;
+    }
+
+    ret = cfg.block_count != 2 || cfg.block_addr[1] != 0x1009 ||
+        cfg.edge_index[1] != 1 || cfg.edge_type[0] != E_BRANCH ||
+        cfg.edge_target[0] != 1;
+    darm_cfg_free(&cfg);
+
+    if(ret != 0) {
+        printf("Control flow graph falls through a literal pool\n");
+        return -1;
+    }
+
+    printf("[x] passed control flow graph tests\n");
+    return 0;
+}
+
+static int test_descent()
+{
+    // blx 0x100c; bx lr; .word 0x12345678; movs r0, #1; bx lr
+    static const uint8_t code[] = {
+        0x01, 0x00, 0x00, 0xfa, 0x1e, 0xff, 0x2f, 0xe1,
+        0x78, 0x56, 0x34, 0x12, 0x01, 0x20, 0x70, 0x47,
+    };
+
+    darm_rd_t rd;
+    if(darm_rd_init(&rd, code, sizeof(code), 0x1000) < 0 ||
+            darm_rd_seed(&rd, 0x1000) < 0 || darm_rd_run(&rd) != 4) {
+        printf("Recursive descent failed\n");
+        return -1;
+    }
+
+    int ret = darm_rd_visited(&rd, 0x1004) != 1 ||
+        darm_rd_visited(&rd, 0x1008) != 0 ||
+        darm_rd_visited(&rd, 0x100e) != 2;
+    darm_rd_free(&rd);
+
+    if(ret != 0) {
+        printf("Recursive descent visited the wrong instructions\n");
+        return -1;
+    }
+
+    printf("[x] passed recursive descent tests\n");
+    return 0;
+}
+
+static int test_data()
+{
+    // cmp r0, #3; bhi 0x200c; tbb [pc, r0]; .byte 2, 3, 4, 5; bx lr (4x)
+    static const uint8_t table[] = {
+        0x03, 0x28, 0x03, 0xd8, 0xdf, 0xe8, 0x00, 0xf0,
+        0x02, 0x03, 0x04, 0x05, 0x70, 0x47, 0x70, 0x47,
+        0x70, 0x47, 0x70, 0x47,
+    };
+
+    darm_data_t data; darm_t d;
+    if(darm_data_init(&data, 0x2000, sizeof(table)) < 0) {
+        printf("Data initialization failed\n");
+        return -1;
+    }
+
+    for (uint32_t off = 0; off < 8; ) {
+        int ret = darm_disasm_buf(&d, table + off, sizeof(table) - off,
+            (0x2000 + off) | 1);
+        darm_data_mark(&data, &d, (0x2000 + off) | 1);
+        off += ret != 0 ? ret * 2 : 2;
+    }
+
+    int ret = darm_data_get(&data, 0x2006) != 0 ||
+        darm_data_get(&data, 0x2008) != 1 ||
+        darm_data_get(&data, 0x200a) != 1 ||
+        darm_data_get(&data, 0x200c) != 0;
+    darm_data_free(&data);
+
+    if(ret != 0) {
+        printf("Jump table has not been marked as data\n");
+        return -1;
+    }
+
+    // cmp r0, #3; ldr r0, [pc, #16]; tbb [pc, r0], the load overwrites the
+    // bounds checked register so the table size is unknown
+    static const uint16_t reload[][2] = {
+        {0x2803, 0}, {0x4804, 0}, {0xe8df, 0xf000},
+    };
+
+    if(darm_data_init(&data, 0x3000, 0x20) < 0) {
+        printf("Data initialization failed\n");
+        return -1;
+    }
+
+    for (uint32_t idx = 0; idx < ARRAYSIZE(reload); idx++) {
+        uint32_t addr = (0x3000 + idx * 2) | 1;
+        darm_disasm(&d, reload[idx][0], reload[idx][1], addr);
+        darm_data_mark(&data, &d, addr);
+    }
+
+    ret = darm_data_get(&data, 0x3008) != 0 ||
+        darm_data_get(&data, 0x3014) != 1;
+    darm_data_free(&data);
+
+    if(ret != 0) {
+        printf("Jump table bounded by an overwritten register\n");
+        return -1;
+    }
+
+    // cmp.w r0, #0x40000000; tbb [pc, r0], a bogus bounds check, and data
+    // that runs up to the end of the address space
+    if(darm_data_init(&data, 0xfffff000, 0x1000) < 0) {
+        printf("Data initialization failed\n");
+        return -1;
+    }
+
+    darm_disasm(&d, 0xf1b0, 0x4f80, 0xfffff001);
+    darm_data_mark(&data, &d, 0xfffff001);
+    darm_disasm(&d, 0xe8df, 0xf000, 0xfffff005);
+
+    ret = darm_data_mark(&data, &d, 0xfffff005) != 0 ||
+        darm_data_set(&data, 0xffffffe0, 0x40) != 1 ||
+        darm_data_get(&data, 0xffffffde) != 0 ||
+        darm_data_get(&data, 0xfffffffe) != 1;
+    darm_data_free(&data);
+
+    if(ret != 0) {
+        printf("Data near the end of the address space\n");
+        return -1;
+    }
+
+    // ldr r0, [pc, #0]; bx lr; .word 0xdeadbeef; movs r0, #1; bx lr
+    static const uint8_t code[] = {
+        0x00, 0x48, 0x70, 0x47, 0xef, 0xbe, 0xad, 0xde,
+        0x01, 0x20, 0x70, 0x47,
+    };
+
+    darm_cfg_t cfg;
+    if(darm_cfg_build(&cfg, code, sizeof(code), 0x1000, 0x1001,
+            0x1000 + sizeof(code)) < 0) {
+        printf("Building the control flow graph failed\n");
+        return -1;
+    }
+
+    ret = cfg.block_count != 2 || cfg.block_addr[0] != 0x1001 ||
+        cfg.block_size[0] != 4 || cfg.block_addr[1] != 0x1009 ||
+        cfg.block_size[1] != 4;
+    darm_cfg_free(&cfg);
+
+    if(ret != 0) {
+        printf("Literal pool has not been skipped\n");
+        return -1;
+    }
+
+    printf("[x] passed literal pool and jump table tests\n");
+    return 0;
+}
+
+static int test_fold()
+{
+    struct {
+        uint32_t w;
+        int ret;
+        darm_reg_t reg;
+        uint32_t value;
+    } insns[] = {
+        {0xe3010234, 0, 0, 0},              // movw r0, #0x1234
+        {0xe3051678, 0, 0, 0},              // movw r1, #0x5678
+        {0xe2811001, 0, 0, 0},              // add r1, r1, #1
+        {0xe3400abc, 1, r0, 0x0abc1234},    // movt r0, #0xabc
+        {0xe3401abc, 0, 0, 0},              // movt r1, #0xabc
+        {0xe3014234, 0, 0, 0},              // movw r4, #0x1234
+        {0xe3012234, 0, 0, 0},              // movw r2, #0x1234
+        {0xeb00014e, 0, 0, 0},              // bl #+1336
+        {0xe3442321, 0, 0, 0},              // movt r2, #0x4321
+        {0xe3444321, 1, r4, 0x43211234},    // movt r4, #0x4321
+    };
+
+    darm_fold_t fold; darm_fold_init(&fold, 0);
+
+    for (uint32_t i = 0; i < ARRAYSIZE(insns); i++) {
+        darm_t d; darm_const_t c; uint32_t w = insns[i].w;
+        if(darm_armv7_disasm(&d, w) < 0) {
+            printf("Disassembling 0x%08x failed\n", w);
+            return -1;
+        }
+
+        int ret = darm_fold_step(&fold, &d, 0x1000 + i * 4, &c);
+        if(ret != insns[i].ret || (ret == 1 && (c.reg != insns[i].reg ||
+                c.value != insns[i].value || c.addr != 0x1000 + i * 4))) {
+            printf("Folding 0x%08x failed\n", w);
+            return -1;
+        }
+    }
+
+    printf("[x] passed movw/movt folding tests\n");
+    return 0;
+}
+
+static int test_jumptable()
+{
+    // cmp r0, #3; bhi 0x200c; tbb [pc, r0]; .byte 2, 3, 4, 5; bx lr (4x)
+    static const uint8_t thumb[] = {
+        0x03, 0x28, 0x03, 0xd8, 0xdf, 0xe8, 0x00, 0xf0,
+        0x02, 0x03, 0x04, 0x05, 0x70, 0x47, 0x70, 0x47,
+        0x70, 0x47, 0x70, 0x47,
+    };
+
+    // cmp r0, #1; ldrls pc, [pc, r0, lsl #2]; b 0x1014;
+    // .word 0x1014, 0x1018; bx lr (2x)
+    static const uint8_t arm[] = {
+        0x01, 0x00, 0x50, 0xe3, 0x00, 0xf1, 0x9f, 0x97,
+        0x01, 0x00, 0x00, 0xea, 0x14, 0x10, 0x00, 0x00,
+        0x18, 0x10, 0x00, 0x00, 0x1e, 0xff, 0x2f, 0xe1,
+        0x1e, 0xff, 0x2f, 0xe1,
+    };
+
+    static const struct {
+        const uint8_t *buf;
+        uint32_t len;
+        uint32_t start;
+        uint32_t dispatch;
+        uint32_t count;
+        uint32_t targets[4];
+    } tables[] = {
+        {thumb, sizeof(thumb), 0x2001, 0x2005, 4,
+            {0x200d, 0x200f, 0x2011, 0x2013}},
+        {arm, sizeof(arm), 0x1000, 0x1004, 2, {0x1014, 0x1018}},
+    };
+
+    for (uint32_t idx = 0; idx < ARRAYSIZE(tables); idx++) {
+        uint32_t targets[4], count = 0, base = tables[idx].start & ~1;
+        darm_jt_t jt; darm_t d;
+
+        darm_jt_init(&jt, tables[idx].buf, tables[idx].len, base);
+
+        for (uint32_t addr = tables[idx].start;
+                addr <= tables[idx].dispatch; ) {
+            uint32_t off = (addr & ~1) - base;
+            int ret = darm_disasm_buf(&d, tables[idx].buf + off,
+                tables[idx].len - off, addr);
+            count = darm_jt_step(&jt, &d, addr, targets, 4);
+            addr += ret != 0 ? ret * 2 : 2;
+        }
+
+        if(count != tables[idx].count || memcmp(targets,
+                tables[idx].targets, count * sizeof(uint32_t)) != 0) {
+            printf("Switch at 0x%08x has not been resolved\n",
+                tables[idx].dispatch);
+            return -1;
+        }
+    }
+
+    // cmp r0, #0x40000000; ldrls pc, [pc, r0, lsl #2], the end of the
+    // table would wrap around to its start
+    static const uint32_t huge[] = {0xe3500101, 0x979ff100};
+    darm_jt_t jt; darm_t d; uint32_t targets[4], count = 0;
+
+    darm_jt_init(&jt, arm, sizeof(arm), 0x1000);
+    for (uint32_t idx = 0; idx < ARRAYSIZE(huge); idx++) {
+        darm_armv7_disasm(&d, huge[idx]);
+        count = darm_jt_step(&jt, &d, 0x1000 + idx * 4, targets, 4);
+    }
+
+    if(count != 0) {
+        printf("Switch with a huge bounds check has been resolved\n");
+        return -1;
+    }
+
+    // the address table is data, and each case starts a basic block
+    darm_cfg_t cfg;
+    if(darm_cfg_build(&cfg, arm, sizeof(arm), 0x1000, 0x1000,
+            0x1000 + sizeof(arm)) < 0) {
+        printf("Building the control flow graph failed\n");
+        return -1;
+    }
+
+    int ret = cfg.block_count != 4 || cfg.block_addr[1] != 0x1008 ||
+        cfg.block_addr[2] != 0x1014 || cfg.block_addr[3] != 0x1018 ||
+        cfg.edge_index[1] - cfg.edge_index[0] != 3 ||
+        cfg.edge_type[cfg.edge_index[0]] != E_CASE ||
+        cfg.edge_target[cfg.edge_index[0]] != 2 ||
+        cfg.edge_target[cfg.edge_index[0] + 1] != 3 ||
+        cfg.edge_type[cfg.edge_index[0] + 2] != E_FALLTHROUGH;
+    darm_cfg_free(&cfg);
+
+    if(ret != 0) {
+        printf("Switch cases have not been added to the graph\n");
+        return -1;
+    }
+
+    printf("[x] passed jump table tests\n");
+    return 0;
+}
+
+static int test_funcs()
+{
+    // push {r4, lr}; sub sp, #8; bx lr; push.w {r4-r11, lr};
+    // sub.w sp, sp, #0x100; bx lr; sub sp, #4; bx lr
+    static const uint8_t thumb[] = {
+        0x10, 0xb5, 0x82, 0xb0, 0x70, 0x47, 0x2d, 0xe9,
+        0xf0, 0x4f, 0xad, 0xf5, 0x80, 0x7d, 0x70, 0x47,
+        0x81, 0xb0, 0x70, 0x47,
+    };
+
+    // push {r4, lr}; sub sp, sp, #8; bx lr; str lr, [sp, #-4]!; bx lr;
+    // sub sp, sp, #4
+    static const uint8_t arm[] = {
+        0x10, 0x40, 0x2d, 0xe9, 0x08, 0xd0, 0x4d, 0xe2,
+        0x1e, 0xff, 0x2f, 0xe1, 0x04, 0xe0, 0x2d, 0xe5,
+        0x1e, 0xff, 0x2f, 0xe1, 0x04, 0xd0, 0x4d, 0xe2,
+    };
+
+    // two entries at 0x3000, for 0x1000 (cantunwind) and 0x2020 (inline)
+    static const uint8_t exidx[] = {
+        0x00, 0xe0, 0xff, 0x7f, 0x01, 0x00, 0x00, 0x00,
+        0x18, 0xf0, 0xff, 0x7f, 0xb0, 0xb0, 0xb0, 0x80,
+    };
+
+    // push {r4-r7, lr}; add r7, sp, #12; sub sp, sp, #8; bx lr
+    static const uint8_t frame_arm[] = {
+        0xf0, 0x40, 0x2d, 0xe9, 0x0c, 0x70, 0x8d, 0xe2,
+        0x08, 0xd0, 0x4d, 0xe2, 0x1e, 0xff, 0x2f, 0xe1,
+    };
+
+    // push {r4-r7, lr}; add r7, sp, #12; str.w r8, [sp, #-4]!; sub sp, #8;
+    // bx lr
+    static const uint8_t frame_thumb[] = {
+        0xf0, 0xb5, 0x03, 0xaf, 0x4d, 0xf8, 0x04, 0x8d,
+        0x82, 0xb0, 0x70, 0x47,
+    };
+
+    static const uint32_t starts[] = {
+        0x1001, 0x1007, 0x1011, 0x2000, 0x200c, 0x2014, 0x2020, 0x4000,
+        0x5001,
+    };
+
+    darm_funcs_t f; darm_funcs_init(&f);
+
+    int ret = darm_funcs_scan(&f, thumb, sizeof(thumb), 0x1001) < 0 ||
+        darm_funcs_scan(&f, arm, sizeof(arm), 0x2000) < 0 ||
+        darm_funcs_scan(&f, frame_arm, sizeof(frame_arm), 0x4000) < 0 ||
+        darm_funcs_scan(&f, frame_thumb, sizeof(frame_thumb), 0x5001) < 0 ||
+        darm_funcs_exidx(&f, exidx, sizeof(exidx), 0x3000) < 0;
+
+    darm_funcs_sort(&f);
+
+    ret = ret != 0 || f.count != ARRAYSIZE(starts) ||
+        memcmp(f.start, starts, sizeof(starts)) != 0;
+    darm_funcs_free(&f);
+
+    if(ret != 0) {
+        printf("Function starts have not been found\n");
+        return -1;
+    }
+
+    printf("[x] passed function discovery tests\n");
+    return 0;
+}
+
+static int test_stack()
+{
+    struct {
+        uint32_t w;
+        int ret;
+        int32_t delta;
+    } insns[] = {
+        {0xe92d4ff0, 0, -36},           // push {r4-r11, lr}
+        {0xe8bd8010, 0, 8},             // pop {r4, pc}
+        {0xe52de004, 0, -4},            // push {lr}
+        {0xe24dd008, 0, -8},            // sub sp, sp, #8
+        {0xe28dd010, 0, 16},            // add sp, sp, #16
+        {0xe16d40f8, 0, -8},            // strd r4, r5, [sp, #-8]!
+        {0xe59d0004, 0, 0},             // ldr r0, [sp, #4]
+        {0xe1a0d007, -1, 0},            // mov sp, r7
+        {0xe08dd000, -1, 0},            // add sp, sp, r0
+        {0x128dd008, -1, 0},            // addne sp, sp, #8
+        {0x18bd8010, 0, 0},             // popne {r4, pc}
+    };
+
+    for (uint32_t idx = 0; idx < ARRAYSIZE(insns); idx++) {
+        darm_t d; int32_t delta;
+
+        if(darm_armv7_disasm(&d, insns[idx].w) < 0 ||
+                darm_sp_delta(&d, &delta) != insns[idx].ret ||
+                delta != insns[idx].delta) {
+            printf("Invalid stack pointer delta for 0x%08x\n",
+                insns[idx].w);
+            return -1;
+        }
+    }
+
+    // it eq; popeq {r4}, predicated by the IT block
+    darm_t d; darm_it_t it; int32_t delta;
+    darm_it_init(&it);
+    darm_disasm(&d, 0xbf08, 0, 1);
+    darm_it_apply(&it, &d, 1);
+    darm_disasm(&d, 0xbc10, 0, 3);
+    darm_it_apply(&it, &d, 1);
+
+    if(d.cond != C_EQ || darm_sp_delta(&d, &delta) != -1) {
+        printf("Invalid stack pointer delta inside an IT block\n");
+        return -1;
+    }
+
+    // subw sp, sp, #256 and addw sp, sp, #256 (thumb2)
+    static const uint16_t wide[][2] = {
+        {0xf2ad, 0x1d00}, {0xf20d, 0x1d00},
+    };
+
+    for (uint32_t idx = 0; idx < ARRAYSIZE(wide); idx++) {
+        darm_t d; int32_t delta;
+
+        if(darm_thumb2_disasm(&d, wide[idx][0], wide[idx][1]) < 0 ||
+                darm_sp_delta(&d, &delta) != 0 ||
+                delta != (idx == 0 ? -256 : 256)) {
+            printf("Invalid stack pointer delta for 0x%04x%04x\n",
+                wide[idx][0], wide[idx][1]);
+            return -1;
+        }
+    }
+
+    // push {r4, lr}; sub sp, #8; cbz r0, 0x100c; sub sp, #16;
+    // add sp, #16; nop; add sp, #8; pop {r4, pc}
+    static const uint8_t code[] = {
+        0x10, 0xb5, 0x82, 0xb0, 0x10, 0xb1, 0x84, 0xb0,
+        0x04, 0xb0, 0x00, 0xbf, 0x02, 0xb0, 0x10, 0xbd,
+    };
+
+    darm_stack_t s;
+    if(darm_stack_init(&s, code, sizeof(code), 0x1000) < 0) {
+        printf("Stack analysis initialization failed\n");
+        return -1;
+    }
+
+    int ret = darm_stack_analyze(&s, 0x1001) != 32 ||
+        s.unknown != 0 || s.mismatch != 0 || s.insn_count != 8 ||
+        darm_stack_depth(&s, 0x1006) != 16 ||
+        darm_stack_depth(&s, 0x100c) != 16 ||
+        darm_stack_depth(&s, 0x100e) != 8;
+    darm_stack_free(&s);
+
+    if(ret != 0) {
+        printf("Invalid stack depth\n");
+        return -1;
+    }
+
+    printf("[x] passed stack depth tests\n");
+    return 0;
+}
+
+static int test_batch()
+{
+    static const struct {
+        uint32_t w;
+        darm_class_t cls;
+    } classes[] = {
+        {0xe0810002, DC_DATA},          // add r0, r1, r2
+        {0xe3a00001, DC_DATA},          // mov r0, #1
+        {0xe0000291, DC_MUL},           // mul r0, r1, r2
+        {0xe1c040d0, DC_MUL},           // ldrd r4, r5, [r0]
+        {0xe5910004, DC_LDST},          // ldr r0, [r1, #4]
+        {0xe6ef0070, DC_MEDIA},         // uxtb r0, r0
+        {0xe92d4010, DC_BLOCK},         // push {r4, lr}
+        {0xeafffffe, DC_BRANCH},        // b #-8
+        {0xef000000, DC_COPROC},        // svc #0
+        {0xf57ff04f, DC_UNCOND},        // dsb sy
+    };
+
+    for (uint32_t idx = 0; idx < ARRAYSIZE(classes); idx++) {
+        uint8_t cls;
+        darm_armv7_classify(&classes[idx].w, 1, &cls);
+        if(cls != classes[idx].cls) {
+            printf("Invalid class for 0x%08x\n", classes[idx].w);
+            return -1;
+        }
+    }
+
+    // the batched disassembler has to give the exact same results as
+    // disassembling each instruction by itself
+    static uint32_t w[1000]; static darm_t d[1000];
+    uint32_t seed = 0x12345678, ok = 0;
+
+    for (uint32_t idx = 0; idx < ARRAYSIZE(w); idx++) {
+        seed = seed * 1103515245 + 12345;
+        w[idx] = seed ^ (seed << 13);
+    }
+
+    if(darm_armv7_disasm_batch(d, w, ARRAYSIZE(w)) == 0) {
+        printf("Batched disassembling failed\n");
+        return -1;
+    }
+
+    for (uint32_t idx = 0; idx < ARRAYSIZE(w); idx++) {
+        darm_t single;
+        if(darm_armv7_disasm(&single, w[idx]) < 0) {
+            darm_init(&single);
+            single.w = w[idx];
+        }
+        else {
+            ok++;
+        }
+
+        if(memcmp(&single, &d[idx], sizeof(darm_t)) != 0) {
+            printf("Batched disassembling of 0x%08x differs\n", w[idx]);
+            return -1;
+        }
+    }
+
+    if(darm_armv7_disasm_batch(d, w, ARRAYSIZE(w)) != ok) {
+        printf("Invalid amount of disassembled instructions\n");
+        return -1;
+    }
+
+    printf("[x] passed batched disassembling tests\n");
+    return 0;
+}
+
+static int test_boundaries()
+{
+    // bx lr; bl; push.w {..} with a second half that looks like a prefix;
+    // push.w {r4, lr}; nop
+    static const uint8_t code[] = {
+        0x70, 0x47, 0x00, 0xf0, 0x00, 0xf8, 0x2d, 0xe9,
+        0x2d, 0xe9, 0x2d, 0xe9, 0x10, 0x40, 0x00, 0xbf,
+    };
+    static const uint32_t offsets[] = {0, 2, 6, 10, 14};
+
+    uint32_t starts[200];
+    if(darm_thumb_starts(code, sizeof(code), starts) != ARRAYSIZE(offsets) ||
+            memcmp(starts, offsets, sizeof(offsets)) != 0) {
+        printf("Invalid Thumb instruction boundaries\n");
+        return -1;
+    }
+
+    // a run of prefixes crossing a block of 64 halfwords, after an odd
+    // amount of 16-bit instructions
+    static uint8_t run[2 * 200];
+    for (uint32_t idx = 0; idx < 200; idx++) {
+        run[idx * 2] = 0x00, run[idx * 2 + 1] = idx < 3 ? 0xbf : 0xf0;
+    }
+
+    uint64_t bitmap[4];
+    darm_thumb_bitmap(run, sizeof(run), bitmap);
+
+    uint32_t count = darm_thumb_starts(run, sizeof(run), starts);
+    if(count != 3 + 197 / 2 + 1 || starts[3] != 6 || starts[4] != 10 ||
+            starts[count - 1] != 2 * 199 ||
+            bitmap[1] != 0xaaaaaaaaaaaaaaaaULL) {
+        printf("Invalid Thumb instruction boundaries across blocks\n");
+        return -1;
+    }
+
+    printf("[x] passed thumb instruction boundary tests\n");
+    return 0;
+}
+
+static int test_search()
+{
+    // bx lr; svc #0x42; blx r3; mov r0, r0
+    static const uint8_t arm[] = {
+        0x1e, 0xff, 0x2f, 0xe1, 0x42, 0x00, 0x00, 0xef,
+        0x33, 0xff, 0x2f, 0xe1, 0x00, 0x00, 0xa0, 0xe1,
+    };
+
+    // blx r3; bx lr; svc #1; bl
+    static const uint8_t thumb[] = {
+        0x98, 0x47, 0x70, 0x47, 0x01, 0xdf, 0x00, 0xf0, 0x00, 0xf8,
+    };
+
+    // any blx Rm
+    static const darm_pattern_t blx[] = {
+        {0x0ffffff0, 0x012fff30, ISA_ARMV7, I_BLX},
+        {0xff870000, 0x47800000, ISA_THUMB, I_BLX},
+    };
+
+    darm_hit_t hits[16];
+    if(darm_search(blx, ARRAYSIZE(blx), arm, sizeof(arm), 0x1000,
+                hits, 16) != 1 || hits[0].addr != 0x1008 ||
+            hits[0].pattern != 0 || hits[0].instr != I_BLX ||
+            darm_search(blx, ARRAYSIZE(blx), thumb, sizeof(thumb), 0x2000,
+                hits, 16) != 1 || hits[0].addr != 0x2001 ||
+            hits[0].pattern != 1) {
+        printf("Invalid search results for hand written patterns\n");
+        return -1;
+    }
+
+    // every instruction matches one of the generated patterns, the ARMv7
+    // hits are reported before the Thumb hits
+    static const darm_instr_t instrs[] = {I_BLX, I_BX, I_SVC, I_BL};
+    uint32_t count = darm_search(darm_patterns, ARRAYSIZE(darm_patterns),
+        thumb, sizeof(thumb), 0x2000, hits, 16), thumbs = 0;
+    for (uint32_t idx = 0; idx < count && idx < 16; idx++) {
+        if((hits[idx].addr & 1) == 0 || thumbs == ARRAYSIZE(instrs)) {
+            continue;
+        }
+        if(hits[idx].addr != 0x2001 + 2 * thumbs ||
+                hits[idx].instr != instrs[thumbs]) {
+            break;
+        }
+        thumbs++;
+    }
+    if(thumbs != ARRAYSIZE(instrs) || count > 16) {
+        printf("Invalid search results for generated patterns\n");
+        return -1;
+    }
+
+    count = darm_search(darm_patterns, ARRAYSIZE(darm_patterns),
+        arm, sizeof(arm), 0x1000, hits, 16);
+    if(count < 4 || count > 16 || hits[1].addr != 0x1004 ||
+            hits[1].instr != I_SVC ||
+            darm_patterns[hits[1].pattern].instr != I_SVC) {
+        printf("Invalid search results for generated patterns\n");
+        return -1;
+    }
+
+    // bx lr; and a thumb2 prefix without its second halfword
+    static const uint8_t tail[] = {0x70, 0x47, 0x00, 0xf0};
+    count = darm_search(darm_patterns, ARRAYSIZE(darm_patterns),
+        tail, sizeof(tail), 0x2000, hits, 16);
+    for (uint32_t idx = 0; idx < count && idx < 16; idx++) {
+        if(hits[idx].addr == 0x2003) {
+            printf("Invalid search result past the end of the buffer\n");
+            return -1;
+        }
+    }
+
+    printf("[x] passed search tests\n");
+    return 0;
+}
+
+static int test_gadgets()
+{
+    // mov r0, r1; add r0, r0, #4; pop {r4, pc}; bx lr (arm)
+    // movs r0, #1; adds r0, #2; pop {r4, pc}; b.n (thumb)
+    static const uint8_t code[] = {
+        0x01, 0x00, 0xa0, 0xe1, 0x04, 0x00, 0x80, 0xe2,
+        0x10, 0x80, 0xbd, 0xe8, 0x1e, 0xff, 0x2f, 0xe1,
+        0x01, 0x20, 0x02, 0x30, 0x10, 0xbd, 0xfe, 0xe7,
+    };
+
+    darm_gadgets_t g, lo, hi;
+    darm_gadgets_init(&g);
+    darm_gadgets_init(&lo);
+    darm_gadgets_init(&hi);
+
+    // the thumb pop {r4, pc} is a duplicate of the arm one, the arm pop
+    // {r4, pc} also ends two thumb gadgets
+    if(darm_gadgets_find(&g, code, sizeof(code), 0x8000, 0,
+                sizeof(code), 3) < 0 || g.count != 8 ||
+            g.gadget[0].addr != 0x8008 || g.gadget[2].addr != 0x8000 ||
+            g.gadget[2].count != 3 || g.gadget[2].size != 12 ||
+            g.gadget[7].addr != 0x8011 || g.gadget[7].size != 6) {
+        printf("Invalid gadgets\n");
+        return -1;
+    }
+
+    // two regions merged give the same gadgets
+    if(darm_gadgets_find(&lo, code, sizeof(code), 0x8000, 0, 12, 3) < 0 ||
+            darm_gadgets_find(&hi, code, sizeof(code), 0x8000, 12,
+                sizeof(code), 3) < 0 ||
+            darm_gadgets_merge(&lo, &hi) < 0 || lo.count != g.count) {
+        printf("Invalid merged gadgets\n");
+        return -1;
+    }
+
+    // addw r0, r0, #1; pop {r4, pc}; b.n (thumb), addw can't be formatted
+    // but the gadget is still distinct from the lone pop {r4, pc}
+    static const uint8_t addw[] = {
+        0x00, 0xf2, 0x01, 0x00, 0x10, 0xbd, 0xfe, 0xe7,
+    };
+
+    darm_gadgets_free(&g);
+    darm_gadgets_init(&g);
+    if(darm_gadgets_find(&g, addw, sizeof(addw), 0x8000, 0,
+                sizeof(addw), 2) < 0 || g.count != 3 ||
+            g.gadget[2].addr != 0x8001 || g.gadget[2].size != 6) {
+        printf("Invalid gadgets with unformattable instructions\n");
+        return -1;
+    }
+
+    darm_gadgets_free(&g);
+    darm_gadgets_free(&lo);
+    darm_gadgets_free(&hi);
+
+    printf("[x] passed gadget tests\n");
+    return 0;
+}
+
+static int test_ngram()
+{
+    // add r0, r1, #4; ldr r2, [r0]; pop {r4, pc}, and the same with other
+    // registers and immediates
+    static const uint8_t a[] = {
+        0x04, 0x00, 0x81, 0xe2, 0x00, 0x20, 0x90, 0xe5,
+        0x10, 0x80, 0xbd, 0xe8,
+    };
+    static const uint8_t b[] = {
+        0x08, 0x30, 0x85, 0xe2, 0x00, 0x10, 0x93, 0xe5,
+        0x10, 0x80, 0xbd, 0xe8,
+    };
+
+    uint32_t tokens[2][4]; uint64_t keys[2][4];
+    if(darm_ngram_tokens(a, sizeof(a), 0x1000, tokens[0], 4) != 3 ||
+            darm_ngram_tokens(b, sizeof(b), 0x2000, tokens[1], 4) != 3 ||
+            memcmp(tokens[0], tokens[1], 3 * sizeof(uint32_t)) != 0 ||
+            tokens[0][0] == tokens[0][1] ||
+            darm_ngram_keys(tokens[0], 3, 2, keys[0]) != 2 ||
+            darm_ngram_keys(tokens[0], 3, 4, keys[1]) != 0) {
+        printf("Invalid n-gram tokens\n");
+        return -1;
+    }
+
+    darm_ngram_builder_t builder, other; darm_ngram_index_t ix;
+    darm_ngram_builder_init(&builder, 2);
+    darm_ngram_builder_init(&other, 2);
+
+    // the first key is in both functions, the second key only in one
+    darm_ngram_add_file(&builder, "a");
+    darm_ngram_add_doc(&builder, 0, 0x1000, keys[0], 2);
+    darm_ngram_add_file(&other, "b");
+    darm_ngram_add_doc(&other, 0, 0x2000, keys[0], 1);
+
+    uint32_t docs[4], addr;
+    if(darm_ngram_builder_merge(&builder, &other) < 0 ||
+            darm_ngram_write(&builder, "ngram-test.idx") < 0 ||
+            darm_ngram_open(&ix, "ngram-test.idx") < 0) {
+        printf("Error writing the n-gram index\n");
+        darm_ngram_builder_free(&builder);
+        return -1;
+    }
+
+    darm_ngram_builder_free(&builder);
+    remove("ngram-test.idx");
+
+    if(ix.n != 2 || ix.key_count != 2 || ix.doc_count != 2 ||
+            darm_ngram_lookup(&ix, keys[0][0], docs, 4) != 2 ||
+            docs[0] != 0 || docs[1] != 1 ||
+            darm_ngram_lookup(&ix, keys[0][1], docs, 4) != 1 ||
+            docs[0] != 0 || darm_ngram_lookup(&ix, 42, docs, 4) != 0 ||
+            strcmp(darm_ngram_doc(&ix, 1, &addr), "b") != 0 ||
+            addr != 0x2000) {
+        printf("Invalid n-gram index lookups\n");
+        darm_ngram_close(&ix);
+        return -1;
+    }
+
+    darm_ngram_close(&ix);
+
+    printf("[x] passed n-gram index tests\n");
+    return 0;
+}
+
+static int test_valid()
+{
+    static uint64_t bits[DARM_VALID_BLOCK / 64];
+    static uint8_t out[DARM_VALID_BLOCK / 8];
+    static const uint16_t types[] = {
+        V_EMPTY, V_FULL, V_ARRAY, V_INVERTED, V_RUNS, V_BITMAP,
+    };
+
+    for (uint32_t type = 0; type < ARRAYSIZE(types); type++) {
+        uint32_t seed = 1;
+
+        for (uint32_t idx = 0; idx < DARM_VALID_BLOCK; idx++) {
+            uint32_t bit = 0;
+            seed = seed * 1103515245 + 12345;
+
+            switch (types[type]) {
+            case V_FULL: bit = 1; break;
+            case V_ARRAY: bit = (seed >> 16) % 64 == 0; break;
+            case V_INVERTED: bit = (seed >> 16) % 64 != 0; break;
+            case V_RUNS: bit = (idx / 1000) % 2; break;
+            case V_BITMAP: bit = (seed >> 16) % 2; break;
+            }
+
+            if(bit != 0) {
+                bits[idx / 64] |= 1ULL << (idx % 64);
+            }
+            else {
+                bits[idx / 64] &= ~(1ULL << (idx % 64));
+            }
+        }
+
+        darm_valid_entry_t entry;
+        darm_valid_pack(bits, out, &entry);
+        if(entry.type != types[type]) {
+            printf("Invalid validity container %d for %d\n",
+                entry.type, types[type]);
+            return -1;
+        }
+
+        for (uint32_t idx = 0; idx < DARM_VALID_BLOCK; idx++) {
+            if(darm_valid_unpack(&entry, out, idx) !=
+                    (int)((bits[idx / 64] >> (idx % 64)) & 1)) {
+                printf("Invalid validity of %d in container %d\n",
+                    idx, entry.type);
+                return -1;
+            }
+        }
+    }
+
+    printf("[x] passed validity bitmap tests\n");
+    return 0;
+}
+
+static int test_kernels()
+{
+    static const uint32_t features[] = {
+        CPU_SSE42, CPU_SSE42 | CPU_AVX2, CPU_SSE42 | CPU_AVX2 | CPU_AVX512,
+    };
+    static uint32_t w[131], swapped[2][131];
+    static uint8_t cls[2][131];
+    static uint16_t hw[2][131];
+    static const uint32_t counts[] = {64, 45, 7};
+    uint64_t prefix[2][3], match[2][3];
+    uint32_t seed = 42;
+
+    for (uint32_t idx = 0; idx < ARRAYSIZE(w); idx++) {
+        seed = seed * 1103515245 + 12345;
+        w[idx] = (seed & 0xffff0000) | (seed >> 16);
+
+        // plenty of Thumb2 prefixes and matching words
+        if(idx % 3 == 0) w[idx] |= 0xe800e800;
+        if(idx % 5 == 0) w[idx] = (w[idx] & ~0x0ff000f0) | 0x01200010;
+    }
+
+    for (uint32_t f = 0; f < ARRAYSIZE(features); f++) {
+        for (uint32_t pass = 0; pass < 2; pass++) {
+            // the scalar kernels are the reference
+            if(darm_cpu_select(pass == 0 ? 0 : features[f]) !=
+                    (pass == 0 ? 0 : features[f] & darm_cpu_features())) {
+                printf("Invalid kernel selection\n");
+                return -1;
+            }
+
+            darm_armv7_classify(w, ARRAYSIZE(w), cls[pass]);
+            darm_bswap32(swapped[pass], w, ARRAYSIZE(w));
+            darm_bswap16(hw[pass], (const uint16_t *) w, ARRAYSIZE(w));
+
+            for (uint32_t idx = 0; idx < ARRAYSIZE(counts); idx++) {
+                uint64_t starts[2];
+                darm_thumb_bitmap((const uint8_t *) &w[idx * 3],
+                    counts[idx] * 2, starts);
+                prefix[pass][idx] = starts[0];
+                match[pass][idx] = darm_match_block(&w[idx], counts[idx],
+                    0x0ff000f0, 0x01200010);
+            }
+        }
+
+        if(memcmp(cls[0], cls[1], sizeof(cls[0])) != 0 ||
+                memcmp(swapped[0], swapped[1], sizeof(swapped[0])) != 0 ||
+                memcmp(hw[0], hw[1], sizeof(hw[0])) != 0 ||
+                memcmp(prefix[0], prefix[1], sizeof(prefix[0])) != 0 ||
+                memcmp(match[0], match[1], sizeof(match[0])) != 0 ||
+                swapped[0][1] != __builtin_bswap32(w[1])) {
+            printf("Invalid results for kernels 0x%x\n", features[f]);
+            return -1;
+        }
+    }
+
+    darm_cpu_select(~0);
+
+    printf("[x] passed vectorized kernel tests\n");
+    return 0;
+}
+
+static int test_pext()
+{
+    uint32_t seed = 0x12345678;
+
+    for (uint32_t idx = 0; idx < 4096; idx++) {
+        seed = seed * 1103515245 + 12345;
+        uint16_t w = seed >> 16, w2 = seed ^ (seed >> 7);
+        uint32_t ww = ((uint32_t) w << 16) | w2;
+
+        // the generated masks against the hand-written shifts
+        if(darm_pext(ww, THUMB2_PEXT_IMM2_IMM3) !=
+                (uint32_t)(((w2 >> 10) & b11100) | ((w2 >> 6) & b11)) ||
+                darm_pext(ww, THUMB2_PEXT_IMM1_IMM3_IMM8) !=
+                (uint32_t)(((w & 0x400) << 1) | ((w2 & 0x7000) >> 4) |
+                    (w2 & 0xff)) ||
+                darm_pext(ww, THUMB2_PEXT_IMM6_IMM11) !=
+                (uint32_t)(((w & 0x3f) << 11) | (w2 & 0x7ff)) ||
+                darm_pext(ww, THUMB2_PEXT_IMM10_IMM11) !=
+                (uint32_t)(((w & 0x3ff) << 11) | (w2 & 0x7ff)) ||
+                darm_pext(ww, THUMB2_PEXT_IMM10H_IMM10L) !=
+                (uint32_t)(((w & 0x3ff) << 10) | ((w2 & 0x7fe) >> 1))) {
+            printf("Invalid pext field extraction for 0x%08x\n", ww);
+            return -1;
+        }
+    }
+
+    if(darm_pext(0xffffffff, 0) != 0 ||
+            darm_pext(0x80000001, 0x80000001) != 3 ||
+            darm_pext(0x12345678, 0xffffffff) != 0x12345678) {
+        printf("Invalid pext results\n");
+        return -1;
+    }
+
+    printf("[x] passed pext field extraction tests\n");
+    return 0;
+}
+
+static int test_insn_length()
+{
+    uint32_t seed = 0x87654321;
+
+    for (uint32_t idx = 0; idx < 0x10000; idx++) {
+        seed = seed * 1103515245 + 12345;
+        uint16_t w = idx, w2 = seed >> 8;
+
+        for (uint32_t thumb = 0; thumb < 2; thumb++) {
+            darm_t d, d2;
+            int ret = darm_disasm(&d, w, w2, 0x1000 | thumb);
+
+            // the inlined dispatch has to decode exactly the same, and the
+            // length has to match that of each instruction that decodes
+            if(darm_disasm_inline(&d2, w, w2, 0x1000 | thumb) != ret ||
+                    (ret != 0 && (d.instr != d2.instr || d.imm != d2.imm ||
+                        ret != darm_insn_length(w, thumb)))) {
+                printf("Invalid length of 0x%04x 0x%04x (thumb %d)\n",
+                    w, w2, thumb);
+                return -1;
+            }
+        }
+    }
+
+    printf("[x] passed instruction length tests\n");
+    return 0;
+}
+
 int main()
 {
     int disasm_index = 0, failure = 0;
@@ -1595,13 +2803,21 @@ int main()
         }
     }
 
-    if(failure != 0) {
-        printf("[-] unittests NOT successful!\n");
-        return 0;
+    // run some tests on utility functions
+    if(test_thumb2_functions() < 0 || test_branch_targets() < 0 ||
+            test_regs() < 0 || test_semantics() < 0 || test_cfg() < 0 ||
+            test_it() < 0 || test_descent() < 0 || test_data() < 0 ||
+            test_fold() < 0 || test_jumptable() < 0 || test_funcs() < 0 ||
+            test_stack() < 0 || test_batch() < 0 ||
+            test_boundaries() < 0 || test_search() < 0 ||
+            test_gadgets() < 0 || test_ngram() < 0 || test_valid() < 0 ||
+            test_kernels() < 0 || test_pext() < 0 ||
+            test_insn_length() < 0) {
+        failure = 1;
     }
 
-    // run some tests on utility functions
-    if(test_thumb2_functions() < 0) {
+    if(failure != 0) {
+        printf("[-] unittests NOT successful!\n");
         return 0;
     }
 
@@ -0,0 +1,178 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <stdio.h>
+#include <stdint.h>
+#include "thumb-tbl.h"
+const darm_lut_t thumb_instr_lut[] = {
+    DARM_LUT(I_LSL, T_THUMB_SHIFT_IMM), DARM_LUT(I_LSL, T_THUMB_SHIFT_IMM),
+    DARM_LUT(I_LSL, T_THUMB_SHIFT_IMM), DARM_LUT(I_LSL, T_THUMB_SHIFT_IMM),
+    DARM_LUT(I_LSL, T_THUMB_SHIFT_IMM), DARM_LUT(I_LSL, T_THUMB_SHIFT_IMM),
+    DARM_LUT(I_LSL, T_THUMB_SHIFT_IMM), DARM_LUT(I_LSL, T_THUMB_SHIFT_IMM),
+    DARM_LUT(I_LSR, T_THUMB_SHIFT_IMM), DARM_LUT(I_LSR, T_THUMB_SHIFT_IMM),
+    DARM_LUT(I_LSR, T_THUMB_SHIFT_IMM), DARM_LUT(I_LSR, T_THUMB_SHIFT_IMM),
+    DARM_LUT(I_LSR, T_THUMB_SHIFT_IMM), DARM_LUT(I_LSR, T_THUMB_SHIFT_IMM),
+    DARM_LUT(I_LSR, T_THUMB_SHIFT_IMM), DARM_LUT(I_LSR, T_THUMB_SHIFT_IMM),
+    DARM_LUT(I_ASR, T_THUMB_SHIFT_IMM), DARM_LUT(I_ASR, T_THUMB_SHIFT_IMM),
+    DARM_LUT(I_ASR, T_THUMB_SHIFT_IMM), DARM_LUT(I_ASR, T_THUMB_SHIFT_IMM),
+    DARM_LUT(I_ASR, T_THUMB_SHIFT_IMM), DARM_LUT(I_ASR, T_THUMB_SHIFT_IMM),
+    DARM_LUT(I_ASR, T_THUMB_SHIFT_IMM), DARM_LUT(I_ASR, T_THUMB_SHIFT_IMM),
+    DARM_LUT(I_ADD, T_THUMB_3REG), DARM_LUT(I_ADD, T_THUMB_3REG),
+    DARM_LUT(I_SUB, T_THUMB_3REG), DARM_LUT(I_SUB, T_THUMB_3REG),
+    DARM_LUT(I_ADD, T_THUMB_2REG_IMM), DARM_LUT(I_ADD, T_THUMB_2REG_IMM),
+    DARM_LUT(I_SUB, T_THUMB_2REG_IMM), DARM_LUT(I_SUB, T_THUMB_2REG_IMM),
+    DARM_LUT(I_MOV, T_THUMB_HAS_IMM8), DARM_LUT(I_MOV, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_MOV, T_THUMB_HAS_IMM8), DARM_LUT(I_MOV, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_MOV, T_THUMB_HAS_IMM8), DARM_LUT(I_MOV, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_MOV, T_THUMB_HAS_IMM8), DARM_LUT(I_MOV, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_CMP, T_THUMB_HAS_IMM8), DARM_LUT(I_CMP, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_CMP, T_THUMB_HAS_IMM8), DARM_LUT(I_CMP, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_CMP, T_THUMB_HAS_IMM8), DARM_LUT(I_CMP, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_CMP, T_THUMB_HAS_IMM8), DARM_LUT(I_CMP, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_ADD, T_THUMB_HAS_IMM8), DARM_LUT(I_ADD, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_ADD, T_THUMB_HAS_IMM8), DARM_LUT(I_ADD, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_ADD, T_THUMB_HAS_IMM8), DARM_LUT(I_ADD, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_ADD, T_THUMB_HAS_IMM8), DARM_LUT(I_ADD, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_SUB, T_THUMB_HAS_IMM8), DARM_LUT(I_SUB, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_SUB, T_THUMB_HAS_IMM8), DARM_LUT(I_SUB, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_SUB, T_THUMB_HAS_IMM8), DARM_LUT(I_SUB, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_SUB, T_THUMB_HAS_IMM8), DARM_LUT(I_SUB, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_LSR, T_THUMB_GPI), DARM_LUT(I_SBC, T_THUMB_GPI),
+    DARM_LUT(I_TST, T_THUMB_GPI), DARM_LUT(I_ORR, T_THUMB_GPI),
+    DARM_LUT(I_ADD, T_THUMB_MOD_SP_REG), DARM_LUT(I_CMP, T_THUMB_CMP),
+    DARM_LUT(I_MOV, T_THUMB_MOV4), DARM_LUT(I_BX, T_THUMB_BRANCH_REG),
+    DARM_LUT(I_LDR, T_THUMB_LDR_PC), DARM_LUT(I_LDR, T_THUMB_LDR_PC),
+    DARM_LUT(I_LDR, T_THUMB_LDR_PC), DARM_LUT(I_LDR, T_THUMB_LDR_PC),
+    DARM_LUT(I_LDR, T_THUMB_LDR_PC), DARM_LUT(I_LDR, T_THUMB_LDR_PC),
+    DARM_LUT(I_LDR, T_THUMB_LDR_PC), DARM_LUT(I_LDR, T_THUMB_LDR_PC),
+    DARM_LUT(I_STR, T_THUMB_RW_MEMO), DARM_LUT(I_STR, T_THUMB_RW_MEMO),
+    DARM_LUT(I_STRH, T_THUMB_RW_MEMO), DARM_LUT(I_STRH, T_THUMB_RW_MEMO),
+    DARM_LUT(I_STRB, T_THUMB_RW_MEMO), DARM_LUT(I_STRB, T_THUMB_RW_MEMO),
+    DARM_LUT(I_LDRSB, T_THUMB_RW_MEMO), DARM_LUT(I_LDRSB, T_THUMB_RW_MEMO),
+    DARM_LUT(I_LDR, T_THUMB_RW_MEMO), DARM_LUT(I_LDR, T_THUMB_RW_MEMO),
+    DARM_LUT(I_LDRH, T_THUMB_RW_MEMO), DARM_LUT(I_LDRH, T_THUMB_RW_MEMO),
+    DARM_LUT(I_LDRB, T_THUMB_RW_MEMO), DARM_LUT(I_LDRB, T_THUMB_RW_MEMO),
+    DARM_LUT(I_LDRSH, T_THUMB_RW_MEMO), DARM_LUT(I_LDRSH, T_THUMB_RW_MEMO),
+    DARM_LUT(I_STR, T_THUMB_RW_MEMI), DARM_LUT(I_STR, T_THUMB_RW_MEMI),
+    DARM_LUT(I_STR, T_THUMB_RW_MEMI), DARM_LUT(I_STR, T_THUMB_RW_MEMI),
+    DARM_LUT(I_STR, T_THUMB_RW_MEMI), DARM_LUT(I_STR, T_THUMB_RW_MEMI),
+    DARM_LUT(I_STR, T_THUMB_RW_MEMI), DARM_LUT(I_STR, T_THUMB_RW_MEMI),
+    DARM_LUT(I_LDR, T_THUMB_RW_MEMI), DARM_LUT(I_LDR, T_THUMB_RW_MEMI),
+    DARM_LUT(I_LDR, T_THUMB_RW_MEMI), DARM_LUT(I_LDR, T_THUMB_RW_MEMI),
+    DARM_LUT(I_LDR, T_THUMB_RW_MEMI), DARM_LUT(I_LDR, T_THUMB_RW_MEMI),
+    DARM_LUT(I_LDR, T_THUMB_RW_MEMI), DARM_LUT(I_LDR, T_THUMB_RW_MEMI),
+    DARM_LUT(I_STRB, T_THUMB_RW_MEMI), DARM_LUT(I_STRB, T_THUMB_RW_MEMI),
+    DARM_LUT(I_STRB, T_THUMB_RW_MEMI), DARM_LUT(I_STRB, T_THUMB_RW_MEMI),
+    DARM_LUT(I_STRB, T_THUMB_RW_MEMI), DARM_LUT(I_STRB, T_THUMB_RW_MEMI),
+    DARM_LUT(I_STRB, T_THUMB_RW_MEMI), DARM_LUT(I_STRB, T_THUMB_RW_MEMI),
+    DARM_LUT(I_LDRB, T_THUMB_RW_MEMI), DARM_LUT(I_LDRB, T_THUMB_RW_MEMI),
+    DARM_LUT(I_LDRB, T_THUMB_RW_MEMI), DARM_LUT(I_LDRB, T_THUMB_RW_MEMI),
+    DARM_LUT(I_LDRB, T_THUMB_RW_MEMI), DARM_LUT(I_LDRB, T_THUMB_RW_MEMI),
+    DARM_LUT(I_LDRB, T_THUMB_RW_MEMI), DARM_LUT(I_LDRB, T_THUMB_RW_MEMI),
+    DARM_LUT(I_STRH, T_THUMB_RW_MEMI), DARM_LUT(I_STRH, T_THUMB_RW_MEMI),
+    DARM_LUT(I_STRH, T_THUMB_RW_MEMI), DARM_LUT(I_STRH, T_THUMB_RW_MEMI),
+    DARM_LUT(I_STRH, T_THUMB_RW_MEMI), DARM_LUT(I_STRH, T_THUMB_RW_MEMI),
+    DARM_LUT(I_STRH, T_THUMB_RW_MEMI), DARM_LUT(I_STRH, T_THUMB_RW_MEMI),
+    DARM_LUT(I_LDRH, T_THUMB_RW_MEMI), DARM_LUT(I_LDRH, T_THUMB_RW_MEMI),
+    DARM_LUT(I_LDRH, T_THUMB_RW_MEMI), DARM_LUT(I_LDRH, T_THUMB_RW_MEMI),
+    DARM_LUT(I_LDRH, T_THUMB_RW_MEMI), DARM_LUT(I_LDRH, T_THUMB_RW_MEMI),
+    DARM_LUT(I_LDRH, T_THUMB_RW_MEMI), DARM_LUT(I_LDRH, T_THUMB_RW_MEMI),
+    DARM_LUT(I_STR, T_THUMB_STACK), DARM_LUT(I_STR, T_THUMB_STACK),
+    DARM_LUT(I_STR, T_THUMB_STACK), DARM_LUT(I_STR, T_THUMB_STACK),
+    DARM_LUT(I_STR, T_THUMB_STACK), DARM_LUT(I_STR, T_THUMB_STACK),
+    DARM_LUT(I_STR, T_THUMB_STACK), DARM_LUT(I_STR, T_THUMB_STACK),
+    DARM_LUT(I_LDR, T_THUMB_STACK), DARM_LUT(I_LDR, T_THUMB_STACK),
+    DARM_LUT(I_LDR, T_THUMB_STACK), DARM_LUT(I_LDR, T_THUMB_STACK),
+    DARM_LUT(I_LDR, T_THUMB_STACK), DARM_LUT(I_LDR, T_THUMB_STACK),
+    DARM_LUT(I_LDR, T_THUMB_STACK), DARM_LUT(I_LDR, T_THUMB_STACK),
+    DARM_LUT(I_ADR, T_THUMB_HAS_IMM8), DARM_LUT(I_ADR, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_ADR, T_THUMB_HAS_IMM8), DARM_LUT(I_ADR, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_ADR, T_THUMB_HAS_IMM8), DARM_LUT(I_ADR, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_ADR, T_THUMB_HAS_IMM8), DARM_LUT(I_ADR, T_THUMB_HAS_IMM8),
+    DARM_LUT(I_ADD, T_THUMB_ADD_SP_IMM), DARM_LUT(I_ADD, T_THUMB_ADD_SP_IMM),
+    DARM_LUT(I_ADD, T_THUMB_ADD_SP_IMM), DARM_LUT(I_ADD, T_THUMB_ADD_SP_IMM),
+    DARM_LUT(I_ADD, T_THUMB_ADD_SP_IMM), DARM_LUT(I_ADD, T_THUMB_ADD_SP_IMM),
+    DARM_LUT(I_ADD, T_THUMB_ADD_SP_IMM), DARM_LUT(I_ADD, T_THUMB_ADD_SP_IMM),
+    DARM_LUT(I_SUB, T_THUMB_MOD_SP_IMM), DARM_LUT(I_CBZ, T_THUMB_CBZ),
+    DARM_LUT(I_UXTH, T_THUMB_EXTEND), DARM_LUT(I_CBZ, T_THUMB_CBZ),
+    DARM_LUT(I_PUSH, T_THUMB_PUSHPOP), DARM_LUT(I_PUSH, T_THUMB_PUSHPOP),
+    DARM_LUT(I_SETEND, T_THUMB_SETEND), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_CBZ, T_THUMB_CBZ),
+    DARM_LUT(I_REVSH, T_THUMB_REV), DARM_LUT(I_CBZ, T_THUMB_CBZ),
+    DARM_LUT(I_POP, T_THUMB_PUSHPOP), DARM_LUT(I_POP, T_THUMB_PUSHPOP),
+    DARM_LUT(I_BKPT, T_THUMB_ONLY_IMM8), DARM_LUT(I_YIELD, T_THUMB_IT_HINTS),
+    DARM_LUT(I_STM, T_THUMB_RW_REG), DARM_LUT(I_STM, T_THUMB_RW_REG),
+    DARM_LUT(I_STM, T_THUMB_RW_REG), DARM_LUT(I_STM, T_THUMB_RW_REG),
+    DARM_LUT(I_STM, T_THUMB_RW_REG), DARM_LUT(I_STM, T_THUMB_RW_REG),
+    DARM_LUT(I_STM, T_THUMB_RW_REG), DARM_LUT(I_STM, T_THUMB_RW_REG),
+    DARM_LUT(I_LDM, T_THUMB_RW_REG), DARM_LUT(I_LDM, T_THUMB_RW_REG),
+    DARM_LUT(I_LDM, T_THUMB_RW_REG), DARM_LUT(I_LDM, T_THUMB_RW_REG),
+    DARM_LUT(I_LDM, T_THUMB_RW_REG), DARM_LUT(I_LDM, T_THUMB_RW_REG),
+    DARM_LUT(I_LDM, T_THUMB_RW_REG), DARM_LUT(I_LDM, T_THUMB_RW_REG),
+    DARM_LUT(I_B, T_THUMB_COND_BRANCH), DARM_LUT(I_B, T_THUMB_COND_BRANCH),
+    DARM_LUT(I_B, T_THUMB_COND_BRANCH), DARM_LUT(I_B, T_THUMB_COND_BRANCH),
+    DARM_LUT(I_B, T_THUMB_COND_BRANCH), DARM_LUT(I_B, T_THUMB_COND_BRANCH),
+    DARM_LUT(I_B, T_THUMB_COND_BRANCH), DARM_LUT(I_B, T_THUMB_COND_BRANCH),
+    DARM_LUT(I_B, T_THUMB_COND_BRANCH), DARM_LUT(I_B, T_THUMB_COND_BRANCH),
+    DARM_LUT(I_B, T_THUMB_COND_BRANCH), DARM_LUT(I_B, T_THUMB_COND_BRANCH),
+    DARM_LUT(I_B, T_THUMB_COND_BRANCH), DARM_LUT(I_B, T_THUMB_COND_BRANCH),
+    DARM_LUT(I_UDF, T_THUMB_ONLY_IMM8), DARM_LUT(I_SVC, T_THUMB_ONLY_IMM8),
+    DARM_LUT(I_B, T_THUMB_UNCOND_BRANCH), DARM_LUT(I_B,
+    T_THUMB_UNCOND_BRANCH), DARM_LUT(I_B, T_THUMB_UNCOND_BRANCH),
+    DARM_LUT(I_B, T_THUMB_UNCOND_BRANCH), DARM_LUT(I_B,
+    T_THUMB_UNCOND_BRANCH), DARM_LUT(I_B, T_THUMB_UNCOND_BRANCH),
+    DARM_LUT(I_B, T_THUMB_UNCOND_BRANCH), DARM_LUT(I_B,
+    T_THUMB_UNCOND_BRANCH), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD),
+    DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD,
+    T_INVLD), DARM_LUT(I_INVLD, T_INVLD), DARM_LUT(I_INVLD, T_INVLD)
+};
+
+const uint16_t type_gpi_instr_lookup[] = {
+    I_AND, I_EOR, I_LSL, I_LSR, I_ASR, I_ADC, I_SBC, I_ROR, I_TST, I_RSB,
+    I_CMP, I_CMN, I_ORR, I_MUL, I_BIC, I_MVN
+};
+
+const uint16_t type_hints_instr_lookup[] = {
+    I_NOP, I_YIELD, I_WFE, I_WFI, I_SEV
+};
+
+const uint16_t type_extend_instr_lookup[] = {
+    I_SXTH, I_SXTB, I_UXTH, I_UXTB
+};
+
+const uint16_t type_rev_instr_lookup[] = {
+    I_REV, I_REV16, I_INVLD, I_REVSH
+};
+
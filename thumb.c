@@ -38,8 +38,9 @@ POSSIBILITY OF SUCH DAMAGE.
 
 static int thumb_disasm(darm_t *d, uint16_t w)
 {
-    d->instr = thumb_instr_labels[w >> 8];
-    d->instr_type = thumb_instr_types[w >> 8];
+    darm_lut_t entry = thumb_instr_lut[w >> 8];
+    d->instr = darm_lut_instr(entry);
+    d->instr_type = darm_lut_type(entry);
 
     switch ((uint32_t) d->instr_type) {
     case T_THUMB_ONLY_IMM8:
@@ -340,6 +341,9 @@ int darm_thumb_disasm(darm_t *d, uint16_t w)
         return -1;
 
     default:
-        return thumb_disasm(d, w);
+        if(thumb_disasm(d, w) < 0) return -1;
+
+        darm_regs_update(d);
+        return 0;
     }
 }
@@ -0,0 +1,128 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <stdio.h>
+#include <stdint.h>
+#include "thumb2-tbl.h"
+const uint16_t thumb2_instr_labels[] = {
+    I_ADC, I_ADC, I_ADD, I_ADDW, I_ADD, I_ADD, I_ADDW, I_ADD, I_ADR, I_ADR,
+    I_AND, I_AND, I_ASR, I_ASR, I_B, I_B, I_BFC, I_BFI, I_BIC, I_BIC, I_BL,
+    I_BLX, I_BXJ, I_CLREX, I_CLZ, I_CMN, I_CMN, I_CMP, I_CMP, I_DBG, I_DMB,
+    I_DSB, I_EOR, I_EOR, I_ISB, I_LDM, I_LDMDB, I_LDR, I_LDR, I_LDR, I_LDR,
+    I_LDRB, I_LDRB, I_LDRB, I_LDRB, I_LDRBT, I_LDRD, I_LDRD, I_LDREX,
+    I_LDREXB, I_LDREXD, I_LDREXH, I_LDRH, I_LDRH, I_LDRH, I_LDRH, I_LDRHT,
+    I_LDRSB, I_LDRSB, I_LDRSB, I_LDRSB, I_LDRSBT, I_LDRSH, I_LDRSH, I_LDRSH,
+    I_LDRSH, I_LDRSHT, I_LDRT, I_MOV, I_LSL, I_LSR, I_LSR, I_MLA, I_MLS,
+    I_MOV, I_MOVW, I_MOVT, I_MRS, I_MUL, I_MVN, I_MVN, I_NOP, I_ORN, I_ORN,
+    I_ORR, I_ORR, I_PLD, I_PLD, I_PLD, I_PLD, I_PLI, I_PLI, I_PLI, I_PLI,
+    I_POP, I_POP, I_PUSH, I_PUSH, I_QADD, I_QADD16, I_QADD8, I_QASX, I_QDADD,
+    I_QDSUB, I_QSAX, I_QSUB, I_QSUB16, I_QSUB8, I_RBIT, I_REV, I_REV16,
+    I_REVSH, I_RRX, I_ROR, I_RSB, I_RSB, I_SADD16, I_SADD8, I_SASX, I_SBC,
+    I_SBC, I_SBFX, I_SDIV, I_SEL, I_SEV, I_SHADD16, I_SHADD8, I_SHASX,
+    I_SHSAX, I_SHSUB16, I_SHSUB8, I_SMLA, I_SMLAD, I_SMLAL, I_SMLAL, I_SMLALD,
+    I_SMLAW, I_SMLSD, I_SMLSLD, I_SMMLA, I_SMMLS, I_SMMUL, I_SMUAD, I_SMUL,
+    I_SMULL, I_SMULW, I_SMUSD, I_SSAX, I_SSUB16, I_SSUB8, I_STM, I_STMDB,
+    I_STR, I_STR, I_STR, I_STRB, I_STRB, I_STRB, I_STRBT, I_STREX, I_STREXB,
+    I_STREXD, I_STREXH, I_STRH, I_STRH, I_STRH, I_STRHT, I_STRT, I_SUB,
+    I_SUBW, I_SUB, I_SUB, I_SUBW, I_SUB, I_SXTAB, I_SXTAB16, I_SXTAH, I_SXTB,
+    I_SXTB16, I_SXTH, I_TBB, I_TEQ, I_TEQ, I_TST, I_TST, I_UADD16, I_UADD8,
+    I_UASX, I_UBFX, I_UDF, I_UDIV, I_UHADD16, I_UHADD8, I_UHASX, I_UHSAX,
+    I_UHSUB16, I_UHSUB8, I_UMAAL, I_UMLAL, I_UMULL, I_UQADD16, I_UQADD8,
+    I_UQASX, I_UQSAX, I_UQSUB16, I_UQSUB8, I_USAD8, I_USADA8, I_USAX,
+    I_USUB16, I_USUB8, I_UXTAB, I_UXTAB16, I_UXTAH, I_UXTB, I_UXTB16, I_UXTH,
+    I_WFE, I_WFI, I_YIELD
+};
+
+const char *thumb2_instruction_strings[] = {
+    "ADC", "ADC", "ADD", "ADDW", "ADD", "ADD", "ADDW", "ADD", "ADR", "ADR",
+    "AND", "AND", "ASR", "ASR", "B", "B", "BFC", "BFI", "BIC", "BIC", "BL",
+    "BLX", "BXJ", "CLREX", "CLZ", "CMN", "CMN", "CMP", "CMP", "DBG", "DMB",
+    "DSB", "EOR", "EOR", "ISB", "LDM", "LDMDB", "LDR", "LDR", "LDR", "LDR",
+    "LDRB", "LDRB", "LDRB", "LDRB", "LDRBT", "LDRD", "LDRD", "LDREX",
+    "LDREXB", "LDREXD", "LDREXH", "LDRH", "LDRH", "LDRH", "LDRH", "LDRHT",
+    "LDRSB", "LDRSB", "LDRSB", "LDRSB", "LDRSBT", "LDRSH", "LDRSH", "LDRSH",
+    "LDRSH", "LDRSHT", "LDRT", "MOV", "LSL", "LSR", "LSR", "MLA", "MLS",
+    "MOV", "MOVW", "MOVT", "MRS", "MUL", "MVN", "MVN", "NOP", "ORN", "ORN",
+    "ORR", "ORR", "PLD", "PLD", "PLD", "PLD", "PLI", "PLI", "PLI", "PLI",
+    "POP", "POP", "PUSH", "PUSH", "QADD", "QADD16", "QADD8", "QASX", "QDADD",
+    "QDSUB", "QSAX", "QSUB", "QSUB16", "QSUB8", "RBIT", "REV", "REV16",
+    "REVSH", "RRX", "ROR", "RSB", "RSB", "SADD16", "SADD8", "SASX", "SBC",
+    "SBC", "SBFX", "SDIV", "SEL", "SEV", "SHADD16", "SHADD8", "SHASX",
+    "SHSAX", "SHSUB16", "SHSUB8", "SMLA", "SMLAD", "SMLAL", "SMLAL", "SMLALD",
+    "SMLAW", "SMLSD", "SMLSLD", "SMMLA", "SMMLS", "SMMUL", "SMUAD", "SMUL",
+    "SMULL", "SMULW", "SMUSD", "SSAX", "SSUB16", "SSUB8", "STM", "STMDB",
+    "STR", "STR", "STR", "STRB", "STRB", "STRB", "STRBT", "STREX", "STREXB",
+    "STREXD", "STREXH", "STRH", "STRH", "STRH", "STRHT", "STRT", "SUB",
+    "SUBW", "SUB", "SUB", "SUBW", "SUB", "SXTAB", "SXTAB16", "SXTAH", "SXTB",
+    "SXTB16", "SXTH", "TBB", "TEQ", "TEQ", "TST", "TST", "UADD16", "UADD8",
+    "UASX", "UBFX", "UDF", "UDIV", "UHADD16", "UHADD8", "UHASX", "UHSAX",
+    "UHSUB16", "UHSUB8", "UMAAL", "UMLAL", "UMULL", "UQADD16", "UQADD8",
+    "UQASX", "UQSAX", "UQSUB16", "UQSUB8", "USAD8", "USADA8", "USAX",
+    "USUB16", "USUB8", "UXTAB", "UXTAB16", "UXTAH", "UXTB", "UXTB16", "UXTH",
+    "WFE", "WFI", "YIELD"
+};
+
+const uint8_t thumb2_extractor_index[] = {
+    12, 0, 0, 0, 0, 34, 0, 0, 0, 0, 0, 30, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 35, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 19, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 23, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 11, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 28, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 9, 0, 0, 0, 0, 0, 0, 0, 0, 5, 0, 0, 0, 0, 0, 0, 4, 0,
+    13, 0, 0, 0, 0, 0, 0, 27, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, 6, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16, 0, 0, 31, 0, 0, 0, 0, 0, 0, 0, 0, 32,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 14, 0, 0, 0, 0, 0, 0, 0, 0, 24, 0, 0, 0, 0, 0, 0, 0, 0, 17, 0, 0, 0, 0,
+    0, 0, 0, 0, 21, 0, 0, 18, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 25, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 22, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 36, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    33, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 15, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 20, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 10, 0, 0, 0, 0,
+    0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 1, 0, 38, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 37, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 39, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    29, 0, 0, 0, 0, 0, 0, 8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 26, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
@@ -0,0 +1,87 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef __THUMB2_TBL__
+#define __THUMB2_TBL__
+#include <stdint.h>
+#include "darm-tbl.h"
+#define THUMB2_INSTRUCTION_COUNT 220
+extern const uint16_t thumb2_instr_labels[220];
+extern const char * thumb2_instruction_strings[256];
+extern const uint16_t type_immediate_instr_lookup[16];
+extern const uint16_t type_flags_instr_lookup[8];
+#define THUMB2_PEXT_IMM2_IMM3 0x000070c0
+#define THUMB2_PEXT_IMM1_IMM3_IMM8 0x040070ff
+#define THUMB2_PEXT_IMM6_IMM11 0x003f07ff
+#define THUMB2_PEXT_IMM10_IMM11 0x03ff07ff
+#define THUMB2_PEXT_IMM10H_IMM10L 0x03ff07fe
+#define THUMB2_REG_TYPES 16
+#define THUMB2_IMM_TYPES 6
+#define THUMB2_FLAG_TYPES 9
+#define THUMB2_EXTRACTORS(X) \
+    X(RN_RD_REG, IMM1_IMM3_IMM8, S_FLAG) \
+    X(RN_RD_RM_REG, IMM2_IMM3, S_TYPE_FLAG) \
+    X(RN_RD_REG, IMM1_IMM3_IMM8, NO_FLAG) \
+    X(RD_REG, IMM1_IMM3_IMM8, S_FLAG) \
+    X(RD_REG, IMM1_IMM3_IMM8, NO_FLAG) \
+    X(RD_RM_REG, IMM2_IMM3, S_TYPE_FLAG) \
+    X(RD_RM_REG, IMM2_IMM3, S_FLAG) \
+    X(RN_RD_RM_REG, NO_IMM, S_FLAG) \
+    X(RD_REG, IMM2_IMM3, NO_FLAG) \
+    X(RN_RD_REG, IMM2_IMM3, NO_FLAG) \
+    X(RM_REG, NO_IMM, NO_FLAG) \
+    X(NO_REG, NO_IMM, NO_FLAG) \
+    X(RD_RM_REG, NO_IMM, NO_FLAG) \
+    X(RN_REG, IMM1_IMM3_IMM8, NO_FLAG) \
+    X(RN_RM_REG, IMM2_IMM3, TYPE_FLAG) \
+    X(RN_REG, NO_IMM, WP_REGLIST_FLAG) \
+    X(RN_RT_REG, IMM12, NO_FLAG) \
+    X(RN_RT_REG, IMM8, WUP_FLAG) \
+    X(RT_REG, IMM12, U_FLAG) \
+    X(RN_RM_RT_REG, IMM2, NO_FLAG) \
+    X(RN_RT_REG, IMM8, NO_FLAG) \
+    X(RN_RT_RT2_REG, IMM8, WUP_FLAG) \
+    X(RT_RT2_REG, IMM8, WUP_FLAG) \
+    X(RN_RT_REG, NO_IMM, NO_FLAG) \
+    X(RN_RT_RT2_REG, NO_IMM, NO_FLAG) \
+    X(RN_RD_RM_RA_REG, NO_IMM, NO_FLAG) \
+    X(RD_RM_REG, NO_IMM, S_FLAG) \
+    X(RD_REG, NO_IMM, NO_FLAG) \
+    X(RN_RD_RM_REG, NO_IMM, NO_FLAG) \
+    X(NO_REG, IMM12, U_FLAG) \
+    X(RN_REG, IMM12, NO_FLAG) \
+    X(RN_REG, IMM8, NO_FLAG) \
+    X(RN_RM_REG, IMM2, NO_FLAG) \
+    X(NO_REG, NO_IMM, REGLIST_FLAG) \
+    X(RT_REG, NO_IMM, NO_FLAG) \
+    X(RN_RM_REG, NO_IMM, NO_FLAG) \
+    X(RN_RD_RT_REG, IMM8, NO_FLAG) \
+    X(RN_RD_RT_REG, NO_IMM, NO_FLAG) \
+    X(RN_RD_RT_RT2_REG, NO_IMM, NO_FLAG)
+extern const uint8_t thumb2_extractor_index[864];
+#endif
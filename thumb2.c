@@ -35,11 +35,24 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "thumb-tbl.h"
 #include "thumb2-tbl.h"
 #include "thumb2.h"
+#include "dispatch.h"
 
 #define BITMSK_8 ((1 << 8) - 1)
 #define ROR(val, rotate) (((val) >> (rotate)) | ((val) << (32 - (rotate))))
 #define SIGN_EXTEND32(v, len) (((int32_t)(v) << (32 - len)) >> (32 - len))
 
+// concatenates the immediate fields selected by one of the THUMB2_PEXT_*
+// masks (generated by darmgen.py) of (w << 16) | w2 using a single pext
+// when compiled for BMI2, e.g., with -mbmi2, otherwise the equivalent
+// shifts are used
+#ifdef __BMI2__
+#include <immintrin.h>
+#define THUMB2_FIELDS(w, w2, mask, shifts) \
+    _pext_u32(((uint32_t)(w) << 16) | (w2), (mask))
+#else
+#define THUMB2_FIELDS(w, w2, mask, shifts) (shifts)
+#endif
+
 void thumb2_parse_reg(darm_t *d, uint16_t w, uint16_t w2);
 void thumb2_parse_imm(darm_t *d, uint16_t w, uint16_t w2);
 void thumb2_parse_flag(darm_t *d, uint16_t w, uint16_t w2);
@@ -111,10 +124,12 @@ void thumb2_decode_immshift(darm_t *d, uint8_t type, uint8_t imm5)
     }
 }
 
-// Parse the register instruction type
-void thumb2_parse_reg(darm_t *d, uint16_t w, uint16_t w2)
+// Parse the register instruction type, the type is passed along so that it's
+// folded into straight-line code by the extractors in thumb2_disasm
+static inline void _thumb2_reg(darm_t *d, uint16_t w, uint16_t w2,
+    darm_enctype_t type)
 {
-    switch (d->instr_type) {
+    switch (type) {
     case T_THUMB2_NO_REG:
         break;
 
@@ -202,12 +217,14 @@ void thumb2_parse_reg(darm_t *d, uint16_t w, uint16_t w2)
     }
 }
 
-// Parse the immediate instruction type
-void thumb2_parse_imm(darm_t *d, uint16_t w, uint16_t w2)
+// Parse the immediate instruction type, the type is passed along so that it's
+// folded into straight-line code by the extractors in thumb2_disasm
+static inline void _thumb2_imm(darm_t *d, uint16_t w, uint16_t w2,
+    darm_enctype_t type)
 {
     d->I = B_SET;
 
-    switch (d->instr_imm_type) {
+    switch (type) {
     case T_THUMB2_NO_IMM:
         d->I = B_UNSET;
         break;
@@ -230,19 +247,19 @@ void thumb2_parse_imm(darm_t *d, uint16_t w, uint16_t w2)
     case T_THUMB2_IMM2_IMM3:
         // 2 and 3 bit immediates
         // (imm3:imm2)
-        d->imm = ((w2 >> 10) & b11100) | ((w2 >> 6) & b11);
+        d->imm = THUMB2_FIELDS(w, w2, THUMB2_PEXT_IMM2_IMM3,
+            ((w2 >> 10) & b11100) | ((w2 >> 6) & b11));
         break;
 
     case T_THUMB2_IMM1_IMM3_IMM8:
         // 1, 3 and 8 bit immediates
         // i:imm3:imm8 -> imm12 -> imm32
 
+        d->imm = THUMB2_FIELDS(w, w2, THUMB2_PEXT_IMM1_IMM3_IMM8,
+            ((w & 0x400) << 1) | ((w2 & 0x7000) >> 4) | (w2 & 0xff));
+
         // if bits 9:8 == '10' then zero extend, otherwise thumb expand
-        if((w & 0x300) == 0x200) {
-            d->imm = ((w & 0x400) << 1) | ((w2 & 0x7000) >> 4) | (w2 & 0xff);
-        }
-        else {
-            d->imm = ((w & 0x400) << 1) | ((w2 & 0x7000) >> 4) | (w2 & 0xff);
+        if((w & 0x300) != 0x200) {
             d->imm = thumb_expand_imm(d->imm);
         }
         break;
@@ -252,10 +269,12 @@ void thumb2_parse_imm(darm_t *d, uint16_t w, uint16_t w2)
     }
 }
 
-// Parse the flag instruction type
-void thumb2_parse_flag(darm_t *d, uint16_t w, uint16_t w2)
+// Parse the flag instruction type, the type is passed along so that it's
+// folded into straight-line code by the extractors in thumb2_disasm
+static inline void _thumb2_flag(darm_t *d, uint16_t w, uint16_t w2,
+    darm_enctype_t type)
 {
-    switch (d->instr_flag_type) {
+    switch (type) {
     case T_THUMB2_NO_FLAG:
         break;
 
@@ -310,11 +329,111 @@ void thumb2_parse_flag(darm_t *d, uint16_t w, uint16_t w2)
     }
 }
 
+void thumb2_parse_reg(darm_t *d, uint16_t w, uint16_t w2)
+{
+    _thumb2_reg(d, w, w2, d->instr_type);
+}
+
+void thumb2_parse_imm(darm_t *d, uint16_t w, uint16_t w2)
+{
+    _thumb2_imm(d, w, w2, d->instr_imm_type);
+}
+
+void thumb2_parse_flag(darm_t *d, uint16_t w, uint16_t w2)
+{
+    _thumb2_flag(d, w, w2, d->instr_flag_type);
+}
+
 // Parse misc instruction cases
 void thumb2_parse_misc(darm_t *d, uint16_t w, uint16_t w2)
 {
+#ifdef DARM_THREADED_DISPATCH
+    DISPATCH_TABLE(targets, I_INSTRCNT, misc_other)
+        [I_B] = &&misc_b,
+        [I_BL] = &&misc_bl,
+        [I_BLX] = &&misc_bl,
+        [I_BFC] = &&misc_bfc,
+        [I_BFI] = &&misc_bfc,
+        [I_LSL] = &&misc_lsl,
+        [I_LSR] = &&misc_lsl,
+        [I_ASR] = &&misc_lsl,
+        [I_ROR] = &&misc_lsl,
+        [I_MOVW] = &&misc_movw,
+        [I_MOVT] = &&misc_movw,
+        [I_CMP] = &&misc_cmp,
+        [I_CMN] = &&misc_cmp,
+        [I_TEQ] = &&misc_cmp,
+        [I_TST] = &&misc_cmp,
+        [I_DBG] = &&misc_dbg,
+        [I_DMB] = &&misc_dbg,
+        [I_DSB] = &&misc_dbg,
+        [I_ISB] = &&misc_dbg,
+        [I_LDC] = &&misc_ldc,
+        [I_LDC2] = &&misc_ldc,
+        [I_STC] = &&misc_ldc,
+        [I_STC2] = &&misc_ldc,
+        [I_STREX] = &&misc_strex,
+        [I_LDRD] = &&misc_ldrd,
+        [I_LDREX] = &&misc_ldrd,
+        [I_STRD] = &&misc_ldrd,
+        [I_POP] = &&misc_pop,
+        [I_PUSH] = &&misc_pop,
+        [I_MCR] = &&misc_mcr,
+        [I_MCR2] = &&misc_mcr,
+        [I_MRC] = &&misc_mcr,
+        [I_MRC2] = &&misc_mcr,
+        [I_MCRR] = &&misc_mcrr,
+        [I_MCRR2] = &&misc_mcrr,
+        [I_MRRC] = &&misc_mcrr,
+        [I_MRRC2] = &&misc_mcrr,
+        [I_MSR] = &&misc_msr,
+        [I_PKH] = &&misc_pkh,
+        [I_PLI] = &&misc_pli,
+        [I_PLD] = &&misc_pld,
+        [I_SBFX] = &&misc_sbfx,
+        [I_UBFX] = &&misc_sbfx,
+        [I_SMLABB] = &&misc_smlabb,
+        [I_SMLABT] = &&misc_smlabb,
+        [I_SMLATB] = &&misc_smlabb,
+        [I_SMLATT] = &&misc_smlabb,
+        [I_SMULBB] = &&misc_smlabb,
+        [I_SMULBT] = &&misc_smlabb,
+        [I_SMULTB] = &&misc_smlabb,
+        [I_SMULTT] = &&misc_smlabb,
+        [I_SMLAD] = &&misc_smlad,
+        [I_SMLAW] = &&misc_smlad,
+        [I_SMLSD] = &&misc_smlad,
+        [I_SMUAD] = &&misc_smlad,
+        [I_SMULW] = &&misc_smlad,
+        [I_SMUSD] = &&misc_smlad,
+        [I_SMLALBB] = &&misc_smlalbb,
+        [I_SMLALBT] = &&misc_smlalbb,
+        [I_SMLALTB] = &&misc_smlalbb,
+        [I_SMLALTT] = &&misc_smlalbb,
+        [I_SMLSLD] = &&misc_smlsld,
+        [I_SMLALD] = &&misc_smlsld,
+        [I_SMLAL] = &&misc_smlal,
+        [I_SMULL] = &&misc_smlal,
+        [I_UMAAL] = &&misc_smlal,
+        [I_UMLAL] = &&misc_smlal,
+        [I_UMULL] = &&misc_smlal,
+        [I_SMMLA] = &&misc_smmla,
+        [I_SMMLS] = &&misc_smmla,
+        [I_SMMUL] = &&misc_smmla,
+        [I_SSAT] = &&misc_ssat,
+        [I_USAT] = &&misc_ssat,
+        [I_SSAT16] = &&misc_ssat16,
+        [I_USAT16] = &&misc_ssat16,
+        [I_STM] = &&misc_stm,
+        [I_STMDB] = &&misc_stm,
+        [I_TBB] = &&misc_tbb,
+        [I_TBH] = &&misc_tbb,
+    DISPATCH_END()
+    DISPATCH(targets, d->instr);
+#endif
+
     switch (d->instr) {
-    case I_B:
+    case I_B: DISPATCH_TARGET(misc_b)
         d->I = B_SET;
         d->S = (w >> 10) & 1 ? B_SET : B_UNSET;
         if ((w2 & 0x1000) == 0) {
@@ -324,8 +443,8 @@ void thumb2_parse_misc(darm_t *d, uint16_t w, uint16_t w2)
                 ((w & 0x400) << 10) |
                 ((w2 & 0x800) << 8) |
                 ((w2 & 0x2000) << 5) |
-                ((w & 0x3F) << 12) |
-                ((w2 & 0x7ff) << 1);
+                (THUMB2_FIELDS(w, w2, THUMB2_PEXT_IMM6_IMM11,
+                    ((w & 0x3F) << 11) | (w2 & 0x7ff)) << 1);
             d->imm = SIGN_EXTEND32(d->imm, 21);
             d->cond = (w >> 6) & b1111;
         }
@@ -338,13 +457,13 @@ void thumb2_parse_misc(darm_t *d, uint16_t w, uint16_t w2)
                 ((w & 0x400) << 14) |
                 (((~(w2 >> 13) ^ (w >> 10)) & 1) << 23) |
                 ((~((w2 >> 11) ^ (w >> 10)) & 1) << 22) |
-                ((w & 0x3FF) << 12) |
-                ((w2 & 0x7FF) << 1);
+                (THUMB2_FIELDS(w, w2, THUMB2_PEXT_IMM10_IMM11,
+                    ((w & 0x3FF) << 11) | (w2 & 0x7FF)) << 1);
             d->imm = SIGN_EXTEND32(d->imm, 25);
         }
         break;
 
-    case I_BL: case I_BLX:
+    case I_BL: case I_BLX: DISPATCH_TARGET(misc_bl)
         d->I = B_SET;
         d->S = (w >> 10) & 1 ? B_SET : B_UNSET;
         if ((w2 & 0x1000) == 0) {
@@ -354,8 +473,8 @@ void thumb2_parse_misc(darm_t *d, uint16_t w, uint16_t w2)
                 ((w & 0x400) << 14) |
                 ((~((w2 >> 13) ^ (w >> 10)) & 1) << 23) |
                 ((~((w2 >> 11) ^ (w >> 10)) & 1) << 22) |
-                ((w & 0x3FF) << 12) |
-                ((w2 & 0x7FE) << 1);
+                (THUMB2_FIELDS(w, w2, THUMB2_PEXT_IMM10H_IMM10L,
+                    ((w & 0x3FF) << 10) | ((w2 & 0x7FE) >> 1)) << 2);
             d->imm = SIGN_EXTEND32(d->imm, 25);
             d->H = (w & 1) ? B_SET : B_UNSET;
         }
@@ -366,40 +485,39 @@ void thumb2_parse_misc(darm_t *d, uint16_t w, uint16_t w2)
                 ((w & 0x400) << 14) |
                 (((~((w2 >> 13) ^ (w >> 10))) & 1) << 23) |
                 ((~((w2 >> 11) ^ (w >> 10)) & 1) << 22) |
-                ((w & 0x3FF) << 12) |
-                ((w2 & 0x7FF) << 1);
+                (THUMB2_FIELDS(w, w2, THUMB2_PEXT_IMM10_IMM11,
+                    ((w & 0x3FF) << 11) | (w2 & 0x7FF)) << 1);
             d->imm = SIGN_EXTEND32(d->imm, 25);
         }
         break;
 
-    case I_BFC: case I_BFI:
+    case I_BFC: case I_BFI: DISPATCH_TARGET(misc_bfc)
         d->lsb = d->imm & 0x1f;
         d->msb = w2 & 0x1f;
         d->width = d->msb + 1 - d->lsb;
         break;
 
-    case I_LSL: case I_LSR: case I_ASR: case I_ROR:
+    case I_LSL: case I_LSR: case I_ASR: case I_ROR: DISPATCH_TARGET(misc_lsl)
         if(d->I == B_SET) {
             d->shift = d->imm;
             d->shift_type = ((w2 >> 4) & b11);
         }
         break;
 
-    case I_MOVW: case I_MOVT:
+    case I_MOVW: case I_MOVT: DISPATCH_TARGET(misc_movw)
         d->imm =
             ((w & b1111) << 12) |
-            ((w & 0x400) << 1) |
-            ((w2 & 0x7000) >> 4) |
-            (w2 & 0xff);
+            THUMB2_FIELDS(w, w2, THUMB2_PEXT_IMM1_IMM3_IMM8,
+                ((w & 0x400) << 1) | ((w2 & 0x7000) >> 4) | (w2 & 0xff));
         break;
 
     // preserve PC in Rd for further use (?)
-    case I_CMP: case I_CMN: case I_TEQ: case I_TST:
+    case I_CMP: case I_CMN: case I_TEQ: case I_TST: DISPATCH_TARGET(misc_cmp)
         d->Rd = PC;
         break;
 
     // option field
-    case I_DBG: case I_DMB: case I_DSB: case I_ISB:
+    case I_DBG: case I_DMB: case I_DSB: case I_ISB: DISPATCH_TARGET(misc_dbg)
         d->option = w2 & b1111;
         break;
 
@@ -410,7 +528,7 @@ void thumb2_parse_misc(darm_t *d, uint16_t w, uint16_t w2)
 
     // co-proc load/store memory
     case I_LDC: case I_LDC2:
-    case I_STC: case I_STC2:
+    case I_STC: case I_STC2: DISPATCH_TARGET(misc_ldc)
         d->P = (w >> 8) & 1 ? B_SET : B_UNSET;
         d->U = (w >> 7) & 1 ? B_SET : B_UNSET;
         d->D = (w >> 6) & 1 ? B_SET : B_UNSET;
@@ -426,13 +544,13 @@ void thumb2_parse_misc(darm_t *d, uint16_t w, uint16_t w2)
         break;
 
     // Weird Rd offset
-    case I_STREX:
+    case I_STREX: DISPATCH_TARGET(misc_strex)
         d->Rd = (w2 >> 8) & b1111;
         d->imm = (w2 & 0xff) << 2;
         break;
 
     // zero-extend corner case with '00' appended
-    case I_LDRD: case I_LDREX: case I_STRD:
+    case I_LDRD: case I_LDREX: case I_STRD: DISPATCH_TARGET(misc_ldrd)
         d->imm = (w2 & 0xff) << 2;
         d->W = (w >> 5) & 1 ? B_SET : B_UNSET;
         d->U = (w >> 7) & 1 ? B_SET : B_UNSET;
@@ -440,7 +558,7 @@ void thumb2_parse_misc(darm_t *d, uint16_t w, uint16_t w2)
         break;
 
     // Catch some pop/push inconsistencies
-    case I_POP: case I_PUSH:
+    case I_POP: case I_PUSH: DISPATCH_TARGET(misc_pop)
         // no flags, TODO fixup
         if(w == 0xf85d || w == 0xf84d) {
             break;
@@ -456,7 +574,7 @@ void thumb2_parse_misc(darm_t *d, uint16_t w, uint16_t w2)
 
     // co-processor move
     case I_MCR: case I_MCR2:
-    case I_MRC: case I_MRC2:
+    case I_MRC: case I_MRC2: DISPATCH_TARGET(misc_mcr)
         d->CRm = w2 & b1111;
         d->CRn = w & b1111;
         d->coproc = (w2 >> 8) & b1111;
@@ -467,7 +585,7 @@ void thumb2_parse_misc(darm_t *d, uint16_t w, uint16_t w2)
 
     // co-proc move 2 reg
     case I_MCRR: case I_MCRR2:
-    case I_MRRC: case I_MRRC2:
+    case I_MRRC: case I_MRRC2: DISPATCH_TARGET(misc_mcrr)
         d->coproc = (w2 >> 8) & b1111;
         d->Rt = (w2 >> 12) & b1111;
         d->opc1 = (w2 >> 4) & b1111;
@@ -475,19 +593,19 @@ void thumb2_parse_misc(darm_t *d, uint16_t w, uint16_t w2)
         d->Rt2 = w & b1111;
         break;
 
-    case I_MSR:
+    case I_MSR: DISPATCH_TARGET(misc_msr)
         d->I = B_SET;
         d->Rn = w & b1111;
         d->mask = d->imm = (w2 >> 10) & b11;
         break;
 
-    case I_PKH:
+    case I_PKH: DISPATCH_TARGET(misc_pkh)
         // S flag and immediate already set
         d->T = (w2 >> 4) & 1;
         thumb2_decode_immshift(d, (w2 >> 4) & 2, d->imm);
         break;
 
-    case I_PLI:
+    case I_PLI: DISPATCH_TARGET(misc_pli)
         d->Rt = R_INVLD;
         d->P = B_INVLD;
         d->W = B_INVLD;
@@ -498,7 +616,7 @@ void thumb2_parse_misc(darm_t *d, uint16_t w, uint16_t w2)
         }
         break;
 
-    case I_PLD:
+    case I_PLD: DISPATCH_TARGET(misc_pld)
         d->Rt = R_INVLD;
         d->P = B_INVLD;
         if(d->Rn == b1111) {
@@ -511,20 +629,20 @@ void thumb2_parse_misc(darm_t *d, uint16_t w, uint16_t w2)
         d->W = (w & b1111) != b1111 ? ((w >> 5) & 1) : B_INVLD;
         break;
 
-    case I_SBFX: case I_UBFX:
+    case I_SBFX: case I_UBFX: DISPATCH_TARGET(misc_sbfx)
         d->lsb = d->imm;
         d->width = (w2 & 0x1f) + 1;
         break;
 
     // N, M flags
     case I_SMLABB: case I_SMLABT: case I_SMLATB: case I_SMLATT:
-    case I_SMULBB: case I_SMULBT: case I_SMULTB: case I_SMULTT:
+    case I_SMULBB: case I_SMULBT: case I_SMULTB: case I_SMULTT: DISPATCH_TARGET(misc_smlabb)
         d->N = (w2 >> 5) & 1 ? B_SET : B_UNSET;
         // fall-through
 
     case I_SMLAD: case I_SMLAW:
     case I_SMLSD: case I_SMUAD:
-    case I_SMULW: case I_SMUSD:
+    case I_SMULW: case I_SMUSD: DISPATCH_TARGET(misc_smlad)
         d->M = (w2 >> 4) & 1 ? B_SET : B_UNSET;
         if(d->Ra == b1111) {
             d->Ra = R_INVLD;
@@ -532,47 +650,70 @@ void thumb2_parse_misc(darm_t *d, uint16_t w, uint16_t w2)
         break;
 
     // N, M, Rdhi, Rdlo flags
-    case I_SMLALBB: case I_SMLALBT: case I_SMLALTB: case I_SMLALTT:
+    case I_SMLALBB: case I_SMLALBT: case I_SMLALTB: case I_SMLALTT: DISPATCH_TARGET(misc_smlalbb)
         d->N = (w2 >> 5) & 1 ? B_SET : B_UNSET;
         // fall-through
 
-    case I_SMLSLD: case I_SMLALD:
+    case I_SMLSLD: case I_SMLALD: DISPATCH_TARGET(misc_smlsld)
         d->M = (w2 >> 4) & 1 ? B_SET : B_UNSET;
         // fall-through
 
     case I_SMLAL: case I_SMULL:
-    case I_UMAAL: case I_UMLAL: case I_UMULL:
+    case I_UMAAL: case I_UMLAL: case I_UMULL: DISPATCH_TARGET(misc_smlal)
         d->RdHi = (w2 >> 8) & b1111;
         d->RdLo = (w2 >> 12) & b1111;
         break;
 
-    case I_SMMLA: case I_SMMLS: case I_SMMUL:
+    case I_SMMLA: case I_SMMLS: case I_SMMUL: DISPATCH_TARGET(misc_smmla)
         d->R = (w2 >> 4) & 1 ? B_SET : B_UNSET;
         break;
 
-    case I_SSAT: case I_USAT:
+    case I_SSAT: case I_USAT: DISPATCH_TARGET(misc_ssat)
         thumb2_decode_immshift(d, (w >> 4) & 2, d->imm);
         d->sat_imm = w2 & 0x1f;
         break;
 
-    case I_SSAT16: case I_USAT16:
+    case I_SSAT16: case I_USAT16: DISPATCH_TARGET(misc_ssat16)
         d->sat_imm = w2 & 0xf;
         break;
 
-    case I_STM: case I_STMDB:
+    case I_STM: case I_STMDB: DISPATCH_TARGET(misc_stm)
         d->W = (w >> 5) & 1 ? B_SET : B_UNSET;
         d->M = (w2 >> 14) & 1 ? B_SET : B_UNSET;
         break;
 
-    case I_TBB: case I_TBH:
+    case I_TBB: case I_TBH: DISPATCH_TARGET(misc_tbb)
         d->H = (w2 >> 4) & 1 ? B_SET : B_UNSET;
         break;
 
-    default:
+    default: DISPATCH_TARGET(misc_other)
         break;
     }
 }
 
+typedef void (*thumb2_extractor_t)(darm_t *d, uint16_t w, uint16_t w2);
+
+// one fused operand extractor for each combination of register, immediate
+// and flag type that is used by the thumb2 encodings (see darmgen.py)
+#define THUMB2_EXTRACTOR(reg, imm, flag) \
+    static void thumb2_extract_##reg##_##imm##_##flag(darm_t *d, \
+        uint16_t w, uint16_t w2) \
+    { \
+        _thumb2_reg(d, w, w2, T_THUMB2_##reg); \
+        _thumb2_imm(d, w, w2, T_THUMB2_##imm); \
+        _thumb2_flag(d, w, w2, T_THUMB2_##flag); \
+    }
+
+THUMB2_EXTRACTORS(THUMB2_EXTRACTOR)
+
+#define THUMB2_EXTRACTOR_ENTRY(reg, imm, flag) \
+    &thumb2_extract_##reg##_##imm##_##flag,
+
+// indexed by thumb2_extractor_index, the first entry is the fallback
+static const thumb2_extractor_t g_thumb2_extractors[] = {
+    NULL, THUMB2_EXTRACTORS(THUMB2_EXTRACTOR_ENTRY)
+};
+
 static int thumb2_disasm(darm_t *d, uint16_t w, uint16_t w2)
 {
     d->instr = thumb2_decode_instruction(d, w, w2);
@@ -580,11 +721,30 @@ static int thumb2_disasm(darm_t *d, uint16_t w, uint16_t w2)
         return -1;
     }
 
-    thumb2_parse_reg(d, w, w2);
-    thumb2_parse_imm(d, w, w2);
-    thumb2_parse_flag(d, w, w2);
+    uint32_t reg = d->instr_type - T_THUMB2_NO_REG;
+    uint32_t imm = d->instr_imm_type - T_THUMB2_NO_IMM;
+    uint32_t flag = d->instr_flag_type - T_THUMB2_NO_FLAG;
+
+    // a single table lookup selects the extractor which parses all operand
+    // types at once, other combinations go through the generic functions
+    uint32_t index = 0;
+    if(reg < THUMB2_REG_TYPES && imm < THUMB2_IMM_TYPES &&
+            flag < THUMB2_FLAG_TYPES) {
+        index = thumb2_extractor_index[
+            (reg * THUMB2_IMM_TYPES + imm) * THUMB2_FLAG_TYPES + flag];
+    }
+
+    if(index != 0) {
+        g_thumb2_extractors[index](d, w, w2);
+    }
+    else {
+        thumb2_parse_reg(d, w, w2);
+        thumb2_parse_imm(d, w, w2);
+        thumb2_parse_flag(d, w, w2);
+    }
     thumb2_parse_misc(d, w, w2);
     d->instr_type = T_INVLD;
+    darm_regs_update(d);
     return 0;
 }
 
@@ -0,0 +1,304 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+benchdarm measures the decoders on a corpus of flat ARM or Thumb code, e.g.,
+the .text section of a firmware image (objcopy -O binary -j .text), as the
+time and the amount of mispredicted branches per instruction. The hash of the
+decoded instructions makes sure that builds with different options, such as
+DARM_THREADED_DISPATCH, disassemble the corpus identically.
+
+*/
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include "darm.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#define FNV_OFFSET 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+
+typedef struct _bench_t {
+    uint64_t    insns;
+    uint64_t    valid;
+    uint64_t    misses;
+    double      seconds;
+    uint64_t    hash;
+} bench_t;
+
+static const uint8_t *map_file(const char *fname, uint32_t *len)
+{
+#ifndef _WIN32
+    int fd = open(fname, O_RDONLY);
+    if(fd < 0) return NULL;
+
+    struct stat st;
+    if(fstat(fd, &st) < 0 || st.st_size == 0 || st.st_size > 0xffffffff) {
+        close(fd);
+        return NULL;
+    }
+
+    void *ptr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(ptr == MAP_FAILED) return NULL;
+
+    *len = st.st_size;
+    return ptr;
+#else
+    FILE *fp = fopen(fname, "rb");
+    if(fp == NULL) return NULL;
+
+    fseek(fp, 0, SEEK_END);
+    *len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    uint8_t *buf = *len != 0 ? malloc(*len) : NULL;
+    if(buf != NULL && fread(buf, 1, *len, fp) != *len) {
+        free(buf), buf = NULL;
+    }
+    fclose(fp);
+    return buf;
+#endif
+}
+
+// counts the mispredicted branches of this thread, returns -1 if the
+// counter is not available (e.g., no permission or not on linux)
+static int misses_open()
+{
+#ifdef __linux__
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
+
+static void misses_start(int fd)
+{
+#ifdef __linux__
+    if(fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#else
+    (void) fd;
+#endif
+}
+
+static uint64_t misses_stop(int fd)
+{
+    uint64_t value = 0;
+#ifdef __linux__
+    if(fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if(read(fd, &value, sizeof(value)) != sizeof(value)) {
+            value = 0;
+        }
+    }
+#else
+    (void) fd;
+#endif
+    return value;
+}
+
+static uint64_t hash_insn(uint64_t hash, const darm_t *d)
+{
+    uint32_t fields[] = {
+        d->instr, d->cond, d->Rd, d->Rn, d->Rm, d->Rt, d->imm,
+        d->shift_type, d->shift, d->reglist,
+    };
+
+    for (uint32_t idx = 0; idx < ARRAYSIZE(fields); idx++) {
+        hash = (hash ^ fields[idx]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+static void bench_arm(const uint8_t *buf, uint32_t len, bench_t *b)
+{
+    darm_t d;
+
+    for (uint32_t off = 0; off + 4 <= len; off += 4) {
+        uint32_t w;
+        memcpy(&w, &buf[off], sizeof(w));
+
+        b->insns++;
+        if(darm_armv7_disasm(&d, w) == 0) {
+            b->valid++;
+            b->hash = hash_insn(b->hash, &d);
+        }
+    }
+}
+
+static void bench_thumb(const uint8_t *buf, uint32_t len, bench_t *b)
+{
+    darm_t d;
+
+    for (uint32_t off = 0; off + 2 <= len;) {
+        uint16_t w, w2 = 0;
+        memcpy(&w, &buf[off], sizeof(w));
+        if(off + 4 <= len) {
+            memcpy(&w2, &buf[off + 2], sizeof(w2));
+        }
+
+        b->insns++;
+        if(darm_disasm_inline(&d, w, w2, off | 1) > 0) {
+            b->valid++;
+            b->hash = hash_insn(b->hash, &d);
+        }
+        off += darm_insn_length(w, 1) * 2;
+    }
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+        "benchdarm - Decoder benchmark on flat ARM/Thumb code      "
+                                        "(C) Jurriaan Bremer, 2013\n"
+        "\n"
+        "Usage: %s [options] <files..>\n"
+        "\n"
+        "Options:\n"
+        "  --thumb          the files contain Thumb/Thumb2 code\n"
+        "  --rounds <n>     disassemble every file <n> times (default 10)\n",
+        prog
+    );
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t rounds = 10;
+    int thumb = 0, first = argc;
+
+    for (int idx = 1; idx < argc; idx++) {
+        const char *arg = argv[idx];
+        int has_value = idx + 1 < argc;
+
+        if(!strcmp(arg, "--thumb")) {
+            thumb = 1;
+        }
+        else if(!strcmp(arg, "--rounds") && has_value) {
+            rounds = strtoul(argv[++idx], NULL, 0);
+        }
+        else if(arg[0] == '-') {
+            usage(argv[0]);
+            return 1;
+        }
+        else {
+            first = idx;
+            break;
+        }
+    }
+
+    if(first == argc || rounds == 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    bench_t b;
+    memset(&b, 0, sizeof(b));
+    b.hash = FNV_OFFSET;
+
+    int fd = misses_open();
+
+    for (int idx = first; idx < argc; idx++) {
+        uint32_t len;
+        const uint8_t *buf = map_file(argv[idx], &len);
+        if(buf == NULL) {
+            fprintf(stderr, "Error opening file: %s\n", argv[idx]);
+            return 1;
+        }
+
+        for (uint32_t round = 0; round < rounds; round++) {
+            bench_t one;
+            memset(&one, 0, sizeof(one));
+            one.hash = b.hash;
+
+            clock_t start = clock();
+            misses_start(fd);
+
+            if(thumb != 0) {
+                bench_thumb(buf, len, &one);
+            }
+            else {
+                bench_arm(buf, len, &one);
+            }
+
+            b.misses += misses_stop(fd);
+            b.seconds += (double)(clock() - start) / CLOCKS_PER_SEC;
+            b.insns += one.insns, b.valid += one.valid;
+
+            // every round decodes the same instructions
+            if(round == rounds - 1) {
+                b.hash = one.hash;
+            }
+        }
+    }
+
+    if(b.insns == 0) {
+        fprintf(stderr, "No instructions in the corpus\n");
+        return 1;
+    }
+
+    printf("%-8s %llu instructions, %.1f%% valid\n",
+        thumb != 0 ? "thumb" : "arm", (unsigned long long) b.insns,
+        100.0 * b.valid / b.insns);
+    printf("time     %.2f ns/instruction\n", 1e9 * b.seconds / b.insns);
+    if(fd >= 0) {
+        printf("misses   %.4f branch-misses/instruction\n",
+            (double) b.misses / b.insns);
+    }
+    else {
+        printf("misses   n/a (no branch-miss counter available)\n");
+    }
+    printf("hash     %016llx\n", (unsigned long long) b.hash);
+    return 0;
+}
@@ -0,0 +1,611 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+
+bindarm is the sibling of elfdarm for images that don't come with an ELF
+header, i.e., flat binary dumps and Intel HEX files as they are typically
+pulled from microcontrollers.
+
+*/
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include "darm.h"
+#include "data.h"
+#include "fold.h"
+#include "gadget.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <pthread.h>
+#endif
+
+// amount of instructions that are decoded before they're formatted
+#define BATCHSIZE 4096
+
+// size of the output buffer, flushed whenever it's (nearly) full
+#define OUTBUFSIZE (1024 * 1024)
+
+// maximum amount of instructions per gadget, a formatted gadget has to fit
+// in the output buffer
+#define MAXDEPTH 256
+
+static struct {
+    darm_t   d;
+    uint32_t addr;
+    uint32_t w;
+    int      len; // -1 for literal pools and jump tables
+
+    // the constant that is completed by a MOVT, if any
+    int      folded;
+    uint32_t value;
+} g_batch[BATCHSIZE];
+
+static char g_out[OUTBUFSIZE];
+static uint32_t g_outlen;
+
+static void out_flush()
+{
+    fwrite(g_out, 1, g_outlen, stdout);
+    g_outlen = 0;
+}
+
+static const uint8_t *map_file(const char *fname, uint32_t *len)
+{
+#ifndef _WIN32
+    int fd = open(fname, O_RDONLY);
+    if(fd < 0) return NULL;
+
+    struct stat st;
+    if(fstat(fd, &st) < 0 || st.st_size == 0 || st.st_size > 0xffffffff) {
+        close(fd);
+        return NULL;
+    }
+
+    void *ptr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(ptr == MAP_FAILED) return NULL;
+
+    // we walk the image front to back exactly once
+    madvise(ptr, st.st_size, MADV_SEQUENTIAL);
+
+    *len = st.st_size;
+    return ptr;
+#else
+    FILE *fp = fopen(fname, "rb");
+    if(fp == NULL) return NULL;
+
+    fseek(fp, 0, SEEK_END);
+    *len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    uint8_t *buf = *len != 0 ? malloc(*len) : NULL;
+    if(buf != NULL && fread(buf, 1, *len, fp) != *len) {
+        free(buf), buf = NULL;
+    }
+    fclose(fp);
+    return buf;
+#endif
+}
+
+static int hex_nibble(uint8_t ch)
+{
+    if(ch >= '0' && ch <= '9') return ch - '0';
+    if(ch >= 'a' && ch <= 'f') return ch - 'a' + 10;
+    if(ch >= 'A' && ch <= 'F') return ch - 'A' + 10;
+    return -1;
+}
+
+static int hex_byte(const uint8_t *p)
+{
+    int hi = hex_nibble(p[0]), lo = hex_nibble(p[1]);
+    return hi < 0 || lo < 0 ? -1 : (hi << 4) | lo;
+}
+
+// parses the Intel HEX records in buf, if out is NULL then only the lowest
+// and highest address are determined, otherwise the data records are
+// written into out, which starts at address lo
+static int ihex_parse(const uint8_t *buf, uint32_t len, uint8_t *out,
+    uint32_t *lo, uint32_t *hi)
+{
+    uint32_t upper = 0, off = 0;
+    uint8_t rec[256 + 5];
+
+    if(out == NULL) {
+        *lo = 0xffffffff, *hi = 0;
+    }
+
+    while (off < len) {
+        // skip any whitespace between the records
+        if(buf[off] != ':') {
+            if(buf[off] == '\r' || buf[off] == '\n' || buf[off] == ' ') {
+                off++;
+                continue;
+            }
+            return -1;
+        }
+
+        // count, address (two bytes), type, data, and checksum
+        int count = off + 3 <= len ? hex_byte(&buf[off + 1]) : -1;
+        if(count < 0 || off + 1 + (count + 5) * 2 > len) return -1;
+
+        uint8_t sum = 0;
+        for (int idx = 0; idx < count + 5; idx++) {
+            int value = hex_byte(&buf[off + 1 + idx * 2]);
+            if(value < 0) return -1;
+            sum += rec[idx] = value;
+        }
+        if(sum != 0) return -1;
+
+        off += 1 + (count + 5) * 2;
+
+        uint32_t addr = upper + ((rec[1] << 8) | rec[2]);
+        switch (rec[3]) {
+        case 0x00:
+            if(count == 0) break;
+
+            if(out == NULL) {
+                if(addr < *lo) *lo = addr;
+                if(addr + count > *hi) *hi = addr + count;
+            }
+            else {
+                memcpy(&out[addr - *lo], &rec[4], count);
+            }
+            break;
+
+        case 0x01:
+            return 0;
+
+        case 0x02:
+            // extended segment address
+            upper = ((rec[4] << 8) | rec[5]) << 4;
+            break;
+
+        case 0x04:
+            // extended linear address
+            upper = ((rec[4] << 8) | rec[5]) << 16;
+            break;
+
+        case 0x03: case 0x05:
+            // start addresses, not relevant for disassembling
+            break;
+
+        default:
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void format_batch(uint32_t count, int thumb)
+{
+    darm_str_t str;
+
+    for (uint32_t idx = 0; idx < count; idx++) {
+        if(g_outlen > OUTBUFSIZE - 128) {
+            out_flush();
+        }
+
+        char *out = &g_out[g_outlen];
+        const char *fmt = !thumb || g_batch[idx].len == 2 ?
+            "#%06x %08x " : "#%06x     %04x ";
+
+        out += sprintf(out, fmt, g_batch[idx].addr, g_batch[idx].w);
+
+        if(g_batch[idx].len < 0) {
+            out += sprintf(out, "(data)\n");
+        }
+        else if(g_batch[idx].len == 0 ||
+                darm_str2(&g_batch[idx].d, &str, 1) < 0) {
+            out += sprintf(out, "(..)\n");
+        }
+        else if(g_batch[idx].folded != 0) {
+            out += sprintf(out, "%s ; 0x%08x\n", str.total,
+                g_batch[idx].value);
+        }
+        else {
+            out += sprintf(out, "%s\n", str.total);
+        }
+
+        g_outlen = out - g_out;
+    }
+}
+
+static int disasm_image(const uint8_t *buf, uint32_t len, uint32_t base,
+    int thumb)
+{
+    uint32_t off = 0, step = thumb ? 2 : 4;
+    darm_data_t data;
+    darm_fold_t fold;
+    darm_it_t it;
+
+    // literal pools and jump tables are referenced before they're reached
+    if(darm_data_init(&data, base, len) < 0) {
+        return -1;
+    }
+
+    darm_it_init(&it);
+    darm_fold_init(&fold, 0);
+
+    while (off + step <= len) {
+        uint32_t count = 0;
+
+        for (; count < BATCHSIZE && off + step <= len; count++) {
+            uint16_t w = buf[off] | (buf[off + 1] << 8), w2 = 0;
+            if(off + 4 <= len) {
+                w2 = buf[off + 2] | (buf[off + 3] << 8);
+            }
+
+            g_batch[count].addr = base + off;
+
+            // a pending movw doesn't carry over literal pools, jump tables,
+            // or undecodable words
+            if(darm_data_get(&data, base + off)) {
+                darm_fold_reset(&fold);
+                g_batch[count].len = -1;
+                g_batch[count].w = thumb ? w : (w2 << 16) | w;
+                off += step;
+                continue;
+            }
+
+            // a thumb2 prefix in the last halfword of the image would run
+            // past its end, so it's undecodable
+            if(thumb != 0 && off + darm_insn_length(w, 1) * 2 > len) {
+                g_batch[count].len = 0;
+            }
+            else {
+                g_batch[count].len = darm_disasm_it(&it, &g_batch[count].d,
+                    w, w2, (base + off) | thumb);
+            }
+
+            g_batch[count].folded = 0;
+            if(g_batch[count].len != 0) {
+                darm_const_t c;
+
+                darm_data_mark(&data, &g_batch[count].d, (base + off) | thumb);
+
+                if(darm_fold_step(&fold, &g_batch[count].d, base + off,
+                        &c) != 0) {
+                    g_batch[count].folded = 1;
+                    g_batch[count].value = c.value;
+                }
+            }
+            else {
+                darm_fold_reset(&fold);
+            }
+
+            // for undecodable instructions we step over a single halfword
+            // in thumb mode, just like the cpu would
+            if(g_batch[count].len == 2) {
+                g_batch[count].w = thumb ? (w << 16) | w2 : (w2 << 16) | w;
+                off += 4;
+            }
+            else {
+                g_batch[count].w = thumb ? w : (w2 << 16) | w;
+                off += thumb ? 2 : 4;
+            }
+        }
+
+        format_batch(count, thumb);
+    }
+
+    out_flush();
+    darm_data_free(&data);
+    return 0;
+}
+
+typedef struct _gadget_job_t {
+    const uint8_t  *buf;
+    uint32_t       len;
+    uint32_t       base;
+    uint32_t       start;
+    uint32_t       end;
+    uint32_t       depth;
+    darm_gadgets_t gadgets;
+    int            ret;
+#ifndef _WIN32
+    pthread_t      tid;
+    int            started;
+#endif
+} gadget_job_t;
+
+static void *gadget_thread(void *arg)
+{
+    gadget_job_t *job = (gadget_job_t *) arg;
+    job->ret = darm_gadgets_find(&job->gadgets, job->buf, job->len,
+        job->base, job->start, job->end, job->depth);
+    return NULL;
+}
+
+static void format_gadget(const uint8_t *buf, uint32_t base,
+    const darm_gadget_t *gadget)
+{
+    uint32_t off = (gadget->addr & ~1) - base, end = off + gadget->size;
+    darm_str_t str; darm_t d;
+
+    // the address, and for each instruction its string and the separator
+    uint32_t size = 16 + gadget->count * (sizeof(str.total) + 4);
+    if(g_outlen + size > OUTBUFSIZE) {
+        out_flush();
+    }
+
+    char *out = &g_out[g_outlen];
+    out += sprintf(out, "#%06x ", gadget->addr);
+
+    while (off < end) {
+        int ret = darm_disasm_buf(&d, buf + off, end - off,
+            (base + off) | (gadget->addr & 1));
+        if(ret == 0) break;
+
+        if(darm_str2(&d, &str, 1) < 0) {
+            sprintf(str.total, "(%08x)", d.w);
+        }
+
+        out += sprintf(out, off == (gadget->addr & ~1) - base ?
+            "%s" : " ; %s", str.total);
+        off += gadget->addr & 1 ? ret * 2 : 4;
+    }
+
+    *out++ = '\n';
+    g_outlen = out - g_out;
+}
+
+// splits the image into one region per thread, the gadgets of the regions
+// are merged in order so the output doesn't depend on the thread count
+static int gadget_image(const uint8_t *buf, uint32_t len, uint32_t base,
+    uint32_t depth, uint32_t threads)
+{
+    gadget_job_t *jobs = calloc(threads, sizeof(gadget_job_t));
+    if(jobs == NULL) return -1;
+
+    uint32_t region = ((len / threads) + 3) & ~3, ret = 0;
+
+    for (uint32_t idx = 0; idx < threads; idx++) {
+        jobs[idx].buf = buf, jobs[idx].len = len, jobs[idx].base = base;
+        jobs[idx].start = idx * region < len ? idx * region : len;
+        jobs[idx].end = len - jobs[idx].start < region ?
+            len : jobs[idx].start + region;
+        jobs[idx].depth = depth;
+        darm_gadgets_init(&jobs[idx].gadgets);
+    }
+
+#ifndef _WIN32
+    // the first region is handled by this thread, as are the regions for
+    // which no thread could be created
+    for (uint32_t idx = 1; idx < threads; idx++) {
+        jobs[idx].started = pthread_create(&jobs[idx].tid, NULL,
+            &gadget_thread, &jobs[idx]) == 0;
+        if(jobs[idx].started == 0) {
+            gadget_thread(&jobs[idx]);
+        }
+    }
+
+    gadget_thread(&jobs[0]);
+
+    for (uint32_t idx = 1; idx < threads; idx++) {
+        if(jobs[idx].started != 0) {
+            pthread_join(jobs[idx].tid, NULL);
+        }
+    }
+#else
+    for (uint32_t idx = 0; idx < threads; idx++) {
+        gadget_thread(&jobs[idx]);
+    }
+#endif
+
+    for (uint32_t idx = 0; idx < threads; idx++) {
+        if(jobs[idx].ret < 0 || (idx != 0 && darm_gadgets_merge(
+                &jobs[0].gadgets, &jobs[idx].gadgets) < 0)) {
+            ret = -1;
+        }
+        if(idx != 0) {
+            darm_gadgets_free(&jobs[idx].gadgets);
+        }
+    }
+
+    for (uint32_t idx = 0; ret == 0 && idx < jobs[0].gadgets.count; idx++) {
+        format_gadget(buf, base, &jobs[0].gadgets.gadget[idx]);
+    }
+
+    out_flush();
+    darm_gadgets_free(&jobs[0].gadgets);
+    free(jobs);
+    return ret;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+        "bindarm - Utility for dumping raw ARMv7/Thumb images   "
+                                        "(C) Jurriaan Bremer, 2013\n"
+        "\n"
+        "Usage: %s [options] <binfile>\n"
+        "\n"
+        "Options:\n"
+        "  --base <addr>    load address of a raw image (default 0)\n"
+        "  --arm            disassemble as ARMv7 (default)\n"
+        "  --thumb          disassemble as Thumb/Thumb2\n"
+        "  --offset <off>   skip the first <off> bytes of the image\n"
+        "  --length <len>   disassemble at most <len> bytes\n"
+        "  --ihex           input is Intel HEX (detected by default)\n"
+        "  --raw            input is a flat binary\n"
+        "  --gadgets        list the ARMv7 and Thumb ROP/JOP gadgets\n"
+        "  --depth <n>      gadgets have at most <n> instructions (default 6,\n"
+        "                   at most 256)\n"
+        "  --threads <n>    search gadgets with <n> threads (default: cpus)\n",
+        prog
+    );
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t base = 0, offset = 0, length = 0xffffffff, len;
+    uint32_t depth = 6, threads = 0;
+    int thumb = 0, ihex = -1, gadgets = 0;
+    const char *fname = NULL;
+
+    for (int idx = 1; idx < argc; idx++) {
+        const char *arg = argv[idx];
+        int has_value = idx + 1 < argc;
+
+        if(!strcmp(arg, "--arm")) {
+            thumb = 0;
+        }
+        else if(!strcmp(arg, "--thumb")) {
+            thumb = 1;
+        }
+        else if(!strcmp(arg, "--ihex")) {
+            ihex = 1;
+        }
+        else if(!strcmp(arg, "--raw")) {
+            ihex = 0;
+        }
+        else if(!strcmp(arg, "--gadgets")) {
+            gadgets = 1;
+        }
+        else if(!strcmp(arg, "--depth") && has_value) {
+            depth = strtoul(argv[++idx], NULL, 0);
+        }
+        else if(!strcmp(arg, "--threads") && has_value) {
+            threads = strtoul(argv[++idx], NULL, 0);
+        }
+        else if(!strcmp(arg, "--base") && has_value) {
+            base = strtoul(argv[++idx], NULL, 0);
+        }
+        else if(!strcmp(arg, "--offset") && has_value) {
+            offset = strtoul(argv[++idx], NULL, 0);
+        }
+        else if(!strcmp(arg, "--length") && has_value) {
+            length = strtoul(argv[++idx], NULL, 0);
+        }
+        else if(arg[0] == '-' || fname != NULL) {
+            usage(argv[0]);
+            return 1;
+        }
+        else {
+            fname = arg;
+        }
+    }
+
+    if(fname == NULL) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    const uint8_t *buf = map_file(fname, &len);
+    if(buf == NULL) {
+        fprintf(stderr, "[-] Error mapping the input file!\n");
+        return 1;
+    }
+
+    const uint8_t *image = buf;
+
+    // Intel HEX files always start with a colon
+    if(ihex == 1 || (ihex == -1 && buf[0] == ':')) {
+        uint32_t lo, hi;
+        if(ihex_parse(buf, len, NULL, &lo, &hi) < 0 || lo >= hi) {
+            fprintf(stderr, "[-] Invalid Intel HEX file!\n");
+            return 1;
+        }
+
+        // gaps between the records are treated as erased flash
+        uint8_t *flat = malloc(hi - lo);
+        if(flat == NULL) {
+            fprintf(stderr, "[-] Error allocating memory!\n");
+            return 1;
+        }
+
+        memset(flat, 0xff, hi - lo);
+        ihex_parse(buf, len, flat, &lo, &hi);
+
+        image = flat, len = hi - lo, base = lo;
+    }
+
+    if(offset >= len) {
+        fprintf(stderr, "[-] Offset lies outside of the image!\n");
+        return 1;
+    }
+
+    if(length > len - offset) {
+        length = len - offset;
+    }
+
+    if(gadgets != 0) {
+        // both ARMv7 and Thumb terminators are searched for
+        if(((base + offset) & 3) != 0 || depth == 0) {
+            fprintf(stderr, "[-] Unaligned start address or zero depth!\n");
+            return 1;
+        }
+
+        if(depth > MAXDEPTH) {
+            fprintf(stderr, "[-] Depth is limited to %d instructions!\n",
+                MAXDEPTH);
+            return 1;
+        }
+
+#ifndef _WIN32
+        if(threads == 0) {
+            long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+            threads = cpus > 0 ? cpus : 1;
+        }
+#endif
+        if(threads == 0) {
+            threads = 1;
+        }
+
+        // there's no point in regions smaller than a page
+        if(threads > length / 4096 + 1) {
+            threads = length / 4096 + 1;
+        }
+
+        if(gadget_image(image + offset, length, base + offset, depth,
+                threads) < 0) {
+            fprintf(stderr, "[-] Error allocating memory!\n");
+            return 1;
+        }
+        return 0;
+    }
+
+    // make sure the window starts on an instruction boundary
+    if(thumb != 0 ? (base + offset) & 1 : (base + offset) & 3) {
+        fprintf(stderr, "[-] Unaligned start address!\n");
+        return 1;
+    }
+
+    if(disasm_image(image + offset, length, base + offset, thumb) < 0) {
+        fprintf(stderr, "[-] Error allocating memory!\n");
+        return 1;
+    }
+    return 0;
+}
@@ -37,6 +37,9 @@ binary without caring too much about messed up ELF header files.
 #include <string.h>
 #include <stdlib.h>
 #include "darm.h"
+#include "descent.h"
+#include "funcs.h"
+#include "stack.h"
 #include "elfdarm.h"
 
 // TODO add an ignore switch
@@ -53,6 +56,14 @@ binary without caring too much about messed up ELF header files.
 static const uint8_t *g_buf;
 static uint32_t g_len;
 
+// recursive descent mode, only disassemble code that's reachable from the
+// entry point, the function symbols, and the .ARM.exidx function starts
+static int g_recursive;
+static darm_funcs_t g_funcs;
+
+// stack mode, print the maximum stack depth of each function
+static int g_stack;
+
 static int parse_code_section(uint32_t vaddr, uint32_t offset, uint32_t size)
 {
     // TODO improve this, big time :')
@@ -78,6 +89,159 @@ static int parse_code_section(uint32_t vaddr, uint32_t offset, uint32_t size)
     return 0;
 }
 
+// the function starts inside of a segment, without any symbols this falls
+// back to scanning for function prologues in the instruction set of the
+// entry point
+static int segment_funcs(darm_funcs_t *funcs, uint32_t vaddr,
+    uint32_t offset, uint32_t size)
+{
+    if(g_funcs.count == 1 && darm_funcs_scan(funcs, &g_buf[offset], size,
+            vaddr | (g_funcs.start[0] & 1)) < 0) {
+        return -1;
+    }
+
+    for (uint32_t idx = 0; idx < g_funcs.count; idx++) {
+        if((g_funcs.start[idx] & ~1) >= vaddr &&
+                (g_funcs.start[idx] & ~1) - vaddr < size &&
+                darm_funcs_add(funcs, g_funcs.start[idx]) < 0) {
+            return -1;
+        }
+    }
+
+    darm_funcs_sort(funcs);
+    return 0;
+}
+
+static int parse_code_recursive(uint32_t vaddr, uint32_t offset,
+    uint32_t size)
+{
+    darm_rd_t rd; darm_t d; darm_str_t str; darm_it_t it; darm_funcs_t funcs;
+
+    darm_funcs_init(&funcs);
+    if(darm_rd_init(&rd, &g_buf[offset], size, vaddr) < 0 ||
+            segment_funcs(&funcs, vaddr, offset, size) < 0) {
+        fprintf(stderr, "[-] Error allocating memory!\n");
+        darm_funcs_free(&funcs);
+        darm_rd_free(&rd);
+        return -1;
+    }
+
+    for (uint32_t idx = 0; idx < funcs.count; idx++) {
+        darm_rd_seed(&rd, funcs.start[idx]);
+    }
+    darm_funcs_free(&funcs);
+
+    if(darm_rd_run(&rd) < 0) {
+        fprintf(stderr, "[-] Error allocating memory!\n");
+        darm_rd_free(&rd);
+        return -1;
+    }
+
+    darm_it_init(&it);
+
+    for (uint32_t off = 0; off < size; off += 2) {
+        int mode = darm_rd_visited(&rd, vaddr + off);
+        if(mode == 0) continue;
+
+        int ret = darm_disasm_buf(&d, &g_buf[offset + off], size - off,
+            (vaddr + off) | (mode == 2));
+
+        // the IT block state only carries over between thumb instructions
+        if(mode == 2) {
+            darm_it_apply(&it, &d, ret);
+        }
+        else {
+            darm_it_init(&it);
+        }
+
+        if(darm_str2(&d, &str, 1) < 0) {
+            printf("#%06x %08x (..)\n", vaddr + off, d.w);
+            continue;
+        }
+
+        printf("#%06x %08x %s\n", vaddr + off, d.w, str.total);
+    }
+
+    darm_rd_free(&rd);
+    return 0;
+}
+
+static int parse_code_stack(uint32_t vaddr, uint32_t offset, uint32_t size)
+{
+    darm_stack_t s; darm_funcs_t funcs;
+
+    darm_funcs_init(&funcs);
+    if(darm_stack_init(&s, &g_buf[offset], size, vaddr) < 0 ||
+            segment_funcs(&funcs, vaddr, offset, size) < 0) {
+        fprintf(stderr, "[-] Error allocating memory!\n");
+        darm_funcs_free(&funcs);
+        darm_stack_free(&s);
+        return -1;
+    }
+
+    for (uint32_t idx = 0; idx < funcs.count; idx++) {
+        int32_t depth = darm_stack_analyze(&s, funcs.start[idx]);
+        if(depth < 0) {
+            fprintf(stderr, "[-] Error allocating memory!\n");
+            break;
+        }
+
+        printf("#%06x %5d bytes%s%s\n", funcs.start[idx] & ~1, depth,
+            s.unknown != 0 ? " (unknown sp)" : "",
+            s.mismatch != 0 ? " (unbalanced)" : "");
+    }
+
+    darm_funcs_free(&funcs);
+    darm_stack_free(&s);
+    return 0;
+}
+
+static int parse_symbols(const uint8_t *buf)
+{
+    elf32_header_t *hdr = (elf32_header_t *) buf;
+
+    // the entry point is the first seed, and each function symbol and
+    // .ARM.exidx entry is another one
+    if(darm_funcs_add(&g_funcs, hdr->e_entry) < 0) return -1;
+
+    uint32_t sh_off = hdr->e_shoff;
+    for (uint32_t idx = 0; sh_off != 0 && idx < hdr->e_shnum;
+            idx++, sh_off += sizeof(elf32_sheader_t)) {
+        CHK(sh_off, sizeof(elf32_sheader_t), "ELF Section Header");
+
+        const elf32_sheader_t *shdr = (elf32_sheader_t *) &buf[sh_off];
+        if(shdr->sh_type == SHT_ARM_EXIDX) {
+            CHK(shdr->sh_offset, shdr->sh_size, "Exception Index Table");
+
+            if(darm_funcs_exidx(&g_funcs, &buf[shdr->sh_offset],
+                    shdr->sh_size, shdr->sh_addr) < 0) {
+                fprintf(stderr, "[-] Invalid exception index table..\n");
+            }
+            continue;
+        }
+
+        if(shdr->sh_type != SHT_SYMTAB && shdr->sh_type != SHT_DYNSYM) {
+            continue;
+        }
+
+        CHK(shdr->sh_offset, shdr->sh_size, "Symbol Table");
+
+        uint32_t count = shdr->sh_size / sizeof(elf32_sym_t);
+
+        const elf32_sym_t *sym = (elf32_sym_t *) &buf[shdr->sh_offset];
+        for (uint32_t sym_idx = 0; sym_idx < count; sym_idx++) {
+            if(ELF32_ST_TYPE(sym[sym_idx].st_info) == STT_FUNC &&
+                    sym[sym_idx].st_value != 0 &&
+                    darm_funcs_add(&g_funcs, sym[sym_idx].st_value) < 0) {
+                return -1;
+            }
+        }
+    }
+
+    darm_funcs_sort(&g_funcs);
+    return 0;
+}
+
 static int parse_program_header(const elf32_pheader_t *phdr)
 {
     // let's see if we're interested in this section - is it executable?
@@ -88,6 +252,16 @@ static int parse_program_header(const elf32_pheader_t *phdr)
     printf("offset: 0x%08x, filesz: 0x%08x, vaddr: 0x%08x\n",
         phdr->p_offset, phdr->p_filesz, phdr->p_vaddr);
 
+    if(g_stack != 0) {
+        return parse_code_stack(phdr->p_vaddr, phdr->p_offset,
+            phdr->p_filesz);
+    }
+
+    if(g_recursive != 0) {
+        return parse_code_recursive(phdr->p_vaddr, phdr->p_offset,
+            phdr->p_filesz);
+    }
+
     parse_code_section(phdr->p_vaddr, phdr->p_offset, phdr->p_filesz);
     return 0;
 }
@@ -97,6 +271,11 @@ static int parse_elf_header(const uint8_t *buf)
     CHK(0, sizeof(elf32_header_t), "ELF Header");
     elf32_header_t *hdr = (elf32_header_t *) buf;
 
+    if((g_recursive != 0 || g_stack != 0) && parse_symbols(buf) < 0) {
+        fprintf(stderr, "[-] Error parsing the symbol tables!\n");
+        return -1;
+    }
+
     uint32_t ph_off = hdr->e_phoff;
     for (uint32_t idx = 0; idx < hdr->e_phnum;
             idx++, ph_off += sizeof(elf32_pheader_t)) {
@@ -109,12 +288,25 @@ static int parse_elf_header(const uint8_t *buf)
 
 int main(int argc, char *argv[])
 {
+    if(argc > 2 && !strcmp(argv[1], "-r")) {
+        g_recursive = 1;
+        argv++, argc--;
+    }
+    else if(argc > 2 && !strcmp(argv[1], "-s")) {
+        g_stack = 1;
+        argv++, argc--;
+    }
+
     if(argc < 2) {
         fprintf(stderr,
             "elfdarm - Utility for dumping ARMv7 ELF files   "
                                         "(C) Jurriaan Bremer, 2013\n"
             "\n"
-            "Usage: %s <binfile>\n", argv[0]
+            "Usage: %s [-r|-s] <binfile>\n"
+            "\n"
+            "  -r   recursive descent, only disassemble code reachable from\n"
+            "       the entry point and function symbols\n"
+            "  -s   print the maximum stack depth of each function\n", argv[0]
         );
         return 1;
     }
@@ -31,6 +31,35 @@ typedef struct _elf32_pheader_t {
   uint32_t      p_align;                /* Segment alignment */
 } elf32_pheader_t;
 
+typedef struct _elf32_sheader_t {
+  uint32_t      sh_name;                /* Section name (string tbl index) */
+  uint32_t      sh_type;                /* Section type */
+  uint32_t      sh_flags;               /* Section flags */
+  uint32_t      sh_addr;                /* Section virtual addr at execution */
+  uint32_t      sh_offset;              /* Section file offset */
+  uint32_t      sh_size;                /* Section size in bytes */
+  uint32_t      sh_link;                /* Link to another section */
+  uint32_t      sh_info;                /* Additional section information */
+  uint32_t      sh_addralign;           /* Section alignment */
+  uint32_t      sh_entsize;             /* Entry size if section holds table */
+} elf32_sheader_t;
+
+typedef struct _elf32_sym_t {
+  uint32_t      st_name;                /* Symbol name (string tbl index) */
+  uint32_t      st_value;               /* Symbol value */
+  uint32_t      st_size;                /* Symbol size */
+  uint8_t       st_info;                /* Symbol type and binding */
+  uint8_t       st_other;               /* Symbol visibility */
+  uint16_t      st_shndx;               /* Section index */
+} elf32_sym_t;
+
 #define PF_X (1 << 0)
 
+#define SHT_SYMTAB 2
+#define SHT_DYNSYM 11
+#define SHT_ARM_EXIDX 0x70000001
+
+#define STT_FUNC 2
+#define ELF32_ST_TYPE(info) ((info) & 0xf)
+
 #endif
@@ -0,0 +1,376 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+
+ngdarm builds an index of the instruction n-grams of the functions in a set
+of raw images (e.g., hundreds of firmware versions) and looks up the most
+similar indexed function for each function of another image.
+
+*/
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include "darm.h"
+#include "funcs.h"
+#include "ngram.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <pthread.h>
+#endif
+
+// functions are cut off after this many bytes
+#define MAXFUNCSIZE (64 * 1024)
+
+typedef struct _build_job_t {
+    char           **fnames;
+    uint32_t       count;
+    uint32_t       base;
+    darm_ngram_builder_t b;
+    int            ret;
+#ifndef _WIN32
+    pthread_t      tid;
+    int            started;
+#endif
+} build_job_t;
+
+static uint8_t *read_file(const char *fname, uint32_t *len)
+{
+    FILE *fp = fopen(fname, "rb");
+    if(fp == NULL) return NULL;
+
+    fseek(fp, 0, SEEK_END);
+    *len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    uint8_t *buf = *len != 0 ? malloc(*len) : NULL;
+    if(buf != NULL && fread(buf, 1, *len, fp) != *len) {
+        free(buf), buf = NULL;
+    }
+    fclose(fp);
+    return buf;
+}
+
+// calls cb for each function of the image with its n-gram keys
+static int image_funcs(const uint8_t *buf, uint32_t len, uint32_t base,
+    uint32_t n, int (*cb)(void *ctx, uint32_t addr, const uint64_t *keys,
+    uint32_t count), void *ctx)
+{
+    darm_funcs_t funcs; int ret = 0;
+
+    uint32_t *tokens = malloc(MAXFUNCSIZE / 2 * sizeof(uint32_t));
+    uint64_t *keys = malloc(MAXFUNCSIZE / 2 * sizeof(uint64_t));
+
+    darm_funcs_init(&funcs);
+    if(tokens == NULL || keys == NULL ||
+            darm_funcs_scan(&funcs, buf, len, base) < 0) {
+        ret = -1;
+    }
+    darm_funcs_sort(&funcs);
+
+    for (uint32_t idx = 0; ret == 0 && idx < funcs.count; idx++) {
+        uint32_t start = (funcs.start[idx] & ~1) - (base & ~1);
+        uint32_t end = idx + 1 < funcs.count ?
+            (funcs.start[idx + 1] & ~1) - (base & ~1) : len;
+        if(end - start > MAXFUNCSIZE) end = start + MAXFUNCSIZE;
+
+        uint32_t count = darm_ngram_tokens(buf + start, end - start,
+            funcs.start[idx], tokens, MAXFUNCSIZE / 2);
+        count = darm_ngram_keys(tokens, count, n, keys);
+        ret = cb(ctx, funcs.start[idx], keys, count);
+    }
+
+    darm_funcs_free(&funcs);
+    free(tokens), free(keys);
+    return ret;
+}
+
+typedef struct _build_ctx_t {
+    darm_ngram_builder_t *b;
+    uint32_t       file;
+} build_ctx_t;
+
+static int build_func(void *ctx, uint32_t addr, const uint64_t *keys,
+    uint32_t count)
+{
+    build_ctx_t *c = (build_ctx_t *) ctx;
+    return darm_ngram_add_doc(c->b, c->file, addr, keys, count) < 0 ? -1 : 0;
+}
+
+static void *build_thread(void *arg)
+{
+    build_job_t *job = (build_job_t *) arg;
+
+    for (uint32_t idx = 0; job->ret == 0 && idx < job->count; idx++) {
+        uint32_t len; uint8_t *buf = read_file(job->fnames[idx], &len);
+        build_ctx_t ctx;
+
+        ctx.b = &job->b;
+        ctx.file = darm_ngram_add_file(&job->b, job->fnames[idx]);
+
+        if(buf == NULL || ctx.file == (uint32_t) -1 ||
+                image_funcs(buf, len, job->base, job->b.n, &build_func,
+                &ctx) < 0) {
+            fprintf(stderr, "[-] Error indexing %s!\n", job->fnames[idx]);
+            job->ret = -1;
+        }
+        free(buf);
+    }
+    return NULL;
+}
+
+// each thread indexes a contiguous range of the files, the partial indices
+// are merged in order so the document numbers don't depend on the threads
+static int build_index(const char *index, char **fnames, uint32_t count,
+    uint32_t base, uint32_t n, uint32_t threads)
+{
+    if(threads > count) threads = count;
+
+    build_job_t *jobs = calloc(threads, sizeof(build_job_t));
+    if(jobs == NULL) return -1;
+
+    for (uint32_t idx = 0, off = 0; idx < threads; idx++) {
+        jobs[idx].fnames = &fnames[off];
+        jobs[idx].count = count / threads + (idx < count % threads);
+        jobs[idx].base = base;
+        darm_ngram_builder_init(&jobs[idx].b, n);
+        off += jobs[idx].count;
+    }
+
+#ifndef _WIN32
+    for (uint32_t idx = 1; idx < threads; idx++) {
+        jobs[idx].started = pthread_create(&jobs[idx].tid, NULL,
+            &build_thread, &jobs[idx]) == 0;
+        if(jobs[idx].started == 0) {
+            build_thread(&jobs[idx]);
+        }
+    }
+
+    build_thread(&jobs[0]);
+
+    for (uint32_t idx = 1; idx < threads; idx++) {
+        if(jobs[idx].started != 0) {
+            pthread_join(jobs[idx].tid, NULL);
+        }
+    }
+#else
+    for (uint32_t idx = 0; idx < threads; idx++) {
+        build_thread(&jobs[idx]);
+    }
+#endif
+
+    int ret = 0;
+    for (uint32_t idx = 0; idx < threads; idx++) {
+        if(jobs[idx].ret < 0 || (idx != 0 && darm_ngram_builder_merge(
+                &jobs[0].b, &jobs[idx].b) < 0)) {
+            ret = -1;
+        }
+        if(idx != 0) {
+            darm_ngram_builder_free(&jobs[idx].b);
+        }
+    }
+
+    if(ret == 0 && darm_ngram_write(&jobs[0].b, index) < 0) {
+        fprintf(stderr, "[-] Error writing the index!\n");
+        ret = -1;
+    }
+
+    if(ret == 0) {
+        fprintf(stderr, "[x] Indexed %d functions of %d files\n",
+            jobs[0].b.doc_count, jobs[0].b.file_count);
+    }
+
+    darm_ngram_builder_free(&jobs[0].b);
+    free(jobs);
+    return ret;
+}
+
+typedef struct _query_ctx_t {
+    const darm_ngram_index_t *ix;
+
+    // amount of shared keys per document, and the documents touched by
+    // the current function
+    uint32_t       *score;
+    uint32_t       *touched;
+    uint32_t       *docs;
+} query_ctx_t;
+
+static int query_func(void *ctx, uint32_t addr, const uint64_t *keys,
+    uint32_t count)
+{
+    query_ctx_t *c = (query_ctx_t *) ctx;
+    uint32_t touched = 0, best = 0;
+
+    for (uint32_t idx = 0; idx < count; idx++) {
+        uint32_t hits = darm_ngram_lookup(c->ix, keys[idx], c->docs,
+            c->ix->doc_count);
+        for (uint32_t doc = 0; doc < hits; doc++) {
+            if(c->score[c->docs[doc]]++ == 0) {
+                c->touched[touched++] = c->docs[doc];
+            }
+        }
+    }
+
+    for (uint32_t idx = 0; idx < touched; idx++) {
+        if(c->score[c->touched[idx]] > c->score[c->touched[best]]) {
+            best = idx;
+        }
+    }
+
+    if(touched != 0) {
+        uint32_t doc = c->touched[best], func;
+        const char *fname = darm_ngram_doc(c->ix, doc, &func);
+
+        printf("#%06x %s:%06x %d/%d\n", addr, fname != NULL ? fname : "?",
+            func, c->score[doc], count);
+    }
+
+    for (uint32_t idx = 0; idx < touched; idx++) {
+        c->score[c->touched[idx]] = 0;
+    }
+    return 0;
+}
+
+static int query_index(const char *index, const char *fname, uint32_t base)
+{
+    darm_ngram_index_t ix; query_ctx_t ctx;
+
+    if(darm_ngram_open(&ix, index) < 0) {
+        fprintf(stderr, "[-] Error opening the index!\n");
+        return -1;
+    }
+
+    uint32_t len; uint8_t *buf = read_file(fname, &len);
+
+    ctx.ix = &ix;
+    ctx.score = calloc(ix.doc_count + 1, sizeof(uint32_t));
+    ctx.touched = malloc((ix.doc_count + 1) * sizeof(uint32_t));
+    ctx.docs = malloc((ix.doc_count + 1) * sizeof(uint32_t));
+
+    int ret = buf != NULL && ctx.score != NULL && ctx.touched != NULL &&
+        ctx.docs != NULL ? image_funcs(buf, len, base, ix.n, &query_func,
+        &ctx) : -1;
+    if(ret < 0) {
+        fprintf(stderr, "[-] Error querying %s!\n", fname);
+    }
+
+    free(ctx.score), free(ctx.touched), free(ctx.docs), free(buf);
+    darm_ngram_close(&ix);
+    return ret;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+        "ngdarm - Instruction n-gram index of raw ARMv7/Thumb images   "
+                                        "(C) Jurriaan Bremer, 2013\n"
+        "\n"
+        "Usage: %s [options] -o <index> <binfile>...\n"
+        "       %s [options] -q <index> <binfile>\n"
+        "\n"
+        "Options:\n"
+        "  -o <index>       index the functions of the images\n"
+        "  -q <index>       find the most similar indexed function for\n"
+        "                   each function of the image\n"
+        "  --base <addr>    load address of the images (default 0)\n"
+        "  --arm            the images are ARMv7 code (default)\n"
+        "  --thumb          the images are Thumb/Thumb2 code\n"
+        "  -n <n>           amount of instructions per n-gram (default 4)\n"
+        "  --threads <n>    index with <n> threads (default: cpus)\n",
+        prog, prog
+    );
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t base = 0, n = 4, threads = 0, count = 0;
+    const char *output = NULL, *query = NULL;
+    int thumb = 0;
+
+    char **fnames = malloc(argc * sizeof(char *));
+    if(fnames == NULL) return 1;
+
+    for (int idx = 1; idx < argc; idx++) {
+        const char *arg = argv[idx];
+        int has_value = idx + 1 < argc;
+
+        if(!strcmp(arg, "--arm")) {
+            thumb = 0;
+        }
+        else if(!strcmp(arg, "--thumb")) {
+            thumb = 1;
+        }
+        else if(!strcmp(arg, "--base") && has_value) {
+            base = strtoul(argv[++idx], NULL, 0);
+        }
+        else if(!strcmp(arg, "-n") && has_value) {
+            n = strtoul(argv[++idx], NULL, 0);
+        }
+        else if(!strcmp(arg, "--threads") && has_value) {
+            threads = strtoul(argv[++idx], NULL, 0);
+        }
+        else if(!strcmp(arg, "-o") && has_value) {
+            output = argv[++idx];
+        }
+        else if(!strcmp(arg, "-q") && has_value) {
+            query = argv[++idx];
+        }
+        else if(arg[0] == '-') {
+            usage(argv[0]);
+            return 1;
+        }
+        else {
+            fnames[count++] = argv[idx];
+        }
+    }
+
+    if((output == NULL) == (query == NULL) || count == 0 || n == 0 ||
+            (query != NULL && count != 1)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if(query != NULL) {
+        return query_index(query, fnames[0], base | thumb) < 0;
+    }
+
+#ifndef _WIN32
+    if(threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? cpus : 1;
+    }
+#endif
+    if(threads == 0) {
+        threads = 1;
+    }
+
+    return build_index(output, fnames, count, base | thumb, n, threads) < 0;
+}
@@ -0,0 +1,244 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+
+sweepdarm disassembles the entire ARMv7 encoding space, i.e., all 2^32
+words, and writes a compressed bitmap of the valid words together with the
+amount of words for each instruction, see valid.h.
+
+*/
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include "darm.h"
+#include "valid.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <pthread.h>
+#endif
+
+// amount of words that are disassembled at once
+#define BATCHSIZE 256
+
+typedef struct _sweep_t {
+    uint32_t       first;
+    uint32_t       count;
+
+    // the next block to be swept, shared by all threads
+    volatile uint32_t next;
+
+    darm_valid_entry_t *entry;
+    uint8_t        **container;
+} sweep_t;
+
+typedef struct _sweep_job_t {
+    sweep_t        *sweep;
+    uint64_t       counts[I_INSTRCNT];
+    int            ret;
+#ifndef _WIN32
+    pthread_t      tid;
+    int            started;
+#endif
+} sweep_job_t;
+
+static int sweep_block(sweep_job_t *job, uint32_t block)
+{
+    uint64_t bits[DARM_VALID_BLOCK / 64];
+    uint8_t out[DARM_VALID_BLOCK / 8];
+    uint32_t w[BATCHSIZE];
+    darm_t d[BATCHSIZE];
+
+    memset(bits, 0, sizeof(bits));
+
+    for (uint32_t low = 0; low < DARM_VALID_BLOCK; low += BATCHSIZE) {
+        for (uint32_t idx = 0; idx < BATCHSIZE; idx++) {
+            w[idx] = (block << 16) | (low + idx);
+        }
+
+        darm_armv7_disasm_batch(d, w, BATCHSIZE);
+
+        for (uint32_t idx = 0; idx < BATCHSIZE; idx++) {
+            uint32_t bit = low + idx;
+            bits[bit / 64] |= (uint64_t)(d[idx].instr != I_INVLD) << (bit % 64);
+            job->counts[d[idx].instr]++;
+        }
+    }
+
+    darm_valid_entry_t *entry = &job->sweep->entry[block];
+    uint32_t size = darm_valid_pack(bits, out, entry);
+    if(size == 0) return 0;
+
+    uint8_t *container = malloc(size);
+    if(container == NULL) return -1;
+
+    memcpy(container, out, size);
+    job->sweep->container[block] = container;
+    return 0;
+}
+
+static void *sweep_thread(void *arg)
+{
+    sweep_job_t *job = (sweep_job_t *) arg;
+    sweep_t *sweep = job->sweep;
+
+    while (job->ret == 0) {
+        uint32_t idx = __sync_fetch_and_add(&sweep->next, 1);
+        if(idx >= sweep->count) break;
+
+        job->ret = sweep_block(job, sweep->first + idx);
+    }
+    return NULL;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+        "sweepdarm - Validity bitmap of the ARMv7 encoding space   "
+                                        "(C) Jurriaan Bremer, 2013\n"
+        "\n"
+        "Usage: %s [options] -o <bitmap>\n"
+        "\n"
+        "Options:\n"
+        "  --first <block>  first block of 65536 words (default 0)\n"
+        "  --count <n>      amount of blocks to sweep (default all)\n"
+        "  --threads <n>    sweep with <n> threads (default: cpus)\n",
+        prog
+    );
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t first = 0, count = DARM_VALID_BLOCK, threads = 0;
+    const char *output = NULL;
+
+    for (int idx = 1; idx < argc; idx++) {
+        const char *arg = argv[idx];
+        int has_value = idx + 1 < argc;
+
+        if(!strcmp(arg, "--first") && has_value) {
+            first = strtoul(argv[++idx], NULL, 0);
+        }
+        else if(!strcmp(arg, "--count") && has_value) {
+            count = strtoul(argv[++idx], NULL, 0);
+        }
+        else if(!strcmp(arg, "--threads") && has_value) {
+            threads = strtoul(argv[++idx], NULL, 0);
+        }
+        else if(!strcmp(arg, "-o") && has_value) {
+            output = argv[++idx];
+        }
+        else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if(output == NULL || first >= DARM_VALID_BLOCK) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if(count > DARM_VALID_BLOCK - first) {
+        count = DARM_VALID_BLOCK - first;
+    }
+
+#ifndef _WIN32
+    if(threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? cpus : 1;
+    }
+#endif
+    if(threads == 0) {
+        threads = 1;
+    }
+
+    sweep_t sweep;
+    sweep.first = first, sweep.count = count, sweep.next = 0;
+
+    // the blocks that aren't swept remain V_UNKNOWN
+    sweep.entry = calloc(DARM_VALID_BLOCK, sizeof(darm_valid_entry_t));
+    sweep.container = calloc(DARM_VALID_BLOCK, sizeof(uint8_t *));
+    sweep_job_t *jobs = calloc(threads, sizeof(sweep_job_t));
+    if(sweep.entry == NULL || sweep.container == NULL || jobs == NULL) {
+        fprintf(stderr, "[-] Error allocating memory!\n");
+        return 1;
+    }
+
+    for (uint32_t idx = 0; idx < threads; idx++) {
+        jobs[idx].sweep = &sweep;
+    }
+
+#ifndef _WIN32
+    for (uint32_t idx = 1; idx < threads; idx++) {
+        jobs[idx].started = pthread_create(&jobs[idx].tid, NULL,
+            &sweep_thread, &jobs[idx]) == 0;
+    }
+
+    sweep_thread(&jobs[0]);
+
+    for (uint32_t idx = 1; idx < threads; idx++) {
+        if(jobs[idx].started != 0) {
+            pthread_join(jobs[idx].tid, NULL);
+        }
+    }
+#else
+    sweep_thread(&jobs[0]);
+#endif
+
+    uint64_t counts[I_INSTRCNT] = {0}, valid = 0;
+    for (uint32_t idx = 0; idx < threads; idx++) {
+        if(jobs[idx].ret < 0) {
+            fprintf(stderr, "[-] Error allocating memory!\n");
+            return 1;
+        }
+        for (uint32_t instr = 0; instr < I_INSTRCNT; instr++) {
+            counts[instr] += jobs[idx].counts[instr];
+        }
+    }
+
+    if(darm_valid_write(output, counts, sweep.entry,
+            (const uint8_t *const *) sweep.container) < 0) {
+        fprintf(stderr, "[-] Error writing the bitmap!\n");
+        return 1;
+    }
+
+    for (uint32_t instr = 0; instr < I_INSTRCNT; instr++) {
+        if(counts[instr] == 0) continue;
+
+        printf("%-10s %10llu\n", instr == I_INVLD ? "(invalid)" :
+            darm_mnemonic_name(instr), (unsigned long long) counts[instr]);
+        valid += instr != I_INVLD ? counts[instr] : 0;
+    }
+
+    printf("%-10s %10llu\n", "(valid)", (unsigned long long) valid);
+    return 0;
+}
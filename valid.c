@@ -0,0 +1,321 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "darm.h"
+#include "darm-internal.h"
+#include "valid.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#define VALID_MAGIC "DARMVLD1"
+
+// containers with more entries than this are stored as bitmap instead
+#define ARRAY_MAX 4096
+
+#define BITMAP_SIZE (DARM_VALID_BLOCK / 8)
+
+typedef struct _valid_header_t {
+    char            magic[8];
+    uint32_t        instr_count;
+    uint32_t        reserved;
+    uint64_t        data_size;
+} valid_header_t;
+
+// the containers are stored in little endian
+static inline uint16_t _read_le16(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+static inline void _write16(uint8_t *p, uint16_t value)
+{
+    p[0] = value & 0xff, p[1] = value >> 8;
+}
+
+static uint32_t _container_size(const darm_valid_entry_t *entry)
+{
+    switch ((darm_valid_type_t) entry->type) {
+    case V_ARRAY: case V_INVERTED:
+        return entry->count * sizeof(uint16_t);
+
+    case V_RUNS:
+        return entry->count * 2 * sizeof(uint16_t);
+
+    case V_BITMAP:
+        return BITMAP_SIZE;
+
+    default:
+        return 0;
+    }
+}
+
+uint32_t darm_valid_pack(const uint64_t *bits, uint8_t *out,
+    darm_valid_entry_t *entry)
+{
+    uint32_t valid = 0, runs = 0;
+
+    for (uint32_t idx = 0; idx < DARM_VALID_BLOCK / 64; idx++) {
+        uint64_t prev = idx != 0 ? bits[idx - 1] >> 63 : 0;
+
+        // a run starts at every valid word of which the previous word
+        // isn't valid
+        valid += __builtin_popcountll(bits[idx]);
+        runs += __builtin_popcountll(bits[idx] & ~((bits[idx] << 1) | prev));
+    }
+
+    uint32_t count = 0;
+
+    entry->offset = 0;
+
+    if(valid == 0 || valid == DARM_VALID_BLOCK) {
+        entry->type = valid == 0 ? V_EMPTY : V_FULL;
+        entry->count = 0;
+        return 0;
+    }
+
+    // the smallest of the sorted arrays and the runs, if any of them is
+    // smaller than the bitmap
+    uint32_t invalid = DARM_VALID_BLOCK - valid;
+    uint32_t array = valid < invalid ? valid : invalid;
+
+    if(runs * 2 <= array && runs * 4 < BITMAP_SIZE) {
+        for (uint32_t idx = 0; idx < DARM_VALID_BLOCK; idx++) {
+            if(BITMAP_GET(bits, idx) == 0) continue;
+
+            // the run continues while the next word is valid
+            _write16(&out[count * 4], idx);
+            while (idx + 1 < DARM_VALID_BLOCK && BITMAP_GET(bits, idx + 1)) {
+                idx++;
+            }
+            _write16(&out[count++ * 4 + 2], idx);
+        }
+
+        entry->type = V_RUNS, entry->count = count;
+    }
+    else if(array <= ARRAY_MAX) {
+        uint32_t want = valid == array;
+        for (uint32_t idx = 0; idx < DARM_VALID_BLOCK; idx++) {
+            if(BITMAP_GET(bits, idx) == want) {
+                _write16(&out[count++ * 2], idx);
+            }
+        }
+
+        entry->type = want ? V_ARRAY : V_INVERTED, entry->count = count;
+    }
+    else {
+        for (uint32_t idx = 0; idx < BITMAP_SIZE; idx++) {
+            out[idx] = bits[idx / 8] >> (idx % 8 * 8);
+        }
+
+        entry->type = V_BITMAP, entry->count = 0;
+    }
+    return _container_size(entry);
+}
+
+// index of the last halfword in the sorted array that is at most value,
+// or -1 if there's none
+static int32_t _lower_bound(const uint8_t *data, uint32_t count,
+    uint32_t stride, uint16_t value)
+{
+    uint32_t lo = 0, hi = count;
+
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2, off = mid * stride * 2;
+        uint16_t x = _read_le16(&data[off]);
+
+        if(x <= value) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return (int32_t) lo - 1;
+}
+
+int darm_valid_unpack(const darm_valid_entry_t *entry, const uint8_t *data,
+    uint16_t low)
+{
+    int32_t idx;
+
+    switch ((darm_valid_type_t) entry->type) {
+    case V_EMPTY:
+        return 0;
+
+    case V_FULL:
+        return 1;
+
+    case V_ARRAY: case V_INVERTED:
+        idx = _lower_bound(data, entry->count, 1, low);
+        return (idx >= 0 && _read_le16(&data[idx * 2]) == low) ==
+            (entry->type == V_ARRAY);
+
+    case V_RUNS:
+        idx = _lower_bound(data, entry->count, 2, low);
+        return idx >= 0 && low <= _read_le16(&data[idx * 4 + 2]);
+
+    case V_BITMAP:
+        return (data[low / 8] >> (low % 8)) & 1;
+
+    default:
+        return -1;
+    }
+}
+
+int darm_valid_write(const char *fname, const uint64_t *counts,
+    darm_valid_entry_t *entry, const uint8_t *const *container)
+{
+    valid_header_t hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, VALID_MAGIC, sizeof(hdr.magic));
+    hdr.instr_count = I_INSTRCNT;
+
+    for (uint32_t idx = 0; idx < DARM_VALID_BLOCK; idx++) {
+        entry[idx].offset = hdr.data_size;
+        hdr.data_size += _container_size(&entry[idx]);
+    }
+
+    FILE *fp = fopen(fname, "wb");
+    if(fp == NULL) return -1;
+
+    int ret = fwrite(&hdr, sizeof(hdr), 1, fp) == 1 &&
+        fwrite(counts, sizeof(uint64_t), I_INSTRCNT, fp) == I_INSTRCNT &&
+        fwrite(entry, sizeof(darm_valid_entry_t), DARM_VALID_BLOCK,
+            fp) == DARM_VALID_BLOCK ? 0 : -1;
+
+    for (uint32_t idx = 0; ret == 0 && idx < DARM_VALID_BLOCK; idx++) {
+        uint32_t size = _container_size(&entry[idx]);
+        if(size != 0 && fwrite(container[idx], 1, size, fp) != size) {
+            ret = -1;
+        }
+    }
+
+    if(fclose(fp) != 0) {
+        ret = -1;
+    }
+    return ret;
+}
+
+int darm_valid_open(darm_valid_t *v, const char *fname)
+{
+    memset(v, 0, sizeof(darm_valid_t));
+
+#ifndef _WIN32
+    int fd = open(fname, O_RDONLY);
+    if(fd < 0) return -1;
+
+    struct stat st;
+    if(fstat(fd, &st) < 0 || (uint64_t) st.st_size < sizeof(valid_header_t)) {
+        close(fd);
+        return -1;
+    }
+
+    void *ptr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(ptr == MAP_FAILED) return -1;
+
+    v->map = ptr, v->size = st.st_size;
+#else
+    FILE *fp = fopen(fname, "rb");
+    if(fp == NULL) return -1;
+
+    fseek(fp, 0, SEEK_END);
+    long len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    uint8_t *buf = len >= (long) sizeof(valid_header_t) ? malloc(len) : NULL;
+    if(buf != NULL && fread(buf, 1, len, fp) != (size_t) len) {
+        free(buf), buf = NULL;
+    }
+    fclose(fp);
+    if(buf == NULL) return -1;
+
+    v->map = buf, v->size = len;
+#endif
+
+    const valid_header_t *hdr = (const valid_header_t *) v->map;
+    uint64_t off = sizeof(valid_header_t) +
+        (uint64_t) hdr->instr_count * sizeof(uint64_t) +
+        DARM_VALID_BLOCK * sizeof(darm_valid_entry_t);
+
+    if(memcmp(hdr->magic, VALID_MAGIC, sizeof(hdr->magic)) != 0 ||
+            off > v->size || hdr->data_size != v->size - off) {
+        darm_valid_close(v);
+        return -1;
+    }
+
+    v->instr_count = hdr->instr_count;
+    v->counts = (const uint64_t *) &v->map[sizeof(valid_header_t)];
+    v->entry = (const darm_valid_entry_t *) &v->counts[v->instr_count];
+    v->data = &v->map[off];
+    v->data_size = hdr->data_size;
+
+    // make sure every container lies within the data
+    for (uint32_t idx = 0; idx < DARM_VALID_BLOCK; idx++) {
+        if((uint64_t) v->entry[idx].offset +
+                _container_size(&v->entry[idx]) > v->data_size) {
+            darm_valid_close(v);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int darm_valid_get(const darm_valid_t *v, uint32_t w)
+{
+    const darm_valid_entry_t *entry = &v->entry[w >> 16];
+    return darm_valid_unpack(entry, &v->data[entry->offset], w & 0xffff);
+}
+
+uint64_t darm_valid_count(const darm_valid_t *v, darm_instr_t instr)
+{
+    return (uint32_t) instr < v->instr_count ? v->counts[instr] : 0;
+}
+
+void darm_valid_close(darm_valid_t *v)
+{
+    if(v->map != NULL) {
+#ifndef _WIN32
+        munmap((void *) v->map, v->size);
+#else
+        free((void *) v->map);
+#endif
+    }
+    memset(v, 0, sizeof(darm_valid_t));
+}
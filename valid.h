@@ -0,0 +1,118 @@
+/*
+Copyright (c) 2013, Jurriaan Bremer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice,
+  this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+* Neither the name of the darm developer(s) nor the names of its
+  contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef __VALID_H__
+#define __VALID_H__
+
+#include "darm.h"
+
+// amount of words in each block of the encoding space, i.e., the upper
+// halfword of a word selects the block and the lower halfword the word
+// within that block
+#define DARM_VALID_BLOCK 65536
+
+typedef enum _darm_valid_type_t {
+    // the block hasn't been swept
+    V_UNKNOWN,
+
+    // none or all of the words are valid
+    V_EMPTY,
+    V_FULL,
+
+    // sorted lower halfwords of the valid or invalid words, count entries
+    V_ARRAY,
+    V_INVERTED,
+
+    // count runs of valid words, each as the lower halfwords of the first
+    // and the last word of the run
+    V_RUNS,
+
+    // one bit per word
+    V_BITMAP,
+} darm_valid_type_t;
+
+typedef struct _darm_valid_entry_t {
+    // offset of the container relative to the start of the data
+    uint32_t        offset;
+    uint16_t        type;
+    uint16_t        count;
+} darm_valid_entry_t;
+
+//
+// Packs the validity bitmap of a block (one bit per word, DARM_VALID_BLOCK
+// bits) into the smallest container, at most DARM_VALID_BLOCK / 8 bytes
+// are written to out. Sets the type and count of the entry, but not its
+// offset. Returns the size of the container in bytes.
+//
+uint32_t darm_valid_pack(const uint64_t *bits, uint8_t *out,
+    darm_valid_entry_t *entry);
+
+// whether the word with lower halfword low is valid according to the
+// container, returns -1 for blocks that haven't been swept
+int darm_valid_unpack(const darm_valid_entry_t *entry, const uint8_t *data,
+    uint16_t low);
+
+//
+// Writes a validity bitmap to fname, given the per-instruction counts
+// (I_INSTRCNT entries) and the entry and packed container of each of the
+// DARM_VALID_BLOCK blocks, setting the offsets of the entries. The file
+// consists of a header, the counts, the entries, and the containers; the
+// containers are stored in little endian, everything else in host byte
+// order. Returns 0 on success, -1 on failure.
+//
+int darm_valid_write(const char *fname, const uint64_t *counts,
+    darm_valid_entry_t *entry, const uint8_t *const *container);
+
+typedef struct _darm_valid_t {
+    const uint8_t   *map;
+    uint64_t        size;
+
+    // the amount of words that disassemble to each instruction, the
+    // invalid words are counted as I_INVLD
+    const uint64_t  *counts;
+    uint32_t        instr_count;
+
+    const darm_valid_entry_t *entry;
+    const uint8_t   *data;
+    uint64_t        data_size;
+} darm_valid_t;
+
+// maps a validity bitmap as written by darm_valid_write, e.g., by the
+// utils/sweepdarm tool, returns 0 on success, -1 on failure
+int darm_valid_open(darm_valid_t *v, const char *fname);
+
+// whether the ARMv7 word w is a valid instruction, -1 if unknown
+int darm_valid_get(const darm_valid_t *v, uint32_t w);
+
+// the amount of words that disassemble to instr
+uint64_t darm_valid_count(const darm_valid_t *v, darm_instr_t instr);
+
+void darm_valid_close(darm_valid_t *v);
+
+#endif